@@ -52,6 +52,7 @@ bool Config::Reload(std::filesystem::path iniPath)
             Dx11Upscaler.set_from_config(readString("Upscalers", "Dx11Upscaler", true));
             Dx12Upscaler.set_from_config(readString("Upscalers", "Dx12Upscaler", true));
             VulkanUpscaler.set_from_config(readString("Upscalers", "VulkanUpscaler", true));
+            PreloadBackends.set_from_config(readBool("Upscalers", "PreloadBackends"));
         }
 
         // Frame Generation
@@ -75,8 +76,11 @@ bool Config::Reload(std::filesystem::path iniPath)
             FGDebugResetLines.set_from_config(readBool("OptiFG", "DebugResetLines"));
             FGDebugPacingLines.set_from_config(readBool("OptiFG", "DebugPacingLines"));
             FGAsync.set_from_config(readBool("OptiFG", "AllowAsync"));
+            FGVulkan.set_from_config(readBool("OptiFG", "Vulkan"));
             FGHUDFix.set_from_config(readBool("OptiFG", "HUDFix"));
             FGHUDLimit.set_from_config(readInt("OptiFG", "HUDLimit"));
+            FGHUDValidation.set_from_config(readBool("OptiFG", "HUDValidation"));
+            FGHUDValidationThreshold.set_from_config(readFloat("OptiFG", "HUDValidationThreshold"));
             FGHUDFixExtended.set_from_config(readBool("OptiFG", "HUDFixExtended"));
             FGImmediateCapture.set_from_config(readBool("OptiFG", "HUDFixImmediate"));
             FGRectLeft.set_from_config(readInt("OptiFG", "RectLeft"));
@@ -87,6 +91,11 @@ bool Config::Reload(std::filesystem::path iniPath)
             FGResourceBlocking.set_from_config(readBool("OptiFG", "ResourceBlocking"));
             FGMakeDepthCopy.set_from_config(readBool("OptiFG", "MakeDepthCopy"));
             FGMakeMVCopy.set_from_config(readBool("OptiFG", "MakeMVCopy"));
+            FGHazardTracking.set_from_config(readBool("OptiFG", "HazardTracking"));
+            FGMVHazard.set_from_config(readBool("OptiFG", "MVHazard"));
+            FGDepthHazard.set_from_config(readBool("OptiFG", "DepthHazard"));
+            FGHudlessHazard.set_from_config(readBool("OptiFG", "HudlessHazard"));
+            FGFuseInputPasses.set_from_config(readBool("OptiFG", "FuseInputPasses"));
             FGUseMutexForSwapchain.set_from_config(readBool("OptiFG", "UseMutexForSwapchain"));
 
             FGEnableDepthScale.set_from_config(readBool("OptiFG", "EnableDepthScale"));
@@ -98,6 +107,7 @@ bool Config::Reload(std::filesystem::path iniPath)
             FGFPTAllowHybridSpin.set_from_config(readBool("OptiFG", "FPTHybridSpin"));
             FGFPTHybridSpinTime.set_from_config(readInt("OptiFG", "FPTHybridSpinTime"));
             FGFPTAllowWaitForSingleObjectOnFence.set_from_config(readInt("OptiFG", "FPTWaitForSingleObjectOnFence"));
+            FGFPTAutoTune.set_from_config(readBool("OptiFG", "FPTAutoTune"));
 
             FGDontUseSwapchainBuffers.set_from_config(readBool("OptiFG", "HUDFixDontUseSwapchainBuffers"));
             FGRelaxedResolutionCheck.set_from_config(readBool("OptiFG", "HUDFixRelaxedResolutionCheck"));
@@ -280,6 +290,9 @@ bool Config::Reload(std::filesystem::path iniPath)
             if (auto setting = readFloat("Menu", "FpsOverlayAlpha"); setting.has_value())
                 FpsOverlayAlpha.set_from_config(std::clamp(setting.value(), 0.0f, 1.0f));
 
+            if (auto setting = readFloat("Menu", "FpsOverlayUpdateRate"); setting.has_value())
+                FpsOverlayUpdateRate.set_from_config(std::clamp(setting.value(), 0.0f, 60.0f));
+
             if (auto setting = readFloat("Menu", "FpsScale"); setting.has_value())
                 FpsScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
 
@@ -317,6 +330,7 @@ bool Config::Reload(std::filesystem::path iniPath)
             OutputScalingEnabled.set_from_config(readBool("OutputScaling", "Enabled"));
             OutputScalingUseFsr.set_from_config(readBool("OutputScaling", "UseFsr"));
             OutputScalingDownscaler.set_from_config(readInt("OutputScaling", "Downscaler"));
+            OutputScalingFuseRcas.set_from_config(readBool("OutputScaling", "FuseRcas"));
 
             if (auto setting = readFloat("OutputScaling", "Multiplier"); setting.has_value())
                 OutputScalingMultiplier.set_from_config(std::clamp(setting.value(), 0.5f, 3.0f));
@@ -344,6 +358,39 @@ bool Config::Reload(std::filesystem::path iniPath)
             UpscaleRatioOverrideValue.set_from_config(readFloat("UpscaleRatio", "UpscaleRatioOverrideValue"));
         }
 
+        // Auto Render Scale
+        {
+            AutoRenderScaleEnabled.set_from_config(readBool("UpscaleRatio", "AutoRenderScaleEnabled"));
+            AutoRenderScaleTarget.set_from_config(readFloat("UpscaleRatio", "AutoRenderScaleTarget"));
+            AutoRenderScaleMaxRatio.set_from_config(readFloat("UpscaleRatio", "AutoRenderScaleMaxRatio"));
+        }
+
+        // Benchmark
+        {
+            BenchmarkBackends.set_from_config(readString("Benchmark", "Backends", true));
+            BenchmarkRatios.set_from_config(readString("Benchmark", "Ratios"));
+            BenchmarkCapture.set_from_config(readBool("Benchmark", "Capture"));
+
+            if (auto setting = readInt("Benchmark", "Frames"); setting.has_value())
+                BenchmarkFrames.set_from_config(std::clamp(setting.value(), 10, 10000));
+
+            if (auto setting = readInt("Benchmark", "WarmupFrames"); setting.has_value())
+                BenchmarkWarmupFrames.set_from_config(std::clamp(setting.value(), 0, 10000));
+        }
+
+        // Telemetry
+        {
+            TelemetryEnabled.set_from_config(readBool("Telemetry", "Enabled"));
+        }
+
+        // VRAM
+        {
+            VramBudgetSaving.set_from_config(readBool("VRAM", "BudgetSaving"));
+
+            if (auto setting = readFloat("VRAM", "BudgetThreshold"); setting.has_value())
+                VramBudgetThreshold.set_from_config(std::clamp(setting.value(), 0.5f, 1.0f));
+        }
+
         // Quality Overrides
         {
             QualityRatioOverrideEnabled.set_from_config(readBool("QualityOverrides", "QualityRatioOverrideEnabled"));
@@ -403,6 +450,10 @@ bool Config::Reload(std::filesystem::path iniPath)
         {
             Dx11DelayedInit.set_from_config(readInt("Dx11withDx12", "UseDelayedInit"));
             DontUseNTShared.set_from_config(readBool("Dx11withDx12", "DontUseNTShared"));
+            AsyncPostPasses.set_from_config(readBool("Dx11withDx12", "AsyncPostPasses"));
+            AsyncPostRcas.set_from_config(readBool("Dx11withDx12", "AsyncRcas"));
+            AsyncPostOutputScaling.set_from_config(readBool("Dx11withDx12", "AsyncOutputScaling"));
+            AsyncPostAutoTune.set_from_config(readBool("Dx11withDx12", "AsyncAutoTune"));
         }
 
         // NvApi
@@ -622,6 +673,8 @@ bool Config::SaveIni()
         ini.SetValue("Upscalers", "Dx11Upscaler", Instance()->Dx11Upscaler.value_for_config_or("auto").c_str());
         ini.SetValue("Upscalers", "Dx12Upscaler", Instance()->Dx12Upscaler.value_for_config_or("auto").c_str());
         ini.SetValue("Upscalers", "VulkanUpscaler", Instance()->VulkanUpscaler.value_for_config_or("auto").c_str());
+        ini.SetValue("Upscalers", "PreloadBackends",
+                     GetBoolValue(Instance()->PreloadBackends.value_for_config()).c_str());
     }
 
     // Frame Generation
@@ -649,8 +702,12 @@ bool Config::SaveIni()
         ini.SetValue("OptiFG", "DebugPacingLines",
                      GetBoolValue(Instance()->FGDebugPacingLines.value_for_config()).c_str());
         ini.SetValue("OptiFG", "AllowAsync", GetBoolValue(Instance()->FGAsync.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "Vulkan", GetBoolValue(Instance()->FGVulkan.value_for_config()).c_str());
         ini.SetValue("OptiFG", "HUDFix", GetBoolValue(Instance()->FGHUDFix.value_for_config()).c_str());
         ini.SetValue("OptiFG", "HUDLimit", GetIntValue(Instance()->FGHUDLimit.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "HUDValidation", GetBoolValue(Instance()->FGHUDValidation.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "HUDValidationThreshold",
+                     GetFloatValue(Instance()->FGHUDValidationThreshold.value_for_config()).c_str());
         ini.SetValue("OptiFG", "HUDFixExtended", GetBoolValue(Instance()->FGHUDFixExtended.value_for_config()).c_str());
         ini.SetValue("OptiFG", "HUDFixImmediate",
                      GetBoolValue(Instance()->FGImmediateCapture.value_for_config()).c_str());
@@ -664,6 +721,13 @@ bool Config::SaveIni()
                      GetBoolValue(Instance()->FGResourceBlocking.value_for_config()).c_str());
         ini.SetValue("OptiFG", "MakeDepthCopy", GetBoolValue(Instance()->FGMakeDepthCopy.value_for_config()).c_str());
         ini.SetValue("OptiFG", "MakeMVCopy", GetBoolValue(Instance()->FGMakeMVCopy.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "HazardTracking",
+                     GetBoolValue(Instance()->FGHazardTracking.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "MVHazard", GetBoolValue(Instance()->FGMVHazard.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "DepthHazard", GetBoolValue(Instance()->FGDepthHazard.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "HudlessHazard", GetBoolValue(Instance()->FGHudlessHazard.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "FuseInputPasses",
+                     GetBoolValue(Instance()->FGFuseInputPasses.value_for_config()).c_str());
         ini.SetValue("OptiFG", "UseMutexForSwapchain",
                      GetBoolValue(Instance()->FGUseMutexForSwapchain.value_for_config()).c_str());
 
@@ -683,6 +747,7 @@ bool Config::SaveIni()
                      GetIntValue(Instance()->FGFPTHybridSpinTime.value_for_config()).c_str());
         ini.SetValue("OptiFG", "FPTWaitForSingleObjectOnFence",
                      GetBoolValue(Instance()->FGFPTAllowWaitForSingleObjectOnFence.value_for_config()).c_str());
+        ini.SetValue("OptiFG", "FPTAutoTune", GetBoolValue(Instance()->FGFPTAutoTune.value_for_config()).c_str());
 
         ini.SetValue("OptiFG", "HUDFixDontUseSwapchainBuffers",
                      GetBoolValue(Instance()->FGDontUseSwapchainBuffers.value_for_config()).c_str());
@@ -705,6 +770,8 @@ bool Config::SaveIni()
         ini.SetValue("OutputScaling", "UseFsr",
                      GetBoolValue(Instance()->OutputScalingUseFsr.value_for_config()).c_str());
         ini.SetValue("OutputScaling", "Downscaler", GetIntValue(Instance()->OutputScalingDownscaler).c_str());
+        ini.SetValue("OutputScaling", "FuseRcas",
+                     GetBoolValue(Instance()->OutputScalingFuseRcas.value_for_config()).c_str());
     }
 
     // FSR common
@@ -820,6 +887,8 @@ bool Config::SaveIni()
         ini.SetValue("Menu", "FpsOverlayHorizontal",
                      GetBoolValue(Instance()->FpsOverlayHorizontal.value_for_config()).c_str());
         ini.SetValue("Menu", "FpsOverlayAlpha", GetFloatValue(Instance()->FpsOverlayAlpha.value_for_config()).c_str());
+        ini.SetValue("Menu", "FpsOverlayUpdateRate",
+                     GetFloatValue(Instance()->FpsOverlayUpdateRate.value_for_config()).c_str());
         ini.SetValue("Menu", "FpsScale", GetFloatValue(Instance()->FpsScale.value_for_config()).c_str());
         ini.SetValue("Menu", "TTFFontPath",
                      wstring_to_string(Instance()->TTFFontPath.value_for_config_or(L"auto")).c_str());
@@ -869,6 +938,38 @@ bool Config::SaveIni()
                      GetFloatValue(Instance()->UpscaleRatioOverrideValue.value_for_config()).c_str());
     }
 
+    // Auto Render Scale
+    {
+        ini.SetValue("UpscaleRatio", "AutoRenderScaleEnabled",
+                     GetBoolValue(Instance()->AutoRenderScaleEnabled.value_for_config()).c_str());
+        ini.SetValue("UpscaleRatio", "AutoRenderScaleTarget",
+                     GetFloatValue(Instance()->AutoRenderScaleTarget.value_for_config()).c_str());
+        ini.SetValue("UpscaleRatio", "AutoRenderScaleMaxRatio",
+                     GetFloatValue(Instance()->AutoRenderScaleMaxRatio.value_for_config()).c_str());
+    }
+
+    // Benchmark
+    {
+        ini.SetValue("Benchmark", "Backends", Instance()->BenchmarkBackends.value_for_config_or("auto").c_str());
+        ini.SetValue("Benchmark", "Ratios", Instance()->BenchmarkRatios.value_for_config_or("auto").c_str());
+        ini.SetValue("Benchmark", "Frames", GetIntValue(Instance()->BenchmarkFrames.value_for_config()).c_str());
+        ini.SetValue("Benchmark", "WarmupFrames",
+                     GetIntValue(Instance()->BenchmarkWarmupFrames.value_for_config()).c_str());
+        ini.SetValue("Benchmark", "Capture", GetBoolValue(Instance()->BenchmarkCapture.value_for_config()).c_str());
+    }
+
+    // Telemetry
+    {
+        ini.SetValue("Telemetry", "Enabled", GetBoolValue(Instance()->TelemetryEnabled.value_for_config()).c_str());
+    }
+
+    // VRAM
+    {
+        ini.SetValue("VRAM", "BudgetSaving", GetBoolValue(Instance()->VramBudgetSaving.value_for_config()).c_str());
+        ini.SetValue("VRAM", "BudgetThreshold",
+                     GetFloatValue(Instance()->VramBudgetThreshold.value_for_config()).c_str());
+    }
+
     // Quality Overrides
     {
         ini.SetValue("QualityOverrides", "QualityRatioOverrideEnabled",
@@ -947,6 +1048,13 @@ bool Config::SaveIni()
         // "UseDelayedInit", GetBoolValue(Instance()->Dx11DelayedInit.value_for_config()).c_str());
         ini.SetValue("Dx11withDx12", "DontUseNTShared",
                      GetBoolValue(Instance()->DontUseNTShared.value_for_config()).c_str());
+        ini.SetValue("Dx11withDx12", "AsyncPostPasses",
+                     GetBoolValue(Instance()->AsyncPostPasses.value_for_config()).c_str());
+        ini.SetValue("Dx11withDx12", "AsyncRcas", GetBoolValue(Instance()->AsyncPostRcas.value_for_config()).c_str());
+        ini.SetValue("Dx11withDx12", "AsyncOutputScaling",
+                     GetBoolValue(Instance()->AsyncPostOutputScaling.value_for_config()).c_str());
+        ini.SetValue("Dx11withDx12", "AsyncAutoTune",
+                     GetBoolValue(Instance()->AsyncPostAutoTune.value_for_config()).c_str());
     }
 
     // Logging
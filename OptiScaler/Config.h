@@ -225,6 +225,8 @@ class Config
     CustomOptional<int> FpsCycleShortcutKey { VK_NEXT };
     CustomOptional<bool> FpsOverlayHorizontal { false };
     CustomOptional<float> FpsOverlayAlpha { 0.4f };
+    /// Overlay texts and graphs are rebuilt with this rate (Hz), 0 rebuilds every frame
+    CustomOptional<float> FpsOverlayUpdateRate { 10.0f };
     CustomOptional<float, NoDefault> FpsScale; // No value means same as MenuScale
     CustomOptional<bool> UseHQFont { true };
     CustomOptional<bool> DisableSplash { false };
@@ -238,6 +240,25 @@ class Config
     CustomOptional<bool> UpscaleRatioOverrideEnabled { false };
     CustomOptional<float> UpscaleRatioOverrideValue { 1.3f };
 
+    // Auto Render Scale
+    CustomOptional<bool> AutoRenderScaleEnabled { false };
+    CustomOptional<float> AutoRenderScaleTarget { 16.667f };
+    CustomOptional<float> AutoRenderScaleMaxRatio { 2.0f };
+
+    // Benchmark
+    CustomOptional<std::string> BenchmarkBackends { "xess,fsr21,fsr22,fsr31,dlss" };
+    CustomOptional<std::string> BenchmarkRatios { "1.5,2.0" };
+    CustomOptional<int> BenchmarkFrames { 300 };
+    CustomOptional<int> BenchmarkWarmupFrames { 60 };
+    CustomOptional<bool> BenchmarkCapture { true };
+
+    // Telemetry
+    CustomOptional<bool> TelemetryEnabled { false };
+
+    // VRAM
+    CustomOptional<bool> VramBudgetSaving { true };
+    CustomOptional<float> VramBudgetThreshold { 0.9f };
+
     // DRS
     CustomOptional<bool> DrsMinOverrideEnabled { false };
     CustomOptional<bool> DrsMaxOverrideEnabled { false };
@@ -282,12 +303,14 @@ class Config
     CustomOptional<std::string, SoftDefault> Dx11Upscaler { "fsr22" };
     CustomOptional<std::string, SoftDefault> Dx12Upscaler { "xess" };
     CustomOptional<std::string, SoftDefault> VulkanUpscaler { "fsr21" };
+    CustomOptional<bool> PreloadBackends { false };
 
     // Output Scaling
     CustomOptional<bool> OutputScalingEnabled { false };
     CustomOptional<float> OutputScalingMultiplier { 1.5f };
     CustomOptional<bool> OutputScalingUseFsr { true };
     CustomOptional<uint32_t> OutputScalingDownscaler { 0 }; // 0 = Bicubic | 1 = Lanczos | 2 = Catmull-Rom | 3 = MAGC
+    CustomOptional<bool> OutputScalingFuseRcas { true };
 
     // FSR
     CustomOptional<bool> FsrDebugView { false };
@@ -317,6 +340,10 @@ class Config
     // dx11wdx12
     CustomOptional<bool> Dx11DelayedInit { false };
     CustomOptional<bool> DontUseNTShared { false };
+    CustomOptional<bool> AsyncPostPasses { false };
+    CustomOptional<bool> AsyncPostRcas { true };
+    CustomOptional<bool> AsyncPostOutputScaling { true };
+    CustomOptional<bool> AsyncPostAutoTune { true };
 
     // NVAPI Override
     CustomOptional<bool> OverrideNvapiDll { false };
@@ -356,15 +383,23 @@ class Config
     CustomOptional<bool> FGDebugTearLines { false };
     CustomOptional<bool> FGDebugPacingLines { false };
     CustomOptional<bool> FGAsync { false };
+    CustomOptional<bool> FGVulkan { false };
     CustomOptional<bool> FGUseMutexForSwapchain { true };
     CustomOptional<bool> FGMakeMVCopy { true };
     CustomOptional<bool> FGMakeDepthCopy { true };
+    CustomOptional<bool> FGHazardTracking { true };
+    CustomOptional<bool, NoDefault> FGMVHazard;
+    CustomOptional<bool, NoDefault> FGDepthHazard;
+    CustomOptional<bool, NoDefault> FGHudlessHazard;
     CustomOptional<bool> FGResourceFlip { false };
     CustomOptional<bool> FGResourceFlipOffset { false };
+    CustomOptional<bool> FGFuseInputPasses { true };
 
     // OptiFG - Hudfix
     CustomOptional<bool> FGHUDFix { false };
     CustomOptional<int> FGHUDLimit { 1 };
+    CustomOptional<bool> FGHUDValidation { false };
+    CustomOptional<float> FGHUDValidationThreshold { 0.5f };
     CustomOptional<bool> FGHUDFixExtended { false };
     CustomOptional<bool> FGImmediateCapture { false };
     CustomOptional<bool> FGDontUseSwapchainBuffers { false };
@@ -391,6 +426,7 @@ class Config
     CustomOptional<bool> FGFPTAllowHybridSpin { false };
     CustomOptional<int> FGFPTHybridSpinTime { 2 };
     CustomOptional<bool> FGFPTAllowWaitForSingleObjectOnFence { false };
+    CustomOptional<bool> FGFPTAutoTune { false };
 
     // DLSS Enabler
     std::optional<int> DE_FramerateLimit; // off - vsync - number
@@ -3,6 +3,8 @@
 #include "Config.h"
 #include "DLSSG_Mod.h"
 
+#include <misc/RenderScale.h>
+
 #include <ankerl/unordered_dense.h>
 
 // Use real NVNGX params encapsulated in custom one
@@ -22,6 +24,9 @@ inline static std::optional<float> GetQualityOverrideRatio(const NVSDK_NGX_PerfQ
 {
     std::optional<float> output;
 
+    if (auto ratio = RenderScale::QueryRatio(); ratio.has_value())
+        return ratio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -170,7 +175,9 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallb
     InParams->Set(NVSDK_NGX_Parameter_OutHeight, OutHeight);
 
     // DRS minimum resolution
-    if (Config::Instance()->DrsMinOverrideEnabled.value_or_default() || enumPQValue == NVSDK_NGX_PerfQuality_Value_DLAA)
+    // Auto render scale pins DRS range to its choice
+    if (Config::Instance()->DrsMinOverrideEnabled.value_or_default() || RenderScale::IsActive() ||
+        enumPQValue == NVSDK_NGX_PerfQuality_Value_DLAA)
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height, OutHeight);
@@ -203,7 +210,7 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallb
 
     // DRS maximum resolution
 
-    if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default())
+    if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default() || RenderScale::IsActive())
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, OutHeight);
@@ -324,7 +331,7 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSSD_GetOptimalSettingsCall
     InParams->Set(NVSDK_NGX_Parameter_OutHeight, OutHeight);
 
     // DRS minimum resolution
-    if (Config::Instance()->DrsMinOverrideEnabled.value_or_default())
+    if (Config::Instance()->DrsMinOverrideEnabled.value_or_default() || RenderScale::IsActive())
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height, OutHeight);
@@ -353,7 +360,7 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSSD_GetOptimalSettingsCall
     }
 
     // DRS maximum resolution
-    if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default())
+    if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default() || RenderScale::IsActive())
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, OutHeight);
@@ -898,19 +905,36 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
     }
 
   private:
-    ankerl::unordered_dense::map<std::string, Parameter> m_values;
+    // Transparent lookup, per frame Set/Get calls don't allocate a std::string for existing keys
+    struct KeyHash
+    {
+        using is_transparent = void;
+        using is_avalanching = void;
+
+        uint64_t operator()(std::string_view key) const noexcept
+        {
+            return ankerl::unordered_dense::hash<std::string_view>{}(key);
+        }
+    };
+
+    ankerl::unordered_dense::map<std::string, Parameter, KeyHash, std::equal_to<>> m_values;
     mutable std::mutex m_mutex;
 
     template <typename T> void setT(const char* key, T& value)
     {
         const std::lock_guard<std::mutex> lock(m_mutex);
-        m_values[key] = value;
+        auto k = m_values.find(std::string_view(key));
+
+        if (k != m_values.end())
+            k->second = value;
+        else
+            m_values[key] = value;
     }
 
     template <typename T> NVSDK_NGX_Result getT(const char* key, T* value) const
     {
         const std::lock_guard<std::mutex> lock(m_mutex);
-        auto k = m_values.find(key);
+        auto k = m_values.find(std::string_view(key));
 
         if (k == m_values.end())
         {
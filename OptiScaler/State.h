@@ -2,7 +2,9 @@
 #include "pch.h"
 
 #include "upscalers/IFeature.h"
+#include "upscalers/Upscaler.h"
 #include "framegen/IFGFeature_Dx12.h"
+#include "framegen/IFGFeature_Vk.h"
 #include "misc/Quirks.h"
 
 #include <deque>
@@ -28,6 +30,7 @@ typedef struct CapturedHudlessInfo
 {
     UINT64 usageCount = 1;
     bool enabled = true;
+    float confidence = -1.0f; // Hudless validation score, -1 until first result
 } captured_hudless_info;
 
 class State
@@ -70,7 +73,8 @@ class State
     bool FGonlyGenerated = false;
     bool FGchanged = false;
     bool SCchanged = false;
-    bool skipHeapCapture = false;
+    // Per thread, upscalers can be created on a worker thread while the game keeps rendering
+    inline static thread_local bool skipHeapCapture = false;
 
     bool FGcaptureResources = false;
     bool FGHudlessCompare = false;
@@ -78,6 +82,10 @@ class State
     bool FGresetCapturedResources = false;
     bool FGonlyUseCapturedResources = false;
 
+    // Hudless capture copies of last frame
+    UINT64 FGHudlessCopyBytes = 0;
+    UINT64 FGHudlessSavedBytes = 0;
+
     bool FSRFGFTPchanged = false;
 
     ankerl::unordered_dense::map<void*, CapturedHudlessInfo> CapturedHudlesses;
@@ -113,7 +121,7 @@ class State
 
     // for realtime changes
     ankerl::unordered_dense::map<unsigned int, bool> changeBackend;
-    std::string newBackend = "";
+    Upscaler newBackend = Upscaler::None;
 
     // XeSS debug stuff
     bool xessDebug = false;
@@ -125,8 +133,8 @@ class State
     bool dlssPresetsOverriddenExternally = false;
     bool dlssdPresetsOverriddenExternally = false;
 
-    // Spoofing
-    bool skipSpoofing = false;
+    // Spoofing, per thread like skipHeapCapture
+    inline static thread_local bool skipSpoofing = false;
     // For DXVK, it calls DXGI which cause softlock
     bool skipDxgiLoadChecks = false;
 
@@ -151,6 +159,7 @@ class State
     // Framegraph
     std::deque<double> upscaleTimes;
     std::deque<double> frameTimes;
+    uint64_t upscaleTimeCount = 0;
     double lastFrameTime = 0.0;
     std::mutex frameTimeMutex;
 
@@ -179,6 +188,7 @@ class State
     IFeature* currentFeature = nullptr;
 
     IFGFeature_Dx12* currentFG = nullptr;
+    IFGFeature_Vk* currentVkFG = nullptr;
     IDXGISwapChain* currentSwapchain = nullptr;
     ID3D12Device* currentD3D12Device = nullptr;
     ID3D11Device* currentD3D11Device = nullptr;
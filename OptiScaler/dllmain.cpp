@@ -15,6 +15,7 @@
 #include <hooks/Crypt32_Hooks.h>
 #include <hooks/Advapi32_Hooks.h>
 #include <hooks/Streamline_Hooks.h>
+#include <hooks/HookBackend_Detours.h>
 #include "proxies/Kernel32_Proxy.h"
 #include "proxies/KernelBase_Proxy.h"
 #include <proxies/IGDExt_Proxy.h>
@@ -34,9 +35,12 @@
 
 #include <nvapi/NvApiHooks.h>
 
+#include <misc/BackendPreloader.h>
+
 #include <cwctype>
 
 static std::vector<HMODULE> _asiHandles;
+static DetoursHookBackend detoursBackend;
 
 #pragma warning(disable : 4996)
 
@@ -771,6 +775,9 @@ static void CheckWorkingMode()
                 hookAdvapi32();
 
             // hook streamline right away if it's already loaded
+            // plugin hooks are committed together after the checks
+            HookRegistry::BeginBatch();
+
             HMODULE slModule = nullptr;
             slModule = GetDllNameWModule(&slInterposerNamesW);
             if (slModule != nullptr)
@@ -811,6 +818,8 @@ static void CheckWorkingMode()
                 StreamlineHooks::hookCommon(slCommon);
             }
 
+            HookRegistry::EndBatch();
+
             // XeSS
             HMODULE xessModule = nullptr;
             xessModule = GetDllNameWModule(&xessNamesW);
@@ -1113,6 +1122,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
         PrepareLogger();
 
+        // Before anything queues hooks
+        HookRegistry::SetBackend(&detoursBackend);
+
         spdlog::warn("{0} loaded", VER_PRODUCT_NAME);
         spdlog::warn("---------------------------------");
         spdlog::warn("OptiScaler is freely downloadable from");
@@ -1252,6 +1264,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             State::Instance().upscaleTimes.push_back(0.0f);
         }
 
+        // Load selected backends in background
+        BackendPreloader::Start();
+
         spdlog::info("");
         spdlog::info("Init done");
         spdlog::info("---------------------------------------------");
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Progress of a frame in its slot, flags are only added for the frame that owns the slot
+enum FGSlotFlags : uint32_t
+{
+    FGSlot_None = 0,
+    FGSlot_InputsReady = 1 << 0,  // Velocity and depth are set
+    FGSlot_HudlessReady = 1 << 1, // Hudless command list is closed
+    FGSlot_UsingHudless = 1 << 2, // Hudless resource is set for the frame
+    FGSlot_Dispatched = 1 << 3,   // Dispatch is claimed by a thread
+    FGSlot_Prepared = 1 << 4,     // FG command list is closed and waits for execution
+    FGSlot_Executed = 1 << 5,     // FG command list is claimed for execution
+};
+
+// Lock free handoff of frames between upscale, command list and present hooks
+// Frame id and flags are kept in a single word so a late update for an old frame
+// can't mark a newer frame that reuses the slot. Flags are set with release and
+// read with acquire, resources written before setting a flag are visible to the
+// thread that sees it.
+class FGFrameSlots
+{
+  public:
+    // Same with BUFFER_COUNT, IFGFeature checks it
+    static constexpr uint32_t SlotCount = 4;
+
+  private:
+    static constexpr uint32_t FlagBits = 8;
+    static constexpr uint64_t FlagMask = (1ull << FlagBits) - 1;
+
+    std::atomic<uint64_t> _slots[SlotCount] = {};
+
+    static uint64_t Pack(uint64_t frameId, uint32_t flags) { return (frameId << FlagBits) | flags; }
+    static uint64_t FrameOf(uint64_t value) { return value >> FlagBits; }
+    static uint32_t FlagsOf(uint64_t value) { return (uint32_t) (value & FlagMask); }
+
+    std::atomic<uint64_t>& Slot(uint64_t frameId) { return _slots[frameId % SlotCount]; }
+
+  public:
+    // Takes over the slot for a new frame, previous frame's flags are dropped
+    void Begin(uint64_t frameId) { Slot(frameId).store(Pack(frameId, FGSlot_None), std::memory_order_release); }
+
+    // Adds set and removes clear flags when slot belongs to frameId and has all of required and none of excluded
+    // Only one of the threads racing for the same transition succeeds
+    bool Transition(uint64_t frameId, uint32_t required, uint32_t excluded, uint32_t set, uint32_t clear = 0)
+    {
+        auto& slot = Slot(frameId);
+        auto current = slot.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            auto flags = FlagsOf(current);
+
+            if (FrameOf(current) != frameId || (flags & required) != required || (flags & excluded) != 0)
+                return false;
+
+            auto desired = Pack(frameId, (flags & ~clear) | set);
+
+            if (desired == current)
+                return true;
+
+            if (slot.compare_exchange_weak(current, desired, std::memory_order_acq_rel, std::memory_order_acquire))
+                return true;
+        }
+    }
+
+    bool Set(uint64_t frameId, uint32_t flags) { return Transition(frameId, 0, 0, flags); }
+    bool Clear(uint64_t frameId, uint32_t flags) { return Transition(frameId, 0, 0, 0, flags); }
+
+    // True when slot belongs to frameId and has all of the flags
+    bool Has(uint64_t frameId, uint32_t flags) const
+    {
+        auto current = _slots[frameId % SlotCount].load(std::memory_order_acquire);
+        return FrameOf(current) == frameId && (FlagsOf(current) & flags) == flags;
+    }
+
+    void Reset()
+    {
+        for (auto& slot : _slots)
+            slot.store(0, std::memory_order_release);
+    }
+};
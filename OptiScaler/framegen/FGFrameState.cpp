@@ -0,0 +1,60 @@
+#include "FGFrameState.h"
+
+int FGFrameState::GetIndex() { return (int) (_frameCount % FGFrameSlots::SlotCount); }
+
+uint64_t FGFrameState::StartNewFrame()
+{
+    auto frame = _frameCount.load() + 1;
+
+    // Slot is cleared before the frame is published to other threads
+    _slots.Begin(frame);
+    _frameCount.store(frame, std::memory_order_release);
+
+    return frame;
+}
+
+bool FGFrameState::ClaimDispatch(uint64_t frameId)
+{
+    if (!_slots.Transition(frameId, FGSlot_None, FGSlot_Dispatched, FGSlot_Dispatched))
+        return false;
+
+    _lastDispatchedFrame = frameId;
+    return true;
+}
+
+bool FGFrameState::WaitingExecution()
+{
+    uint64_t frame = _frameCount;
+    return _slots.Has(frame, FGSlot_Prepared) && !_slots.Has(frame, FGSlot_Executed);
+}
+
+bool FGFrameState::ClaimExecution(uint64_t frameId)
+{
+    return _slots.Transition(frameId, FGSlot_Prepared, FGSlot_Executed, FGSlot_Executed);
+}
+
+bool FGFrameState::UpscalerInputsReady() { return _slots.Has(_frameCount, FGSlot_InputsReady); }
+void FGFrameState::SetUpscaleInputsReady() { _slots.Set(_frameCount, FGSlot_InputsReady); }
+
+bool FGFrameState::HudlessReady() { return _slots.Has(_frameCount, FGSlot_HudlessReady); }
+void FGFrameState::SetHudlessReady() { _slots.Set(_frameCount, FGSlot_HudlessReady); }
+bool FGFrameState::UsingHudless() { return _slots.Has(_frameCount, FGSlot_UsingHudless); }
+
+bool FGFrameState::IsPaused() { return _targetFrame >= _frameCount; }
+
+bool FGFrameState::IsDispatched() { return _slots.Has(_frameCount, FGSlot_Dispatched); }
+
+void FGFrameState::ResetCounters()
+{
+    _frameCount = 0;
+    _targetFrame = 0;
+    _slots.Reset();
+}
+
+void FGFrameState::UpdateTarget() { _targetFrame = _frameCount + PauseFrames; }
+
+uint64_t FGFrameState::FrameCount() { return _frameCount; }
+
+uint64_t FGFrameState::LastDispatchedFrame() { return _lastDispatchedFrame; }
+
+uint64_t FGFrameState::TargetFrame() { return _targetFrame; }
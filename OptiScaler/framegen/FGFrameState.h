@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FGFrameSlots.h"
+
+#include <atomic>
+#include <cstdint>
+
+// Backend-neutral per-frame state machine of frame generation
+// Frames are indexed with _frameCount % SlotCount and every slot tracks the readiness
+// of its inputs until the backend dispatches and executes it.
+// Upscale and present threads don't lock each other.
+class FGFrameState
+{
+  protected:
+    std::atomic<uint64_t> _frameCount = 0;
+    std::atomic<uint64_t> _lastDispatchedFrame = 0;
+    uint64_t _targetFrame = 0;
+
+    FGFrameSlots _slots;
+
+    // Only one caller gets true for a frame, it must do the dispatch
+    bool ClaimDispatch(uint64_t frameId);
+
+  public:
+    // Frames FG waits after a reset before it starts generating
+    static constexpr uint64_t PauseFrames = 10;
+
+    int GetIndex();
+    uint64_t StartNewFrame();
+
+    void SetUpscaleInputsReady();
+    bool UpscalerInputsReady();
+
+    void SetHudlessReady();
+    bool HudlessReady();
+    bool UsingHudless();
+
+    bool WaitingExecution();
+
+    // Only one caller gets true for a frame, it must execute the command list
+    bool ClaimExecution(uint64_t frameId);
+
+    bool IsPaused();
+    bool IsDispatched();
+
+    void ResetCounters();
+    void UpdateTarget();
+
+    uint64_t FrameCount();
+    uint64_t LastDispatchedFrame();
+    uint64_t TargetFrame();
+};
@@ -0,0 +1,90 @@
+#include "FGPacing.h"
+
+#include <Config.h>
+#include <Util.h>
+
+void FGPacing::Present(IDXGISwapChain* InSwapChain, bool InGenerated)
+{
+    if (InSwapChain == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _analyzer.AddPresent(Util::MillisecondsNow(), InGenerated);
+
+    DXGI_FRAME_STATISTICS frameStats {};
+    auto result = InSwapChain->GetFrameStatistics(&frameStats);
+
+    if (result == S_OK)
+    {
+        if (_qpcFrequency == 0.0)
+        {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            _qpcFrequency = (double) frequency.QuadPart;
+        }
+
+        _analyzer.AddSyncSample(frameStats.PresentCount,
+                                (double) frameStats.SyncQPCTime.QuadPart * 1000.0 / _qpcFrequency);
+    }
+    else if (result == DXGI_ERROR_FRAME_STATISTICS_DISJOINT)
+    {
+        _analyzer.ResetSync();
+    }
+
+    PacingStats stats {};
+
+    if (!_analyzer.Analyze(&stats))
+        return;
+
+    _stats = stats;
+
+    LOG_DEBUG("Interval: {:.3f} ms, jitter: {:.3f} ms, error: {:.3f}, imbalance: {:.3f}, display: {:.3f} ms",
+              stats.interval, stats.jitter, stats.error, stats.imbalance, stats.displayInterval);
+
+    auto config = Config::Instance();
+
+    if (!config->FGFPTAutoTune.value_or_default() || !config->FGFramePacingTuning.value_or_default())
+    {
+        _tunerSynced = false;
+        return;
+    }
+
+    // Start from current values, also when they are changed from menu
+    if (!_tunerSynced || config->FGFPTSafetyMarginInMs.value_or_default() != _tuner.SafetyMargin() ||
+        config->FGFPTVarianceFactor.value_or_default() != _tuner.VarianceFactor())
+    {
+        _tuner.Reset(config->FGFPTSafetyMarginInMs.value_or_default(), config->FGFPTVarianceFactor.value_or_default());
+        _tunerSynced = true;
+    }
+
+    if (!_tuner.Step(stats))
+        return;
+
+    config->FGFPTSafetyMarginInMs = _tuner.SafetyMargin();
+    config->FGFPTVarianceFactor = _tuner.VarianceFactor();
+    State::Instance().FSRFGFTPchanged = true;
+
+    LOG_INFO("Frame pacing {}: safety margin {:.3f} ms, variance factor {:.3f}",
+             _tuner.Converged() ? "tuned" : "trying", _tuner.SafetyMargin(), _tuner.VarianceFactor());
+}
+
+PacingStats FGPacing::Stats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+bool FGPacing::TunerConverged()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tunerSynced && _tuner.Converged();
+}
+
+void FGPacing::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _analyzer.Reset();
+    _stats = {};
+    _tunerSynced = false;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <pch.h>
+
+#include "FGPacing_Common.h"
+
+#include <dxgi.h>
+
+#include <mutex>
+
+// Samples presents of FG output swapchain and drives the tuner when it's enabled
+class FGPacing
+{
+  private:
+    inline static std::mutex _mutex;
+    inline static PacingAnalyzer _analyzer { 240 };
+    inline static PacingTuner _tuner { 0.01f, 0.3f };
+    inline static PacingStats _stats {};
+    inline static bool _tunerSynced = false;
+    inline static double _qpcFrequency = 0.0;
+
+  public:
+    // Called after each present of real and generated frames
+    static void Present(IDXGISwapChain* InSwapChain, bool InGenerated);
+
+    // Last analyzed window
+    static PacingStats Stats();
+    static bool TunerConverged();
+
+    // FG is toggled or swapchain is recreated
+    static void Reset();
+};
@@ -0,0 +1,268 @@
+#include "FGPacing_Common.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Intervals longer than this multiple of median are hitches (loading, alt-tab) and dropped from the window
+static constexpr double HitchFactor = 4.0;
+
+// Error must drop at least this much for a step to be kept, smaller changes are noise
+static constexpr double Improvement = 0.03;
+
+// Converged tuner starts searching again when error grows this much
+static constexpr double DriftFactor = 1.5;
+
+typedef struct IntervalStats
+{
+    uint32_t count = 0;
+    double mean = 0.0;
+    double jitter = 0.0;
+    double error = 0.0;
+} interval_stats;
+
+static double Median(std::vector<double> values)
+{
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+// Mean, standard deviation and mean relative distance from mean of intervals without hitches
+static IntervalStats Measure(const std::vector<double>& intervals, double limit)
+{
+    IntervalStats result {};
+    double sum = 0.0;
+    double sumSq = 0.0;
+
+    for (auto interval : intervals)
+    {
+        if (interval > limit)
+            continue;
+
+        sum += interval;
+        sumSq += interval * interval;
+        result.count++;
+    }
+
+    if (result.count == 0)
+        return result;
+
+    result.mean = sum / result.count;
+    result.jitter = std::sqrt(std::max(0.0, sumSq / result.count - result.mean * result.mean));
+
+    double distance = 0.0;
+
+    for (auto interval : intervals)
+    {
+        if (interval <= limit)
+            distance += std::abs(interval - result.mean);
+    }
+
+    result.error = distance / result.count / result.mean;
+    return result;
+}
+
+void PacingAnalyzer::AddPresent(double timeMs, bool generated)
+{
+    if (_lastPresent > 0.0 && timeMs > _lastPresent)
+    {
+        _intervals.push_back(timeMs - _lastPresent);
+        _toGenerated.push_back(generated);
+    }
+
+    _lastPresent = timeMs;
+}
+
+void PacingAnalyzer::AddSyncSample(uint32_t presentCount, double syncTimeMs)
+{
+    // Statistics are not updated until next present is displayed
+    if (presentCount == _lastPresentCount)
+        return;
+
+    if (_lastPresentCount != 0 && presentCount > _lastPresentCount && syncTimeMs > _lastSyncTime)
+        _displayIntervals.push_back((syncTimeMs - _lastSyncTime) / (presentCount - _lastPresentCount));
+
+    _lastPresentCount = presentCount;
+    _lastSyncTime = syncTimeMs;
+}
+
+void PacingAnalyzer::ResetSync()
+{
+    _displayIntervals.clear();
+    _lastPresentCount = 0;
+    _lastSyncTime = 0.0;
+}
+
+bool PacingAnalyzer::Analyze(PacingStats* stats)
+{
+    if (stats == nullptr || _intervals.size() < _windowSize)
+        return false;
+
+    auto limit = Median(_intervals) * HitchFactor;
+    auto all = Measure(_intervals, limit);
+
+    *stats = {};
+    stats->presents = all.count;
+    stats->interval = all.mean;
+    stats->jitter = all.jitter;
+    stats->error = all.error;
+
+    // With FG every other present is generated, both halves of a real frame should take the same time
+    double sum[2] = {};
+    uint32_t count[2] = {};
+
+    for (size_t i = 0; i < _intervals.size(); i++)
+    {
+        if (_intervals[i] > limit)
+            continue;
+
+        auto index = _toGenerated[i] ? 1 : 0;
+        sum[index] += _intervals[i];
+        count[index]++;
+    }
+
+    if (count[0] > 0 && count[1] > 0 && all.mean > 0.0)
+        stats->imbalance = std::abs(sum[1] / count[1] - sum[0] / count[0]) / all.mean;
+
+    if (_displayIntervals.size() > 1)
+    {
+        auto display = Measure(_displayIntervals, Median(_displayIntervals) * HitchFactor);
+        stats->displayInterval = display.mean;
+        stats->displayJitter = display.jitter;
+    }
+
+    _intervals.clear();
+    _toGenerated.clear();
+    _displayIntervals.clear();
+
+    return true;
+}
+
+void PacingAnalyzer::Reset()
+{
+    _intervals.clear();
+    _toGenerated.clear();
+    _lastPresent = 0.0;
+
+    ResetSync();
+}
+
+double PacingTuner::Score(const PacingStats& stats)
+{
+    auto score = stats.error + stats.imbalance;
+
+    // Displayed cadence is what user sees, use it when driver reports it
+    if (stats.displayInterval > 0.0)
+        score += stats.displayJitter / stats.displayInterval;
+
+    return score;
+}
+
+bool PacingTuner::StartTrial()
+{
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        auto& param = _params[_trial / 2];
+        auto direction = (_trial % 2) == 0 ? 1.0f : -1.0f;
+        auto value = std::clamp(param.value + direction * param.step, param.min, param.max);
+
+        if (value != param.value)
+        {
+            _trialOldValue = param.value;
+            param.value = value;
+            _trialActive = true;
+            return true;
+        }
+
+        // Parameter is at its limit in this direction
+        _trial = (_trial + 1) % 4;
+    }
+
+    return false;
+}
+
+bool PacingTuner::Step(const PacingStats& stats)
+{
+    if (stats.presents == 0 || stats.interval <= 0.0)
+        return false;
+
+    auto score = Score(stats);
+
+    if (!_hasBaseline)
+    {
+        _bestScore = score;
+        _hasBaseline = true;
+        return StartTrial();
+    }
+
+    if (_converged)
+    {
+        if (score <= _bestScore * DriftFactor)
+            return false;
+
+        // Game or scene changed, search again from current values
+        for (auto& param : _params)
+            param.step = param.initialStep;
+
+        _bestScore = score;
+        _converged = false;
+        _failed = 0;
+
+        return StartTrial();
+    }
+
+    if (!_trialActive)
+        return StartTrial();
+
+    _trialActive = false;
+
+    // Keep going in the same direction while it helps
+    if (score < _bestScore * (1.0 - Improvement))
+    {
+        _bestScore = score;
+        _failed = 0;
+        StartTrial();
+        return true;
+    }
+
+    _params[_trial / 2].value = _trialOldValue;
+    _trial = (_trial + 1) % 4;
+
+    if (++_failed >= 4)
+    {
+        _failed = 0;
+        auto refined = false;
+
+        for (auto& param : _params)
+        {
+            if (param.step > param.minStep)
+            {
+                param.step = std::max(param.step * 0.5f, param.minStep);
+                refined = true;
+            }
+        }
+
+        if (!refined)
+        {
+            _converged = true;
+            return true;
+        }
+    }
+
+    StartTrial();
+    return true;
+}
+
+void PacingTuner::Reset(float safetyMargin, float varianceFactor)
+{
+    _params[0] = { std::clamp(safetyMargin, 0.0f, 2.0f), 0.0f, 2.0f, 0.1f, 0.01f, 0.1f };
+    _params[1] = { std::clamp(varianceFactor, 0.0f, 1.0f), 0.0f, 1.0f, 0.1f, 0.02f, 0.1f };
+
+    _bestScore = 0.0;
+    _hasBaseline = false;
+    _trialActive = false;
+    _trialOldValue = 0.0f;
+    _trial = 0;
+    _failed = 0;
+    _converged = false;
+}
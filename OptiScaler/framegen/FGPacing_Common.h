@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+typedef struct PacingStats
+{
+    uint32_t presents = 0;
+    double interval = 0.0;  // mean present to present time in ms
+    double jitter = 0.0;    // standard deviation of present intervals in ms
+    double error = 0.0;     // mean distance of intervals from the mean, relative to it
+    double imbalance = 0.0; // difference of real -> generated and generated -> real intervals, relative to mean
+
+    // From DXGI frame statistics, 0 when not available
+    double displayInterval = 0.0;
+    double displayJitter = 0.0;
+} pacing_stats;
+
+// Collects present times of FG output and computes pacing of a window
+class PacingAnalyzer
+{
+  private:
+    uint32_t _windowSize = 0;
+
+    std::vector<double> _intervals;
+    std::vector<bool> _toGenerated; // interval ends with a generated frame
+    double _lastPresent = 0.0;
+
+    std::vector<double> _displayIntervals;
+    uint32_t _lastPresentCount = 0;
+    double _lastSyncTime = 0.0;
+
+  public:
+    // Time of a present in ms
+    void AddPresent(double timeMs, bool generated);
+
+    // Present count and sync time of the last displayed present from frame statistics
+    void AddSyncSample(uint32_t presentCount, double syncTimeMs);
+
+    // Frame statistics are disjoint (mode change, alt-tab), display samples start over
+    void ResetSync();
+
+    // Stats of the window, returns false until it's filled, window starts over after
+    bool Analyze(PacingStats* stats);
+
+    void Reset();
+
+    explicit PacingAnalyzer(uint32_t windowSize) : _windowSize(windowSize) {}
+};
+
+// Searches FFX pacing parameters which give the lowest pacing error, one parameter step is tried per window
+// Step is kept when error drops, otherwise reverted. When no step helps step sizes are halved until minimum.
+class PacingTuner
+{
+  private:
+    typedef struct Parameter
+    {
+        float value = 0.0f;
+        float min = 0.0f;
+        float max = 0.0f;
+        float step = 0.0f;
+        float minStep = 0.0f;
+        float initialStep = 0.0f;
+    } parameter;
+
+    // 0 = safety margin, 1 = variance factor
+    Parameter _params[2] = {};
+
+    double _bestScore = 0.0;
+    bool _hasBaseline = false;
+    bool _trialActive = false;
+    float _trialOldValue = 0.0f;
+    uint32_t _trial = 0;  // parameter * 2 + direction
+    uint32_t _failed = 0; // consecutive trials without improvement
+    bool _converged = false;
+
+    static double Score(const PacingStats& stats);
+    bool StartTrial();
+
+  public:
+    // Result of a window with current parameters, returns true when parameters are changed
+    bool Step(const PacingStats& stats);
+
+    void Reset(float safetyMargin, float varianceFactor);
+
+    float SafetyMargin() const { return _params[0].value; }
+    float VarianceFactor() const { return _params[1].value; }
+    bool Converged() const { return _converged; }
+    double BestScore() const { return _bestScore; }
+
+    PacingTuner(float safetyMargin, float varianceFactor) { Reset(safetyMargin, varianceFactor); }
+};
@@ -2,60 +2,14 @@
 
 #include <Config.h>
 
-int IFGFeature::GetIndex() { return (_frameCount % BUFFER_COUNT); }
-
 UINT64 IFGFeature::StartNewFrame()
 {
     LOG_FUNC();
-    _frameCount++;
-    auto fIndex = GetIndex();
-
-    _mvAndDepthReady[fIndex] = false;
-    _hudlessReady[fIndex] = false;
-    _waitingExecute[fIndex] = false;
-    _noHudless[fIndex] = true;
-
-    return _frameCount;
-}
-
-bool IFGFeature::WaitingExecution() { return _waitingExecute[GetIndex()]; }
-void IFGFeature::SetExecuted() { _waitingExecute[GetIndex()] = false; }
-
-bool IFGFeature::UpscalerInputsReady() { return _mvAndDepthReady[GetIndex()]; }
-void IFGFeature::SetUpscaleInputsReady() { _mvAndDepthReady[GetIndex()] = true; }
-
-bool IFGFeature::HudlessReady() { return _hudlessReady[GetIndex()]; }
-void IFGFeature::SetHudlessReady() { _hudlessReady[GetIndex()] = true; }
-bool IFGFeature::UsingHudless() { return !_noHudless[GetIndex()]; }
-
-bool IFGFeature::CheckForRealObject(std::string functionName, IUnknown* pObject, IUnknown** ppRealObject)
-{
-    if (streamlineRiid.Data1 == 0)
-    {
-        auto iidResult = IIDFromString(L"{ADEC44E2-61F0-45C3-AD9F-1B37379284FF}", &streamlineRiid);
-
-        if (iidResult != S_OK)
-            return false;
-    }
-
-    auto qResult = pObject->QueryInterface(streamlineRiid, (void**) ppRealObject);
-
-    if (qResult == S_OK && *ppRealObject != nullptr)
-    {
-        LOG_INFO("{} Streamline proxy found!", functionName);
-        (*ppRealObject)->Release();
-        return true;
-    }
-
-    return false;
+    return FGFrameState::StartNewFrame();
 }
 
 bool IFGFeature::IsActive() { return _isActive; }
 
-bool IFGFeature::IsPaused() { return _targetFrame >= _frameCount; }
-
-bool IFGFeature::IsDispatched() { return _lastDispatchedFrame == _frameCount; }
-
 void IFGFeature::SetJitter(float x, float y)
 {
     _jitterX = x;
@@ -80,20 +34,8 @@ void IFGFeature::SetFrameTimeDelta(float delta) { _ftDelta = delta; }
 
 void IFGFeature::SetReset(UINT reset) { _reset = reset; }
 
-void IFGFeature::ResetCounters()
-{
-    _frameCount = 0;
-    _targetFrame = 0;
-}
-
 void IFGFeature::UpdateTarget()
 {
-    _targetFrame = _frameCount + 10;
-    LOG_DEBUG("Current frame: {} target frame: {}", _frameCount, _targetFrame);
+    FGFrameState::UpdateTarget();
+    LOG_DEBUG("Current frame: {} target frame: {}", _frameCount.load(), _targetFrame);
 }
-
-UINT64 IFGFeature::FrameCount() { return _frameCount; }
-
-UINT64 IFGFeature::LastDispatchedFrame() { return _lastDispatchedFrame; }
-
-UINT64 IFGFeature::TargetFrame() { return _targetFrame; }
@@ -2,10 +2,13 @@
 #include <pch.h>
 
 #include <OwnedMutex.h>
+#include "FGFrameState.h"
 
-#include <dxgi1_6.h>
+static_assert(FGFrameSlots::SlotCount == BUFFER_COUNT, "FG frame slots should match resource ring size");
 
-class IFGFeature
+// Backend-neutral part of frame generation, per-frame state machine is in FGFrameState.
+// Mutex only guards context and swapchain lifetime.
+class IFGFeature : public FGFrameState
 {
   protected:
     float _jitterX = 0.0;
@@ -19,21 +22,9 @@ class IFGFeature
     float _ftDelta = 0.0;
     UINT _reset = 0;
 
-    UINT64 _frameCount = 0;
-    UINT64 _lastDispatchedFrame = 0;
     UINT64 _lastUpscaledFrameId = 0;
 
     bool _isActive = false;
-    UINT64 _targetFrame = 0;
-
-    bool _mvAndDepthReady[BUFFER_COUNT] = { false, false, false, false };
-    bool _hudlessReady[BUFFER_COUNT] = { false, false, false, false };
-    bool _noHudless[BUFFER_COUNT] = { true, true, true, true };
-    bool _waitingExecute[BUFFER_COUNT] = { false, false, false, false };
-
-    IID streamlineRiid {};
-
-    bool CheckForRealObject(std::string functionName, IUnknown* pObject, IUnknown** ppRealObject);
 
   public:
     OwnedMutex Mutex;
@@ -44,22 +35,9 @@ class IFGFeature
     virtual void ReleaseObjects() = 0;
     virtual void StopAndDestroyContext(bool destroy, bool shutDown, bool useMutex) = 0;
 
-    int GetIndex();
     UINT64 StartNewFrame();
 
-    void SetUpscaleInputsReady();
-    bool UpscalerInputsReady();
-
-    void SetHudlessReady();
-    bool HudlessReady();
-    bool UsingHudless();
-
-    bool WaitingExecution();
-    void SetExecuted();
-
     bool IsActive();
-    bool IsPaused();
-    bool IsDispatched();
 
     void SetJitter(float x, float y);
     void SetMVScale(float x, float y);
@@ -67,12 +45,7 @@ class IFGFeature
     void SetFrameTimeDelta(float delta);
     void SetReset(UINT reset);
 
-    void ResetCounters();
     void UpdateTarget();
 
-    UINT64 FrameCount();
-    UINT64 LastDispatchedFrame();
-    UINT64 TargetFrame();
-
     IFGFeature() = default;
 };
@@ -2,6 +2,42 @@
 
 #include <State.h>
 #include <Config.h>
+#include <misc/VramTracker.h>
+#include <resource_tracking/FGHazard_Dx12.h>
+#include <hudfix/Hudfix_Dx12.h>
+
+// Slot copies are reused after BUFFER_COUNT frames, releasing at that point is as safe as overwriting them
+static void ReleaseSlotCopy(ID3D12Resource** InResource)
+{
+    if (*InResource == nullptr)
+        return;
+
+    LOG_DEBUG("Releasing copy to save VRAM");
+    (*InResource)->Release();
+    (*InResource) = nullptr;
+}
+
+bool IFGFeature_Dx12::CheckForRealObject(std::string functionName, IUnknown* pObject, IUnknown** ppRealObject)
+{
+    if (streamlineRiid.Data1 == 0)
+    {
+        auto iidResult = IIDFromString(L"{ADEC44E2-61F0-45C3-AD9F-1B37379284FF}", &streamlineRiid);
+
+        if (iidResult != S_OK)
+            return false;
+    }
+
+    auto qResult = pObject->QueryInterface(streamlineRiid, (void**) ppRealObject);
+
+    if (qResult == S_OK && *ppRealObject != nullptr)
+    {
+        LOG_INFO("{} Streamline proxy found!", functionName);
+        (*ppRealObject)->Release();
+        return true;
+    }
+
+    return false;
+}
 
 bool IFGFeature_Dx12::CreateBufferResourceWithSize(ID3D12Device* device, ID3D12Resource* source,
                                                    D3D12_RESOURCE_STATES state, ID3D12Resource** target, UINT width,
@@ -56,6 +92,8 @@ bool IFGFeature_Dx12::CreateBufferResourceWithSize(ID3D12Device* device, ID3D12R
         return false;
     }
 
+    VramTracker::Track(*target, VramOwner::FrameGen);
+
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
 
     return true;
@@ -110,6 +148,8 @@ bool IFGFeature_Dx12::CreateBufferResource(ID3D12Device* device, ID3D12Resource*
         return false;
     }
 
+    VramTracker::Track(*target, VramOwner::FrameGen);
+
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
 
     return true;
@@ -187,8 +227,24 @@ void IFGFeature_Dx12::SetVelocity(ID3D12GraphicsCommandList* cmdList, ID3D12Reso
         return;
     }
 
-    if (Config::Instance()->FGMakeMVCopy.value_or_default() &&
-        CopyResource(cmdList, velocity, &_paramVelocityCopy[index], state))
+    // Game resource is used directly when close to VRAM budget
+    if (VramTracker::SaveMemory())
+    {
+        ReleaseSlotCopy(&_paramVelocityCopy[index]);
+        return;
+    }
+
+    if (!Config::Instance()->FGMakeMVCopy.value_or_default())
+        return;
+
+    // Game doesn't write to it before FG runs
+    if (!FGHazard_Dx12::NeedsCopy(FGInput::Velocity, _frameCount, velocity, state))
+    {
+        ReleaseSlotCopy(&_paramVelocityCopy[index]);
+        return;
+    }
+
+    if (CopyResource(cmdList, velocity, &_paramVelocityCopy[index], state))
     {
         LOG_TRACE("Setting velocity, index: {}", index);
         _paramVelocity[index] = _paramVelocityCopy[index];
@@ -238,24 +294,126 @@ void IFGFeature_Dx12::SetDepth(ID3D12GraphicsCommandList* cmdList, ID3D12Resourc
         return;
     }
 
-    if (Config::Instance()->FGMakeDepthCopy.value_or_default() &&
-        CopyResource(cmdList, depth, &_paramDepthCopy[index], state))
+    if (VramTracker::SaveMemory())
+    {
+        ReleaseSlotCopy(&_paramDepthCopy[index]);
+        return;
+    }
+
+    if (!Config::Instance()->FGMakeDepthCopy.value_or_default())
+        return;
+
+    if (!FGHazard_Dx12::NeedsCopy(FGInput::Depth, _frameCount, depth, state))
+    {
+        ReleaseSlotCopy(&_paramDepthCopy[index]);
+        return;
+    }
+
+    if (CopyResource(cmdList, depth, &_paramDepthCopy[index], state))
     {
         LOG_TRACE("Setting depth, index: {}", index);
         _paramDepth[index] = _paramDepthCopy[index];
     }
 }
 
+bool IFGFeature_Dx12::PrepareInputs(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* velocity,
+                                    ID3D12Resource* depth, bool scaleDepth)
+{
+    auto feature = State::Instance().currentFeature;
+
+    if (cmdList == nullptr || velocity == nullptr || depth == nullptr || _device == nullptr || feature == nullptr ||
+        !Config::Instance()->FGFuseInputPasses.value_or_default() ||
+        !Config::Instance()->FGResourceFlip.value_or_default())
+    {
+        return false;
+    }
+
+    uint32_t flags = FI_FlipVelocity | FI_FlipDepth;
+
+    if (scaleDepth)
+        flags |= FI_ScaleDepth;
+
+    if (_inputPrep.get() == nullptr)
+        _inputPrep = std::make_unique<FI_Dx12>("FGInputs", _device);
+
+    if (!_inputPrep->IsSupported(flags))
+        return false;
+
+    auto index = GetIndex();
+
+    if (!CreateBufferResource(_device, velocity, D3D12_RESOURCE_STATE_COPY_DEST, &_paramVelocityCopy[index], true,
+                              false) ||
+        !CreateBufferResource(_device, depth, D3D12_RESOURCE_STATE_COPY_DEST, &_paramDepthCopy[index], true, true))
+    {
+        return false;
+    }
+
+    FIParams params {};
+    params.velocity = velocity;
+    params.velocityOut = _paramVelocityCopy[index];
+    params.velocityWidth = feature->LowResMV() ? feature->RenderWidth() : feature->DisplayWidth();
+    params.velocityHeight = feature->LowResMV() ? feature->RenderHeight() : feature->DisplayHeight();
+    params.depth = depth;
+    params.depthOut = _paramDepthCopy[index];
+    params.depthWidth = feature->RenderWidth();
+    params.depthHeight = feature->RenderHeight();
+    params.flags = flags;
+
+    // Both outputs are transitioned with a single call
+    D3D12_RESOURCE_BARRIER barriers[2] = {};
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        barriers[i].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barriers[i].Transition.pResource = i == 0 ? params.velocityOut : params.depthOut;
+        barriers[i].Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+        barriers[i].Transition.StateAfter = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+        barriers[i].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    }
+
+    cmdList->ResourceBarrier(2, barriers);
+
+    auto result = _inputPrep->Dispatch(_device, cmdList, params);
+
+    for (size_t i = 0; i < 2; i++)
+        std::swap(barriers[i].Transition.StateBefore, barriers[i].Transition.StateAfter);
+
+    cmdList->ResourceBarrier(2, barriers);
+
+    if (!result)
+        return false;
+
+    LOG_TRACE("Setting velocity & depth from fused pass, index: {}", index);
+    _paramVelocity[index] = _paramVelocityCopy[index];
+    _paramDepth[index] = _paramDepthCopy[index];
+
+    return true;
+}
+
 void IFGFeature_Dx12::SetHudless(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless,
                                  D3D12_RESOURCE_STATES state, bool makeCopy)
 {
     auto index = GetIndex();
     LOG_TRACE("Index: {}, Resource: {:X}, CmdList: {:X}", index, (size_t) hudless, (size_t) cmdList);
 
-    _noHudless[index] = false;
+    _slots.Set(_frameCount, FGSlot_UsingHudless);
+
+    // Hudless copy is only skipped when over budget, game might change it before FG runs
+    if (makeCopy && VramTracker::SaveMemory(VramPressure::Critical))
+    {
+        ReleaseSlotCopy(&_paramHudlessCopy[index]);
+        makeCopy = false;
+    }
+
+    if (makeCopy && !FGHazard_Dx12::NeedsCopy(FGInput::Hudless, _frameCount, hudless, state))
+    {
+        ReleaseSlotCopy(&_paramHudlessCopy[index]);
+        makeCopy = false;
+    }
 
     if (cmdList == nullptr || !makeCopy)
     {
+        _paramHudlessState[index] = state;
         _paramHudless[index] = hudless;
         return;
     }
@@ -342,9 +500,11 @@ void IFGFeature_Dx12::ReleaseObjects()
 
     _mvFlip.reset();
     _depthFlip.reset();
+    _inputPrep.reset();
+    _hudlessValidation.reset();
 }
 
-ID3D12CommandList* IFGFeature_Dx12::GetCommandList() { return _commandList[GetIndex()]; }
+ID3D12CommandList* IFGFeature_Dx12::GetCommandList(UINT64 frameId) { return _commandList[frameId % BUFFER_COUNT]; }
 
 void IFGFeature_Dx12::Compare()
 {
@@ -370,15 +530,61 @@ void IFGFeature_Dx12::Compare()
     }
 }
 
+void IFGFeature_Dx12::ValidateHudless()
+{
+    if (!Config::Instance()->FGHUDValidation.value_or_default() || _device == nullptr || !IsActive() || IsPaused())
+        return;
+
+    if (_hudlessValidation.get() == nullptr)
+        _hudlessValidation = std::make_unique<HV_Dx12>("HudlessValidation", _device);
+
+    if (!_hudlessValidation->IsInit())
+        return;
+
+    std::vector<HVResult> results;
+    _hudlessValidation->Collect(results);
+
+    for (auto& result : results)
+        Hudfix_Dx12::HudlessValidated(result.candidate, result.histogram);
+
+    auto candidate = Hudfix_Dx12::ValidationCandidate();
+    auto fIndex = GetIndex();
+
+    if (candidate == nullptr || _paramHudless[fIndex] == nullptr || _swapChain == nullptr)
+        return;
+
+    IDXGISwapChain3* sc = nullptr;
+    if (_swapChain->QueryInterface(IID_PPV_ARGS(&sc)) != S_OK || sc == nullptr)
+        return;
+
+    ID3D12Resource* scBuffer = nullptr;
+    auto result = sc->GetBuffer(sc->GetCurrentBackBufferIndex(), IID_PPV_ARGS(&scBuffer));
+    sc->Release();
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("sc->GetBuffer error: {:X}", (UINT) result);
+        return;
+    }
+
+    _hudlessValidation->Dispatch(_gameCommandQueue, _paramHudless[fIndex], _paramHudlessState[fIndex], scBuffer,
+                                 candidate);
+
+    scBuffer->Release();
+}
+
 bool IFGFeature_Dx12::ExecuteCommandList()
 {
     LOG_DEBUG();
 
-    if (WaitingExecution())
+    UINT64 frame = _frameCount;
+
+    if (ClaimExecution(frame))
     {
-        auto cmdList = GetCommandList();
+        FGHazard_Dx12::FrameDone(frame);
+
+        auto cmdList = GetCommandList(frame);
         _gameCommandQueue->ExecuteCommandLists(1, &cmdList);
-        SetExecuted();
         return true;
     }
 
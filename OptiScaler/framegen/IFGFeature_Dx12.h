@@ -5,7 +5,9 @@
 #include <upscalers/IFeature.h>
 
 #include <shaders/resource_flip/RF_Dx12.h>
+#include <shaders/fg_inputs/FI_Dx12.h>
 #include <shaders/hudless_compare/HC_Dx12.h>
+#include <shaders/hudless_compare/HV_Dx12.h>
 
 #include <dxgi1_6.h>
 #include <d3d12.h>
@@ -15,10 +17,14 @@ class IFGFeature_Dx12 : public virtual IFGFeature
   private:
     std::unique_ptr<RF_Dx12> _mvFlip;
     std::unique_ptr<RF_Dx12> _depthFlip;
+    std::unique_ptr<FI_Dx12> _inputPrep;
     std::unique_ptr<HC_Dx12> _hudlessCompare;
+    std::unique_ptr<HV_Dx12> _hudlessValidation;
     ID3D12Device* _device = nullptr;
 
   protected:
+    IID streamlineRiid {};
+
     IDXGISwapChain* _swapChain = nullptr;
     ID3D12CommandQueue* _gameCommandQueue = nullptr;
     HWND _hwnd = NULL;
@@ -42,6 +48,7 @@ class IFGFeature_Dx12 : public virtual IFGFeature
                          D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
     bool CopyResource(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* source, ID3D12Resource** target,
                       D3D12_RESOURCE_STATES sourceState);
+    bool CheckForRealObject(std::string functionName, IUnknown* pObject, IUnknown** ppRealObject);
 
   public:
     virtual bool CreateSwapchain(IDXGIFactory* factory, ID3D12CommandQueue* cmdQueue, DXGI_SWAP_CHAIN_DESC* desc,
@@ -53,7 +60,9 @@ class IFGFeature_Dx12 : public virtual IFGFeature
 
     virtual void CreateContext(ID3D12Device* device, int featureFlags, uint32_t width, uint32_t height) = 0;
 
-    virtual bool Dispatch() = 0;
+    // Frame count can move on while another thread dispatches, caller passes the frame it checked
+    virtual bool Dispatch(UINT64 frame) = 0;
+    bool Dispatch() { return Dispatch(FrameCount()); }
 
     virtual void* FrameGenerationContext() = 0;
     virtual void* SwapchainContext() = 0;
@@ -64,12 +73,20 @@ class IFGFeature_Dx12 : public virtual IFGFeature
 
     void SetVelocity(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* velocity, D3D12_RESOURCE_STATES state);
     void SetDepth(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* depth, D3D12_RESOURCE_STATES state);
+
+    // Flips velocity & depth (and scales depth) in one dispatch when resource flip is enabled
+    // Returns false when SetVelocity and SetDepth should be used instead
+    bool PrepareInputs(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* velocity, ID3D12Resource* depth,
+                       bool scaleDepth);
     void SetHudless(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless, D3D12_RESOURCE_STATES state,
                     bool makeCopy = false);
 
     bool ExecuteCommandList();
-    ID3D12CommandList* GetCommandList();
+    ID3D12CommandList* GetCommandList(UINT64 frameId);
     void Compare();
 
+    // Dispatches GPU validation of current hudless and passes completed results to Hudfix
+    void ValidateHudless();
+
     IFGFeature_Dx12() = default;
 };
@@ -0,0 +1,222 @@
+#include "IFGFeature_Vk.h"
+
+#include <State.h>
+#include <Config.h>
+
+uint32_t IFGFeature_Vk::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties)
+{
+    VkPhysicalDeviceMemoryProperties memProperties {};
+    vkGetPhysicalDeviceMemoryProperties(_physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+    {
+        if ((typeBits & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            return i;
+    }
+
+    return UINT32_MAX;
+}
+
+bool IFGFeature_Vk::CreateImageResource(FGResourceVk* source, FGResourceVk* target, VkDeviceMemory* memory)
+{
+    if (_device == VK_NULL_HANDLE || source == nullptr || source->image == VK_NULL_HANDLE)
+        return false;
+
+    if (target->image != VK_NULL_HANDLE)
+    {
+        if (target->width == source->width && target->height == source->height && target->format == source->format)
+            return true;
+
+        vkDestroyImage(_device, target->image, nullptr);
+        vkFreeMemory(_device, *memory, nullptr);
+        target->image = VK_NULL_HANDLE;
+        *memory = VK_NULL_HANDLE;
+    }
+
+    VkImageCreateInfo imageInfo { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = source->format;
+    imageInfo.extent = { source->width, source->height, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto result = vkCreateImage(_device, &imageInfo, nullptr, &target->image);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkCreateImage error: {:X}", (UINT) result);
+        return false;
+    }
+
+    VkMemoryRequirements memReqs {};
+    vkGetImageMemoryRequirements(_device, target->image, &memReqs);
+
+    VkMemoryAllocateInfo allocInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocInfo.allocationSize = memReqs.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (allocInfo.memoryTypeIndex == UINT32_MAX ||
+        (result = vkAllocateMemory(_device, &allocInfo, nullptr, memory)) != VK_SUCCESS ||
+        (result = vkBindImageMemory(_device, target->image, *memory, 0)) != VK_SUCCESS)
+    {
+        LOG_ERROR("Image memory error: {:X}, memoryTypeIndex: {}", (UINT) result, allocInfo.memoryTypeIndex);
+
+        vkDestroyImage(_device, target->image, nullptr);
+
+        if (*memory != VK_NULL_HANDLE)
+            vkFreeMemory(_device, *memory, nullptr);
+
+        target->image = VK_NULL_HANDLE;
+        *memory = VK_NULL_HANDLE;
+        return false;
+    }
+
+    target->format = source->format;
+    target->width = source->width;
+    target->height = source->height;
+    target->depth = source->depth;
+    target->layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    LOG_DEBUG("Created new one: {}x{}", target->width, target->height);
+
+    return true;
+}
+
+void IFGFeature_Vk::ImageBarrier(VkCommandBuffer cmdBuffer, VkImage image, VkImageLayout oldLayout,
+                                 VkImageLayout newLayout, bool depth)
+{
+    VkImageMemoryBarrier barrier { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = depth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0,
+                         nullptr, 0, nullptr, 1, &barrier);
+}
+
+bool IFGFeature_Vk::CopyImage(VkCommandBuffer cmdBuffer, FGResourceVk* source, FGResourceVk* target,
+                              VkDeviceMemory* memory)
+{
+    if (cmdBuffer == VK_NULL_HANDLE || !CreateImageResource(source, target, memory))
+        return false;
+
+    ImageBarrier(cmdBuffer, source->image, source->layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, source->depth);
+    ImageBarrier(cmdBuffer, target->image, target->layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, target->depth);
+
+    VkImageCopy region {};
+    region.srcSubresource.aspectMask = source->depth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+    region.srcSubresource.layerCount = 1;
+    region.dstSubresource = region.srcSubresource;
+    region.extent = { source->width, source->height, 1 };
+
+    vkCmdCopyImage(cmdBuffer, source->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, target->image,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    ImageBarrier(cmdBuffer, source->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, source->layout, source->depth);
+    target->layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+    return true;
+}
+
+void IFGFeature_Vk::SetDevice(VkInstance instance, VkPhysicalDevice physicalDevice, VkDevice device,
+                              PFN_vkGetDeviceProcAddr gdpa)
+{
+    if (_device != VK_NULL_HANDLE && _device != device)
+        ReleaseObjects();
+
+    _instance = instance;
+    _physicalDevice = physicalDevice;
+    _device = device;
+    _gdpa = gdpa != nullptr ? gdpa : vkGetDeviceProcAddr;
+}
+
+void IFGFeature_Vk::SetQueues(FGQueueVk game, FGQueueVk asyncCompute, FGQueueVk present, FGQueueVk imageAcquire)
+{
+    _gameQueue = game;
+    _asyncComputeQueue = asyncCompute.queue != VK_NULL_HANDLE ? asyncCompute : game;
+    _presentQueue = present.queue != VK_NULL_HANDLE ? present : game;
+    _imageAcquireQueue = imageAcquire.queue != VK_NULL_HANDLE ? imageAcquire : _presentQueue;
+
+    LOG_DEBUG("Game: {:X}({}), Async: {:X}({}), Present: {:X}({}), Acquire: {:X}({})", (size_t) _gameQueue.queue,
+              _gameQueue.family, (size_t) _asyncComputeQueue.queue, _asyncComputeQueue.family,
+              (size_t) _presentQueue.queue, _presentQueue.family, (size_t) _imageAcquireQueue.queue,
+              _imageAcquireQueue.family);
+}
+
+bool IFGFeature_Vk::IsFGSwapchain(VkSwapchainKHR swapChain)
+{
+    return swapChain != VK_NULL_HANDLE && swapChain == _swapChain && SwapchainContext() != nullptr;
+}
+
+void IFGFeature_Vk::SetVelocity(FGResourceVk* velocity)
+{
+    auto index = GetIndex();
+
+    if (velocity == nullptr)
+        return;
+
+    LOG_TRACE("Setting velocity, index: {}", index);
+    _paramVelocity[index] = *velocity;
+}
+
+void IFGFeature_Vk::SetDepth(FGResourceVk* depth)
+{
+    auto index = GetIndex();
+
+    if (depth == nullptr)
+        return;
+
+    LOG_TRACE("Setting depth, index: {}", index);
+    _paramDepth[index] = *depth;
+}
+
+void IFGFeature_Vk::SetHudless(VkCommandBuffer cmdBuffer, FGResourceVk* hudless, bool makeCopy)
+{
+    auto index = GetIndex();
+    LOG_TRACE("Index: {}, Image: {:X}, CmdBuffer: {:X}", index, (size_t) hudless->image, (size_t) cmdBuffer);
+
+    _slots.Set(_frameCount, FGSlot_UsingHudless);
+
+    // Render pass final layouts are not tracked, hudless is expected to be sampled for HUD composition
+    if (hudless->layout == VK_IMAGE_LAYOUT_UNDEFINED)
+        hudless->layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    // Hudless is used by interpolation at present time, original image might be overwritten by then
+    if (makeCopy && CopyImage(cmdBuffer, hudless, &_paramHudlessCopy[index], &_hudlessMemory[index]))
+        _paramHudless[index] = _paramHudlessCopy[index];
+    else
+        _paramHudless[index] = *hudless;
+}
+
+void IFGFeature_Vk::ReleaseObjects()
+{
+    LOG_DEBUG("");
+
+    for (size_t i = 0; i < BUFFER_COUNT; i++)
+    {
+        if (_device != VK_NULL_HANDLE && _paramHudlessCopy[i].image != VK_NULL_HANDLE)
+            vkDestroyImage(_device, _paramHudlessCopy[i].image, nullptr);
+
+        if (_device != VK_NULL_HANDLE && _hudlessMemory[i] != VK_NULL_HANDLE)
+            vkFreeMemory(_device, _hudlessMemory[i], nullptr);
+
+        _paramHudlessCopy[i] = {};
+        _hudlessMemory[i] = VK_NULL_HANDLE;
+
+        _paramVelocity[i] = {};
+        _paramDepth[i] = {};
+        _paramHudless[i] = {};
+    }
+}
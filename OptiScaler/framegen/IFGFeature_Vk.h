@@ -0,0 +1,90 @@
+#pragma once
+#include <pch.h>
+#include "IFGFeature.h"
+
+#include <upscalers/IFeature.h>
+
+#include <vulkan/vulkan.hpp>
+
+typedef struct FGResourceVk
+{
+    VkImage image = VK_NULL_HANDLE;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    bool depth = false;
+} fg_resource_vk;
+
+typedef struct FGQueueVk
+{
+    VkQueue queue = VK_NULL_HANDLE;
+    uint32_t family = 0;
+} fg_queue_vk;
+
+class IFGFeature_Vk : public virtual IFGFeature
+{
+  private:
+    VkDeviceMemory _hudlessMemory[BUFFER_COUNT] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+    uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties);
+
+  protected:
+    VkInstance _instance = VK_NULL_HANDLE;
+    VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
+    VkDevice _device = VK_NULL_HANDLE;
+    PFN_vkGetDeviceProcAddr _gdpa = nullptr;
+
+    // Queues captured at device creation, missing ones fall back to game queue
+    FGQueueVk _gameQueue {};
+    FGQueueVk _asyncComputeQueue {};
+    FGQueueVk _presentQueue {};
+    FGQueueVk _imageAcquireQueue {};
+
+    // Handle returned to the game, might not be a real driver object
+    VkSwapchainKHR _swapChain = VK_NULL_HANDLE;
+    VkSwapchainCreateInfoKHR _swapChainInfo {};
+
+    FGResourceVk _paramVelocity[BUFFER_COUNT] = {};
+    FGResourceVk _paramDepth[BUFFER_COUNT] = {};
+    FGResourceVk _paramHudless[BUFFER_COUNT] = {};
+    FGResourceVk _paramHudlessCopy[BUFFER_COUNT] = {};
+
+    bool CreateImageResource(FGResourceVk* source, FGResourceVk* target, VkDeviceMemory* memory);
+    void ImageBarrier(VkCommandBuffer cmdBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                      bool depth = false);
+    bool CopyImage(VkCommandBuffer cmdBuffer, FGResourceVk* source, FGResourceVk* target, VkDeviceMemory* memory);
+
+  public:
+    virtual bool CreateSwapchain(VkDevice device, const VkSwapchainCreateInfoKHR* createInfo,
+                                 const VkAllocationCallbacks* allocator, VkSwapchainKHR* swapChain) = 0;
+    virtual bool ReleaseSwapchain(VkSwapchainKHR swapChain) = 0;
+
+    // Swapchain calls of the game are routed here when handle belongs to frame generation
+    virtual VkResult GetSwapchainImages(VkDevice device, VkSwapchainKHR swapChain, uint32_t* count,
+                                        VkImage* images) = 0;
+    virtual VkResult AcquireNextImage(VkDevice device, VkSwapchainKHR swapChain, uint64_t timeout,
+                                      VkSemaphore semaphore, VkFence fence, uint32_t* imageIndex) = 0;
+    virtual VkResult QueuePresent(VkQueue queue, const VkPresentInfoKHR* presentInfo) = 0;
+
+    virtual void CreateContext(int featureFlags, uint32_t width, uint32_t height) = 0;
+
+    virtual bool Dispatch(VkCommandBuffer cmdBuffer) = 0;
+
+    virtual void* FrameGenerationContext() = 0;
+    virtual void* SwapchainContext() = 0;
+
+    // IFGFeature
+    void ReleaseObjects() override final;
+
+    void SetDevice(VkInstance instance, VkPhysicalDevice physicalDevice, VkDevice device,
+                   PFN_vkGetDeviceProcAddr gdpa);
+    void SetQueues(FGQueueVk game, FGQueueVk asyncCompute, FGQueueVk present, FGQueueVk imageAcquire);
+    bool IsFGSwapchain(VkSwapchainKHR swapChain);
+
+    void SetVelocity(FGResourceVk* velocity);
+    void SetDepth(FGResourceVk* depth);
+    void SetHudless(VkCommandBuffer cmdBuffer, FGResourceVk* hudless, bool makeCopy = true);
+
+    IFGFeature_Vk() = default;
+};
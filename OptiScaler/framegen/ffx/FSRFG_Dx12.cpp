@@ -69,21 +69,26 @@ feature_version FSRFG_Dx12::Version()
 
 const char* FSRFG_Dx12::Name() { return "FSR-FG"; }
 
-bool FSRFG_Dx12::Dispatch()
+bool FSRFG_Dx12::Dispatch(UINT64 frame)
 {
     LOG_DEBUG();
 
-    _lastDispatchedFrame = _frameCount;
+    // Hudfix, upscaler and present hooks can all try to dispatch the same frame
+    if (!ClaimDispatch(frame))
+    {
+        LOG_DEBUG("Frame {} is already dispatched", frame);
+        return false;
+    }
 
     if (State::Instance().FSRFGFTPchanged)
         ConfigureFramePaceTuning();
 
-    auto fIndex = GetIndex();
+    auto fIndex = frame % BUFFER_COUNT;
 
     ffxConfigureDescFrameGeneration m_FrameGenerationConfig = {};
     m_FrameGenerationConfig.header.type = FFX_API_CONFIGURE_DESC_TYPE_FRAMEGENERATION;
 
-    if (!_noHudless[fIndex] && _paramHudless[fIndex] != nullptr)
+    if (_slots.Has(frame, FGSlot_UsingHudless) && _paramHudless[fIndex] != nullptr)
     {
         LOG_TRACE("Using hudless: {:X}", (size_t) _paramHudless[fIndex]);
         m_FrameGenerationConfig.HUDLessColor =
@@ -162,11 +167,11 @@ bool FSRFG_Dx12::Dispatch()
     };
 
     m_FrameGenerationConfig.onlyPresentGenerated = State::Instance().FGonlyGenerated;
-    m_FrameGenerationConfig.frameID = _frameCount;
+    m_FrameGenerationConfig.frameID = frame;
     m_FrameGenerationConfig.swapChain = State::Instance().currentSwapchain;
 
     ffxReturnCode_t retCode = FfxApiProxy::D3D12_Configure()(&_fgContext, &m_FrameGenerationConfig.header);
-    LOG_DEBUG("D3D12_Configure result: {0:X}, frame: {1}, fIndex: {2}", retCode, _frameCount, fIndex);
+    LOG_DEBUG("D3D12_Configure result: {0:X}, frame: {1}, fIndex: {2}", retCode, frame, fIndex);
 
     if (retCode == FFX_API_RETURN_OK)
     {
@@ -196,7 +201,7 @@ bool FSRFG_Dx12::Dispatch()
 
         dfgPrepare.commandList = _commandList[fIndex];
 
-        dfgPrepare.frameID = _frameCount;
+        dfgPrepare.frameID = frame;
         dfgPrepare.flags = m_FrameGenerationConfig.flags;
 
         dfgPrepare.renderSize = { State::Instance().currentFeature->RenderWidth(),
@@ -216,8 +221,8 @@ bool FSRFG_Dx12::Dispatch()
         dfgPrepare.viewSpaceToMetersFactor = _meterFactor;
 
         retCode = FfxApiProxy::D3D12_Dispatch()(&_fgContext, &dfgPrepare.header);
-        LOG_DEBUG("D3D12_Dispatch result: {0}, frame: {1}, fIndex: {2}, commandList: {3:X}", retCode, _frameCount,
-                  fIndex, (size_t) dfgPrepare.commandList);
+        LOG_DEBUG("D3D12_Dispatch result: {0}, frame: {1}, fIndex: {2}, commandList: {3:X}", retCode, frame, fIndex,
+                  (size_t) dfgPrepare.commandList);
 
         if (retCode == FFX_API_RETURN_OK)
             _commandList[fIndex]->Close();
@@ -229,9 +234,9 @@ bool FSRFG_Dx12::Dispatch()
         Mutex.unlockThis(1);
     };
 
-    _mvAndDepthReady[fIndex] = false;
-    _hudlessReady[fIndex] = false;
-    _waitingExecute[fIndex] = true;
+    // Inputs are consumed, command list is executed with game's or at present
+    _slots.Transition(frame, FGSlot_None, FGSlot_None, retCode == FFX_API_RETURN_OK ? FGSlot_Prepared : FGSlot_None,
+                      FGSlot_InputsReady | FGSlot_HudlessReady);
 
     return retCode == FFX_API_RETURN_OK;
 }
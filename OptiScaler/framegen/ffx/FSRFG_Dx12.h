@@ -32,7 +32,7 @@ class FSRFG_Dx12 : public virtual IFGFeature_Dx12
 
     void CreateContext(ID3D12Device* device, int featureFlags, uint32_t width, uint32_t height) override final;
 
-    bool Dispatch() override final;
+    bool Dispatch(UINT64 frame) override final;
 
     void* FrameGenerationContext() override final;
     void* SwapchainContext() override final;
@@ -0,0 +1,450 @@
+#include "FSRFG_Vk.h"
+
+#include <State.h>
+
+#include <upscalers/IFeature.h>
+
+typedef struct FfxSwapchainFramePacingTuning
+{
+    float safetyMarginInMs;  // in Millisecond. Default is 0.1ms
+    float varianceFactor;    // valid range [0.0,1.0]. Default is 0.1
+    bool allowHybridSpin;    // Allows pacing spinlock to sleep. Default is false.
+    uint32_t hybridSpinTime; // How long to spin if allowHybridSpin is true. Measured in timer resolution units. Not
+                             // recommended to go below 2. Will result in frequent overshoots. Default is 2.
+    bool allowWaitForSingleObjectOnFence; // Allows WaitForSingleObject instead of spinning for fence value. Default is
+                                          // false.
+} FfxSwapchainFramePacingTuning;
+
+static uint32_t LayoutToFfxState(VkImageLayout layout)
+{
+    switch (layout)
+    {
+    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+        return FFX_API_RESOURCE_STATE_COPY_DEST;
+    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+        return FFX_API_RESOURCE_STATE_COPY_SRC;
+    case VK_IMAGE_LAYOUT_GENERAL:
+        return FFX_API_RESOURCE_STATE_UNORDERED_ACCESS;
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+        return FFX_API_RESOURCE_STATE_RENDER_TARGET;
+    default:
+        return FFX_API_RESOURCE_STATE_PIXEL_COMPUTE_READ;
+    }
+}
+
+void FSRFG_Vk::ConfigureFramePaceTuning()
+{
+    State::Instance().FSRFGFTPchanged = false;
+
+    if (_swapChainContext == nullptr || Version() < feature_version { 3, 1, 3 })
+        return;
+
+    FfxSwapchainFramePacingTuning fpt {};
+    if (Config::Instance()->FGFramePacingTuning.value_or_default())
+    {
+        fpt.allowHybridSpin = Config::Instance()->FGFPTAllowHybridSpin.value_or_default();
+        fpt.allowWaitForSingleObjectOnFence =
+            Config::Instance()->FGFPTAllowWaitForSingleObjectOnFence.value_or_default();
+        fpt.hybridSpinTime = Config::Instance()->FGFPTHybridSpinTime.value_or_default();
+        fpt.safetyMarginInMs = Config::Instance()->FGFPTSafetyMarginInMs.value_or_default();
+        fpt.varianceFactor = Config::Instance()->FGFPTVarianceFactor.value_or_default();
+
+        ffxConfigureDescFrameGenerationSwapChainKeyValueVK cfgDesc {};
+        cfgDesc.header.type = FFX_API_CONFIGURE_DESC_TYPE_FGSWAPCHAIN_KEYVALUE_VK;
+        cfgDesc.key = 2; // FfxSwapchainFramePacingTuning
+        cfgDesc.ptr = &fpt;
+
+        auto result = FfxApiProxy::VULKAN_Configure()(&_swapChainContext, &cfgDesc.header);
+        LOG_DEBUG("HybridSpin VULKAN_Configure result: {}", FfxApiProxy::ReturnCodeToString(result));
+    }
+}
+
+FfxApiResource FSRFG_Vk::GetResource(FGResourceVk* resource, uint32_t state)
+{
+    if (resource == nullptr || resource->image == VK_NULL_HANDLE)
+        return FfxApiResource({});
+
+    FfxApiResourceDescription desc {};
+    desc.type = FFX_API_RESOURCE_TYPE_TEXTURE2D;
+    desc.format = ffxApiGetSurfaceFormatVK(resource->format);
+    desc.width = resource->width;
+    desc.height = resource->height;
+    desc.depth = 1;
+    desc.mipCount = 1;
+    desc.flags = FFX_API_RESOURCE_FLAGS_NONE;
+    desc.usage = FFX_API_RESOURCE_USAGE_READ_ONLY;
+
+    if (resource->depth)
+        desc.usage |= FFX_API_RESOURCE_USAGE_DEPTHTARGET;
+
+    return ffxApiGetResourceVK((void*) resource->image, desc, state);
+}
+
+feature_version FSRFG_Vk::Version()
+{
+    if (FfxApiProxy::InitFfxVk())
+    {
+        auto ver = FfxApiProxy::VersionVk();
+        return ver;
+    }
+
+    return { 0, 0, 0 };
+}
+
+const char* FSRFG_Vk::Name() { return "FSR-FG"; }
+
+bool FSRFG_Vk::Dispatch(VkCommandBuffer cmdBuffer)
+{
+    LOG_DEBUG();
+
+    if (cmdBuffer == VK_NULL_HANDLE || State::Instance().currentFeature == nullptr)
+        return false;
+
+    UINT64 frame = _frameCount;
+
+    // Hudfix, upscaler and present hooks can all try to dispatch the same frame
+    if (!ClaimDispatch(frame))
+    {
+        LOG_DEBUG("Frame {} is already dispatched", frame);
+        return false;
+    }
+
+    if (State::Instance().FSRFGFTPchanged)
+        ConfigureFramePaceTuning();
+
+    auto fIndex = frame % BUFFER_COUNT;
+
+    ffxConfigureDescFrameGeneration m_FrameGenerationConfig = {};
+    m_FrameGenerationConfig.header.type = FFX_API_CONFIGURE_DESC_TYPE_FRAMEGENERATION;
+
+    if (_slots.Has(frame, FGSlot_UsingHudless) && _paramHudless[fIndex].image != VK_NULL_HANDLE)
+    {
+        LOG_TRACE("Using hudless: {:X}", (size_t) _paramHudless[fIndex].image);
+        m_FrameGenerationConfig.HUDLessColor =
+            GetResource(&_paramHudless[fIndex], LayoutToFfxState(_paramHudless[fIndex].layout));
+    }
+    else
+    {
+        m_FrameGenerationConfig.HUDLessColor = FfxApiResource({});
+    }
+
+    m_FrameGenerationConfig.frameGenerationEnabled = true;
+    m_FrameGenerationConfig.flags = 0;
+
+    if (Config::Instance()->FGDebugView.value_or_default())
+        m_FrameGenerationConfig.flags |= FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_VIEW;
+
+    if (Config::Instance()->FGDebugTearLines.value_or_default())
+        m_FrameGenerationConfig.flags |= FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_TEAR_LINES;
+
+    if (Config::Instance()->FGDebugResetLines.value_or_default())
+        m_FrameGenerationConfig.flags |= FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_RESET_INDICATORS;
+
+    if (Config::Instance()->FGDebugPacingLines.value_or_default())
+        m_FrameGenerationConfig.flags |= FFX_FRAMEGENERATION_FLAG_DRAW_DEBUG_PACING_LINES;
+
+    m_FrameGenerationConfig.allowAsyncWorkloads = Config::Instance()->FGAsync.value_or_default();
+
+    // use swapchain buffer info
+    auto feature = State::Instance().currentFeature;
+    auto calculatedLeft = (_swapChainInfo.imageExtent.width - feature->DisplayWidth()) / 2;
+    auto calculatedTop = (_swapChainInfo.imageExtent.height - feature->DisplayHeight()) / 2;
+    m_FrameGenerationConfig.generationRect.left = Config::Instance()->FGRectLeft.value_or(calculatedLeft);
+    m_FrameGenerationConfig.generationRect.top = Config::Instance()->FGRectTop.value_or(calculatedTop);
+    m_FrameGenerationConfig.generationRect.width = Config::Instance()->FGRectWidth.value_or(feature->DisplayWidth());
+    m_FrameGenerationConfig.generationRect.height =
+        Config::Instance()->FGRectHeight.value_or(feature->DisplayHeight());
+
+    m_FrameGenerationConfig.frameGenerationCallbackUserContext = this;
+    m_FrameGenerationConfig.frameGenerationCallback = [](ffxDispatchDescFrameGeneration* params,
+                                                         void* pUserCtx) -> ffxReturnCode_t
+    {
+        FSRFG_Vk* fsrFG = nullptr;
+
+        if (pUserCtx != nullptr)
+            fsrFG = reinterpret_cast<FSRFG_Vk*>(pUserCtx);
+
+        if (fsrFG != nullptr)
+            return fsrFG->DispatchCallback(params);
+
+        return FFX_API_RETURN_ERROR;
+    };
+
+    m_FrameGenerationConfig.onlyPresentGenerated = State::Instance().FGonlyGenerated;
+    m_FrameGenerationConfig.frameID = frame;
+    m_FrameGenerationConfig.swapChain = (void*) _swapChain;
+
+    ffxReturnCode_t retCode = FfxApiProxy::VULKAN_Configure()(&_fgContext, &m_FrameGenerationConfig.header);
+    LOG_DEBUG("VULKAN_Configure result: {0:X}, frame: {1}, fIndex: {2}", retCode, frame, fIndex);
+
+    if (retCode == FFX_API_RETURN_OK)
+    {
+        // Prepare is recorded to game's command buffer, inputs are valid at this point of the frame
+        ffxDispatchDescFrameGenerationPrepare dfgPrepare {};
+        dfgPrepare.header.type = FFX_API_DISPATCH_DESC_TYPE_FRAMEGENERATION_PREPARE;
+        dfgPrepare.commandList = cmdBuffer;
+
+        dfgPrepare.frameID = frame;
+        dfgPrepare.flags = m_FrameGenerationConfig.flags;
+
+        dfgPrepare.renderSize = { feature->RenderWidth(), feature->RenderHeight() };
+
+        dfgPrepare.jitterOffset.x = _jitterX;
+        dfgPrepare.jitterOffset.y = _jitterY;
+        dfgPrepare.motionVectors =
+            GetResource(&_paramVelocity[fIndex], LayoutToFfxState(_paramVelocity[fIndex].layout));
+        dfgPrepare.depth = GetResource(&_paramDepth[fIndex], LayoutToFfxState(_paramDepth[fIndex].layout));
+
+        dfgPrepare.motionVectorScale.x = _mvScaleX;
+        dfgPrepare.motionVectorScale.y = _mvScaleY;
+        dfgPrepare.cameraFar = _cameraFar;
+        dfgPrepare.cameraNear = _cameraNear;
+        dfgPrepare.cameraFovAngleVertical = _cameraVFov;
+        dfgPrepare.frameTimeDelta = _ftDelta;
+        dfgPrepare.viewSpaceToMetersFactor = _meterFactor;
+
+        retCode = FfxApiProxy::VULKAN_Dispatch()(&_fgContext, &dfgPrepare.header);
+        LOG_DEBUG("VULKAN_Dispatch result: {0}, frame: {1}, fIndex: {2}, cmdBuffer: {3:X}", retCode, frame, fIndex,
+                  (size_t) cmdBuffer);
+    }
+
+    // Nothing left to execute, prepare is already in game's command buffer
+    _slots.Clear(frame, FGSlot_InputsReady | FGSlot_HudlessReady);
+
+    return retCode == FFX_API_RETURN_OK;
+}
+
+ffxReturnCode_t FSRFG_Vk::DispatchCallback(ffxDispatchDescFrameGeneration* params)
+{
+    ffxReturnCode_t dispatchResult = FFX_API_RETURN_OK;
+    int fIndex = params->frameID % BUFFER_COUNT;
+
+    LOG_DEBUG("frameID: {}, commandList: {:X}, numGeneratedFrames: {}", params->frameID, (size_t) params->commandList,
+              params->numGeneratedFrames);
+
+    // check for status
+    if (!Config::Instance()->FGEnabled.value_or_default() || _fgContext == nullptr || State::Instance().SCchanged)
+    {
+        LOG_WARN("Cancel async dispatch");
+        params->numGeneratedFrames = 0;
+    }
+
+    // If fg is active but upscaling paused
+    if (State::Instance().currentFeature == nullptr || State::Instance().FGchanged || fIndex < 0 || !IsActive() ||
+        State::Instance().currentFeature->FrameCount() == 0 || params->frameID == _lastUpscaledFrameId)
+    {
+        LOG_WARN("Upscaling paused! frameID: {}", params->frameID);
+        params->numGeneratedFrames = 0;
+    }
+
+    dispatchResult = FfxApiProxy::VULKAN_Dispatch()(&_fgContext, &params->header);
+    LOG_DEBUG("VULKAN_Dispatch result: {}, fIndex: {}", (UINT) dispatchResult, fIndex);
+
+    _lastUpscaledFrameId = params->frameID;
+
+    return dispatchResult;
+}
+
+void* FSRFG_Vk::FrameGenerationContext()
+{
+    LOG_DEBUG("");
+    return (void*) _fgContext;
+}
+
+void* FSRFG_Vk::SwapchainContext() { return _swapChainContext; }
+
+void FSRFG_Vk::StopAndDestroyContext(bool destroy, bool shutDown, bool useMutex)
+{
+    _frameCount = 0;
+
+    LOG_DEBUG("");
+
+    if (!(shutDown || State::Instance().isShuttingDown) && _fgContext != nullptr)
+    {
+        ffxConfigureDescFrameGeneration m_FrameGenerationConfig = {};
+        m_FrameGenerationConfig.header.type = FFX_API_CONFIGURE_DESC_TYPE_FRAMEGENERATION;
+        m_FrameGenerationConfig.frameGenerationEnabled = false;
+        m_FrameGenerationConfig.swapChain = (void*) _swapChain;
+        m_FrameGenerationConfig.presentCallback = nullptr;
+        m_FrameGenerationConfig.HUDLessColor = FfxApiResource({});
+
+        auto result = FfxApiProxy::VULKAN_Configure()(&_fgContext, &m_FrameGenerationConfig.header);
+
+        _isActive = false;
+
+        LOG_INFO("VULKAN_Configure result: {0:X}", result);
+    }
+
+    if (destroy && _fgContext != nullptr)
+    {
+        auto result = FfxApiProxy::VULKAN_DestroyContext()(&_fgContext, nullptr);
+
+        if (!(shutDown || State::Instance().isShuttingDown))
+            LOG_INFO("VULKAN_DestroyContext result: {0:X}", result);
+
+        _fgContext = nullptr;
+        _isActive = false;
+    }
+
+    if (shutDown || State::Instance().isShuttingDown)
+        ReleaseObjects();
+}
+
+bool FSRFG_Vk::CreateSwapchain(VkDevice device, const VkSwapchainCreateInfoKHR* createInfo,
+                               const VkAllocationCallbacks* allocator, VkSwapchainKHR* swapChain)
+{
+    if (_physicalDevice == VK_NULL_HANDLE || _gameQueue.queue == VK_NULL_HANDLE)
+    {
+        LOG_ERROR("Device or queues are not captured!");
+        return false;
+    }
+
+    ffxCreateContextDescFrameGenerationSwapChainVK createSwapChainDesc {};
+    createSwapChainDesc.header.type = FFX_API_CREATE_CONTEXT_DESC_TYPE_FGSWAPCHAIN_VK;
+    createSwapChainDesc.physicalDevice = _physicalDevice;
+    createSwapChainDesc.device = device;
+    createSwapChainDesc.swapchain = swapChain;
+    createSwapChainDesc.allocator = allocator;
+    createSwapChainDesc.createInfo = *createInfo;
+    createSwapChainDesc.gameQueue = { _gameQueue.queue, _gameQueue.family, 0 };
+    createSwapChainDesc.asyncComputeQueue = { _asyncComputeQueue.queue, _asyncComputeQueue.family, 0 };
+    createSwapChainDesc.presentQueue = { _presentQueue.queue, _presentQueue.family, 0 };
+    createSwapChainDesc.imageAcquireQueue = { _imageAcquireQueue.queue, _imageAcquireQueue.family, 0 };
+
+    auto result = FfxApiProxy::VULKAN_CreateContext()(&_swapChainContext, &createSwapChainDesc.header, nullptr);
+    LOG_INFO("Create Ffx Swapchain Result: {}({})", result, FfxApiProxy::ReturnCodeToString(result));
+
+    if (result != FFX_API_RETURN_OK)
+        return false;
+
+    _scFunctions = {};
+    _scFunctions.header.type = FFX_API_QUERY_DESC_TYPE_FGSWAPCHAIN_FUNCTIONS_VK;
+    result = FfxApiProxy::VULKAN_Query()(&_swapChainContext, &_scFunctions.header);
+
+    if (result != FFX_API_RETURN_OK || _scFunctions.pOutQueuePresentKHR == nullptr)
+    {
+        LOG_ERROR("Swapchain functions VULKAN_Query result: {}", FfxApiProxy::ReturnCodeToString(result));
+        FfxApiProxy::VULKAN_DestroyContext()(&_swapChainContext, nullptr);
+        _swapChainContext = nullptr;
+        return false;
+    }
+
+    ConfigureFramePaceTuning();
+
+    _swapChain = *swapChain;
+    _swapChainInfo = *createInfo;
+    _swapChainInfo.pNext = nullptr;
+    _swapChainInfo.pQueueFamilyIndices = nullptr;
+
+    return true;
+}
+
+bool FSRFG_Vk::ReleaseSwapchain(VkSwapchainKHR swapChain)
+{
+    if (!IsFGSwapchain(swapChain))
+        return false;
+
+    LOG_DEBUG("");
+
+    if (_fgContext != nullptr)
+        StopAndDestroyContext(true, false, false);
+
+    auto result = FfxApiProxy::VULKAN_DestroyContext()(&_swapChainContext, nullptr);
+    LOG_INFO("Destroy Ffx Swapchain Result: {}({})", result, FfxApiProxy::ReturnCodeToString(result));
+
+    _swapChainContext = nullptr;
+    _swapChain = VK_NULL_HANDLE;
+    _scFunctions = {};
+
+    return true;
+}
+
+VkResult FSRFG_Vk::GetSwapchainImages(VkDevice device, VkSwapchainKHR swapChain, uint32_t* count, VkImage* images)
+{
+    return _scFunctions.pOutGetSwapchainImagesKHR(device, swapChain, count, images);
+}
+
+VkResult FSRFG_Vk::AcquireNextImage(VkDevice device, VkSwapchainKHR swapChain, uint64_t timeout,
+                                    VkSemaphore semaphore, VkFence fence, uint32_t* imageIndex)
+{
+    return _scFunctions.pOutAcquireNextImageKHR(device, swapChain, timeout, semaphore, fence, imageIndex);
+}
+
+VkResult FSRFG_Vk::QueuePresent(VkQueue queue, const VkPresentInfoKHR* presentInfo)
+{
+    return _scFunctions.pOutQueuePresentKHR(queue, presentInfo);
+}
+
+void FSRFG_Vk::CreateContext(int featureFlags, uint32_t width, uint32_t height)
+{
+    LOG_DEBUG("");
+
+    if (_fgContext != nullptr)
+    {
+        ffxConfigureDescFrameGeneration m_FrameGenerationConfig = {};
+        m_FrameGenerationConfig.header.type = FFX_API_CONFIGURE_DESC_TYPE_FRAMEGENERATION;
+        m_FrameGenerationConfig.frameGenerationEnabled = true;
+        m_FrameGenerationConfig.swapChain = (void*) _swapChain;
+        m_FrameGenerationConfig.presentCallback = nullptr;
+        m_FrameGenerationConfig.HUDLessColor = FfxApiResource({});
+
+        auto result = FfxApiProxy::VULKAN_Configure()(&_fgContext, &m_FrameGenerationConfig.header);
+
+        _isActive = (result == FFX_API_RETURN_OK);
+
+        LOG_DEBUG("Reactivate");
+
+        return;
+    }
+
+    ffxCreateBackendVKDesc backendDesc {};
+    backendDesc.header.type = FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK;
+    backendDesc.vkDevice = _device;
+    backendDesc.vkPhysicalDevice = _physicalDevice;
+    backendDesc.vkDeviceProcAddr = _gdpa;
+
+    ffxCreateContextDescFrameGeneration createFg {};
+    createFg.header.type = FFX_API_CREATE_CONTEXT_DESC_TYPE_FRAMEGENERATION;
+
+    // use swapchain buffer info
+    if (_swapChain != VK_NULL_HANDLE)
+    {
+        createFg.displaySize = { _swapChainInfo.imageExtent.width, _swapChainInfo.imageExtent.height };
+        createFg.maxRenderSize = { width, height };
+    }
+    else
+    {
+        // this might cause issues
+        createFg.displaySize = { width, height };
+        createFg.maxRenderSize = { width, height };
+    }
+
+    createFg.flags = 0;
+
+    if (featureFlags & NVSDK_NGX_DLSS_Feature_Flags_IsHDR)
+        createFg.flags |= FFX_FRAMEGENERATION_ENABLE_HIGH_DYNAMIC_RANGE;
+
+    if (featureFlags & NVSDK_NGX_DLSS_Feature_Flags_DepthInverted)
+        createFg.flags |= FFX_FRAMEGENERATION_ENABLE_DEPTH_INVERTED;
+
+    if (featureFlags & NVSDK_NGX_DLSS_Feature_Flags_MVJittered)
+        createFg.flags |= FFX_FRAMEGENERATION_ENABLE_MOTION_VECTORS_JITTER_CANCELLATION;
+
+    if ((featureFlags & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes) == 0)
+        createFg.flags |= FFX_FRAMEGENERATION_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS;
+
+    if (Config::Instance()->FGAsync.value_or_default())
+        createFg.flags |= FFX_FRAMEGENERATION_ENABLE_ASYNC_WORKLOAD_SUPPORT;
+
+    createFg.backBufferFormat = ffxApiGetSurfaceFormatVK(_swapChainInfo.imageFormat);
+    createFg.header.pNext = &backendDesc.header;
+
+    State::Instance().skipSpoofing = true;
+    ffxReturnCode_t retCode = FfxApiProxy::VULKAN_CreateContext()(&_fgContext, &createFg.header, nullptr);
+    State::Instance().skipSpoofing = false;
+    LOG_INFO("VULKAN_CreateContext result: {0:X}", retCode);
+
+    _isActive = (retCode == FFX_API_RETURN_OK);
+
+    LOG_DEBUG("Create");
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <framegen/IFGFeature_Vk.h>
+
+#include <proxies/FfxApi_Proxy.h>
+
+#include <vk/ffx_api_vk.h>
+#include <ffx_framegeneration.h>
+
+class FSRFG_Vk : public virtual IFGFeature_Vk
+{
+  private:
+    ffxContext _swapChainContext = nullptr;
+    ffxContext _fgContext = nullptr;
+    ffxQueryDescSwapchainReplacementFunctionsVK _scFunctions {};
+
+    FfxApiResource GetResource(FGResourceVk* resource, uint32_t state);
+
+  public:
+    // IFGFeature
+    const char* Name() override final;
+    feature_version Version() override final;
+
+    void StopAndDestroyContext(bool destroy, bool shutDown, bool useMutex) override final;
+
+    // IFGFeature_Vk
+    bool CreateSwapchain(VkDevice device, const VkSwapchainCreateInfoKHR* createInfo,
+                         const VkAllocationCallbacks* allocator, VkSwapchainKHR* swapChain) override final;
+    bool ReleaseSwapchain(VkSwapchainKHR swapChain) override final;
+
+    VkResult GetSwapchainImages(VkDevice device, VkSwapchainKHR swapChain, uint32_t* count,
+                                VkImage* images) override final;
+    VkResult AcquireNextImage(VkDevice device, VkSwapchainKHR swapChain, uint64_t timeout, VkSemaphore semaphore,
+                              VkFence fence, uint32_t* imageIndex) override final;
+    VkResult QueuePresent(VkQueue queue, const VkPresentInfoKHR* presentInfo) override final;
+
+    void CreateContext(int featureFlags, uint32_t width, uint32_t height) override final;
+
+    bool Dispatch(VkCommandBuffer cmdBuffer) override final;
+
+    void* FrameGenerationContext() override final;
+    void* SwapchainContext() override final;
+
+    // Methods
+    void ConfigureFramePaceTuning();
+
+    ffxReturnCode_t DispatchCallback(ffxDispatchDescFrameGeneration* params);
+
+    FSRFG_Vk() : IFGFeature_Vk(), IFGFeature()
+    {
+        //
+    }
+};
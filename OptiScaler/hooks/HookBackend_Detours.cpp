@@ -0,0 +1,63 @@
+#include "HookBackend_Detours.h"
+
+#include <detours/detours.h>
+
+bool DetoursHookBackend::Begin()
+{
+    if (DetourTransactionBegin() != NO_ERROR)
+    {
+        LOG_ERROR("Can't begin hook transaction!");
+        return false;
+    }
+
+    // An open transaction would fail every later Begin
+    if (DetourUpdateThread(GetCurrentThread()) != NO_ERROR)
+    {
+        LOG_ERROR("DetourUpdateThread failed!");
+        DetourTransactionAbort();
+        return false;
+    }
+
+    return true;
+}
+
+bool DetoursHookBackend::Attach(void** original, void* detour)
+{
+    auto result = DetourAttach(original, detour);
+
+    if (result != NO_ERROR)
+    {
+        LOG_WARN("Attach failed for {:X}, error: {}, it's dropped", (size_t) detour, result);
+        return false;
+    }
+
+    return true;
+}
+
+bool DetoursHookBackend::Detach(void** original, void* detour)
+{
+    auto result = DetourDetach(original, detour);
+
+    if (result != NO_ERROR)
+    {
+        LOG_WARN("Detach failed for {:X}, error: {}", (size_t) detour, result);
+        return false;
+    }
+
+    return true;
+}
+
+bool DetoursHookBackend::Commit()
+{
+    auto result = DetourTransactionCommit();
+
+    if (result != NO_ERROR)
+    {
+        LOG_ERROR("Hook transaction commit failed, error: {}", result);
+        return false;
+    }
+
+    return true;
+}
+
+void DetoursHookBackend::Abort() { DetourTransactionAbort(); }
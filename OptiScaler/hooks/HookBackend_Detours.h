@@ -0,0 +1,16 @@
+#pragma once
+
+#include <pch.h>
+
+#include "HookRegistry.h"
+
+// HookRegistry backend using Detours, failures are logged here
+class DetoursHookBackend : public IHookBackend
+{
+  public:
+    bool Begin() override;
+    bool Attach(void** original, void* detour) override;
+    bool Detach(void** original, void* detour) override;
+    bool Commit() override;
+    void Abort() override;
+};
@@ -0,0 +1,167 @@
+#include "HookRegistry.h"
+
+bool HookRegistry::IsPending(const HookEntry& entry)
+{
+    if (entry.failed)
+        return false;
+
+    if (entry.remove)
+        return entry.attached;
+
+    return !entry.attached;
+}
+
+bool HookRegistry::CommitPending()
+{
+    auto succeeded = true;
+
+    // Each pass either commits or drops one failing entry, so this ends
+    while (true)
+    {
+        size_t pending = 0;
+
+        for (auto& entry : _entries)
+        {
+            if (IsPending(entry))
+                pending++;
+        }
+
+        if (pending == 0)
+        {
+            // Drop entries that were never attached
+            std::erase_if(_entries,
+                          [](const HookEntry& entry) { return !entry.attached && (entry.remove || entry.failed); });
+            return succeeded;
+        }
+
+        if (_backend == nullptr || !_backend->Begin())
+            return false;
+
+        std::vector<HookEntry*> changed;
+        changed.reserve(pending);
+
+        HookEntry* failed = nullptr;
+
+        for (auto& entry : _entries)
+        {
+            if (!IsPending(entry))
+                continue;
+
+            bool result;
+
+            if (entry.attached)
+                result = _backend->Detach(entry.original, entry.detour);
+            else
+                result = _backend->Attach(entry.original, entry.detour);
+
+            if (!result)
+            {
+                failed = &entry;
+                break;
+            }
+
+            changed.push_back(&entry);
+        }
+
+        // Transaction can't be committed after a failed operation, retry the batch without the failing entry
+        if (failed != nullptr)
+        {
+            _backend->Abort();
+            failed->failed = true;
+            succeeded = false;
+            continue;
+        }
+
+        if (!_backend->Commit())
+        {
+            _backend->Abort();
+            return false;
+        }
+
+        for (auto entry : changed)
+        {
+            entry->attached = !entry->attached;
+
+            if (entry->remove)
+                *entry->original = nullptr;
+        }
+    }
+}
+
+void HookRegistry::Queue(HookGroup group, void** original, void* detour)
+{
+    if (original == nullptr || *original == nullptr || detour == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto& entry : _entries)
+    {
+        if (entry.original == original)
+        {
+            // Re-queued after removal, keep the existing hook
+            entry.remove = false;
+            entry.failed = false;
+            return;
+        }
+    }
+
+    HookEntry entry {};
+    entry.group = group;
+    entry.original = original;
+    entry.detour = detour;
+
+    _entries.push_back(entry);
+}
+
+void HookRegistry::Remove(void** original)
+{
+    if (original == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    bool found = false;
+
+    for (auto& entry : _entries)
+    {
+        if (entry.original == original)
+        {
+            entry.remove = true;
+            entry.failed = false;
+            found = true;
+            break;
+        }
+    }
+
+    if (found)
+        CommitPending();
+}
+
+bool HookRegistry::Commit()
+{
+    if (_batchDepth > 0)
+        return true;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return CommitPending();
+}
+
+void HookRegistry::BeginBatch() { _batchDepth++; }
+
+void HookRegistry::EndBatch()
+{
+    if (_batchDepth == 0)
+        return;
+
+    _batchDepth--;
+
+    if (_batchDepth == 0)
+        Commit();
+}
+
+void HookRegistry::SetBackend(IHookBackend* backend)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _backend = backend;
+}
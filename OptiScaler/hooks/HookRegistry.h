@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Groups of hooks that can be enabled / disabled together
+enum class HookGroup : uint32_t
+{
+    Dx12Device = 0,      // HooksDx device hooks (sampler, UE Intel atomics spoofing)
+    ResTrackHeaps,       // Descriptor heap creation & resource release tracking
+    ResTrackDescriptors, // View creation & descriptor copies
+    ResTrackHudless,     // Command list hooks used only for hudless detection
+    ResTrackFG,          // Queue & command list hooks needed for OptiFG command list handling
+    RootSignature,       // NVNGX root signature restore hooks
+    Streamline,          // Streamline plugin hooks
+    ResTrackVkObjects,   // Vulkan image, view, framebuffer & descriptor tracking
+    ResTrackVkCommands,  // Vulkan command buffer hooks used only for hudless detection
+    DescriptorHeaps,     // Game descriptor heaps of command lists, bound back after OptiScaler passes
+    Count
+};
+
+// Interface to the hooking library, DetoursHookBackend is set at process attach
+// A failed Attach or Detach makes the whole transaction fail, like Detours does
+class IHookBackend
+{
+  public:
+    virtual bool Begin() = 0;
+    virtual bool Attach(void** original, void* detour) = 0;
+    virtual bool Detach(void** original, void* detour) = 0;
+    virtual bool Commit() = 0;
+    virtual void Abort() = 0;
+
+    virtual ~IHookBackend() = default;
+};
+
+// Collects vtable & function hooks and applies them in a single transaction.
+// Each Detours commit suspends threads and flushes instruction caches,
+// so hooks are queued and committed at well defined points.
+class HookRegistry
+{
+  private:
+    typedef struct HookEntry
+    {
+        HookGroup group = HookGroup::Dx12Device;
+        void** original = nullptr;
+        void* detour = nullptr;
+        bool attached = false;
+        bool remove = false;
+        bool failed = false; // backend refused it, not retried
+    } hook_entry;
+
+    inline static std::mutex _mutex;
+    inline static std::vector<HookEntry> _entries;
+
+    inline static IHookBackend* _backend = nullptr;
+
+    // Batch depth of calling thread, commits are deferred while > 0
+    inline static thread_local uint32_t _batchDepth = 0;
+
+    static bool IsPending(const HookEntry& entry);
+    static bool CommitPending();
+
+  public:
+    // Queue a hook, it will be attached with next commit
+    static void Queue(HookGroup group, void** original, void* detour);
+
+    // Queue removal of a hook, original pointer is set to nullptr if it was attached
+    // Flushes immediately because callers usually reuse the original pointer right after
+    static void Remove(void** original);
+
+    // Apply all pending changes in one transaction, deferred while a batch is open on this thread
+    // A hook the backend refuses is dropped and the rest are committed without it, returns false in that case
+    static bool Commit();
+
+    static void BeginBatch();
+    static void EndBatch();
+
+    static void SetBackend(IHookBackend* backend);
+};
+
+// Defers commits of this thread until end of scope
+class HookBatch
+{
+  public:
+    HookBatch() { HookRegistry::BeginBatch(); }
+    ~HookBatch() { HookRegistry::EndBatch(); }
+
+    HookBatch(const HookBatch&) = delete;
+    HookBatch& operator=(const HookBatch&) = delete;
+};
@@ -4,11 +4,14 @@
 #include <Config.h>
 
 #include "wrapped_swapchain.h"
+#include "HookRegistry.h"
 
 #include <hudfix/Hudfix_Dx12.h>
 #include <menu/menu_overlay_dx.h>
 #include <framegen/ffx/FSRFG_Dx12.h>
+#include <framegen/FGPacing.h>
 #include <resource_tracking/ResTrack_Dx12.h>
+#include <shaders/DescriptorHeap_Dx12.h>
 
 #include <proxies/Dxgi_Proxy.h>
 #include <proxies/D3D12_Proxy.h>
@@ -242,6 +245,7 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
                     State::Instance().frameTimeMutex.lock();
                     State::Instance().upscaleTimes.push_back(elapsedTimeMs);
                     State::Instance().upscaleTimes.pop_front();
+                    State::Instance().upscaleTimeCount++;
                     State::Instance().frameTimeMutex.unlock();
                 }
             }
@@ -269,12 +273,15 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
     if (willPresent && State::Instance().currentCommandQueue != nullptr && State::Instance().activeFgType == OptiFG &&
         fg->IsActive())
     {
+        fg->ValidateHudless();
         fg->Compare();
 
+        auto frame = fg->FrameCount();
+
         if (!fg->IsPaused() && !fg->IsDispatched() && fg->UpscalerInputsReady())
         {
             LOG_WARN("Dispatch FG from present");
-            fg->Dispatch();
+            fg->Dispatch(frame);
         }
 
         // ResTrack_Dx12::ExecuteWaitingCommandLists();
@@ -289,6 +296,7 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
     if (willPresent)
     {
         ResTrack_Dx12::ClearPossibleHudless();
+        ResTrack_Dx12::UpdateTrackingMode();
         Hudfix_Dx12::PresentStart();
     }
 
@@ -408,6 +416,9 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
         State::Instance().swapchainApi = DX12;
         State::Instance().currentCommandQueue = cq;
 
+        // Descriptors used by OptiScaler passes of this frame are recycled when the queue reaches here
+        DescriptorHeap_Dx12::EndFrame(cq);
+
         if (cq->GetDevice(IID_PPV_ARGS(&device12)) == S_OK)
         {
             if (!_dx12Device)
@@ -452,6 +463,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
                 State::Instance().frameTimeMutex.lock();
                 State::Instance().upscaleTimes.push_back(elapsedTimeMs);
                 State::Instance().upscaleTimes.pop_front();
+                State::Instance().upscaleTimeCount++;
                 State::Instance().frameTimeMutex.unlock();
             }
         }
@@ -493,6 +505,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
                         State::Instance().frameTimeMutex.lock();
                         State::Instance().upscaleTimes.push_back(elapsedTimeMs);
                         State::Instance().upscaleTimes.pop_front();
+                        State::Instance().upscaleTimeCount++;
                         State::Instance().frameTimeMutex.unlock();
                     }
                 }
@@ -548,6 +561,13 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
     else
         presentResult = ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
 
+    // Same frame type guess with fakenvapi, counter is already increased for next present
+    if (willPresent && presentResult == S_OK && State::Instance().activeFgType == OptiFG && fg != nullptr &&
+        fg->IsActive())
+    {
+        FGPacing::Present(pSwapChain, (_frameCounter - 1) % 2);
+    }
+
     // release used objects
     if (cq != nullptr)
         cq->Release();
@@ -856,6 +876,8 @@ static HRESULT hkCreateSwapChain(IDXGIFactory* pFactory, IUnknown* pDevice, DXGI
 
         if (scResult)
         {
+            FGPacing::Reset();
+
             if (o_FGSCPresent == nullptr && *ppSwapChain != nullptr)
             {
                 void** pFactoryVTable = *reinterpret_cast<void***>(*ppSwapChain);
@@ -1138,6 +1160,8 @@ static HRESULT hkCreateSwapChainForHwnd(IDXGIFactory* This, IUnknown* pDevice, H
 
         if (scResult)
         {
+            FGPacing::Reset();
+
             if (o_FGSCPresent == nullptr && *ppSwapChain != nullptr)
             {
                 void** pFactoryVTable = *reinterpret_cast<void***>(*ppSwapChain);
@@ -1578,38 +1602,30 @@ static void HookToDevice(ID3D12Device* InDevice)
     o_CreateCommittedResource = (PFN_CreateCommittedResource) pVTable[27];
     o_CreatePlacedResource = (PFN_CreatePlacedResource) pVTable[29];
 
-    // Apply the detour
+    // Device and resource tracking hooks are committed together at end of scope
+    HookBatch batch;
+
     if (o_CreateSampler != nullptr)
     {
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        if (o_CreateSampler != nullptr)
-            DetourAttach(&(PVOID&) o_CreateSampler, hkCreateSampler);
+        HookRegistry::Queue(HookGroup::Dx12Device, &(PVOID&) o_CreateSampler, hkCreateSampler);
 
         if (Config::Instance()->UESpoofIntelAtomics64.value_or_default())
         {
-            if (o_CheckFeatureSupport != nullptr)
-                DetourAttach(&(PVOID&) o_CheckFeatureSupport, hkCheckFeatureSupport);
-
-            if (o_CreateCommittedResource != nullptr)
-                DetourAttach(&(PVOID&) o_CreateCommittedResource, hkCreateCommittedResource);
-
-            if (o_CreatePlacedResource != nullptr)
-                DetourAttach(&(PVOID&) o_CreatePlacedResource, hkCreatePlacedResource);
-
-            if (o_D3D12DeviceRelease != nullptr)
-                DetourAttach(&(PVOID&) o_D3D12DeviceRelease, hkD3D12DeviceRelease);
+            HookRegistry::Queue(HookGroup::Dx12Device, &(PVOID&) o_CheckFeatureSupport, hkCheckFeatureSupport);
+            HookRegistry::Queue(HookGroup::Dx12Device, &(PVOID&) o_CreateCommittedResource, hkCreateCommittedResource);
+            HookRegistry::Queue(HookGroup::Dx12Device, &(PVOID&) o_CreatePlacedResource, hkCreatePlacedResource);
+            HookRegistry::Queue(HookGroup::Dx12Device, &(PVOID&) o_D3D12DeviceRelease, hkD3D12DeviceRelease);
 
             // This does not work but luckily
             // UE works without Intel Extension for it
-            // if (o_GetResourceAllocationInfo != nullptr)
-            //    DetourAttach(&(PVOID&) o_GetResourceAllocationInfo, hkGetResourceAllocationInfo);
+            // HookRegistry::Queue(HookGroup::Dx12Device, &(PVOID&) o_GetResourceAllocationInfo,
+            //                     hkGetResourceAllocationInfo);
         }
-
-        DetourTransactionCommit();
     }
 
+    // Game heaps are restored after OptiScaler passes, command lists recorded from now on are tracked
+    DescriptorHeap_Dx12::HookDevice(realDevice != nullptr ? realDevice : InDevice);
+
     if (State::Instance().activeFgType == FGType::OptiFG && Config::Instance()->OverlayMenu.value_or_default())
         ResTrack_Dx12::HookDevice(InDevice);
 }
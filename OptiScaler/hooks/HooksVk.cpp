@@ -4,11 +4,14 @@
 #include <Config.h>
 
 #include <menu/menu_overlay_vk.h>
+#include <resource_tracking/ResTrack_Vk.h>
+#include <framegen/ffx/FSRFG_Vk.h>
 
 #include <proxies/Kernel32_Proxy.h>
 
 #include <detours/detours.h>
 #include <misc/FrameLimit.h>
+#include <misc/RenderScale.h>
 #include <nvapi/ReflexHooks.h>
 
 // for menu rendering
@@ -19,6 +22,30 @@ static HWND _hwnd = nullptr;
 
 static std::mutex _vkPresentMutex;
 
+// frame generation
+typedef struct FGQueueRequest
+{
+    uint32_t family = UINT32_MAX;
+    uint32_t index = 0;
+} fg_queue_request;
+
+static FGQueueRequest _fgGameRequest {};
+static FGQueueRequest _fgPresentRequest {};
+static FGQueueRequest _fgAsyncRequest {};
+static FGQueueVk _fgGameQueue {};
+static FGQueueVk _fgPresentQueue {};
+static FGQueueVk _fgAsyncQueue {};
+static bool _skipFGSwapchainCreation = false;
+
+// Queues game got from the device, game queue of frame generation must be the one game presents on
+static ankerl::unordered_dense::map<VkQueue, FGQueueRequest> _gameQueues;
+static FGQueueVk _gamePresentQueue {};
+static FGQueueVk _fgSwapchainGameQueue {};
+static std::mutex _gameQueueMutex;
+
+// FG swapchains released while game recreates the swapchain, game will still try to destroy them
+static ankerl::unordered_dense::set<VkSwapchainKHR> _releasedFGSwapchains;
+
 // hooking
 typedef VkResult (*PFN_QueuePresentKHR)(VkQueue, const VkPresentInfoKHR*);
 typedef VkResult (*PFN_CreateSwapchainKHR)(VkDevice, const VkSwapchainCreateInfoKHR*, const VkAllocationCallbacks*,
@@ -32,12 +59,28 @@ PFN_vkCreateWin32SurfaceKHR o_vkCreateWin32SurfaceKHR = nullptr;
 PFN_vkCmdPipelineBarrier o_vkCmdPipelineBarrier = nullptr;
 PFN_QueuePresentKHR o_QueuePresentKHR = nullptr;
 PFN_CreateSwapchainKHR o_CreateSwapchainKHR = nullptr;
+PFN_vkDestroySwapchainKHR o_DestroySwapchainKHR = nullptr;
+PFN_vkGetSwapchainImagesKHR o_GetSwapchainImagesKHR = nullptr;
+PFN_vkAcquireNextImageKHR o_AcquireNextImageKHR = nullptr;
+PFN_vkGetDeviceQueue o_vkGetDeviceQueue = nullptr;
+PFN_vkGetDeviceQueue2 o_vkGetDeviceQueue2 = nullptr;
 
 static VkResult hkvkCreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo,
                                  const VkAllocationCallbacks* pAllocator, VkDevice* pDevice);
 static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInfo);
 static VkResult hkvkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo,
                                        VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain);
+static void hkvkDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator);
+static VkResult hkvkGetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t* pSwapchainImageCount,
+                                          VkImage* pSwapchainImages);
+static VkResult hkvkAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout,
+                                        VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex);
+
+static bool IsFGEnabled()
+{
+    return Config::Instance()->OverlayMenu.value_or_default() && State::Instance().activeFgType == FGType::OptiFG &&
+           Config::Instance()->FGVulkan.value_or_default();
+}
 
 static void HookDevice(VkDevice InDevice)
 {
@@ -49,6 +92,16 @@ static void HookDevice(VkDevice InDevice)
     o_QueuePresentKHR = (PFN_QueuePresentKHR) (vkGetDeviceProcAddr(InDevice, "vkQueuePresentKHR"));
     o_CreateSwapchainKHR = (PFN_CreateSwapchainKHR) (vkGetDeviceProcAddr(InDevice, "vkCreateSwapchainKHR"));
 
+    // Needed to route game's swapchain calls to frame generation swapchain
+    if (IsFGEnabled())
+    {
+        o_DestroySwapchainKHR =
+            (PFN_vkDestroySwapchainKHR) (vkGetDeviceProcAddr(InDevice, "vkDestroySwapchainKHR"));
+        o_GetSwapchainImagesKHR =
+            (PFN_vkGetSwapchainImagesKHR) (vkGetDeviceProcAddr(InDevice, "vkGetSwapchainImagesKHR"));
+        o_AcquireNextImageKHR = (PFN_vkAcquireNextImageKHR) (vkGetDeviceProcAddr(InDevice, "vkAcquireNextImageKHR"));
+    }
+
     if (o_CreateSwapchainKHR)
     {
         LOG_DEBUG("Hooking VkDevice");
@@ -60,6 +113,15 @@ static void HookDevice(VkDevice InDevice)
         DetourAttach(&(PVOID&) o_QueuePresentKHR, hkvkQueuePresentKHR);
         DetourAttach(&(PVOID&) o_CreateSwapchainKHR, hkvkCreateSwapchainKHR);
 
+        if (o_DestroySwapchainKHR != nullptr)
+            DetourAttach(&(PVOID&) o_DestroySwapchainKHR, hkvkDestroySwapchainKHR);
+
+        if (o_GetSwapchainImagesKHR != nullptr)
+            DetourAttach(&(PVOID&) o_GetSwapchainImagesKHR, hkvkGetSwapchainImagesKHR);
+
+        if (o_AcquireNextImageKHR != nullptr)
+            DetourAttach(&(PVOID&) o_AcquireNextImageKHR, hkvkAcquireNextImageKHR);
+
         DetourTransactionCommit();
     }
 }
@@ -165,13 +227,245 @@ static VkResult hkvkCreateInstance(const VkInstanceCreateInfo* pCreateInfo, cons
     return result;
 }
 
+// Frame generation swapchain presents from its own queues, request them next to game's queues
+static void AddFGQueues(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo,
+                        std::vector<VkDeviceQueueCreateInfo>& queueInfos, std::vector<std::vector<float>>& priorities)
+{
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    queueInfos.assign(pCreateInfo->pQueueCreateInfos,
+                      pCreateInfo->pQueueCreateInfos + pCreateInfo->queueCreateInfoCount);
+
+    // Inner vectors must not move after their data is referenced
+    priorities.resize(queueInfos.size() + 1);
+
+    _fgGameRequest = {};
+    _fgPresentRequest = {};
+    _fgAsyncRequest = {};
+
+    bool computeFamilyUsed = false;
+
+    for (size_t i = 0; i < queueInfos.size(); i++)
+    {
+        auto family = queueInfos[i].queueFamilyIndex;
+
+        if (family >= familyCount || queueInfos[i].flags != 0)
+            continue;
+
+        auto flags = families[family].queueFlags;
+        bool graphics = (flags & VK_QUEUE_GRAPHICS_BIT) > 0;
+        bool compute = !graphics && (flags & VK_QUEUE_COMPUTE_BIT) > 0;
+        computeFamilyUsed |= compute;
+
+        if ((!graphics && !compute) || (graphics && _fgGameRequest.family != UINT32_MAX) ||
+            (compute && _fgAsyncRequest.family != UINT32_MAX))
+        {
+            continue;
+        }
+
+        // Fallback if game queues aren't captured, first queue of graphics family
+        if (graphics)
+            _fgGameRequest = { family, 0 };
+
+        if (queueInfos[i].queueCount >= families[family].queueCount)
+            continue;
+
+        if (graphics)
+            _fgPresentRequest = { family, queueInfos[i].queueCount };
+        else
+            _fgAsyncRequest = { family, queueInfos[i].queueCount };
+
+        priorities[i].assign(queueInfos[i].pQueuePriorities,
+                             queueInfos[i].pQueuePriorities + queueInfos[i].queueCount);
+        priorities[i].push_back(1.0f);
+
+        queueInfos[i].queueCount = (uint32_t) priorities[i].size();
+        queueInfos[i].pQueuePriorities = priorities[i].data();
+    }
+
+    if (!computeFamilyUsed)
+    {
+        for (uint32_t family = 0; family < familyCount; family++)
+        {
+            auto flags = families[family].queueFlags;
+
+            if ((flags & VK_QUEUE_GRAPHICS_BIT) > 0 || (flags & VK_QUEUE_COMPUTE_BIT) == 0)
+                continue;
+
+            priorities.back() = { 1.0f };
+
+            VkDeviceQueueCreateInfo queueInfo { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+            queueInfo.queueFamilyIndex = family;
+            queueInfo.queueCount = 1;
+            queueInfo.pQueuePriorities = priorities.back().data();
+            queueInfos.push_back(queueInfo);
+
+            _fgAsyncRequest = { family, 0 };
+            break;
+        }
+    }
+
+    LOG_DEBUG("Game: {}/{}, Present: {}/{}, Async: {}/{}", _fgGameRequest.family, _fgGameRequest.index,
+              _fgPresentRequest.family, _fgPresentRequest.index, _fgAsyncRequest.family, _fgAsyncRequest.index);
+}
+
+static void AddGameQueue(uint32_t family, uint32_t index, VkQueue queue)
+{
+    if (queue == VK_NULL_HANDLE)
+        return;
+
+    // Queues added for frame generation
+    if ((family == _fgPresentRequest.family && index == _fgPresentRequest.index) ||
+        (family == _fgAsyncRequest.family && index == _fgAsyncRequest.index))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_gameQueueMutex);
+
+    if (_gameQueues.insert({ queue, { family, index } }).second)
+        LOG_DEBUG("Game queue: {:X}, family: {}, index: {}", (size_t) queue, family, index);
+}
+
+static void hkvkGetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue* pQueue)
+{
+    o_vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, pQueue);
+
+    if (pQueue != nullptr)
+        AddGameQueue(queueFamilyIndex, queueIndex, *pQueue);
+}
+
+static void hkvkGetDeviceQueue2(VkDevice device, const VkDeviceQueueInfo2* pQueueInfo, VkQueue* pQueue)
+{
+    o_vkGetDeviceQueue2(device, pQueueInfo, pQueue);
+
+    if (pQueueInfo != nullptr && pQueue != nullptr && pQueueInfo->flags == 0)
+        AddGameQueue(pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, *pQueue);
+}
+
+// Queue which presented last, or first queue game got which can present to the surface
+static FGQueueVk GetGameQueue(VkSurfaceKHR surface)
+{
+    std::lock_guard<std::mutex> lock(_gameQueueMutex);
+
+    if (_gamePresentQueue.queue != VK_NULL_HANDLE)
+        return _gamePresentQueue;
+
+    for (auto& [queue, request] : _gameQueues)
+    {
+        VkBool32 supported = VK_FALSE;
+
+        if (_PD == VK_NULL_HANDLE ||
+            vkGetPhysicalDeviceSurfaceSupportKHR(_PD, request.family, surface, &supported) != VK_SUCCESS)
+        {
+            break;
+        }
+
+        if (supported == VK_TRUE)
+            return { queue, request.family };
+    }
+
+    // No captured queue can present, expect the first queue of graphics family
+    return _fgGameQueue;
+}
+
+// Game queue of frame generation swapchain is a guess until the first present, returns false if it was wrong
+static bool CapturePresentQueue(VkQueue queue)
+{
+    std::lock_guard<std::mutex> lock(_gameQueueMutex);
+
+    if (_gamePresentQueue.queue != VK_NULL_HANDLE)
+        return true;
+
+    auto it = _gameQueues.find(queue);
+    if (it == _gameQueues.end())
+    {
+        LOG_WARN("Present queue {:X} is unknown, using {:X}", (size_t) queue, (size_t) _fgSwapchainGameQueue.queue);
+        _gamePresentQueue = _fgSwapchainGameQueue;
+        return true;
+    }
+
+    _gamePresentQueue = { queue, it->second.family };
+
+    if (queue == _fgSwapchainGameQueue.queue)
+        return true;
+
+    LOG_INFO("Game presents on queue {:X} ({}/{}), recreating FG swapchain", (size_t) queue, it->second.family,
+             it->second.index);
+
+    return false;
+}
+
+static FGQueueVk GetFGQueue(VkDevice device, FGQueueRequest request)
+{
+    FGQueueVk queue {};
+
+    if (request.family == UINT32_MAX)
+        return queue;
+
+    vkGetDeviceQueue(device, request.family, request.index, &queue.queue);
+    queue.family = request.family;
+
+    return queue;
+}
+
 static VkResult hkvkCreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo,
                                  const VkAllocationCallbacks* pAllocator, VkDevice* pDevice)
 {
     LOG_FUNC();
 
+    VkDeviceCreateInfo createInfo {};
+    std::vector<VkDeviceQueueCreateInfo> queueInfos;
+    std::vector<std::vector<float>> queuePriorities;
+    bool fgQueues = IsFGEnabled() && pCreateInfo != nullptr && pCreateInfo->pQueueCreateInfos != nullptr &&
+                    !State::Instance().vulkanSkipHooks;
+
+    if (fgQueues)
+    {
+        AddFGQueues(physicalDevice, pCreateInfo, queueInfos, queuePriorities);
+
+        createInfo = *pCreateInfo;
+        createInfo.queueCreateInfoCount = (uint32_t) queueInfos.size();
+        createInfo.pQueueCreateInfos = queueInfos.data();
+        pCreateInfo = &createInfo;
+    }
+
     auto result = o_vkCreateDevice(physicalDevice, pCreateInfo, pAllocator, pDevice);
 
+    if (result == VK_SUCCESS && fgQueues)
+    {
+        _fgGameQueue = GetFGQueue(*pDevice, _fgGameRequest);
+        _fgPresentQueue = GetFGQueue(*pDevice, _fgPresentRequest);
+        _fgAsyncQueue = GetFGQueue(*pDevice, _fgAsyncRequest);
+
+        {
+            std::lock_guard<std::mutex> lock(_gameQueueMutex);
+            _gameQueues.clear();
+            _gamePresentQueue = {};
+        }
+
+        // Game gets its queues right after device creation
+        if (o_vkGetDeviceQueue == nullptr)
+        {
+            o_vkGetDeviceQueue = (PFN_vkGetDeviceQueue) vkGetDeviceProcAddr(*pDevice, "vkGetDeviceQueue");
+            o_vkGetDeviceQueue2 = (PFN_vkGetDeviceQueue2) vkGetDeviceProcAddr(*pDevice, "vkGetDeviceQueue2");
+
+            DetourTransactionBegin();
+            DetourUpdateThread(GetCurrentThread());
+
+            if (o_vkGetDeviceQueue != nullptr)
+                DetourAttach(&(PVOID&) o_vkGetDeviceQueue, hkvkGetDeviceQueue);
+
+            if (o_vkGetDeviceQueue2 != nullptr)
+                DetourAttach(&(PVOID&) o_vkGetDeviceQueue2, hkvkGetDeviceQueue2);
+
+            DetourTransactionCommit();
+        }
+    }
+
     if (o_vkCmdPipelineBarrier == nullptr)
     {
         o_vkCmdPipelineBarrier = (PFN_vkCmdPipelineBarrier) vkGetDeviceProcAddr(*pDevice, "vkCmdPipelineBarrier");
@@ -194,6 +488,7 @@ static VkResult hkvkCreateDevice(VkPhysicalDevice physicalDevice, const VkDevice
         _device = *pDevice;
         LOG_DEBUG("_device captured: {0:X}", (UINT64) _device);
         HookDevice(_device);
+        ResTrack_Vk::HookDevice(_device);
 
         State::Instance().skipSpoofing = true;
 
@@ -217,6 +512,14 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
 {
     LOG_FUNC();
 
+    auto fg = State::Instance().currentVkFG;
+    bool fgPresent =
+        fg != nullptr && pPresentInfo->swapchainCount > 0 && fg->IsFGSwapchain(pPresentInfo->pSwapchains[0]);
+
+    // Presents of real swapchain from frame generation's present thread
+    if (fg != nullptr && fg->SwapchainContext() != nullptr && !fgPresent)
+        return o_QueuePresentKHR(queue, pPresentInfo);
+
     // get upscaler time
     if (HooksVk::vkUpscaleTrig && HooksVk::queryPool != VK_NULL_HANDLE)
     {
@@ -233,6 +536,7 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
             State::Instance().frameTimeMutex.lock();
             State::Instance().upscaleTimes.push_back(elapsedTimeMs);
             State::Instance().upscaleTimes.pop_front();
+            State::Instance().upscaleTimeCount++;
             State::Instance().frameTimeMutex.unlock();
         }
 
@@ -241,6 +545,8 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
 
     State::Instance().swapchainApi = Vulkan;
 
+    RenderScale::Present();
+
     // Tick feature to let it know if it's frozen
     if (auto currentFeature = State::Instance().currentFeature; currentFeature != nullptr)
         currentFeature->TickFrozenCheck();
@@ -254,9 +560,22 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
 
     ReflexHooks::update(false, true);
 
+    ResTrack_Vk::ClearPossibleHudless();
+    ResTrack_Vk::UpdateHookState();
+
+    // Game queue of FG swapchain was wrong, game recreates the swapchain with the present queue
+    if (fgPresent && !CapturePresentQueue(queue))
+        return VK_ERROR_OUT_OF_DATE_KHR;
+
     // original call
     State::Instance().vulkanCreatingSC = true;
-    auto result = o_QueuePresentKHR(queue, pPresentInfo);
+    VkResult result;
+
+    if (fgPresent)
+        result = fg->QueuePresent(queue, pPresentInfo);
+    else
+        result = o_QueuePresentKHR(queue, pPresentInfo);
+
     State::Instance().vulkanCreatingSC = false;
 
     // Unsure about Vulkan Reflex fps limit and if that could be causing an issue here
@@ -272,9 +591,69 @@ static VkResult hkvkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
 {
     LOG_FUNC();
 
-    State::Instance().vulkanCreatingSC = true;
-    auto result = o_CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
-    State::Instance().vulkanCreatingSC = false;
+    // Real swapchain of frame generation
+    if (_skipFGSwapchainCreation)
+        return o_CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
+
+    VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+    bool fgCreated = false;
+    VkSwapchainCreateInfoKHR createInfo {};
+
+    if (pCreateInfo != nullptr)
+    {
+        createInfo = *pCreateInfo;
+        pCreateInfo = &createInfo;
+    }
+
+    FGQueueVk gameQueue {};
+
+    if (pCreateInfo != nullptr && IsFGEnabled() && !State::Instance().vulkanSkipHooks)
+        gameQueue = GetGameQueue(pCreateInfo->surface);
+
+    if (gameQueue.queue != VK_NULL_HANDLE && FfxApiProxy::InitFfxVk())
+    {
+        // FG Init
+        if (State::Instance().currentVkFG == nullptr)
+            State::Instance().currentVkFG = new FSRFG_Vk();
+
+        auto fg = State::Instance().currentVkFG;
+
+        // Frame generation swapchain can't be passed to driver as old swapchain
+        if (fg->IsFGSwapchain(createInfo.oldSwapchain))
+        {
+            _releasedFGSwapchains.insert(createInfo.oldSwapchain);
+            fg->ReleaseSwapchain(createInfo.oldSwapchain);
+            createInfo.oldSwapchain = VK_NULL_HANDLE;
+            State::Instance().SCchanged = true;
+        }
+
+        fg->SetDevice(_instance, _PD, device, nullptr);
+        fg->SetQueues(gameQueue, _fgAsyncQueue, _fgPresentQueue, {});
+        _fgSwapchainGameQueue = gameQueue;
+
+        _skipFGSwapchainCreation = true;
+        State::Instance().vulkanCreatingSC = true;
+
+        *pSwapchain = VK_NULL_HANDLE;
+        fgCreated = fg->CreateSwapchain(device, &createInfo, pAllocator, pSwapchain);
+
+        State::Instance().vulkanCreatingSC = false;
+        _skipFGSwapchainCreation = false;
+
+        if (fgCreated)
+        {
+            LOG_INFO("Created FG swapchain: {:X}", (size_t) *pSwapchain);
+            _releasedFGSwapchains.erase(*pSwapchain);
+            result = VK_SUCCESS;
+        }
+    }
+
+    if (!fgCreated)
+    {
+        State::Instance().vulkanCreatingSC = true;
+        result = o_CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
+        State::Instance().vulkanCreatingSC = false;
+    }
 
     if (result == VK_SUCCESS && device != VK_NULL_HANDLE && pCreateInfo != nullptr && *pSwapchain != VK_NULL_HANDLE &&
         !State::Instance().vulkanSkipHooks)
@@ -282,6 +661,9 @@ static VkResult hkvkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
         State::Instance().screenWidth = pCreateInfo->imageExtent.width;
         State::Instance().screenHeight = pCreateInfo->imageExtent.height;
 
+        Hudfix_Vk::SwapchainCreated(pCreateInfo->imageExtent.width, pCreateInfo->imageExtent.height,
+                                    pCreateInfo->imageFormat);
+
         LOG_DEBUG("if (result == VK_SUCCESS && device != VK_NULL_HANDLE && pCreateInfo != nullptr && pSwapchain != "
                   "VK_NULL_HANDLE)");
 
@@ -295,6 +677,41 @@ static VkResult hkvkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
     return result;
 }
 
+static void hkvkDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator)
+{
+    LOG_FUNC();
+
+    auto fg = State::Instance().currentVkFG;
+    if (fg != nullptr && fg->ReleaseSwapchain(swapchain))
+        return;
+
+    // Already released while game was recreating the swapchain
+    if (_releasedFGSwapchains.erase(swapchain) > 0)
+        return;
+
+    o_DestroySwapchainKHR(device, swapchain, pAllocator);
+}
+
+static VkResult hkvkGetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t* pSwapchainImageCount,
+                                          VkImage* pSwapchainImages)
+{
+    auto fg = State::Instance().currentVkFG;
+    if (fg != nullptr && fg->IsFGSwapchain(swapchain))
+        return fg->GetSwapchainImages(device, swapchain, pSwapchainImageCount, pSwapchainImages);
+
+    return o_GetSwapchainImagesKHR(device, swapchain, pSwapchainImageCount, pSwapchainImages);
+}
+
+static VkResult hkvkAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout,
+                                        VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex)
+{
+    auto fg = State::Instance().currentVkFG;
+    if (fg != nullptr && fg->IsFGSwapchain(swapchain))
+        return fg->AcquireNextImage(device, swapchain, timeout, semaphore, fence, pImageIndex);
+
+    return o_AcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, pImageIndex);
+}
+
 void HooksVk::HookVk(HMODULE vulkan1)
 {
     if (o_vkCreateDevice != nullptr)
@@ -340,6 +757,15 @@ void HooksVk::UnHookVk()
     if (o_CreateSwapchainKHR != nullptr)
         DetourDetach(&(PVOID&) o_CreateSwapchainKHR, hkvkCreateSwapchainKHR);
 
+    if (o_DestroySwapchainKHR != nullptr)
+        DetourDetach(&(PVOID&) o_DestroySwapchainKHR, hkvkDestroySwapchainKHR);
+
+    if (o_GetSwapchainImagesKHR != nullptr)
+        DetourDetach(&(PVOID&) o_GetSwapchainImagesKHR, hkvkGetSwapchainImagesKHR);
+
+    if (o_AcquireNextImageKHR != nullptr)
+        DetourDetach(&(PVOID&) o_AcquireNextImageKHR, hkvkAcquireNextImageKHR);
+
     if (o_vkCreateDevice != nullptr)
         DetourDetach(&(PVOID&) o_vkCreateDevice, hkvkCreateDevice);
 
@@ -352,5 +778,11 @@ void HooksVk::UnHookVk()
     if (o_vkCmdPipelineBarrier != nullptr)
         DetourDetach(&(PVOID&) o_vkCmdPipelineBarrier, hkvkCmdPipelineBarrier);
 
+    if (o_vkGetDeviceQueue != nullptr)
+        DetourDetach(&(PVOID&) o_vkGetDeviceQueue, hkvkGetDeviceQueue);
+
+    if (o_vkGetDeviceQueue2 != nullptr)
+        DetourDetach(&(PVOID&) o_vkGetDeviceQueue2, hkvkGetDeviceQueue2);
+
     DetourTransactionCommit();
 }
@@ -2,6 +2,7 @@
 
 #include <json.hpp>
 #include "detours/detours.h"
+#include "HookRegistry.h"
 
 #include <Util.h>
 #include <Config.h>
@@ -9,6 +10,7 @@
 #include <menu/menu_overlay_base.h>
 #include <nvapi/ReflexHooks.h>
 #include <magic_enum.hpp>
+#include <misc/BackendPreloader.h>
 #include <sl1_reflex.h>
 #include "include/sl.param/parameters.h"
 
@@ -580,7 +582,7 @@ void StreamlineHooks::hookInterposer(HMODULE slInterposer)
         GetModuleFileNameA(slInterposer, dllPath, MAX_PATH);
 
         Util::version_t sl_version;
-        Util::GetDLLVersion(string_to_wstring(dllPath), &sl_version);
+        BackendPreloader::GetDLLVersion(string_to_wstring(dllPath), &sl_version);
 
         State::Instance().streamlineVersion.major = sl_version.major;
         State::Instance().streamlineVersion.minor = sl_version.minor;
@@ -635,16 +637,11 @@ void StreamlineHooks::unhookDlss()
 {
     LOG_FUNC();
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
     if (o_dlss_slGetPluginFunction)
     {
-        DetourDetach(&(PVOID&) o_dlss_slGetPluginFunction, hkdlss_slGetPluginFunction);
+        HookRegistry::Remove(&(PVOID&) o_dlss_slGetPluginFunction);
         o_dlss_slGetPluginFunction = nullptr;
     }
-
-    DetourTransactionCommit();
 }
 
 void StreamlineHooks::hookDlss(HMODULE slDlss)
@@ -666,12 +663,8 @@ void StreamlineHooks::hookDlss(HMODULE slDlss)
     if (o_dlss_slGetPluginFunction != nullptr)
     {
         LOG_TRACE("Hooking slGetPluginFunction in sl.dlss");
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        DetourAttach(&(PVOID&) o_dlss_slGetPluginFunction, hkdlss_slGetPluginFunction);
-
-        DetourTransactionCommit();
+        HookRegistry::Queue(HookGroup::Streamline, &(PVOID&) o_dlss_slGetPluginFunction, hkdlss_slGetPluginFunction);
+        HookRegistry::Commit();
     }
 }
 
@@ -681,16 +674,11 @@ void StreamlineHooks::unhookDlssg()
 {
     LOG_FUNC();
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
     if (o_dlssg_slGetPluginFunction)
     {
-        DetourDetach(&(PVOID&) o_dlssg_slGetPluginFunction, hkdlssg_slGetPluginFunction);
+        HookRegistry::Remove(&(PVOID&) o_dlssg_slGetPluginFunction);
         o_dlssg_slGetPluginFunction = nullptr;
     }
-
-    DetourTransactionCommit();
 }
 
 void StreamlineHooks::hookDlssg(HMODULE slDlssg)
@@ -712,12 +700,8 @@ void StreamlineHooks::hookDlssg(HMODULE slDlssg)
     if (o_dlssg_slGetPluginFunction != nullptr)
     {
         LOG_TRACE("Hooking slGetPluginFunction in sl.dlssg");
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        DetourAttach(&(PVOID&) o_dlssg_slGetPluginFunction, hkdlssg_slGetPluginFunction);
-
-        DetourTransactionCommit();
+        HookRegistry::Queue(HookGroup::Streamline, &(PVOID&) o_dlssg_slGetPluginFunction, hkdlssg_slGetPluginFunction);
+        HookRegistry::Commit();
     }
 }
 
@@ -727,16 +711,11 @@ void StreamlineHooks::unhookReflex()
 {
     LOG_FUNC();
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
     if (o_reflex_slGetPluginFunction)
     {
-        DetourDetach(&(PVOID&) o_reflex_slGetPluginFunction, hkreflex_slGetPluginFunction);
+        HookRegistry::Remove(&(PVOID&) o_reflex_slGetPluginFunction);
         o_reflex_slGetPluginFunction = nullptr;
     }
-
-    DetourTransactionCommit();
 }
 
 void StreamlineHooks::hookReflex(HMODULE slReflex)
@@ -758,12 +737,9 @@ void StreamlineHooks::hookReflex(HMODULE slReflex)
     if (o_reflex_slGetPluginFunction != nullptr)
     {
         LOG_TRACE("Hooking slGetPluginFunction in sl.reflex");
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        DetourAttach(&(PVOID&) o_reflex_slGetPluginFunction, hkreflex_slGetPluginFunction);
-
-        DetourTransactionCommit();
+        HookRegistry::Queue(HookGroup::Streamline, &(PVOID&) o_reflex_slGetPluginFunction,
+                            hkreflex_slGetPluginFunction);
+        HookRegistry::Commit();
     }
 }
 
@@ -773,16 +749,11 @@ void StreamlineHooks::unhookCommon()
 {
     LOG_FUNC();
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
     if (o_common_slGetPluginFunction)
     {
-        DetourDetach(&(PVOID&) o_common_slGetPluginFunction, hkcommon_slGetPluginFunction);
+        HookRegistry::Remove(&(PVOID&) o_common_slGetPluginFunction);
         o_common_slGetPluginFunction = nullptr;
     }
-
-    DetourTransactionCommit();
 }
 
 void StreamlineHooks::hookCommon(HMODULE slCommon)
@@ -804,11 +775,8 @@ void StreamlineHooks::hookCommon(HMODULE slCommon)
     if (o_common_slGetPluginFunction != nullptr)
     {
         LOG_TRACE("Hooking slGetPluginFunction in sl.common");
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        DetourAttach(&(PVOID&) o_common_slGetPluginFunction, hkcommon_slGetPluginFunction);
-
-        DetourTransactionCommit();
+        HookRegistry::Queue(HookGroup::Streamline, &(PVOID&) o_common_slGetPluginFunction,
+                            hkcommon_slGetPluginFunction);
+        HookRegistry::Commit();
     }
 }
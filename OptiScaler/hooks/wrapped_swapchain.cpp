@@ -5,6 +5,7 @@
 #include "HooksDx.h"
 
 #include <misc/FrameLimit.h>
+#include <misc/RenderScale.h>
 
 #pragma intrinsic(_ReturnAddress)
 
@@ -215,6 +216,7 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::Present(UINT SyncInterval, UIN
 
     if (!(Flags & DXGI_PRESENT_TEST || Flags & DXGI_PRESENT_RESTART) && RenderTrig != nullptr)
     {
+        RenderScale::Present();
         result = RenderTrig(m_pReal, SyncInterval, Flags, nullptr, Device, Handle, UWP);
 
         // When Reflex can't be used to limit, sleep in present
@@ -481,7 +483,10 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::Present1(UINT SyncInterval, UI
     HRESULT result;
 
     if (!(Flags & DXGI_PRESENT_TEST || Flags & DXGI_PRESENT_RESTART) && RenderTrig != nullptr)
+    {
+        RenderScale::Present();
         result = RenderTrig(m_pReal1, SyncInterval, Flags, pPresentParameters, Device, Handle, UWP);
+    }
     else
         result = m_pReal1->Present1(SyncInterval, Flags, pPresentParameters);
 
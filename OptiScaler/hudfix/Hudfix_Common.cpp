@@ -0,0 +1,56 @@
+#include "Hudfix_Common.h"
+
+bool Hudfix_Common::CheckSize(uint64_t width, uint32_t height, uint32_t targetWidth, uint32_t targetHeight,
+                              bool relaxed, bool* extended)
+{
+    if (width == targetWidth && height == targetHeight)
+        return true;
+
+    // Extended size check
+    if (!relaxed)
+        return false;
+
+    if (height < (uint64_t) targetHeight - 32 || height > (uint64_t) targetHeight + 32 ||
+        width < (uint64_t) targetWidth - 32 || width > (uint64_t) targetWidth + 32)
+    {
+        return false;
+    }
+
+    if (extended != nullptr)
+        *extended = true;
+
+    return true;
+}
+
+uint32_t Hudfix_Common::ValidationBin(float diff)
+{
+    uint32_t bin = 0;
+
+    // Same comparisons with the shader, edges are exact in float
+    for (uint32_t i = 1; i < ValidationBinCount; i++)
+    {
+        if (diff >= (float) (i * i) / (float) (ValidationBinCount * ValidationBinCount))
+            bin++;
+    }
+
+    return bin;
+}
+
+float Hudfix_Common::ValidationScore(const uint32_t* histogram)
+{
+    uint64_t total = 0;
+    uint64_t matched = 0;
+
+    for (uint32_t i = 0; i < ValidationBinCount; i++)
+    {
+        total += histogram[i];
+
+        if (i < ValidationMatchBins)
+            matched += histogram[i];
+    }
+
+    if (total == 0)
+        return -1.0f;
+
+    return (float) ((double) matched / (double) total);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+// API independent hudless candidate checks, used by Hudfix_Dx12 & Hudfix_Vk
+class Hudfix_Common
+{
+  public:
+    // Compare candidate size with swapchain, relaxed resolution check allows 32 pixels difference
+    static bool CheckSize(uint64_t width, uint32_t height, uint32_t targetWidth, uint32_t targetHeight, bool relaxed,
+                          bool* extended);
+
+    // Validation compares one pixel per cell of hudless & back buffer
+    // Bin edges are (i / BinCount)^2 so small differences get finer bins
+    static constexpr uint32_t ValidationCellSize = 8;
+    static constexpr uint32_t ValidationBinCount = 16;
+
+    // Differences below (MatchBins / BinCount)^2 are counted as same pixel (~4 steps of 8 bit)
+    static constexpr uint32_t ValidationMatchBins = 2;
+
+    static uint32_t ValidationBin(float diff);
+
+    // Fraction of samples matching the back buffer, HUD should only cover a small part of the screen
+    static float ValidationScore(const uint32_t* histogram);
+};
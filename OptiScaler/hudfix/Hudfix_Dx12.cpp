@@ -3,6 +3,7 @@
 #include <Util.h>
 #include <State.h>
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 #include <framegen/IFGFeature_Dx12.h>
 
@@ -120,6 +121,8 @@ bool Hudfix_Dx12::CreateBufferResource(ID3D12Device* InDevice, ResourceInfo* InS
         return false;
     }
 
+    VramTracker::Track(*OutResource, VramOwner::Hudfix);
+
     LOG_DEBUG("Created new one: {}x{}", texDesc.Width, texDesc.Height);
     return true;
 }
@@ -172,6 +175,8 @@ bool Hudfix_Dx12::CreateBufferResourceWithSize(ID3D12Device* InDevice, ResourceI
         return false;
     }
 
+    VramTracker::Track(*OutResource, VramOwner::Hudfix);
+
     LOG_DEBUG("Created new one: {}x{}", InWidth, InHeight);
     return true;
 }
@@ -214,6 +219,41 @@ bool Hudfix_Dx12::CheckCapture()
     return true;
 }
 
+UINT64 Hudfix_Dx12::CaptureSize(ResourceInfo* resource, UINT targetWidth, UINT targetHeight)
+{
+    auto desc = resource->buffer->GetDesc();
+    desc.Width = std::min(desc.Width, (UINT64) targetWidth);
+    desc.Height = std::min(desc.Height, targetHeight);
+    desc.MipLevels = 1;
+    desc.DepthOrArraySize = 1;
+
+    UINT64 totalBytes = 0;
+    State::Instance().currentD3D12Device->GetCopyableFootprints(&desc, 0, 1, 0, nullptr, nullptr, nullptr,
+                                                               &totalBytes);
+
+    return totalBytes;
+}
+
+bool Hudfix_Dx12::PrepareFormatTransfer(int fIndex, DXGI_FORMAT format, ID3D12Resource* resource)
+{
+    if (_formatTransfer[fIndex] == nullptr || !_formatTransfer[fIndex]->IsFormatCompatible(format))
+    {
+        LOG_DEBUG("Format change, recreate the FormatTransfer");
+
+        if (_formatTransfer[fIndex] != nullptr)
+            delete _formatTransfer[fIndex];
+
+        _formatTransfer[fIndex] = nullptr;
+        State::Instance().skipHeapCapture = true;
+        _formatTransfer[fIndex] = new FT_Dx12("FormatTransfer", State::Instance().currentD3D12Device, format);
+        State::Instance().skipHeapCapture = false;
+    }
+
+    return _formatTransfer[fIndex] != nullptr &&
+           _formatTransfer[fIndex]->CreateBufferResource(State::Instance().currentD3D12Device, resource,
+                                                         D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+}
+
 bool Hudfix_Dx12::CheckResource(ResourceInfo* resource)
 {
     if (resource == nullptr || resource->buffer == nullptr || State::Instance().isShuttingDown)
@@ -243,17 +283,10 @@ bool Hudfix_Dx12::CheckResource(ResourceInfo* resource)
     auto resDesc = resource->buffer->GetDesc();
 
     // dimensions not match
-    if (resDesc.Height != scDesc.BufferDesc.Height || resDesc.Width != scDesc.BufferDesc.Width)
+    if (!Hudfix_Common::CheckSize(resDesc.Width, resDesc.Height, scDesc.BufferDesc.Width, scDesc.BufferDesc.Height,
+                                  Config::Instance()->FGRelaxedResolutionCheck.value_or_default(), &resource->extended))
     {
-        // Extended size check
-        if (!(Config::Instance()->FGRelaxedResolutionCheck.value_or_default() &&
-              resDesc.Height >= scDesc.BufferDesc.Height - 32 && resDesc.Height <= scDesc.BufferDesc.Height + 32 &&
-              resDesc.Width >= scDesc.BufferDesc.Width - 32 && resDesc.Width <= scDesc.BufferDesc.Width + 32))
-        {
-            return false;
-        }
-
-        resource->extended = true;
+        return false;
     }
 
     // check for resource flags
@@ -382,6 +415,9 @@ void Hudfix_Dx12::UpscaleStart()
     {
         State::Instance().ClearCapturedHudlesses = false;
         State::Instance().CapturedHudlesses.clear();
+
+        std::lock_guard<std::mutex> lock(_confidenceMutex);
+        _confidence.Clear();
     }
 }
 
@@ -392,9 +428,19 @@ void Hudfix_Dx12::UpscaleEnd(UINT64 frameId, float lastFrameTime)
     _upscaleCounter++; // = frameId;
     _frameTime = lastFrameTime;
 
+    // Previous frame is done, publish its capture stats
+    auto prevIndex = (_upscaleCounter - 1) % BUFFER_COUNT;
+    State::Instance().FGHudlessCopyBytes = _copyBytes[prevIndex];
+    State::Instance().FGHudlessSavedBytes = _savedBytes[prevIndex];
+
     // Get new index and clear resources
     auto index = GetIndex();
     _captureCounter[index] = 0;
+    _copyBytes[index] = 0;
+    _savedBytes[index] = 0;
+
+    // Only validate hudless captured in the frame being presented
+    _validationCandidate.store(nullptr, std::memory_order_release);
 }
 
 void Hudfix_Dx12::PresentStart() { return; }
@@ -431,6 +477,27 @@ bool Hudfix_Dx12::IsResourceCheckActive()
 
 bool Hudfix_Dx12::SkipHudlessChecks() { return _skipHudlessChecks; }
 
+void* Hudfix_Dx12::ValidationCandidate()
+{
+    return _validationCandidate.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void Hudfix_Dx12::HudlessValidated(void* resource, const uint32_t* histogram)
+{
+    if (resource == nullptr || histogram == nullptr)
+        return;
+
+    auto score = Hudfix_Common::ValidationScore(histogram);
+
+    LOG_DEBUG("Resource: {:X}, score: {:.3f}", (size_t) resource, score);
+
+    std::lock_guard<std::mutex> lock(_confidenceMutex);
+    _confidence.Update(resource, score);
+
+    if (auto it = State::Instance().CapturedHudlesses.find(resource); it != State::Instance().CapturedHudlesses.end())
+        it->second.confidence = _confidence.Score(resource);
+}
+
 bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandList* cmdList, ResourceInfo* resource,
                                   D3D12_RESOURCE_STATES state, bool ignoreBlocked)
 {
@@ -458,94 +525,19 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
 
         if (!ignoreBlocked && Config::Instance()->FGResourceBlocking.value_or_default())
         {
-            if (_hudlessList.contains(resource->buffer))
-            {
-                auto info = &_hudlessList[resource->buffer];
-
-                // if game starts reusing the ignored resource & it's not banned
-                if (info->ignore && !info->dontReuse)
-                {
-                    // check resource once per frame
-                    if (info->lastTriedFrame != _upscaleCounter)
-                    {
-                        // start retry period
-                        if (info->retryStartFrame == 0)
-                        {
-                            LOG_WARN("Retry for {:X} as hudless, current frame: {}", (size_t) resource->buffer,
-                                     _upscaleCounter);
-                            info->retryStartFrame = _upscaleCounter;
-                            info->lastTriedFrame = _upscaleCounter;
-                            info->retryCount = 0;
-                            break;
-                        }
-
-                        info->retryCount++;
-                        info->lastTriedFrame = _upscaleCounter;
-
-                        // If still in retry period (70 frames)
-                        if ((_upscaleCounter - info->retryStartFrame) < 69)
-                        {
-                            // and used at least 20 times (around every 3rd frame)
-                            // try reusing the resource
-                            if (info->retryCount > 19)
-                            {
-                                LOG_WARN("Reusing {:X} as hudless, retry start frame: {}, current frame: {}, reuse "
-                                         "count: {}",
-                                         (size_t) resource->buffer, info->retryStartFrame, _upscaleCounter,
-                                         info->retryCount);
-
-                                info->lastUsedFrame = _upscaleCounter;
-                                info->retryStartFrame = 0;
-                                info->useCount = 0;
-                                info->retryCount = 0;
-                                info->ignore = false;
-                                info->reuseCount++;
-                            }
-                        }
-                        else
-                        {
-                            // Retry period ended without success, reset values
-
-                            LOG_WARN("Retry failed for {:X} as hudless, current frame: {}", (size_t) resource->buffer,
-                                     _upscaleCounter);
-
-                            info->useCount = 0;
-                            info->retryCount = 0;
-                            info->retryStartFrame = 0;
-                        }
-                    }
-                }
-
-                // directly ignore
-                if (info->ignore)
-                    break;
-
-                // if buffer is not used in last 5 frames stop using it
-                if ((_upscaleCounter - info->lastUsedFrame) > 6 && info->useCount < 100)
-                {
-                    LOG_WARN("Blocked {:X} as hudless, last used frame: {}, current frame: {}, use count: {}",
-                             (size_t) resource->buffer, info->lastUsedFrame, _upscaleCounter, info->useCount);
-
-                    info->ignore = true;
-                    info->retryCount = 0;
-                    info->lastTriedFrame = 0;
-                    info->retryStartFrame = 0;
-                    info->lastUsedFrame = _upscaleCounter;
-
-                    // don't reuse more than 2 times
-                    if (info->reuseCount > 1)
-                        info->dontReuse = true;
+            if (!_hudlessList.Check(resource->buffer, _upscaleCounter))
+                break;
+        }
 
-                    break;
-                }
+        if (Config::Instance()->FGHUDValidation.value_or_default())
+        {
+            std::lock_guard<std::mutex> lock(_confidenceMutex);
 
-                // update the info
-                info->lastUsedFrame = _upscaleCounter;
-                info->useCount++;
-            }
-            else
+            if (!_confidence.Check(resource->buffer, _upscaleCounter,
+                                   Config::Instance()->FGHUDValidationThreshold.value_or_default()))
             {
-                _hudlessList[resource->buffer] = { _upscaleCounter, 0, 0, 0, 0, 1, false, false };
+                LOG_DEBUG("Skipping {:X}, low hudless confidence!", (size_t) resource->buffer);
+                break;
             }
         }
 
@@ -571,159 +563,171 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
             return false;
         }
 
-        // Make a copy of resource to capture current state
-        if (!resource->extended)
+        auto needsConversion = resource->format != scDesc.BufferDesc.Format;
+
+        // Format transfer can read the resource at this point of the command list, an intermediate copy is not needed
+        auto directTransfer =
+            needsConversion && !resource->extended && state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE;
+
+        auto captureSize = CaptureSize(resource, scDesc.BufferDesc.Width, scDesc.BufferDesc.Height);
+
+        auto fg = reinterpret_cast<IFGFeature_Dx12*>(State::Instance().currentFG);
+
+        // Prepare format transfer first, so a failure doesn't leave a wasted copy in the command list
+        if (needsConversion && !PrepareFormatTransfer(fIndex, scDesc.BufferDesc.Format, resource->buffer))
         {
-            if (CreateBufferResource(State::Instance().currentD3D12Device, resource, D3D12_RESOURCE_STATE_COPY_DEST,
-                                     &_captureBuffer[fIndex]))
-            {
-                LOG_DEBUG("Create a copy of resource: {:X}", (size_t) resource->buffer);
+            LOG_WARN("_formatTransfer is null or can't create _formatTransfer buffer!");
+            _captureCounter[fIndex]--;
+            break;
+        }
 
-                // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
-                if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+        if (directTransfer)
+        {
+            // This will prevent resource tracker to check these operations
+            // Will reset after FG dispatch
+            _skipHudlessChecks = true;
 
-                cmdList->CopyResource(_captureBuffer[fIndex], resource->buffer);
+            if (state != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+                ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-                // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
-                if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
+            _formatTransfer[fIndex]->Dispatch(State::Instance().currentD3D12Device, cmdList, resource->buffer,
+                                              _formatTransfer[fIndex]->Buffer());
 
-                LOG_DEBUG("Copy created");
-            }
-            else
-            {
-                LOG_WARN("Can't create _captureBuffer!");
-                _captureCounter[fIndex]--;
-                break;
-            }
+            if (state != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+                ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, state);
+
+            LOG_TRACE("Using _formatTransfer->Buffer() without copy");
+            _savedBytes[fIndex] += captureSize;
+
+            if (fg != nullptr)
+                fg->SetHudless(cmdList, _formatTransfer[fIndex]->Buffer(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                               false);
         }
         else
         {
-            DXGI_SWAP_CHAIN_DESC scDesc {};
-            if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
-            {
-                LOG_WARN("Can't get swapchain desc!");
-                break;
-            }
-
-            if (CreateBufferResourceWithSize(State::Instance().currentD3D12Device, resource,
-                                             D3D12_RESOURCE_STATE_COPY_DEST, &_captureBuffer[fIndex],
-                                             scDesc.BufferDesc.Width, scDesc.BufferDesc.Height))
+            // Make a copy of resource to capture current state
+            if (!resource->extended)
             {
-                LOG_DEBUG("Create a copy of resource: {:X}", (size_t) resource->buffer);
-
-                // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
-                if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
-
-                D3D12_TEXTURE_COPY_LOCATION srcLocation;
-                ZeroMemory(&srcLocation, sizeof(srcLocation));
-                srcLocation.pResource = resource->buffer;
-                srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-                srcLocation.SubresourceIndex = 0; // copy from mip 0, array slice 0
-
-                D3D12_TEXTURE_COPY_LOCATION dstLocation;
-                ZeroMemory(&dstLocation, sizeof(dstLocation));
-                dstLocation.pResource = _captureBuffer[fIndex];
-                dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-                dstLocation.SubresourceIndex = 0; // paste into mip 0, array slice 0
-
-                D3D12_BOX srcBox;
-                srcBox.left = 0;
-                srcBox.top = 0;
-                srcBox.front = 0;
-                srcBox.back = 1;
-
-                if (scDesc.BufferDesc.Width > resource->width || scDesc.BufferDesc.Height > resource->height)
+                if (CreateBufferResource(State::Instance().currentD3D12Device, resource, D3D12_RESOURCE_STATE_COPY_DEST,
+                                         &_captureBuffer[fIndex]))
                 {
-                    srcBox.right = resource->width;
-                    srcBox.bottom = resource->height;
-                    UINT top = (scDesc.BufferDesc.Height - resource->height) / 2;
-                    UINT left = (scDesc.BufferDesc.Width - resource->width) / 2;
+                    LOG_DEBUG("Create a copy of resource: {:X}", (size_t) resource->buffer);
 
-                    cmdList->CopyTextureRegion(&dstLocation, left, top, 0, &srcLocation, &srcBox);
+                    // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
+                    if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
+                        ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+                    cmdList->CopyResource(_captureBuffer[fIndex], resource->buffer);
+
+                    // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
+                    if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
+                        ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
+
+                    LOG_DEBUG("Copy created");
                 }
                 else
                 {
-                    srcBox.right = scDesc.BufferDesc.Width;
-                    srcBox.bottom = scDesc.BufferDesc.Height;
-
-                    cmdList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, &srcBox);
+                    LOG_WARN("Can't create _captureBuffer!");
+                    _captureCounter[fIndex]--;
+                    break;
                 }
-
-                // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
-                if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
-
-                LOG_DEBUG("Copy created");
             }
             else
             {
-                LOG_WARN("Can't create _captureBuffer!");
-                _captureCounter[fIndex]--;
-                break;
-            }
-        }
+                DXGI_SWAP_CHAIN_DESC scDesc {};
+                if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
+                {
+                    LOG_WARN("Can't get swapchain desc!");
+                    break;
+                }
 
-        // needs conversion?
-        if (resource->format != scDesc.BufferDesc.Format)
-        {
-            if (_formatTransfer[fIndex] == nullptr ||
-                !_formatTransfer[fIndex]->IsFormatCompatible(scDesc.BufferDesc.Format))
-            {
-                LOG_DEBUG("Format change, recreate the FormatTransfer");
+                if (CreateBufferResourceWithSize(State::Instance().currentD3D12Device, resource,
+                                                 D3D12_RESOURCE_STATE_COPY_DEST, &_captureBuffer[fIndex],
+                                                 scDesc.BufferDesc.Width, scDesc.BufferDesc.Height))
+                {
+                    LOG_DEBUG("Create a copy of resource: {:X}", (size_t) resource->buffer);
+
+                    // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
+                    if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
+                        ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+                    D3D12_TEXTURE_COPY_LOCATION srcLocation;
+                    ZeroMemory(&srcLocation, sizeof(srcLocation));
+                    srcLocation.pResource = resource->buffer;
+                    srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+                    srcLocation.SubresourceIndex = 0; // copy from mip 0, array slice 0
+
+                    D3D12_TEXTURE_COPY_LOCATION dstLocation;
+                    ZeroMemory(&dstLocation, sizeof(dstLocation));
+                    dstLocation.pResource = _captureBuffer[fIndex];
+                    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+                    dstLocation.SubresourceIndex = 0; // paste into mip 0, array slice 0
+
+                    D3D12_BOX srcBox;
+                    srcBox.left = 0;
+                    srcBox.top = 0;
+                    srcBox.front = 0;
+                    srcBox.back = 1;
+
+                    if (scDesc.BufferDesc.Width > resource->width || scDesc.BufferDesc.Height > resource->height)
+                    {
+                        srcBox.right = resource->width;
+                        srcBox.bottom = resource->height;
+                        UINT top = (scDesc.BufferDesc.Height - resource->height) / 2;
+                        UINT left = (scDesc.BufferDesc.Width - resource->width) / 2;
+
+                        cmdList->CopyTextureRegion(&dstLocation, left, top, 0, &srcLocation, &srcBox);
+                    }
+                    else
+                    {
+                        srcBox.right = scDesc.BufferDesc.Width;
+                        srcBox.bottom = scDesc.BufferDesc.Height;
+
+                        cmdList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, &srcBox);
+                    }
 
-                if (_formatTransfer[fIndex] != nullptr)
-                    delete _formatTransfer[fIndex];
+                    // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
+                    if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
+                        ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
 
-                _formatTransfer[fIndex] = nullptr;
-                State::Instance().skipHeapCapture = true;
-                _formatTransfer[fIndex] =
-                    new FT_Dx12("FormatTransfer", State::Instance().currentD3D12Device, scDesc.BufferDesc.Format);
-                State::Instance().skipHeapCapture = false;
+                    LOG_DEBUG("Copy created");
+                }
+                else
+                {
+                    LOG_WARN("Can't create _captureBuffer!");
+                    _captureCounter[fIndex]--;
+                    break;
+                }
             }
 
-            if (_formatTransfer[fIndex] != nullptr &&
-                _formatTransfer[fIndex]->CreateBufferResource(State::Instance().currentD3D12Device, resource->buffer,
-                                                              D3D12_RESOURCE_STATE_UNORDERED_ACCESS))
-            {
-                // This will prevent resource tracker to check these operations
-                // Will reset after FG dispatch
-                _skipHudlessChecks = true;
+            _copyBytes[fIndex] += captureSize;
 
+            // This will prevent resource tracker to check these operations
+            // Will reset after FG dispatch
+            _skipHudlessChecks = true;
+
+            if (needsConversion)
+            {
                 ResourceBarrier(cmdList, _captureBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_DEST,
                                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-                _formatTransfer[fIndex]->Dispatch(State::Instance().currentD3D12Device, cmdList, _captureBuffer[fIndex],
-                                                  _formatTransfer[fIndex]->Buffer());
+                _formatTransfer[fIndex]->Dispatch(State::Instance().currentD3D12Device, cmdList,
+                                                  _captureBuffer[fIndex], _formatTransfer[fIndex]->Buffer());
                 ResourceBarrier(cmdList, _captureBuffer[fIndex], D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
                                 D3D12_RESOURCE_STATE_COPY_DEST);
 
                 LOG_TRACE("Using _formatTransfer->Buffer()");
 
-                auto fg = reinterpret_cast<IFGFeature_Dx12*>(State::Instance().currentFG);
-
                 if (fg != nullptr)
                     fg->SetHudless(cmdList, _formatTransfer[fIndex]->Buffer(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
                                    false);
             }
             else
             {
-                LOG_WARN("_formatTransfer is null or can't create _formatTransfer buffer!");
-                _captureCounter[fIndex]--;
-                break;
-            }
-        }
-        else
-        {
-            // This will prevent resource tracker to check these operations
-            // Will reset after FG dispatch
-            _skipHudlessChecks = true;
-            LOG_DEBUG("Using _captureBuffer");
-            auto fg = reinterpret_cast<IFGFeature_Dx12*>(State::Instance().currentFG);
+                LOG_DEBUG("Using _captureBuffer");
 
-            if (fg != nullptr)
-                fg->SetHudless(cmdList, _captureBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_DEST, false);
+                if (fg != nullptr)
+                    fg->SetHudless(cmdList, _captureBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_DEST, false);
+            }
         }
 
         if (State::Instance().FGcaptureResources)
@@ -733,6 +737,8 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
             State::Instance().FGcapturedResourceCount = _captureList.size();
         }
 
+        _validationCandidate.store(resource->buffer, std::memory_order_release);
+
         LOG_DEBUG("Calling FG with hudless");
 
         // This will prevent resource tracker to check these operations
@@ -762,12 +768,13 @@ void Hudfix_Dx12::ResetCounters()
     _targetTime = 0.0;
     _frameTime = 0.0;
 
-    _hudlessList.clear();
+    _hudlessList.Clear();
+    _validationCandidate.store(nullptr, std::memory_order_release);
 
     _captureCounter[0] = 0;
     _captureCounter[1] = 0;
     _captureCounter[2] = 0;
     _captureCounter[3] = 0;
 
-    LOG_DEBUG("_hudlessList: {}", _hudlessList.size());
+    LOG_DEBUG("_hudlessList: {}", _hudlessList.Size());
 }
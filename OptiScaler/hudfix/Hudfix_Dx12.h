@@ -1,11 +1,15 @@
 #pragma once
 #include <pch.h>
 
+#include "Hudfix_Common.h"
+#include "HudlessHistory.h"
+
 #include <shaders/format_transfer/FT_Dx12.h>
 
 #include <ankerl/unordered_dense.h>
 
 #include <set>
+#include <atomic>
 #include <dxgi.h>
 #include <d3d12.h>
 #include <shared_mutex>
@@ -30,18 +34,6 @@ typedef struct ResourceInfo
     bool extended = false;
 } resource_info;
 
-typedef struct HudlessInfo
-{
-    UINT64 lastUsedFrame = 0;
-    UINT64 retryStartFrame = 0;
-    UINT64 lastTriedFrame = 0;
-    UINT64 retryCount = 0;
-    UINT64 reuseCount = 0;
-    UINT64 useCount = 0;
-    bool ignore = false;
-    bool dontReuse = false;
-} hudless_info;
-
 class Hudfix_Dx12
 {
   private:
@@ -61,7 +53,14 @@ class Hudfix_Dx12
     inline static ID3D12Resource* _captureBuffer[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
 
     // used hudless list
-    inline static ankerl::unordered_dense::map<ID3D12Resource*, HudlessInfo> _hudlessList;
+    inline static HudlessHistory _hudlessList;
+
+    // GPU validation results of used hudless resources
+    inline static HudlessConfidence _confidence;
+    inline static std::mutex _confidenceMutex;
+
+    // Set on recording thread of the capture, taken by FG on present or cleared at upscale
+    inline static std::atomic<void*> _validationCandidate = nullptr;
 
     // Capture List
     inline static std::set<ID3D12Resource*> _captureList;
@@ -70,6 +69,10 @@ class Hudfix_Dx12
     inline static std::mutex _captureMutex;
     inline static std::mutex _counterMutex;
     inline static INT64 _captureCounter[BUFFER_COUNT] = { 0, 0, 0, 0 };
+
+    // Bytes copied for hudless captures / skipped by direct transfers
+    inline static UINT64 _copyBytes[BUFFER_COUNT] = { 0, 0, 0, 0 };
+    inline static UINT64 _savedBytes[BUFFER_COUNT] = { 0, 0, 0, 0 };
     inline static FT_Dx12* _formatTransfer[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
 
     inline static ID3D12CommandQueue* _commandQueue = nullptr;
@@ -91,6 +94,12 @@ class Hudfix_Dx12
     // Check _captureCounter for current frame
     static bool CheckCapture();
 
+    // Size of a full copy of the resource, extended captures only copy the part fitting in the swapchain
+    static UINT64 CaptureSize(ResourceInfo* resource, UINT targetWidth, UINT targetHeight);
+
+    // Create / resize format transfer before recording any commands
+    static bool PrepareFormatTransfer(int fIndex, DXGI_FORMAT format, ID3D12Resource* resource);
+
     static void HudlessFound(ID3D12GraphicsCommandList* cmdList);
 
     static int GetIndex();
@@ -125,6 +134,12 @@ class Hudfix_Dx12
                                 D3D12_RESOURCE_STATES state, bool ignoreBlocked = false);
     static bool CheckResource(ResourceInfo* resource);
 
+    // Resource hudless of current frame was captured from, cleared after the call
+    static void* ValidationCandidate();
+
+    // Updates confidence of resource with the histogram of GPU validation
+    static void HudlessValidated(void* resource, const uint32_t* histogram);
+
     // Reset frame counters
     static void ResetCounters();
 };
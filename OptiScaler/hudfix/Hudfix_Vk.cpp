@@ -0,0 +1,180 @@
+#include "Hudfix_Vk.h"
+
+#include <State.h>
+#include <Config.h>
+
+static bool IsConvertibleFormat(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+    case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+    case VK_FORMAT_R16G16B16A16_SFLOAT:
+    case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+    case VK_FORMAT_R32G32B32A32_SFLOAT:
+    case VK_FORMAT_R32G32B32_SFLOAT:
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+int Hudfix_Vk::GetIndex() { return _upscaleCounter % BUFFER_COUNT; }
+
+bool Hudfix_Vk::CheckCapture()
+{
+    auto fIndex = GetIndex();
+
+    std::lock_guard<std::mutex> lock(_counterMutex);
+
+    // early exit
+    if (_captureCounter[fIndex] > 999)
+        return false;
+
+    _captureCounter[fIndex]++;
+
+    LOG_TRACE("_upscaleCounter: {}, _captureCounter: {}, Limit: {}", _upscaleCounter, _captureCounter[fIndex],
+              Config::Instance()->FGHUDLimit.value_or_default());
+
+    return _captureCounter[fIndex] == Config::Instance()->FGHUDLimit.value_or_default();
+}
+
+void Hudfix_Vk::SetCaptureCallback(HudlessCaptureCallback callback)
+{
+    std::lock_guard<std::mutex> lock(_checkMutex);
+    _captureCallback = callback;
+}
+
+bool Hudfix_Vk::HasCaptureCallback() { return _captureCallback != nullptr; }
+
+void Hudfix_Vk::SwapchainCreated(uint32_t width, uint32_t height, VkFormat format)
+{
+    LOG_DEBUG("{}x{}, format: {}", width, height, (UINT) format);
+
+    _scWidth = width;
+    _scHeight = height;
+    _scFormat = format;
+}
+
+void Hudfix_Vk::UpscaleEnd()
+{
+    // Update counter after upscaling so _upscaleCounter > _fgCounter check at IsResourceCheckActive will work
+    _upscaleCounter++;
+
+    // Get new index and clear resources
+    _captureCounter[GetIndex()] = 0;
+}
+
+UINT64 Hudfix_Vk::ActiveUpscaleFrame() { return _upscaleCounter; }
+
+UINT64 Hudfix_Vk::ActivePresentFrame() { return _fgCounter; }
+
+bool Hudfix_Vk::IsResourceCheckActive()
+{
+    if (State::Instance().isShuttingDown || _captureCallback == nullptr)
+        return false;
+
+    if (_upscaleCounter <= _fgCounter)
+        return false;
+
+    if (!Config::Instance()->FGEnabled.value_or_default() || !Config::Instance()->FGHUDFix.value_or_default())
+        return false;
+
+    if (State::Instance().currentFeature == nullptr || State::Instance().FGchanged)
+        return false;
+
+    return true;
+}
+
+bool Hudfix_Vk::CheckResource(ImageInfo* image)
+{
+    if (image == nullptr || image->image == VK_NULL_HANDLE || image->width == 0 || image->height == 0)
+        return false;
+
+    if (_scWidth == 0 || _scHeight == 0)
+        return false;
+
+    if (!Hudfix_Common::CheckSize(image->width, image->height, _scWidth, _scHeight,
+                                  Config::Instance()->FGRelaxedResolutionCheck.value_or_default(), &image->extended))
+        return false;
+
+    if ((image->usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) > 0)
+        return false;
+
+    // format match
+    if (image->format == _scFormat)
+        return true;
+
+    // extended not active
+    if (!Config::Instance()->FGHUDFixExtended.value_or_default())
+        return false;
+
+    // resource and target formats are supported by converter
+    return IsConvertibleFormat(image->format) && IsConvertibleFormat(_scFormat);
+}
+
+bool Hudfix_Vk::CheckForHudless(std::string callerName, VkCommandBuffer cmdBuffer, ImageInfo* image)
+{
+    if (!IsResourceCheckActive())
+        return false;
+
+    if (!CheckResource(image))
+        return false;
+
+    if (!State::Instance().CapturedHudlesses[(void*) image->image].enabled)
+    {
+        LOG_DEBUG("Skipping {:X}, disabled from captured hudless list!", (size_t) image->image);
+        return false;
+    }
+
+    // Prevent double capture
+    std::lock_guard<std::mutex> lock(_checkMutex);
+
+    if (_captureCallback == nullptr || _upscaleCounter <= _fgCounter)
+        return false;
+
+    if (Config::Instance()->FGResourceBlocking.value_or_default() &&
+        !_hudlessList.Check((void*) image->image, _upscaleCounter))
+    {
+        return false;
+    }
+
+    if (!CheckCapture())
+        return false;
+
+    LOG_DEBUG("{} capture image: {:X}, {}x{}, format: {}", callerName, (size_t) image->image, image->width,
+              image->height, (UINT) image->format);
+
+    if (!_captureCallback(cmdBuffer, image))
+    {
+        LOG_WARN("Capture failed for {:X}", (size_t) image->image);
+        _captureCounter[GetIndex()]--;
+        return false;
+    }
+
+    // Set it above 1000 to prevent capture
+    _captureCounter[GetIndex()] = 9999;
+    _fgCounter++;
+
+    State::Instance().CapturedHudlesses[(void*) image->image].usageCount++;
+
+    return true;
+}
+
+void Hudfix_Vk::ResetCounters()
+{
+    _fgCounter = 0;
+    _upscaleCounter = 0;
+
+    _hudlessList.Clear();
+
+    for (size_t i = 0; i < BUFFER_COUNT; i++)
+        _captureCounter[i] = 0;
+
+    LOG_DEBUG("");
+}
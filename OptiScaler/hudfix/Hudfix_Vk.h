@@ -0,0 +1,78 @@
+#pragma once
+#include <pch.h>
+
+#include "Hudfix_Common.h"
+#include "HudlessHistory.h"
+
+#include <vulkan/vulkan.hpp>
+
+#include <functional>
+#include <mutex>
+
+typedef struct ImageInfo
+{
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkImageUsageFlags usage = 0;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    bool extended = false;
+} image_info;
+
+// Records the hudless capture to command buffer, returns false if capture failed
+typedef std::function<bool(VkCommandBuffer cmdBuffer, ImageInfo* image)> HudlessCaptureCallback;
+
+class Hudfix_Vk
+{
+  private:
+    // Last upscaled frame
+    inline static UINT64 _upscaleCounter = 0;
+
+    // Last frame hudless found
+    inline static UINT64 _fgCounter = 0;
+
+    // Swapchain info for candidate checks
+    inline static uint32_t _scWidth = 0;
+    inline static uint32_t _scHeight = 0;
+    inline static VkFormat _scFormat = VK_FORMAT_UNDEFINED;
+
+    // used hudless list
+    inline static HudlessHistory _hudlessList;
+
+    inline static std::mutex _checkMutex;
+    inline static std::mutex _counterMutex;
+    inline static INT64 _captureCounter[BUFFER_COUNT] = { 0, 0, 0, 0 };
+
+    // Set by the Vulkan frame generation, hudless checks are not active without it
+    inline static HudlessCaptureCallback _captureCallback = nullptr;
+
+    // Check _captureCounter for current frame
+    static bool CheckCapture();
+
+    static int GetIndex();
+
+  public:
+    static void SetCaptureCallback(HudlessCaptureCallback callback);
+    static bool HasCaptureCallback();
+
+    // Trig for swapchain creation
+    static void SwapchainCreated(uint32_t width, uint32_t height, VkFormat format);
+
+    // Trig for upscaling end
+    static void UpscaleEnd();
+
+    static UINT64 ActiveUpscaleFrame();
+    static UINT64 ActivePresentFrame();
+
+    // Is Hudfix active
+    static bool IsResourceCheckActive();
+
+    // Check image for hudless
+    static bool CheckForHudless(std::string callerName, VkCommandBuffer cmdBuffer, ImageInfo* image);
+    static bool CheckResource(ImageInfo* image);
+
+    // Reset frame counters
+    static void ResetCounters();
+};
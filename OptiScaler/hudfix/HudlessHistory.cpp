@@ -0,0 +1,161 @@
+#include "HudlessHistory.h"
+
+void HudlessConfidence::Update(void* resource, float score)
+{
+    if (score < 0.0f)
+        return;
+
+    auto info = &_list[resource];
+
+    if (info->samples == 0)
+        info->score = score;
+    else
+        info->score = (info->score + score) * 0.5f;
+
+    info->samples++;
+}
+
+bool HudlessConfidence::Check(void* resource, UINT64 frame, float threshold)
+{
+    auto it = _list.find(resource);
+
+    if (it == _list.end())
+        return true;
+
+    auto info = &it->second;
+
+    if (info->samples == 0 || info->score >= threshold)
+        return true;
+
+    if (info->rejectedFrame == 0)
+    {
+        LOG_WARN("Rejected {:X} as hudless, score: {:.3f}, threshold: {:.3f}", (size_t) resource, info->score,
+                 threshold);
+
+        info->rejectedFrame = frame;
+        info->rejectCount++;
+        return false;
+    }
+
+    if (frame < info->rejectedFrame + RetryFrames)
+        return false;
+
+    // Give it another chance, next result decides again
+    LOG_WARN("Retry for {:X} as hudless, last score: {:.3f}", (size_t) resource, info->score);
+
+    info->samples = 0;
+    info->rejectedFrame = 0;
+
+    return true;
+}
+
+float HudlessConfidence::Score(void* resource) const
+{
+    auto it = _list.find(resource);
+
+    if (it == _list.end() || it->second.samples == 0)
+        return -1.0f;
+
+    return it->second.score;
+}
+
+void HudlessConfidence::Remove(void* resource) { _list.erase(resource); }
+
+void HudlessConfidence::Clear() { _list.clear(); }
+
+size_t HudlessConfidence::Size() const { return _list.size(); }
+
+bool HudlessHistory::Check(void* resource, UINT64 frame)
+{
+    if (!_list.contains(resource))
+    {
+        _list[resource] = { frame, 0, 0, 0, 0, 1, false, false };
+        return true;
+    }
+
+    auto info = &_list[resource];
+
+    // if game starts reusing the ignored resource & it's not banned
+    if (info->ignore && !info->dontReuse)
+    {
+        // check resource once per frame
+        if (info->lastTriedFrame != frame)
+        {
+            // start retry period
+            if (info->retryStartFrame == 0)
+            {
+                LOG_WARN("Retry for {:X} as hudless, current frame: {}", (size_t) resource, frame);
+                info->retryStartFrame = frame;
+                info->lastTriedFrame = frame;
+                info->retryCount = 0;
+                return false;
+            }
+
+            info->retryCount++;
+            info->lastTriedFrame = frame;
+
+            // If still in retry period (70 frames)
+            if ((frame - info->retryStartFrame) < 69)
+            {
+                // and used at least 20 times (around every 3rd frame)
+                // try reusing the resource
+                if (info->retryCount > 19)
+                {
+                    LOG_WARN("Reusing {:X} as hudless, retry start frame: {}, current frame: {}, reuse count: {}",
+                             (size_t) resource, info->retryStartFrame, frame, info->retryCount);
+
+                    info->lastUsedFrame = frame;
+                    info->retryStartFrame = 0;
+                    info->useCount = 0;
+                    info->retryCount = 0;
+                    info->ignore = false;
+                    info->reuseCount++;
+                }
+            }
+            else
+            {
+                // Retry period ended without success, reset values
+                LOG_WARN("Retry failed for {:X} as hudless, current frame: {}", (size_t) resource, frame);
+
+                info->useCount = 0;
+                info->retryCount = 0;
+                info->retryStartFrame = 0;
+            }
+        }
+    }
+
+    // directly ignore
+    if (info->ignore)
+        return false;
+
+    // if buffer is not used in last 5 frames stop using it
+    if ((frame - info->lastUsedFrame) > 6 && info->useCount < 100)
+    {
+        LOG_WARN("Blocked {:X} as hudless, last used frame: {}, current frame: {}, use count: {}", (size_t) resource,
+                 info->lastUsedFrame, frame, info->useCount);
+
+        info->ignore = true;
+        info->retryCount = 0;
+        info->lastTriedFrame = 0;
+        info->retryStartFrame = 0;
+        info->lastUsedFrame = frame;
+
+        // don't reuse more than 2 times
+        if (info->reuseCount > 1)
+            info->dontReuse = true;
+
+        return false;
+    }
+
+    // update the info
+    info->lastUsedFrame = frame;
+    info->useCount++;
+
+    return true;
+}
+
+void HudlessHistory::Remove(void* resource) { _list.erase(resource); }
+
+void HudlessHistory::Clear() { _list.clear(); }
+
+size_t HudlessHistory::Size() const { return _list.size(); }
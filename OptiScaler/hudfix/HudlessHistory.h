@@ -0,0 +1,63 @@
+#pragma once
+#include <pch.h>
+
+#include <ankerl/unordered_dense.h>
+
+typedef struct HudlessInfo
+{
+    UINT64 lastUsedFrame = 0;
+    UINT64 retryStartFrame = 0;
+    UINT64 lastTriedFrame = 0;
+    UINT64 retryCount = 0;
+    UINT64 reuseCount = 0;
+    UINT64 useCount = 0;
+    bool ignore = false;
+    bool dontReuse = false;
+} hudless_info;
+
+typedef struct HudlessConfidenceInfo
+{
+    float score = 1.0f;
+    UINT64 samples = 0;
+    UINT64 rejectedFrame = 0;
+    UINT64 rejectCount = 0;
+} hudless_confidence_info;
+
+// Confidence of hudless candidates from GPU validation results
+class HudlessConfidence
+{
+  private:
+    ankerl::unordered_dense::map<void*, HudlessConfidenceInfo> _list;
+
+  public:
+    // Frames until a rejected resource is tried again
+    static constexpr UINT64 RetryFrames = 300;
+
+    // Results arrive a few frames after the resource is used, first one replaces the initial score
+    void Update(void* resource, float score);
+
+    // Returns false if resource is rejected at this frame
+    bool Check(void* resource, UINT64 frame, float threshold);
+
+    // Returns -1 for resources without validation results
+    float Score(void* resource) const;
+
+    void Remove(void* resource);
+    void Clear();
+    size_t Size() const;
+};
+
+// Usage history of hudless candidates for blocking rarely used resources
+class HudlessHistory
+{
+  private:
+    ankerl::unordered_dense::map<void*, HudlessInfo> _list;
+
+  public:
+    // Update usage info of resource, returns false if resource is blocked at this frame
+    bool Check(void* resource, UINT64 frame);
+
+    void Remove(void* resource);
+    void Clear();
+    size_t Size() const;
+};
@@ -0,0 +1,15 @@
+#include "FGContextSelector.h"
+
+void FGContextSelector::Add(unsigned int handle, uint32_t displayWidth, uint32_t displayHeight)
+{
+    uint64_t area = (uint64_t) displayWidth * displayHeight;
+
+    if (!_found || area > _area || (area == _area && handle < _handle))
+    {
+        _handle = handle;
+        _area = area;
+        _found = true;
+    }
+}
+
+bool FGContextSelector::IsSelected(unsigned int handle) const { return !_found || _handle == handle; }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+// Games which upscale more than one view (split screen, scopes, separate UI upscale) create several contexts.
+// Only one of them feeds FG & Hudfix, largest output wins and lower handle breaks the tie
+// so selection doesn't depend on the order contexts are added
+class FGContextSelector
+{
+  private:
+    unsigned int _handle = 0;
+    uint64_t _area = 0;
+    bool _found = false;
+
+  public:
+    // Only contexts with a feature should be added
+    void Add(unsigned int handle, uint32_t displayWidth, uint32_t displayHeight);
+
+    // Also true when no context is added, single context always drives FG
+    bool IsSelected(unsigned int handle) const;
+};
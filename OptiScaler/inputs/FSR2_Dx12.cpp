@@ -4,6 +4,7 @@
 #include "Config.h"
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "UpscaleInputs.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -111,6 +112,7 @@ static PFN_ffxFsr2GetInterfaceDX12 o_ffxFsr2GetInterfaceDX12 = nullptr;
 
 static std::map<Fsr212::FfxFsr2Context*, Fsr212::FfxFsr2ContextDescription> _initParams;
 static std::map<Fsr212::FfxFsr2Context*, NVSDK_NGX_Parameter*> _nvParams;
+static std::map<Fsr212::FfxFsr2Context*, UpscaleInputs> _lastInputs;
 static std::map<Fsr212::FfxFsr2Context*, NVSDK_NGX_Handle*> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
@@ -306,6 +308,9 @@ static std::optional<float> GetQualityOverrideRatioFfx(const Fsr212::FfxFsr2Qual
 
     std::optional<float> output;
 
+    if (auto ratio = RenderScale::QueryRatio(); ratio.has_value())
+        return ratio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -450,6 +455,7 @@ static Fsr212::FfxErrorCode ffxFsr2ContextCreate_Dx12(Fsr212::FfxFsr2Context* co
         return Fsr212::FFX_ERROR_BACKEND_API_ERROR;
 
     _nvParams[context] = params;
+    _lastInputs[context] = {};
 
     Fsr212::FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
@@ -559,6 +565,7 @@ static Fsr212::FfxErrorCode ffxFsr2ContextCreate_Pattern_Dx12(Fsr212::FfxFsr2Con
         return Fsr212::FFX_ERROR_BACKEND_API_ERROR;
 
     _nvParams[context] = params;
+    _lastInputs[context] = {};
 
     Fsr212::FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
@@ -608,30 +615,12 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     NVSDK_NGX_Parameter* params = _nvParams[context];
     NVSDK_NGX_Handle* handle = _contexts[context];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(dispatchDescription, inputs);
+    inputs.biasColorMask = dispatchDescription->reactive.resource;
+    inputs.reactive = dispatchDescription->reactive.resource;
+    inputs.transparency = dispatchDescription->transparencyAndComposition.resource;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[context]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -672,30 +661,12 @@ ffxFsr2ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2Context* context,
     NVSDK_NGX_Parameter* params = _nvParams[context];
     NVSDK_NGX_Handle* handle = _contexts[context];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(dispatchDescription, inputs);
+    inputs.biasColorMask = dispatchDescription->reactive.resource;
+    inputs.reactive = dispatchDescription->reactive.resource;
+    inputs.transparency = dispatchDescription->transparencyAndComposition.resource;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[context]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -739,30 +710,12 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     NVSDK_NGX_Parameter* params = _nvParams[context];
     NVSDK_NGX_Handle* handle = _contexts[context];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(dispatchDescription, inputs);
+    inputs.biasColorMask = dispatchDescription->reactive.resource;
+    inputs.reactive = dispatchDescription->reactive.resource;
+    inputs.transparency = dispatchDescription->transparencyAndComposition.resource;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[context]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -807,30 +760,12 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2
     NVSDK_NGX_Parameter* params = _nvParams[context];
     NVSDK_NGX_Handle* handle = _contexts[context];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(dispatchDescription, inputs);
+    inputs.biasColorMask = dispatchDescription->reactive.resource;
+    inputs.reactive = dispatchDescription->reactive.resource;
+    inputs.transparency = dispatchDescription->transparencyAndComposition.resource;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[context]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -871,30 +806,12 @@ static Fsr212::FfxErrorCode ffxFsr2TinyContextDispatch_Dx12(Fsr212::FfxFsr2Conte
     NVSDK_NGX_Parameter* params = _nvParams[context];
     NVSDK_NGX_Handle* handle = _contexts[context];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(dispatchDescription, inputs);
+    inputs.biasColorMask = dispatchDescription->reactive.resource;
+    inputs.reactive = dispatchDescription->reactive.resource;
+    inputs.transparency = dispatchDescription->transparencyAndComposition.resource;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[context]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -923,6 +840,7 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDestroy_Dx12(Fsr212::FfxFsr2Context* c
 
     _contexts.erase(context);
     _nvParams.erase(context);
+    _lastInputs.erase(context);
     _initParams.erase(context);
 
     _skipDestroy = true;
@@ -944,6 +862,7 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDestroy_Pattern_Dx12(Fsr212::FfxFsr2Co
 
     _contexts.erase(context);
     _nvParams.erase(context);
+    _lastInputs.erase(context);
     _initParams.erase(context);
 
     auto cdResult = o_ffxFsr2ContextDestroy_Pattern_Dx12(context);
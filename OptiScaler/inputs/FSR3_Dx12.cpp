@@ -5,6 +5,7 @@
 
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "UpscaleInputs.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -45,6 +46,7 @@ static PFN_ffxFSR3GetInterfaceDX12 o_ffxFSR3GetInterfaceDX12 = nullptr;
 
 static std::map<Fsr3::FfxFsr3UpscalerContext*, Fsr3::FfxFsr3UpscalerContextDescription> _initParams;
 static std::map<Fsr3::FfxFsr3UpscalerContext*, NVSDK_NGX_Parameter*> _nvParams;
+static std::map<Fsr3::FfxFsr3UpscalerContext*, UpscaleInputs> _lastInputs;
 static std::map<Fsr3::FfxFsr3UpscalerContext*, NVSDK_NGX_Handle*> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
@@ -118,6 +120,9 @@ static std::optional<float> GetQualityOverrideRatioFfx(const Fsr3::FfxFsr3Upscal
 {
     std::optional<float> output;
 
+    if (auto ratio = RenderScale::QueryRatio(); ratio.has_value())
+        return ratio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -272,6 +277,7 @@ static Fsr3::FfxErrorCode ffxFsr3ContextCreate_Dx12(Fsr3::FfxFsr3UpscalerContext
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
     _nvParams[pContext] = params;
+    _lastInputs[pContext] = {};
 
     Fsr3::FfxFsr3UpscalerContextDescription ccd {};
     ccd.flags = pContextDescription->flags;
@@ -316,31 +322,13 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDispatch_Dx12(Fsr3::FfxFsr3UpscalerConte
     NVSDK_NGX_Parameter* params = _nvParams[pContext];
     NVSDK_NGX_Handle* handle = _contexts[pContext];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pDispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pDispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pDispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pDispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, pDispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, pDispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, pDispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, pDispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, pDispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, pDispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, pDispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, pDispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", pDispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", pDispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", pDispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", pDispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", pDispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", pDispatchDescription->reactive.resource);
-    params->Set("FSR.viewSpaceToMetersFactor", pDispatchDescription->viewSpaceToMetersFactor);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, pDispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(pDispatchDescription, inputs);
+    inputs.biasColorMask = pDispatchDescription->reactive.resource;
+    inputs.reactive = pDispatchDescription->reactive.resource;
+    inputs.transparency = pDispatchDescription->transparencyAndComposition.resource;
+    inputs.meterFactor = pDispatchDescription->viewSpaceToMetersFactor;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[pContext]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, pDispatchDescription->renderSize.width,
               pDispatchDescription->renderSize.height);
@@ -369,6 +357,7 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDestroy_Dx12(Fsr3::FfxFsr3UpscalerContex
 
     _contexts.erase(pContext);
     _nvParams.erase(pContext);
+    _lastInputs.erase(pContext);
     _initParams.erase(pContext);
 
     _skipDestroy = true;
@@ -476,6 +465,7 @@ ffxFsr3ContextCreate_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
     _nvParams[pContext] = params;
+    _lastInputs[pContext] = {};
 
     Fsr3::FfxFsr3UpscalerContextDescription ccd {};
     ccd.flags = pContextDescription->flags;
@@ -511,31 +501,13 @@ ffxFsr3ContextDispatch_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     NVSDK_NGX_Parameter* params = _nvParams[pContext];
     NVSDK_NGX_Handle* handle = _contexts[pContext];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pDispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pDispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pDispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pDispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, pDispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, pDispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, pDispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, pDispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, pDispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, pDispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, pDispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, pDispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", pDispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", pDispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", pDispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", pDispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", pDispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", pDispatchDescription->reactive.resource);
-    params->Set("FSR.viewSpaceToMetersFactor", pDispatchDescription->viewSpaceToMetersFactor);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, pDispatchDescription->sharpness);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(pDispatchDescription, inputs);
+    inputs.biasColorMask = pDispatchDescription->reactive.resource;
+    inputs.reactive = pDispatchDescription->reactive.resource;
+    inputs.transparency = pDispatchDescription->transparencyAndComposition.resource;
+    inputs.meterFactor = pDispatchDescription->viewSpaceToMetersFactor;
+    ApplyUpscaleInputs(params, inputs, _lastInputs[pContext]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, pDispatchDescription->renderSize.width,
               pDispatchDescription->renderSize.height);
@@ -564,6 +536,7 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDestroy_Pattern_Dx12(Fsr3::FfxFsr3Upscal
 
     _contexts.erase(pContext);
     _nvParams.erase(pContext);
+    _lastInputs.erase(pContext);
     _initParams.erase(pContext);
 
     auto cdResult = o_ffxFsr3UpscalerContextDestroy_Dx12(pContext);
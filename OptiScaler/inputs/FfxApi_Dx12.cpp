@@ -5,12 +5,14 @@
 #include "resource.h"
 #include "proxies/FfxApi_Proxy.h"
 #include "NVNGX_Parameter.h"
+#include "UpscaleInputs.h"
 
 #include "ffx_upscale.h"
 #include "dx12/ffx_api_dx12.h"
 
 static std::map<ffxContext, ffxCreateContextDescUpscale> _initParams;
 static std::map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
+static std::map<ffxContext, UpscaleInputs> _lastInputs;
 static std::map<ffxContext, NVSDK_NGX_Handle*> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
@@ -198,6 +200,9 @@ static std::optional<float> GetQualityOverrideRatioFfx(const uint32_t input)
 {
     std::optional<float> output;
 
+    if (auto ratio = RenderScale::QueryRatio(); ratio.has_value())
+        return ratio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -419,6 +424,7 @@ ffxReturnCode_t ffxCreateContext_Dx12(ffxContext* context, ffxCreateContextDescH
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
     _nvParams[*context] = params;
+    _lastInputs[*context] = {};
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
@@ -447,6 +453,7 @@ ffxReturnCode_t ffxDestroyContext_Dx12(ffxContext* context, const ffxAllocationC
 
     _contexts.erase(*context);
     _nvParams.erase(*context);
+    _lastInputs.erase(*context);
     _initParams.erase(*context);
 
     if (State::Instance().currentFG != nullptr)
@@ -577,44 +584,24 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
     NVSDK_NGX_Parameter* params = _nvParams[*context];
     NVSDK_NGX_Handle* handle = _contexts[*context];
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDesc->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDesc->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDesc->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDesc->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDesc->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDesc->exposure.resource);
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(dispatchDesc, inputs);
+    inputs.meterFactor = dispatchDesc->viewSpaceToMetersFactor;
+    inputs.upscaleWidth = dispatchDesc->upscaleSize.width;
+    inputs.upscaleHeight = dispatchDesc->upscaleSize.height;
 
     if (dispatchDesc->reactive.description.width >= dispatchDesc->renderSize.width &&
         dispatchDesc->reactive.description.height >= dispatchDesc->renderSize.height)
-        params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDesc->reactive.resource);
-
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDesc->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDesc->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDesc->output.resource);
-    params->Set("FSR.cameraNear", dispatchDesc->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDesc->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDesc->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDesc->frameTimeDelta);
-    params->Set("FSR.viewSpaceToMetersFactor", dispatchDesc->viewSpaceToMetersFactor);
+    {
+        inputs.biasColorMask = dispatchDesc->reactive.resource;
+        inputs.reactive = dispatchDesc->reactive.resource;
+    }
 
     if (dispatchDesc->transparencyAndComposition.description.width >= dispatchDesc->renderSize.width &&
         dispatchDesc->transparencyAndComposition.description.height >= dispatchDesc->renderSize.height)
-        params->Set("FSR.transparencyAndComposition", dispatchDesc->transparencyAndComposition.resource);
-
-    if (dispatchDesc->reactive.description.width >= dispatchDesc->renderSize.width &&
-        dispatchDesc->reactive.description.height >= dispatchDesc->renderSize.height)
-        params->Set("FSR.reactive", dispatchDesc->reactive.resource);
+        inputs.transparency = dispatchDesc->transparencyAndComposition.resource;
 
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDesc->sharpness);
-    params->Set("FSR.upscaleSize.width", dispatchDesc->upscaleSize.width);
-    params->Set("FSR.upscaleSize.height", dispatchDesc->upscaleSize.height);
+    ApplyUpscaleInputs(params, inputs, _lastInputs[*context]);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDesc->renderSize.width,
               dispatchDesc->renderSize.height);
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <upscalers/Upscaler.h>
+
+#include <future>
+
 template <typename FeatureType> struct ContextData
 {
     std::unique_ptr<FeatureType> feature;
     NVSDK_NGX_Parameter* createParams = nullptr;
     int changeBackendCounter = 0;
+
+    // Replacement feature which is created and inited on a worker thread
+    std::future<std::unique_ptr<FeatureType>> pendingFeature;
+    Upscaler pendingBackend = Upscaler::None;
 };
@@ -558,7 +558,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_CreateFeature(ID3D11DeviceContext
 
     LOG_ERROR("CreateFeature failed");
 
-    State::Instance().newBackend = "fsr22";
+    State::Instance().newBackend = Upscaler::FSR22;
     State::Instance().changeBackend[handleId] = true;
 
     return NVSDK_NGX_Result_Success;
@@ -712,9 +712,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
 
     if (State::Instance().changeBackend[handleId])
     {
-        if (State::Instance().newBackend == "" ||
-            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == "dlss"))
-            State::Instance().newBackend = Config::Instance()->Dx11Upscaler.value_or_default();
+        if (State::Instance().newBackend == Upscaler::None ||
+            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == Upscaler::DLSS))
+            State::Instance().newBackend = UpscalerFromCode(Config::Instance()->Dx11Upscaler.value_or_default());
 
         Dx11Contexts[handleId].changeBackendCounter++;
 
@@ -723,11 +723,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
         {
             if (Dx11Contexts.contains(handleId) && Dx11Contexts[handleId].feature != nullptr)
             {
-                LOG_INFO("changing backend to {0}", State::Instance().newBackend);
+                LOG_INFO("changing backend to {0}", UpscalerCode(State::Instance().newBackend));
 
                 auto dc = Dx11Contexts[handleId].feature.get();
 
-                if (State::Instance().newBackend != "dlssd" && State::Instance().newBackend != "dlss")
+                if (State::Instance().newBackend != Upscaler::DLSSD && State::Instance().newBackend != Upscaler::DLSS)
                     Dx11Contexts[handleId].createParams = GetNGXParameters("OptiDx11");
                 else
                     Dx11Contexts[handleId].createParams = InParameters;
@@ -754,7 +754,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
             {
                 LOG_ERROR("can't find handle {0} in Dx11Contexts!", handleId);
 
-                State::Instance().newBackend = "";
+                State::Instance().newBackend = Upscaler::None;
                 State::Instance().changeBackend[handleId] = false;
 
                 if (Dx11Contexts[handleId].createParams != nullptr)
@@ -772,61 +772,61 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
         if (Dx11Contexts[handleId].changeBackendCounter == 2)
         {
             // next frame prepare stuff
-            if (State::Instance().newBackend == "xess")
+            if (State::Instance().newBackend == Upscaler::XeSS)
             {
                 Config::Instance()->Dx11Upscaler = "xess";
                 LOG_INFO("creating new XeSS feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<XeSSFeature_Dx11>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "xess_12")
+            else if (State::Instance().newBackend == Upscaler::XeSS_Dx12)
             {
                 Config::Instance()->Dx11Upscaler = "xess_12";
                 LOG_INFO("creating new XeSS with Dx12 feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<XeSSFeatureDx11on12>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "dlss")
+            else if (State::Instance().newBackend == Upscaler::DLSS)
             {
                 Config::Instance()->Dx11Upscaler = "dlss";
                 LOG_INFO("creating new DLSS feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<DLSSFeatureDx11>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "dlssd")
+            else if (State::Instance().newBackend == Upscaler::DLSSD)
             {
                 LOG_INFO("creating new DLSSD feature");
                 Dx11Contexts[handleId].feature = std::make_unique<DLSSDFeatureDx11>(handleId, InParameters);
             }
-            else if (State::Instance().newBackend == "fsr21_12")
+            else if (State::Instance().newBackend == Upscaler::FSR21_Dx12)
             {
                 Config::Instance()->Dx11Upscaler = "fsr21_12";
                 LOG_INFO("creating new FSR 2.1.2 with Dx12 feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<FSR2FeatureDx11on12_212>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "fsr31_12")
+            else if (State::Instance().newBackend == Upscaler::FSR31_Dx12)
             {
                 Config::Instance()->Dx11Upscaler = "fsr31_12";
                 LOG_INFO("creating new FSR 3.1 with Dx12 feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<FSR31FeatureDx11on12>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "fsr22_12")
+            else if (State::Instance().newBackend == Upscaler::FSR22_Dx12)
             {
                 Config::Instance()->Dx11Upscaler = "fsr22_12";
                 LOG_INFO("creating new FSR 2.2.1 with Dx12 feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<FSR2FeatureDx11on12>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "fsr22")
+            else if (State::Instance().newBackend == Upscaler::FSR22)
             {
                 Config::Instance()->Dx11Upscaler = "fsr22";
                 LOG_INFO("creating new native FSR 2.2.1 feature");
                 Dx11Contexts[handleId].feature =
                     std::make_unique<FSR2FeatureDx11>(handleId, Dx11Contexts[handleId].createParams);
             }
-            else if (State::Instance().newBackend == "fsr31")
+            else if (State::Instance().newBackend == Upscaler::FSR31)
             {
                 Config::Instance()->Dx11Upscaler = "fsr31";
                 LOG_INFO("creating new native FSR 3.1.0 feature");
@@ -841,8 +841,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
             //     Dx11Contexts[handleId].createParams);
             // }
 
-            if (Config::Instance()->Dx11DelayedInit.value_or_default() && State::Instance().newBackend != "fsr22" &&
-                State::Instance().newBackend != "dlss" && State::Instance().newBackend != "dlssd")
+            if (Config::Instance()->Dx11DelayedInit.value_or_default() &&
+                State::Instance().newBackend != Upscaler::FSR22 && State::Instance().newBackend != Upscaler::DLSS &&
+                State::Instance().newBackend != Upscaler::DLSSD)
             {
                 LOG_TRACE("sleeping after new creation of new feature for 1000ms");
                 std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -867,25 +868,25 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
 
             if (!initResult || !Dx11Contexts[handleId].feature->ModuleLoaded())
             {
-                LOG_ERROR("init failed with {0} feature", State::Instance().newBackend);
+                LOG_ERROR("init failed with {0} feature", UpscalerCode(State::Instance().newBackend));
 
-                if (State::Instance().newBackend != "dlssd")
+                if (State::Instance().newBackend != Upscaler::DLSSD)
                 {
-                    State::Instance().newBackend = "fsr22";
+                    State::Instance().newBackend = Upscaler::FSR22;
                     State::Instance().changeBackend[handleId] = true;
                 }
                 else
                 {
-                    State::Instance().newBackend = "";
+                    State::Instance().newBackend = Upscaler::None;
                     State::Instance().changeBackend[handleId] = false;
                     return NVSDK_NGX_Result_Fail;
                 }
             }
             else
             {
-                LOG_INFO("init successful for {0}, upscaler changed", State::Instance().newBackend);
+                LOG_INFO("init successful for {0}, upscaler changed", UpscalerCode(State::Instance().newBackend));
 
-                State::Instance().newBackend = "";
+                State::Instance().newBackend = Upscaler::None;
                 State::Instance().changeBackend[handleId] = false;
                 evalCounter = 0;
             }
@@ -949,7 +950,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D11_EvaluateFeature(ID3D11DeviceConte
     if (!deviceContext->Evaluate(InDevCtx, InParameters) && !deviceContext->IsInited() &&
         (deviceContext->Name() == "XeSS" || deviceContext->Name() == "DLSS" || deviceContext->Name() == "FSR3 w/Dx12"))
     {
-        State::Instance().newBackend = "fsr22";
+        State::Instance().newBackend = Upscaler::FSR22;
         State::Instance().changeBackend[handleId] = true;
     }
 
@@ -16,16 +16,20 @@
 #include "framegen/ffx/FSRFG_Dx12.h"
 
 #include "hooks/HooksDx.h"
+#include "hooks/HookRegistry.h"
 #include "proxies/FfxApi_Proxy.h"
 
 #include <hudfix/Hudfix_Dx12.h>
 #include <resource_tracking/ResTrack_dx12.h>
+#include <misc/Benchmark.h>
+#include <misc/VramTracker.h>
+#include <inputs/FGContextSelector.h>
+#include <shaders/DescriptorHeap_Dx12.h>
 
 #include "shaders/depth_scale/DS_Dx12.h"
 
 #include <dxgi1_4.h>
 #include <shared_mutex>
-#include "detours/detours.h"
 #include <ffx_framegeneration.h>
 #include <ankerl/unordered_dense.h>
 
@@ -170,39 +174,292 @@ static void HookToCommandList(ID3D12GraphicsCommandList* InCmdList)
     orgSetComputeRootSignature = (PFN_SetComputeRootSignature) pVTable[29];
     orgSetGraphicRootSignature = (PFN_SetComputeRootSignature) pVTable[30];
 
-    if (orgSetComputeRootSignature != nullptr || orgSetGraphicRootSignature != nullptr)
+    HookRegistry::Queue(HookGroup::RootSignature, &(PVOID&) orgSetComputeRootSignature, hkSetComputeRootSignature);
+    HookRegistry::Queue(HookGroup::RootSignature, &(PVOID&) orgSetGraphicRootSignature, hkSetGraphicRootSignature);
+    HookRegistry::Commit();
+}
+
+static void UnhookAll()
+{
+    HookRegistry::Remove(&(PVOID&) orgSetComputeRootSignature);
+    HookRegistry::Remove(&(PVOID&) orgSetGraphicRootSignature);
+
+    orgSetComputeRootSignature = nullptr;
+    orgSetGraphicRootSignature = nullptr;
+}
+
+#pragma endregion
+
+#pragma region Backend Change
+
+// Replaced features are kept alive until command lists recorded with them are executed
+typedef struct RetiredFeatureDx12
+{
+    std::unique_ptr<IFeature_Dx12> feature;
+    int frames = 0;
+    UINT64 fenceValue = 0;
+} retired_feature_dx12;
+
+static const int RetireFrameDelay = 4;
+
+static std::vector<RetiredFeatureDx12> retiredFeatures;
+static ID3D12Fence* retireFence = nullptr;
+static UINT64 retireFenceValue = 0;
+
+// Unknown backends are created as XeSS like before
+static Upscaler SupportedBackend(Upscaler backend)
+{
+    switch (backend)
     {
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
+    case Upscaler::FSR21:
+    case Upscaler::FSR22:
+    case Upscaler::FSR31:
+    case Upscaler::DLSS:
+    case Upscaler::DLSSD:
+        return backend;
+    default:
+        return Upscaler::XeSS;
+    }
+}
 
-        if (orgSetComputeRootSignature != nullptr)
-            DetourAttach(&(PVOID&) orgSetComputeRootSignature, hkSetComputeRootSignature);
+// Value of DLSSEnabler.Dx12Backend parameter, -1 means don't report
+static int EnablerBackendIndex(Upscaler backend)
+{
+    switch (backend)
+    {
+    case Upscaler::XeSS:
+        return 0;
+    case Upscaler::FSR22:
+        return 1;
+    case Upscaler::FSR21:
+        return 2;
+    case Upscaler::DLSS:
+        return 3;
+    case Upscaler::FSR31:
+        return 4;
+    default:
+        return -1;
+    }
+}
+
+static std::unique_ptr<IFeature_Dx12> CreateUpscaler(Upscaler backend, unsigned int handleId,
+                                                     NVSDK_NGX_Parameter* parameters)
+{
+    switch (backend)
+    {
+    case Upscaler::FSR22:
+        return std::make_unique<FSR2FeatureDx12>(handleId, parameters);
+    case Upscaler::FSR21:
+        return std::make_unique<FSR2FeatureDx12_212>(handleId, parameters);
+    case Upscaler::FSR31:
+        return std::make_unique<FSR31FeatureDx12>(handleId, parameters);
+    case Upscaler::DLSS:
+        return std::make_unique<DLSSFeatureDx12>(handleId, parameters);
+    case Upscaler::DLSSD:
+        return std::make_unique<DLSSDFeatureDx12>(handleId, parameters);
+    default:
+        return std::make_unique<XeSSFeatureDx12>(handleId, parameters);
+    }
+}
 
-        if (orgSetGraphicRootSignature != nullptr)
-            DetourAttach(&(PVOID&) orgSetGraphicRootSignature, hkSetGraphicRootSignature);
+static void RetireFeature(std::unique_ptr<IFeature_Dx12> feature)
+{
+    if (feature == nullptr)
+        return;
+
+    LOG_DEBUG("retiring {} feature", feature->Name());
+    retiredFeatures.push_back({ std::move(feature), RetireFrameDelay, 0 });
+}
+
+static void UpdateRetiredFeatures()
+{
+    for (auto it = retiredFeatures.begin(); it != retiredFeatures.end();)
+    {
+        if (it->frames > 0)
+        {
+            it->frames--;
+            it++;
+            continue;
+        }
+
+        if (it->fenceValue == 0 && D3D12Device != nullptr)
+        {
+            // Command lists of the swap frame are submitted by now, signal after them on the queue which executed
+            // upscaler command lists. Present queue is used if that queue is not known (queue hook is missing).
+            auto queue = ResTrack_Dx12::GetUpscalerQueue();
 
-        DetourTransactionCommit();
+            if (queue == nullptr && State::Instance().currentCommandQueue != nullptr)
+            {
+                queue = State::Instance().currentCommandQueue;
+                queue->AddRef();
+            }
+
+            if (retireFence == nullptr &&
+                D3D12Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&retireFence)) != S_OK)
+            {
+                retireFence = nullptr;
+            }
+
+            auto signaled = queue != nullptr && retireFence != nullptr &&
+                            queue->Signal(retireFence, retireFenceValue + 1) == S_OK;
+
+            if (queue != nullptr)
+                queue->Release();
+
+            if (signaled)
+            {
+                it->fenceValue = ++retireFenceValue;
+                it++;
+                continue;
+            }
+        }
+        else if (it->fenceValue != 0 && retireFence->GetCompletedValue() < it->fenceValue)
+        {
+            it++;
+            continue;
+        }
+
+        LOG_DEBUG("releasing retired {} feature", it->feature->Name());
+        it = retiredFeatures.erase(it);
     }
 }
 
-static void UnhookAll()
+static void ReleaseRetiredFeatures()
+{
+    retiredFeatures.clear();
+
+    if (retireFence != nullptr)
+    {
+        retireFence->Release();
+        retireFence = nullptr;
+    }
+
+    retireFenceValue = 0;
+}
+
+// Non NGX backends don't record anything during init so they are created on a worker thread while current feature
+// keeps rendering, then swapped at the start of a frame. skipHeapCapture & skipSpoofing set by init are thread local
+// so they don't leak into the render thread. Returns false when synchronous path should be used.
+static bool ChangeBackendAsync(unsigned int handleId, ContextData<IFeature_Dx12>* deviceContext,
+                               NVSDK_NGX_Parameter* InParameters, bool outputChanged)
 {
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
+    auto& state = State::Instance();
+
+    if (!deviceContext->pendingFeature.valid())
+    {
+        auto current = deviceContext->feature.get();
+
+        if (state.newBackend == Upscaler::None ||
+            (!Config::Instance()->DLSSEnabled.value_or_default() && state.newBackend == Upscaler::DLSS))
+            state.newBackend = UpscalerFromCode(Config::Instance()->Dx12Upscaler.value_or_default());
+
+        auto backend = SupportedBackend(state.newBackend);
+
+        // In-upscaler menu creates ImGui context during init, that can't be done from another thread
+        if (outputChanged || deviceContext->changeBackendCounter != 0 || current == nullptr || !current->IsInited() ||
+            current->Name() == "DLSSD" || backend == Upscaler::DLSS || backend == Upscaler::DLSSD ||
+            !Config::Instance()->OverlayMenu.value_or_default())
+        {
+            return false;
+        }
+
+        LOG_INFO("creating {} feature on worker thread", UpscalerCode(backend));
+
+        auto createParams = GetNGXParameters("OptiDx12");
+        createParams->Set(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, current->GetFeatureFlags());
+        createParams->Set(NVSDK_NGX_Parameter_Width, current->RenderWidth());
+        createParams->Set(NVSDK_NGX_Parameter_Height, current->RenderHeight());
+        createParams->Set(NVSDK_NGX_Parameter_OutWidth, current->DisplayWidth());
+        createParams->Set(NVSDK_NGX_Parameter_OutHeight, current->DisplayHeight());
+        createParams->Set(NVSDK_NGX_Parameter_PerfQualityValue, current->PerfQualityValue());
+
+        deviceContext->createParams = createParams;
+        deviceContext->pendingBackend = backend;
+        deviceContext->pendingFeature =
+            std::async(std::launch::async,
+                       [backend, handleId, createParams, device = D3D12Device]()
+                       {
+                           auto feature = CreateUpscaler(backend, handleId, createParams);
+
+                           if (!feature->Init(device, nullptr, createParams))
+                               feature.reset();
+
+                           return feature;
+                       });
+
+        return true;
+    }
+
+    // Output resolution changed while building, replacement would be created with old size
+    if (outputChanged)
+        deviceContext->pendingFeature.wait();
+    else if (deviceContext->pendingFeature.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return true;
+
+    auto feature = deviceContext->pendingFeature.get();
+    auto backend = deviceContext->pendingBackend;
 
-    if (orgSetComputeRootSignature != nullptr)
+    deviceContext->pendingBackend = Upscaler::None;
+
+    if (deviceContext->createParams != nullptr)
+    {
+        free(deviceContext->createParams);
+        deviceContext->createParams = nullptr;
+    }
+
+    if (outputChanged)
+        return false;
+
+    if (feature == nullptr)
+    {
+        LOG_ERROR("init failed with {} feature, current feature is kept", UpscalerCode(backend));
+
+        // Same fallback with synchronous path, but current feature keeps rendering meanwhile
+        if (backend != Upscaler::FSR21 && state.newBackend == backend)
+        {
+            state.newBackend = Upscaler::FSR21;
+        }
+        else if (state.newBackend == backend)
+        {
+            state.newBackend = Upscaler::None;
+            state.changeBackend[handleId] = false;
+        }
+
+        return true;
+    }
+
+    if (state.currentFG != nullptr && state.currentFG->IsActive())
     {
-        DetourDetach(&(PVOID&) orgSetComputeRootSignature, hkSetComputeRootSignature);
-        orgSetComputeRootSignature = nullptr;
+        state.currentFG->StopAndDestroyContext(false, false, false);
+        Hudfix_Dx12::ResetCounters();
+        state.FGchanged = true;
+        state.ClearCapturedHudlesses = true;
     }
 
-    if (orgSetGraphicRootSignature != nullptr)
+    RetireFeature(std::move(deviceContext->feature));
+    deviceContext->feature = std::move(feature);
+    state.currentFeature = deviceContext->feature.get();
+
+    Config::Instance()->Dx12Upscaler = UpscalerCode(backend);
+
+    if (auto index = EnablerBackendIndex(backend); index >= 0)
+        InParameters->Set("DLSSEnabler.Dx12Backend", index);
+
+    LOG_INFO("init successful for {}, upscaler changed", UpscalerCode(backend));
+
+    // Another backend might be selected while building this one
+    if (state.newBackend == backend)
     {
-        DetourDetach(&(PVOID&) orgSetGraphicRootSignature, hkSetGraphicRootSignature);
-        orgSetGraphicRootSignature = nullptr;
+        state.newBackend = Upscaler::None;
+        state.changeBackend[handleId] = false;
     }
 
-    DetourTransactionCommit();
+    evalCounter = 0;
+
+    if (state.currentFG != nullptr)
+        state.currentFG->UpdateTarget();
+
+    return true;
 }
 
 #pragma endregion
@@ -464,6 +721,23 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init_with_ProjectID(
 
 #pragma endregion
 
+// Only one of the contexts feeds FG & Hudfix, see FGContextSelector
+static bool IsFGContext(unsigned int handleId)
+{
+    if (Dx12Contexts.size() < 2)
+        return true;
+
+    FGContextSelector selector;
+
+    for (auto const& [handle, context] : Dx12Contexts)
+    {
+        if (context.feature != nullptr)
+            selector.Add(handle, context.feature->DisplayWidth(), context.feature->DisplayHeight());
+    }
+
+    return selector.IsSelected(handleId);
+}
+
 #pragma region DLSS Shutdown Calls
 
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Shutdown(void)
@@ -482,6 +756,10 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Shutdown(void)
 
     // Dx12Contexts.clear();
 
+    ReleaseRetiredFeatures();
+    ShaderPool_Dx12::Clear();
+    DescriptorHeap_Dx12::Clear();
+
     D3D12Device = nullptr;
 
     State::Instance().currentFeature = nullptr;
@@ -886,7 +1164,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
     else
     {
         LOG_ERROR("CreateFeature failed, returning to FSR 2.1.2 upscaler");
-        State::Instance().newBackend = "fsr21";
+        State::Instance().newBackend = Upscaler::FSR21;
         State::Instance().changeBackend[handleId] = true;
     }
 
@@ -971,6 +1249,19 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
         return DLSSGMod::D3D12_ReleaseFeature(InHandle);
     }
 
+    // Wait for replacement which is still building, it's not referenced by anything else
+    if (Dx12Contexts.contains(handleId) && Dx12Contexts[handleId].pendingFeature.valid())
+    {
+        Dx12Contexts[handleId].pendingFeature.get();
+        Dx12Contexts[handleId].pendingBackend = Upscaler::None;
+
+        if (Dx12Contexts[handleId].createParams != nullptr)
+        {
+            free(Dx12Contexts[handleId].createParams);
+            Dx12Contexts[handleId].createParams = nullptr;
+        }
+    }
+
     if (auto deviceContext = Dx12Contexts[handleId].feature.get(); deviceContext != nullptr)
     {
         if (deviceContext == State::Instance().currentFeature)
@@ -1143,6 +1434,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
                                                                    IID_PPV_ARGS(&copiedDlssgDepth));
                 if (result == S_OK)
                 {
+                    VramTracker::Track(copiedDlssgDepth, VramOwner::Inputs);
                     InCmdList->CopyResource(copiedDlssgDepth, dlssgDepth);
                     InParameters->Set("DLSSG.Depth",
                                       (void*) copiedDlssgDepth); // cast to make sure it's void*, otherwise dlssg cries
@@ -1253,6 +1545,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         }
     }
 
+    bool outputChanged = false;
+
     if (deviceContext->feature)
     {
         auto* feature = deviceContext->feature.get();
@@ -1260,15 +1554,21 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         // FSR 3.1 supports upscaleSize that doesn't need reinit to change output resolution
         if (!(feature->Name().starts_with("FSR") && feature->Version() >= feature_version { 3, 1, 0 }) &&
             feature->UpdateOutputResolution(InParameters))
+        {
             State::Instance().changeBackend[handleId] = true;
+            outputChanged = true;
+        }
     }
 
+    UpdateRetiredFeatures();
+
     // Change backend
-    if (State::Instance().changeBackend[handleId])
+    if (State::Instance().changeBackend[handleId] &&
+        !ChangeBackendAsync(handleId, deviceContext, InParameters, outputChanged))
     {
-        if (State::Instance().newBackend == "" ||
-            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == "dlss"))
-            State::Instance().newBackend = Config::Instance()->Dx12Upscaler.value_or_default();
+        if (State::Instance().newBackend == Upscaler::None ||
+            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == Upscaler::DLSS))
+            State::Instance().newBackend = UpscalerFromCode(Config::Instance()->Dx12Upscaler.value_or_default());
 
         deviceContext->changeBackendCounter++;
 
@@ -1287,11 +1587,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
             if (Dx12Contexts.contains(handleId) && deviceContext->feature != nullptr)
             {
-                LOG_INFO("changing backend to {0}", State::Instance().newBackend);
+                LOG_INFO("changing backend to {0}", UpscalerCode(State::Instance().newBackend));
 
                 auto dc = deviceContext->feature.get();
 
-                if (State::Instance().newBackend != "dlssd" && State::Instance().newBackend != "dlss")
+                if (State::Instance().newBackend != Upscaler::DLSSD && State::Instance().newBackend != Upscaler::DLSS)
                     deviceContext->createParams = GetNGXParameters("OptiDx12");
                 else
                     deviceContext->createParams = InParameters;
@@ -1329,7 +1629,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             {
                 LOG_ERROR("can't find handle {0} in Dx12Contexts!", handleId);
 
-                State::Instance().newBackend = "";
+                State::Instance().newBackend = Upscaler::None;
                 State::Instance().changeBackend[handleId] = false;
 
                 if (deviceContext->createParams != nullptr)
@@ -1347,58 +1647,16 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         // create new feature
         if (deviceContext->changeBackendCounter == 2)
         {
-            // backend selection
-            // 0 : XeSS
-            // 1 : FSR2.2
-            // 2 : FSR2.1
-            // 3 : DLSS
-            // 4 : FSR3.1
-            int upscalerChoice = -1;
-
-            // prepare new upscaler
-            if (State::Instance().newBackend == "fsr22")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr22";
-                LOG_INFO("creating new FSR 2.2.1 feature");
-                deviceContext->feature = std::make_unique<FSR2FeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 1;
-            }
-            else if (State::Instance().newBackend == "fsr21")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr21";
-                LOG_INFO("creating new FSR 2.1.2 feature");
-                deviceContext->feature = std::make_unique<FSR2FeatureDx12_212>(handleId, deviceContext->createParams);
-                upscalerChoice = 2;
-            }
-            else if (State::Instance().newBackend == "dlss")
-            {
-                Config::Instance()->Dx12Upscaler = "dlss";
-                LOG_INFO("creating new DLSS feature");
-                deviceContext->feature = std::make_unique<DLSSFeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 3;
-            }
-            else if (State::Instance().newBackend == "dlssd")
-            {
-                LOG_INFO("creating new DLSSD feature");
-                deviceContext->feature = std::make_unique<DLSSDFeatureDx12>(handleId, deviceContext->createParams);
-            }
-            else if (State::Instance().newBackend == "fsr31")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr31";
-                LOG_INFO("creating new FSR 3.X feature");
-                deviceContext->feature = std::make_unique<FSR31FeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 4;
-            }
-            else
-            {
-                Config::Instance()->Dx12Upscaler = "xess";
-                LOG_INFO("creating new XeSS feature");
-                deviceContext->feature = std::make_unique<XeSSFeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 0;
-            }
+            auto backend = SupportedBackend(State::Instance().newBackend);
 
-            if (upscalerChoice >= 0)
-                InParameters->Set("DLSSEnabler.Dx12Backend", upscalerChoice);
+            if (backend != Upscaler::DLSSD)
+                Config::Instance()->Dx12Upscaler = UpscalerCode(backend);
+
+            LOG_INFO("creating new {} feature", UpscalerCode(backend));
+            deviceContext->feature = CreateUpscaler(backend, handleId, deviceContext->createParams);
+
+            if (auto index = EnablerBackendIndex(backend); index >= 0)
+                InParameters->Set("DLSSEnabler.Dx12Backend", index);
 
             return NVSDK_NGX_Result_Success;
         }
@@ -1412,25 +1670,25 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
             if (!initResult)
             {
-                LOG_ERROR("init failed with {0} feature", State::Instance().newBackend);
+                LOG_ERROR("init failed with {0} feature", UpscalerCode(State::Instance().newBackend));
 
-                if (State::Instance().newBackend != "dlssd")
+                if (State::Instance().newBackend != Upscaler::DLSSD)
                 {
                     if (Config::Instance()->Dx12Upscaler == "dlss")
                     {
-                        State::Instance().newBackend = "xess";
+                        State::Instance().newBackend = Upscaler::XeSS;
                         InParameters->Set("DLSSEnabler.Dx12Backend", 0);
                     }
                     else
                     {
-                        State::Instance().newBackend = "fsr21";
+                        State::Instance().newBackend = Upscaler::FSR21;
                         InParameters->Set("DLSSEnabler.Dx12Backend", 2);
                     }
                 }
                 else
                 {
                     // Retry DLSSD
-                    State::Instance().newBackend = "dlssd";
+                    State::Instance().newBackend = Upscaler::DLSSD;
                 }
 
                 State::Instance().changeBackend[handleId] = true;
@@ -1438,9 +1696,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             }
             else
             {
-                LOG_INFO("init successful for {0}, upscaler changed", State::Instance().newBackend);
+                LOG_INFO("init successful for {0}, upscaler changed", UpscalerCode(State::Instance().newBackend));
 
-                State::Instance().newBackend = "";
+                State::Instance().newBackend = Upscaler::None;
                 State::Instance().changeBackend[handleId] = false;
                 evalCounter = 0;
             }
@@ -1457,7 +1715,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
         // if initial feature can't be inited
         State::Instance().currentFeature = deviceContext->feature.get();
-        if (State::Instance().currentFG != nullptr)
+        if (State::Instance().currentFG != nullptr && IsFGContext(handleId))
             State::Instance().currentFG->UpdateTarget();
 
         // return NVSDK_NGX_Result_Success;
@@ -1472,7 +1730,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     if (!deviceContext->feature->IsInited() && Config::Instance()->Dx12Upscaler.value_or_default() != "fsr21")
     {
         LOG_WARN("InCmdList {0} is not inited, falling back to FSR 2.1.2", deviceContext->feature->Name());
-        State::Instance().newBackend = "fsr21";
+        State::Instance().newBackend = Upscaler::FSR21;
         State::Instance().changeBackend[handleId] = true;
         return NVSDK_NGX_Result_Success;
     }
@@ -1484,12 +1742,13 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
                                                       Config::Instance()->RestoreGraphicSignature.value_or_default()))
         contextRendering = true;
 
+    // Other views are upscaled without touching FG state
     IFGFeature_Dx12* fg = nullptr;
-    if (State::Instance().currentFG != nullptr)
+    if (State::Instance().currentFG != nullptr && IsFGContext(handleId))
         fg = State::Instance().currentFG;
 
     // FG Init || Disable
-    if (State::Instance().activeFgType == OptiFG && Config::Instance()->OverlayMenu.value_or_default())
+    if (fg != nullptr && State::Instance().activeFgType == OptiFG && Config::Instance()->OverlayMenu.value_or_default())
     {
         if (!State::Instance().FGchanged && Config::Instance()->FGEnabled.value_or_default() && !fg->IsPaused() &&
             FfxApiProxy::InitFfxDx12() && !fg->IsActive() && HooksDx::CurrentSwapchainFormat() != DXGI_FORMAT_UNKNOWN)
@@ -1602,14 +1861,6 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         Config::Instance()->FGEnabled.value_or_default() && !fg->IsPaused() &&
         State::Instance().currentSwapchain != nullptr)
     {
-        // Wait for present
-        if (fg->Mutex.getOwner() == 2)
-        {
-            LOG_TRACE("Waiting for present!");
-            fg->Mutex.lock(4);
-            fg->Mutex.unlockThis(4);
-        }
-
         ResTrack_Dx12::SetInputsCmdList(InCmdList);
         bool allocatorReset = false;
         frameIndex = fg->GetIndex();
@@ -1637,44 +1888,51 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         if (InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, &paramVelocity) != NVSDK_NGX_Result_Success)
             InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, (void**) &paramVelocity);
 
-        if (paramVelocity != nullptr)
-            fg->SetVelocity(commandList, paramVelocity,
-                            (D3D12_RESOURCE_STATES) Config::Instance()->MVResourceBarrier.value_or(
-                                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
-
         ID3D12Resource* paramDepth = nullptr;
         if (InParameters->Get(NVSDK_NGX_Parameter_Depth, &paramDepth) != NVSDK_NGX_Result_Success)
             InParameters->Get(NVSDK_NGX_Parameter_Depth, (void**) &paramDepth);
 
-        if (paramDepth != nullptr)
+        // Flip & depth scale of both inputs in a single dispatch
+        if (!fg->PrepareInputs(commandList, paramVelocity, paramDepth,
+                               Config::Instance()->FGEnableDepthScale.value_or_default()))
         {
-            auto done = false;
+            if (paramVelocity != nullptr)
+                fg->SetVelocity(commandList, paramVelocity,
+                                (D3D12_RESOURCE_STATES) Config::Instance()->MVResourceBarrier.value_or(
+                                    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
 
-            if (Config::Instance()->FGEnableDepthScale.value_or_default())
+            if (paramDepth != nullptr)
             {
-                if (DepthScale == nullptr)
-                    DepthScale = new DS_Dx12("Depth Scale", D3D12Device);
+                auto done = false;
 
-                if (DepthScale->CreateBufferResource(D3D12Device, paramDepth, deviceContext->feature->DisplayWidth(),
-                                                     deviceContext->feature->DisplayHeight(),
-                                                     D3D12_RESOURCE_STATE_UNORDERED_ACCESS) &&
-                    DepthScale->Buffer() != nullptr)
+                if (Config::Instance()->FGEnableDepthScale.value_or_default())
                 {
-                    DepthScale->SetBufferState(InCmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-
-                    if (DepthScale->Dispatch(D3D12Device, InCmdList, paramDepth, DepthScale->Buffer()))
+                    if (DepthScale == nullptr)
+                        DepthScale = new DS_Dx12("Depth Scale", D3D12Device);
+
+                    if (DepthScale->CreateBufferResource(D3D12Device, paramDepth,
+                                                         deviceContext->feature->DisplayWidth(),
+                                                         deviceContext->feature->DisplayHeight(),
+                                                         D3D12_RESOURCE_STATE_UNORDERED_ACCESS) &&
+                        DepthScale->Buffer() != nullptr)
                     {
-                        DepthScale->SetBufferState(InCmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-                        fg->SetDepth(commandList, DepthScale->Buffer(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-                        done = true;
+                        DepthScale->SetBufferState(InCmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+                        if (DepthScale->Dispatch(D3D12Device, InCmdList, paramDepth, DepthScale->Buffer()))
+                        {
+                            DepthScale->SetBufferState(InCmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                            fg->SetDepth(commandList, DepthScale->Buffer(),
+                                         D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                            done = true;
+                        }
                     }
                 }
-            }
 
-            if (!done)
-                fg->SetDepth(commandList, paramDepth,
-                             (D3D12_RESOURCE_STATES) Config::Instance()->DepthResourceBarrier.value_or(
-                                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+                if (!done)
+                    fg->SetDepth(commandList, paramDepth,
+                                 (D3D12_RESOURCE_STATES) Config::Instance()->DepthResourceBarrier.value_or(
+                                     D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+            }
         }
 
 #ifdef USE_COPY_QUEUE_FOR_FG
@@ -1692,6 +1950,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         InCmdList->EndQuery(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 0);
 
     // Run upscaler
+    ResTrack_Dx12::SetUpscalerCmdList(InCmdList);
     auto evalResult = deviceContext->feature->Evaluate(InCmdList, InParameters);
 
     // Record the second timestamp
@@ -1710,6 +1969,13 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     {
         HooksDx::dx12UpscaleTrig = true;
 
+        if (Benchmark::CaptureRequested())
+        {
+            Benchmark::CaptureOutput(InCmdList, output,
+                                     (D3D12_RESOURCE_STATES) Config::Instance()->OutputResourceBarrier.value_or(
+                                         D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+        }
+
         // FG Dispatch
         if (fg != nullptr && fg->IsActive() && State::Instance().activeFgType == OptiFG &&
             Config::Instance()->OverlayMenu.value_or_default() && Config::Instance()->FGEnabled.value_or_default() &&
@@ -16,6 +16,10 @@
 #include "upscalers/xess/XeSSFeature_Vk.h"
 
 #include "hooks/HooksVk.h"
+#include "hudfix/Hudfix_Vk.h"
+#include "framegen/ffx/FSRFG_Vk.h"
+#include "shaders/DescriptorPool_Vk.h"
+#include "shaders/PipelineCache_Vk.h"
 
 #include <ankerl/unordered_dense.h>
 #include <vulkan/vulkan.hpp>
@@ -904,6 +908,149 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_ReleaseFeature(NVSDK_NGX_Handle*
     return NVSDK_NGX_Result_Success;
 }
 
+static bool GetFGResource(NVSDK_NGX_Parameter* InParameters, const char* name, FGResourceVk* resource)
+{
+    void* param = nullptr;
+    if (InParameters->Get(name, &param) != NVSDK_NGX_Result_Success || param == nullptr)
+        return false;
+
+    auto vkResource = (NVSDK_NGX_Resource_VK*) param;
+    auto& viewInfo = vkResource->Resource.ImageViewInfo;
+
+    resource->image = viewInfo.Image;
+    resource->format = viewInfo.Format;
+    resource->width = viewInfo.Width;
+    resource->height = viewInfo.Height;
+    resource->depth = (viewInfo.SubresourceRange.aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT) > 0;
+    resource->layout = vkResource->ReadWrite ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    return resource->image != VK_NULL_HANDLE;
+}
+
+// Returns true when frame generation is running for this frame
+static bool PrepareFrameGeneration(IFeature_Vk* feature, NVSDK_NGX_Parameter* InParameters)
+{
+    auto fg = State::Instance().currentVkFG;
+
+    if (fg == nullptr || State::Instance().activeFgType != OptiFG ||
+        !Config::Instance()->OverlayMenu.value_or_default() || !Config::Instance()->FGVulkan.value_or_default())
+    {
+        return false;
+    }
+
+    // FG Init || Disable
+    if (!State::Instance().FGchanged && Config::Instance()->FGEnabled.value_or_default() && !fg->IsPaused() &&
+        !fg->IsActive() && fg->SwapchainContext() != nullptr)
+    {
+        fg->CreateContext(feature->GetFeatureFlags(), feature->DisplayWidth(), feature->DisplayHeight());
+        fg->ResetCounters();
+        fg->UpdateTarget();
+
+        Hudfix_Vk::SetCaptureCallback(
+            [fg](VkCommandBuffer cmdBuffer, ImageInfo* image) -> bool
+            {
+                FGResourceVk hudless { image->image, image->format, image->width, image->height, image->layout };
+                fg->SetHudless(cmdBuffer, &hudless);
+                fg->SetHudlessReady();
+
+                return fg->Dispatch(cmdBuffer);
+            });
+    }
+    else if ((!Config::Instance()->FGEnabled.value_or_default() || State::Instance().FGchanged) && fg->IsActive())
+    {
+        fg->StopAndDestroyContext(State::Instance().SCchanged, false, false);
+        Hudfix_Vk::SetCaptureCallback(nullptr);
+        State::Instance().ClearCapturedHudlesses = true;
+        Hudfix_Vk::ResetCounters();
+    }
+
+    if (State::Instance().FGchanged)
+    {
+        LOG_DEBUG("(FG) Frame generation paused");
+        fg->ResetCounters();
+        fg->UpdateTarget();
+        Hudfix_Vk::ResetCounters();
+
+        State::Instance().FGchanged = false;
+    }
+
+    State::Instance().SCchanged = false;
+
+    // FSR Camera values
+    float cameraNear = 0.0f;
+    float cameraFar = 0.0f;
+    float cameraVFov = 0.0f;
+    float meterFactor = 0.0f;
+    float mvScaleX = 0.0f;
+    float mvScaleY = 0.0f;
+    int reset = 0;
+
+    if (!Config::Instance()->FsrUseFsrInputValues.value_or_default() ||
+        InParameters->Get("FSR.cameraNear", &cameraNear) != NVSDK_NGX_Result_Success)
+    {
+        if (feature->DepthInverted())
+            cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
+        else
+            cameraNear = Config::Instance()->FsrCameraNear.value_or_default();
+    }
+
+    if (!Config::Instance()->FsrUseFsrInputValues.value_or_default() ||
+        InParameters->Get("FSR.cameraFar", &cameraFar) != NVSDK_NGX_Result_Success)
+    {
+        if (feature->DepthInverted())
+            cameraNear = Config::Instance()->FsrCameraFar.value_or_default();
+        else
+            cameraFar = Config::Instance()->FsrCameraFar.value_or_default();
+    }
+
+    if (!Config::Instance()->FsrUseFsrInputValues.value_or_default() ||
+        InParameters->Get("FSR.cameraFovAngleVertical", &cameraVFov) != NVSDK_NGX_Result_Success)
+    {
+        if (Config::Instance()->FsrVerticalFov.has_value())
+            cameraVFov = Config::Instance()->FsrVerticalFov.value() * 0.0174532925199433f;
+        else if (Config::Instance()->FsrHorizontalFov.value_or_default() > 0.0f)
+            cameraVFov = 2.0f * atan((tan(Config::Instance()->FsrHorizontalFov.value() * 0.0174532925199433f) * 0.5f) /
+                                     (float) feature->TargetHeight() * (float) feature->TargetWidth());
+        else
+            cameraVFov = 1.0471975511966f;
+    }
+
+    if (!Config::Instance()->FsrUseFsrInputValues.value_or_default())
+        InParameters->Get("FSR.viewSpaceToMetersFactor", &meterFactor);
+
+    InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &mvScaleX);
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &mvScaleY);
+
+    fg->StartNewFrame();
+
+    fg->SetCameraValues(cameraNear, cameraFar, cameraVFov, meterFactor);
+    fg->SetFrameTimeDelta(State::Instance().lastFrameTime);
+    fg->SetMVScale(mvScaleX, mvScaleY);
+    fg->SetReset(reset);
+
+    if (State::Instance().isShuttingDown || !fg->IsActive() || !Config::Instance()->FGEnabled.value_or_default() ||
+        fg->IsPaused())
+    {
+        return false;
+    }
+
+    // Prepare pass is recorded into the frame before inputs are reused, they are referenced without copies
+    FGResourceVk velocity {};
+    FGResourceVk depth {};
+
+    if (GetFGResource(InParameters, NVSDK_NGX_Parameter_MotionVectors, &velocity))
+        fg->SetVelocity(&velocity);
+
+    if (GetFGResource(InParameters, NVSDK_NGX_Parameter_Depth, &depth))
+        fg->SetDepth(&depth);
+
+    if (velocity.image != VK_NULL_HANDLE && depth.image != VK_NULL_HANDLE)
+        fg->SetUpscaleInputsReady();
+
+    return fg->UpscalerInputsReady();
+}
+
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer InCmdList,
                                                                 const NVSDK_NGX_Handle* InFeatureHandle,
                                                                 NVSDK_NGX_Parameter* InParameters,
@@ -1031,9 +1178,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
 
     if (State::Instance().changeBackend[handleId])
     {
-        if (State::Instance().newBackend == "" ||
-            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == "dlss"))
-            State::Instance().newBackend = Config::Instance()->VulkanUpscaler.value_or_default();
+        if (State::Instance().newBackend == Upscaler::None ||
+            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == Upscaler::DLSS))
+            State::Instance().newBackend = UpscalerFromCode(Config::Instance()->VulkanUpscaler.value_or_default());
 
         VkContexts[handleId].changeBackendCounter++;
 
@@ -1044,11 +1191,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
         {
             if (VkContexts.contains(handleId) && VkContexts[handleId].feature != nullptr)
             {
-                LOG_INFO("changing backend to {0}", State::Instance().newBackend);
+                LOG_INFO("changing backend to {0}", UpscalerCode(State::Instance().newBackend));
 
                 auto dc = VkContexts[handleId].feature.get();
 
-                if (State::Instance().newBackend != "dlssd" && State::Instance().newBackend != "dlss")
+                if (State::Instance().newBackend != Upscaler::DLSSD && State::Instance().newBackend != Upscaler::DLSS)
                     VkContexts[handleId].createParams = GetNGXParameters("OptiVk");
                 else
                     VkContexts[handleId].createParams = InParameters;
@@ -1077,7 +1224,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
             {
                 LOG_ERROR("can't find handle {0} in VkContexts!", handleId);
 
-                State::Instance().newBackend = "";
+                State::Instance().newBackend = Upscaler::None;
                 State::Instance().changeBackend[handleId] = false;
 
                 if (VkContexts[handleId].createParams != nullptr)
@@ -1103,7 +1250,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
             int upscalerChoice = -1; // Default FSR2.1
 
             // prepare new upscaler
-            if (State::Instance().newBackend == "fsr22")
+            if (State::Instance().newBackend == Upscaler::FSR22)
             {
                 Config::Instance()->VulkanUpscaler = "fsr22";
                 LOG_INFO("creating new FSR 2.2.1 feature");
@@ -1111,7 +1258,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
                     std::make_unique<FSR2FeatureVk>(handleId, VkContexts[handleId].createParams);
                 upscalerChoice = 1;
             }
-            else if (State::Instance().newBackend == "dlss")
+            else if (State::Instance().newBackend == Upscaler::DLSS)
             {
                 Config::Instance()->VulkanUpscaler = "dlss";
                 LOG_INFO("creating new DLSS feature");
@@ -1119,7 +1266,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
                     std::make_unique<DLSSFeatureVk>(handleId, VkContexts[handleId].createParams);
                 upscalerChoice = 2;
             }
-            else if (State::Instance().newBackend == "fsr31")
+            else if (State::Instance().newBackend == Upscaler::FSR31)
             {
                 Config::Instance()->VulkanUpscaler = "fsr31";
                 LOG_INFO("creating new FSR 3.X feature");
@@ -1127,12 +1274,12 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
                     std::make_unique<FSR31FeatureVk>(handleId, VkContexts[handleId].createParams);
                 upscalerChoice = 3;
             }
-            else if (State::Instance().newBackend == "dlssd")
+            else if (State::Instance().newBackend == Upscaler::DLSSD)
             {
                 LOG_INFO("creating new DLSSD feature");
                 VkContexts[handleId].feature = std::make_unique<DLSSDFeatureVk>(handleId, InParameters);
             }
-            else if (State::Instance().newBackend == "xess")
+            else if (State::Instance().newBackend == Upscaler::XeSS)
             {
                 Config::Instance()->VulkanUpscaler = "xess";
                 LOG_INFO("creating new XeSS feature");
@@ -1163,25 +1310,25 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
 
             if (!initResult || !VkContexts[handleId].feature->ModuleLoaded())
             {
-                LOG_ERROR("init failed with {0} feature", State::Instance().newBackend);
+                LOG_ERROR("init failed with {0} feature", UpscalerCode(State::Instance().newBackend));
 
-                if (State::Instance().newBackend != "dlssd")
+                if (State::Instance().newBackend != Upscaler::DLSSD)
                 {
-                    State::Instance().newBackend = "fsr21";
+                    State::Instance().newBackend = Upscaler::FSR21;
                     State::Instance().changeBackend[handleId] = true;
                 }
                 else
                 {
-                    State::Instance().newBackend = "";
+                    State::Instance().newBackend = Upscaler::None;
                     State::Instance().changeBackend[handleId] = false;
                     return NVSDK_NGX_Result_Success;
                 }
             }
             else
             {
-                LOG_INFO("init successful for {0}, upscaler changed", State::Instance().newBackend);
+                LOG_INFO("init successful for {0}, upscaler changed", UpscalerCode(State::Instance().newBackend));
 
-                State::Instance().newBackend = "";
+                State::Instance().newBackend = Upscaler::None;
                 State::Instance().changeBackend[handleId] = false;
                 evalCounter = 0;
             }
@@ -1207,11 +1354,13 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
 
     if (!deviceContext->IsInited() && Config::Instance()->VulkanUpscaler.value_or_default() != "fsr21")
     {
-        State::Instance().newBackend = "fsr21";
+        State::Instance().newBackend = Upscaler::FSR21;
         State::Instance().changeBackend[handleId] = true;
         return NVSDK_NGX_Result_Success;
     }
 
+    auto fgRunning = PrepareFrameGeneration(deviceContext, InParameters);
+
     // Record the first timestamp (before FSR2)
     vkCmdWriteTimestamp(InCmdList, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, HooksVk::queryPool, 0);
 
@@ -1221,6 +1370,17 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
     vkCmdWriteTimestamp(InCmdList, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, HooksVk::queryPool, 1);
     HooksVk::vkUpscaleTrig = true;
 
+    // Hudless checks start after upscaling, FG is dispatched when hudless is captured
+    if (upscaleResult && Config::Instance()->FGHUDFix.value_or_default())
+    {
+        Hudfix_Vk::UpscaleEnd();
+    }
+    else if (upscaleResult && fgRunning)
+    {
+        LOG_DEBUG("(FG) running, frame: {0}", deviceContext->FrameCount());
+        State::Instance().currentVkFG->Dispatch(InCmdList);
+    }
+
     return upscaleResult ? NVSDK_NGX_Result_Success : NVSDK_NGX_Result_Fail;
 }
 
@@ -1235,6 +1395,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_Shutdown(void)
 
     // VkContexts.clear();
 
+    DescriptorPool_Vk::Clear();
+    PipelineCache_Vk::Release();
+
     vkInstance = nullptr;
     vkPD = nullptr;
     vkDevice = nullptr;
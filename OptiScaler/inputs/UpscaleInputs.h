@@ -0,0 +1,172 @@
+#pragma once
+
+#include <nvsdk_ngx_params.h>
+
+#include <optional>
+
+// Per frame upscaler inputs of the FFX/XeSS input layers
+// Dispatch descriptions are translated to this struct first and only the values
+// that are changed since last frame are written to the NGX parameters.
+// Width, Height, Output and Sharpness are written every frame because backends
+// overwrite them in parameters during evaluate.
+
+typedef struct UpscaleSubrectBases
+{
+    unsigned int colorX = 0;
+    unsigned int colorY = 0;
+    unsigned int depthX = 0;
+    unsigned int depthY = 0;
+    unsigned int mvX = 0;
+    unsigned int mvY = 0;
+    unsigned int outputX = 0;
+    unsigned int outputY = 0;
+    unsigned int biasX = 0;
+    unsigned int biasY = 0;
+
+    bool operator==(const UpscaleSubrectBases&) const = default;
+} upscale_subrect_bases;
+
+typedef struct UpscaleInputs
+{
+    float jitterX = 0.0f;
+    float jitterY = 0.0f;
+    std::optional<float> mvScaleX;
+    std::optional<float> mvScaleY;
+    float exposureScale = 1.0f;
+    std::optional<float> preExposure;
+    int reset = 0;
+
+    unsigned int renderWidth = 0;
+    unsigned int renderHeight = 0;
+
+    void* color = nullptr;
+    void* depth = nullptr;
+    void* motionVectors = nullptr;
+    void* exposure = nullptr;
+    void* output = nullptr;
+
+    // DLSS bias mask and FSR reactive mask are separate keys, FFX inputs set both
+    std::optional<void*> biasColorMask;
+    std::optional<void*> reactive;
+    std::optional<void*> transparency;
+
+    std::optional<float> cameraNear;
+    std::optional<float> cameraFar;
+    std::optional<float> cameraVFov;
+    std::optional<float> frameTimeDelta;
+    std::optional<float> meterFactor;
+    std::optional<float> sharpness;
+
+    std::optional<unsigned int> upscaleWidth;
+    std::optional<unsigned int> upscaleHeight;
+
+    std::optional<UpscaleSubrectBases> subrectBases;
+
+    // Set after inputs are written to parameters at least once
+    bool applied = false;
+} upscale_inputs;
+
+template <typename T>
+inline static void SetIfChanged(NVSDK_NGX_Parameter* InParams, const char* InKey, const T& InValue, const T& InLast,
+                                bool InForce)
+{
+    if (InForce || !(InValue == InLast))
+        InParams->Set(InKey, InValue);
+}
+
+template <typename T>
+inline static void SetIfChanged(NVSDK_NGX_Parameter* InParams, const char* InKey, const std::optional<T>& InValue,
+                                const std::optional<T>& InLast, bool InForce)
+{
+    if (InValue.has_value() && (InForce || InValue != InLast))
+        InParams->Set(InKey, InValue.value());
+}
+
+// Writes changed inputs to InParams and updates InLast
+inline static void ApplyUpscaleInputs(NVSDK_NGX_Parameter* InParams, const UpscaleInputs& InInputs,
+                                      UpscaleInputs& InLast)
+{
+    auto force = !InLast.applied;
+
+    // Always written, backends might change them
+    InParams->Set(NVSDK_NGX_Parameter_Width, InInputs.renderWidth);
+    InParams->Set(NVSDK_NGX_Parameter_Height, InInputs.renderHeight);
+    InParams->Set(NVSDK_NGX_Parameter_Output, InInputs.output);
+
+    if (InInputs.sharpness.has_value())
+        InParams->Set(NVSDK_NGX_Parameter_Sharpness, InInputs.sharpness.value());
+
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_Jitter_Offset_X, InInputs.jitterX, InLast.jitterX, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_Jitter_Offset_Y, InInputs.jitterY, InLast.jitterY, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_MV_Scale_X, InInputs.mvScaleX, InLast.mvScaleX, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_MV_Scale_Y, InInputs.mvScaleY, InLast.mvScaleY, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_DLSS_Exposure_Scale, InInputs.exposureScale, InLast.exposureScale,
+                 force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_DLSS_Pre_Exposure, InInputs.preExposure, InLast.preExposure, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_Reset, InInputs.reset, InLast.reset, force);
+
+    if (force || InInputs.renderWidth != InLast.renderWidth || InInputs.renderHeight != InLast.renderHeight)
+    {
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, InInputs.renderWidth);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, InInputs.renderHeight);
+    }
+
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_Color, InInputs.color, InLast.color, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_Depth, InInputs.depth, InLast.depth, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_MotionVectors, InInputs.motionVectors, InLast.motionVectors, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_ExposureTexture, InInputs.exposure, InLast.exposure, force);
+    SetIfChanged(InParams, NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, InInputs.biasColorMask,
+                 InLast.biasColorMask, force);
+    SetIfChanged(InParams, "FSR.reactive", InInputs.reactive, InLast.reactive, force);
+    SetIfChanged(InParams, "FSR.transparencyAndComposition", InInputs.transparency, InLast.transparency, force);
+
+    SetIfChanged(InParams, "FSR.cameraNear", InInputs.cameraNear, InLast.cameraNear, force);
+    SetIfChanged(InParams, "FSR.cameraFar", InInputs.cameraFar, InLast.cameraFar, force);
+    SetIfChanged(InParams, "FSR.cameraFovAngleVertical", InInputs.cameraVFov, InLast.cameraVFov, force);
+    SetIfChanged(InParams, "FSR.frameTimeDelta", InInputs.frameTimeDelta, InLast.frameTimeDelta, force);
+    SetIfChanged(InParams, "FSR.viewSpaceToMetersFactor", InInputs.meterFactor, InLast.meterFactor, force);
+    SetIfChanged(InParams, "FSR.upscaleSize.width", InInputs.upscaleWidth, InLast.upscaleWidth, force);
+    SetIfChanged(InParams, "FSR.upscaleSize.height", InInputs.upscaleHeight, InLast.upscaleHeight, force);
+
+    if (InInputs.subrectBases.has_value() && (force || InInputs.subrectBases != InLast.subrectBases))
+    {
+        auto& bases = InInputs.subrectBases.value();
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X, bases.colorX);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y, bases.colorY);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X, bases.depthX);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y, bases.depthY);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X, bases.mvX);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y, bases.mvY);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X, bases.outputX);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y, bases.outputY);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X, bases.biasX);
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y, bases.biasY);
+    }
+
+    InLast = InInputs;
+    InLast.applied = true;
+}
+
+// Fills common inputs of FSR2/FSR3 dispatch descriptions, member names are same in all versions
+template <typename T> inline static void GetFfxUpscaleInputs(const T* InDesc, UpscaleInputs& OutInputs)
+{
+    OutInputs.jitterX = InDesc->jitterOffset.x;
+    OutInputs.jitterY = InDesc->jitterOffset.y;
+    OutInputs.mvScaleX = InDesc->motionVectorScale.x;
+    OutInputs.mvScaleY = InDesc->motionVectorScale.y;
+    OutInputs.exposureScale = 1.0f;
+    OutInputs.preExposure = InDesc->preExposure;
+    OutInputs.reset = InDesc->reset ? 1 : 0;
+    OutInputs.renderWidth = InDesc->renderSize.width;
+    OutInputs.renderHeight = InDesc->renderSize.height;
+    OutInputs.color = InDesc->color.resource;
+    OutInputs.depth = InDesc->depth.resource;
+    OutInputs.motionVectors = InDesc->motionVectors.resource;
+    OutInputs.exposure = InDesc->exposure.resource;
+    OutInputs.output = InDesc->output.resource;
+    OutInputs.cameraNear = InDesc->cameraNear;
+    OutInputs.cameraFar = InDesc->cameraFar;
+    OutInputs.cameraVFov = InDesc->cameraFovAngleVertical;
+    OutInputs.frameTimeDelta = InDesc->frameTimeDelta;
+    OutInputs.sharpness = InDesc->sharpness;
+}
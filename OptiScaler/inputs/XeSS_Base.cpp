@@ -2,6 +2,7 @@
 
 std::map<xess_context_handle_t, NVSDK_NGX_Parameter*> _nvParams;
 std::map<xess_context_handle_t, NVSDK_NGX_Handle*> _contexts;
+std::map<xess_context_handle_t, UpscaleInputs> _lastInputs;
 std::map<xess_context_handle_t, Scale> _motionScales;
 std::map<xess_context_handle_t, Scale> _jitterScales;
 std::map<xess_context_handle_t, xess_d3d12_init_params_t> _d3d12InitParams;
@@ -3,6 +3,8 @@
 #include "pch.h"
 #include <map>
 
+#include "UpscaleInputs.h"
+
 #include <xess_d3d12.h>
 #include <xess_vk.h>
 
@@ -14,6 +16,7 @@ typedef struct Scale
 
 extern std::map<xess_context_handle_t, NVSDK_NGX_Parameter*> _nvParams;
 extern std::map<xess_context_handle_t, NVSDK_NGX_Handle*> _contexts;
+extern std::map<xess_context_handle_t, UpscaleInputs> _lastInputs;
 extern std::map<xess_context_handle_t, Scale> _motionScales;
 extern std::map<xess_context_handle_t, Scale> _jitterScales;
 extern std::map<xess_context_handle_t, xess_d3d12_init_params_t> _d3d12InitParams;
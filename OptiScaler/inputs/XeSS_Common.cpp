@@ -3,12 +3,16 @@
 #include "XeSS_Base.h"
 
 #include <proxies/XeSS_Proxy.h>
+#include <misc/RenderScale.h>
 #include <nvsdk_ngx_vk.h>
 
 static std::optional<float> GetQualityOverrideRatio(const xess_quality_settings_t input)
 {
     std::optional<float> output;
 
+    if (auto ratio = RenderScale::QueryRatio(); ratio.has_value())
+        return ratio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -128,6 +132,7 @@ xess_result_t hk_xessDestroyContext(xess_context_handle_t hContext)
 
     _contexts.erase(hContext);
     _nvParams.erase(hContext);
+    _lastInputs.erase(hContext);
 
     return XESS_RESULT_SUCCESS;
 }
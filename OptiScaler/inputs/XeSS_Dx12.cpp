@@ -152,6 +152,7 @@ xess_result_t hk_xessD3D12CreateContext(ID3D12Device* pDevice, xess_context_hand
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
     _nvParams[*phContext] = params;
+    _lastInputs[*phContext] = {};
     _motionScales[*phContext] = { 1.0, 1.0 };
 
     return XESS_RESULT_SUCCESS;
@@ -206,6 +207,8 @@ xess_result_t hk_xessD3D12Execute(xess_context_handle_t hContext, ID3D12Graphics
     NVSDK_NGX_Handle* handle = _contexts[hContext];
     xess_d3d12_init_params_t* initParams = &_d3d12InitParams[hContext];
 
+    UpscaleInputs inputs {};
+
     if (_motionScales.contains(hContext))
     {
         auto scales = &_motionScales[hContext];
@@ -214,19 +217,19 @@ xess_result_t hk_xessD3D12Execute(xess_context_handle_t hContext, ID3D12Graphics
         {
             if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
             {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * scales->y);
+                inputs.mvScaleX = initParams->outputResolution.x * 0.5f * scales->x;
+                inputs.mvScaleY = initParams->outputResolution.y * -0.5f * scales->y;
             }
             else
             {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * scales->y);
+                inputs.mvScaleX = pExecParams->inputWidth * 0.5f * scales->x;
+                inputs.mvScaleY = pExecParams->inputHeight * -0.5f * scales->y;
             }
         }
         else
         {
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, scales->x);
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, scales->y);
+            inputs.mvScaleX = scales->x;
+            inputs.mvScaleY = scales->y;
         }
     }
 
@@ -240,39 +243,38 @@ xess_result_t hk_xessD3D12Execute(xess_context_handle_t hContext, ID3D12Graphics
         jitterScaleY = scales->y;
     }
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pExecParams->jitterOffsetX * jitterScaleX);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pExecParams->jitterOffsetY * jitterScaleY);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pExecParams->exposureScale);
-    params->Set(NVSDK_NGX_Parameter_Reset, pExecParams->resetHistory);
-    params->Set(NVSDK_NGX_Parameter_Width, pExecParams->inputWidth);
-    params->Set(NVSDK_NGX_Parameter_Height, pExecParams->inputHeight);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pExecParams->inputWidth);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pExecParams->inputHeight);
-    params->Set(NVSDK_NGX_Parameter_Depth, pExecParams->pDepthTexture);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, pExecParams->pExposureScaleTexture);
+    inputs.jitterX = pExecParams->jitterOffsetX * jitterScaleX;
+    inputs.jitterY = pExecParams->jitterOffsetY * jitterScaleY;
+    inputs.exposureScale = pExecParams->exposureScale;
+    inputs.reset = pExecParams->resetHistory;
+    inputs.renderWidth = pExecParams->inputWidth;
+    inputs.renderHeight = pExecParams->inputHeight;
+    inputs.color = pExecParams->pColorTexture;
+    inputs.depth = pExecParams->pDepthTexture;
+    inputs.motionVectors = pExecParams->pVelocityTexture;
+    inputs.exposure = pExecParams->pExposureScaleTexture;
+    inputs.output = pExecParams->pOutputTexture;
 
     if (feature_version { XeSSProxy::Version().major, XeSSProxy::Version().minor, XeSSProxy::Version().patch } <
         feature_version { 2, 0, 1 })
-        params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, pExecParams->pResponsivePixelMaskTexture);
+        inputs.biasColorMask = pExecParams->pResponsivePixelMaskTexture;
     else
-        params->Set("FSR.reactive", pExecParams->pResponsivePixelMaskTexture);
-
-    params->Set(NVSDK_NGX_Parameter_Color, pExecParams->pColorTexture);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, pExecParams->pVelocityTexture);
-    params->Set(NVSDK_NGX_Parameter_Output, pExecParams->pOutputTexture);
-
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X, pExecParams->inputColorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y, pExecParams->inputColorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X, pExecParams->inputDepthBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y, pExecParams->inputDepthBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X, pExecParams->inputMotionVectorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y, pExecParams->inputMotionVectorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X, pExecParams->outputColorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y, pExecParams->outputColorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X,
-                pExecParams->inputResponsiveMaskBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y,
-                pExecParams->inputResponsiveMaskBase.y);
+        inputs.reactive = pExecParams->pResponsivePixelMaskTexture;
+
+    UpscaleSubrectBases bases {};
+    bases.colorX = pExecParams->inputColorBase.x;
+    bases.colorY = pExecParams->inputColorBase.y;
+    bases.depthX = pExecParams->inputDepthBase.x;
+    bases.depthY = pExecParams->inputDepthBase.y;
+    bases.mvX = pExecParams->inputMotionVectorBase.x;
+    bases.mvY = pExecParams->inputMotionVectorBase.y;
+    bases.outputX = pExecParams->outputColorBase.x;
+    bases.outputY = pExecParams->outputColorBase.y;
+    bases.biasX = pExecParams->inputResponsiveMaskBase.x;
+    bases.biasY = pExecParams->inputResponsiveMaskBase.y;
+    inputs.subrectBases = bases;
+
+    ApplyUpscaleInputs(params, inputs, _lastInputs[hContext]);
 
     State::Instance().setInputApiName = "XeSS";
 
@@ -7,9 +7,17 @@
 #include <proxies/XeSS_Proxy.h>
 #include <proxies/FfxApi_Proxy.h>
 
+#include <misc/RenderScale.h>
+#include <misc/Benchmark.h>
+#include <misc/VramTracker.h>
+#include <misc/Telemetry.h>
+#include <resource_tracking/FGHazard_Dx12.h>
+#include <shaders/AsyncCompute_Dx12.h>
+
 #include "DLSSG_Mod.h"
 
 #include <framegen/ffx/FSRFG_Dx12.h>
+#include <framegen/FGPacing.h>
 
 #include <nvapi/fakenvapi.h>
 #include <nvapi/ReflexHooks.h>
@@ -33,7 +41,7 @@ static bool hasGamepad = false;
 static bool fsr31InitTried = false;
 static std::string windowTitle;
 static std::string selectedUpscalerName = "";
-static std::string currentBackend = "";
+static Upscaler currentBackend = Upscaler::None;
 static std::string currentBackendName = "";
 
 static ImVec2 splashPosition(-1000.0f, -1000.0f);
@@ -113,7 +121,7 @@ void MenuCommon::ShowResetButton(CustomOptional<bool, NoDefault>* initFlag, std:
 inline void MenuCommon::ReInitUpscaler()
 {
     if (State::Instance().currentFeature->Name() == "DLSSD")
-        State::Instance().newBackend = "dlssd";
+        State::Instance().newBackend = Upscaler::DLSSD;
     else
         State::Instance().newBackend = currentBackend;
 
@@ -841,39 +849,39 @@ void KeyUp(UINT vKey)
     inputFpsCycle = vKey == Config::Instance()->FpsCycleShortcutKey.value_or_default();
 }
 
-std::string MenuCommon::GetBackendName(std::string* code)
+std::string MenuCommon::GetBackendName(Upscaler* code)
 {
-    if (*code == "fsr21")
+    if (*code == Upscaler::FSR21)
         return "FSR 2.1.2";
 
-    if (*code == "fsr22")
+    if (*code == Upscaler::FSR22)
         return "FSR 2.2.1";
 
-    if (*code == "fsr31")
+    if (*code == Upscaler::FSR31)
         return "FSR 3.X";
 
-    if (*code == "fsr21_12")
+    if (*code == Upscaler::FSR21_Dx12)
         return "FSR 2.1.2 w/Dx12";
 
-    if (*code == "fsr22_12")
+    if (*code == Upscaler::FSR22_Dx12)
         return "FSR 2.2.1 w/Dx12";
 
-    if (*code == "fsr31_12")
+    if (*code == Upscaler::FSR31_Dx12)
         return "FSR 3.X w/Dx12";
 
-    if (*code == "xess")
+    if (*code == Upscaler::XeSS)
         return "XeSS";
 
-    if (*code == "xess_12")
+    if (*code == Upscaler::XeSS_Dx12)
         return "XeSS w/Dx12";
 
-    if (*code == "dlss")
+    if (*code == Upscaler::DLSS)
         return "DLSS";
 
     return "????";
 }
 
-std::string MenuCommon::GetBackendCode(const API api)
+Upscaler MenuCommon::GetBackendCode(const API api)
 {
     std::string code;
 
@@ -884,138 +892,138 @@ std::string MenuCommon::GetBackendCode(const API api)
     else
         code = Config::Instance()->VulkanUpscaler.value_or_default();
 
-    return code;
+    return UpscalerFromCode(code);
 }
 
-void MenuCommon::GetCurrentBackendInfo(const API api, std::string* code, std::string* name)
+void MenuCommon::GetCurrentBackendInfo(const API api, Upscaler* code, std::string* name)
 {
     *code = GetBackendCode(api);
     *name = GetBackendName(code);
 }
 
-void MenuCommon::AddDx11Backends(std::string* code, std::string* name)
+void MenuCommon::AddDx11Backends(Upscaler* code, std::string* name)
 {
     std::string selectedUpscalerName = "";
+    auto selected = State::Instance().newBackend != Upscaler::None ? State::Instance().newBackend : *code;
     std::string fsr3xName = Config::Instance()->Fsr4Update.value_or_default() ? "FSR 3.X/4 w/Dx12" : "FSR 3.X w/Dx12";
 
-    if (State::Instance().newBackend == "fsr22" || (State::Instance().newBackend == "" && *code == "fsr22"))
+    if (selected == Upscaler::FSR22)
         selectedUpscalerName = "FSR 2.2.1";
-    else if (State::Instance().newBackend == "fsr22_12" || (State::Instance().newBackend == "" && *code == "fsr22_12"))
+    else if (selected == Upscaler::FSR22_Dx12)
         selectedUpscalerName = "FSR 2.2.1 w/Dx12";
-    else if (State::Instance().newBackend == "fsr21_12" || (State::Instance().newBackend == "" && *code == "fsr21_12"))
+    else if (selected == Upscaler::FSR21_Dx12)
         selectedUpscalerName = "FSR 2.1.2 w/Dx12";
-    else if (State::Instance().newBackend == "fsr31" || (State::Instance().newBackend == "" && *code == "fsr31"))
+    else if (selected == Upscaler::FSR31)
         selectedUpscalerName = "FSR 3.X";
-    else if (State::Instance().newBackend == "fsr31_12" || (State::Instance().newBackend == "" && *code == "fsr31_12"))
+    else if (selected == Upscaler::FSR31_Dx12)
         selectedUpscalerName = fsr3xName;
-    else if (Config::Instance()->DLSSEnabled.value_or_default() &&
-             (State::Instance().newBackend == "dlss" || (State::Instance().newBackend == "" && *code == "dlss")))
+    else if (Config::Instance()->DLSSEnabled.value_or_default() && selected == Upscaler::DLSS)
         selectedUpscalerName = "DLSS";
-    else if (State::Instance().newBackend == "xess" || (State::Instance().newBackend == "" && *code == "xess"))
+    else if (selected == Upscaler::XeSS)
         selectedUpscalerName = "XeSS";
     else
         selectedUpscalerName = "XeSS w/Dx12";
 
     if (ImGui::BeginCombo("", selectedUpscalerName.c_str()))
     {
-        if (ImGui::Selectable("XeSS", *code == "xess"))
-            State::Instance().newBackend = "xess";
+        if (ImGui::Selectable("XeSS", *code == Upscaler::XeSS))
+            State::Instance().newBackend = Upscaler::XeSS;
 
-        if (ImGui::Selectable("FSR 2.2.1", *code == "fsr22"))
-            State::Instance().newBackend = "fsr22";
+        if (ImGui::Selectable("FSR 2.2.1", *code == Upscaler::FSR22))
+            State::Instance().newBackend = Upscaler::FSR22;
 
-        if (ImGui::Selectable("FSR 3.X", *code == "fsr31"))
-            State::Instance().newBackend = "fsr31";
+        if (ImGui::Selectable("FSR 3.X", *code == Upscaler::FSR31))
+            State::Instance().newBackend = Upscaler::FSR31;
 
-        if (ImGui::Selectable("XeSS w/Dx12", *code == "xess_12"))
-            State::Instance().newBackend = "xess_12";
+        if (ImGui::Selectable("XeSS w/Dx12", *code == Upscaler::XeSS_Dx12))
+            State::Instance().newBackend = Upscaler::XeSS_Dx12;
 
-        if (ImGui::Selectable("FSR 2.1.2 w/Dx12", *code == "fsr21_12"))
-            State::Instance().newBackend = "fsr21_12";
+        if (ImGui::Selectable("FSR 2.1.2 w/Dx12", *code == Upscaler::FSR21_Dx12))
+            State::Instance().newBackend = Upscaler::FSR21_Dx12;
 
-        if (ImGui::Selectable("FSR 2.2.1 w/Dx12", *code == "fsr22_12"))
-            State::Instance().newBackend = "fsr22_12";
+        if (ImGui::Selectable("FSR 2.2.1 w/Dx12", *code == Upscaler::FSR22_Dx12))
+            State::Instance().newBackend = Upscaler::FSR22_Dx12;
 
-        if (ImGui::Selectable(fsr3xName.c_str(), *code == "fsr31_12"))
-            State::Instance().newBackend = "fsr31_12";
+        if (ImGui::Selectable(fsr3xName.c_str(), *code == Upscaler::FSR31_Dx12))
+            State::Instance().newBackend = Upscaler::FSR31_Dx12;
 
-        if (Config::Instance()->DLSSEnabled.value_or_default() && ImGui::Selectable("DLSS", *code == "dlss"))
-            State::Instance().newBackend = "dlss";
+        if (Config::Instance()->DLSSEnabled.value_or_default() && ImGui::Selectable("DLSS", *code == Upscaler::DLSS))
+            State::Instance().newBackend = Upscaler::DLSS;
 
         ImGui::EndCombo();
     }
 }
 
-void MenuCommon::AddDx12Backends(std::string* code, std::string* name)
+void MenuCommon::AddDx12Backends(Upscaler* code, std::string* name)
 {
     std::string selectedUpscalerName = "";
+    auto selected = State::Instance().newBackend != Upscaler::None ? State::Instance().newBackend : *code;
     std::string fsr3xName = Config::Instance()->Fsr4Update.value_or_default() ? "FSR 3.X/4" : "FSR 3.X";
 
-    if (State::Instance().newBackend == "fsr21" || (State::Instance().newBackend == "" && *code == "fsr21"))
+    if (selected == Upscaler::FSR21)
         selectedUpscalerName = "FSR 2.1.2";
-    else if (State::Instance().newBackend == "fsr22" || (State::Instance().newBackend == "" && *code == "fsr22"))
+    else if (selected == Upscaler::FSR22)
         selectedUpscalerName = "FSR 2.2.1";
-    else if (State::Instance().newBackend == "fsr31" || (State::Instance().newBackend == "" && *code == "fsr31"))
+    else if (selected == Upscaler::FSR31)
         selectedUpscalerName = fsr3xName;
-    else if (Config::Instance()->DLSSEnabled.value_or_default() &&
-             (State::Instance().newBackend == "dlss" || (State::Instance().newBackend == "" && *code == "dlss")))
+    else if (Config::Instance()->DLSSEnabled.value_or_default() && selected == Upscaler::DLSS)
         selectedUpscalerName = "DLSS";
     else
         selectedUpscalerName = "XeSS";
 
     if (ImGui::BeginCombo("", selectedUpscalerName.c_str()))
     {
-        if (ImGui::Selectable("XeSS", *code == "xess"))
-            State::Instance().newBackend = "xess";
+        if (ImGui::Selectable("XeSS", *code == Upscaler::XeSS))
+            State::Instance().newBackend = Upscaler::XeSS;
 
-        if (ImGui::Selectable("FSR 2.1.2", *code == "fsr21"))
-            State::Instance().newBackend = "fsr21";
+        if (ImGui::Selectable("FSR 2.1.2", *code == Upscaler::FSR21))
+            State::Instance().newBackend = Upscaler::FSR21;
 
-        if (ImGui::Selectable("FSR 2.2.1", *code == "fsr22"))
-            State::Instance().newBackend = "fsr22";
+        if (ImGui::Selectable("FSR 2.2.1", *code == Upscaler::FSR22))
+            State::Instance().newBackend = Upscaler::FSR22;
 
-        if (ImGui::Selectable(fsr3xName.c_str(), *code == "fsr31"))
-            State::Instance().newBackend = "fsr31";
+        if (ImGui::Selectable(fsr3xName.c_str(), *code == Upscaler::FSR31))
+            State::Instance().newBackend = Upscaler::FSR31;
 
-        if (Config::Instance()->DLSSEnabled.value_or_default() && ImGui::Selectable("DLSS", *code == "dlss"))
-            State::Instance().newBackend = "dlss";
+        if (Config::Instance()->DLSSEnabled.value_or_default() && ImGui::Selectable("DLSS", *code == Upscaler::DLSS))
+            State::Instance().newBackend = Upscaler::DLSS;
 
         ImGui::EndCombo();
     }
 }
 
-void MenuCommon::AddVulkanBackends(std::string* code, std::string* name)
+void MenuCommon::AddVulkanBackends(Upscaler* code, std::string* name)
 {
     std::string selectedUpscalerName = "";
+    auto selected = State::Instance().newBackend != Upscaler::None ? State::Instance().newBackend : *code;
 
-    if (State::Instance().newBackend == "fsr21" || (State::Instance().newBackend == "" && *code == "fsr21"))
+    if (selected == Upscaler::FSR21)
         selectedUpscalerName = "FSR 2.1.2";
-    else if (State::Instance().newBackend == "fsr31" || (State::Instance().newBackend == "" && *code == "fsr31"))
+    else if (selected == Upscaler::FSR31)
         selectedUpscalerName = "FSR 3.X";
-    else if (State::Instance().newBackend == "xess" || (State::Instance().newBackend == "" && *code == "xess"))
+    else if (selected == Upscaler::XeSS)
         selectedUpscalerName = "XeSS";
-    else if (Config::Instance()->DLSSEnabled.value_or_default() &&
-             (State::Instance().newBackend == "dlss" || (State::Instance().newBackend == "" && *code == "dlss")))
+    else if (Config::Instance()->DLSSEnabled.value_or_default() && selected == Upscaler::DLSS)
         selectedUpscalerName = "DLSS";
     else
         selectedUpscalerName = "FSR 2.2.1";
 
     if (ImGui::BeginCombo("", selectedUpscalerName.c_str()))
     {
-        if (ImGui::Selectable("XeSS", *code == "xess"))
-            State::Instance().newBackend = "xess";
+        if (ImGui::Selectable("XeSS", *code == Upscaler::XeSS))
+            State::Instance().newBackend = Upscaler::XeSS;
 
-        if (ImGui::Selectable("FSR 2.1.2", *code == "fsr21"))
-            State::Instance().newBackend = "fsr21";
+        if (ImGui::Selectable("FSR 2.1.2", *code == Upscaler::FSR21))
+            State::Instance().newBackend = Upscaler::FSR21;
 
-        if (ImGui::Selectable("FSR 2.2.1", *code == "fsr22"))
-            State::Instance().newBackend = "fsr22";
+        if (ImGui::Selectable("FSR 2.2.1", *code == Upscaler::FSR22))
+            State::Instance().newBackend = Upscaler::FSR22;
 
-        if (ImGui::Selectable("FSR 3.X", *code == "fsr31"))
-            State::Instance().newBackend = "fsr31";
+        if (ImGui::Selectable("FSR 3.X", *code == Upscaler::FSR31))
+            State::Instance().newBackend = Upscaler::FSR31;
 
-        if (Config::Instance()->DLSSEnabled.value_or_default() && ImGui::Selectable("DLSS", *code == "dlss"))
-            State::Instance().newBackend = "dlss";
+        if (Config::Instance()->DLSSEnabled.value_or_default() && ImGui::Selectable("DLSS", *code == Upscaler::DLSS))
+            State::Instance().newBackend = Upscaler::DLSS;
 
         ImGui::EndCombo();
     }
@@ -1287,6 +1295,171 @@ static void MenuSizeCheck(ImGuiIO io)
 static double lastTime = 0.0;
 static UINT64 uwpTargetFrame = 0;
 
+void MenuCommon::UpdateFpsOverlayTexts(float fpsScale)
+{
+    auto currentFeature = State::Instance().currentFeature;
+
+    std::string api;
+    if (State::Instance().isRunningOnDXVK || State::Instance().isRunningOnLinux)
+    {
+        api = "VKD3D";
+    }
+    else
+    {
+        switch (State::Instance().swapchainApi)
+        {
+        case Vulkan:
+            api = "VLK";
+            break;
+
+        case DX11:
+            api = "D3D11";
+            break;
+
+        case DX12:
+            api = "D3D12";
+            break;
+
+        default:
+            switch (State::Instance().api)
+            {
+            case Vulkan:
+                api = "VLK";
+                break;
+
+            case DX11:
+                api = "D3D11";
+                break;
+
+            case DX12:
+                api = "D3D12";
+                break;
+
+            default:
+                api = "???";
+                break;
+            }
+
+            break;
+        }
+    }
+
+    _fpsFirstLine.clear();
+    _fpsSecondLine.clear();
+    _fpsThirdLine.clear();
+
+    // Prepare Line 1
+    if (Config::Instance()->FpsOverlayType.value_or_default() == 0)
+    {
+        _fpsFirstLine = std::format("{} | FPS: {:5.1f}", api.c_str(), _fpsFrameRate);
+    }
+    else if (Config::Instance()->FpsOverlayType.value_or_default() == 1)
+    {
+        if (currentFeature != nullptr && !currentFeature->IsFrozen())
+            _fpsFirstLine = std::format("{} | FPS: {:5.1f}, {:6.2f} ms | {} -> {} {}.{}.{}", api.c_str(),
+                                        _fpsFrameRate, _fpsFrameTime, State::Instance().currentInputApiName.c_str(),
+                                        currentFeature->Name().c_str(), currentFeature->Version().major,
+                                        currentFeature->Version().minor, currentFeature->Version().patch);
+        else
+            _fpsFirstLine = std::format("{} | FPS: {:5.1f}, {:6.2f} ms", api.c_str(), _fpsFrameRate, _fpsFrameTime);
+    }
+    else
+    {
+        if (currentFeature != nullptr && !currentFeature->IsFrozen())
+            _fpsFirstLine = std::format("{} | FPS: {:5.1f}, Avg: {:5.1f} | {} -> {} {}.{}.{}", api.c_str(),
+                                        _fpsFrameRate, 1000.0f / _fpsAverageFrameTime,
+                                        State::Instance().currentInputApiName.c_str(), currentFeature->Name().c_str(),
+                                        currentFeature->Version().major, currentFeature->Version().minor,
+                                        currentFeature->Version().patch);
+        else
+            _fpsFirstLine = std::format("{} | FPS: {:5.1f}, Avg: {:5.1f}", api.c_str(), _fpsFrameRate,
+                                        1000.0f / _fpsAverageFrameTime);
+    }
+
+    // Prepare Line 2
+    if (Config::Instance()->FpsOverlayType.value_or_default() > 1)
+    {
+        _fpsSecondLine = std::format("Frame Time: {:6.2f} ms, Avg: {:6.2f} ms", _fpsFrameTimes.back(),
+                                     _fpsAverageFrameTime);
+    }
+
+    // Prepare Line 3
+    if (Config::Instance()->FpsOverlayType.value_or_default() > 3)
+    {
+        _fpsThirdLine = std::format("Upscaler Time: {:6.2f} ms, Avg: {:6.2f} ms", _fpsUpscalerTimes.back(),
+                                    _fpsAverageUpscalerTime);
+    }
+
+    if (Config::Instance()->FpsOverlayHorizontal.value_or_default())
+    {
+        _fpsPlotSize = { fpsScale * 150, fpsScale * 16 };
+    }
+    else
+    {
+        // Find the widest text width
+        auto firstSize = ImGui::CalcTextSize(_fpsFirstLine.c_str());
+        auto secondSize = ImGui::CalcTextSize(_fpsSecondLine.c_str());
+        auto thirdSize = ImGui::CalcTextSize(_fpsThirdLine.c_str());
+        auto textWidth = 0.0f;
+
+        if (firstSize.x > secondSize.x)
+            textWidth = firstSize.x > thirdSize.x ? firstSize.x : thirdSize.x;
+        else
+            textWidth = secondSize.x > thirdSize.x ? secondSize.x : thirdSize.x;
+
+        auto minWidth = fpsScale * 300.0f;
+        auto plotWidth = textWidth < minWidth ? minWidth : textWidth;
+
+        _fpsPlotSize = { plotWidth, fpsScale * 30 };
+    }
+
+    BuildFpsPlot(_fpsFrameTimes, 66.6f, _fpsFramePlot);
+    BuildFpsPlot(_fpsUpscalerTimes, 20.0f, _fpsUpscalerPlot);
+}
+
+void MenuCommon::BuildFpsPlot(const std::vector<float>& values, float scaleMax, std::vector<ImVec2>& plot)
+{
+    // One point per pixel at most, like ImGui::PlotLines
+    auto count = std::min((size_t) _fpsPlotSize.x, values.size());
+    plot.resize(count);
+
+    if (count < 2)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto value = values[i * values.size() / count];
+        plot[i] = { (float) i / (count - 1), 1.0f - std::clamp(value / scaleMax, 0.0f, 1.0f) };
+    }
+}
+
+// Same frame & line as ImGui::PlotLines but draws the cached points with a single polyline
+void MenuCommon::DrawFpsPlot(const std::vector<ImVec2>& plot)
+{
+    auto& style = ImGui::GetStyle();
+    auto drawList = ImGui::GetWindowDrawList();
+
+    auto frameMin = ImGui::GetCursorScreenPos();
+    ImVec2 frameMax { frameMin.x + _fpsPlotSize.x, frameMin.y + _fpsPlotSize.y };
+    ImGui::Dummy(_fpsPlotSize);
+
+    drawList->AddRectFilled(frameMin, frameMax, ImGui::GetColorU32(ImGuiCol_FrameBg), style.FrameRounding);
+
+    if (plot.size() < 2)
+        return;
+
+    ImVec2 innerMin { frameMin.x + style.FramePadding.x, frameMin.y + style.FramePadding.y };
+    ImVec2 innerSize { _fpsPlotSize.x - style.FramePadding.x * 2.0f, _fpsPlotSize.y - style.FramePadding.y * 2.0f };
+
+    _fpsPlotPoints.resize(plot.size());
+
+    for (size_t i = 0; i < plot.size(); i++)
+        _fpsPlotPoints[i] = { innerMin.x + plot[i].x * innerSize.x, innerMin.y + plot[i].y * innerSize.y };
+
+    drawList->AddPolyline(_fpsPlotPoints.data(), (int) _fpsPlotPoints.size(), ImGui::GetColorU32(ImGuiCol_PlotLines),
+                          ImDrawFlags_None, 1.0f);
+}
+
 bool MenuCommon::RenderMenu()
 {
     if (!_isInited)
@@ -1310,6 +1483,10 @@ bool MenuCommon::RenderMenu()
     State::Instance().frameTimes.pop_front();
     State::Instance().frameTimes.push_back(frameTime);
 
+    Benchmark::Update(frameTime);
+    VramTracker::Update();
+    Telemetry::Update(frameTime);
+
     ImGuiIO& io = ImGui::GetIO();
     (void) io;
     auto currentFeature = State::Instance().currentFeature;
@@ -1480,19 +1657,55 @@ bool MenuCommon::RenderMenu()
     // If Fps overlay is visible
     if (Config::Instance()->ShowFps.value_or_default())
     {
-        float frameCnt = 0;
-        frameTime = 0;
-        for (size_t i = 299; i > 199; i--)
+        // Texts, graphs and layout are rebuilt with FpsOverlayUpdateRate, other frames draw the cached values
+        auto updateRate = Config::Instance()->FpsOverlayUpdateRate.value_or_default();
+        auto overlayType = Config::Instance()->FpsOverlayType.value_or_default();
+        auto overlayHorizontal = Config::Instance()->FpsOverlayHorizontal.value_or_default();
+
+        bool refreshOverlay = updateRate <= 0.0f || (now - _fpsLastUpdate) >= (1000.0 / updateRate) ||
+                              _fpsLastType != overlayType || _fpsLastHorizontal != overlayHorizontal ||
+                              _fpsLastScale != fpsScale;
+
+        if (refreshOverlay)
         {
-            if (State::Instance().frameTimes[i] > 0.0)
+            float frameCnt = 0;
+            frameTime = 0;
+            for (size_t i = 299; i > 199; i--)
+            {
+                if (State::Instance().frameTimes[i] > 0.0)
+                {
+                    frameTime += State::Instance().frameTimes[i];
+                    frameCnt++;
+                }
+            }
+
+            _fpsFrameTime = frameTime / frameCnt;
+            _fpsFrameRate = 1000.0 / _fpsFrameTime;
+
+            State::Instance().frameTimeMutex.lock();
+            _fpsFrameTimes.assign(State::Instance().frameTimes.begin(), State::Instance().frameTimes.end());
+            _fpsUpscalerTimes.assign(State::Instance().upscaleTimes.begin(), State::Instance().upscaleTimes.end());
+            State::Instance().frameTimeMutex.unlock();
+
+            _fpsAverageFrameTime = 0.0f;
+            _fpsAverageUpscalerTime = 0.0f;
+
+            for (size_t i = 0; i < _fpsFrameTimes.size(); i++)
             {
-                frameTime += State::Instance().frameTimes[i];
-                frameCnt++;
+                _fpsAverageFrameTime += _fpsFrameTimes[i];
+                _fpsAverageUpscalerTime += _fpsUpscalerTimes[i];
             }
+            _fpsAverageFrameTime /= _fpsFrameTimes.size();
+            _fpsAverageUpscalerTime /= _fpsFrameTimes.size();
+
+            _fpsLastUpdate = now;
+            _fpsLastType = overlayType;
+            _fpsLastHorizontal = overlayHorizontal;
+            _fpsLastScale = fpsScale;
         }
 
-        frameTime /= frameCnt;
-        frameRate = 1000.0 / frameTime;
+        frameTime = _fpsFrameTime;
+        frameRate = _fpsFrameRate;
         frameTimesCalculated = true;
 
         if (!frameStarted)
@@ -1514,22 +1727,6 @@ bool MenuCommon::RenderMenu()
             frameStarted = true;
         }
 
-        State::Instance().frameTimeMutex.lock();
-        std::vector<float> frameTimeArray(State::Instance().frameTimes.begin(), State::Instance().frameTimes.end());
-        std::vector<float> upscalerFrameTimeArray(State::Instance().upscaleTimes.begin(),
-                                                  State::Instance().upscaleTimes.end());
-        State::Instance().frameTimeMutex.unlock();
-        float averageFrameTime = 0.0f;
-        float averageUpscalerFT = 0.0f;
-
-        for (size_t i = 0; i < frameTimeArray.size(); i++)
-        {
-            averageFrameTime += frameTimeArray[i];
-            averageUpscalerFT += upscalerFrameTimeArray[i];
-        }
-        averageFrameTime /= frameTimeArray.size();
-        averageUpscalerFT /= frameTimeArray.size();
-
         // Set overlay position
         ImGui::SetNextWindowPos(overlayPosition, ImGuiCond_Always);
 
@@ -1552,142 +1749,16 @@ bool MenuCommon::RenderMenu()
                              ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing |
                              ImGuiWindowFlags_NoNav))
         {
-            std::string api;
-            if (State::Instance().isRunningOnDXVK || State::Instance().isRunningOnLinux)
-            {
-                api = "VKD3D";
-            }
-            else
-            {
-                switch (State::Instance().swapchainApi)
-                {
-                case Vulkan:
-                    api = "VLK";
-                    break;
-
-                case DX11:
-                    api = "D3D11";
-                    break;
-
-                case DX12:
-                    api = "D3D12";
-                    break;
-
-                default:
-                    switch (State::Instance().api)
-                    {
-                    case Vulkan:
-                        api = "VLK";
-                        break;
-
-                    case DX11:
-                        api = "D3D11";
-                        break;
-
-                    case DX12:
-                        api = "D3D12";
-                        break;
-
-                    default:
-                        api = "???";
-                        break;
-                    }
-
-                    break;
-                }
-            }
-
             if (Config::Instance()->UseHQFont.value_or_default())
                 ImGui::PushFontSize(std::round(fpsScale * fontSize));
             else
                 ImGui::SetWindowFontScale(fpsScale);
 
-            std::string firstLine = "";
-            std::string secondLine = "";
-            std::string thirdLine = "";
-
-            // Prepare Line 1
-            if (Config::Instance()->FpsOverlayType.value_or_default() == 0)
-            {
-                firstLine = std::format("{} | FPS: {:5.1f}", api.c_str(), frameRate);
-            }
-            else if (Config::Instance()->FpsOverlayType.value_or_default() == 1)
-            {
-                if (currentFeature != nullptr && !currentFeature->IsFrozen())
-                    firstLine =
-                        std::format("{} | FPS: {:5.1f}, {:6.2f} ms | {} -> {} {}.{}.{}", api.c_str(), frameRate,
-                                    frameTime, State::Instance().currentInputApiName.c_str(),
-                                    currentFeature->Name().c_str(), State::Instance().currentFeature->Version().major,
-                                    State::Instance().currentFeature->Version().minor,
-                                    State::Instance().currentFeature->Version().patch);
-                else
-                    firstLine = std::format("{} | FPS: {:5.1f}, {:6.2f} ms", api.c_str(), frameRate, frameTime);
-            }
-            else
-            {
-                if (currentFeature != nullptr && !currentFeature->IsFrozen())
-                    firstLine =
-                        std::format("{} | FPS: {:5.1f}, Avg: {:5.1f} | {} -> {} {}.{}.{}", api.c_str(), frameRate,
-                                    1000.0f / averageFrameTime, State::Instance().currentInputApiName.c_str(),
-                                    currentFeature->Name().c_str(), State::Instance().currentFeature->Version().major,
-                                    State::Instance().currentFeature->Version().minor,
-                                    State::Instance().currentFeature->Version().patch);
-                else
-                    firstLine = std::format("{} | FPS: {:5.1f}, Avg: {:5.1f}", api.c_str(), frameRate,
-                                            1000.0f / averageFrameTime);
-            }
-
-            // Prepare Line 2
-            if (Config::Instance()->FpsOverlayType.value_or_default() > 1)
-            {
-                if (Config::Instance()->FpsOverlayHorizontal.value_or_default())
-                {
-                    ImGui::SameLine(0.0f, 0.0f);
-                    ImGui::Text(" | ");
-                    ImGui::SameLine(0.0f, 0.0f);
-                }
-                else
-                {
-                    ImGui::Spacing();
-                }
-
-                secondLine = std::format("Frame Time: {:6.2f} ms, Avg: {:6.2f} ms", State::Instance().frameTimes.back(),
-                                         averageFrameTime);
-            }
-
-            // Prepare Line 3
-            if (Config::Instance()->FpsOverlayType.value_or_default() > 3)
-            {
-                thirdLine = std::format("Upscaler Time: {:6.2f} ms, Avg: {:6.2f} ms",
-                                        State::Instance().upscaleTimes.back(), averageUpscalerFT);
-            }
-
-            ImVec2 plotSize;
-            if (Config::Instance()->FpsOverlayHorizontal.value_or_default())
-            {
-                plotSize = { fpsScale * 150, fpsScale * 16 };
-            }
-            else
-            {
-                // Find the widest text width
-                auto firstSize = ImGui::CalcTextSize(firstLine.c_str());
-                auto secondSize = ImGui::CalcTextSize(secondLine.c_str());
-                auto thirdSize = ImGui::CalcTextSize(thirdLine.c_str());
-                auto textWidth = 0.0f;
-
-                if (firstSize.x > secondSize.x)
-                    textWidth = firstSize.x > thirdSize.x ? firstSize.x : thirdSize.x;
-                else
-                    textWidth = secondSize.x > thirdSize.x ? secondSize.x : thirdSize.x;
-
-                auto minWidth = fpsScale * 300.0f;
-                auto plotWidth = textWidth < minWidth ? minWidth : textWidth;
-
-                plotSize = { plotWidth, fpsScale * 30 };
-            }
+            if (refreshOverlay)
+                UpdateFpsOverlayTexts(fpsScale);
 
             // Draw the overlay
-            ImGui::Text(firstLine.c_str());
+            ImGui::Text(_fpsFirstLine.c_str());
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 1)
             {
@@ -1702,7 +1773,7 @@ bool MenuCommon::RenderMenu()
                     ImGui::Spacing();
                 }
 
-                ImGui::Text(secondLine.c_str());
+                ImGui::Text(_fpsSecondLine.c_str());
             }
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 2)
@@ -1711,8 +1782,7 @@ bool MenuCommon::RenderMenu()
                     ImGui::SameLine(0.0f, 0.0f);
 
                 // Graph of frame times
-                ImGui::PlotLines("##FrameTimeGraph", frameTimeArray.data(), static_cast<int>(frameTimeArray.size()), 0,
-                                 nullptr, 0.0f, 66.6f, plotSize);
+                DrawFpsPlot(_fpsFramePlot);
             }
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 3)
@@ -1728,7 +1798,7 @@ bool MenuCommon::RenderMenu()
                     ImGui::Spacing();
                 }
 
-                ImGui::Text(thirdLine.c_str());
+                ImGui::Text(_fpsThirdLine.c_str());
             }
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 4)
@@ -1737,8 +1807,7 @@ bool MenuCommon::RenderMenu()
                     ImGui::SameLine(0.0f, 0.0f);
 
                 // Graph of upscaler times
-                ImGui::PlotLines("##UpscalerFrameTimeGraph", upscalerFrameTimeArray.data(),
-                                 static_cast<int>(upscalerFrameTimeArray.size()), 0, nullptr, 0.0f, 20.0f, plotSize);
+                DrawFpsPlot(_fpsUpscalerPlot);
             }
 
             ImGui::PopStyleColor(3); // Restore the style
@@ -2062,10 +2131,10 @@ bool MenuCommon::RenderMenu()
                     {
                         ImGui::SameLine(0.0f, 6.0f);
 
-                        if (ImGui::Button("Change Upscaler##2") && State::Instance().newBackend != "" &&
+                        if (ImGui::Button("Change Upscaler##2") && State::Instance().newBackend != Upscaler::None &&
                             State::Instance().newBackend != currentBackend)
                         {
-                            if (State::Instance().newBackend == "xess")
+                            if (State::Instance().newBackend == Upscaler::XeSS)
                             {
                                 // Reseting them for xess
                                 Config::Instance()->DisableReactiveMask.reset();
@@ -2106,6 +2175,38 @@ bool MenuCommon::RenderMenu()
                                 ImGui::Checkbox("Don't Use NTShared", &dontUseNTShared))
                                 Config::Instance()->DontUseNTShared = dontUseNTShared;
 
+                            if (bool asyncPost = Config::Instance()->AsyncPostPasses.value_or_default();
+                                ImGui::Checkbox("Async Post Passes", &asyncPost))
+                                Config::Instance()->AsyncPostPasses = asyncPost;
+
+                            ShowHelpMarker("Runs RCAS and output scaling on an async compute queue");
+
+                            if (Config::Instance()->AsyncPostPasses.value_or_default())
+                            {
+                                ScopedIndent asyncIndent {};
+
+                                if (bool asyncRcas = Config::Instance()->AsyncPostRcas.value_or_default();
+                                    ImGui::Checkbox("Async RCAS", &asyncRcas))
+                                    Config::Instance()->AsyncPostRcas = asyncRcas;
+
+                                ImGui::SameLine(0.0f, 6.0f);
+
+                                if (bool asyncOS = Config::Instance()->AsyncPostOutputScaling.value_or_default();
+                                    ImGui::Checkbox("Async Output Scaling", &asyncOS))
+                                    Config::Instance()->AsyncPostOutputScaling = asyncOS;
+
+                                if (bool autoTune = Config::Instance()->AsyncPostAutoTune.value_or_default();
+                                    ImGui::Checkbox("Auto Tune", &autoTune))
+                                    Config::Instance()->AsyncPostAutoTune = autoTune;
+
+                                ShowHelpMarker("Measures latency of both modes with GPU timestamps\n"
+                                               "and uses async compute only when it's faster");
+
+                                ImGui::Text("Inline: %.3f ms, Async: %.3f ms, Using: %s",
+                                            AsyncCompute_Dx12::LastMs(false), AsyncCompute_Dx12::LastMs(true),
+                                            AsyncCompute_Dx12::LastFrameAsync() ? "Async" : "Inline");
+                            }
+
                             ImGui::Spacing();
                             ImGui::Spacing();
                         }
@@ -2114,7 +2215,7 @@ bool MenuCommon::RenderMenu()
                     // UPSCALER SPECIFIC -----------------------------
 
                     // XeSS -----------------------------
-                    if (currentBackend == "xess" && State::Instance().currentFeature->Name() != "DLSSD")
+                    if (currentBackend == Upscaler::XeSS && State::Instance().currentFeature->Name() != "DLSSD")
                     {
                         ImGui::Spacing();
                         if (ImGui::CollapsingHeader("XeSS Settings"))
@@ -2172,16 +2273,16 @@ bool MenuCommon::RenderMenu()
                     }
 
                     // FFX -----------------
-                    if (currentBackend.rfind("fsr", 0) == 0 && State::Instance().currentFeature->Name() != "DLSSD" &&
-                        (currentBackend == "fsr31" || currentBackend == "fsr31_12"))
+                    if (IsFSRUpscaler(currentBackend) && State::Instance().currentFeature->Name() != "DLSSD" &&
+                        (currentBackend == Upscaler::FSR31 || currentBackend == Upscaler::FSR31_Dx12))
                     {
                         ImGui::SeparatorText("FFX Settings");
 
                         if (_fsr3xIndex < 0)
                             _fsr3xIndex = Config::Instance()->Fsr3xIndex.value_or_default();
 
-                        if (currentBackend == "fsr31" ||
-                            currentBackend == "fsr31_12" && State::Instance().fsr3xVersionNames.size() > 0)
+                        if (currentBackend == Upscaler::FSR31 ||
+                            currentBackend == Upscaler::FSR31_Dx12 && State::Instance().fsr3xVersionNames.size() > 0)
                         {
                             ImGui::PushItemWidth(135.0f * Config::Instance()->MenuScale.value_or_default());
 
@@ -2388,7 +2489,7 @@ bool MenuCommon::RenderMenu()
                     }
 
                     // DLSS -----------------
-                    if ((Config::Instance()->DLSSEnabled.value_or_default() && currentBackend == "dlss" &&
+                    if ((Config::Instance()->DLSSEnabled.value_or_default() && currentBackend == Upscaler::DLSS &&
                          State::Instance().currentFeature->Version().major > 2) ||
                         State::Instance().currentFeature->Name() == "DLSSD")
                     {
@@ -2435,7 +2536,7 @@ bool MenuCommon::RenderMenu()
                         if (ImGui::Button("Apply Changes"))
                         {
                             if (usesDlssd)
-                                State::Instance().newBackend = "dlssd";
+                                State::Instance().newBackend = Upscaler::DLSSD;
                             else
                                 State::Instance().newBackend = currentBackend;
 
@@ -2502,7 +2603,8 @@ bool MenuCommon::RenderMenu()
                     disabledMask[1] = true;
                     fgDesc[1] = "Old overlay menu is unsupported";
                 }
-                else if (State::Instance().api != DX12)
+                else if (State::Instance().api != DX12 &&
+                         !(State::Instance().api == Vulkan && Config::Instance()->FGVulkan.value_or_default()))
                 {
                     disabledMask[1] = true;
                     fgDesc[1] = "Unsupported API";
@@ -2512,6 +2614,17 @@ bool MenuCommon::RenderMenu()
                     disabledMask[1] = true;
                     fgDesc[1] = "Unsupported Opti working mode";
                 }
+                else if (State::Instance().api == Vulkan)
+                {
+                    if ((fsr31InitTried && FfxApiProxy::VkModule() == nullptr) ||
+                        (!fsr31InitTried && !FfxApiProxy::InitFfxVk()))
+                    {
+                        disabledMask[1] = true;
+                        fgDesc[1] = "amd_fidelityfx_vk.dll is missing";
+                    }
+
+                    fsr31InitTried = true;
+                }
                 else if ((fsr31InitTried && FfxApiProxy::Dx12Module() == nullptr) ||
                          (!fsr31InitTried && !FfxApiProxy::InitFfxDx12()))
                 {
@@ -2559,12 +2672,18 @@ bool MenuCommon::RenderMenu()
                     State::Instance().activeFgType != Config::Instance()->FGType.value_or_default();
 
                 // OptiFG
-                if (Config::Instance()->OverlayMenu.value_or_default() && State::Instance().api == DX12 &&
+                bool optiFGApi = State::Instance().api == DX12 ||
+                                 (State::Instance().api == Vulkan && Config::Instance()->FGVulkan.value_or_default());
+
+                if (Config::Instance()->OverlayMenu.value_or_default() && optiFGApi &&
                     !State::Instance().isWorkingAsNvngx && State::Instance().activeFgType == FGType::OptiFG)
                 {
                     ImGui::SeparatorText("Frame Generation (OptiFG)");
 
-                    if (currentFeature != nullptr && !currentFeature->IsFrozen() && FfxApiProxy::InitFfxDx12())
+                    bool ffxLoaded =
+                        State::Instance().api == Vulkan ? FfxApiProxy::InitFfxVk() : FfxApiProxy::InitFfxDx12();
+
+                    if (currentFeature != nullptr && !currentFeature->IsFrozen() && ffxLoaded)
                     {
                         bool fgActive = Config::Instance()->FGEnabled.value_or_default();
                         if (ImGui::Checkbox("Active##2", &fgActive))
@@ -2613,6 +2732,30 @@ bool MenuCommon::RenderMenu()
                         ShowHelpMarker("Needs hudless texture to compare with final image.\n"
                                        "UI elements and ONLY UI elements should have a pink tint!");
 
+                        ImGui::Text("Hudless Copied: %.1f MB, Saved: %.1f MB",
+                                    State::Instance().FGHudlessCopyBytes / (1024.0f * 1024.0f),
+                                    State::Instance().FGHudlessSavedBytes / (1024.0f * 1024.0f));
+
+                        bool hudValidation = Config::Instance()->FGHUDValidation.value_or_default();
+                        if (ImGui::Checkbox("Validate Hudless", &hudValidation))
+                        {
+                            Config::Instance()->FGHUDValidation = hudValidation;
+                            LOG_DEBUG("Enabled set FGHUDValidation: {}", hudValidation);
+                        }
+                        ShowHelpMarker("Compares used hudless with the final image on GPU\n"
+                                       "Resources which mostly don't match are skipped and retried later\n\n"
+                                       "Scores are listed in hudless resources window (Res)");
+
+                        ImGui::SameLine(0.0f, 16.0f);
+                        ImGui::BeginDisabled(!hudValidation);
+                        ImGui::PushItemWidth(95.0f * Config::Instance()->MenuScale.value_or_default());
+                        float hudThreshold = Config::Instance()->FGHUDValidationThreshold.value_or_default();
+                        if (ImGui::SliderFloat("Threshold##HV", &hudThreshold, 0.0f, 1.0f, "%.2f"))
+                            Config::Instance()->FGHUDValidationThreshold = hudThreshold;
+                        ImGui::PopItemWidth();
+                        ShowHelpMarker("Minimum fraction of pixels matching the final image");
+                        ImGui::EndDisabled();
+
                         ImGui::EndDisabled();
 
                         auto hudExtended = Config::Instance()->FGHUDFixExtended.value_or_default();
@@ -2687,6 +2830,14 @@ bool MenuCommon::RenderMenu()
                             Config::Instance()->FGResourceFlipOffset = resourceFlipOffset;
                         ShowHelpMarker("Use height difference as offset");
 
+                        if (resourceFlip)
+                        {
+                            bool fuseInputs = Config::Instance()->FGFuseInputPasses.value_or_default();
+                            if (ImGui::Checkbox("Single Pass Flip", &fuseInputs))
+                                Config::Instance()->FGFuseInputPasses = fuseInputs;
+                            ShowHelpMarker("Flip velocity & depth and scale depth with one dispatch");
+                        }
+
                         ImGui::Spacing();
                         if (ImGui::CollapsingHeader("Advanced OptiFG Settings"))
                         {
@@ -2810,6 +2961,44 @@ bool MenuCommon::RenderMenu()
                                 ShowHelpMarker("Make a copy of depth to use with OptiFG\n"
                                                "For preventing corruptions that might happen");
 
+                                bool hazardTracking = Config::Instance()->FGHazardTracking.value_or_default();
+                                if (ImGui::Checkbox("FG Skip Unneeded Copies", &hazardTracking))
+                                    Config::Instance()->FGHazardTracking = hazardTracking;
+                                ShowHelpMarker("Watch if game writes to copied resources before FG uses them\n"
+                                               "Copies are skipped when no writes are seen for a while\n"
+                                               "Learned results are saved with Save INI");
+
+                                if (hazardTracking)
+                                {
+                                    const char* inputNames[] = { "MV", "Depth", "Hudless" };
+
+                                    for (uint32_t i = 0; i < (uint32_t) FGInput::Count; i++)
+                                    {
+                                        auto input = (FGInput) i;
+                                        auto savedMB = FGHazard_Dx12::SavedBytes(input) / 1048576.0;
+
+                                        switch (FGHazard_Dx12::State(input))
+                                        {
+                                        case HazardState::Learning:
+                                            ImGui::Text("%s: Learning %u/%u", inputNames[i],
+                                                        FGHazard_Dx12::CleanFrames(input),
+                                                        FGHazard_Dx12::RequiredFrames(input));
+                                            break;
+
+                                        case HazardState::Safe:
+                                            ImGui::Text("%s: Skipping, saved %.1f MB", inputNames[i], savedMB);
+                                            break;
+
+                                        case HazardState::Hazard:
+                                            ImGui::Text("%s: Copying, saved %.1f MB", inputNames[i], savedMB);
+                                            break;
+                                        }
+                                    }
+
+                                    if (ImGui::Button("Relearn Copies"))
+                                        FGHazard_Dx12::Reset();
+                                }
+
                                 ImGui::PushItemWidth(115.0f * Config::Instance()->MenuScale.value_or_default());
                                 float depthScaleMax = Config::Instance()->FGDepthScaleMax.value_or_default();
                                 if (ImGui::InputFloat("FG Scale Depth Max", &depthScaleMax, 10.0f, 100.0f, "%.1f"))
@@ -2936,6 +3125,27 @@ bool MenuCommon::RenderMenu()
                                     if (ImGui::Button("Apply Timing Changes"))
                                         State::Instance().FSRFGFTPchanged = true;
 
+                                    if (bool fptAutoTune = Config::Instance()->FGFPTAutoTune.value_or_default();
+                                        ImGui::Checkbox("Auto Tune", &fptAutoTune))
+                                        Config::Instance()->FGFPTAutoTune = fptAutoTune;
+                                    ShowHelpMarker("Adjusts safety margin and variance factor\n"
+                                                   "while measured pacing error keeps improving");
+
+                                    if (auto pacing = FGPacing::Stats(); pacing.presents > 0)
+                                    {
+                                        ImGui::Text("Interval: %.2f ms, Jitter: %.2f ms", pacing.interval,
+                                                    pacing.jitter);
+                                        ImGui::Text("Pacing Error: %.1f%%, Real/Generated: %.1f%%",
+                                                    pacing.error * 100.0, pacing.imbalance * 100.0);
+
+                                        if (pacing.displayInterval > 0.0)
+                                            ImGui::Text("Display: %.2f ms, Jitter: %.2f ms", pacing.displayInterval,
+                                                        pacing.displayJitter);
+
+                                        if (Config::Instance()->FGFPTAutoTune.value_or_default())
+                                            ImGui::Text(FGPacing::TunerConverged() ? "Tuned" : "Tuning...");
+                                    }
+
                                     ImGui::EndDisabled();
                                     ImGui::TreePop();
                                 }
@@ -3027,7 +3237,7 @@ bool MenuCommon::RenderMenu()
                 {
                     // FSR Common -----------------
                     if (currentFeature != nullptr && !currentFeature->IsFrozen() &&
-                        (State::Instance().activeFgType == FGType::OptiFG || currentBackend.rfind("fsr", 0) == 0))
+                        (State::Instance().activeFgType == FGType::OptiFG || IsFSRUpscaler(currentBackend)))
                     {
                         SeparatorWithHelpMarker("FSR Common Settings", "Affects both FSR-FG & Upscalers");
 
@@ -3368,7 +3578,7 @@ bool MenuCommon::RenderMenu()
                     {
                         Config::Instance()->OverrideSharpness = overrideSharpness;
 
-                        if (currentBackend == "dlss" && State::Instance().currentFeature->Version().major < 3)
+                        if (currentBackend == Upscaler::DLSS && State::Instance().currentFeature->Version().major < 3)
                         {
                             State::Instance().newBackend = currentBackend;
                             MARK_ALL_BACKENDS_CHANGED();
@@ -3390,12 +3600,13 @@ bool MenuCommon::RenderMenu()
                     ImGui::EndDisabled();
 
                     // RCAS
-                    if (State::Instance().api == DX12 || State::Instance().api == DX11)
+                    if (State::Instance().api == DX12 || State::Instance().api == DX11 ||
+                        State::Instance().api == Vulkan)
                     {
                         // xess or dlss version >= 2.5.1
                         constexpr feature_version requiredDlssVersion = { 2, 5, 1 };
-                        rcasEnabled = (currentBackend == "xess" ||
-                                       (currentBackend == "dlss" &&
+                        rcasEnabled = (currentBackend == Upscaler::XeSS ||
+                                       (currentBackend == Upscaler::DLSS &&
                                         State::Instance().currentFeature->Version() >= requiredDlssVersion));
 
                         if (bool rcas = Config::Instance()->RcasEnabled.value_or(rcasEnabled);
@@ -3507,6 +3718,37 @@ bool MenuCommon::RenderMenu()
                                    "1.5x on a 1080p screen means internal resolution of 720p\n"
                                    "1080 / 1.5 = 720");
 
+                    if (bool autoScale = Config::Instance()->AutoRenderScaleEnabled.value_or_default();
+                        ImGui::Checkbox("Auto render scale", &autoScale))
+                    {
+                        Config::Instance()->AutoRenderScaleEnabled = autoScale;
+                    }
+
+                    ShowHelpMarker("Adjusts render resolution to reach target frame time\n"
+                                   "Overrides ratios above when enabled\n\n"
+                                   "New resolution is used when game asks for\n"
+                                   "optimal settings again, not every game does it");
+
+                    if (Config::Instance()->AutoRenderScaleEnabled.value_or_default())
+                    {
+                        float target = Config::Instance()->AutoRenderScaleTarget.value_or_default();
+                        if (ImGui::SliderFloat("Target Frame Time", &target, 4.0f, 50.0f, "%.2f ms"))
+                            Config::Instance()->AutoRenderScaleTarget = target;
+
+                        float maxRatio = Config::Instance()->AutoRenderScaleMaxRatio.value_or_default();
+                        float ratioLimit =
+                            Config::Instance()->ExtendedLimits.value_or_default() ? maxSliderLimit : 2.0f;
+
+                        if (ImGui::SliderFloat("Max Ratio", &maxRatio, 1.0f, ratioLimit, "%.3f"))
+                            Config::Instance()->AutoRenderScaleMaxRatio = maxRatio;
+
+                        if (auto ratio = RenderScale::Ratio(); ratio.has_value())
+                            ImGui::Text("Current Ratio: %.3f", ratio.value());
+
+                        if (RenderScale::WaitingForQuery())
+                            ImGui::Text("Waiting for game to query the new ratio");
+                    }
+
                     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default())
                     {
                         float urOverride = Config::Instance()->UpscaleRatioOverrideValue.value_or_default();
@@ -3544,7 +3786,8 @@ bool MenuCommon::RenderMenu()
                     if (currentFeature != nullptr && !currentFeature->IsFrozen())
                     {
                         // OUTPUT SCALING -----------------------------
-                        if (State::Instance().api == DX12 || State::Instance().api == DX11)
+                        if (State::Instance().api == DX12 || State::Instance().api == DX11 ||
+                            State::Instance().api == Vulkan)
                         {
                             // if motion vectors are not display size
                             ImGui::BeginDisabled(!currentFeature->LowResMV());
@@ -3559,11 +3802,13 @@ bool MenuCommon::RenderMenu()
                                 _ssEnabled = Config::Instance()->OutputScalingEnabled.value_or_default();
                                 _ssUseFsr = Config::Instance()->OutputScalingUseFsr.value_or_default();
                                 _ssDownsampler = Config::Instance()->OutputScalingDownscaler.value_or_default();
+                                _ssFuseRcas = Config::Instance()->OutputScalingFuseRcas.value_or_default();
                             }
 
-                            ImGui::BeginDisabled((currentBackend == "xess" || currentBackend == "dlss") &&
-                                                 State::Instance().currentFeature->RenderWidth() >
-                                                     State::Instance().currentFeature->DisplayWidth());
+                            ImGui::BeginDisabled(
+                                (currentBackend == Upscaler::XeSS || currentBackend == Upscaler::DLSS) &&
+                                State::Instance().currentFeature->RenderWidth() >
+                                    State::Instance().currentFeature->DisplayWidth());
                             ImGui::Checkbox("Enable", &_ssEnabled);
                             ImGui::EndDisabled();
 
@@ -3577,12 +3822,15 @@ bool MenuCommon::RenderMenu()
 
                             ImGui::BeginDisabled(!_ssEnabled);
                             {
+                                // Vulkan only has bicubic scaling
+                                ImGui::BeginDisabled(State::Instance().api == Vulkan);
                                 ImGui::Checkbox("Use FSR 1", &_ssUseFsr);
+                                ImGui::EndDisabled();
                                 ShowHelpMarker("Use FSR 1 for scaling");
 
                                 ImGui::SameLine(0.0f, 6.0f);
 
-                                ImGui::BeginDisabled(_ssUseFsr || _ssRatio < 1.0f);
+                                ImGui::BeginDisabled(_ssUseFsr || _ssRatio < 1.0f || State::Instance().api == Vulkan);
                                 {
                                     const char* ds_modes[] = { "Bicubic", "Lanczos", "Catmull-Rom", "MAGC" };
                                     const std::string ds_modesDesc[] = { "", "", "", "" };
@@ -3593,6 +3841,16 @@ bool MenuCommon::RenderMenu()
                                     ImGui::PopItemWidth();
                                 }
                                 ImGui::EndDisabled();
+
+                                if (State::Instance().api == DX12)
+                                {
+                                    ImGui::BeginDisabled(_ssUseFsr);
+                                    ImGui::Checkbox("Fuse RCAS", &_ssFuseRcas);
+                                    ShowHelpMarker("Apply RCAS while scaling the output in a single pass\n"
+                                                   "Skips RCAS buffer and one full screen pass\n\n"
+                                                   "Only used with bicubic scaling");
+                                    ImGui::EndDisabled();
+                                }
                             }
                             ImGui::EndDisabled();
 
@@ -3600,6 +3858,7 @@ bool MenuCommon::RenderMenu()
                                 _ssEnabled != Config::Instance()->OutputScalingEnabled.value_or_default() ||
                                 _ssRatio != Config::Instance()->OutputScalingMultiplier.value_or(defaultRatio) ||
                                 _ssUseFsr != Config::Instance()->OutputScalingUseFsr.value_or_default() ||
+                                _ssFuseRcas != Config::Instance()->OutputScalingFuseRcas.value_or_default() ||
                                 (_ssRatio > 1.0f &&
                                  _ssDownsampler != Config::Instance()->OutputScalingDownscaler.value_or_default());
 
@@ -3609,10 +3868,11 @@ bool MenuCommon::RenderMenu()
                                 Config::Instance()->OutputScalingEnabled = _ssEnabled;
                                 Config::Instance()->OutputScalingMultiplier = _ssRatio;
                                 Config::Instance()->OutputScalingUseFsr = _ssUseFsr;
+                                Config::Instance()->OutputScalingFuseRcas = _ssFuseRcas;
                                 _ssDownsampler = Config::Instance()->OutputScalingDownscaler.value_or_default();
 
                                 if (State::Instance().currentFeature->Name() == "DLSSD")
-                                    State::Instance().newBackend = "dlssd";
+                                    State::Instance().newBackend = Upscaler::DLSSD;
                                 else
                                     State::Instance().newBackend = currentBackend;
 
@@ -3646,7 +3906,8 @@ bool MenuCommon::RenderMenu()
                         ImGui::TableNextColumn();
 
                         // AutoExposure is always enabled for XeSS with native Dx11
-                        bool autoExposureDisabled = State::Instance().api == API::DX11 && currentBackend == "xess";
+                        bool autoExposureDisabled =
+                            State::Instance().api == API::DX11 && currentBackend == Upscaler::XeSS;
                         ImGui::BeginDisabled(autoExposureDisabled);
 
                         if (bool autoExposure = currentFeature->AutoExposure();
@@ -3666,8 +3927,9 @@ bool MenuCommon::RenderMenu()
                         ImGui::BeginDisabled(!accessToReactiveMask);
 
                         bool canUseReactiveMask =
-                            accessToReactiveMask && currentBackend != "dlss" &&
-                            (currentBackend != "xess" || currentFeature->Version() >= feature_version { 2, 0, 1 });
+                            accessToReactiveMask && currentBackend != Upscaler::DLSS &&
+                            (currentBackend != Upscaler::XeSS ||
+                             currentFeature->Version() >= feature_version { 2, 0, 1 });
 
                         bool disableReactiveMask =
                             Config::Instance()->DisableReactiveMask.value_or(!canUseReactiveMask);
@@ -3676,7 +3938,7 @@ bool MenuCommon::RenderMenu()
                         {
                             Config::Instance()->DisableReactiveMask = disableReactiveMask;
 
-                            if (currentBackend == "xess")
+                            if (currentBackend == Upscaler::XeSS)
                             {
                                 State::Instance().newBackend = currentBackend;
                                 MARK_ALL_BACKENDS_CHANGED();
@@ -3755,12 +4017,13 @@ bool MenuCommon::RenderMenu()
                                 ImGui::EndTable();
                             }
 
-                            if (State::Instance().currentFeature->AccessToReactiveMask() && currentBackend != "dlss")
+                            if (State::Instance().currentFeature->AccessToReactiveMask() &&
+                                currentBackend != Upscaler::DLSS)
                             {
                                 ImGui::BeginDisabled(
-                                    Config::Instance()->DisableReactiveMask.value_or(currentBackend == "xess"));
+                                    Config::Instance()->DisableReactiveMask.value_or(currentBackend == Upscaler::XeSS));
 
-                                bool binaryMask = State::Instance().api == Vulkan || currentBackend == "xess";
+                                bool binaryMask = State::Instance().api == Vulkan || currentBackend == Upscaler::XeSS;
                                 auto defaultBias = binaryMask ? 0.0f : 0.45f;
                                 auto maskBias = Config::Instance()->DlssReactiveMaskBias.value_or(defaultBias);
 
@@ -3835,7 +4098,7 @@ bool MenuCommon::RenderMenu()
                     }
 
                     // Non-DLSS hotfixes -----------------------------
-                    if (currentFeature != nullptr && !currentFeature->IsFrozen() && currentBackend != "dlss")
+                    if (currentFeature != nullptr && !currentFeature->IsFrozen() && currentBackend != Upscaler::DLSS)
                     {
                         // BARRIERS -----------------------------
                         ImGui::Spacing();
@@ -3974,6 +4237,12 @@ bool MenuCommon::RenderMenu()
                     if (ImGui::SliderFloat("Background Alpha", &fpsAlpha, 0.0f, 1.0f, "%.2f"))
                         Config::Instance()->FpsOverlayAlpha = fpsAlpha;
 
+                    float fpsUpdateRate = Config::Instance()->FpsOverlayUpdateRate.value_or_default();
+                    if (ImGui::SliderFloat("Update Rate", &fpsUpdateRate, 0.0f, 60.0f, "%.0f Hz"))
+                        Config::Instance()->FpsOverlayUpdateRate = fpsUpdateRate;
+                    ShowHelpMarker("How many times per second overlay texts and graphs are updated\n"
+                                   "0 updates them every frame");
+
                     const char* options[] = { "Same as menu", "0.5", "0.6", "0.7", "0.8", "0.9", "1.0", "1.1", "1.2",
                                               "1.3",          "1.4", "1.5", "1.6", "1.7", "1.8", "1.9", "2.0" };
                     int currentIndex = std::max(((int) (Config::Instance()->FpsScale.value_or(0.0f) * 10.0f)) - 4, 0);
@@ -3994,6 +4263,114 @@ bool MenuCommon::RenderMenu()
                     }
                 }
 
+                // BENCHMARK -----------------------------
+                ImGui::Spacing();
+                if (ImGui::CollapsingHeader("Benchmark"))
+                {
+                    ScopedIndent indent {};
+                    ImGui::Spacing();
+
+                    auto running = Benchmark::IsRunning();
+
+                    ImGui::Text("Backends: %s", Config::Instance()->BenchmarkBackends.value_or_default().c_str());
+                    ImGui::Text("Ratios: %s", Config::Instance()->BenchmarkRatios.value_or_default().c_str());
+                    ShowHelpMarker("Backends and ratios can be changed from ini\n"
+                                   "Ratios are only applied when game queries render resolution again");
+
+                    ImGui::BeginDisabled(running);
+
+                    int benchmarkFrames = Config::Instance()->BenchmarkFrames.value_or_default();
+                    if (ImGui::SliderInt("Frames", &benchmarkFrames, 10, 3000))
+                        Config::Instance()->BenchmarkFrames = benchmarkFrames;
+
+                    int benchmarkWarmup = Config::Instance()->BenchmarkWarmupFrames.value_or_default();
+                    if (ImGui::SliderInt("Warmup Frames", &benchmarkWarmup, 0, 600))
+                        Config::Instance()->BenchmarkWarmupFrames = benchmarkWarmup;
+
+                    ImGui::BeginDisabled(State::Instance().api != DX12);
+
+                    bool benchmarkCapture = Config::Instance()->BenchmarkCapture.value_or_default();
+                    if (ImGui::Checkbox("Capture Outputs", &benchmarkCapture))
+                        Config::Instance()->BenchmarkCapture = benchmarkCapture;
+                    ShowHelpMarker("Saves upscaler output of each run as DDS for offline comparison\n"
+                                   "Only supported with DX12, keep the camera still while running");
+
+                    ImGui::EndDisabled();
+                    ImGui::EndDisabled();
+
+                    ImGui::BeginDisabled(running || currentFeature == nullptr);
+                    if (ImGui::Button("Start"))
+                        Benchmark::Start();
+                    ImGui::EndDisabled();
+
+                    ImGui::SameLine(0.0f, 6.0f);
+
+                    ImGui::BeginDisabled(!running);
+                    if (ImGui::Button("Stop"))
+                        Benchmark::Stop();
+                    ImGui::EndDisabled();
+
+                    if (auto status = Benchmark::Status(); !status.empty())
+                        ImGui::TextWrapped("%s", status.c_str());
+                }
+
+                // TELEMETRY -----------------------------
+                ImGui::Spacing();
+                if (ImGui::CollapsingHeader("Telemetry"))
+                {
+                    ScopedIndent indent {};
+                    ImGui::Spacing();
+
+                    if (bool telemetry = Config::Instance()->TelemetryEnabled.value_or_default();
+                        ImGui::Checkbox("Export Telemetry", &telemetry))
+                        Config::Instance()->TelemetryEnabled = telemetry;
+
+                    ShowHelpMarker("Writes metrics of every frame to shared memory\n"
+                                   "for external tools like tools/telemetry_reader.py");
+
+                    if (Telemetry::IsOpen())
+                        ImGui::Text("Mapping: %s", wstring_to_string(Telemetry::MappingName()).c_str());
+                }
+
+                // VRAM -----------------------------
+                ImGui::Spacing();
+                if (ImGui::CollapsingHeader("VRAM"))
+                {
+                    ScopedIndent indent {};
+                    ImGui::Spacing();
+
+                    auto memoryInfo = VramTracker::MemoryInfo();
+                    const char* pressureNames[] = { "Normal", "High", "Over Budget" };
+
+                    ImGui::Text("Process usage: %llu / %llu MB", memoryInfo.CurrentUsage / 1048576,
+                                memoryInfo.Budget / 1048576);
+                    ImGui::Text("Pressure: %s", pressureNames[(uint32_t) VramTracker::Pressure()]);
+
+                    ImGui::Spacing();
+                    ImGui::Text("OptiScaler: %.1f MB in %zu resources", VramTracker::Total() / 1048576.0,
+                                VramTracker::Count());
+
+                    for (uint32_t i = 0; i < (uint32_t) VramOwner::Count; i++)
+                    {
+                        auto total = VramTracker::Total((VramOwner) i);
+
+                        if (total > 0)
+                            ImGui::Text("  %s: %.1f MB", VramOwnerName((VramOwner) i), total / 1048576.0);
+                    }
+
+                    ImGui::Spacing();
+
+                    bool budgetSaving = Config::Instance()->VramBudgetSaving.value_or_default();
+                    if (ImGui::Checkbox("Save VRAM Near Budget", &budgetSaving))
+                        Config::Instance()->VramBudgetSaving = budgetSaving;
+                    ShowHelpMarker("When usage gets close to budget frame generation skips\n"
+                                   "optional velocity and depth copies, over budget hudless copy is skipped too");
+
+                    float budgetThreshold = Config::Instance()->VramBudgetThreshold.value_or_default();
+                    if (ImGui::SliderFloat("Budget Threshold", &budgetThreshold, 0.5f, 1.0f, "%.2f"))
+                        Config::Instance()->VramBudgetThreshold = budgetThreshold;
+                }
+
                 // UPSCALER INPUTS -----------------------------
                 ImGui::Spacing();
                 auto uiStateOpen = currentFeature == nullptr || currentFeature->IsFrozen();
@@ -4541,9 +4918,21 @@ bool MenuCommon::RenderMenu()
 
                             ImGui::TableSetColumnIndex(0);
 
-                            ImGui::Text(std::format("{:X}, Count: {}, {}", (size_t) it->first, it->second.usageCount,
-                                                    it->second.enabled ? "Active" : "Passive")
-                                            .c_str());
+                            if (it->second.confidence < 0.0f)
+                            {
+                                ImGui::Text(std::format("{:X}, Count: {}, {}", (size_t) it->first,
+                                                        it->second.usageCount,
+                                                        it->second.enabled ? "Active" : "Passive")
+                                                .c_str());
+                            }
+                            else
+                            {
+                                ImGui::Text(std::format("{:X}, Count: {}, {}, Score: {:.2f}", (size_t) it->first,
+                                                        it->second.usageCount,
+                                                        it->second.enabled ? "Active" : "Passive",
+                                                        it->second.confidence)
+                                                .c_str());
+                            }
 
                             ImGui::TableSetColumnIndex(1);
 
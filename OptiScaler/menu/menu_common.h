@@ -6,6 +6,8 @@
 #include <resource.h>
 #include <Logger.h>
 
+#include <upscalers/Upscaler.h>
+
 #include <imgui/imgui.h>
 #include <imgui/imgui_impl_win32.h>
 #include <imgui/imgui_impl_uwp.h>
@@ -51,6 +53,27 @@ class MenuCommon
 
     inline static UINT64 _frameCount = 0;
 
+    // fps overlay, cached values are rebuilt with FpsOverlayUpdateRate
+    inline static double _fpsLastUpdate = 0.0;
+    inline static int _fpsLastType = -1;
+    inline static bool _fpsLastHorizontal = false;
+    inline static float _fpsLastScale = 0.0f;
+    inline static double _fpsFrameTime = 0.0;
+    inline static double _fpsFrameRate = 0.0;
+    inline static float _fpsAverageFrameTime = 0.0f;
+    inline static float _fpsAverageUpscalerTime = 0.0f;
+    inline static std::vector<float> _fpsFrameTimes;
+    inline static std::vector<float> _fpsUpscalerTimes;
+    inline static std::string _fpsFirstLine;
+    inline static std::string _fpsSecondLine;
+    inline static std::string _fpsThirdLine;
+    inline static ImVec2 _fpsPlotSize = {};
+
+    // Normalized graph points, built with the texts so graphs are not resampled every frame
+    inline static std::vector<ImVec2> _fpsFramePlot;
+    inline static std::vector<ImVec2> _fpsUpscalerPlot;
+    inline static std::vector<ImVec2> _fpsPlotPoints;
+
     // reflex
     inline static float _limitFps = INFINITY;
 
@@ -62,6 +85,7 @@ class MenuCommon
     inline static bool _ssEnabled = false;
     inline static bool _ssUseFsr = false;
     inline static uint32_t _ssDownsampler = 0;
+    inline static bool _ssFuseRcas = false;
 
     // ui scale
     inline static int _selectedScale = 5;
@@ -79,6 +103,9 @@ class MenuCommon
     inline static void ReInitUpscaler();
 
     inline static void SeparatorWithHelpMarker(const char* label, const char* tip);
+    static void UpdateFpsOverlayTexts(float fpsScale);
+    static void BuildFpsPlot(const std::vector<float>& values, float scaleMax, std::vector<ImVec2>& plot);
+    static void DrawFpsPlot(const std::vector<ImVec2>& plot);
 
 #pragma region "Hooks & WndProc"
 
@@ -127,12 +154,12 @@ class MenuCommon
 
 #pragma endregion
 
-    static std::string GetBackendName(std::string* code);
-    static std::string GetBackendCode(const API api);
-    static void GetCurrentBackendInfo(const API api, std::string* code, std::string* name);
-    static void AddDx11Backends(std::string* code, std::string* name);
-    static void AddDx12Backends(std::string* code, std::string* name);
-    static void AddVulkanBackends(std::string* code, std::string* name);
+    static std::string GetBackendName(Upscaler* code);
+    static Upscaler GetBackendCode(const API api);
+    static void GetCurrentBackendInfo(const API api, Upscaler* code, std::string* name);
+    static void AddDx11Backends(Upscaler* code, std::string* name);
+    static void AddDx12Backends(Upscaler* code, std::string* name);
+    static void AddVulkanBackends(Upscaler* code, std::string* name);
     template <HasDefaultValue B> static void AddResourceBarrier(std::string name, CustomOptional<int32_t, B>* value);
     template <HasDefaultValue B> static void AddDLSSRenderPreset(std::string name, CustomOptional<uint32_t, B>* value);
     template <HasDefaultValue B> static void AddDLSSDRenderPreset(std::string name, CustomOptional<uint32_t, B>* value);
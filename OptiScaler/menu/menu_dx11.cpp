@@ -2,6 +2,7 @@
 
 #include "Config.h"
 #include "menu_common.h"
+#include <misc/VramTracker.h>
 #include <imgui/imgui_impl_dx11.h>
 #include <imgui/imgui_impl_win32.h>
 
@@ -58,6 +59,7 @@ void Menu_Dx11::CreateRenderTarget(ID3D11Resource* out)
         textureDesc.MiscFlags = 0;
 
         _device->CreateTexture2D(&textureDesc, nullptr, &_renderTargetTexture);
+        VramTracker::Track(_renderTargetTexture, VramOwner::Overlay);
 
         D3D11_RENDER_TARGET_VIEW_DESC rtvDesc;
         ZeroMemory(&rtvDesc, sizeof(rtvDesc));
@@ -4,6 +4,7 @@
 
 #include "Config.h"
 #include "menu_common.h"
+#include <misc/VramTracker.h>
 #include <imgui/imgui_impl_dx12.h>
 #include <imgui/imgui_impl_win32.h>
 
@@ -318,6 +319,7 @@ void Menu_Dx12::CreateRenderTarget(const D3D12_RESOURCE_DESC& InDesc)
         if (result == S_OK)
         {
             renderTarget->SetName(L"Imgui_Dx12_renderTarget");
+            VramTracker::Track(renderTarget, VramOwner::Overlay);
 
             D3D12_RENDER_TARGET_VIEW_DESC rtDesc = {};
             rtDesc.Format = InDesc.Format;
@@ -0,0 +1,398 @@
+#include "BackendPreloader.h"
+
+#include <Config.h>
+#include <proxies/KernelBase_Proxy.h>
+#include <upscalers/Upscaler.h>
+
+#include <fstream>
+
+static const char* LibraryName(PreloadLibrary library)
+{
+    switch (library)
+    {
+    case PreloadLibrary::XeSS:
+        return "libxess.dll";
+    case PreloadLibrary::XeSSDx11:
+        return "libxess_dx11.dll";
+    case PreloadLibrary::FfxDx12:
+        return "amd_fidelityfx_dx12.dll";
+    case PreloadLibrary::FfxVk:
+        return "amd_fidelityfx_vk.dll";
+    case PreloadLibrary::DLSSSnippet:
+        return "nvngx_dlss.dll";
+    default:
+        return "";
+    }
+}
+
+void BackendPreloader::Start()
+{
+    if (_thread != nullptr)
+        return;
+
+    if (!Config::Instance()->PreloadBackends.value_or_default())
+    {
+        _done.store(true, std::memory_order_release);
+        return;
+    }
+
+    // We are inside DLL_PROCESS_ATTACH, thread will start running after loader lock is released
+    _thread = CreateThread(nullptr, 0, Run, nullptr, 0, nullptr);
+
+    if (_thread == nullptr)
+    {
+        LOG_ERROR("CreateThread error: {:X}", GetLastError());
+        _done.store(true, std::memory_order_release);
+    }
+}
+
+DWORD WINAPI BackendPreloader::Run(LPVOID lpParam)
+{
+    auto config = Config::Instance();
+    auto start = Util::MillisecondsNow();
+
+    LoadCache();
+
+    // Api is not known yet, libraries of upscalers selected for any api are preloaded
+    auto dx11 = UpscalerFromCode(config->Dx11Upscaler.value_or_default());
+    auto dx12 = UpscalerFromCode(config->Dx12Upscaler.value_or_default());
+    auto vulkan = UpscalerFromCode(config->VulkanUpscaler.value_or_default());
+
+    if (dx12 == Upscaler::XeSS || vulkan == Upscaler::XeSS || dx11 == Upscaler::XeSS_Dx12)
+        Preload(PreloadLibrary::XeSS, Candidates(config->XeSSLibrary, { L"libxess.dll" }));
+
+    if (dx11 == Upscaler::XeSS)
+        Preload(PreloadLibrary::XeSSDx11, Candidates(config->XeSSDx11Library, { L"libxess_dx11.dll" }));
+
+    if (dx12 == Upscaler::FSR31 || dx11 == Upscaler::FSR31_Dx12 ||
+        config->FGType.value_or_default() == FGType::OptiFG)
+    {
+        Preload(PreloadLibrary::FfxDx12,
+                Candidates(config->FfxDx12Path, { L"amd_fidelityfx_dx12.dll", L"amd_fidelityfx_loader_dx12.dll" }));
+    }
+
+    if (vulkan == Upscaler::FSR31)
+        Preload(PreloadLibrary::FfxVk, Candidates(config->FfxVkPath, { L"amd_fidelityfx_vk.dll" }));
+
+    if (config->DLSSEnabled.value_or_default() &&
+        (dx11 == Upscaler::DLSS || dx12 == Upscaler::DLSS || vulkan == Upscaler::DLSS))
+    {
+        Preload(PreloadLibrary::DLSSSnippet, Candidates(config->NVNGX_DLSS_Library, { L"nvngx_dlss.dll" }));
+    }
+
+    SaveCache();
+
+    _done.store(true, std::memory_order_release);
+    LOG_INFO("Backend preloading done in {:.1f} ms", Util::MillisecondsNow() - start);
+
+    return 0;
+}
+
+// Same order proxies use, ini path first then OptiScaler and exe folders
+std::vector<std::filesystem::path> BackendPreloader::Candidates(const std::optional<std::wstring>& InConfigPath,
+                                                                const std::vector<std::wstring>& InNames)
+{
+    std::vector<std::filesystem::path> candidates;
+
+    if (InConfigPath.has_value())
+    {
+        std::filesystem::path cfgPath(InConfigPath.value());
+
+        if (cfgPath.has_extension())
+            candidates.push_back(cfgPath);
+        else
+        {
+            for (auto& name : InNames)
+                candidates.push_back(cfgPath / name);
+        }
+    }
+
+    for (auto& name : InNames)
+    {
+        candidates.push_back(Util::DllPath().parent_path() / name);
+
+        if (Util::ExePath().parent_path() != Util::DllPath().parent_path())
+            candidates.push_back(Util::ExePath().parent_path() / name);
+    }
+
+    return candidates;
+}
+
+void BackendPreloader::Preload(PreloadLibrary InLibrary, const std::vector<std::filesystem::path>& InCandidates)
+{
+    auto& result = _results[(uint32_t) InLibrary];
+
+    for (auto& path : InCandidates)
+    {
+        uint64_t size = 0;
+        uint64_t writeTime = 0;
+
+        if (!FileKey(path, &size, &writeTime))
+            continue;
+
+        auto cached = false;
+
+        {
+            std::lock_guard<std::mutex> lock(_cacheMutex);
+
+            if (auto entry = _cache.find(path.wstring());
+                entry != _cache.end() && entry->second.size == size && entry->second.writeTime == writeTime)
+            {
+                result.version = entry->second.version;
+                cached = true;
+            }
+        }
+
+        HMODULE module = nullptr;
+
+        // Util::GetDLLVersion loads the file again through hooked LoadLibrary which ends in proxies,
+        // version is read from the module mapped with original LoadLibrary instead
+        if (InLibrary == PreloadLibrary::DLSSSnippet)
+        {
+            PrefetchFile(path);
+
+            if (!cached)
+            {
+                module = KernelBaseProxy::LoadLibraryExW_()(path.c_str(), NULL,
+                                                            LOAD_LIBRARY_AS_DATAFILE | LOAD_LIBRARY_AS_IMAGE_RESOURCE);
+
+                if (module != nullptr)
+                {
+                    ReadVersion(module, &result.version);
+                    KernelBaseProxy::FreeLibrary_()(module);
+                    module = nullptr;
+                }
+            }
+        }
+        else
+        {
+            module = KernelBaseProxy::LoadLibraryExW_()(path.c_str(), NULL, 0);
+
+            if (module == nullptr)
+            {
+                LOG_WARN("Can't load {}, error: {:X}", wstring_to_string(path.wstring()), GetLastError());
+                continue;
+            }
+
+            Prefetch(module);
+
+            if (!cached)
+                ReadVersion(module, &result.version);
+        }
+
+        if (!cached)
+        {
+            std::lock_guard<std::mutex> lock(_cacheMutex);
+            _cache[path.wstring()] = { size, writeTime, result.version };
+            _cacheDirty = true;
+        }
+
+        result.found = true;
+        result.path = path;
+        result.module = module;
+
+        LOG_INFO("{} v{}.{}.{}.{} preloaded from {}{}", LibraryName(InLibrary), result.version.major,
+                 result.version.minor, result.version.patch, result.version.reserved,
+                 wstring_to_string(path.parent_path().wstring()), cached ? " (cached version)" : "");
+
+        return;
+    }
+
+    LOG_DEBUG("{} not found", LibraryName(InLibrary));
+}
+
+bool BackendPreloader::FileKey(const std::filesystem::path& InPath, uint64_t* OutSize, uint64_t* OutWriteTime)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data {};
+
+    if (!GetFileAttributesExW(InPath.c_str(), GetFileExInfoStandard, &data) ||
+        (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+    {
+        return false;
+    }
+
+    *OutSize = ((uint64_t) data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    *OutWriteTime = ((uint64_t) data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+
+    return true;
+}
+
+bool BackendPreloader::ReadVersion(HMODULE InModule, Util::version_t* OutVersion)
+{
+    auto resource = FindResourceW(InModule, MAKEINTRESOURCEW(VS_VERSION_INFO), RT_VERSION);
+
+    if (resource == nullptr)
+        return false;
+
+    auto size = SizeofResource(InModule, resource);
+    auto data = LockResource(LoadResource(InModule, resource));
+
+    if (data == nullptr || size == 0)
+        return false;
+
+    // VerQueryValueW needs a writable copy of the resource
+    std::vector<BYTE> versionInfo((BYTE*) data, (BYTE*) data + size);
+
+    VS_FIXEDFILEINFO* fileInfo = nullptr;
+    UINT fileInfoSize = 0;
+
+    if (!VerQueryValueW(versionInfo.data(), L"\\", (LPVOID*) &fileInfo, &fileInfoSize) || fileInfo == nullptr)
+        return false;
+
+    OutVersion->major = (fileInfo->dwFileVersionMS >> 16) & 0xffff;
+    OutVersion->minor = (fileInfo->dwFileVersionMS >> 0) & 0xffff;
+    OutVersion->patch = (fileInfo->dwFileVersionLS >> 16) & 0xffff;
+    OutVersion->reserved = (fileInfo->dwFileVersionLS >> 0) & 0xffff;
+
+    return true;
+}
+
+// Loader only maps the image, pages are read from disk when they are first touched
+void BackendPreloader::Prefetch(HMODULE InModule)
+{
+    auto dosHeader = (PIMAGE_DOS_HEADER) InModule;
+    auto ntHeaders = (PIMAGE_NT_HEADERS) ((BYTE*) InModule + dosHeader->e_lfanew);
+
+    WIN32_MEMORY_RANGE_ENTRY range {};
+    range.VirtualAddress = (PVOID) InModule;
+    range.NumberOfBytes = ntHeaders->OptionalHeader.SizeOfImage;
+
+    if (!PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0))
+        LOG_DEBUG("PrefetchVirtualMemory error: {:X}", GetLastError());
+}
+
+// Reads the file once so NGX finds it in file cache
+void BackendPreloader::PrefetchFile(const std::filesystem::path& InPath)
+{
+    auto file = CreateFileW(InPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    std::vector<BYTE> buffer(1024 * 1024);
+    DWORD read = 0;
+
+    while (ReadFile(file, buffer.data(), (DWORD) buffer.size(), &read, nullptr) && read > 0)
+        ;
+
+    CloseHandle(file);
+}
+
+std::filesystem::path BackendPreloader::CachePath() { return Util::DllPath().parent_path() / L"OptiScaler.backends"; }
+
+// Each line is: size write_time major minor patch reserved path
+void BackendPreloader::LoadCache()
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+
+    if (_cacheLoaded)
+        return;
+
+    _cacheLoaded = true;
+
+    std::ifstream file(CachePath());
+
+    if (!file.is_open())
+        return;
+
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        CacheEntry entry {};
+        uint32_t version[4] {};
+        int pathStart = 0;
+
+        if (sscanf_s(line.c_str(), "%llu %llu %u %u %u %u %n", &entry.size, &entry.writeTime, &version[0],
+                     &version[1], &version[2], &version[3], &pathStart) != 6 ||
+            pathStart == 0 || pathStart >= (int) line.size())
+        {
+            continue;
+        }
+
+        entry.version = { (uint16_t) version[0], (uint16_t) version[1], (uint16_t) version[2],
+                          (uint16_t) version[3] };
+
+        _cache[string_to_wstring(line.substr(pathStart))] = entry;
+    }
+
+    LOG_DEBUG("{} libraries in version cache", _cache.size());
+}
+
+void BackendPreloader::SaveCache()
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+
+    if (!_cacheDirty)
+        return;
+
+    std::ofstream file(CachePath(), std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        LOG_WARN("Can't write version cache: {}", wstring_to_string(CachePath().wstring()));
+        return;
+    }
+
+    for (auto& [path, entry] : _cache)
+    {
+        file << entry.size << " " << entry.writeTime << " " << entry.version.major << " " << entry.version.minor
+             << " " << entry.version.patch << " " << entry.version.reserved << " " << wstring_to_string(path)
+             << "\n";
+    }
+
+    _cacheDirty = false;
+}
+
+const PreloadResult* BackendPreloader::Result(PreloadLibrary InLibrary)
+{
+    if (!_done.load(std::memory_order_acquire))
+        return nullptr;
+
+    auto& result = _results[(uint32_t) InLibrary];
+    return result.found ? &result : nullptr;
+}
+
+HMODULE BackendPreloader::Module(PreloadLibrary InLibrary)
+{
+    auto result = Result(InLibrary);
+    return result != nullptr ? result->module : nullptr;
+}
+
+bool BackendPreloader::GetDLLVersion(const std::filesystem::path& InPath, Util::version_t* OutVersion)
+{
+    uint64_t size = 0;
+    uint64_t writeTime = 0;
+
+    if (!FileKey(InPath, &size, &writeTime))
+        return false;
+
+    LoadCache();
+
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+
+        if (auto entry = _cache.find(InPath.wstring());
+            entry != _cache.end() && entry->second.size == size && entry->second.writeTime == writeTime)
+        {
+            *OutVersion = entry->second.version;
+            return true;
+        }
+    }
+
+    if (!Util::GetDLLVersion(InPath.wstring(), OutVersion))
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cache[InPath.wstring()] = { size, writeTime, *OutVersion };
+        _cacheDirty = true;
+    }
+
+    // Worker saves the cache when it's done
+    if (_done.load(std::memory_order_acquire))
+        SaveCache();
+
+    return true;
+}
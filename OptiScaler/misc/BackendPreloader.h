@@ -0,0 +1,79 @@
+#pragma once
+
+#include <pch.h>
+
+#include <Util.h>
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+enum class PreloadLibrary : uint32_t
+{
+    XeSS,        // libxess.dll
+    XeSSDx11,    // libxess_dx11.dll
+    FfxDx12,     // amd_fidelityfx_dx12.dll or amd_fidelityfx_loader_dx12.dll
+    FfxVk,       // amd_fidelityfx_vk.dll
+    DLSSSnippet, // nvngx_dlss.dll, loaded by NGX itself so only its pages are prefetched
+
+    Count
+};
+
+typedef struct PreloadResult
+{
+    bool found = false;
+    std::filesystem::path path;
+    Util::version_t version {};
+    HMODULE module = nullptr;
+} preload_result;
+
+// Resolves, version checks and loads backend libraries selected in config on a worker thread after attach,
+// so first CreateFeature doesn't probe the disk from the render thread. Versions are cached in a small file
+// next to OptiScaler and only read again when size or write time of the library changes.
+class BackendPreloader
+{
+  private:
+    typedef struct CacheEntry
+    {
+        uint64_t size = 0;
+        uint64_t writeTime = 0;
+        Util::version_t version {};
+    } cache_entry;
+
+    inline static HANDLE _thread = nullptr;
+    inline static std::atomic<bool> _done = false;
+    inline static PreloadResult _results[(uint32_t) PreloadLibrary::Count] {};
+
+    inline static std::mutex _cacheMutex;
+    inline static std::unordered_map<std::wstring, CacheEntry> _cache;
+    inline static bool _cacheLoaded = false;
+    inline static bool _cacheDirty = false;
+
+    static DWORD WINAPI Run(LPVOID lpParam);
+    static void Preload(PreloadLibrary InLibrary, const std::vector<std::filesystem::path>& InCandidates);
+    static std::vector<std::filesystem::path> Candidates(const std::optional<std::wstring>& InConfigPath,
+                                                         const std::vector<std::wstring>& InNames);
+
+    static bool FileKey(const std::filesystem::path& InPath, uint64_t* OutSize, uint64_t* OutWriteTime);
+    static bool ReadVersion(HMODULE InModule, Util::version_t* OutVersion);
+    static void Prefetch(HMODULE InModule);
+    static void PrefetchFile(const std::filesystem::path& InPath);
+
+    static std::filesystem::path CachePath();
+    static void LoadCache();
+    static void SaveCache();
+
+  public:
+    // Called once at the end of attach, worker starts running after loader lock is released
+    static void Start();
+
+    // Doesn't wait for the worker, returns nullptr until preloading is finished
+    static const PreloadResult* Result(PreloadLibrary InLibrary);
+    static HMODULE Module(PreloadLibrary InLibrary);
+
+    // Util::GetDLLVersion with the version cache, file is only read when it's not in cache or changed
+    static bool GetDLLVersion(const std::filesystem::path& InPath, Util::version_t* OutVersion);
+};
@@ -0,0 +1,637 @@
+#include "Benchmark.h"
+#include "VramTracker.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+
+#include <resource_tracking/ResTrack_dx12.h>
+
+#include <json.hpp>
+#include <include/d3dx/d3dx12.h>
+
+#include <fstream>
+#include <sstream>
+
+// Frames to wait for a backend change or capture before giving up on the pair
+static constexpr uint32_t PhaseTimeout = 600;
+
+static std::vector<std::string> SplitList(const std::string& value)
+{
+    std::vector<std::string> result;
+    std::istringstream iss(value);
+    std::string item;
+
+    while (std::getline(iss, item, ','))
+    {
+        auto first = item.find_first_not_of(" \t");
+
+        if (first == std::string::npos)
+            continue;
+
+        auto last = item.find_last_not_of(" \t");
+        result.push_back(item.substr(first, last - first + 1));
+    }
+
+    return result;
+}
+
+static double Percentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    auto index = (size_t) std::ceil(percentile / 100.0 * values.size());
+    return values[std::clamp(index, (size_t) 1, values.size()) - 1];
+}
+
+static double Average(const std::vector<double>& values)
+{
+    if (values.empty())
+        return 0.0;
+
+    double sum = 0.0;
+
+    for (auto value : values)
+        sum += value;
+
+    return sum / values.size();
+}
+
+static std::string RunName(const BenchmarkRun& run)
+{
+    if (run.ratio > 0.0f)
+        return std::format("{}_{:.2f}", UpscalerCode(run.backend), run.ratio);
+
+    return UpscalerCode(run.backend);
+}
+
+Upscaler Benchmark::CurrentBackend()
+{
+    if (State::Instance().currentFeature != nullptr && State::Instance().currentFeature->Name() == "DLSSD")
+        return Upscaler::DLSSD;
+
+    std::string code;
+
+    if (State::Instance().api == DX11)
+        code = Config::Instance()->Dx11Upscaler.value_or_default();
+    else if (State::Instance().api == DX12)
+        code = Config::Instance()->Dx12Upscaler.value_or_default();
+    else
+        code = Config::Instance()->VulkanUpscaler.value_or_default();
+
+    return UpscalerFromCode(code);
+}
+
+void Benchmark::SwitchBackend(Upscaler backend)
+{
+    State::Instance().newBackend = backend;
+
+    for (auto& changeBackend : State::Instance().changeBackend)
+        changeBackend.second = true;
+}
+
+bool Benchmark::IsSwitching()
+{
+    for (auto& changeBackend : State::Instance().changeBackend)
+    {
+        if (changeBackend.second)
+            return true;
+    }
+
+    return State::Instance().currentFeature == nullptr || !State::Instance().currentFeature->IsInited();
+}
+
+bool Benchmark::Start()
+{
+    if (_phase != Phase::Idle)
+        return false;
+
+    if (State::Instance().currentFeature == nullptr)
+    {
+        _statusText = "No active upscaler";
+        return false;
+    }
+
+    auto usesDlssd = State::Instance().currentFeature->Name() == "DLSSD";
+    std::vector<Upscaler> backends;
+
+    for (auto& code : SplitList(Config::Instance()->BenchmarkBackends.value_or_default()))
+    {
+        auto backend = UpscalerFromCode(code);
+
+        if (backend == Upscaler::None)
+        {
+            LOG_WARN("Unknown backend: {}", code);
+            continue;
+        }
+
+        // DLSSD contexts can't be changed to other backends and vice versa
+        if ((backend == Upscaler::DLSSD) != usesDlssd)
+        {
+            LOG_INFO("Skipping {}, current feature: {}", code, State::Instance().currentFeature->Name());
+            continue;
+        }
+
+        backends.push_back(backend);
+    }
+
+    std::vector<float> ratios;
+
+    for (auto& value : SplitList(Config::Instance()->BenchmarkRatios.value_or_default()))
+    {
+        auto ratio = std::strtof(value.c_str(), nullptr);
+
+        if (ratio >= 1.0f)
+            ratios.push_back(ratio);
+        else
+            LOG_WARN("Invalid ratio: {}", value);
+    }
+
+    if (ratios.empty())
+        ratios.push_back(0.0f);
+
+    _runs.clear();
+
+    for (auto backend : backends)
+    {
+        for (auto ratio : ratios)
+        {
+            BenchmarkRun run {};
+            run.backend = backend;
+            run.ratio = ratio;
+            _runs.push_back(run);
+        }
+    }
+
+    if (_runs.empty())
+    {
+        _statusText = "No backends to test";
+        return false;
+    }
+
+    auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    _outputDir = Util::DllPath().parent_path() / "Benchmark" / std::format("{:%Y%m%d_%H%M%S}", now);
+
+    std::error_code ec;
+    std::filesystem::create_directories(_outputDir, ec);
+
+    if (ec)
+    {
+        LOG_ERROR("Can't create {}: {}", _outputDir.string(), ec.message());
+        _statusText = "Can't create output folder";
+        return false;
+    }
+
+    _initialBackend = CurrentBackend();
+    _baseVram = VramTracker::QueryUsage();
+    _current = 0;
+
+    LOG_INFO("Starting benchmark, {} runs, output: {}", _runs.size(), _outputDir.string());
+
+    StartRun();
+    return true;
+}
+
+void Benchmark::Stop()
+{
+    if (_phase == Phase::Idle)
+        return;
+
+    LOG_INFO("Benchmark stopped");
+
+    if (_current < _runs.size())
+        _runs[_current].status = "stopped";
+
+    Finish();
+}
+
+void Benchmark::StartRun()
+{
+    auto& run = _runs[_current];
+
+    _ratio = run.ratio;
+    _phaseFrames = 0;
+    _phase = Phase::Switching;
+
+    if (CurrentBackend() != run.backend)
+        SwitchBackend(run.backend);
+
+    LOG_INFO("Run {}/{}: {}", _current + 1, _runs.size(), RunName(run));
+}
+
+void Benchmark::FinishRun(std::string status)
+{
+    auto& run = _runs[_current];
+    run.status = status;
+
+    LOG_INFO("Run {} {}, avg frame time: {:.3f} ms, avg upscale time: {:.3f} ms", RunName(run), status,
+             Average(run.frameTimes), Average(run.upscaleTimes));
+
+    _current++;
+
+    if (_current < _runs.size())
+        StartRun();
+    else
+        Finish();
+}
+
+void Benchmark::Finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(_captureMutex);
+        _captureRequested = false;
+        ReleaseCapture();
+    }
+
+    WriteReport();
+
+    _ratio = 0.0f;
+    _phase = Phase::Idle;
+
+    if (_initialBackend != Upscaler::None && CurrentBackend() != _initialBackend)
+        SwitchBackend(_initialBackend);
+
+    _statusText = std::format("Report saved to {}", _outputDir.string());
+}
+
+void Benchmark::Update(double frameTimeMs)
+{
+    if (_phase == Phase::Idle)
+        return;
+
+    auto& run = _runs[_current];
+    _phaseFrames++;
+
+    switch (_phase)
+    {
+    case Phase::Switching:
+        if (!IsSwitching())
+        {
+            // Backend change could fail and fall back to another one
+            if (CurrentBackend() != run.backend)
+            {
+                LOG_WARN("Backend {} is not available", UpscalerCode(run.backend));
+                FinishRun("unsupported");
+                return;
+            }
+
+            _phaseFrames = 0;
+            _phase = Phase::Warmup;
+        }
+        else if (_phaseFrames > PhaseTimeout)
+        {
+            FinishRun("timeout");
+        }
+
+        break;
+
+    case Phase::Warmup:
+        if (_phaseFrames >= (uint32_t) Config::Instance()->BenchmarkWarmupFrames.value_or_default())
+        {
+            if (auto vram = VramTracker::QueryUsage(); vram.has_value() && _baseVram.has_value())
+                run.vramDelta = (int64_t) vram.value() - (int64_t) _baseVram.value();
+
+            {
+                std::lock_guard<std::mutex> lock(State::Instance().frameTimeMutex);
+                _lastUpscaleCount = State::Instance().upscaleTimeCount;
+            }
+
+            _phaseFrames = 0;
+            _phase = Phase::Measure;
+        }
+
+        break;
+
+    case Phase::Measure:
+    {
+        run.frameTimes.push_back(frameTimeMs);
+
+        {
+            std::lock_guard<std::mutex> lock(State::Instance().frameTimeMutex);
+
+            if (State::Instance().upscaleTimeCount != _lastUpscaleCount && !State::Instance().upscaleTimes.empty())
+            {
+                run.upscaleTimes.push_back(State::Instance().upscaleTimes.back());
+                _lastUpscaleCount = State::Instance().upscaleTimeCount;
+            }
+        }
+
+        if (_phaseFrames < (uint32_t) Config::Instance()->BenchmarkFrames.value_or_default())
+            break;
+
+        if (auto feature = State::Instance().currentFeature; feature != nullptr)
+        {
+            run.featureName = feature->Name();
+            run.renderWidth = feature->RenderWidth();
+            run.renderHeight = feature->RenderHeight();
+            run.displayWidth = feature->DisplayWidth();
+            run.displayHeight = feature->DisplayHeight();
+        }
+
+        if (Config::Instance()->BenchmarkCapture.value_or_default() && State::Instance().api == DX12)
+        {
+            std::lock_guard<std::mutex> lock(_captureMutex);
+            _captureDone = false;
+            _captureRequested = true;
+
+            _phaseFrames = 0;
+            _phase = Phase::Capture;
+            break;
+        }
+
+        FinishRun("ok");
+        break;
+    }
+
+    case Phase::Capture:
+        if (ProcessCapture())
+            FinishRun("ok");
+        else if (_phaseFrames > PhaseTimeout)
+            FinishRun("capture timeout");
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+std::optional<float> Benchmark::Ratio()
+{
+    std::optional<float> output;
+
+    if (auto ratio = _ratio.load(); ratio > 0.0f)
+        output = ratio;
+
+    return output;
+}
+
+bool Benchmark::IsRunning() { return _phase != Phase::Idle; }
+
+std::string Benchmark::Status()
+{
+    if (_phase == Phase::Idle)
+        return _statusText;
+
+    const char* phaseNames[] = { "Idle", "Switching", "Warmup", "Measuring", "Capturing" };
+    return std::format("{}/{} {} - {} {}", _current + 1, _runs.size(), RunName(_runs[_current]),
+                       phaseNames[(int) _phase], _phaseFrames);
+}
+
+bool Benchmark::CaptureRequested() { return _captureRequested.load(); }
+
+void Benchmark::CaptureOutput(ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InOutput,
+                              D3D12_RESOURCE_STATES InState)
+{
+    std::lock_guard<std::mutex> lock(_captureMutex);
+
+    if (!_captureRequested || InCmdList == nullptr || InOutput == nullptr || _capture.buffer != nullptr)
+        return;
+
+    _captureRequested = false;
+
+    ID3D12Device* device = nullptr;
+
+    if (InOutput->GetDevice(IID_PPV_ARGS(&device)) != S_OK)
+        return;
+
+    auto desc = InOutput->GetDesc();
+    UINT64 totalSize = 0;
+
+    device->GetCopyableFootprints(&desc, 0, 1, 0, &_capture.footprint, &_capture.rowCount, &_capture.rowSize,
+                                  &totalSize);
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(totalSize);
+
+    auto result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                                  D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                  IID_PPV_ARGS(&_capture.buffer));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommittedResource error: {:X}", (UINT) result);
+        device->Release();
+        _capture = {};
+        return;
+    }
+
+    result = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_capture.fence));
+    device->Release();
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateFence error: {:X}", (UINT) result);
+        _capture.fence = nullptr;
+        ReleaseCapture();
+        return;
+    }
+
+    _capture.width = (UINT) desc.Width;
+    _capture.format = desc.Format;
+
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = InOutput;
+    barrier.Transition.Subresource = 0;
+    barrier.Transition.StateBefore = InState;
+    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+
+    if (InState != D3D12_RESOURCE_STATE_COPY_SOURCE)
+        InCmdList->ResourceBarrier(1, &barrier);
+
+    D3D12_TEXTURE_COPY_LOCATION dstLocation = {};
+    dstLocation.pResource = _capture.buffer;
+    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    dstLocation.PlacedFootprint = _capture.footprint;
+
+    D3D12_TEXTURE_COPY_LOCATION srcLocation = {};
+    srcLocation.pResource = InOutput;
+    srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    srcLocation.SubresourceIndex = 0;
+
+    InCmdList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+
+    if (InState != D3D12_RESOURCE_STATE_COPY_SOURCE)
+    {
+        std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+        InCmdList->ResourceBarrier(1, &barrier);
+    }
+}
+
+bool Benchmark::ProcessCapture()
+{
+    std::lock_guard<std::mutex> lock(_captureMutex);
+
+    if (_captureDone)
+        return true;
+
+    if (_capture.buffer == nullptr)
+        return false;
+
+    // Called at present, command list with the copy is submitted by now
+    if (!_capture.signaled)
+    {
+        auto queue = ResTrack_Dx12::GetUpscalerQueue();
+
+        if (queue == nullptr && State::Instance().currentCommandQueue != nullptr)
+        {
+            queue = State::Instance().currentCommandQueue;
+            queue->AddRef();
+        }
+
+        if (queue == nullptr)
+            return false;
+
+        _capture.signaled = queue->Signal(_capture.fence, 1) == S_OK;
+        queue->Release();
+
+        return false;
+    }
+
+    if (_capture.fence->GetCompletedValue() < 1)
+        return false;
+
+    auto& run = _runs[_current];
+    auto fileName = RunName(run) + ".dds";
+
+    BYTE* data = nullptr;
+    D3D12_RANGE range = { 0, (SIZE_T) (_capture.footprint.Offset +
+                                       _capture.footprint.Footprint.RowPitch * (UINT64) _capture.rowCount) };
+
+    if (_capture.buffer->Map(0, &range, (void**) &data) == S_OK && data != nullptr)
+    {
+        if (WriteDds(_outputDir / fileName, _capture, data + _capture.footprint.Offset))
+            run.capture = fileName;
+
+        D3D12_RANGE writeRange = { 0, 0 };
+        _capture.buffer->Unmap(0, &writeRange);
+    }
+    else
+    {
+        LOG_ERROR("Can't map capture buffer");
+    }
+
+    ReleaseCapture();
+    _captureDone = true;
+
+    return true;
+}
+
+void Benchmark::ReleaseCapture()
+{
+    if (_capture.buffer != nullptr)
+        _capture.buffer->Release();
+
+    if (_capture.fence != nullptr)
+        _capture.fence->Release();
+
+    _capture = {};
+}
+
+// DDS with DX10 header so any DXGI format can be saved as is
+bool Benchmark::WriteDds(const std::filesystem::path& path, const PendingCapture& capture, const BYTE* data)
+{
+    std::ofstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+    {
+        LOG_ERROR("Can't open {}", path.string());
+        return false;
+    }
+
+    uint32_t header[32] = {};
+    header[0] = 0x20534444;                       // "DDS "
+    header[1] = 124;                              // header size
+    header[2] = 0x1 | 0x2 | 0x4 | 0x8 | 0x1000;   // caps, height, width, pitch, pixel format
+    header[3] = capture.rowCount;                 // height
+    header[4] = capture.width;                    // width
+    header[5] = (uint32_t) capture.rowSize;       // pitch
+    header[7] = 1;                                // mip count
+    header[19] = 32;                              // pixel format size
+    header[20] = 0x4;                             // fourcc
+    header[21] = 0x30315844;                      // "DX10"
+    header[27] = 0x1000;                          // texture
+
+    uint32_t dx10Header[5] = {};
+    dx10Header[0] = capture.format;
+    dx10Header[1] = 3; // texture 2D
+    dx10Header[3] = 1; // array size
+
+    file.write((const char*) header, sizeof(header));
+    file.write((const char*) dx10Header, sizeof(dx10Header));
+
+    for (UINT row = 0; row < capture.rowCount; row++)
+        file.write((const char*) (data + row * (UINT64) capture.footprint.Footprint.RowPitch), capture.rowSize);
+
+    return file.good();
+}
+
+void Benchmark::WriteReport()
+{
+    nlohmann::ordered_json report;
+
+    report["game"] = State::Instance().GameExe;
+    report["api"] = State::Instance().api == DX11 ? "dx11" : State::Instance().api == DX12 ? "dx12" : "vulkan";
+    report["input"] = State::Instance().currentInputApiName;
+    report["frames"] = Config::Instance()->BenchmarkFrames.value_or_default();
+    report["warmupFrames"] = Config::Instance()->BenchmarkWarmupFrames.value_or_default();
+
+    auto runs = nlohmann::ordered_json::array();
+
+    std::ofstream csv(_outputDir / "report.csv");
+    csv << "name,backend,ratio,feature,status,render_width,render_height,display_width,display_height,frames,"
+           "frame_avg_ms,frame_p50_ms,frame_p95_ms,frame_p99_ms,fps_avg,fps_1_low,upscale_avg_ms,upscale_p50_ms,"
+           "upscale_p95_ms,vram_delta_mb,capture\n";
+
+    for (auto& run : _runs)
+    {
+        auto frameAvg = Average(run.frameTimes);
+        auto frameP99 = Percentile(run.frameTimes, 99.0);
+        auto vramDeltaMb = run.vramDelta.has_value() ? run.vramDelta.value() / (1024.0 * 1024.0) : 0.0;
+
+        nlohmann::ordered_json item;
+        item["name"] = RunName(run);
+        item["backend"] = UpscalerCode(run.backend);
+        item["ratio"] = run.ratio;
+        item["feature"] = run.featureName;
+        item["status"] = run.status;
+        item["renderWidth"] = run.renderWidth;
+        item["renderHeight"] = run.renderHeight;
+        item["displayWidth"] = run.displayWidth;
+        item["displayHeight"] = run.displayHeight;
+        item["frames"] = run.frameTimes.size();
+        item["frameTime"] = { { "avg", frameAvg },
+                              { "p50", Percentile(run.frameTimes, 50.0) },
+                              { "p95", Percentile(run.frameTimes, 95.0) },
+                              { "p99", frameP99 } };
+        item["fps"] = { { "avg", frameAvg > 0.0 ? 1000.0 / frameAvg : 0.0 },
+                        { "low1", frameP99 > 0.0 ? 1000.0 / frameP99 : 0.0 } };
+        item["upscaleTime"] = { { "avg", Average(run.upscaleTimes) },
+                                { "p50", Percentile(run.upscaleTimes, 50.0) },
+                                { "p95", Percentile(run.upscaleTimes, 95.0) } };
+        item["vramDeltaMB"] = run.vramDelta.has_value() ? nlohmann::ordered_json(vramDeltaMb) : nullptr;
+        item["capture"] = run.capture;
+        runs.push_back(item);
+
+        csv << std::format("{},{},{:.3f},{},{},{},{},{},{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.2f},{:.2f},{:.4f},{:.4f},"
+                           "{:.4f},{:.1f},{}\n",
+                           RunName(run), UpscalerCode(run.backend), run.ratio, run.featureName, run.status,
+                           run.renderWidth, run.renderHeight, run.displayWidth, run.displayHeight,
+                           run.frameTimes.size(), frameAvg, Percentile(run.frameTimes, 50.0),
+                           Percentile(run.frameTimes, 95.0), frameP99, frameAvg > 0.0 ? 1000.0 / frameAvg : 0.0,
+                           frameP99 > 0.0 ? 1000.0 / frameP99 : 0.0, Average(run.upscaleTimes),
+                           Percentile(run.upscaleTimes, 50.0), Percentile(run.upscaleTimes, 95.0), vramDeltaMb,
+                           run.capture);
+    }
+
+    report["runs"] = runs;
+
+    std::ofstream json(_outputDir / "report.json");
+    json << report.dump(2);
+
+    LOG_INFO("Benchmark report saved to {}", _outputDir.string());
+}
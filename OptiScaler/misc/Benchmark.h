@@ -0,0 +1,101 @@
+#pragma once
+#include <pch.h>
+
+#include <upscalers/Upscaler.h>
+
+#include <d3d12.h>
+#include <atomic>
+#include <filesystem>
+
+typedef struct BenchmarkRun
+{
+    Upscaler backend = Upscaler::None;
+    float ratio = 0.0f; // 0 means no ratio override
+    std::string featureName;
+    std::string status = "pending";
+    uint32_t renderWidth = 0;
+    uint32_t renderHeight = 0;
+    uint32_t displayWidth = 0;
+    uint32_t displayHeight = 0;
+    std::vector<double> frameTimes;
+    std::vector<double> upscaleTimes;
+    std::optional<int64_t> vramDelta; // bytes, relative to usage before benchmark started
+    std::string capture;
+} benchmark_run;
+
+// Cycles configured backends and upscale ratios, measures each pair for a fixed number of frames
+// and writes report.json, report.csv and captured outputs to Benchmark/<date> next to OptiScaler
+class Benchmark
+{
+  private:
+    enum class Phase
+    {
+        Idle,
+        Switching,
+        Warmup,
+        Measure,
+        Capture
+    };
+
+    typedef struct PendingCapture
+    {
+        ID3D12Resource* buffer = nullptr;
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint {};
+        UINT64 rowSize = 0;
+        UINT rowCount = 0;
+        UINT width = 0;
+        DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+
+        // Signalled after the command list with the copy is executed, buffer is mapped after it completes
+        ID3D12Fence* fence = nullptr;
+        bool signaled = false;
+    } pending_capture;
+
+    inline static Phase _phase = Phase::Idle;
+    inline static std::vector<BenchmarkRun> _runs;
+    inline static size_t _current = 0;
+    inline static uint32_t _phaseFrames = 0;
+    inline static uint64_t _lastUpscaleCount = 0;
+    inline static Upscaler _initialBackend = Upscaler::None;
+    inline static std::optional<UINT64> _baseVram;
+    inline static std::filesystem::path _outputDir;
+    inline static std::string _statusText;
+
+    inline static std::atomic<float> _ratio = 0.0f;
+    inline static std::atomic<bool> _captureRequested = false;
+    inline static std::mutex _captureMutex;
+    inline static PendingCapture _capture;
+    inline static bool _captureDone = false;
+
+    static void SwitchBackend(Upscaler backend);
+    static bool IsSwitching();
+
+    static void StartRun();
+    static void FinishRun(std::string status);
+    static void Finish();
+
+    static bool ProcessCapture();
+    static void ReleaseCapture();
+    static bool WriteDds(const std::filesystem::path& path, const PendingCapture& capture, const BYTE* data);
+    static void WriteReport();
+
+  public:
+    // Backend selected for current api, DLSSD when game uses it
+    static Upscaler CurrentBackend();
+
+    static bool Start();
+    static void Stop();
+
+    // Called once per presented frame
+    static void Update(double frameTimeMs);
+
+    // Upscale ratio of the running pair, overrides other ratio settings
+    static std::optional<float> Ratio();
+    static bool IsRunning();
+    static std::string Status();
+
+    // Copies upscaler output to a readback buffer when benchmark asks for a capture
+    static bool CaptureRequested();
+    static void CaptureOutput(ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InOutput,
+                              D3D12_RESOURCE_STATES InState);
+};
@@ -0,0 +1,88 @@
+#include "RenderScale.h"
+
+#include <Util.h>
+#include <Config.h>
+#include <misc/Benchmark.h>
+
+void RenderScale::Present()
+{
+    auto now = Util::MillisecondsNow();
+    auto frameTimeMs = _lastPresentTime > 0.0 ? now - _lastPresentTime : 0.0;
+    _lastPresentTime = now;
+
+    if (!Config::Instance()->AutoRenderScaleEnabled.value_or_default())
+    {
+        _active = false;
+        _ratio = 0.0f;
+        _queriedRatio = 0.0f;
+        return;
+    }
+
+    // Controller works inside DLSS DRS range (0.5 - 1.0) unless limits are extended
+    auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
+    auto maxRatio = std::max(Config::Instance()->AutoRenderScaleMaxRatio.value_or_default(), sliderLimit);
+
+    if (!Config::Instance()->ExtendedLimits.value_or_default())
+        maxRatio = std::min(maxRatio, 2.0f);
+
+    if (!_active)
+    {
+        LOG_INFO("Auto render scale enabled, target: {:.2f} ms, max ratio: {:.2f}",
+                 Config::Instance()->AutoRenderScaleTarget.value_or_default(), maxRatio);
+
+        _controller.Reset(1.0f, 1.0f / maxRatio, 1.0f);
+        _ratio = 1.0f / _controller.Scale();
+        _active = true;
+        return;
+    }
+
+    _controller.SetLimits(1.0f / maxRatio, 1.0f);
+
+    // Game got the last ratio, frames from now on are measured against it
+    if (_controller.Pending() && _queriedRatio.load() == _ratio.load())
+    {
+        LOG_TRACE("Render scale {:.3f} applied", _controller.Scale());
+        _controller.Applied();
+    }
+
+    auto oldScale = _controller.Scale();
+    auto scale = _controller.Update(frameTimeMs, Config::Instance()->AutoRenderScaleTarget.value_or_default());
+
+    if (scale != oldScale)
+        LOG_TRACE("Render scale: {:.3f} -> {:.3f}", oldScale, scale);
+
+    _ratio = 1.0f / scale;
+}
+
+std::optional<float> RenderScale::QueryRatio()
+{
+    auto output = Ratio();
+
+    // Benchmark ratios are not controller's
+    if (output.has_value() && !Benchmark::Ratio().has_value())
+        _queriedRatio = output.value();
+
+    return output;
+}
+
+std::optional<float> RenderScale::Ratio()
+{
+    // Benchmark pairs use fixed ratios
+    if (auto benchmarkRatio = Benchmark::Ratio(); benchmarkRatio.has_value())
+        return benchmarkRatio;
+
+    std::optional<float> output;
+
+    if (auto ratio = _ratio.load(); ratio > 0.0f && Config::Instance()->AutoRenderScaleEnabled.value_or_default())
+        output = ratio;
+
+    return output;
+}
+
+bool RenderScale::IsActive() { return Ratio().has_value(); }
+
+bool RenderScale::WaitingForQuery()
+{
+    auto ratio = _ratio.load();
+    return ratio > 0.0f && _queriedRatio.load() != ratio;
+}
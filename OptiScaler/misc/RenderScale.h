@@ -0,0 +1,30 @@
+#pragma once
+#include <pch.h>
+
+#include "RenderScale_Common.h"
+
+#include <atomic>
+
+class RenderScale
+{
+  private:
+    inline static RenderScaleController _controller;
+    inline static std::atomic<float> _ratio = 0.0f;
+    inline static std::atomic<float> _queriedRatio = 0.0f;
+    inline static double _lastPresentTime = 0.0;
+    inline static bool _active = false;
+
+  public:
+    // Called from present hooks once per presented frame, interval includes frame limiter sleep
+    static void Present();
+
+    // Ratio for optimal settings queries, game gets the controller's ratio and it's counted as applied
+    static std::optional<float> QueryRatio();
+
+    // Upscale ratio (display / render) chosen by the controller when it's enabled
+    static std::optional<float> Ratio();
+    static bool IsActive();
+
+    // Controller waits for the game to query the last ratio
+    static bool WaitingForQuery();
+};
@@ -0,0 +1,88 @@
+#include "RenderScale_Common.h"
+
+#include <algorithm>
+#include <cmath>
+
+void RenderScaleController::Reset(float scale, float minScale, float maxScale)
+{
+    _minScale = std::min(minScale, maxScale);
+    _maxScale = maxScale;
+    _scale = std::clamp(scale, _minScale, _maxScale);
+    _smoothedMs = 0.0;
+    _integral = 0.0;
+    _settleFrames = 0;
+    _pending = true;
+}
+
+void RenderScaleController::SetLimits(float minScale, float maxScale)
+{
+    _minScale = std::min(minScale, maxScale);
+    _maxScale = maxScale;
+
+    auto scale = std::clamp(_scale, _minScale, _maxScale);
+
+    if (scale != _scale)
+    {
+        _scale = scale;
+        _pending = true;
+    }
+}
+
+void RenderScaleController::Applied()
+{
+    if (!_pending)
+        return;
+
+    // Frame times of the old resolution are dropped
+    _pending = false;
+    _smoothedMs = 0.0;
+    _settleFrames = SettleFrames;
+}
+
+float RenderScaleController::Update(double frameTimeMs, double targetMs)
+{
+    // Game is still rendering with an older scale, frame times don't tell anything about the current one
+    if (_pending || frameTimeMs <= 0.0 || targetMs <= 0.0)
+        return _scale;
+
+    // First frames after the query might still use the old resolution
+    if (_settleFrames > 0)
+    {
+        _settleFrames--;
+        return _scale;
+    }
+
+    if (_smoothedMs == 0.0)
+        _smoothedMs = frameTimeMs;
+    else
+        _smoothedMs += (frameTimeMs - _smoothedMs) * Smoothing;
+
+    // Positive when frames are slower than target
+    auto error = (_smoothedMs - targetMs) / targetMs;
+
+    if (std::abs(error) < DeadBand)
+    {
+        _integral *= 0.95;
+        return _scale;
+    }
+
+    auto predicted = _scale * std::sqrt(targetMs / _smoothedMs);
+    _integral = std::clamp(_integral - error * IntegralGain, -0.05, 0.05);
+
+    auto step = (predicted - _scale) * PredictionGain + _integral;
+    step = std::clamp(step, (double) -MaxStepDown, (double) MaxStepUp);
+
+    auto scale = std::clamp((float) (_scale + step), _minScale, _maxScale);
+
+    // Anti windup, limit is reached and more correction won't change anything
+    if (scale == _minScale || scale == _maxScale)
+        _integral = 0.0;
+
+    if (scale != _scale)
+    {
+        _scale = scale;
+        _pending = true;
+    }
+
+    return _scale;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+// Closed loop render scale controller, has no dependencies so it can be driven by recorded frame times.
+// Frame time is modeled as proportional to rendered pixel count (scale squared), the model's prediction is
+// blended with an integral term to correct for parts of the frame which don't scale with resolution.
+// A new scale only takes effect when the game queries optimal settings again, so after each change the
+// controller waits for Applied before it measures or changes anything else.
+class RenderScaleController
+{
+  private:
+    float _scale = 1.0f;
+    float _minScale = 0.5f;
+    float _maxScale = 1.0f;
+    double _smoothedMs = 0.0;
+    double _integral = 0.0;
+    uint32_t _settleFrames = 0;
+    bool _pending = true;
+
+  public:
+    // Relative frame time error which is ignored, prevents oscillation around target
+    float DeadBand = 0.05f;
+    float PredictionGain = 0.5f;
+    float IntegralGain = 0.01f;
+
+    // Limits of one step, lowering is faster to recover from spikes quickly
+    float MaxStepDown = 0.02f;
+    float MaxStepUp = 0.005f;
+
+    // Exponential moving average weight of new frame times
+    float Smoothing = 0.1f;
+
+    // Frames to wait after a change is applied, game needs a few frames to render with new resolution
+    uint32_t SettleFrames = 8;
+
+    // Starts pending, scale is not known to be used by the game yet
+    void Reset(float scale, float minScale, float maxScale);
+    void SetLimits(float minScale, float maxScale);
+
+    // Called once per presented frame, scale is only changed when the previous one is applied
+    float Update(double frameTimeMs, double targetMs);
+
+    // Game got the current scale from an optimal settings query
+    void Applied();
+
+    float Scale() const { return _scale; }
+    bool Pending() const { return _pending; }
+};
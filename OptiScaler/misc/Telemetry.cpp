@@ -0,0 +1,137 @@
+#include "Telemetry.h"
+#include "Benchmark.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+
+std::wstring Telemetry::MappingName() { return std::format(L"Local\\OptiScaler_Telemetry_{}", GetCurrentProcessId()); }
+
+bool Telemetry::Open()
+{
+    if (_header != nullptr)
+        return true;
+
+    if (_failed)
+        return false;
+
+    auto name = MappingName();
+
+    _mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD) TelemetryMappingSize,
+                                  name.c_str());
+
+    if (_mapping == nullptr)
+    {
+        LOG_ERROR("CreateFileMappingW error: {:X}", GetLastError());
+        _failed = true;
+        return false;
+    }
+
+    auto view = MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, TelemetryMappingSize);
+
+    if (view == nullptr)
+    {
+        LOG_ERROR("MapViewOfFile error: {:X}", GetLastError());
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+        _failed = true;
+        return false;
+    }
+
+    memset(view, 0, TelemetryMappingSize);
+
+    _header = (TelemetryHeader*) view;
+    TelemetryInitHeader(_header, GetCurrentProcessId());
+
+    LOG_INFO("Telemetry mapping {} is created", wstring_to_string(name));
+    return true;
+}
+
+void Telemetry::Fill(TelemetryRecord* OutRecord, double InFrameTimeMs)
+{
+    auto& state = State::Instance();
+
+    {
+        std::lock_guard<std::mutex> lock(state.frameTimeMutex);
+
+        if (state.upscaleTimeCount != _lastUpscaleCount && !state.upscaleTimes.empty())
+        {
+            _upscaleTimeMs = state.upscaleTimes.back();
+            _lastUpscaleCount = state.upscaleTimeCount;
+        }
+    }
+
+    OutRecord->timeMs = Util::MillisecondsNow();
+    OutRecord->frameTimeMs = InFrameTimeMs;
+    OutRecord->upscaleTimeMs = _upscaleTimeMs;
+    OutRecord->api = (uint32_t) state.api;
+    OutRecord->fgType = (uint32_t) state.activeFgType;
+
+    uint32_t flags = TF_None;
+
+    if (auto feature = state.currentFeature; feature != nullptr && !feature->IsFrozen())
+    {
+        flags |= TF_Upscaling;
+        OutRecord->renderWidth = feature->RenderWidth();
+        OutRecord->renderHeight = feature->RenderHeight();
+        OutRecord->outputWidth = feature->DisplayWidth();
+        OutRecord->outputHeight = feature->DisplayHeight();
+
+        strncpy_s(OutRecord->backend, UpscalerCode(Benchmark::CurrentBackend()), _TRUNCATE);
+    }
+
+    if (state.activeFgType == OptiFG)
+    {
+        if (state.currentFG != nullptr && state.currentFG->IsActive())
+        {
+            flags |= TF_FGActive;
+
+            if (state.currentFG->UsingHudless())
+                flags |= TF_FGHudless;
+        }
+        else if (state.currentVkFG != nullptr && state.currentVkFG->IsActive())
+        {
+            flags |= TF_FGActive;
+        }
+
+        if (Config::Instance()->FGHUDFix.value_or_default())
+            flags |= TF_FGHudfix;
+    }
+
+    OutRecord->flags = flags;
+}
+
+void Telemetry::Update(double frameTimeMs)
+{
+    if (!Config::Instance()->TelemetryEnabled.value_or_default())
+    {
+        Close();
+        return;
+    }
+
+    if (!Open())
+        return;
+
+    TelemetryRecord data {};
+    Fill(&data, frameTimeMs);
+
+    // Only writer of the mapping, readers never change it
+    TelemetryWriteRecord(_header, data);
+}
+
+void Telemetry::Close()
+{
+    if (_header != nullptr)
+    {
+        UnmapViewOfFile(_header);
+        _header = nullptr;
+    }
+
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+
+    _failed = false;
+}
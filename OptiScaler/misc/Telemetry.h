@@ -0,0 +1,29 @@
+#pragma once
+
+#include <pch.h>
+
+#include "TelemetryLayout.h"
+
+// Writes a record of runtime metrics for every presented frame to a named shared memory ring,
+// so external tools can collect them without the overlay. See TelemetryLayout.h for the layout.
+class Telemetry
+{
+  private:
+    inline static HANDLE _mapping = nullptr;
+    inline static TelemetryHeader* _header = nullptr;
+    inline static bool _failed = false;
+    inline static uint64_t _lastUpscaleCount = 0;
+    inline static double _upscaleTimeMs = 0.0;
+
+    static bool Open();
+    static void Fill(TelemetryRecord* OutRecord, double InFrameTimeMs);
+
+  public:
+    // Called once per presented frame
+    static void Update(double frameTimeMs);
+
+    static bool IsOpen() { return _header != nullptr; }
+    static std::wstring MappingName();
+
+    static void Close();
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Shared memory layout of OptiScaler telemetry, tools/telemetry_reader.py mirrors it.
+// Mapping is named Local\OptiScaler_Telemetry_<process id> and holds a header followed by a ring of records.
+//
+// Each record is guarded by its own sequence (seqlock), record of frame n is stored at n % recordCount:
+//  - sequence is 2n + 1 while it's written and 2n + 2 when it's done
+//  - reader copies the record and accepts it when sequence is 2n + 2 before and after the copy
+// Header's writeIndex is the number of finished records, it's increased after the record is done.
+//
+// Fields are only appended to the end of record (recordSize grows) and version is increased when
+// a field changes meaning, readers should check both.
+
+static constexpr uint32_t TelemetryMagic = 0x54504F54; // "TOPT"
+static constexpr uint32_t TelemetryVersion = 1;
+static constexpr uint32_t TelemetryRecordCount = 512;
+
+enum TelemetryFlags : uint32_t
+{
+    TF_None = 0,
+    TF_Upscaling = 1 << 0, // Upscaler feature exists and is not frozen
+    TF_FGActive = 1 << 1,  // OptiFG is generating frames
+    TF_FGHudless = 1 << 2, // OptiFG is using hudless of the frame
+    TF_FGHudfix = 1 << 3,  // Hudless is searched from game's resources
+};
+
+// Values of State API and FGType enums
+enum TelemetryApi : uint32_t
+{
+    TA_None = 0,
+    TA_Dx11 = 1,
+    TA_Dx12 = 2,
+    TA_Vulkan = 3,
+};
+
+struct TelemetryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint32_t processId;
+    uint64_t writeIndex;
+    uint8_t reserved[32];
+};
+
+struct TelemetryRecord
+{
+    uint64_t sequence;
+    uint64_t frame;
+    double timeMs;        // QueryPerformanceCounter time in ms
+    double frameTimeMs;   // present to present
+    double upscaleTimeMs; // last measured upscaler GPU time, 0 when not measured
+    uint32_t renderWidth;
+    uint32_t renderHeight;
+    uint32_t outputWidth;
+    uint32_t outputHeight;
+    uint32_t api;    // TelemetryApi
+    uint32_t fgType; // 0 = none, 1 = OptiFG, 2 = Nukem's DLSSG mod
+    uint32_t flags;  // TelemetryFlags
+    uint32_t reserved0;
+    char backend[16]; // upscaler code from ini like fsr31 or xess, zero terminated
+    uint8_t reserved[40];
+};
+
+static_assert(sizeof(TelemetryHeader) == 64, "Telemetry header layout is shared with readers");
+static_assert(sizeof(TelemetryRecord) == 128, "Telemetry record layout is shared with readers");
+static_assert(offsetof(TelemetryHeader, writeIndex) == 24);
+static_assert(offsetof(TelemetryRecord, renderWidth) == 40);
+static_assert(offsetof(TelemetryRecord, backend) == 72);
+
+static constexpr size_t TelemetryMappingSize = sizeof(TelemetryHeader) + sizeof(TelemetryRecord) * TelemetryRecordCount;
+
+inline TelemetryRecord* TelemetryRecords(TelemetryHeader* header)
+{
+    return (TelemetryRecord*) ((uint8_t*) header + sizeof(TelemetryHeader));
+}
+
+// View must be zeroed, magic is written last so readers ignore the mapping until header is complete
+inline void TelemetryInitHeader(TelemetryHeader* header, uint32_t processId)
+{
+    header->version = TelemetryVersion;
+    header->headerSize = sizeof(TelemetryHeader);
+    header->recordSize = sizeof(TelemetryRecord);
+    header->recordCount = TelemetryRecordCount;
+    header->processId = processId;
+
+    std::atomic_ref<uint32_t>(header->magic).store(TelemetryMagic, std::memory_order_release);
+}
+
+// Only one writer per mapping, data is stored as the next frame and its frame field is overwritten
+inline void TelemetryWriteRecord(TelemetryHeader* header, TelemetryRecord data)
+{
+    auto index = header->writeIndex;
+    auto record = &TelemetryRecords(header)[index % TelemetryRecordCount];
+    std::atomic_ref<uint64_t> sequence(record->sequence);
+
+    data.frame = index;
+
+    sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Everything after sequence
+    memcpy((uint8_t*) record + sizeof(uint64_t), (uint8_t*) &data + sizeof(uint64_t),
+           sizeof(TelemetryRecord) - sizeof(uint64_t));
+
+    sequence.store(index * 2 + 2, std::memory_order_release);
+    std::atomic_ref<uint64_t>(header->writeIndex).store(index + 1, std::memory_order_release);
+}
+
+// Number of finished records, 0 until the header is complete
+inline uint64_t TelemetryWriteIndex(TelemetryHeader* header)
+{
+    if (std::atomic_ref<uint32_t>(header->magic).load(std::memory_order_acquire) != TelemetryMagic)
+        return 0;
+
+    return std::atomic_ref<uint64_t>(header->writeIndex).load(std::memory_order_acquire);
+}
+
+// Returns false when record of the frame is being written or already overwritten by a newer frame
+inline bool TelemetryReadRecord(TelemetryHeader* header, uint64_t frame, TelemetryRecord* OutRecord)
+{
+    auto record = &TelemetryRecords(header)[frame % header->recordCount];
+    std::atomic_ref<uint64_t> sequence(record->sequence);
+    auto done = frame * 2 + 2;
+
+    if (sequence.load(std::memory_order_acquire) != done)
+        return false;
+
+    memcpy(OutRecord, record, sizeof(TelemetryRecord));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return sequence.load(std::memory_order_relaxed) == done && OutRecord->frame == frame;
+}
@@ -0,0 +1,245 @@
+#include "VramTracker.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+
+// Budget is polled at least this often even without driver notification
+static constexpr double BudgetQueryInterval = 1000.0;
+
+// Only used for Dx11 textures, Dx12 asks the device for the allocation size
+static uint32_t BytesPerPixel(DXGI_FORMAT format)
+{
+    if (format >= DXGI_FORMAT_R32G32B32A32_TYPELESS && format <= DXGI_FORMAT_R32G32B32A32_SINT)
+        return 16;
+
+    if (format >= DXGI_FORMAT_R32G32B32_TYPELESS && format <= DXGI_FORMAT_R32G32B32_SINT)
+        return 12;
+
+    if (format >= DXGI_FORMAT_R16G16B16A16_TYPELESS && format <= DXGI_FORMAT_X32_TYPELESS_G8X24_UINT)
+        return 8;
+
+    if (format >= DXGI_FORMAT_R8G8_TYPELESS && format <= DXGI_FORMAT_R16_SINT)
+        return 2;
+
+    if (format >= DXGI_FORMAT_R8_TYPELESS && format <= DXGI_FORMAT_A8_UNORM)
+        return 1;
+
+    return 4;
+}
+
+void WINAPI VramTracker::OnDestroyed(void* InData)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _accounting.Remove((uintptr_t) InData);
+}
+
+void VramTracker::Register(IUnknown* InObject, VramOwner InOwner, uint64_t InBytes)
+{
+    ID3DDestructionNotifier* notifier = nullptr;
+
+    // Without a notifier entry could outlive the resource and address can be reused
+    if (InObject->QueryInterface(IID_PPV_ARGS(&notifier)) != S_OK)
+    {
+        LOG_DEBUG("ID3DDestructionNotifier is not supported, {} is not tracked", VramOwnerName(InOwner));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _accounting.Add((uintptr_t) InObject, InOwner, InBytes);
+    }
+
+    UINT callbackId = 0;
+
+    if (notifier->RegisterDestructionCallback(OnDestroyed, InObject, &callbackId) != S_OK)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _accounting.Remove((uintptr_t) InObject);
+    }
+
+    notifier->Release();
+}
+
+void VramTracker::Track(ID3D12Resource* InResource, VramOwner InOwner)
+{
+    if (InResource == nullptr)
+        return;
+
+    ID3D12Device* device = nullptr;
+
+    if (InResource->GetDevice(IID_PPV_ARGS(&device)) != S_OK)
+        return;
+
+    auto desc = InResource->GetDesc();
+    auto info = device->GetResourceAllocationInfo(0, 1, &desc);
+    device->Release();
+
+    if (info.SizeInBytes == UINT64_MAX)
+        return;
+
+    Register(InResource, InOwner, info.SizeInBytes);
+}
+
+void VramTracker::Track(ID3D11Texture2D* InTexture, VramOwner InOwner)
+{
+    if (InTexture == nullptr)
+        return;
+
+    D3D11_TEXTURE2D_DESC desc {};
+    InTexture->GetDesc(&desc);
+
+    // First mip only, OptiScaler doesn't create mipmapped textures
+    auto bytes = (uint64_t) desc.Width * desc.Height * desc.ArraySize * BytesPerPixel(desc.Format);
+    Register(InTexture, InOwner, bytes);
+}
+
+bool VramTracker::UpdateAdapter()
+{
+    auto& state = State::Instance();
+    void* device = state.currentD3D12Device != nullptr ? (void*) state.currentD3D12Device
+                                                       : (void*) state.currentD3D11Device;
+
+    if (device == nullptr)
+        return false;
+
+    if (_adapter != nullptr && device == _adapterDevice)
+        return true;
+
+    ReleaseAdapter();
+
+    if (state.currentD3D12Device != nullptr)
+    {
+        IDXGIFactory4* factory = nullptr;
+
+        if (state.currentSwapchain == nullptr || state.currentSwapchain->GetParent(IID_PPV_ARGS(&factory)) != S_OK)
+            return false;
+
+        factory->EnumAdapterByLuid(state.currentD3D12Device->GetAdapterLuid(), IID_PPV_ARGS(&_adapter));
+        factory->Release();
+    }
+    else
+    {
+        IDXGIDevice* dxgiDevice = nullptr;
+
+        if (state.currentD3D11Device->QueryInterface(IID_PPV_ARGS(&dxgiDevice)) != S_OK)
+            return false;
+
+        IDXGIAdapter* dxgiAdapter = nullptr;
+
+        if (dxgiDevice->GetAdapter(&dxgiAdapter) == S_OK)
+        {
+            dxgiAdapter->QueryInterface(IID_PPV_ARGS(&_adapter));
+            dxgiAdapter->Release();
+        }
+
+        dxgiDevice->Release();
+    }
+
+    if (_adapter == nullptr)
+        return false;
+
+    _adapterDevice = device;
+    _budgetEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+    if (_budgetEvent != nullptr &&
+        _adapter->RegisterVideoMemoryBudgetChangeNotificationEvent(_budgetEvent, &_budgetCookie) != S_OK)
+    {
+        LOG_WARN("Can't register budget change notification, budget will be polled");
+        CloseHandle(_budgetEvent);
+        _budgetEvent = nullptr;
+    }
+
+    return true;
+}
+
+void VramTracker::ReleaseAdapter()
+{
+    if (_adapter == nullptr)
+        return;
+
+    if (_budgetEvent != nullptr)
+    {
+        _adapter->UnregisterVideoMemoryBudgetChangeNotification(_budgetCookie);
+        CloseHandle(_budgetEvent);
+        _budgetEvent = nullptr;
+    }
+
+    _adapter->Release();
+    _adapter = nullptr;
+    _adapterDevice = nullptr;
+}
+
+void VramTracker::Update()
+{
+    if (!UpdateAdapter())
+        return;
+
+    auto now = Util::MillisecondsNow();
+    auto signaled = _budgetEvent != nullptr && WaitForSingleObject(_budgetEvent, 0) == WAIT_OBJECT_0;
+
+    if (!signaled && now - _lastQuery < BudgetQueryInterval)
+        return;
+
+    _lastQuery = now;
+
+    DXGI_QUERY_VIDEO_MEMORY_INFO info {};
+
+    if (_adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info) != S_OK)
+        return;
+
+    _memoryInfo = info;
+
+    auto threshold = Config::Instance()->VramBudgetThreshold.value_or_default();
+    auto current = _pressure.load();
+    auto pressure = VramAccounting::Evaluate(info.CurrentUsage, info.Budget, threshold, current);
+
+    if (pressure != current)
+    {
+        LOG_INFO("VRAM pressure: {} -> {}, usage: {} MB, budget: {} MB, OptiScaler: {} MB", (UINT) current,
+                 (UINT) pressure, info.CurrentUsage / 1048576, info.Budget / 1048576, Total() / 1048576);
+        _pressure = pressure;
+    }
+}
+
+std::optional<UINT64> VramTracker::QueryUsage()
+{
+    std::optional<UINT64> output;
+
+    if (!UpdateAdapter())
+        return output;
+
+    DXGI_QUERY_VIDEO_MEMORY_INFO info {};
+
+    if (_adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info) == S_OK)
+        output = info.CurrentUsage;
+
+    return output;
+}
+
+VramPressure VramTracker::Pressure() { return _pressure.load(); }
+
+bool VramTracker::SaveMemory(VramPressure InLevel)
+{
+    return _pressure.load() >= InLevel && Config::Instance()->VramBudgetSaving.value_or_default();
+}
+
+uint64_t VramTracker::Total()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _accounting.Total();
+}
+
+uint64_t VramTracker::Total(VramOwner InOwner)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _accounting.Total(InOwner);
+}
+
+size_t VramTracker::Count()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _accounting.Count();
+}
+
+DXGI_QUERY_VIDEO_MEMORY_INFO VramTracker::MemoryInfo() { return _memoryInfo; }
@@ -0,0 +1,51 @@
+#pragma once
+#include <pch.h>
+
+#include "VramTracker_Common.h"
+
+#include <d3d11.h>
+#include <d3d12.h>
+#include <dxgi1_4.h>
+#include <atomic>
+
+// Tracks OptiScaler owned resources and the process VRAM budget
+// Resources are removed automatically when they are destroyed
+class VramTracker
+{
+  private:
+    inline static VramAccounting _accounting;
+    inline static std::mutex _mutex;
+
+    inline static std::atomic<VramPressure> _pressure = VramPressure::None;
+    inline static DXGI_QUERY_VIDEO_MEMORY_INFO _memoryInfo {};
+    inline static IDXGIAdapter3* _adapter = nullptr;
+    inline static void* _adapterDevice = nullptr;
+    inline static HANDLE _budgetEvent = nullptr;
+    inline static DWORD _budgetCookie = 0;
+    inline static double _lastQuery = 0.0;
+
+    static void WINAPI OnDestroyed(void* InData);
+    static void Register(IUnknown* InObject, VramOwner InOwner, uint64_t InBytes);
+    static bool UpdateAdapter();
+    static void ReleaseAdapter();
+
+  public:
+    static void Track(ID3D12Resource* InResource, VramOwner InOwner);
+    static void Track(ID3D11Texture2D* InTexture, VramOwner InOwner);
+
+    // Called once per presented frame, queries budget when driver signals a change or once a second
+    static void Update();
+
+    // Current local memory usage of the process
+    static std::optional<UINT64> QueryUsage();
+
+    static VramPressure Pressure();
+
+    // True when optional resources should not be created at given pressure
+    static bool SaveMemory(VramPressure InLevel = VramPressure::High);
+
+    static uint64_t Total();
+    static uint64_t Total(VramOwner InOwner);
+    static size_t Count();
+    static DXGI_QUERY_VIDEO_MEMORY_INFO MemoryInfo();
+};
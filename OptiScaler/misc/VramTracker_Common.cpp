@@ -0,0 +1,52 @@
+#include "VramTracker_Common.h"
+
+// Pressure is only lowered after usage drops this much (fraction of budget) below the limit
+static constexpr float PressureHysteresis = 0.05f;
+
+void VramAccounting::Add(uintptr_t key, VramOwner owner, uint64_t bytes)
+{
+    Remove(key);
+
+    _entries[key] = { owner, bytes };
+    _totals[(size_t) owner] += bytes;
+    _total += bytes;
+}
+
+bool VramAccounting::Remove(uintptr_t key)
+{
+    auto it = _entries.find(key);
+
+    if (it == _entries.end())
+        return false;
+
+    _totals[(size_t) it->second.owner] -= it->second.bytes;
+    _total -= it->second.bytes;
+    _entries.erase(it);
+
+    return true;
+}
+
+void VramAccounting::Clear()
+{
+    _entries.clear();
+    _total = 0;
+
+    for (auto& total : _totals)
+        total = 0;
+}
+
+VramPressure VramAccounting::Evaluate(uint64_t usage, uint64_t budget, float threshold, VramPressure current)
+{
+    if (budget == 0)
+        return VramPressure::None;
+
+    auto used = (double) usage / (double) budget;
+
+    if (used > 1.0 || (current == VramPressure::Critical && used > 1.0 - PressureHysteresis))
+        return VramPressure::Critical;
+
+    if (used > threshold || (current != VramPressure::None && used > threshold - PressureHysteresis))
+        return VramPressure::High;
+
+    return VramPressure::None;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+// Subsystems owning GPU resources created by OptiScaler
+enum class VramOwner : uint32_t
+{
+    FrameGen,
+    Hudfix,
+    ResourceTracking,
+    Inputs,
+    Shaders,
+    Dx11wDx12,
+    Overlay,
+    Count
+};
+
+inline const char* VramOwnerName(VramOwner owner)
+{
+    switch (owner)
+    {
+    case VramOwner::FrameGen:
+        return "Frame Generation";
+    case VramOwner::Hudfix:
+        return "Hudfix";
+    case VramOwner::ResourceTracking:
+        return "Resource Tracking";
+    case VramOwner::Inputs:
+        return "Upscaler Inputs";
+    case VramOwner::Shaders:
+        return "Shaders";
+    case VramOwner::Dx11wDx12:
+        return "Dx11 with Dx12";
+    case VramOwner::Overlay:
+        return "Overlay";
+    default:
+        return "Unknown";
+    }
+}
+
+enum class VramPressure : uint32_t
+{
+    None,
+    High,     // Usage is over threshold, optional copies are skipped
+    Critical, // Usage is over budget
+};
+
+// Per owner byte totals of tracked resources, key is the resource address
+class VramAccounting
+{
+  private:
+    typedef struct Entry
+    {
+        VramOwner owner = VramOwner::Count;
+        uint64_t bytes = 0;
+    } entry;
+
+    std::unordered_map<uintptr_t, Entry> _entries;
+    uint64_t _totals[(size_t) VramOwner::Count] = {};
+    uint64_t _total = 0;
+
+  public:
+    // Replaces previous entry of the same key
+    void Add(uintptr_t key, VramOwner owner, uint64_t bytes);
+    bool Remove(uintptr_t key);
+    void Clear();
+
+    uint64_t Total() const { return _total; }
+    uint64_t Total(VramOwner owner) const { return _totals[(size_t) owner]; }
+    size_t Count() const { return _entries.size(); }
+
+    // Hysteresis keeps the state from flipping every frame around the threshold
+    static VramPressure Evaluate(uint64_t usage, uint64_t budget, float threshold, VramPressure current);
+};
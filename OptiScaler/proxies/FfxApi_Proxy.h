@@ -6,6 +6,7 @@
 #include "Logger.h"
 
 #include <proxies/KernelBase_Proxy.h>
+#include <misc/BackendPreloader.h>
 
 #include <inputs/FfxApi_Dx12.h>
 #include <inputs/FfxApi_Vk.h>
@@ -61,6 +62,19 @@ class FfxApiProxy
 
         spdlog::info("");
 
+        // Game's own copy wins over the preloaded one
+        if (module == nullptr && _dllDx12 == nullptr)
+        {
+            module = GetModuleHandle(L"amd_fidelityfx_dx12.dll");
+
+            if (module == nullptr)
+                module = GetModuleHandle(L"amd_fidelityfx_loader_dx12.dll");
+        }
+
+        // Already loaded and checked after attach
+        if (module == nullptr && _dllDx12 == nullptr)
+            module = BackendPreloader::Module(PreloadLibrary::FfxDx12);
+
         if (module != nullptr)
             _dllDx12 = module;
 
@@ -214,6 +228,14 @@ class FfxApiProxy
 
         LOG_DEBUG("Loading amd_fidelityfx_vk.dll methods");
 
+        // Game's own copy wins over the preloaded one
+        if (module == nullptr && _dllVk == nullptr)
+            module = GetModuleHandle(L"amd_fidelityfx_vk.dll");
+
+        // Already loaded and checked after attach
+        if (module == nullptr && _dllVk == nullptr)
+            module = BackendPreloader::Module(PreloadLibrary::FfxVk);
+
         if (module != nullptr)
             _dllVk = module;
 
@@ -6,6 +6,7 @@
 #include "Logger.h"
 
 #include <proxies/KernelBase_Proxy.h>
+#include <misc/BackendPreloader.h>
 
 #include <inputs/XeSS_Common.h>
 #include <inputs/XeSS_Dx12.h>
@@ -236,13 +237,23 @@ class XeSSProxy
 
         HMODULE mainModule = nullptr;
 
+        // Game's own copy wins over the preloaded one
         mainModule = GetModuleHandle(L"libxess.dll");
         if (mainModule != nullptr)
         {
+            // Preloader doesn't go through load hooks, its module is not hooked yet
+            if (mainModule == BackendPreloader::Module(PreloadLibrary::XeSS))
+                return HookXeSS(mainModule);
+
             _dll = mainModule;
             return true;
         }
 
+        // Already loaded and checked after attach
+        mainModule = BackendPreloader::Module(PreloadLibrary::XeSS);
+        if (mainModule != nullptr)
+            return HookXeSS(mainModule);
+
         auto dllPath = Util::DllPath();
 
         std::wstring libraryName;
@@ -286,6 +297,11 @@ class XeSSProxy
                 break;
             }
 
+            // Already loaded and checked after attach
+            dx11Module = BackendPreloader::Module(PreloadLibrary::XeSSDx11);
+            if (dx11Module != nullptr)
+                break;
+
             auto dllPath = Util::DllPath();
 
             std::wstring libraryName;
@@ -0,0 +1,51 @@
+#include "FGHazard_Common.h"
+
+void HazardLearner::Restore(std::optional<bool> hazard)
+{
+    _cleanFrames = 0;
+
+    if (_forced || (hazard.has_value() && hazard.value()))
+        _state = HazardState::Hazard;
+    else
+        _state = HazardState::Learning;
+}
+
+bool HazardLearner::Observe(bool written)
+{
+    if (_state == HazardState::Hazard)
+        return false;
+
+    if (written)
+    {
+        _state = HazardState::Hazard;
+        _cleanFrames = 0;
+        return true;
+    }
+
+    if (_state == HazardState::Safe)
+        return false;
+
+    if (++_cleanFrames < _requiredFrames)
+        return false;
+
+    _state = HazardState::Safe;
+    return true;
+}
+
+bool HazardLearner::ForceHazard()
+{
+    _forced = true;
+    _cleanFrames = 0;
+
+    if (_state == HazardState::Hazard)
+        return false;
+
+    _state = HazardState::Hazard;
+    return true;
+}
+
+void HazardLearner::Reset()
+{
+    _state = _forced ? HazardState::Hazard : HazardState::Learning;
+    _cleanFrames = 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+// Game resources which FG might use directly instead of a copy
+enum class FGInput : uint32_t
+{
+    Velocity,
+    Depth,
+    Hudless,
+    Count
+};
+
+enum class HazardState : uint32_t
+{
+    Learning, // Copy is made, source is watched for writes
+    Safe,     // No writes seen, copy is skipped but source is still watched
+    Hazard    // Source is written before FG uses it, copy is always made
+};
+
+// Decides if an input needs a copy from the observed capture -> FG windows
+class HazardLearner
+{
+  private:
+    HazardState _state = HazardState::Learning;
+    uint32_t _cleanFrames = 0;
+    uint32_t _requiredFrames = 0;
+    bool _forced = false;
+
+  public:
+    // Learned value from config, true means input was written before FG
+    // Only a hazard is trusted, a game update might add writes so safe inputs are learned again
+    void Restore(std::optional<bool> hazard);
+
+    // Result of a closed window, returns true when state is changed
+    bool Observe(bool written);
+
+    // Writes can't be observed anymore, input stays a hazard even after Reset & Restore
+    // Returns true when state is changed
+    bool ForceHazard();
+
+    void Reset();
+
+    bool NeedsCopy() const { return _state != HazardState::Safe; }
+    HazardState State() const { return _state; }
+    uint32_t CleanFrames() const { return _cleanFrames; }
+    uint32_t RequiredFrames() const { return _requiredFrames; }
+    bool Forced() const { return _forced; }
+
+    explicit HazardLearner(uint32_t requiredFrames) : _requiredFrames(requiredFrames) {}
+};
@@ -0,0 +1,329 @@
+#include "FGHazard_Dx12.h"
+
+#include <Config.h>
+
+// Sources in these states can be written without a barrier, they are always copied
+static constexpr D3D12_RESOURCE_STATES WriteStates =
+    D3D12_RESOURCE_STATE_RENDER_TARGET | D3D12_RESOURCE_STATE_UNORDERED_ACCESS | D3D12_RESOURCE_STATE_DEPTH_WRITE |
+    D3D12_RESOURCE_STATE_STREAM_OUT | D3D12_RESOURCE_STATE_COPY_DEST | D3D12_RESOURCE_STATE_RESOLVE_DEST;
+
+static const char* InputName(FGInput input)
+{
+    switch (input)
+    {
+    case FGInput::Velocity:
+        return "Velocity";
+    case FGInput::Depth:
+        return "Depth";
+    case FGInput::Hudless:
+        return "Hudless";
+    default:
+        return "Unknown";
+    }
+}
+
+static CustomOptional<bool, NoDefault>* LearnedValue(FGInput input)
+{
+    switch (input)
+    {
+    case FGInput::Velocity:
+        return &Config::Instance()->FGMVHazard;
+    case FGInput::Depth:
+        return &Config::Instance()->FGDepthHazard;
+    case FGInput::Hudless:
+        return &Config::Instance()->FGHudlessHazard;
+    default:
+        return nullptr;
+    }
+}
+
+void FGHazard_Dx12::RestoreFromConfig()
+{
+    if (_restored)
+        return;
+
+    for (uint32_t i = 0; i < (uint32_t) FGInput::Count; i++)
+    {
+        auto value = LearnedValue((FGInput) i);
+
+        if (value != nullptr && value->has_value())
+        {
+            _learners[i].Restore(value->value());
+
+            if (value->value())
+                LOG_INFO("{} copy learned as needed", InputName((FGInput) i));
+            else
+                LOG_INFO("{} copy learned as not needed before, learning again", InputName((FGInput) i));
+        }
+    }
+
+    _restored = true;
+}
+
+void FGHazard_Dx12::ApplyEnhancedBarriers()
+{
+    if (!_enhancedBarriers.load(std::memory_order_relaxed))
+        return;
+
+    for (uint32_t i = 0; i < (uint32_t) FGInput::Count; i++)
+    {
+        if (_learners[i].Forced())
+            continue;
+
+        if (_learners[i].ForceHazard())
+            LOG_INFO("{} can't be watched with enhanced barriers, copying from now on", InputName((FGInput) i));
+
+        SaveToConfig((FGInput) i);
+    }
+}
+
+void FGHazard_Dx12::SaveToConfig(FGInput InInput)
+{
+    auto value = LearnedValue(InInput);
+    auto state = _learners[(uint32_t) InInput].State();
+
+    if (value == nullptr || state == HazardState::Learning)
+        return;
+
+    *value = state == HazardState::Hazard;
+}
+
+void FGHazard_Dx12::CloseWatch(Watch* InWatch, FGInput InInput, bool InLearn)
+{
+    if (InWatch->resource.load(std::memory_order_relaxed) == nullptr)
+        return;
+
+    if (InLearn)
+    {
+        auto& learner = _learners[(uint32_t) InInput];
+        auto wasSafe = learner.State() == HazardState::Safe;
+
+        if (learner.Observe(InWatch->written.load(std::memory_order_acquire)))
+        {
+            if (learner.State() == HazardState::Hazard)
+            {
+                if (wasSafe)
+                    LOG_WARN("{} is written before FG used it, copying from now on", InputName(InInput));
+                else
+                    LOG_INFO("{} is written before FG, copy is needed", InputName(InInput));
+            }
+            else
+            {
+                LOG_INFO("{} is not written in {} frames, skipping copy", InputName(InInput),
+                         learner.RequiredFrames());
+            }
+
+            SaveToConfig(InInput);
+        }
+    }
+
+    InWatch->resource.store(nullptr, std::memory_order_release);
+    InWatch->written.store(false, std::memory_order_relaxed);
+    _watchCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+uint64_t FGHazard_Dx12::ResourceSize(FGInput InInput, ID3D12Resource* InResource)
+{
+    auto index = (uint32_t) InInput;
+
+    if (_sizeResource[index] == InResource)
+        return _sizeBytes[index];
+
+    ID3D12Device* device = nullptr;
+    _sizeBytes[index] = 0;
+
+    if (InResource->GetDevice(IID_PPV_ARGS(&device)) == S_OK)
+    {
+        auto desc = InResource->GetDesc();
+        _sizeBytes[index] = device->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+        device->Release();
+    }
+
+    _sizeResource[index] = InResource;
+    return _sizeBytes[index];
+}
+
+bool FGHazard_Dx12::NeedsCopy(FGInput InInput, UINT64 InFrameId, ID3D12Resource* InResource,
+                              D3D12_RESOURCE_STATES InState)
+{
+    if (InResource == nullptr || !Config::Instance()->FGHazardTracking.value_or_default())
+        return true;
+
+    // Common state decays and promotes implicitly, simultaneous access textures can be written without
+    // a barrier and a writable state doesn't need one. Writes of these sources can't be observed.
+    if (InState == D3D12_RESOURCE_STATE_COMMON || (InState & WriteStates) != 0 ||
+        (InResource->GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_SIMULTANEOUS_ACCESS) != 0)
+    {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    RestoreFromConfig();
+    ApplyEnhancedBarriers();
+
+    auto& learner = _learners[(uint32_t) InInput];
+
+    if (learner.State() == HazardState::Hazard)
+        return true;
+
+    // Windows of frames which never reached FG are dropped without learning
+    for (auto& slot : _watches)
+    {
+        auto watch = &slot[(uint32_t) InInput];
+
+        if (watch->resource.load(std::memory_order_relaxed) != nullptr && watch->frameId + 1 < InFrameId)
+            CloseWatch(watch, InInput, false);
+    }
+
+    auto watch = &_watches[InFrameId % BUFFER_COUNT][(uint32_t) InInput];
+    CloseWatch(watch, InInput, false);
+
+    watch->frameId = InFrameId;
+    watch->written.store(false, std::memory_order_relaxed);
+    watch->resource.store(InResource, std::memory_order_release);
+    _watchCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (learner.NeedsCopy())
+        return true;
+
+    _savedBytes[(uint32_t) InInput].fetch_add(ResourceSize(InInput, InResource), std::memory_order_relaxed);
+    return false;
+}
+
+void FGHazard_Dx12::CheckBarriers(UINT InNumBarriers, const D3D12_RESOURCE_BARRIER* InBarriers)
+{
+    if (InBarriers == nullptr || InNumBarriers == 0)
+        return;
+
+    // Snapshot of watched pointers, barriers are checked against it without taking the lock
+    ID3D12Resource* watched[BUFFER_COUNT][(size_t) FGInput::Count] = {};
+    auto any = false;
+
+    for (size_t s = 0; s < BUFFER_COUNT; s++)
+    {
+        for (size_t i = 0; i < (size_t) FGInput::Count; i++)
+        {
+            auto& watch = _watches[s][i];
+
+            if (!watch.written.load(std::memory_order_relaxed))
+                watched[s][i] = watch.resource.load(std::memory_order_acquire);
+
+            any |= watched[s][i] != nullptr;
+        }
+    }
+
+    if (!any)
+        return;
+
+    for (UINT b = 0; b < InNumBarriers; b++)
+    {
+        auto& barrier = InBarriers[b];
+        ID3D12Resource* first = nullptr;
+        ID3D12Resource* second = nullptr;
+
+        switch (barrier.Type)
+        {
+        case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+            first = barrier.Transition.pResource;
+            break;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+            first = barrier.Aliasing.pResourceBefore;
+            second = barrier.Aliasing.pResourceAfter;
+            break;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+            first = barrier.UAV.pResource;
+            break;
+        }
+
+        if (first == nullptr && second == nullptr)
+            continue;
+
+        for (size_t s = 0; s < BUFFER_COUNT; s++)
+        {
+            for (size_t i = 0; i < (size_t) FGInput::Count; i++)
+            {
+                if (watched[s][i] == nullptr || (watched[s][i] != first && watched[s][i] != second))
+                    continue;
+
+                if (!_watches[s][i].written.exchange(true, std::memory_order_acq_rel))
+                    LOG_DEBUG("Watched resource {:X} changed by a barrier", (size_t) watched[s][i]);
+
+                watched[s][i] = nullptr;
+            }
+        }
+    }
+}
+
+void FGHazard_Dx12::EnhancedBarrier()
+{
+    if (_enhancedBarriers.exchange(true, std::memory_order_relaxed))
+        return;
+
+    LOG_INFO("Game uses enhanced barriers, FG inputs are always copied");
+
+    // Open windows might have skipped copies already, they are closed as written
+    for (auto& slot : _watches)
+    {
+        for (auto& watch : slot)
+            watch.written.store(true, std::memory_order_release);
+    }
+}
+
+void FGHazard_Dx12::FrameDone(UINT64 InFrameId)
+{
+    if (!IsWatching())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto slot = _watches[InFrameId % BUFFER_COUNT];
+
+    for (uint32_t i = 0; i < (uint32_t) FGInput::Count; i++)
+    {
+        if (slot[i].resource.load(std::memory_order_relaxed) != nullptr && slot[i].frameId == InFrameId)
+            CloseWatch(&slot[i], (FGInput) i, true);
+    }
+}
+
+void FGHazard_Dx12::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (uint32_t i = 0; i < (uint32_t) FGInput::Count; i++)
+    {
+        for (auto& slot : _watches)
+            CloseWatch(&slot[i], (FGInput) i, false);
+
+        _learners[i].Reset();
+        _savedBytes[i] = 0;
+
+        if (auto value = LearnedValue((FGInput) i); value != nullptr)
+            *value = std::nullopt;
+    }
+
+    _restored = true;
+}
+
+HazardState FGHazard_Dx12::State(FGInput InInput)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    RestoreFromConfig();
+    ApplyEnhancedBarriers();
+    return _learners[(uint32_t) InInput].State();
+}
+
+uint32_t FGHazard_Dx12::CleanFrames(FGInput InInput)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _learners[(uint32_t) InInput].CleanFrames();
+}
+
+uint32_t FGHazard_Dx12::RequiredFrames(FGInput InInput) { return _learners[(uint32_t) InInput].RequiredFrames(); }
+
+uint64_t FGHazard_Dx12::SavedBytes(FGInput InInput)
+{
+    return _savedBytes[(uint32_t) InInput].load(std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <pch.h>
+
+#include "FGHazard_Common.h"
+
+#include <d3d12.h>
+
+#include <atomic>
+#include <mutex>
+
+// Watches captured FG inputs with game's resource barriers until FG command list of the frame is submitted.
+// Any transition, UAV or aliasing barrier of the source is a hazard. When copy is skipped FG uses the source
+// with its captured state, so even a transition to another read state would break it.
+class FGHazard_Dx12
+{
+  private:
+    // Barrier hooks read these without the lock, a slot reused meanwhile can only get a false hazard
+    typedef struct Watch
+    {
+        std::atomic<ID3D12Resource*> resource { nullptr };
+        std::atomic<bool> written { false };
+        UINT64 frameId = 0;
+    } watch;
+
+    inline static std::mutex _mutex;
+    inline static std::atomic<uint32_t> _watchCount = 0;
+
+    inline static Watch _watches[BUFFER_COUNT][(size_t) FGInput::Count];
+    inline static HazardLearner _learners[(size_t) FGInput::Count] = { HazardLearner(300), HazardLearner(300),
+                                                                       HazardLearner(300) };
+    inline static bool _restored = false;
+
+    // Enhanced barriers are not checked, once game uses them every input is copied
+    inline static std::atomic<bool> _enhancedBarriers = false;
+
+    inline static ID3D12Resource* _sizeResource[(size_t) FGInput::Count] = {};
+    inline static uint64_t _sizeBytes[(size_t) FGInput::Count] = {};
+    inline static std::atomic<uint64_t> _savedBytes[(size_t) FGInput::Count] = {};
+
+    static void RestoreFromConfig();
+    static void ApplyEnhancedBarriers();
+    static void SaveToConfig(FGInput InInput);
+    static void CloseWatch(Watch* InWatch, FGInput InInput, bool InLearn);
+    static uint64_t ResourceSize(FGInput InInput, ID3D12Resource* InResource);
+
+  public:
+    // Decides if input of the frame should be copied, source is watched while tracking is enabled
+    static bool NeedsCopy(FGInput InInput, UINT64 InFrameId, ID3D12Resource* InResource,
+                          D3D12_RESOURCE_STATES InState);
+
+    static bool IsWatching() { return _watchCount.load(std::memory_order_relaxed) > 0; }
+
+    // Called from ResourceBarrier hook, doesn't lock
+    static void CheckBarriers(UINT InNumBarriers, const D3D12_RESOURCE_BARRIER* InBarriers);
+
+    // Called from ID3D12GraphicsCommandList7::Barrier hook, doesn't lock
+    static void EnhancedBarrier();
+
+    // FG command list of the frame is submitted, later writes can't affect its inputs
+    static void FrameDone(UINT64 InFrameId);
+
+    // Drops learned states of this game
+    static void Reset();
+
+    static HazardState State(FGInput InInput);
+    static uint32_t CleanFrames(FGInput InInput);
+    static uint32_t RequiredFrames(FGInput InInput);
+    static uint64_t SavedBytes(FGInput InInput);
+};
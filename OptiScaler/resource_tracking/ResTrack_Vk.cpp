@@ -0,0 +1,782 @@
+#include "ResTrack_Vk.h"
+
+#include <Config.h>
+#include <State.h>
+
+#include <hooks/HookRegistry.h>
+
+#include <shared_mutex>
+
+// Original method calls for device
+static PFN_vkCreateImage o_vkCreateImage = nullptr;
+static PFN_vkDestroyImage o_vkDestroyImage = nullptr;
+static PFN_vkCreateImageView o_vkCreateImageView = nullptr;
+static PFN_vkDestroyImageView o_vkDestroyImageView = nullptr;
+static PFN_vkCreateFramebuffer o_vkCreateFramebuffer = nullptr;
+static PFN_vkDestroyFramebuffer o_vkDestroyFramebuffer = nullptr;
+static PFN_vkCreateDescriptorUpdateTemplate o_vkCreateDescriptorUpdateTemplate = nullptr;
+static PFN_vkDestroyDescriptorUpdateTemplate o_vkDestroyDescriptorUpdateTemplate = nullptr;
+static PFN_vkCreateDescriptorSetLayout o_vkCreateDescriptorSetLayout = nullptr;
+static PFN_vkDestroyDescriptorSetLayout o_vkDestroyDescriptorSetLayout = nullptr;
+static PFN_vkAllocateDescriptorSets o_vkAllocateDescriptorSets = nullptr;
+static PFN_vkFreeDescriptorSets o_vkFreeDescriptorSets = nullptr;
+static PFN_vkResetDescriptorPool o_vkResetDescriptorPool = nullptr;
+static PFN_vkDestroyDescriptorPool o_vkDestroyDescriptorPool = nullptr;
+static PFN_vkUpdateDescriptorSets o_vkUpdateDescriptorSets = nullptr;
+static PFN_vkUpdateDescriptorSetWithTemplate o_vkUpdateDescriptorSetWithTemplate = nullptr;
+
+// Original method calls for command buffer
+static PFN_vkCmdBindDescriptorSets o_vkCmdBindDescriptorSets = nullptr;
+static PFN_vkCmdBeginRenderPass o_vkCmdBeginRenderPass = nullptr;
+static PFN_vkCmdEndRenderPass o_vkCmdEndRenderPass = nullptr;
+static PFN_vkCmdBeginRendering o_vkCmdBeginRendering = nullptr;
+static PFN_vkCmdBeginRendering o_vkCmdBeginRenderingKHR = nullptr;
+static PFN_vkCmdEndRendering o_vkCmdEndRendering = nullptr;
+static PFN_vkCmdEndRendering o_vkCmdEndRenderingKHR = nullptr;
+static PFN_vkCmdDraw o_vkCmdDraw = nullptr;
+static PFN_vkCmdDrawIndexed o_vkCmdDrawIndexed = nullptr;
+static PFN_vkCmdDispatch o_vkCmdDispatch = nullptr;
+
+// Tracked objects, only images which can be a hudless candidate are stored
+static ankerl::unordered_dense::map<VkImage, ImageInfo> _images;
+static ankerl::unordered_dense::map<VkImageView, VkImage> _views;
+static ankerl::unordered_dense::map<VkFramebuffer, std::vector<VkImageView>> _framebuffers;
+static ankerl::unordered_dense::map<VkDescriptorUpdateTemplate, std::vector<TemplateImageEntry>> _templates;
+static std::shared_mutex _objectMutex;
+
+// Descriptor sets, their pools & set layouts
+static DescriptorSetTracker _descriptorSets;
+static std::shared_mutex _setMutex;
+
+static ankerl::unordered_dense::map<VkCommandBuffer, CommandBufferHudless> _possibleHudless[BUFFER_COUNT];
+static std::mutex _hudlessMutex;
+
+#pragma region Helpers
+
+bool ResTrack_Vk::IsTrackedDescriptorType(VkDescriptorType type)
+{
+    return type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE || type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER ||
+           type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE || type == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+}
+
+bool ResTrack_Vk::GetImageInfo(VkImageView view, VkImageLayout layout, ImageInfo* info)
+{
+    std::shared_lock<std::shared_mutex> lock(_objectMutex);
+
+    auto viewIt = _views.find(view);
+    if (viewIt == _views.end())
+        return false;
+
+    auto imageIt = _images.find(viewIt->second);
+    if (imageIt == _images.end())
+        return false;
+
+    *info = imageIt->second;
+    info->view = view;
+    info->layout = layout;
+
+    return true;
+}
+
+bool ResTrack_Vk::IsCommandTrackingActive()
+{
+    return _commandHooksActive.load(std::memory_order_relaxed) && Hudfix_Vk::IsResourceCheckActive();
+}
+
+DescriptorWrite ResTrack_Vk::GetDescriptorWrite(VkImageView view, VkImageLayout layout)
+{
+    DescriptorWrite write { (VkHandleValue) view, (uint32_t) layout, false };
+
+    if (view != VK_NULL_HANDLE)
+    {
+        std::shared_lock<std::shared_mutex> lock(_objectMutex);
+        write.tracked = _views.contains(view);
+    }
+
+    return write;
+}
+
+void ResTrack_Vk::AddPossibleHudless(VkCommandBuffer cmdBuffer, VkImageView view, VkImageLayout layout)
+{
+    ImageInfo info {};
+    if (!GetImageInfo(view, layout, &info))
+        return;
+
+    // Filter early, keeps the lists short
+    if (!Hudfix_Vk::CheckResource(&info))
+        return;
+
+    auto fIndex = Hudfix_Vk::ActivePresentFrame() % BUFFER_COUNT;
+
+    std::lock_guard<std::mutex> lock(_hudlessMutex);
+    _possibleHudless[fIndex][cmdBuffer].bound.insert_or_assign(info.image, info);
+}
+
+void ResTrack_Vk::MarkDrawn(VkCommandBuffer cmdBuffer)
+{
+    auto fIndex = Hudfix_Vk::ActivePresentFrame() % BUFFER_COUNT;
+
+    std::lock_guard<std::mutex> lock(_hudlessMutex);
+
+    auto it = _possibleHudless[fIndex].find(cmdBuffer);
+    if (it == _possibleHudless[fIndex].end() || it->second.bound.size() == 0)
+        return;
+
+    for (auto& [key, val] : it->second.bound)
+        it->second.drawn.insert_or_assign(key, val);
+
+    it->second.bound.clear();
+}
+
+void ResTrack_Vk::CheckPossibleHudless(std::string callerName, VkCommandBuffer cmdBuffer, bool drawn)
+{
+    auto fIndex = Hudfix_Vk::ActivePresentFrame() % BUFFER_COUNT;
+
+    ankerl::unordered_dense::map<VkImage, ImageInfo> candidates;
+
+    {
+        std::lock_guard<std::mutex> lock(_hudlessMutex);
+
+        auto it = _possibleHudless[fIndex].find(cmdBuffer);
+        if (it == _possibleHudless[fIndex].end())
+            return;
+
+        if (drawn)
+            candidates = std::move(it->second.drawn);
+        else
+            candidates = std::move(it->second.bound);
+
+        it->second.drawn.clear();
+        it->second.bound.clear();
+    }
+
+    // Capture is recorded by the callback, this must be outside of the render pass
+    for (auto& [key, val] : candidates)
+    {
+        if (Hudfix_Vk::CheckForHudless(callerName, cmdBuffer, &val))
+            break;
+    }
+}
+
+#pragma endregion
+
+#pragma region Object hooks
+
+VkResult ResTrack_Vk::hkCreateImage(VkDevice device, const VkImageCreateInfo* pCreateInfo,
+                                    const VkAllocationCallbacks* pAllocator, VkImage* pImage)
+{
+    auto result = o_vkCreateImage(device, pCreateInfo, pAllocator, pImage);
+
+    if (result != VK_SUCCESS || pCreateInfo == nullptr || pCreateInfo->imageType != VK_IMAGE_TYPE_2D ||
+        pCreateInfo->samples != VK_SAMPLE_COUNT_1_BIT)
+    {
+        return result;
+    }
+
+    if ((pCreateInfo->usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) > 0 ||
+        (pCreateInfo->usage & (VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT |
+                               VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)) == 0)
+    {
+        return result;
+    }
+
+    ImageInfo info {};
+    info.image = *pImage;
+    info.width = pCreateInfo->extent.width;
+    info.height = pCreateInfo->extent.height;
+    info.format = pCreateInfo->format;
+    info.usage = pCreateInfo->usage;
+
+    std::unique_lock<std::shared_mutex> lock(_objectMutex);
+    _images.insert_or_assign(*pImage, info);
+
+    return result;
+}
+
+void ResTrack_Vk::hkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator)
+{
+    if (image != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::shared_mutex> lock(_objectMutex);
+        _images.erase(image);
+    }
+
+    o_vkDestroyImage(device, image, pAllocator);
+}
+
+VkResult ResTrack_Vk::hkCreateImageView(VkDevice device, const VkImageViewCreateInfo* pCreateInfo,
+                                        const VkAllocationCallbacks* pAllocator, VkImageView* pView)
+{
+    auto result = o_vkCreateImageView(device, pCreateInfo, pAllocator, pView);
+
+    if (result != VK_SUCCESS || pCreateInfo == nullptr || pCreateInfo->viewType != VK_IMAGE_VIEW_TYPE_2D ||
+        (pCreateInfo->subresourceRange.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) == 0)
+    {
+        return result;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_objectMutex);
+
+    if (_images.contains(pCreateInfo->image))
+        _views.insert_or_assign(*pView, pCreateInfo->image);
+
+    return result;
+}
+
+void ResTrack_Vk::hkDestroyImageView(VkDevice device, VkImageView imageView, const VkAllocationCallbacks* pAllocator)
+{
+    if (imageView != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::shared_mutex> lock(_objectMutex);
+        _views.erase(imageView);
+    }
+
+    o_vkDestroyImageView(device, imageView, pAllocator);
+}
+
+VkResult ResTrack_Vk::hkCreateFramebuffer(VkDevice device, const VkFramebufferCreateInfo* pCreateInfo,
+                                          const VkAllocationCallbacks* pAllocator, VkFramebuffer* pFramebuffer)
+{
+    auto result = o_vkCreateFramebuffer(device, pCreateInfo, pAllocator, pFramebuffer);
+
+    // Imageless framebuffers get their views at vkCmdBeginRenderPass
+    if (result != VK_SUCCESS || pCreateInfo == nullptr || pCreateInfo->pAttachments == nullptr ||
+        (pCreateInfo->flags & VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT) > 0)
+    {
+        return result;
+    }
+
+    std::vector<VkImageView> views;
+
+    std::unique_lock<std::shared_mutex> lock(_objectMutex);
+
+    for (uint32_t i = 0; i < pCreateInfo->attachmentCount; i++)
+    {
+        if (_views.contains(pCreateInfo->pAttachments[i]))
+            views.push_back(pCreateInfo->pAttachments[i]);
+    }
+
+    if (views.size() > 0)
+        _framebuffers.insert_or_assign(*pFramebuffer, views);
+
+    return result;
+}
+
+void ResTrack_Vk::hkDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer,
+                                       const VkAllocationCallbacks* pAllocator)
+{
+    if (framebuffer != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::shared_mutex> lock(_objectMutex);
+        _framebuffers.erase(framebuffer);
+    }
+
+    o_vkDestroyFramebuffer(device, framebuffer, pAllocator);
+}
+
+VkResult ResTrack_Vk::hkCreateDescriptorUpdateTemplate(VkDevice device,
+                                                       const VkDescriptorUpdateTemplateCreateInfo* pCreateInfo,
+                                                       const VkAllocationCallbacks* pAllocator,
+                                                       VkDescriptorUpdateTemplate* pDescriptorUpdateTemplate)
+{
+    auto result = o_vkCreateDescriptorUpdateTemplate(device, pCreateInfo, pAllocator, pDescriptorUpdateTemplate);
+
+    if (result != VK_SUCCESS || pCreateInfo == nullptr ||
+        pCreateInfo->templateType != VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET)
+    {
+        return result;
+    }
+
+    std::vector<TemplateImageEntry> entries;
+
+    for (uint32_t i = 0; i < pCreateInfo->descriptorUpdateEntryCount; i++)
+    {
+        auto entry = &pCreateInfo->pDescriptorUpdateEntries[i];
+
+        if (!IsTrackedDescriptorType(entry->descriptorType))
+            continue;
+
+        entries.push_back({ entry->dstBinding, entry->dstArrayElement, entry->descriptorCount, entry->offset,
+                            entry->stride, entry->descriptorType });
+    }
+
+    if (entries.size() > 0)
+    {
+        std::unique_lock<std::shared_mutex> lock(_objectMutex);
+        _templates.insert_or_assign(*pDescriptorUpdateTemplate, entries);
+    }
+
+    return result;
+}
+
+void ResTrack_Vk::hkDestroyDescriptorUpdateTemplate(VkDevice device,
+                                                    VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                    const VkAllocationCallbacks* pAllocator)
+{
+    if (descriptorUpdateTemplate != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::shared_mutex> lock(_objectMutex);
+        _templates.erase(descriptorUpdateTemplate);
+    }
+
+    o_vkDestroyDescriptorUpdateTemplate(device, descriptorUpdateTemplate, pAllocator);
+}
+
+VkResult ResTrack_Vk::hkCreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo* pCreateInfo,
+                                                  const VkAllocationCallbacks* pAllocator,
+                                                  VkDescriptorSetLayout* pSetLayout)
+{
+    auto result = o_vkCreateDescriptorSetLayout(device, pCreateInfo, pAllocator, pSetLayout);
+
+    if (result != VK_SUCCESS || pCreateInfo == nullptr || pCreateInfo->pBindings == nullptr)
+        return result;
+
+    std::vector<LayoutBinding> bindings(pCreateInfo->bindingCount);
+
+    for (uint32_t i = 0; i < pCreateInfo->bindingCount; i++)
+        bindings[i] = { pCreateInfo->pBindings[i].binding, pCreateInfo->pBindings[i].descriptorCount };
+
+    std::unique_lock<std::shared_mutex> lock(_setMutex);
+    _descriptorSets.AddLayout((VkHandleValue) *pSetLayout, bindings);
+
+    return result;
+}
+
+void ResTrack_Vk::hkDestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout,
+                                               const VkAllocationCallbacks* pAllocator)
+{
+    if (descriptorSetLayout != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::shared_mutex> lock(_setMutex);
+        _descriptorSets.RemoveLayout((VkHandleValue) descriptorSetLayout);
+    }
+
+    o_vkDestroyDescriptorSetLayout(device, descriptorSetLayout, pAllocator);
+}
+
+VkResult ResTrack_Vk::hkAllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo* pAllocateInfo,
+                                               VkDescriptorSet* pDescriptorSets)
+{
+    auto result = o_vkAllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets);
+
+    if (result != VK_SUCCESS || pAllocateInfo == nullptr || pDescriptorSets == nullptr)
+        return result;
+
+    std::unique_lock<std::shared_mutex> lock(_setMutex);
+
+    for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++)
+    {
+        _descriptorSets.Allocate((VkHandleValue) pAllocateInfo->descriptorPool,
+                                 (VkHandleValue) pAllocateInfo->pSetLayouts[i], (VkHandleValue) pDescriptorSets[i]);
+    }
+
+    return result;
+}
+
+VkResult ResTrack_Vk::hkFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool,
+                                           uint32_t descriptorSetCount, const VkDescriptorSet* pDescriptorSets)
+{
+    if (pDescriptorSets != nullptr)
+    {
+        std::unique_lock<std::shared_mutex> lock(_setMutex);
+
+        for (uint32_t i = 0; i < descriptorSetCount; i++)
+            _descriptorSets.Free((VkHandleValue) pDescriptorSets[i]);
+    }
+
+    return o_vkFreeDescriptorSets(device, descriptorPool, descriptorSetCount, pDescriptorSets);
+}
+
+VkResult ResTrack_Vk::hkResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                            VkDescriptorPoolResetFlags flags)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(_setMutex);
+        _descriptorSets.ResetPool((VkHandleValue) descriptorPool);
+    }
+
+    return o_vkResetDescriptorPool(device, descriptorPool, flags);
+}
+
+void ResTrack_Vk::hkDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                          const VkAllocationCallbacks* pAllocator)
+{
+    if (descriptorPool != VK_NULL_HANDLE)
+    {
+        std::unique_lock<std::shared_mutex> lock(_setMutex);
+        _descriptorSets.DestroyPool((VkHandleValue) descriptorPool);
+    }
+
+    o_vkDestroyDescriptorPool(device, descriptorPool, pAllocator);
+}
+
+void ResTrack_Vk::hkUpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount,
+                                         const VkWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount,
+                                         const VkCopyDescriptorSet* pDescriptorCopies)
+{
+    o_vkUpdateDescriptorSets(device, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount,
+                             pDescriptorCopies);
+
+    std::vector<DescriptorWrite> writes;
+
+    for (uint32_t i = 0; i < descriptorWriteCount; i++)
+    {
+        auto write = &pDescriptorWrites[i];
+
+        if (!IsTrackedDescriptorType(write->descriptorType) || write->pImageInfo == nullptr)
+            continue;
+
+        writes.resize(write->descriptorCount);
+
+        for (uint32_t j = 0; j < write->descriptorCount; j++)
+            writes[j] = GetDescriptorWrite(write->pImageInfo[j].imageView, write->pImageInfo[j].imageLayout);
+
+        std::unique_lock<std::shared_mutex> lock(_setMutex);
+        _descriptorSets.Write((VkHandleValue) write->dstSet, write->dstBinding, write->dstArrayElement, writes.data(),
+                              write->descriptorCount);
+    }
+
+    if (descriptorCopyCount == 0 || pDescriptorCopies == nullptr)
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(_setMutex);
+
+    for (uint32_t i = 0; i < descriptorCopyCount; i++)
+    {
+        auto copy = &pDescriptorCopies[i];
+        _descriptorSets.Copy((VkHandleValue) copy->srcSet, copy->srcBinding, copy->srcArrayElement,
+                             (VkHandleValue) copy->dstSet, copy->dstBinding, copy->dstArrayElement,
+                             copy->descriptorCount);
+    }
+}
+
+void ResTrack_Vk::hkUpdateDescriptorSetWithTemplate(VkDevice device, VkDescriptorSet descriptorSet,
+                                                    VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                    const void* pData)
+{
+    o_vkUpdateDescriptorSetWithTemplate(device, descriptorSet, descriptorUpdateTemplate, pData);
+
+    if (pData == nullptr)
+        return;
+
+    std::vector<TemplateImageEntry> entries;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_objectMutex);
+
+        auto it = _templates.find(descriptorUpdateTemplate);
+        if (it == _templates.end())
+            return;
+
+        entries = it->second;
+    }
+
+    std::vector<DescriptorWrite> writes;
+
+    for (auto& entry : entries)
+    {
+        writes.resize(entry.count);
+
+        for (uint32_t j = 0; j < entry.count; j++)
+        {
+            auto imageInfo = (const VkDescriptorImageInfo*) ((const char*) pData + entry.offset + j * entry.stride);
+            writes[j] = GetDescriptorWrite(imageInfo->imageView, imageInfo->imageLayout);
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_setMutex);
+        _descriptorSets.Write((VkHandleValue) descriptorSet, entry.binding, entry.arrayElement, writes.data(),
+                              entry.count);
+    }
+}
+
+#pragma endregion
+
+#pragma region Command buffer hooks
+
+void ResTrack_Vk::hkCmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint,
+                                          VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount,
+                                          const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount,
+                                          const uint32_t* pDynamicOffsets)
+{
+    o_vkCmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount,
+                              pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+
+    if (pDescriptorSets == nullptr || !IsCommandTrackingActive())
+        return;
+
+    std::vector<DescriptorImageInfo> entries;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_setMutex);
+
+        for (uint32_t i = 0; i < descriptorSetCount; i++)
+            _descriptorSets.GetImages((VkHandleValue) pDescriptorSets[i], entries);
+    }
+
+    for (auto& entry : entries)
+        AddPossibleHudless(commandBuffer, (VkImageView) entry.view, (VkImageLayout) entry.layout);
+}
+
+void ResTrack_Vk::hkCmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin,
+                                       VkSubpassContents contents)
+{
+    o_vkCmdBeginRenderPass(commandBuffer, pRenderPassBegin, contents);
+
+    if (pRenderPassBegin == nullptr || !IsCommandTrackingActive())
+        return;
+
+    std::vector<VkImageView> views;
+
+    // Imageless framebuffer
+    auto next = (const VkBaseInStructure*) pRenderPassBegin->pNext;
+    while (next != nullptr)
+    {
+        if (next->sType == VK_STRUCTURE_TYPE_RENDER_PASS_ATTACHMENT_BEGIN_INFO)
+        {
+            auto attachmentInfo = (const VkRenderPassAttachmentBeginInfo*) next;
+            views.assign(attachmentInfo->pAttachments, attachmentInfo->pAttachments + attachmentInfo->attachmentCount);
+            break;
+        }
+
+        next = next->pNext;
+    }
+
+    if (views.size() == 0)
+    {
+        std::shared_lock<std::shared_mutex> lock(_objectMutex);
+
+        auto it = _framebuffers.find(pRenderPassBegin->framebuffer);
+        if (it == _framebuffers.end())
+            return;
+
+        views = it->second;
+    }
+
+    // Final layout is defined by the render pass and not tracked
+    for (auto view : views)
+        AddPossibleHudless(commandBuffer, view, VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
+void ResTrack_Vk::hkCmdEndRenderPass(VkCommandBuffer commandBuffer)
+{
+    o_vkCmdEndRenderPass(commandBuffer);
+
+    if (!IsCommandTrackingActive())
+        return;
+
+    CheckPossibleHudless(__FUNCTION__, commandBuffer, true);
+}
+
+void ResTrack_Vk::hkCmdBeginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo)
+{
+    o_vkCmdBeginRendering(commandBuffer, pRenderingInfo);
+
+    if (pRenderingInfo == nullptr || pRenderingInfo->pColorAttachments == nullptr ||
+        !IsCommandTrackingActive())
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < pRenderingInfo->colorAttachmentCount; i++)
+    {
+        AddPossibleHudless(commandBuffer, pRenderingInfo->pColorAttachments[i].imageView,
+                           pRenderingInfo->pColorAttachments[i].imageLayout);
+    }
+}
+
+void ResTrack_Vk::hkCmdBeginRenderingKHR(VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo)
+{
+    o_vkCmdBeginRenderingKHR(commandBuffer, pRenderingInfo);
+
+    if (pRenderingInfo == nullptr || pRenderingInfo->pColorAttachments == nullptr ||
+        !IsCommandTrackingActive())
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < pRenderingInfo->colorAttachmentCount; i++)
+    {
+        AddPossibleHudless(commandBuffer, pRenderingInfo->pColorAttachments[i].imageView,
+                           pRenderingInfo->pColorAttachments[i].imageLayout);
+    }
+}
+
+void ResTrack_Vk::hkCmdEndRendering(VkCommandBuffer commandBuffer)
+{
+    o_vkCmdEndRendering(commandBuffer);
+
+    if (!IsCommandTrackingActive())
+        return;
+
+    CheckPossibleHudless(__FUNCTION__, commandBuffer, true);
+}
+
+void ResTrack_Vk::hkCmdEndRenderingKHR(VkCommandBuffer commandBuffer)
+{
+    o_vkCmdEndRenderingKHR(commandBuffer);
+
+    if (!IsCommandTrackingActive())
+        return;
+
+    CheckPossibleHudless(__FUNCTION__, commandBuffer, true);
+}
+
+// Draws are inside of a render pass, candidates are checked when it ends
+void ResTrack_Vk::hkCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
+                            uint32_t firstVertex, uint32_t firstInstance)
+{
+    o_vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+
+    if (!IsCommandTrackingActive())
+        return;
+
+    MarkDrawn(commandBuffer);
+}
+
+void ResTrack_Vk::hkCmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount,
+                                   uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    o_vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+
+    if (!IsCommandTrackingActive())
+        return;
+
+    MarkDrawn(commandBuffer);
+}
+
+void ResTrack_Vk::hkCmdDispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY,
+                                uint32_t groupCountZ)
+{
+    o_vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+
+    if (!IsCommandTrackingActive())
+        return;
+
+    CheckPossibleHudless(__FUNCTION__, commandBuffer, false);
+}
+
+#pragma endregion
+
+void ResTrack_Vk::HookDevice(VkDevice device)
+{
+    if (o_vkCreateImage != nullptr || device == VK_NULL_HANDLE || State::Instance().vulkanSkipHooks)
+        return;
+
+    if (!Config::Instance()->FGHUDFix.value_or_default())
+        return;
+
+    LOG_FUNC();
+
+    o_vkCreateImage = (PFN_vkCreateImage) vkGetDeviceProcAddr(device, "vkCreateImage");
+    o_vkDestroyImage = (PFN_vkDestroyImage) vkGetDeviceProcAddr(device, "vkDestroyImage");
+    o_vkCreateImageView = (PFN_vkCreateImageView) vkGetDeviceProcAddr(device, "vkCreateImageView");
+    o_vkDestroyImageView = (PFN_vkDestroyImageView) vkGetDeviceProcAddr(device, "vkDestroyImageView");
+    o_vkCreateFramebuffer = (PFN_vkCreateFramebuffer) vkGetDeviceProcAddr(device, "vkCreateFramebuffer");
+    o_vkDestroyFramebuffer = (PFN_vkDestroyFramebuffer) vkGetDeviceProcAddr(device, "vkDestroyFramebuffer");
+    o_vkCreateDescriptorUpdateTemplate =
+        (PFN_vkCreateDescriptorUpdateTemplate) vkGetDeviceProcAddr(device, "vkCreateDescriptorUpdateTemplate");
+    o_vkDestroyDescriptorUpdateTemplate =
+        (PFN_vkDestroyDescriptorUpdateTemplate) vkGetDeviceProcAddr(device, "vkDestroyDescriptorUpdateTemplate");
+    o_vkCreateDescriptorSetLayout =
+        (PFN_vkCreateDescriptorSetLayout) vkGetDeviceProcAddr(device, "vkCreateDescriptorSetLayout");
+    o_vkDestroyDescriptorSetLayout =
+        (PFN_vkDestroyDescriptorSetLayout) vkGetDeviceProcAddr(device, "vkDestroyDescriptorSetLayout");
+    o_vkAllocateDescriptorSets =
+        (PFN_vkAllocateDescriptorSets) vkGetDeviceProcAddr(device, "vkAllocateDescriptorSets");
+    o_vkFreeDescriptorSets = (PFN_vkFreeDescriptorSets) vkGetDeviceProcAddr(device, "vkFreeDescriptorSets");
+    o_vkResetDescriptorPool = (PFN_vkResetDescriptorPool) vkGetDeviceProcAddr(device, "vkResetDescriptorPool");
+    o_vkDestroyDescriptorPool =
+        (PFN_vkDestroyDescriptorPool) vkGetDeviceProcAddr(device, "vkDestroyDescriptorPool");
+    o_vkUpdateDescriptorSets = (PFN_vkUpdateDescriptorSets) vkGetDeviceProcAddr(device, "vkUpdateDescriptorSets");
+    o_vkUpdateDescriptorSetWithTemplate =
+        (PFN_vkUpdateDescriptorSetWithTemplate) vkGetDeviceProcAddr(device, "vkUpdateDescriptorSetWithTemplate");
+
+    o_vkCmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets) vkGetDeviceProcAddr(device, "vkCmdBindDescriptorSets");
+    o_vkCmdBeginRenderPass = (PFN_vkCmdBeginRenderPass) vkGetDeviceProcAddr(device, "vkCmdBeginRenderPass");
+    o_vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass) vkGetDeviceProcAddr(device, "vkCmdEndRenderPass");
+    o_vkCmdBeginRendering = (PFN_vkCmdBeginRendering) vkGetDeviceProcAddr(device, "vkCmdBeginRendering");
+    o_vkCmdBeginRenderingKHR = (PFN_vkCmdBeginRendering) vkGetDeviceProcAddr(device, "vkCmdBeginRenderingKHR");
+    o_vkCmdEndRendering = (PFN_vkCmdEndRendering) vkGetDeviceProcAddr(device, "vkCmdEndRendering");
+    o_vkCmdEndRenderingKHR = (PFN_vkCmdEndRendering) vkGetDeviceProcAddr(device, "vkCmdEndRenderingKHR");
+    o_vkCmdDraw = (PFN_vkCmdDraw) vkGetDeviceProcAddr(device, "vkCmdDraw");
+    o_vkCmdDrawIndexed = (PFN_vkCmdDrawIndexed) vkGetDeviceProcAddr(device, "vkCmdDrawIndexed");
+    o_vkCmdDispatch = (PFN_vkCmdDispatch) vkGetDeviceProcAddr(device, "vkCmdDispatch");
+
+    // Driver might return same function for core & KHR versions
+    if (o_vkCmdBeginRenderingKHR == o_vkCmdBeginRendering)
+        o_vkCmdBeginRenderingKHR = nullptr;
+
+    if (o_vkCmdEndRenderingKHR == o_vkCmdEndRendering)
+        o_vkCmdEndRenderingKHR = nullptr;
+
+    // Can't track anything without these
+    if (o_vkCreateImage == nullptr || o_vkCreateImageView == nullptr || o_vkUpdateDescriptorSets == nullptr ||
+        o_vkAllocateDescriptorSets == nullptr || o_vkFreeDescriptorSets == nullptr ||
+        o_vkResetDescriptorPool == nullptr || o_vkDestroyDescriptorPool == nullptr ||
+        o_vkCmdBindDescriptorSets == nullptr || o_vkCmdEndRenderPass == nullptr)
+    {
+        LOG_ERROR("Can't get device functions!");
+        o_vkCreateImage = nullptr;
+        return;
+    }
+
+    HookBatch batch;
+
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkCreateImage, hkCreateImage);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkDestroyImage, hkDestroyImage);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkCreateImageView, hkCreateImageView);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkDestroyImageView, hkDestroyImageView);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkCreateFramebuffer, hkCreateFramebuffer);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkDestroyFramebuffer, hkDestroyFramebuffer);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkCreateDescriptorUpdateTemplate,
+                        hkCreateDescriptorUpdateTemplate);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkDestroyDescriptorUpdateTemplate,
+                        hkDestroyDescriptorUpdateTemplate);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkCreateDescriptorSetLayout,
+                        hkCreateDescriptorSetLayout);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkDestroyDescriptorSetLayout,
+                        hkDestroyDescriptorSetLayout);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkAllocateDescriptorSets, hkAllocateDescriptorSets);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkFreeDescriptorSets, hkFreeDescriptorSets);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkResetDescriptorPool, hkResetDescriptorPool);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkDestroyDescriptorPool, hkDestroyDescriptorPool);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkUpdateDescriptorSets, hkUpdateDescriptorSets);
+    HookRegistry::Queue(HookGroup::ResTrackVkObjects, &(PVOID&) o_vkUpdateDescriptorSetWithTemplate,
+                        hkUpdateDescriptorSetWithTemplate);
+
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdBindDescriptorSets, hkCmdBindDescriptorSets);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdBeginRenderPass, hkCmdBeginRenderPass);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdEndRenderPass, hkCmdEndRenderPass);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdBeginRendering, hkCmdBeginRendering);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdBeginRenderingKHR, hkCmdBeginRenderingKHR);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdEndRendering, hkCmdEndRendering);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdEndRenderingKHR, hkCmdEndRenderingKHR);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdDraw, hkCmdDraw);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdDrawIndexed, hkCmdDrawIndexed);
+    HookRegistry::Queue(HookGroup::ResTrackVkCommands, &(PVOID&) o_vkCmdDispatch, hkCmdDispatch);
+
+    // Command buffer hooks only pass through until a capture callback is set
+    UpdateHookState();
+}
+
+void ResTrack_Vk::UpdateHookState()
+{
+    // Device is not hooked
+    if (o_vkCreateImage == nullptr)
+        return;
+
+    auto enabled = Hudfix_Vk::HasCaptureCallback() && Config::Instance()->FGEnabled.value_or_default() &&
+                   Config::Instance()->FGHUDFix.value_or_default();
+
+    // Detaching while game threads record command buffers could free trampolines in use
+    if (_commandHooksActive.exchange(enabled) != enabled)
+        LOG_DEBUG("Command buffer hooks: {}", enabled ? "active" : "inactive");
+}
+
+void ResTrack_Vk::ClearPossibleHudless()
+{
+    std::lock_guard<std::mutex> lock(_hudlessMutex);
+
+    auto fIndex = Hudfix_Vk::ActivePresentFrame() % BUFFER_COUNT;
+    _possibleHudless[fIndex].clear();
+}
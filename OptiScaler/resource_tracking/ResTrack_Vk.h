@@ -0,0 +1,113 @@
+#pragma once
+
+#include <pch.h>
+
+#include "ResTrack_Vk_Common.h"
+
+#include <hudfix/Hudfix_Vk.h>
+
+#include <vulkan/vulkan.hpp>
+
+#include <ankerl/unordered_dense.h>
+
+// Image descriptor entry of an update template
+typedef struct TemplateImageEntry
+{
+    uint32_t binding = 0;
+    uint32_t arrayElement = 0;
+    uint32_t count = 0;
+    size_t offset = 0;
+    size_t stride = 0;
+    VkDescriptorType type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+} template_image_entry;
+
+// Hudless candidates of a command buffer
+typedef struct CommandBufferHudless
+{
+    // Bound by descriptor sets or render pass attachments
+    ankerl::unordered_dense::map<VkImage, ImageInfo> bound;
+
+    // Used by a draw inside current render pass, checked at the end of render pass
+    ankerl::unordered_dense::map<VkImage, ImageInfo> drawn;
+} command_buffer_hudless;
+
+class ResTrack_Vk
+{
+  private:
+    // Command buffer hooks stay attached and check this, recording threads read it without locks
+    inline static std::atomic<bool> _commandHooksActive { false };
+
+    static bool IsTrackedDescriptorType(VkDescriptorType type);
+    static bool GetImageInfo(VkImageView view, VkImageLayout layout, ImageInfo* info);
+
+    static bool IsCommandTrackingActive();
+
+    // Tracked state of image views, checked once per write before locking the descriptor sets
+    static DescriptorWrite GetDescriptorWrite(VkImageView view, VkImageLayout layout);
+
+    static void AddPossibleHudless(VkCommandBuffer cmdBuffer, VkImageView view, VkImageLayout layout);
+    static void MarkDrawn(VkCommandBuffer cmdBuffer);
+    static void CheckPossibleHudless(std::string callerName, VkCommandBuffer cmdBuffer, bool drawn);
+
+    static VkResult hkCreateImage(VkDevice device, const VkImageCreateInfo* pCreateInfo,
+                                  const VkAllocationCallbacks* pAllocator, VkImage* pImage);
+    static void hkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator);
+    static VkResult hkCreateImageView(VkDevice device, const VkImageViewCreateInfo* pCreateInfo,
+                                      const VkAllocationCallbacks* pAllocator, VkImageView* pView);
+    static void hkDestroyImageView(VkDevice device, VkImageView imageView, const VkAllocationCallbacks* pAllocator);
+    static VkResult hkCreateFramebuffer(VkDevice device, const VkFramebufferCreateInfo* pCreateInfo,
+                                        const VkAllocationCallbacks* pAllocator, VkFramebuffer* pFramebuffer);
+    static void hkDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer,
+                                     const VkAllocationCallbacks* pAllocator);
+    static VkResult hkCreateDescriptorUpdateTemplate(VkDevice device,
+                                                     const VkDescriptorUpdateTemplateCreateInfo* pCreateInfo,
+                                                     const VkAllocationCallbacks* pAllocator,
+                                                     VkDescriptorUpdateTemplate* pDescriptorUpdateTemplate);
+    static void hkDestroyDescriptorUpdateTemplate(VkDevice device, VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                  const VkAllocationCallbacks* pAllocator);
+    static VkResult hkCreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo* pCreateInfo,
+                                                const VkAllocationCallbacks* pAllocator,
+                                                VkDescriptorSetLayout* pSetLayout);
+    static void hkDestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout,
+                                             const VkAllocationCallbacks* pAllocator);
+    static VkResult hkAllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo* pAllocateInfo,
+                                             VkDescriptorSet* pDescriptorSets);
+    static VkResult hkFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t descriptorSetCount,
+                                         const VkDescriptorSet* pDescriptorSets);
+    static VkResult hkResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                          VkDescriptorPoolResetFlags flags);
+    static void hkDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                        const VkAllocationCallbacks* pAllocator);
+    static void hkUpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount,
+                                       const VkWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount,
+                                       const VkCopyDescriptorSet* pDescriptorCopies);
+    static void hkUpdateDescriptorSetWithTemplate(VkDevice device, VkDescriptorSet descriptorSet,
+                                                  VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                  const void* pData);
+
+    static void hkCmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint,
+                                        VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount,
+                                        const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount,
+                                        const uint32_t* pDynamicOffsets);
+    static void hkCmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin,
+                                     VkSubpassContents contents);
+    static void hkCmdBeginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo);
+    static void hkCmdBeginRenderingKHR(VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo);
+    static void hkCmdEndRenderPass(VkCommandBuffer commandBuffer);
+    static void hkCmdEndRendering(VkCommandBuffer commandBuffer);
+    static void hkCmdEndRenderingKHR(VkCommandBuffer commandBuffer);
+    static void hkCmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
+                          uint32_t firstVertex, uint32_t firstInstance);
+    static void hkCmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount,
+                                 uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+    static void hkCmdDispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY,
+                              uint32_t groupCountZ);
+
+  public:
+    static void HookDevice(VkDevice device);
+
+    // Activates / deactivates command buffer hooks depending on hudfix state, called once per present
+    static void UpdateHookState();
+
+    static void ClearPossibleHudless();
+};
@@ -0,0 +1,192 @@
+#include "ResTrack_Vk_Common.h"
+
+void DescriptorSetTracker::NextDescriptor(const std::vector<uint32_t>* bindingCounts, uint32_t& binding,
+                                          uint32_t& arrayElement, bool advance)
+{
+    if (advance)
+        arrayElement++;
+
+    // Layout is unknown, set was allocated before hooking
+    if (bindingCounts == nullptr)
+        return;
+
+    while (binding < bindingCounts->size() && arrayElement >= (*bindingCounts)[binding])
+    {
+        arrayElement -= (*bindingCounts)[binding];
+        binding++;
+    }
+}
+
+void DescriptorSetTracker::AddLayout(VkHandleValue layout, const std::vector<LayoutBinding>& bindings)
+{
+    auto counts = std::make_shared<std::vector<uint32_t>>();
+
+    for (auto& binding : bindings)
+    {
+        if (binding.binding >= counts->size())
+            counts->resize(binding.binding + 1, 0);
+
+        (*counts)[binding.binding] = binding.count;
+    }
+
+    _layouts.insert_or_assign(layout, counts);
+}
+
+void DescriptorSetTracker::RemoveLayout(VkHandleValue layout) { _layouts.erase(layout); }
+
+void DescriptorSetTracker::Allocate(VkHandleValue pool, VkHandleValue layout, VkHandleValue set)
+{
+    DescriptorSetInfo info {};
+    info.pool = pool;
+
+    auto layoutIt = _layouts.find(layout);
+    if (layoutIt != _layouts.end())
+        info.bindingCounts = layoutIt->second;
+
+    // Recycled handle might still be listed in its old pool
+    Free(set);
+
+    _sets.insert_or_assign(set, std::move(info));
+    _poolSets[pool].insert(set);
+}
+
+void DescriptorSetTracker::Free(VkHandleValue set)
+{
+    auto it = _sets.find(set);
+    if (it == _sets.end())
+        return;
+
+    auto poolIt = _poolSets.find(it->second.pool);
+    if (poolIt != _poolSets.end())
+        poolIt->second.erase(set);
+
+    _sets.erase(it);
+}
+
+void DescriptorSetTracker::ErasePoolSets(VkHandleValue pool, bool destroy)
+{
+    auto it = _poolSets.find(pool);
+    if (it == _poolSets.end())
+        return;
+
+    for (auto set : it->second)
+        _sets.erase(set);
+
+    if (destroy)
+        _poolSets.erase(it);
+    else
+        it->second.clear();
+}
+
+void DescriptorSetTracker::ResetPool(VkHandleValue pool) { ErasePoolSets(pool, false); }
+
+void DescriptorSetTracker::DestroyPool(VkHandleValue pool) { ErasePoolSets(pool, true); }
+
+void DescriptorSetTracker::SetDescriptor(VkHandleValue set, uint32_t binding, uint32_t arrayElement,
+                                         const DescriptorWrite& write)
+{
+    auto setIt = _sets.find(set);
+
+    // Nothing to clear
+    if (!write.tracked && setIt == _sets.end())
+        return;
+
+    if (setIt == _sets.end())
+        setIt = _sets.insert({ set, {} }).first;
+
+    auto& entries = setIt->second.images;
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].binding != binding || entries[i].arrayElement != arrayElement)
+            continue;
+
+        if (write.tracked)
+        {
+            entries[i].view = write.view;
+            entries[i].layout = write.layout;
+        }
+        else
+        {
+            entries.erase(entries.begin() + i);
+        }
+
+        return;
+    }
+
+    if (write.tracked)
+        entries.push_back({ binding, arrayElement, write.view, write.layout });
+}
+
+void DescriptorSetTracker::Write(VkHandleValue set, uint32_t binding, uint32_t arrayElement,
+                                 const DescriptorWrite* writes, uint32_t count)
+{
+    std::shared_ptr<const std::vector<uint32_t>> counts;
+
+    auto it = _sets.find(set);
+    if (it != _sets.end())
+        counts = it->second.bindingCounts;
+
+    NextDescriptor(counts.get(), binding, arrayElement, false);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        SetDescriptor(set, binding, arrayElement, writes[i]);
+        NextDescriptor(counts.get(), binding, arrayElement, true);
+    }
+}
+
+void DescriptorSetTracker::Copy(VkHandleValue srcSet, uint32_t srcBinding, uint32_t srcArrayElement,
+                                VkHandleValue dstSet, uint32_t dstBinding, uint32_t dstArrayElement, uint32_t count)
+{
+    std::shared_ptr<const std::vector<uint32_t>> srcCounts;
+    std::shared_ptr<const std::vector<uint32_t>> dstCounts;
+
+    auto srcIt = _sets.find(srcSet);
+    if (srcIt != _sets.end())
+        srcCounts = srcIt->second.bindingCounts;
+
+    auto dstIt = _sets.find(dstSet);
+    if (dstIt != _sets.end())
+        dstCounts = dstIt->second.bindingCounts;
+
+    NextDescriptor(srcCounts.get(), srcBinding, srcArrayElement, false);
+    NextDescriptor(dstCounts.get(), dstBinding, dstArrayElement, false);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        DescriptorWrite write {};
+
+        // Looked up every time, destination might be the same set
+        srcIt = _sets.find(srcSet);
+        if (srcIt != _sets.end())
+        {
+            for (auto& entry : srcIt->second.images)
+            {
+                if (entry.binding == srcBinding && entry.arrayElement == srcArrayElement)
+                {
+                    write = { entry.view, entry.layout, true };
+                    break;
+                }
+            }
+        }
+
+        SetDescriptor(dstSet, dstBinding, dstArrayElement, write);
+
+        NextDescriptor(srcCounts.get(), srcBinding, srcArrayElement, true);
+        NextDescriptor(dstCounts.get(), dstBinding, dstArrayElement, true);
+    }
+}
+
+void DescriptorSetTracker::GetImages(VkHandleValue set, std::vector<DescriptorImageInfo>& images) const
+{
+    auto it = _sets.find(set);
+    if (it != _sets.end())
+        images.insert(images.end(), it->second.images.begin(), it->second.images.end());
+}
+
+size_t DescriptorSetTracker::PoolSetCount(VkHandleValue pool) const
+{
+    auto it = _poolSets.find(pool);
+    return it == _poolSets.end() ? 0 : it->second.size();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Vulkan handles are stored as 64 bit values, non-dispatchable handles are not pointers on 32 bit builds
+typedef uint64_t VkHandleValue;
+
+// Image view written to a descriptor set binding
+typedef struct DescriptorImageInfo
+{
+    uint32_t binding = 0;
+    uint32_t arrayElement = 0;
+    VkHandleValue view = 0;
+    uint32_t layout = 0;
+} descriptor_image_info;
+
+// One descriptor of a write, untracked views clear the previous entry
+typedef struct DescriptorWrite
+{
+    VkHandleValue view = 0;
+    uint32_t layout = 0;
+    bool tracked = false;
+} descriptor_write;
+
+// Binding number & descriptor count from a set layout create info
+typedef struct LayoutBinding
+{
+    uint32_t binding = 0;
+    uint32_t count = 0;
+} layout_binding;
+
+// Allocated descriptor set, recycled handles get a fresh entry on allocation
+typedef struct DescriptorSetInfo
+{
+    VkHandleValue pool = 0;
+
+    // Descriptor count of each binding number from the set layout, needed for rolling over to next binding
+    std::shared_ptr<const std::vector<uint32_t>> bindingCounts;
+
+    std::vector<DescriptorImageInfo> images;
+} descriptor_set_info;
+
+// Image descriptors of sets, their pools & set layouts. Not thread safe, ResTrack_Vk locks around it
+class DescriptorSetTracker
+{
+  private:
+    std::unordered_map<VkHandleValue, DescriptorSetInfo> _sets;
+    std::unordered_map<VkHandleValue, std::unordered_set<VkHandleValue>> _poolSets;
+    std::unordered_map<VkHandleValue, std::shared_ptr<const std::vector<uint32_t>>> _layouts;
+
+    void SetDescriptor(VkHandleValue set, uint32_t binding, uint32_t arrayElement, const DescriptorWrite& write);
+    void ErasePoolSets(VkHandleValue pool, bool destroy);
+
+  public:
+    // Consecutive descriptors continue in next binding after the end of the array, empty bindings are skipped
+    static void NextDescriptor(const std::vector<uint32_t>* bindingCounts, uint32_t& binding, uint32_t& arrayElement,
+                               bool advance);
+
+    void AddLayout(VkHandleValue layout, const std::vector<LayoutBinding>& bindings);
+
+    // Allocated sets keep their own reference to binding counts
+    void RemoveLayout(VkHandleValue layout);
+
+    // Handle might be recycled, bindings of the old set are dropped
+    void Allocate(VkHandleValue pool, VkHandleValue layout, VkHandleValue set);
+    void Free(VkHandleValue set);
+    void ResetPool(VkHandleValue pool);
+    void DestroyPool(VkHandleValue pool);
+
+    // Sets allocated before hooking have no layout, their writes don't roll over
+    void Write(VkHandleValue set, uint32_t binding, uint32_t arrayElement, const DescriptorWrite* writes,
+               uint32_t count);
+
+    // Source & destination roll over independently, their layouts can differ
+    void Copy(VkHandleValue srcSet, uint32_t srcBinding, uint32_t srcArrayElement, VkHandleValue dstSet,
+              uint32_t dstBinding, uint32_t dstArrayElement, uint32_t count);
+
+    // Appends tracked image views of the set
+    void GetImages(VkHandleValue set, std::vector<DescriptorImageInfo>& images) const;
+
+    size_t SetCount() const { return _sets.size(); }
+    size_t PoolSetCount(VkHandleValue pool) const;
+};
@@ -3,6 +3,8 @@
 #include <Config.h>
 #include <State.h>
 #include <Util.h>
+#include <misc/VramTracker.h>
+#include "FGHazard_Dx12.h"
 
 #include <menu/menu_overlay_dx.h>
 
@@ -10,15 +12,20 @@
 #include <future>
 
 #include <include/d3dx/d3dx12.h>
-#include <detours/detours.h>
+#include <hooks/HookRegistry.h>
 
 #include <initguid.h>
 #include <guiddef.h>
 
 DEFINE_GUID(GUID_Tracking, 0x12345678, 0x1234, 0x1234, 0x12, 0x34, 0x56, 0x78, 0x90, 0xab, 0xcd, 0xef);
 
+// ID3D12GraphicsCommandList7, enhanced barriers are not in every Windows SDK
+DEFINE_GUID(IID_GraphicsCommandList7, 0xdd171223, 0x8b61, 0x4769, 0x90, 0xe3, 0x16, 0x0c, 0xcd, 0xe4, 0xe2, 0xc1);
+
 static UINT _trackMark = 1;
 
+std::atomic<UINT> _shadowEpoch { 1 };
+
 // Device hooks for FG
 typedef void (*PFN_CreateRenderTargetView)(ID3D12Device* This, ID3D12Resource* pResource,
                                            D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
@@ -68,6 +75,11 @@ typedef void (*PFN_Dispatch)(ID3D12GraphicsCommandList* This, UINT ThreadGroupCo
                              UINT ThreadGroupCountZ);
 typedef void (*PFN_ExecuteBundle)(ID3D12GraphicsCommandList* This, ID3D12GraphicsCommandList* pCommandList);
 typedef HRESULT (*PFN_Close)(ID3D12GraphicsCommandList* This);
+typedef void (*PFN_ResourceBarrier)(ID3D12GraphicsCommandList* This, UINT NumBarriers,
+                                    const D3D12_RESOURCE_BARRIER* pBarriers);
+
+// Groups are not inspected, only the call matters
+typedef void (*PFN_Barrier)(ID3D12GraphicsCommandList* This, UINT32 NumBarrierGroups, const void* pBarrierGroups);
 
 typedef void (*PFN_ExecuteCommandLists)(ID3D12CommandQueue* This, UINT NumCommandLists,
                                         ID3D12CommandList* const* ppCommandLists);
@@ -92,6 +104,8 @@ static PFN_DrawInstanced o_DrawInstanced = nullptr;
 static PFN_DrawIndexedInstanced o_DrawIndexedInstanced = nullptr;
 static PFN_ExecuteBundle o_ExecuteBundle = nullptr;
 static PFN_Close o_Close = nullptr;
+static PFN_ResourceBarrier o_ResourceBarrier = nullptr;
+static PFN_Barrier o_Barrier = nullptr;
 
 static PFN_ExecuteCommandLists o_ExecuteCommandLists = nullptr;
 static PFN_Release o_Release = nullptr;
@@ -127,6 +141,83 @@ static std::atomic<unsigned> gHeapGeneration { 1 };
 static thread_local HeapCacheTLS cacheGR;
 static thread_local HeapCacheTLS cacheCR;
 
+// Present count before switching to a lighter tracking mode
+#define TRACKING_MODE_DOWNGRADE_FRAMES 30
+
+static const char* TrackingModeName(TrackingMode mode)
+{
+    switch (mode)
+    {
+    case TrackingMode::Off:
+        return "Off";
+    case TrackingMode::Descriptors:
+        return "Descriptors";
+    default:
+        return "Full";
+    }
+}
+
+#ifdef TRACK_HOOK_OVERHEAD
+// Time includes the original call, hooks of detached groups are not called at all
+enum HookCategory : UINT
+{
+    HookDescriptors = 0,
+    HookHudless,
+    HookCategoryCount
+};
+
+static const char* _hookCategoryNames[HookCategoryCount] = { "Descriptors", "Hudless" };
+static std::atomic<UINT64> _hookCalls[HookCategoryCount] {};
+static std::atomic<UINT64> _hookTicks[HookCategoryCount] {};
+static UINT _overheadFrames = 0;
+
+class HookOverheadScope
+{
+  private:
+    HookCategory _category;
+    LARGE_INTEGER _start;
+
+  public:
+    HookOverheadScope(HookCategory category) : _category(category) { QueryPerformanceCounter(&_start); }
+
+    ~HookOverheadScope()
+    {
+        LARGE_INTEGER end;
+        QueryPerformanceCounter(&end);
+
+        _hookCalls[_category].fetch_add(1, std::memory_order_relaxed);
+        _hookTicks[_category].fetch_add(end.QuadPart - _start.QuadPart, std::memory_order_relaxed);
+    }
+};
+
+static void LogHookOverhead(TrackingMode mode)
+{
+    if (_overheadFrames == 0)
+        return;
+
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+
+    for (UINT i = 0; i < HookCategoryCount; i++)
+    {
+        auto calls = _hookCalls[i].exchange(0);
+        auto ticks = _hookTicks[i].exchange(0);
+
+        double totalMs = (double) ticks * 1000.0 / (double) freq.QuadPart;
+        double perCallUs = calls == 0 ? 0.0 : totalMs * 1000.0 / (double) calls;
+
+        LOG_INFO("Mode: {}, {} hooks: {} calls/frame, {:.3f} us/call, {:.3f} ms/frame", TrackingModeName(mode),
+                 _hookCategoryNames[i], calls / _overheadFrames, perCallUs, totalMs / _overheadFrames);
+    }
+
+    _overheadFrames = 0;
+}
+
+#define HOOK_OVERHEAD(category) HookOverheadScope _overheadScope(category)
+#else
+#define HOOK_OVERHEAD(category)
+#endif
+
 bool ResTrack_Dx12::CheckResource(ID3D12Resource* resource)
 {
     if (State::Instance().currentSwapchain == nullptr || State::Instance().isShuttingDown)
@@ -226,6 +317,7 @@ bool ResTrack_Dx12::CreateBufferResource(ID3D12Device* InDevice, ResourceInfo* I
     }
 
     (*OutResource)->SetName(L"fgHudlessSCBufferCopy");
+    VramTracker::Track(*OutResource, VramOwner::ResourceTracking);
     return true;
 }
 
@@ -491,6 +583,9 @@ void ResTrack_Dx12::FillResourceInfo(ID3D12Resource* resource, ResourceInfo* inf
 
 bool ResTrack_Dx12::IsHudFixActive()
 {
+    if (_trackingMode.load(std::memory_order_relaxed) != TrackingMode::Full)
+        return false;
+
     if (!Config::Instance()->FGEnabled.value_or_default() || !Config::Instance()->FGHUDFix.value_or_default())
     {
         return false;
@@ -533,6 +628,8 @@ void ResTrack_Dx12::hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource*
                                              D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
                                              D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
 {
+    HOOK_OVERHEAD(HookDescriptors);
+
     // force hdr for swapchain buffer
     if (pResource != nullptr && pDesc != nullptr && Config::Instance()->ForceHDR.value_or_default())
     {
@@ -552,6 +649,10 @@ void ResTrack_Dx12::hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource*
 
     o_CreateRenderTargetView(This, pResource, pDesc, DestDescriptor);
 
+    // Only ForceHDR is applied while tracking is off
+    if (_trackingMode.load(std::memory_order_relaxed) == TrackingMode::Off)
+        return;
+
     if (pResource == nullptr || pDesc == nullptr || pDesc->ViewDimension != D3D12_SRV_DIMENSION_TEXTURE2D ||
         !CheckResource(pResource))
     {
@@ -586,6 +687,8 @@ void ResTrack_Dx12::hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resourc
                                                D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc,
                                                D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
 {
+    HOOK_OVERHEAD(HookDescriptors);
+
     // force hdr for swapchain buffer
     if (pResource != nullptr && pDesc != nullptr && Config::Instance()->ForceHDR.value_or_default())
     {
@@ -605,6 +708,10 @@ void ResTrack_Dx12::hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resourc
 
     o_CreateShaderResourceView(This, pResource, pDesc, DestDescriptor);
 
+    // Only ForceHDR is applied while tracking is off
+    if (_trackingMode.load(std::memory_order_relaxed) == TrackingMode::Off)
+        return;
+
     if (pResource == nullptr || pDesc == nullptr || pDesc->ViewDimension != D3D12_SRV_DIMENSION_TEXTURE2D ||
         !CheckResource(pResource))
     {
@@ -640,6 +747,8 @@ void ResTrack_Dx12::hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resour
                                                 D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc,
                                                 D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor)
 {
+    HOOK_OVERHEAD(HookDescriptors);
+
     if (pResource != nullptr && pDesc != nullptr && Config::Instance()->ForceHDR.value_or_default())
     {
         for (size_t i = 0; i < State::Instance().SCbuffers.size(); i++)
@@ -658,6 +767,10 @@ void ResTrack_Dx12::hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resour
 
     o_CreateUnorderedAccessView(This, pResource, pCounterResource, pDesc, DestDescriptor);
 
+    // Only ForceHDR is applied while tracking is off
+    if (_trackingMode.load(std::memory_order_relaxed) == TrackingMode::Off)
+        return;
+
     if (pResource == nullptr || pDesc == nullptr || pDesc->ViewDimension != D3D12_SRV_DIMENSION_TEXTURE2D ||
         !CheckResource(pResource))
     {
@@ -694,6 +807,31 @@ void ResTrack_Dx12::hkExecuteCommandLists(ID3D12CommandQueue* This, UINT NumComm
     auto signal = false;
     auto fg = State::Instance().currentFG;
 
+    if (auto upscalerCmdList = _upscalerCmdList.load(std::memory_order_relaxed); upscalerCmdList != nullptr)
+    {
+        for (size_t i = 0; i < NumCommandLists; i++)
+        {
+            if (ppCommandLists[i] != upscalerCmdList)
+                continue;
+
+            _upscalerCmdList.store(nullptr, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(_upscalerQueueMutex);
+
+            if (_upscalerQueue != This)
+            {
+                This->AddRef();
+
+                if (_upscalerQueue != nullptr)
+                    _upscalerQueue->Release();
+
+                _upscalerQueue = This;
+            }
+
+            break;
+        }
+    }
+
     if (_notFoundInputsCmdList != nullptr || _notFoundHudlessCmdList != nullptr)
     {
         for (size_t i = 0; i < NumCommandLists; i++)
@@ -773,14 +911,20 @@ void ResTrack_Dx12::hkExecuteCommandLists(ID3D12CommandQueue* This, UINT NumComm
                         ppCmdLists.push_back(ppCommandLists[i]);
                     }
 
-                    auto fgCmdList = fg->GetCommandList();
-                    ppCmdLists.push_back(fgCmdList);
+                    // Present hook might have executed it already
+                    auto frame = fg->FrameCount();
 
-                    LOG_DEBUG("Add fg command list: {:X}", (size_t) fgCmdList);
+                    if (fg->ClaimExecution(frame))
+                    {
+                        FGHazard_Dx12::FrameDone(frame);
 
-                    o_ExecuteCommandLists(This, NumCommandLists + 1, ppCmdLists.data());
+                        auto fgCmdList = fg->GetCommandList(frame);
+                        ppCmdLists.push_back(fgCmdList);
 
-                    fg->SetExecuted();
+                        LOG_DEBUG("Add fg command list: {:X}", (size_t) fgCmdList);
+                    }
+
+                    o_ExecuteCommandLists(This, (UINT) ppCmdLists.size(), ppCmdLists.data());
 
                     _notFoundHudlessCmdList = nullptr;
                     _notFoundInputsCmdList = nullptr;
@@ -882,6 +1026,8 @@ void ResTrack_Dx12::hkCopyDescriptors(ID3D12Device* This, UINT NumDestDescriptor
                                       D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts,
                                       UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
 {
+    HOOK_OVERHEAD(HookDescriptors);
+
     o_CopyDescriptors(This, NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes,
                       NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes, DescriptorHeapsType);
 
@@ -893,7 +1039,7 @@ void ResTrack_Dx12::hkCopyDescriptors(ID3D12Device* This, UINT NumDestDescriptor
         pDestDescriptorRangeSizes == nullptr)
         return;
 
-    if (!Config::Instance()->FGAlwaysTrackHeaps.value_or_default() && !IsHudFixActive())
+    if (_trackingMode.load(std::memory_order_relaxed) < TrackingMode::Descriptors)
         return;
 
     // make copies, just in case
@@ -1123,6 +1269,8 @@ void ResTrack_Dx12::hkCopyDescriptorsSimple(ID3D12Device* This, UINT NumDescript
                                             D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart,
                                             D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
 {
+    HOOK_OVERHEAD(HookDescriptors);
+
     o_CopyDescriptorsSimple(This, NumDescriptors, DestDescriptorRangeStart, SrcDescriptorRangeStart,
                             DescriptorHeapsType);
 
@@ -1130,7 +1278,7 @@ void ResTrack_Dx12::hkCopyDescriptorsSimple(ID3D12Device* This, UINT NumDescript
         DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
         return;
 
-    if (!Config::Instance()->FGAlwaysTrackHeaps.value_or_default() && !IsHudFixActive())
+    if (_trackingMode.load(std::memory_order_relaxed) < TrackingMode::Descriptors)
         return;
 
     auto size = This->GetDescriptorHandleIncrementSize(DescriptorHeapsType);
@@ -1179,6 +1327,8 @@ void ResTrack_Dx12::hkCopyDescriptorsSimple(ID3D12Device* This, UINT NumDescript
 void ResTrack_Dx12::hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* This, UINT RootParameterIndex,
                                                      D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
 {
+    HOOK_OVERHEAD(HookHudless);
+
     if (BaseDescriptor.ptr == 0 || !IsHudFixActive() || Hudfix_Dx12::SkipHudlessChecks())
     {
         o_SetGraphicsRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
@@ -1251,6 +1401,8 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
                                          BOOL RTsSingleHandleToDescriptorRange,
                                          D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor)
 {
+    HOOK_OVERHEAD(HookHudless);
+
     if (NumRenderTargetDescriptors == 0 || pRenderTargetDescriptors == nullptr || !IsHudFixActive() ||
         Hudfix_Dx12::SkipHudlessChecks())
     {
@@ -1347,6 +1499,8 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
 void ResTrack_Dx12::hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* This, UINT RootParameterIndex,
                                                     D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
 {
+    HOOK_OVERHEAD(HookHudless);
+
     if (BaseDescriptor.ptr == 0 || !IsHudFixActive() || Hudfix_Dx12::SkipHudlessChecks())
     {
         o_SetComputeRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
@@ -1425,6 +1579,8 @@ void ResTrack_Dx12::hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* T
 void ResTrack_Dx12::hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT VertexCountPerInstance, UINT InstanceCount,
                                     UINT StartVertexLocation, UINT StartInstanceLocation)
 {
+    HOOK_OVERHEAD(HookHudless);
+
     o_DrawInstanced(This, VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
 
     if (!IsHudFixActive())
@@ -1482,6 +1638,8 @@ void ResTrack_Dx12::hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT
                                            UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation,
                                            UINT StartInstanceLocation)
 {
+    HOOK_OVERHEAD(HookHudless);
+
     o_DrawIndexedInstanced(This, IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation,
                            StartInstanceLocation);
 
@@ -1637,9 +1795,28 @@ HRESULT ResTrack_Dx12::hkClose(ID3D12GraphicsCommandList* This)
     return o_Close(This);
 }
 
+void ResTrack_Dx12::hkResourceBarrier(ID3D12GraphicsCommandList* This, UINT NumBarriers,
+                                      const D3D12_RESOURCE_BARRIER* pBarriers)
+{
+    if (FGHazard_Dx12::IsWatching())
+        FGHazard_Dx12::CheckBarriers(NumBarriers, pBarriers);
+
+    o_ResourceBarrier(This, NumBarriers, pBarriers);
+}
+
+void ResTrack_Dx12::hkBarrier(ID3D12GraphicsCommandList* This, UINT32 NumBarrierGroups, const void* pBarrierGroups)
+{
+    if (NumBarrierGroups > 0)
+        FGHazard_Dx12::EnhancedBarrier();
+
+    o_Barrier(This, NumBarrierGroups, pBarrierGroups);
+}
+
 void ResTrack_Dx12::hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroupCountX, UINT ThreadGroupCountY,
                                UINT ThreadGroupCountZ)
 {
+    HOOK_OVERHEAD(HookHudless);
+
     o_Dispatch(This, ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
 
     if (!IsHudFixActive())
@@ -1716,12 +1893,9 @@ void ResTrack_Dx12::HookResource(ID3D12Device* InDevice)
 
         if (o_Release != nullptr)
         {
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-            DetourAttach(&(PVOID&) o_Release, hkRelease);
-            DetourTransactionCommit();
+            HookRegistry::Queue(HookGroup::ResTrackHeaps, &(PVOID&) o_Release, hkRelease);
 
-            o_Release(tmp); // drop temp
+            o_Release(tmp); // drop temp, hook is not committed yet
         }
         else
         {
@@ -1764,37 +1938,36 @@ void ResTrack_Dx12::HookCommandList(ID3D12Device* InDevice)
             o_SetComputeRootDescriptorTable = (PFN_SetComputeRootDescriptorTable) pVTable[31];
 
             o_ExecuteBundle = (PFN_ExecuteBundle) pVTable[27];
+            o_ResourceBarrier = (PFN_ResourceBarrier) pVTable[26];
 
             if (o_OMSetRenderTargets != nullptr)
             {
-                DetourTransactionBegin();
-                DetourUpdateThread(GetCurrentThread());
-
-                if (o_OMSetRenderTargets != nullptr)
-                    DetourAttach(&(PVOID&) o_OMSetRenderTargets, hkOMSetRenderTargets);
-
-                if (o_SetGraphicsRootDescriptorTable != nullptr)
-                    DetourAttach(&(PVOID&) o_SetGraphicsRootDescriptorTable, hkSetGraphicsRootDescriptorTable);
-
-                if (o_SetComputeRootDescriptorTable != nullptr)
-                    DetourAttach(&(PVOID&) o_SetComputeRootDescriptorTable, hkSetComputeRootDescriptorTable);
-
-                if (o_DrawIndexedInstanced != nullptr)
-                    DetourAttach(&(PVOID&) o_DrawIndexedInstanced, hkDrawIndexedInstanced);
-
-                if (o_DrawInstanced != nullptr)
-                    DetourAttach(&(PVOID&) o_DrawInstanced, hkDrawInstanced);
-
-                if (o_Dispatch != nullptr)
-                    DetourAttach(&(PVOID&) o_Dispatch, hkDispatch);
-
-                if (o_ExecuteBundle != nullptr)
-                    DetourAttach(&(PVOID&) o_ExecuteBundle, hkExecuteBundle);
-
-                if (o_Close != nullptr)
-                    DetourAttach(&(PVOID&) o_Close, hkClose);
+                // Only needed for hudless detection, pass through unless tracking mode is full
+                HookRegistry::Queue(HookGroup::ResTrackHudless, &(PVOID&) o_OMSetRenderTargets, hkOMSetRenderTargets);
+                HookRegistry::Queue(HookGroup::ResTrackHudless, &(PVOID&) o_SetGraphicsRootDescriptorTable,
+                                    hkSetGraphicsRootDescriptorTable);
+                HookRegistry::Queue(HookGroup::ResTrackHudless, &(PVOID&) o_SetComputeRootDescriptorTable,
+                                    hkSetComputeRootDescriptorTable);
+                HookRegistry::Queue(HookGroup::ResTrackHudless, &(PVOID&) o_DrawIndexedInstanced,
+                                    hkDrawIndexedInstanced);
+                HookRegistry::Queue(HookGroup::ResTrackHudless, &(PVOID&) o_DrawInstanced, hkDrawInstanced);
+                HookRegistry::Queue(HookGroup::ResTrackHudless, &(PVOID&) o_Dispatch, hkDispatch);
+
+                // Needed for FG command list handling
+                HookRegistry::Queue(HookGroup::ResTrackFG, &(PVOID&) o_ExecuteBundle, hkExecuteBundle);
+                HookRegistry::Queue(HookGroup::ResTrackFG, &(PVOID&) o_Close, hkClose);
+
+                // Writes to FG inputs before FG runs
+                HookRegistry::Queue(HookGroup::ResTrackFG, &(PVOID&) o_ResourceBarrier, hkResourceBarrier);
+            }
 
-                DetourTransactionCommit();
+            // Enhanced barriers can write FG inputs too, ID3D12GraphicsCommandList7::Barrier
+            IUnknown* commandList7 = nullptr;
+            if (realCL->QueryInterface(IID_GraphicsCommandList7, (void**) &commandList7) == S_OK)
+            {
+                o_Barrier = (PFN_Barrier) pVTable[80];
+                HookRegistry::Queue(HookGroup::ResTrackFG, &(PVOID&) o_Barrier, hkBarrier);
+                commandList7->Release();
             }
 
             commandList->Close();
@@ -1831,13 +2004,7 @@ void ResTrack_Dx12::HookToQueue(ID3D12Device* InDevice)
 
         o_ExecuteCommandLists = (PFN_ExecuteCommandLists) pVTable[10];
 
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        if (o_ExecuteCommandLists != nullptr)
-            DetourAttach(&(PVOID&) o_ExecuteCommandLists, hkExecuteCommandLists);
-
-        DetourTransactionCommit();
+        HookRegistry::Queue(HookGroup::ResTrackFG, &(PVOID&) o_ExecuteCommandLists, hkExecuteCommandLists);
 
         queue->Release();
     }
@@ -1871,38 +2038,111 @@ void ResTrack_Dx12::HookDevice(ID3D12Device* device)
     o_CopyDescriptors = (PFN_CopyDescriptors) pVTable[23];
     o_CopyDescriptorsSimple = (PFN_CopyDescriptorsSimple) pVTable[24];
 
-    // Apply the detour
+    // All hooks of the device are committed in one transaction
+    HookBatch batch;
+
     if (o_CreateDescriptorHeap != nullptr)
     {
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
+        HookRegistry::Queue(HookGroup::ResTrackHeaps, &(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
+
+        HookRegistry::Queue(HookGroup::ResTrackDescriptors, &(PVOID&) o_CreateRenderTargetView,
+                            hkCreateRenderTargetView);
+        HookRegistry::Queue(HookGroup::ResTrackDescriptors, &(PVOID&) o_CreateShaderResourceView,
+                            hkCreateShaderResourceView);
+        HookRegistry::Queue(HookGroup::ResTrackDescriptors, &(PVOID&) o_CreateUnorderedAccessView,
+                            hkCreateUnorderedAccessView);
+        HookRegistry::Queue(HookGroup::ResTrackDescriptors, &(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
+        HookRegistry::Queue(HookGroup::ResTrackDescriptors, &(PVOID&) o_CopyDescriptorsSimple,
+                            hkCopyDescriptorsSimple);
+    }
+
+    HookToQueue(device);
+    HookCommandList(device);
+    HookResource(device);
+
+    SetTrackingMode(DesiredTrackingMode());
+    _pendingMode = _trackingMode.load();
+}
+
+TrackingMode ResTrack_Dx12::DesiredTrackingMode()
+{
+    if (State::Instance().activeFgType != OptiFG || !Config::Instance()->FGEnabled.value_or_default())
+        return TrackingMode::Off;
+
+    auto hudfixEnabled = Config::Instance()->FGHUDFix.value_or_default();
+    auto fg = State::Instance().currentFG;
+
+    if (hudfixEnabled && fg != nullptr && State::Instance().currentFeature != nullptr &&
+        !State::Instance().FGchanged && fg->IsActive() && !fg->IsPaused())
+    {
+        return TrackingMode::Full;
+    }
 
-        if (o_CreateDescriptorHeap != nullptr)
-            DetourAttach(&(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
+    // Keep descriptors shadowed while hudfix is idle, so it can start without waiting for new descriptor writes
+    if (hudfixEnabled || Config::Instance()->FGAlwaysTrackHeaps.value_or_default())
+        return TrackingMode::Descriptors;
 
-        if (o_CreateRenderTargetView != nullptr)
-            DetourAttach(&(PVOID&) o_CreateRenderTargetView, hkCreateRenderTargetView);
+    return TrackingMode::Off;
+}
 
-        if (o_CreateShaderResourceView != nullptr)
-            DetourAttach(&(PVOID&) o_CreateShaderResourceView, hkCreateShaderResourceView);
+void ResTrack_Dx12::SetTrackingMode(TrackingMode mode)
+{
+    auto current = _trackingMode.load();
+
+    if (mode == current)
+        return;
 
-        if (o_CreateUnorderedAccessView != nullptr)
-            DetourAttach(&(PVOID&) o_CreateUnorderedAccessView, hkCreateUnorderedAccessView);
+    LOG_DEBUG("Tracking mode: {} -> {}", TrackingModeName(current), TrackingModeName(mode));
 
-        if (o_CopyDescriptors != nullptr)
-            DetourAttach(&(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
+#ifdef TRACK_HOOK_OVERHEAD
+    LogHookOverhead(current);
+#endif
 
-        if (o_CopyDescriptorsSimple != nullptr)
-            DetourAttach(&(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
+    // Hooks are never detached here, game threads might be inside them while recording. Detours can only
+    // move threads it's told about out of a trampoline, so idle modes pay the hook call and an atomic check,
+    // about 1.3-1.5 ns per call over an unhooked call in HookGate_Bench.
+    // Descriptors are shadowed in both Descriptors and Full modes, heaps only go stale while tracking is Off
+    if (current == TrackingMode::Off)
+        _shadowEpoch.fetch_add(1, std::memory_order_relaxed);
 
-        DetourTransactionCommit();
+    _trackingMode.store(mode);
+}
+
+void ResTrack_Dx12::UpdateTrackingMode()
+{
+    // Device is not hooked
+    if (o_CreateDescriptorHeap == nullptr)
+        return;
+
+#ifdef TRACK_HOOK_OVERHEAD
+    _overheadFrames++;
+
+    if (_overheadFrames >= 500)
+        LogHookOverhead(_trackingMode.load());
+#endif
+
+    auto desired = DesiredTrackingMode();
+
+    if (desired != _pendingMode)
+    {
+        _pendingMode = desired;
+        _pendingModeFrames = 0;
     }
 
-    HookToQueue(device);
-    HookCommandList(device);
-    HookResource(device);
+    auto current = _trackingMode.load();
+
+    if (desired == current)
+        return;
+
+    // Switch up immediately, switch down only after mode is stable to prevent heap shadow resets
+    if (desired < current && ++_pendingModeFrames < TRACKING_MODE_DOWNGRADE_FRAMES)
+        return;
+
+    SetTrackingMode(desired);
 }
 
+TrackingMode ResTrack_Dx12::CurrentTrackingMode() { return _trackingMode.load(); }
+
 void ResTrack_Dx12::ClearPossibleHudless()
 {
     LOG_DEBUG("");
@@ -1944,6 +2184,21 @@ void ResTrack_Dx12::ClearPossibleHudless()
     _hudlessCmdListFound = false;
 }
 
+void ResTrack_Dx12::SetUpscalerCmdList(ID3D12GraphicsCommandList* cmdList)
+{
+    _upscalerCmdList.store(cmdList, std::memory_order_relaxed);
+}
+
+ID3D12CommandQueue* ResTrack_Dx12::GetUpscalerQueue()
+{
+    std::lock_guard<std::mutex> lock(_upscalerQueueMutex);
+
+    if (_upscalerQueue != nullptr)
+        _upscalerQueue->AddRef();
+
+    return _upscalerQueue;
+}
+
 void ResTrack_Dx12::SetInputsCmdList(ID3D12GraphicsCommandList* cmdList)
 {
     auto fg = State::Instance().currentFG;
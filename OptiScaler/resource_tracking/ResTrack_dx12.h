@@ -31,10 +31,16 @@ static void TestResource(ResourceInfo* info)
 }
 #endif
 
+// Measures time spent in tracking hooks per tracking mode, results are logged periodically
+// #define TRACK_HOOK_OVERHEAD
+
 static ankerl::unordered_dense::map<ID3D12Resource*, std::vector<ResourceInfo*>> _trackedResources;
 static std::mutex _trMutex;
 static std::shared_mutex _heapMutex[1000];
 
+// Increased when tracking leaves Off mode, heaps with older epoch are lazily cleared
+extern std::atomic<UINT> _shadowEpoch;
+
 typedef struct HeapInfo
 {
     ID3D12DescriptorHeap* heap = nullptr;
@@ -48,11 +54,13 @@ typedef struct HeapInfo
     std::shared_ptr<ResourceInfo[]> info;
     UINT lastOffset = 0;
     UINT mutexIndex = 0;
+    mutable std::atomic<UINT> epoch = 0;
 
     HeapInfo(ID3D12DescriptorHeap* heap, SIZE_T cpuStart, SIZE_T cpuEnd, SIZE_T gpuStart, SIZE_T gpuEnd,
              UINT numResources, UINT increment, UINT type, UINT mutexIndex)
         : cpuStart(cpuStart), cpuEnd(cpuEnd), gpuStart(gpuStart), gpuEnd(gpuEnd), numDescriptors(numResources),
-          increment(increment), info(new ResourceInfo[numResources]), type(type), heap(heap), mutexIndex(mutexIndex)
+          increment(increment), info(new ResourceInfo[numResources]), type(type), heap(heap), mutexIndex(mutexIndex),
+          epoch(_shadowEpoch.load(std::memory_order_relaxed))
     {
         for (size_t i = 0; i < numDescriptors; i++)
         {
@@ -60,11 +68,49 @@ typedef struct HeapInfo
         }
     }
 
+    // Descriptor writes were not tracked for a while, stored info can't be trusted
+    bool IsStale() const
+    {
+        return epoch.load(std::memory_order_relaxed) != _shadowEpoch.load(std::memory_order_relaxed);
+    }
+
+    // Drop stale info, heap will be refilled by new descriptor writes
+    void ResetIfStale() const
+    {
+        if (!IsStale())
+            return;
+
+        std::lock_guard<std::mutex> lock(_trMutex);
+
+        auto currentEpoch = _shadowEpoch.load(std::memory_order_relaxed);
+        if (epoch.load(std::memory_order_relaxed) == currentEpoch)
+            return;
+
+        LOG_TRACK("Heap: {:X}, epoch: {} -> {}", (size_t) heap, epoch.load(), currentEpoch);
+
+        for (size_t i = 0; i < numDescriptors; i++)
+        {
+            if (info[i].buffer == nullptr)
+                continue;
+
+            if (_trackedResources.contains(info[i].buffer))
+            {
+                auto vector = &_trackedResources[info[i].buffer];
+                std::erase(*vector, &info[i]);
+            }
+
+            info[i].buffer = nullptr;
+            info[i].lastUsedFrame = 0;
+        }
+
+        epoch.store(currentEpoch, std::memory_order_relaxed);
+    }
+
     ResourceInfo* GetByCpuHandle(SIZE_T cpuHandle) const
     {
         auto index = (cpuHandle - cpuStart) / increment;
 
-        if (index >= numDescriptors)
+        if (index >= numDescriptors || IsStale())
             return nullptr;
 
         {
@@ -83,7 +129,7 @@ typedef struct HeapInfo
     {
         auto index = (gpuHandle - gpuStart) / increment;
 
-        if (index >= numDescriptors)
+        if (index >= numDescriptors || IsStale())
             return nullptr;
 
         {
@@ -100,6 +146,8 @@ typedef struct HeapInfo
 
     void SetByCpuHandle(SIZE_T cpuHandle, ResourceInfo setInfo) const
     {
+        ResetIfStale();
+
         auto index = (cpuHandle - cpuStart) / increment;
 
         if (index >= numDescriptors)
@@ -128,6 +176,8 @@ typedef struct HeapInfo
 
     void SetByGpuHandle(SIZE_T gpuHandle, ResourceInfo setInfo) const
     {
+        ResetIfStale();
+
         auto index = (gpuHandle - gpuStart) / increment;
 
         if (index >= numDescriptors)
@@ -156,6 +206,8 @@ typedef struct HeapInfo
 
     void ClearByCpuHandle(SIZE_T cpuHandle) const
     {
+        ResetIfStale();
+
         auto index = (cpuHandle - cpuStart) / increment;
 
         if (index >= numDescriptors)
@@ -191,6 +243,8 @@ typedef struct HeapInfo
 
     void ClearByGpuHandle(SIZE_T gpuHandle) const
     {
+        ResetIfStale();
+
         auto index = (gpuHandle - gpuStart) / increment;
 
         if (index >= numDescriptors)
@@ -231,21 +285,41 @@ typedef struct ResourceHeapInfo
     SIZE_T gpuStart = NULL;
 };
 
+enum class TrackingMode : uint32_t
+{
+    Off,         // Hooks only pass through, Create*View hooks still apply ForceHDR
+    Descriptors, // Descriptor writes are shadowed, hudless hooks pass through
+    Full         // Descriptor shadowing & hudless detection
+};
+
 class ResTrack_Dx12
 {
   private:
+    // Hooks stay attached and check the mode, recording threads read it without locks
+    inline static std::atomic<TrackingMode> _trackingMode { TrackingMode::Full };
+    inline static TrackingMode _pendingMode = TrackingMode::Full;
+    inline static UINT _pendingModeFrames = 0;
+
     inline static bool _presentDone = true;
     inline static std::mutex _drawMutex;
 
     inline static ID3D12GraphicsCommandList* _hudlessCommandList[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
     inline static ID3D12GraphicsCommandList* _inputsCommandList[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
 
+    // Last upscaler command list & the queue which executed it, replaced upscalers are released after that queue
+    inline static std::atomic<ID3D12CommandList*> _upscalerCmdList { nullptr };
+    inline static ID3D12CommandQueue* _upscalerQueue = nullptr;
+    inline static std::mutex _upscalerQueueMutex;
+
     inline static ULONG64 _lastHudlessFrame = 0;
     inline static std::mutex _hudlessMutex;
     inline static void* _hudlessMutexQueue = nullptr;
 
     static bool IsHudFixActive();
 
+    static TrackingMode DesiredTrackingMode();
+    static void SetTrackingMode(TrackingMode mode);
+
     // static bool IsFGCommandList(IUnknown* cmdList);
 
     static void hkCopyDescriptors(ID3D12Device* This, UINT NumDestDescriptorRanges,
@@ -278,6 +352,10 @@ class ResTrack_Dx12
 
     static HRESULT hkClose(ID3D12GraphicsCommandList* This);
 
+    static void hkResourceBarrier(ID3D12GraphicsCommandList* This, UINT NumBarriers,
+                                  const D3D12_RESOURCE_BARRIER* pBarriers);
+    static void hkBarrier(ID3D12GraphicsCommandList* This, UINT32 NumBarrierGroups, const void* pBarrierGroups);
+
     static void hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource* pResource,
                                          D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
                                          D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor);
@@ -325,8 +403,16 @@ class ResTrack_Dx12
 
   public:
     static void HookDevice(ID3D12Device* device);
+
+    // Switches tracking mode depending on FG & hudfix state, called once per present
+    static void UpdateTrackingMode();
+    static TrackingMode CurrentTrackingMode();
     static void ClearPossibleHudless();
     static void SetInputsCmdList(ID3D12GraphicsCommandList* cmdList);
     static void SetHudlessCmdList(ID3D12GraphicsCommandList* cmdList);
+    static void SetUpscalerCmdList(ID3D12GraphicsCommandList* cmdList);
+
+    // Returns an AddRef'ed queue, nullptr until the upscaler command list is executed once
+    static ID3D12CommandQueue* GetUpscalerQueue();
     static void ExecuteWaitingCommandLists();
 };
@@ -0,0 +1,55 @@
+#include "AsyncCompute_Common.h"
+
+bool AsyncTuner::NextAsync()
+{
+    if (_probing)
+        return (_frame++ & 1) != 0;
+
+    if (++_settled >= _settleFrames)
+    {
+        _settled = 0;
+        _probing = true;
+    }
+
+    return _async;
+}
+
+bool AsyncTuner::AddSample(bool async, double ms)
+{
+    if (!_probing || ms <= 0.0)
+        return false;
+
+    auto index = async ? 1 : 0;
+    _sum[index] += ms;
+    _count[index]++;
+
+    if (_count[0] < _probeFrames || _count[1] < _probeFrames)
+        return false;
+
+    _average[0] = _sum[0] / _count[0];
+    _average[1] = _sum[1] / _count[1];
+
+    // Current mode is kept unless other one is clearly faster
+    auto current = _async ? 1 : 0;
+
+    if (_average[1 - current] < _average[current] * (1.0 - _margin))
+        _async = !_async;
+
+    _sum[0] = _sum[1] = 0.0;
+    _count[0] = _count[1] = 0;
+    _probing = false;
+
+    return true;
+}
+
+void AsyncTuner::Reset()
+{
+    _probing = true;
+    _async = false;
+    _frame = 0;
+    _settled = 0;
+
+    _sum[0] = _sum[1] = 0.0;
+    _count[0] = _count[1] = 0;
+    _average[0] = _average[1] = 0.0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+// Chooses between running post passes inline or on async compute from measured latencies
+// Both modes are sampled on alternate frames, faster one is kept until the next probe
+class AsyncTuner
+{
+  private:
+    uint32_t _probeFrames = 0;  // samples of each mode per probe
+    uint32_t _settleFrames = 0; // frames between probes
+    double _margin = 0.0;       // other mode must be faster by this ratio to switch
+
+    bool _probing = true;
+    bool _async = false;
+    uint64_t _frame = 0;
+    uint32_t _settled = 0;
+
+    double _sum[2] = {};
+    uint32_t _count[2] = {};
+    double _average[2] = {};
+
+  public:
+    // Mode of the next frame
+    bool NextAsync();
+
+    // Latency of a finished frame in ms, returns true when probe is finished
+    bool AddSample(bool async, double ms);
+
+    void Reset();
+
+    bool Probing() const { return _probing; }
+    bool Async() const { return _async; }
+
+    // Result of last probe, 0 when mode is not measured yet
+    double Average(bool async) const { return _average[async ? 1 : 0]; }
+
+    AsyncTuner(uint32_t probeFrames, uint32_t settleFrames, double margin)
+        : _probeFrames(probeFrames), _settleFrames(settleFrames), _margin(margin)
+    {
+    }
+};
@@ -0,0 +1,334 @@
+#include "AsyncCompute_Dx12.h"
+
+#include "DescriptorHeap_Dx12.h"
+
+#include <Config.h>
+
+#include <d3dx/d3dx12.h>
+
+#define SAFE_RELEASE(p)                                                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (p && p != nullptr)                                                                                         \
+        {                                                                                                              \
+            (p)->Release();                                                                                            \
+            (p) = nullptr;                                                                                             \
+        }                                                                                                              \
+    } while ((void) 0, 0)
+
+bool AsyncCompute_Dx12::Calibrate()
+{
+    ID3D12CommandQueue* queues[2] = { _directQueue, _computeQueue };
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        if (queues[i]->GetTimestampFrequency(&_frequencies[i]) != S_OK || _frequencies[i] == 0)
+            return false;
+
+        if (queues[i]->GetClockCalibration(&_gpuClocks[i], &_cpuClocks[i]) != S_OK)
+            return false;
+    }
+
+    return true;
+}
+
+void AsyncCompute_Dx12::WaitForSlot(uint32_t InSlot)
+{
+    if (_fence->GetCompletedValue() >= _slotValues[InSlot])
+        return;
+
+    _fence->SetEventOnCompletion(_slotValues[InSlot], _fenceEvent);
+    WaitForSingleObject(_fenceEvent, INFINITE);
+}
+
+void AsyncCompute_Dx12::ReadTimings(uint32_t InSlot)
+{
+    if (!_slotMeasured[InSlot])
+        return;
+
+    _slotMeasured[InSlot] = false;
+
+    UINT64* timestamps = nullptr;
+    D3D12_RANGE readRange = { InSlot * 2 * sizeof(UINT64), (InSlot * 2 + 2) * sizeof(UINT64) };
+
+    if (_readbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&timestamps)) != S_OK)
+        return;
+
+    auto start = timestamps[InSlot * 2];
+    auto end = timestamps[InSlot * 2 + 1];
+
+    D3D12_RANGE writeRange = { 0, 0 };
+    _readbackBuffer->Unmap(0, &writeRange);
+
+    auto async = _slotAsync[InSlot];
+    double ms = 0.0;
+
+    if (!async)
+    {
+        ms = (double) (end - start) / (double) _frequencies[0] * 1000.0;
+    }
+    else
+    {
+        // Timestamps of different queues are aligned on the cpu clock
+        auto startMs = ((double) (INT64) (start - _gpuClocks[0]) / (double) _frequencies[0] +
+                        (double) _cpuClocks[0] / _cpuFrequency) *
+                       1000.0;
+        auto endMs = ((double) (INT64) (end - _gpuClocks[1]) / (double) _frequencies[1] +
+                      (double) _cpuClocks[1] / _cpuFrequency) *
+                     1000.0;
+
+        ms = endMs - startMs;
+    }
+
+    if (!Config::Instance()->AsyncPostAutoTune.value_or_default())
+    {
+        auto& last = _lastMs[async ? 1 : 0];
+        last = last == 0.0 ? ms : last * 0.95 + ms * 0.05;
+        return;
+    }
+
+    if (_tuner.AddSample(async, ms))
+    {
+        _lastMs[0] = _tuner.Average(false);
+        _lastMs[1] = _tuner.Average(true);
+
+        LOG_INFO("{} inline: {:.3f} ms, async: {:.3f} ms, using {}", _name, _lastMs[0], _lastMs[1],
+                 _tuner.Async() ? "async compute" : "direct queue");
+    }
+}
+
+void AsyncCompute_Dx12::BeginFrame(ID3D12GraphicsCommandList* InDirectList)
+{
+    if (!_init || InDirectList == nullptr)
+        return;
+
+    auto slot = (uint32_t) (_frame % 2);
+
+    // Allocator and timestamps of the slot are reused
+    WaitForSlot(slot);
+    ReadTimings(slot);
+
+    // Clocks of queues drift, keep them aligned
+    if (_frame % 300 == 0 && !Calibrate())
+        LOG_WARN("{} can't calibrate queue clocks", _name);
+
+    _frameAsync = false;
+
+    if (Config::Instance()->AsyncPostPasses.value_or_default())
+        _frameAsync = !Config::Instance()->AsyncPostAutoTune.value_or_default() || _tuner.NextAsync();
+
+    _postAsync = false;
+    _postEligible = false;
+
+    InDirectList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, slot * 2);
+}
+
+ID3D12GraphicsCommandList* AsyncCompute_Dx12::BeginPost(ID3D12GraphicsCommandList* InDirectList, bool InEligible)
+{
+    if (!_init)
+        return InDirectList;
+
+    _postEligible = InEligible;
+    _postAsync = _frameAsync && InEligible;
+
+    if (!_postAsync)
+        return InDirectList;
+
+    auto slot = (uint32_t) (_frame % 2);
+
+    _allocators[slot]->Reset();
+    _commandLists[slot]->Reset(_allocators[slot], nullptr);
+
+    return _commandLists[slot];
+}
+
+void AsyncCompute_Dx12::Execute(ID3D12GraphicsCommandList* InDirectList, ID3D12Fence* InOutputFence,
+                                UINT64 InOutputValue)
+{
+    auto slot = (uint32_t) (_frame % 2);
+
+    if (!_postAsync)
+    {
+        InDirectList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, slot * 2 + 1);
+        InDirectList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, slot * 2, 2, _readbackBuffer,
+                                       slot * 2 * sizeof(UINT64));
+    }
+    else
+    {
+        InDirectList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, slot * 2, 1, _readbackBuffer,
+                                       slot * 2 * sizeof(UINT64));
+    }
+
+    InDirectList->Close();
+    ID3D12CommandList* directLists[] = { InDirectList };
+
+    // Post passes of last frame still read OptiScaler's buffers which upscaler will write
+    if (_computeValue > 0)
+        _directQueue->Wait(_fence, _computeValue);
+
+    _directQueue->ExecuteCommandLists(1, directLists);
+
+    if (!_postAsync)
+    {
+        _directQueue->Signal(InOutputFence, InOutputValue);
+        DescriptorHeap_Dx12::EndFrame(_directQueue);
+    }
+    else
+    {
+        auto computeList = _commandLists[slot];
+        computeList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, slot * 2 + 1);
+        computeList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, slot * 2 + 1, 1, _readbackBuffer,
+                                      (slot * 2 + 1) * sizeof(UINT64));
+        computeList->Close();
+
+        ID3D12CommandList* computeLists[] = { computeList };
+
+        _directQueue->Signal(_fence, ++_fenceValue);
+        _computeQueue->Wait(_fence, _fenceValue);
+        _computeQueue->ExecuteCommandLists(1, computeLists);
+        _computeQueue->Signal(InOutputFence, InOutputValue);
+        DescriptorHeap_Dx12::EndFrame(_computeQueue);
+        _computeQueue->Signal(_fence, ++_fenceValue);
+
+        _computeValue = _fenceValue;
+        _slotValues[slot] = _fenceValue;
+    }
+
+    _slotMeasured[slot] = _postEligible;
+    _slotAsync[slot] = _postAsync;
+    _lastAsync = _postAsync;
+
+    _postAsync = false;
+    _postEligible = false;
+    _frame++;
+}
+
+AsyncCompute_Dx12::AsyncCompute_Dx12(std::string InName, ID3D12Device* InDevice, ID3D12CommandQueue* InDirectQueue)
+    : _name(InName), _device(InDevice), _directQueue(InDirectQueue)
+{
+    if (InDevice == nullptr || InDirectQueue == nullptr)
+    {
+        LOG_ERROR("InDevice or InDirectQueue is nullptr!");
+        return;
+    }
+
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+    auto hr = InDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&_computeQueue));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommandQueue error {1:x}", _name, hr);
+        return;
+    }
+
+    _computeQueue->SetName(L"AsyncCompute_Dx12 CommandQueue");
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        hr = InDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COMPUTE, IID_PPV_ARGS(&_allocators[i]));
+
+        if (hr != S_OK)
+        {
+            LOG_ERROR("[{0}] CreateCommandAllocator error {1:x}", _name, hr);
+            return;
+        }
+
+        hr = InDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COMPUTE, _allocators[i], nullptr,
+                                         IID_PPV_ARGS(&_commandLists[i]));
+
+        if (hr != S_OK)
+        {
+            LOG_ERROR("[{0}] CreateCommandList error {1:x}", _name, hr);
+            return;
+        }
+
+        _commandLists[i]->Close();
+    }
+
+    hr = InDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateFence error {1:x}", _name, hr);
+        return;
+    }
+
+    _fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+    if (_fenceEvent == nullptr)
+    {
+        LOG_ERROR("[{0}] CreateEvent error!", _name);
+        return;
+    }
+
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Count = 4;
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+
+    hr = InDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&_queryHeap));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateQueryHeap error {1:x}", _name, hr);
+        return;
+    }
+
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(4 * sizeof(UINT64));
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+    hr = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                           D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&_readbackBuffer));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, hr);
+        return;
+    }
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    _cpuFrequency = (double) frequency.QuadPart;
+
+    if (!Calibrate())
+    {
+        LOG_ERROR("[{0}] Can't read queue timestamp frequencies", _name);
+        return;
+    }
+
+    _init = true;
+}
+
+AsyncCompute_Dx12::~AsyncCompute_Dx12()
+{
+    if (State::Instance().isShuttingDown)
+        return;
+
+    // Post passes might be still running
+    if (_fence != nullptr && _fenceEvent != nullptr && _fence->GetCompletedValue() < _fenceValue)
+    {
+        _fence->SetEventOnCompletion(_fenceValue, _fenceEvent);
+        WaitForSingleObject(_fenceEvent, INFINITE);
+    }
+
+    SAFE_RELEASE(_readbackBuffer);
+    SAFE_RELEASE(_queryHeap);
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        SAFE_RELEASE(_commandLists[i]);
+        SAFE_RELEASE(_allocators[i]);
+    }
+
+    SAFE_RELEASE(_computeQueue);
+    SAFE_RELEASE(_fence);
+
+    if (_fenceEvent != nullptr)
+    {
+        CloseHandle(_fenceEvent);
+        _fenceEvent = nullptr;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <pch.h>
+
+#include "AsyncCompute_Common.h"
+
+#include <d3d12.h>
+
+// Compute queue for OptiScaler's post passes (RCAS, output scaling) of a feature which owns its direct queue
+// Upscaler runs on the direct queue, post passes wait for it on the compute queue and signal the output fence.
+// Latency from start of the direct list to end of post passes is measured with timestamps in both modes.
+class AsyncCompute_Dx12
+{
+  private:
+    std::string _name = "";
+    bool _init = false;
+
+    ID3D12Device* _device = nullptr;
+    ID3D12CommandQueue* _directQueue = nullptr;
+    ID3D12CommandQueue* _computeQueue = nullptr;
+    ID3D12CommandAllocator* _allocators[2] = {};
+    ID3D12GraphicsCommandList* _commandLists[2] = {};
+
+    // Signaled from both queues, values are always increasing
+    ID3D12Fence* _fence = nullptr;
+    HANDLE _fenceEvent = nullptr;
+    UINT64 _fenceValue = 0;
+    UINT64 _slotValues[2] = {};
+    UINT64 _computeValue = 0; // last post passes on compute queue, next direct list waits it
+
+    // [slot * 2] start of direct list, [slot * 2 + 1] end of post passes
+    ID3D12QueryHeap* _queryHeap = nullptr;
+    ID3D12Resource* _readbackBuffer = nullptr;
+    UINT64 _frequencies[2] = {}; // direct, compute
+    UINT64 _gpuClocks[2] = {};
+    UINT64 _cpuClocks[2] = {};
+    double _cpuFrequency = 0.0;
+
+    uint64_t _frame = 0;
+    bool _frameAsync = false;
+    bool _postAsync = false;
+    bool _postEligible = false;
+    bool _slotMeasured[2] = {};
+    bool _slotAsync[2] = {};
+
+    AsyncTuner _tuner { 60, 1800, 0.05 };
+
+    inline static bool _lastAsync = false;
+    inline static double _lastMs[2] = {};
+
+    bool Calibrate();
+    void WaitForSlot(uint32_t InSlot);
+    void ReadTimings(uint32_t InSlot);
+
+  public:
+    // Start of OptiScaler's work of the frame, InDirectList must be just reset
+    void BeginFrame(ID3D12GraphicsCommandList* InDirectList);
+
+    // List for post passes, compute list when frame runs async and all active passes are opted in
+    ID3D12GraphicsCommandList* BeginPost(ID3D12GraphicsCommandList* InDirectList, bool InEligible);
+
+    // Closes and submits lists of the frame, InOutputFence is signaled when post passes are done
+    void Execute(ID3D12GraphicsCommandList* InDirectList, ID3D12Fence* InOutputFence, UINT64 InOutputValue);
+
+    bool IsInit() const { return _init; }
+    bool Probing() const { return _tuner.Probing(); }
+
+    // Latest measurements of any instance for menu
+    static bool LastFrameAsync() { return _lastAsync; }
+    static double LastMs(bool InAsync) { return _lastMs[InAsync ? 1 : 0]; }
+
+    AsyncCompute_Dx12(std::string InName, ID3D12Device* InDevice, ID3D12CommandQueue* InDirectQueue);
+
+    ~AsyncCompute_Dx12();
+};
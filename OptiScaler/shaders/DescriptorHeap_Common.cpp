@@ -0,0 +1,75 @@
+#include "DescriptorHeap_Common.h"
+
+std::optional<uint32_t> DescriptorRing::Allocate(uint32_t count)
+{
+    if (count == 0 || count > _capacity)
+        return std::nullopt;
+
+    // Nothing in use, start from beginning to keep ranges contiguous
+    if (_used == 0)
+    {
+        _head = 0;
+        _tail = 0;
+    }
+
+    uint32_t offset = 0;
+    uint32_t skipped = 0;
+
+    // Free slots are [head, tail) when head is behind tail, otherwise [head, capacity) + [0, tail)
+    auto wrapped = _head < _tail || (_head == _tail && _used > 0);
+
+    if (wrapped)
+    {
+        if (_tail - _head < count)
+            return std::nullopt;
+
+        offset = _head;
+    }
+    else if (_capacity - _head >= count)
+    {
+        offset = _head;
+    }
+    else if (_tail >= count)
+    {
+        skipped = _capacity - _head;
+        offset = 0;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    _head = (offset + count) % _capacity;
+    _used += skipped + count;
+    _frameUsed += skipped + count;
+
+    return offset;
+}
+
+void DescriptorRing::EndFrame(uint64_t fenceValue)
+{
+    if (_frameUsed == 0)
+        return;
+
+    _frames.push_back({ fenceValue, _head, _frameUsed });
+    _frameUsed = 0;
+}
+
+void DescriptorRing::Retire(uint64_t completedValue)
+{
+    while (!_frames.empty() && _frames.front().fenceValue <= completedValue)
+    {
+        _tail = _frames.front().end;
+        _used -= _frames.front().size;
+        _frames.pop_front();
+    }
+}
+
+void DescriptorRing::Reset()
+{
+    _frames.clear();
+    _head = 0;
+    _tail = 0;
+    _used = 0;
+    _frameUsed = 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+// Ring of descriptor slots, allocations are linear and freed per frame
+// Offsets are slot indices in the heap
+class DescriptorRing
+{
+  private:
+    typedef struct FrameRange
+    {
+        uint64_t fenceValue = 0;
+        uint32_t end = 0;  // head after last allocation of the frame
+        uint32_t size = 0; // allocated slots including the skipped end of ring
+    } frame_range;
+
+    uint32_t _capacity = 0;
+    uint32_t _head = 0;
+    uint32_t _tail = 0;
+    uint32_t _used = 0;
+    uint32_t _frameUsed = 0;
+    std::deque<FrameRange> _frames;
+
+  public:
+    // Contiguous range, when it doesn't fit to the end of ring the rest is skipped and it starts from 0
+    std::optional<uint32_t> Allocate(uint32_t count);
+
+    // Allocations since last call are in use until fenceValue is completed
+    void EndFrame(uint64_t fenceValue);
+    void Retire(uint64_t completedValue);
+    void Reset();
+
+    uint32_t Capacity() const { return _capacity; }
+    uint32_t Used() const { return _used; }
+    size_t PendingFrames() const { return _frames.size(); }
+
+    explicit DescriptorRing(uint32_t capacity) : _capacity(capacity) {}
+};
@@ -0,0 +1,315 @@
+#include "DescriptorHeap_Dx12.h"
+
+#include <State.h>
+
+#include <hooks/HookRegistry.h>
+
+// Passes use 2-5 descriptors per dispatch, this covers many frames in flight
+static constexpr uint32_t HeapSize = 1024;
+
+// Full heaps waiting for a frame fence, new heaps are not created past this
+static constexpr size_t MaxRetiredHeaps = 8;
+
+typedef void (*PFN_SetDescriptorHeaps)(ID3D12GraphicsCommandList* This, UINT NumDescriptorHeaps,
+                                       ID3D12DescriptorHeap* const* ppDescriptorHeaps);
+typedef HRESULT (*PFN_Close)(ID3D12GraphicsCommandList* This);
+typedef HRESULT (*PFN_Reset)(ID3D12GraphicsCommandList* This, ID3D12CommandAllocator* pAllocator,
+                             ID3D12PipelineState* pInitialState);
+
+static PFN_SetDescriptorHeaps o_SetDescriptorHeaps = nullptr;
+static PFN_Close o_Close = nullptr;
+static PFN_Reset o_Reset = nullptr;
+
+ID3D12DescriptorHeap* DescriptorHeap_Dx12::CreateHeap(ID3D12Device* InDevice)
+{
+    ID3D12DescriptorHeap* heap = nullptr;
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = HeapSize;
+    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+    State::Instance().skipHeapCapture = true;
+    auto hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&heap));
+    State::Instance().skipHeapCapture = false;
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("CreateDescriptorHeap error {:X}", (UINT) hr);
+        return nullptr;
+    }
+
+    heap->SetName(L"OptiScaler_DescriptorHeap");
+    return heap;
+}
+
+DescriptorHeap_Dx12::DeviceHeap* DescriptorHeap_Dx12::GetHeap(ID3D12Device* InDevice)
+{
+    if (auto it = _heaps.find(InDevice); it != _heaps.end())
+        return it->second.get();
+
+    auto deviceHeap = std::make_unique<DeviceHeap>(HeapSize);
+
+    deviceHeap->heap = CreateHeap(InDevice);
+
+    if (deviceHeap->heap == nullptr)
+        return nullptr;
+
+    auto hr = InDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&deviceHeap->fence));
+
+    if (hr != S_OK)
+    {
+        LOG_ERROR("CreateFence error {:X}", (UINT) hr);
+        deviceHeap->heap->Release();
+        return nullptr;
+    }
+
+    deviceHeap->increment = InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    LOG_DEBUG("Created descriptor heap with {} slots", HeapSize);
+
+    auto result = deviceHeap.get();
+    _heaps[InDevice] = std::move(deviceHeap);
+    return result;
+}
+
+void DescriptorHeap_Dx12::ReleaseRetired(DeviceHeap* InDeviceHeap)
+{
+    auto completed = InDeviceHeap->fence->GetCompletedValue();
+    auto& retired = InDeviceHeap->retired;
+
+    for (auto it = retired.begin(); it != retired.end();)
+    {
+        if (it->fenceValue > completed)
+        {
+            it++;
+            continue;
+        }
+
+        it->heap->Release();
+        it = retired.erase(it);
+    }
+}
+
+bool DescriptorHeap_Dx12::Allocate(ID3D12Device* InDevice, UINT InCount, DescriptorRange* OutRange)
+{
+    if (InDevice == nullptr || OutRange == nullptr)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto deviceHeap = GetHeap(InDevice);
+
+    if (deviceHeap == nullptr)
+        return false;
+
+    deviceHeap->ring.Retire(deviceHeap->fence->GetCompletedValue());
+    auto offset = deviceHeap->ring.Allocate(InCount);
+
+    // Slots might still be used by GPU (or frame fence is not signaled at all when present is not hooked),
+    // continue with a new heap and keep the full one until the fence of current frame is completed
+    if (!offset.has_value() && deviceHeap->retired.size() < MaxRetiredHeaps)
+    {
+        if (auto heap = CreateHeap(InDevice); heap != nullptr)
+        {
+            LOG_DEBUG("Descriptor heap is full, {} slots in use, switching to a new heap", deviceHeap->ring.Used());
+
+            deviceHeap->retired.push_back({ deviceHeap->heap, deviceHeap->fenceValue + 1 });
+            deviceHeap->heap = heap;
+            deviceHeap->ring.Reset();
+            offset = deviceHeap->ring.Allocate(InCount);
+        }
+    }
+
+    if (!offset.has_value())
+    {
+        LOG_WARN("Descriptor heap is full, {} slots in use", deviceHeap->ring.Used());
+        return false;
+    }
+
+    OutRange->heap = deviceHeap->heap;
+    OutRange->increment = deviceHeap->increment;
+    OutRange->cpu = deviceHeap->heap->GetCPUDescriptorHandleForHeapStart();
+    OutRange->cpu.ptr += (SIZE_T) offset.value() * deviceHeap->increment;
+    OutRange->gpu = deviceHeap->heap->GetGPUDescriptorHandleForHeapStart();
+    OutRange->gpu.ptr += (UINT64) offset.value() * deviceHeap->increment;
+
+    return true;
+}
+
+ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, DescriptorHeap_Dx12::GameHeaps>&
+DescriptorHeap_Dx12::ThreadHeaps()
+{
+    auto epoch = _gameHeapEpoch.load(std::memory_order_relaxed);
+
+    // Heaps of this thread were recorded before Clear
+    if (_gameHeaps.epoch != epoch)
+    {
+        _gameHeaps.heaps.clear();
+        _gameHeaps.epoch = epoch;
+    }
+
+    return _gameHeaps.heaps;
+}
+
+void DescriptorHeap_Dx12::hkSetDescriptorHeaps(ID3D12GraphicsCommandList* This, UINT NumDescriptorHeaps,
+                                               ID3D12DescriptorHeap* const* ppDescriptorHeaps)
+{
+    if (This != nullptr && ppDescriptorHeaps != nullptr && NumDescriptorHeaps <= 2)
+    {
+        auto& gameHeaps = ThreadHeaps()[This];
+        gameHeaps.count = NumDescriptorHeaps;
+
+        for (UINT i = 0; i < NumDescriptorHeaps; i++)
+            gameHeaps.heaps[i] = ppDescriptorHeaps[i];
+    }
+
+    o_SetDescriptorHeaps(This, NumDescriptorHeaps, ppDescriptorHeaps);
+}
+
+HRESULT DescriptorHeap_Dx12::hkClose(ID3D12GraphicsCommandList* This)
+{
+    // Recording is done, a reset or new command list at same address must not get these heaps
+    ThreadHeaps().erase(This);
+
+    return o_Close(This);
+}
+
+HRESULT DescriptorHeap_Dx12::hkReset(ID3D12GraphicsCommandList* This, ID3D12CommandAllocator* pAllocator,
+                                     ID3D12PipelineState* pInitialState)
+{
+    // Command list might be closed on another thread, reset happens on the one which records it next
+    ThreadHeaps().erase(This);
+
+    return o_Reset(This, pAllocator, pInitialState);
+}
+
+void DescriptorHeap_Dx12::HookDevice(ID3D12Device* InDevice)
+{
+    if (o_SetDescriptorHeaps != nullptr || InDevice == nullptr)
+        return;
+
+    ID3D12CommandAllocator* commandAllocator = nullptr;
+    ID3D12GraphicsCommandList* commandList = nullptr;
+
+    if (InDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator)) != S_OK)
+    {
+        LOG_ERROR("CreateCommandAllocator error");
+        return;
+    }
+
+    if (InDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator, nullptr,
+                                    IID_PPV_ARGS(&commandList)) == S_OK)
+    {
+        PVOID* pVTable = *(PVOID**) commandList;
+
+        o_SetDescriptorHeaps = (PFN_SetDescriptorHeaps) pVTable[28];
+        o_Close = (PFN_Close) pVTable[9];
+        o_Reset = (PFN_Reset) pVTable[10];
+
+        HookRegistry::Queue(HookGroup::DescriptorHeaps, &(PVOID&) o_SetDescriptorHeaps, hkSetDescriptorHeaps);
+        HookRegistry::Queue(HookGroup::DescriptorHeaps, &(PVOID&) o_Close, hkClose);
+        HookRegistry::Queue(HookGroup::DescriptorHeaps, &(PVOID&) o_Reset, hkReset);
+        HookRegistry::Commit();
+
+        commandList->Close();
+        commandList->Release();
+    }
+    else
+    {
+        LOG_ERROR("CreateCommandList error");
+    }
+
+    commandAllocator->Release();
+}
+
+void DescriptorHeap_Dx12::Bind(ID3D12GraphicsCommandList* InCmdList, const DescriptorRange& InRange)
+{
+    ID3D12DescriptorHeap* heaps[] = { InRange.heap };
+
+    // Device was created before OptiScaler was loaded, game heaps are known after this
+    if (o_SetDescriptorHeaps == nullptr)
+    {
+        ID3D12Device* device = nullptr;
+
+        if (InCmdList->GetDevice(IID_PPV_ARGS(&device)) == S_OK)
+        {
+            HookDevice(device);
+            device->Release();
+        }
+    }
+
+    if (o_SetDescriptorHeaps == nullptr)
+    {
+        InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+        return;
+    }
+
+    o_SetDescriptorHeaps(InCmdList, _countof(heaps), heaps);
+}
+
+void DescriptorHeap_Dx12::Restore(ID3D12GraphicsCommandList* InCmdList)
+{
+    if (o_SetDescriptorHeaps == nullptr)
+        return;
+
+    auto& heaps = ThreadHeaps();
+
+    auto it = heaps.find(InCmdList);
+    if (it == heaps.end())
+        return;
+
+    o_SetDescriptorHeaps(InCmdList, it->second.count, it->second.heaps);
+}
+
+void DescriptorHeap_Dx12::EndFrame(ID3D12CommandQueue* InQueue)
+{
+    if (InQueue == nullptr)
+        return;
+
+    ID3D12Device* device = nullptr;
+
+    if (InQueue->GetDevice(IID_PPV_ARGS(&device)) != S_OK)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _heaps.find(device);
+    device->Release();
+
+    // No pass used this device yet
+    if (it == _heaps.end())
+        return;
+
+    auto deviceHeap = it->second.get();
+
+    if (InQueue->Signal(deviceHeap->fence, deviceHeap->fenceValue + 1) != S_OK)
+        return;
+
+    deviceHeap->fenceValue++;
+    deviceHeap->ring.EndFrame(deviceHeap->fenceValue);
+    deviceHeap->ring.Retire(deviceHeap->fence->GetCompletedValue());
+    ReleaseRetired(deviceHeap);
+}
+
+void DescriptorHeap_Dx12::Clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto& [device, deviceHeap] : _heaps)
+    {
+        if (deviceHeap->heap != nullptr)
+            deviceHeap->heap->Release();
+
+        for (auto& retired : deviceHeap->retired)
+            retired.heap->Release();
+
+        if (deviceHeap->fence != nullptr)
+            deviceHeap->fence->Release();
+    }
+
+    _heaps.clear();
+
+    // Heaps of game command lists are dropped by their threads on next access
+    _gameHeapEpoch.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <pch.h>
+
+#include "DescriptorHeap_Common.h"
+
+#include <d3d12.h>
+#include <ankerl/unordered_dense.h>
+
+#include <atomic>
+#include <mutex>
+
+typedef struct DescriptorRange
+{
+    ID3D12DescriptorHeap* heap = nullptr;
+    D3D12_CPU_DESCRIPTOR_HANDLE cpu {};
+    D3D12_GPU_DESCRIPTOR_HANDLE gpu {};
+    UINT increment = 0;
+
+    D3D12_CPU_DESCRIPTOR_HANDLE Cpu(UINT index) const { return { cpu.ptr + (SIZE_T) index * increment }; }
+    D3D12_GPU_DESCRIPTOR_HANDLE Gpu(UINT index) const { return { gpu.ptr + (UINT64) index * increment }; }
+} descriptor_range;
+
+// One shader visible CBV/SRV/UAV heap per device shared by OptiScaler's compute passes
+// Passes allocate their descriptors for every dispatch and all of them bind the same heap,
+// slots are recycled when the fence signaled at present of the frame they were used is completed
+class DescriptorHeap_Dx12
+{
+  private:
+    // Heap replaced when ring was full, released when a frame fence signaled after it is completed
+    typedef struct RetiredHeap
+    {
+        ID3D12DescriptorHeap* heap = nullptr;
+        uint64_t fenceValue = 0;
+    } retired_heap;
+
+    typedef struct DeviceHeap
+    {
+        ID3D12DescriptorHeap* heap = nullptr;
+        ID3D12Fence* fence = nullptr;
+        uint64_t fenceValue = 0;
+        UINT increment = 0;
+        DescriptorRing ring;
+        std::vector<RetiredHeap> retired;
+
+        explicit DeviceHeap(uint32_t capacity) : ring(capacity) {}
+    } device_heap;
+
+    // Heaps set by the game to a command list
+    typedef struct GameHeaps
+    {
+        ID3D12DescriptorHeap* heaps[2] = { nullptr, nullptr };
+        UINT count = 0;
+    } game_heaps;
+
+    inline static std::mutex _mutex;
+    inline static ankerl::unordered_dense::map<ID3D12Device*, std::unique_ptr<DeviceHeap>> _heaps;
+
+    // A command list is recorded by one thread at a time and passes run inside the game's upscaler call on that
+    // thread, so game heaps are kept per recording thread without locking. Clear bumps the epoch to drop them all
+    typedef struct ThreadGameHeaps
+    {
+        uint32_t epoch = 0;
+        ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, GameHeaps> heaps;
+    } thread_game_heaps;
+
+    inline static std::atomic<uint32_t> _gameHeapEpoch = 0;
+    inline static thread_local ThreadGameHeaps _gameHeaps;
+
+    static ID3D12DescriptorHeap* CreateHeap(ID3D12Device* InDevice);
+    static DeviceHeap* GetHeap(ID3D12Device* InDevice);
+    static void ReleaseRetired(DeviceHeap* InDeviceHeap);
+
+    static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, GameHeaps>& ThreadHeaps();
+
+    static void hkSetDescriptorHeaps(ID3D12GraphicsCommandList* This, UINT NumDescriptorHeaps,
+                                     ID3D12DescriptorHeap* const* ppDescriptorHeaps);
+    static HRESULT hkClose(ID3D12GraphicsCommandList* This);
+    static HRESULT hkReset(ID3D12GraphicsCommandList* This, ID3D12CommandAllocator* pAllocator,
+                           ID3D12PipelineState* pInitialState);
+
+  public:
+    // Hooks command lists with a temporary one, called at device creation so every game command list is seen
+    static void HookDevice(ID3D12Device* InDevice);
+
+    static bool Allocate(ID3D12Device* InDevice, UINT InCount, DescriptorRange* OutRange);
+
+    // Passes overwrite heaps of the game's command list, Bind before the dispatch and Restore after it
+    static void Bind(ID3D12GraphicsCommandList* InCmdList, const DescriptorRange& InRange);
+    static void Restore(ID3D12GraphicsCommandList* InCmdList);
+
+    // Signals the frame fence on present queue, allocations until now are recycled after it's completed
+    static void EndFrame(ID3D12CommandQueue* InQueue);
+
+    // Releases all heaps, called when device is released
+    static void Clear();
+};
@@ -0,0 +1,112 @@
+#include "DescriptorPool_Vk.h"
+
+// Passes keep 16 sets with up to 3 images each, one pool covers a few features
+static constexpr uint32_t PoolMaxSets = 256;
+static constexpr uint32_t PoolSampledImages = 512;
+static constexpr uint32_t PoolStorageImages = 256;
+
+VkDescriptorPool DescriptorPool_Vk::CreatePool(VkDevice InDevice)
+{
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    poolSizes[0].descriptorCount = PoolSampledImages;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSizes[1].descriptorCount = PoolStorageImages;
+
+    VkDescriptorPoolCreateInfo poolInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets = PoolMaxSets;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    auto result = vkCreateDescriptorPool(InDevice, &poolInfo, nullptr, &pool);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkCreateDescriptorPool error: {:X}", (UINT) result);
+        return VK_NULL_HANDLE;
+    }
+
+    LOG_DEBUG("Created descriptor pool {:X}", (size_t) pool);
+
+    return pool;
+}
+
+bool DescriptorPool_Vk::Allocate(VkDevice InDevice, VkDescriptorSetLayout InLayout, uint32_t InCount,
+                                 VkDescriptorPool* OutPool, VkDescriptorSet* OutSets)
+{
+    if (InDevice == VK_NULL_HANDLE || InLayout == VK_NULL_HANDLE || InCount == 0 || InCount > PoolMaxSets)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<VkDescriptorSetLayout> layouts(InCount, InLayout);
+
+    VkDescriptorSetAllocateInfo allocInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorSetCount = InCount;
+    allocInfo.pSetLayouts = layouts.data();
+
+    auto& pools = _pools[InDevice];
+
+    for (auto pool : pools)
+    {
+        allocInfo.descriptorPool = pool;
+
+        if (vkAllocateDescriptorSets(InDevice, &allocInfo, OutSets) == VK_SUCCESS)
+        {
+            *OutPool = pool;
+            return true;
+        }
+    }
+
+    // All pools are full or fragmented
+    auto pool = CreatePool(InDevice);
+
+    if (pool == VK_NULL_HANDLE)
+        return false;
+
+    pools.push_back(pool);
+    allocInfo.descriptorPool = pool;
+
+    auto result = vkAllocateDescriptorSets(InDevice, &allocInfo, OutSets);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkAllocateDescriptorSets error: {:X}", (UINT) result);
+        return false;
+    }
+
+    *OutPool = pool;
+    return true;
+}
+
+void DescriptorPool_Vk::Free(VkDevice InDevice, VkDescriptorPool InPool, uint32_t InCount,
+                             const VkDescriptorSet* InSets)
+{
+    if (InDevice == VK_NULL_HANDLE || InPool == VK_NULL_HANDLE || InCount == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Pool is already gone if device was released before the pass
+    auto it = _pools.find(InDevice);
+
+    if (it == _pools.end() || std::find(it->second.begin(), it->second.end(), InPool) == it->second.end())
+        return;
+
+    vkFreeDescriptorSets(InDevice, InPool, InCount, InSets);
+}
+
+void DescriptorPool_Vk::Clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto& [device, pools] : _pools)
+    {
+        for (auto pool : pools)
+            vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+
+    _pools.clear();
+}
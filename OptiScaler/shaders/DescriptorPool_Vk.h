@@ -0,0 +1,27 @@
+#pragma once
+
+#include <pch.h>
+
+#include <vulkan/vulkan.hpp>
+#include <ankerl/unordered_dense.h>
+
+#include <mutex>
+
+// Descriptor pools shared by OptiScaler's Vulkan passes
+// Passes allocate their sets once and free them when destroyed, a new pool is added when current ones are full
+class DescriptorPool_Vk
+{
+  private:
+    inline static std::mutex _mutex;
+    inline static ankerl::unordered_dense::map<VkDevice, std::vector<VkDescriptorPool>> _pools;
+
+    static VkDescriptorPool CreatePool(VkDevice InDevice);
+
+  public:
+    static bool Allocate(VkDevice InDevice, VkDescriptorSetLayout InLayout, uint32_t InCount,
+                         VkDescriptorPool* OutPool, VkDescriptorSet* OutSets);
+    static void Free(VkDevice InDevice, VkDescriptorPool InPool, uint32_t InCount, const VkDescriptorSet* InSets);
+
+    // Destroys all pools, called when device is released
+    static void Clear();
+};
@@ -0,0 +1,155 @@
+#include "PipelineCacheFile.h"
+
+#include <cstring>
+#include <fstream>
+
+static constexpr uint32_t FileMagic = 0x43505356; // "VSPC"
+static constexpr uint32_t FileVersion = 1;
+
+// VkPipelineCacheHeaderVersionOne
+static constexpr uint32_t VulkanHeaderSize = 32;
+static constexpr uint32_t VulkanHeaderVersionOne = 1;
+
+static uint32_t ReadUInt32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// FNV-1a, only detects damaged files
+uint64_t PipelineCacheFile::Checksum(const uint8_t* InData, size_t InSize)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (size_t i = 0; i < InSize; i++)
+    {
+        hash ^= InData[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+bool PipelineCacheFile::IsCompatible(const std::vector<uint8_t>& InData, const PipelineCacheKey& InKey)
+{
+    if (InData.size() < VulkanHeaderSize)
+        return false;
+
+    auto headerSize = ReadUInt32(&InData[0]);
+
+    if (headerSize < VulkanHeaderSize || headerSize > InData.size())
+        return false;
+
+    if (ReadUInt32(&InData[4]) != VulkanHeaderVersionOne)
+        return false;
+
+    if (ReadUInt32(&InData[8]) != InKey.vendorId || ReadUInt32(&InData[12]) != InKey.deviceId)
+        return false;
+
+    return memcmp(&InData[16], InKey.cacheUUID, sizeof(InKey.cacheUUID)) == 0;
+}
+
+PipelineCacheResult PipelineCacheFile::Load(const std::filesystem::path& InPath, const PipelineCacheKey& InKey,
+                                            std::vector<uint8_t>& OutData)
+{
+    OutData.clear();
+
+    std::ifstream file(InPath, std::ios::binary);
+
+    if (!file.is_open())
+        return PipelineCacheResult::NotFound;
+
+    FileHeader header {};
+
+    if (!file.read((char*) &header, sizeof(header)))
+        return PipelineCacheResult::TooSmall;
+
+    if (header.magic != FileMagic || header.version != FileVersion || header.dataSize == 0 ||
+        header.dataSize > MaxDataSize)
+    {
+        return PipelineCacheResult::UnknownFormat;
+    }
+
+    std::vector<uint8_t> data((size_t) header.dataSize);
+
+    if (!file.read((char*) data.data(), data.size()) || file.peek() != std::char_traits<char>::eof())
+        return PipelineCacheResult::SizeMismatch;
+
+    if (Checksum(data.data(), data.size()) != header.checksum)
+        return PipelineCacheResult::BadChecksum;
+
+    if (!IsCompatible(data, InKey))
+        return PipelineCacheResult::Incompatible;
+
+    OutData = std::move(data);
+    return PipelineCacheResult::Ok;
+}
+
+PipelineCacheResult PipelineCacheFile::Save(const std::filesystem::path& InPath, const PipelineCacheKey& InKey,
+                                            const std::vector<uint8_t>& InData)
+{
+    if (InData.empty() || InData.size() > MaxDataSize || !IsCompatible(InData, InKey))
+        return PipelineCacheResult::Incompatible;
+
+    FileHeader header {};
+    header.magic = FileMagic;
+    header.version = FileVersion;
+    header.dataSize = InData.size();
+    header.checksum = Checksum(InData.data(), InData.size());
+
+    auto tempPath = InPath;
+    tempPath += L".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open() || !file.write((const char*) &header, sizeof(header)) ||
+            !file.write((const char*) InData.data(), InData.size()) || !file.flush())
+        {
+            file.close();
+
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return PipelineCacheResult::WriteFailed;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, InPath, ec);
+
+    if (ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return PipelineCacheResult::ReplaceFailed;
+    }
+
+    return PipelineCacheResult::Ok;
+}
+
+const char* PipelineCacheFile::ResultName(PipelineCacheResult InResult)
+{
+    switch (InResult)
+    {
+    case PipelineCacheResult::Ok:
+        return "Ok";
+    case PipelineCacheResult::NotFound:
+        return "File not found";
+    case PipelineCacheResult::TooSmall:
+        return "File is too small";
+    case PipelineCacheResult::UnknownFormat:
+        return "Unknown file format";
+    case PipelineCacheResult::SizeMismatch:
+        return "File size doesn't match";
+    case PipelineCacheResult::BadChecksum:
+        return "Checksum doesn't match";
+    case PipelineCacheResult::Incompatible:
+        return "Cache is from another GPU or driver";
+    case PipelineCacheResult::WriteFailed:
+        return "Can't write temporary file";
+    case PipelineCacheResult::ReplaceFailed:
+        return "Can't replace old file";
+    default:
+        return "Unknown";
+    }
+}
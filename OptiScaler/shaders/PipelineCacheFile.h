@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Device and driver a VkPipelineCache was created with, same fields as VkPipelineCacheHeaderVersionOne
+typedef struct PipelineCacheKey
+{
+    uint32_t vendorId = 0;
+    uint32_t deviceId = 0;
+    uint8_t cacheUUID[16] {};
+} pipeline_cache_key;
+
+enum class PipelineCacheResult : uint32_t
+{
+    Ok,
+    NotFound,      // No file or it can't be opened
+    TooSmall,      // Shorter than the file header
+    UnknownFormat, // Magic, version or size in header is not valid
+    SizeMismatch,  // Data is shorter or longer than header says
+    BadChecksum,
+    Incompatible,  // Cache of another GPU or driver, or data is not a Vulkan pipeline cache
+    WriteFailed,
+    ReplaceFailed, // Temporary file is written but old file can't be replaced
+};
+
+// On disk container of vkGetPipelineCacheData results
+// File is a small header with size and checksum followed by the cache data, truncated or damaged files
+// and caches of another GPU or driver are rejected before they are given to the driver
+class PipelineCacheFile
+{
+  private:
+    typedef struct FileHeader
+    {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint64_t dataSize = 0;
+        uint64_t checksum = 0;
+    } file_header;
+
+    static uint64_t Checksum(const uint8_t* InData, size_t InSize);
+
+  public:
+    // Way above what OptiScaler's passes produce, larger files are not read
+    static constexpr uint64_t MaxDataSize = 64ull * 1024 * 1024;
+
+    // Checks the header Vulkan puts in front of the cache data against the device
+    static bool IsCompatible(const std::vector<uint8_t>& InData, const PipelineCacheKey& InKey);
+
+    // OutData is only filled when result is Ok
+    static PipelineCacheResult Load(const std::filesystem::path& InPath, const PipelineCacheKey& InKey,
+                                    std::vector<uint8_t>& OutData);
+
+    // Writes to a temporary file and replaces the old one, so a crash while saving keeps the previous cache
+    static PipelineCacheResult Save(const std::filesystem::path& InPath, const PipelineCacheKey& InKey,
+                                    const std::vector<uint8_t>& InData);
+
+    static const char* ResultName(PipelineCacheResult InResult);
+};
@@ -0,0 +1,117 @@
+#include "PipelineCache_Vk.h"
+
+#include <Util.h>
+
+std::filesystem::path PipelineCache_Vk::CachePath() { return Util::DllPath().parent_path() / L"OptiScaler.vkcache"; }
+
+VkPipelineCache PipelineCache_Vk::Get(VkPhysicalDevice InPD, VkDevice InDevice)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_device != VK_NULL_HANDLE)
+    {
+        if (_device != InDevice)
+            return VK_NULL_HANDLE;
+
+        return _cache;
+    }
+
+    if (InPD == VK_NULL_HANDLE || InDevice == VK_NULL_HANDLE)
+        return VK_NULL_HANDLE;
+
+    VkPhysicalDeviceProperties properties {};
+    vkGetPhysicalDeviceProperties(InPD, &properties);
+
+    _key.vendorId = properties.vendorID;
+    _key.deviceId = properties.deviceID;
+    memcpy(_key.cacheUUID, properties.pipelineCacheUUID, sizeof(_key.cacheUUID));
+
+    std::vector<uint8_t> data;
+
+    auto loadResult = PipelineCacheFile::Load(CachePath(), _key, data);
+
+    if (loadResult == PipelineCacheResult::Ok)
+        LOG_DEBUG("Loaded {} bytes of pipeline cache", data.size());
+    else if (loadResult == PipelineCacheResult::Incompatible)
+        LOG_INFO("Pipeline cache is from another GPU or driver, discarding");
+    else if (loadResult != PipelineCacheResult::NotFound)
+        LOG_WARN("Can't load pipeline cache: {}", PipelineCacheFile::ResultName(loadResult));
+
+    VkPipelineCacheCreateInfo createInfo { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    auto result = vkCreatePipelineCache(InDevice, &createInfo, nullptr, &_cache);
+
+    // Driver might still refuse the data, start with an empty cache
+    if (result != VK_SUCCESS && !data.empty())
+    {
+        LOG_WARN("vkCreatePipelineCache with file data error: {:X}", (UINT) result);
+
+        data.clear();
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        result = vkCreatePipelineCache(InDevice, &createInfo, nullptr, &_cache);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("vkCreatePipelineCache error: {:X}", (UINT) result);
+        _cache = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
+    }
+
+    _device = InDevice;
+    _savedSize = data.size();
+
+    return _cache;
+}
+
+void PipelineCache_Vk::SaveLocked()
+{
+    if (_device == VK_NULL_HANDLE || _cache == VK_NULL_HANDLE)
+        return;
+
+    size_t size = 0;
+
+    if (vkGetPipelineCacheData(_device, _cache, &size, nullptr) != VK_SUCCESS || size == 0 || size == _savedSize)
+        return;
+
+    std::vector<uint8_t> data(size);
+
+    if (vkGetPipelineCacheData(_device, _cache, &size, data.data()) != VK_SUCCESS)
+        return;
+
+    data.resize(size);
+
+    auto saveResult = PipelineCacheFile::Save(CachePath(), _key, data);
+
+    if (saveResult != PipelineCacheResult::Ok)
+    {
+        LOG_WARN("Can't save pipeline cache ({} bytes): {}", size, PipelineCacheFile::ResultName(saveResult));
+        return;
+    }
+
+    LOG_DEBUG("Saved {} bytes of pipeline cache", size);
+    _savedSize = size;
+}
+
+void PipelineCache_Vk::Save()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    SaveLocked();
+}
+
+void PipelineCache_Vk::Release()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    SaveLocked();
+
+    if (_device != VK_NULL_HANDLE && _cache != VK_NULL_HANDLE)
+        vkDestroyPipelineCache(_device, _cache, nullptr);
+
+    _device = VK_NULL_HANDLE;
+    _cache = VK_NULL_HANDLE;
+    _savedSize = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <pch.h>
+
+#include "PipelineCacheFile.h"
+
+#include <vulkan/vulkan.hpp>
+
+#include <mutex>
+
+// VkPipelineCache shared by OptiScaler's Vulkan passes, persisted next to the dll as OptiScaler.vkcache
+// Only the first device gets a cache, pipelines of others are created without one
+class PipelineCache_Vk
+{
+  private:
+    inline static std::mutex _mutex;
+    inline static VkDevice _device = VK_NULL_HANDLE;
+    inline static VkPipelineCache _cache = VK_NULL_HANDLE;
+    inline static PipelineCacheKey _key {};
+    inline static size_t _savedSize = 0;
+
+    static std::filesystem::path CachePath();
+    static void SaveLocked();
+
+  public:
+    static VkPipelineCache Get(VkPhysicalDevice InPD, VkDevice InDevice);
+
+    // Writes cache to disk when pipelines were added since last save
+    static void Save();
+
+    // Saves and destroys the cache, called when device is released
+    static void Release();
+};
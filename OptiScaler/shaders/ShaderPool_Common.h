@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Idle instances of one shader pass type, T only needs IsInit()
+// Instances are moved out on Take so two live owners never share one
+template <typename T> class ShaderPoolList
+{
+  private:
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<T>> _items;
+    size_t _limit;
+
+  public:
+    // Older idle instances are destroyed above limit
+    explicit ShaderPoolList(size_t limit = 4) : _limit(limit) {}
+
+    // Newest matching instance first, it's most likely to have matching buffers
+    template <typename Match> std::unique_ptr<T> Take(Match match)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto it = _items.rbegin(); it != _items.rend(); it++)
+        {
+            if (!match(it->get()))
+                continue;
+
+            auto shader = std::move(*it);
+            _items.erase(std::next(it).base());
+            return shader;
+        }
+
+        return nullptr;
+    }
+
+    // Failed instances are not worth keeping, shader is empty after the call
+    void Return(std::unique_ptr<T>& shader)
+    {
+        if (shader == nullptr)
+            return;
+
+        if (!shader->IsInit())
+        {
+            shader.reset();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _items.push_back(std::move(shader));
+
+        if (_items.size() > _limit)
+            _items.erase(_items.begin());
+    }
+
+    size_t Clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto count = _items.size();
+        _items.clear();
+        return count;
+    }
+
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size();
+    }
+};
@@ -0,0 +1,94 @@
+#include "ShaderPool_Dx12.h"
+
+#include <Config.h>
+
+std::unique_ptr<OS_Dx12> ShaderPool_Dx12::AcquireOutputScaler(std::string InName, ID3D12Device* InDevice,
+                                                               bool InUpsample)
+{
+    auto downscaler = Config::Instance()->OutputScalingDownscaler.value_or_default();
+    auto shader = _outputScalers.Take(
+        [&](OS_Dx12* os)
+        {
+            return os->Device() == InDevice && os->IsUpsampling() == InUpsample &&
+                   (InUpsample || os->Downscaler() == downscaler);
+        });
+
+    if (shader != nullptr)
+    {
+        LOG_DEBUG("Reusing pooled {}", InName);
+        return shader;
+    }
+
+    return std::make_unique<OS_Dx12>(InName, InDevice, InUpsample);
+}
+
+std::unique_ptr<RCAS_Dx12> ShaderPool_Dx12::AcquireRcas(std::string InName, ID3D12Device* InDevice)
+{
+    auto shader = _rcas.Take([&](RCAS_Dx12* rcas) { return rcas->Device() == InDevice; });
+
+    if (shader != nullptr)
+    {
+        LOG_DEBUG("Reusing pooled {}", InName);
+        return shader;
+    }
+
+    return std::make_unique<RCAS_Dx12>(InName, InDevice);
+}
+
+std::unique_ptr<RCAS_OS_Dx12> ShaderPool_Dx12::AcquireRcasScaler(std::string InName, ID3D12Device* InDevice,
+                                                                 bool InUpsample)
+{
+    // Pooled instance would be useless if current settings can't use the fused pass
+    if (RCAS_OS_Dx12::IsSupported(InUpsample))
+    {
+        auto shader = _rcasScalers.Take(
+            [&](RCAS_OS_Dx12* rcasOs) { return rcasOs->Device() == InDevice && rcasOs->IsUpsampling() == InUpsample; });
+
+        if (shader != nullptr)
+        {
+            LOG_DEBUG("Reusing pooled {}", InName);
+            return shader;
+        }
+    }
+
+    return std::make_unique<RCAS_OS_Dx12>(InName, InDevice, InUpsample);
+}
+
+std::unique_ptr<Bias_Dx12> ShaderPool_Dx12::AcquireBias(std::string InName, ID3D12Device* InDevice)
+{
+    auto shader = _bias.Take([&](Bias_Dx12* bias) { return bias->Device() == InDevice; });
+
+    if (shader != nullptr)
+    {
+        LOG_DEBUG("Reusing pooled {}", InName);
+        return shader;
+    }
+
+    return std::make_unique<Bias_Dx12>(InName, InDevice);
+}
+
+void ShaderPool_Dx12::Release(std::unique_ptr<OS_Dx12>& InShader)
+{
+    _outputScalers.Return(InShader);
+}
+
+void ShaderPool_Dx12::Release(std::unique_ptr<RCAS_Dx12>& InShader)
+{
+    _rcas.Return(InShader);
+}
+
+void ShaderPool_Dx12::Release(std::unique_ptr<RCAS_OS_Dx12>& InShader)
+{
+    _rcasScalers.Return(InShader);
+}
+
+void ShaderPool_Dx12::Release(std::unique_ptr<Bias_Dx12>& InShader)
+{
+    _bias.Return(InShader);
+}
+
+void ShaderPool_Dx12::Clear()
+{
+    auto count = _outputScalers.Clear() + _rcas.Clear() + _rcasScalers.Clear() + _bias.Clear();
+    LOG_DEBUG("Cleared {} pooled shaders", count);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <pch.h>
+
+#include <shaders/output_scaling/OS_Dx12.h>
+#include <shaders/rcas/RCAS_Dx12.h>
+#include <shaders/rcas/RCAS_OS_Dx12.h>
+#include <shaders/bias/Bias_Dx12.h>
+
+#include "ShaderPool_Common.h"
+
+// Keeps RCAS, Output Scaling and Bias passes of released features for reuse
+// Each live context still owns its own instances so viewports don't share intermediate buffers,
+// only recreating a context (backend change, resize, second viewport) skips the shader compile
+class ShaderPool_Dx12
+{
+  private:
+    inline static ShaderPoolList<OS_Dx12> _outputScalers;
+    inline static ShaderPoolList<RCAS_Dx12> _rcas;
+    inline static ShaderPoolList<RCAS_OS_Dx12> _rcasScalers;
+    inline static ShaderPoolList<Bias_Dx12> _bias;
+
+  public:
+    static std::unique_ptr<OS_Dx12> AcquireOutputScaler(std::string InName, ID3D12Device* InDevice, bool InUpsample);
+    static std::unique_ptr<RCAS_Dx12> AcquireRcas(std::string InName, ID3D12Device* InDevice);
+    static std::unique_ptr<RCAS_OS_Dx12> AcquireRcasScaler(std::string InName, ID3D12Device* InDevice,
+                                                           bool InUpsample);
+    static std::unique_ptr<Bias_Dx12> AcquireBias(std::string InName, ID3D12Device* InDevice);
+
+    static void Release(std::unique_ptr<OS_Dx12>& InShader);
+    static void Release(std::unique_ptr<RCAS_Dx12>& InShader);
+    static void Release(std::unique_ptr<RCAS_OS_Dx12>& InShader);
+    static void Release(std::unique_ptr<Bias_Dx12>& InShader);
+
+    // Destroys all idle instances, called when device is released
+    static void Clear();
+};
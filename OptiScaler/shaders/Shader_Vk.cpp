@@ -0,0 +1,349 @@
+#include "Shader_Vk.h"
+
+#include "DescriptorPool_Vk.h"
+#include "PipelineCache_Vk.h"
+
+#include <State.h>
+
+static VkImageLayout ResourceLayout(const NVSDK_NGX_Resource_VK* InResource)
+{
+    // Same assumption as FG resources, NGX doesn't pass the layout
+    return InResource->ReadWrite ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
+uint32_t Shader_Vk::FindMemoryType(uint32_t InTypeBits, VkMemoryPropertyFlags InProperties)
+{
+    VkPhysicalDeviceMemoryProperties memProperties {};
+    vkGetPhysicalDeviceMemoryProperties(_physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+    {
+        if ((InTypeBits & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & InProperties) == InProperties)
+            return i;
+    }
+
+    return UINT32_MAX;
+}
+
+bool Shader_Vk::CreatePipeline(const uint32_t* InCode, size_t InCodeSize, uint32_t InInputCount,
+                               uint32_t InConstantsSize)
+{
+    VkPhysicalDeviceFeatures features {};
+    vkGetPhysicalDeviceFeatures(_physicalDevice, &features);
+
+    // Shaders write output without a declared format
+    if (!features.shaderStorageImageWriteWithoutFormat)
+    {
+        LOG_ERROR("[{0}] shaderStorageImageWriteWithoutFormat is not supported!", _name);
+        return false;
+    }
+
+    VkPhysicalDeviceProperties properties {};
+    vkGetPhysicalDeviceProperties(_physicalDevice, &properties);
+
+    if (properties.limits.maxComputeWorkGroupInvocations < ThreadGroupSize * ThreadGroupSize ||
+        properties.limits.maxComputeWorkGroupSize[0] < ThreadGroupSize ||
+        properties.limits.maxComputeWorkGroupSize[1] < ThreadGroupSize)
+    {
+        LOG_ERROR("[{0}] maxComputeWorkGroupInvocations: {1} is too low!", _name,
+                  properties.limits.maxComputeWorkGroupInvocations);
+        return false;
+    }
+
+    _inputCount = InInputCount;
+    _constantsSize = InConstantsSize;
+
+    VkDescriptorSetLayoutBinding bindings[4] {};
+
+    for (uint32_t i = 0; i <= InInputCount; i++)
+    {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = i == 1 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    setLayoutInfo.bindingCount = InInputCount + 1;
+    setLayoutInfo.pBindings = bindings;
+
+    auto result = vkCreateDescriptorSetLayout(_device, &setLayoutInfo, nullptr, &_setLayout);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateDescriptorSetLayout error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    VkPushConstantRange pushConstants {};
+    pushConstants.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstants.size = InConstantsSize;
+
+    VkPipelineLayoutCreateInfo layoutInfo { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &_setLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstants;
+
+    result = vkCreatePipelineLayout(_device, &layoutInfo, nullptr, &_pipelineLayout);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreatePipelineLayout error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    VkShaderModuleCreateInfo moduleInfo { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    moduleInfo.codeSize = InCodeSize;
+    moduleInfo.pCode = InCode;
+
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    result = vkCreateShaderModule(_device, &moduleInfo, nullptr, &shaderModule);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateShaderModule error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = _pipelineLayout;
+
+    auto cache = PipelineCache_Vk::Get(_physicalDevice, _device);
+    result = vkCreateComputePipelines(_device, cache, 1, &pipelineInfo, nullptr, &_pipeline);
+
+    vkDestroyShaderModule(_device, shaderModule, nullptr);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateComputePipelines error: {1:X}", _name, (UINT) result);
+        _pipeline = VK_NULL_HANDLE;
+        return false;
+    }
+
+    if (cache != VK_NULL_HANDLE)
+        PipelineCache_Vk::Save();
+
+    if (!DescriptorPool_Vk::Allocate(_device, _setLayout, SetCount, &_pool, _sets))
+    {
+        LOG_ERROR("[{0}] Can't allocate descriptor sets!", _name);
+        _pool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+bool Shader_Vk::CreateBuffer(VkCommandBuffer InCmdBuffer, VkFormat InFormat, uint32_t InWidth, uint32_t InHeight)
+{
+    auto& info = _buffer.Resource.ImageViewInfo;
+
+    // Formats like sRGB can't be written by shaders
+    VkFormatProperties formatProperties {};
+    vkGetPhysicalDeviceFormatProperties(_physicalDevice, InFormat, &formatProperties);
+
+    const VkFormatFeatureFlags neededFeatures =
+        VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+
+    if ((formatProperties.optimalTilingFeatures & neededFeatures) != neededFeatures)
+        InFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+
+    if (info.Image != VK_NULL_HANDLE)
+    {
+        if (info.Width == InWidth && info.Height == InHeight && info.Format == InFormat)
+            return true;
+
+        LOG_DEBUG("[{0}] Release {1}x{2}, new one: {3}x{4}", _name, info.Width, info.Height, InWidth, InHeight);
+        ReleaseBuffer();
+    }
+
+    VkImageCreateInfo imageInfo { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = InFormat;
+    imageInfo.extent = { InWidth, InHeight, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                      VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto result = vkCreateImage(_device, &imageInfo, nullptr, &info.Image);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateImage error: {1:X}", _name, (UINT) result);
+        info.Image = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryRequirements memReqs {};
+    vkGetImageMemoryRequirements(_device, info.Image, &memReqs);
+
+    VkMemoryAllocateInfo allocInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocInfo.allocationSize = memReqs.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (allocInfo.memoryTypeIndex == UINT32_MAX ||
+        (result = vkAllocateMemory(_device, &allocInfo, nullptr, &_bufferMemory)) != VK_SUCCESS ||
+        (result = vkBindImageMemory(_device, info.Image, _bufferMemory, 0)) != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] Image memory error: {1:X}, memoryTypeIndex: {2}", _name, (UINT) result,
+                  allocInfo.memoryTypeIndex);
+        ReleaseBuffer();
+        return false;
+    }
+
+    info.SubresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    info.SubresourceRange.levelCount = 1;
+    info.SubresourceRange.layerCount = 1;
+
+    VkImageViewCreateInfo viewInfo { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    viewInfo.image = info.Image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = InFormat;
+    viewInfo.subresourceRange = info.SubresourceRange;
+
+    result = vkCreateImageView(_device, &viewInfo, nullptr, &info.ImageView);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("[{0}] vkCreateImageView error: {1:X}", _name, (UINT) result);
+        info.ImageView = VK_NULL_HANDLE;
+        ReleaseBuffer();
+        return false;
+    }
+
+    info.Format = InFormat;
+    info.Width = InWidth;
+    info.Height = InHeight;
+    _buffer.Type = NVSDK_NGX_RESOURCE_VK_TYPE_VK_IMAGEVIEW;
+    _buffer.ReadWrite = true;
+
+    // Buffer stays in general layout, upscalers and passes both read and write it
+    VkImageMemoryBarrier barrier { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = info.Image;
+    barrier.subresourceRange = info.SubresourceRange;
+
+    vkCmdPipelineBarrier(InCmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0,
+                         nullptr, 0, nullptr, 1, &barrier);
+
+    LOG_DEBUG("[{0}] Created new one: {1}x{2}, format: {3}", _name, InWidth, InHeight, (UINT) InFormat);
+
+    return true;
+}
+
+void Shader_Vk::ReleaseBuffer()
+{
+    auto& info = _buffer.Resource.ImageViewInfo;
+
+    if (info.ImageView != VK_NULL_HANDLE)
+        vkDestroyImageView(_device, info.ImageView, nullptr);
+
+    if (info.Image != VK_NULL_HANDLE)
+        vkDestroyImage(_device, info.Image, nullptr);
+
+    if (_bufferMemory != VK_NULL_HANDLE)
+        vkFreeMemory(_device, _bufferMemory, nullptr);
+
+    _buffer = {};
+    _bufferMemory = VK_NULL_HANDLE;
+}
+
+bool Shader_Vk::Dispatch(VkCommandBuffer InCmdBuffer, const NVSDK_NGX_Resource_VK* const* InInputs,
+                         NVSDK_NGX_Resource_VK* OutResource, const void* InConstants, uint32_t InWidth,
+                         uint32_t InHeight)
+{
+    if (!_init || InCmdBuffer == VK_NULL_HANDLE || OutResource == nullptr ||
+        OutResource->Resource.ImageViewInfo.ImageView == VK_NULL_HANDLE)
+        return false;
+
+    for (uint32_t i = 0; i < _inputCount; i++)
+    {
+        if (InInputs[i] == nullptr || InInputs[i]->Resource.ImageViewInfo.ImageView == VK_NULL_HANDLE)
+            return false;
+    }
+
+    auto set = _sets[_setIndex];
+    _setIndex = (_setIndex + 1) % SetCount;
+
+    VkDescriptorImageInfo imageInfos[4] {};
+    VkWriteDescriptorSet writes[4] {};
+
+    for (uint32_t i = 0; i <= _inputCount; i++)
+    {
+        // Binding 1 is the output, inputs are at 0 and 2..
+        auto resource = i == 1 ? OutResource : InInputs[i == 0 ? 0 : i - 1];
+
+        imageInfos[i].imageView = resource->Resource.ImageViewInfo.ImageView;
+        imageInfos[i].imageLayout = i == 1 ? VK_IMAGE_LAYOUT_GENERAL : ResourceLayout(resource);
+
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = set;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = i == 1 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        writes[i].pImageInfo = &imageInfos[i];
+    }
+
+    vkUpdateDescriptorSets(_device, _inputCount + 1, writes, 0, nullptr);
+
+    // Inputs were written by the upscaler or the game, output might still be read
+    VkMemoryBarrier barrier { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(InCmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1,
+                         &barrier, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(InCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline);
+    vkCmdBindDescriptorSets(InCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, 1, &set, 0, nullptr);
+    vkCmdPushConstants(InCmdBuffer, _pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, _constantsSize, InConstants);
+
+    vkCmdDispatch(InCmdBuffer, (InWidth + ThreadGroupSize - 1) / ThreadGroupSize,
+                  (InHeight + ThreadGroupSize - 1) / ThreadGroupSize, 1);
+
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+    vkCmdPipelineBarrier(InCmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1,
+                         &barrier, 0, nullptr, 0, nullptr);
+
+    return true;
+}
+
+Shader_Vk::Shader_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice)
+    : _name(InName), _physicalDevice(InPD), _device(InDevice)
+{
+}
+
+Shader_Vk::~Shader_Vk()
+{
+    if (_device == VK_NULL_HANDLE || State::Instance().isShuttingDown)
+        return;
+
+    ReleaseBuffer();
+
+    if (_pool != VK_NULL_HANDLE)
+        DescriptorPool_Vk::Free(_device, _pool, SetCount, _sets);
+
+    if (_pipeline != VK_NULL_HANDLE)
+        vkDestroyPipeline(_device, _pipeline, nullptr);
+
+    if (_pipelineLayout != VK_NULL_HANDLE)
+        vkDestroyPipelineLayout(_device, _pipelineLayout, nullptr);
+
+    if (_setLayout != VK_NULL_HANDLE)
+        vkDestroyDescriptorSetLayout(_device, _setLayout, nullptr);
+}
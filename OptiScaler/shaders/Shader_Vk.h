@@ -0,0 +1,54 @@
+#pragma once
+
+#include <pch.h>
+
+#include <vulkan/vulkan.hpp>
+#include <nvsdk_ngx_vk.h>
+
+// Common part of OptiScaler's Vulkan compute passes
+// Binding 0 is the first input (sampled), binding 1 is the output (storage), extra inputs follow from binding 2
+class Shader_Vk
+{
+  protected:
+    // Sets are cycled per dispatch so a set still used by an in-flight frame isn't updated
+    static constexpr uint32_t SetCount = 16;
+    // 16x16 is above the guaranteed maxComputeWorkGroupInvocations (128), CreatePipeline checks the device limit
+    static constexpr uint32_t ThreadGroupSize = 16;
+
+    std::string _name = "";
+    bool _init = false;
+
+    VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
+    VkDevice _device = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout _setLayout = VK_NULL_HANDLE;
+    VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline _pipeline = VK_NULL_HANDLE;
+    VkDescriptorPool _pool = VK_NULL_HANDLE;
+    VkDescriptorSet _sets[SetCount] {};
+    uint32_t _setIndex = 0;
+    uint32_t _inputCount = 0;
+    uint32_t _constantsSize = 0;
+
+    NVSDK_NGX_Resource_VK _buffer {};
+    VkDeviceMemory _bufferMemory = VK_NULL_HANDLE;
+
+    bool CreatePipeline(const uint32_t* InCode, size_t InCodeSize, uint32_t InInputCount, uint32_t InConstantsSize);
+    bool CreateBuffer(VkCommandBuffer InCmdBuffer, VkFormat InFormat, uint32_t InWidth, uint32_t InHeight);
+    void ReleaseBuffer();
+    uint32_t FindMemoryType(uint32_t InTypeBits, VkMemoryPropertyFlags InProperties);
+
+    // InInputs has _inputCount entries, InWidth/InHeight are the output pixels
+    bool Dispatch(VkCommandBuffer InCmdBuffer, const NVSDK_NGX_Resource_VK* const* InInputs,
+                  NVSDK_NGX_Resource_VK* OutResource, const void* InConstants, uint32_t InWidth, uint32_t InHeight);
+
+  public:
+    NVSDK_NGX_Resource_VK* Buffer() { return &_buffer; }
+    bool IsInit() const { return _init; }
+    VkDevice Device() const { return _device; }
+    bool CanRender() const { return _init && _buffer.Resource.ImageViewInfo.Image != VK_NULL_HANDLE; }
+
+    Shader_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice);
+
+    virtual ~Shader_Vk();
+};
@@ -4,6 +4,7 @@
 #include "precompile/Bias_Shader_Dx11.h"
 
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -69,6 +70,8 @@ bool Bias_Dx11::CreateBufferResource(ID3D11Device* InDevice, ID3D11Resource* InR
         return false;
     }
 
+    VramTracker::Track(_buffer, VramOwner::Shaders);
+
     return true;
 }
 
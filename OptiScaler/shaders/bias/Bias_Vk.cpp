@@ -0,0 +1,45 @@
+#include "Bias_Vk.h"
+
+#include "precompile/bias_Shader_Vk.h"
+
+bool Bias_Vk::CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource)
+{
+    if (!_init || InCmdBuffer == VK_NULL_HANDLE || InSource == nullptr)
+        return false;
+
+    auto& info = InSource->Resource.ImageViewInfo;
+    return CreateBuffer(InCmdBuffer, info.Format, info.Width, info.Height);
+}
+
+bool Bias_Vk::Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, float InBias,
+                       NVSDK_NGX_Resource_VK* OutResource)
+{
+    if (!_init || InResource == nullptr || OutResource == nullptr)
+        return false;
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    auto& outInfo = OutResource->Resource.ImageViewInfo;
+
+    InternalConstants constants {};
+    constants.Bias = InBias;
+    constants.Width = outInfo.Width;
+    constants.Height = outInfo.Height;
+
+    const NVSDK_NGX_Resource_VK* inputs[] = { InResource };
+
+    return Shader_Vk::Dispatch(InCmdBuffer, inputs, OutResource, &constants, outInfo.Width, outInfo.Height);
+}
+
+Bias_Vk::Bias_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice) : Shader_Vk(InName, InPD, InDevice)
+{
+    if (InPD == VK_NULL_HANDLE || InDevice == VK_NULL_HANDLE)
+    {
+        LOG_ERROR("InPD or InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    _init = CreatePipeline(bias_spv, sizeof(bias_spv), 1, sizeof(InternalConstants));
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <pch.h>
+
+#include <shaders/Shader_Vk.h>
+
+class Bias_Vk : public Shader_Vk
+{
+  private:
+    // Push constant layout of bias.spvasm and bias_Vk.hlsl
+    struct InternalConstants
+    {
+        float Bias;
+        int Width;
+        int Height;
+    };
+
+  public:
+    bool CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource);
+    bool Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, float InBias,
+                  NVSDK_NGX_Resource_VK* OutResource);
+
+    Bias_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice);
+};
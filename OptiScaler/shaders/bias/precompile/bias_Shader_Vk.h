@@ -0,0 +1,42 @@
+#pragma once
+
+inline static const uint32_t bias_spv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000033, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+    0x00000038, 0x0003000e, 0x00000000, 0x00000001, 0x0006000f, 0x00000005, 0x00000001, 0x6e69616d,
+    0x00000000, 0x00000002, 0x00060010, 0x00000001, 0x00000011, 0x00000010, 0x00000010, 0x00000001,
+    0x00040047, 0x00000002, 0x0000000b, 0x0000001c, 0x00030047, 0x00000003, 0x00000002, 0x00050048,
+    0x00000003, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000003, 0x00000001, 0x00000023,
+    0x00000004, 0x00050048, 0x00000003, 0x00000002, 0x00000023, 0x00000008, 0x00040047, 0x00000004,
+    0x00000022, 0x00000000, 0x00040047, 0x00000004, 0x00000021, 0x00000000, 0x00040047, 0x00000005,
+    0x00000022, 0x00000000, 0x00040047, 0x00000005, 0x00000021, 0x00000001, 0x00030047, 0x00000005,
+    0x00000019, 0x00020013, 0x00000006, 0x00030021, 0x00000007, 0x00000006, 0x00020014, 0x00000008,
+    0x00040015, 0x00000009, 0x00000020, 0x00000000, 0x00040015, 0x0000000a, 0x00000020, 0x00000001,
+    0x00030016, 0x0000000b, 0x00000020, 0x00040017, 0x0000000c, 0x0000000a, 0x00000002, 0x00040017,
+    0x0000000d, 0x00000009, 0x00000003, 0x00040017, 0x0000000e, 0x00000009, 0x00000002, 0x00040017,
+    0x0000000f, 0x0000000b, 0x00000004, 0x00090019, 0x00000010, 0x0000000b, 0x00000001, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x00090019, 0x00000011, 0x0000000b, 0x00000001,
+    0x00000000, 0x00000000, 0x00000000, 0x00000002, 0x00000000, 0x00040020, 0x00000012, 0x00000000,
+    0x00000010, 0x00040020, 0x00000013, 0x00000000, 0x00000011, 0x0005001e, 0x00000003, 0x0000000b,
+    0x0000000a, 0x0000000a, 0x00040020, 0x00000014, 0x00000009, 0x00000003, 0x00040020, 0x00000015,
+    0x00000009, 0x0000000b, 0x00040020, 0x00000016, 0x00000009, 0x0000000a, 0x00040020, 0x00000017,
+    0x00000001, 0x0000000d, 0x0004002b, 0x0000000a, 0x00000018, 0x00000000, 0x0004002b, 0x0000000a,
+    0x00000019, 0x00000001, 0x0004002b, 0x0000000a, 0x0000001a, 0x00000002, 0x0004003b, 0x00000014,
+    0x0000001b, 0x00000009, 0x0004003b, 0x00000012, 0x00000004, 0x00000000, 0x0004003b, 0x00000013,
+    0x00000005, 0x00000000, 0x0004003b, 0x00000017, 0x00000002, 0x00000001, 0x00050036, 0x00000006,
+    0x00000001, 0x00000000, 0x00000007, 0x000200f8, 0x0000001c, 0x0004003d, 0x0000000d, 0x0000001d,
+    0x00000002, 0x0007004f, 0x0000000e, 0x0000001e, 0x0000001d, 0x0000001d, 0x00000000, 0x00000001,
+    0x0004007c, 0x0000000c, 0x0000001f, 0x0000001e, 0x00050051, 0x0000000a, 0x00000020, 0x0000001f,
+    0x00000000, 0x00050051, 0x0000000a, 0x00000021, 0x0000001f, 0x00000001, 0x00050041, 0x00000016,
+    0x00000022, 0x0000001b, 0x00000019, 0x0004003d, 0x0000000a, 0x00000023, 0x00000022, 0x00050041,
+    0x00000016, 0x00000024, 0x0000001b, 0x0000001a, 0x0004003d, 0x0000000a, 0x00000025, 0x00000024,
+    0x000500af, 0x00000008, 0x00000026, 0x00000020, 0x00000023, 0x000500af, 0x00000008, 0x00000027,
+    0x00000021, 0x00000025, 0x000500a6, 0x00000008, 0x00000028, 0x00000026, 0x00000027, 0x000300f7,
+    0x00000029, 0x00000000, 0x000400fa, 0x00000028, 0x00000029, 0x0000002a, 0x000200f8, 0x0000002a,
+    0x0004003d, 0x00000010, 0x0000002b, 0x00000004, 0x0007005f, 0x0000000f, 0x0000002c, 0x0000002b,
+    0x0000001f, 0x00000002, 0x00000018, 0x00050051, 0x0000000b, 0x0000002d, 0x0000002c, 0x00000000,
+    0x00050041, 0x00000015, 0x0000002e, 0x0000001b, 0x00000018, 0x0004003d, 0x0000000b, 0x0000002f,
+    0x0000002e, 0x00050085, 0x0000000b, 0x00000030, 0x0000002d, 0x0000002f, 0x00060052, 0x0000000f,
+    0x00000031, 0x00000030, 0x0000002c, 0x00000000, 0x0004003d, 0x00000011, 0x00000032, 0x00000005,
+    0x00040063, 0x00000032, 0x0000001f, 0x00000031, 0x000200f9, 0x00000029, 0x000200f8, 0x00000029,
+    0x000100fd, 0x00010038
+};
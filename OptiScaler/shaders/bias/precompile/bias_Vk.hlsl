@@ -0,0 +1,28 @@
+// Vulkan version of bias.hlsl
+// Compile with build_precompiled_shader_vk.bat bias
+
+struct Params
+{
+    float Bias;
+    int Width;
+    int Height;
+};
+
+[[vk::push_constant]] Params params;
+
+[[vk::binding(0, 0)]] Texture2D<float4> Source;
+[[vk::binding(1, 0)]] [[vk::image_format("unknown")]] RWTexture2D<float4> Dest;
+
+// 256 invocations, Shader_Vk checks maxComputeWorkGroupInvocations before creating the pipeline
+[numthreads(16, 16, 1)]
+void CSMain(uint3 DTid : SV_DispatchThreadID)
+{
+    int2 pos = int2(DTid.xy);
+
+    if (pos.x >= params.Width || pos.y >= params.Height)
+        return;
+
+    float4 src = Source.Load(int3(pos, 0));
+    src.r *= params.Bias;
+    Dest[pos] = src;
+}
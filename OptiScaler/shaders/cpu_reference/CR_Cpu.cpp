@@ -0,0 +1,754 @@
+#include "CR_Cpu.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+
+// Texture2D.Load returns 0 for out of bounds reads
+static inline __m128 LoadPixel(const CpuImage& image, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= (int) image.width || y >= (int) image.height)
+        return _mm_setzero_ps();
+
+    return _mm_loadu_ps(image.At(x, y));
+}
+
+static inline __m128 LoadPixelClamped(const CpuImage& image, int x, int y)
+{
+    x = std::clamp(x, 0, (int) image.width - 1);
+    y = std::clamp(y, 0, (int) image.height - 1);
+
+    return _mm_loadu_ps(image.At(x, y));
+}
+
+static inline void StorePixel(CpuImage& image, uint32_t x, uint32_t y, __m128 value)
+{
+    _mm_storeu_ps(image.At(x, y), value);
+}
+
+static inline float Lane(__m128 value, int lane)
+{
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, value);
+    return lanes[lane];
+}
+
+// saturate(NaN) is 0 on GPU, _mm_max_ps returns second operand for NaN
+static inline __m128 Saturate(__m128 value)
+{
+    return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+static inline float Saturate(float value) { return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f; }
+
+// GPU min/max return the other operand when one of them is NaN
+static inline __m128 MaxNum(__m128 a, __m128 b)
+{
+    __m128 bNaN = _mm_cmpunord_ps(b, b);
+    return _mm_or_ps(_mm_and_ps(bNaN, a), _mm_andnot_ps(bNaN, _mm_max_ps(a, b)));
+}
+
+static inline __m128 MinNum(__m128 a, __m128 b)
+{
+    __m128 bNaN = _mm_cmpunord_ps(b, b);
+    return _mm_or_ps(_mm_and_ps(bNaN, a), _mm_andnot_ps(bNaN, _mm_min_ps(a, b)));
+}
+
+static inline __m128 Abs(__m128 value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+
+static inline float Sum3(__m128 value)
+{
+    __m128 g = _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 b = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(value, g), b));
+}
+
+static inline float Max3(__m128 value)
+{
+    return std::fmax(std::fmax(Lane(value, 0), Lane(value, 1)), Lane(value, 2));
+}
+
+// rgb from color, alpha from alpha
+static inline __m128 WithAlpha(__m128 color, __m128 alpha)
+{
+    const __m128 rgbMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    return _mm_or_ps(_mm_and_ps(rgbMask, color), _mm_andnot_ps(rgbMask, alpha));
+}
+
+static inline float Luminance(__m128 color)
+{
+    return Sum3(_mm_mul_ps(color, _mm_setr_ps(0.2126f, 0.7152f, 0.0722f, 0.0f)));
+}
+
+// Luminance correction of output scaling downscalers, only rgb is scaled
+static inline __m128 CorrectLuminance(__m128 color, float avgLuminance)
+{
+    float currentLuminance = Luminance(color);
+
+    if (std::abs(currentLuminance - avgLuminance) <= 0.5f)
+        return color;
+
+    float luminanceScale = avgLuminance / std::max(currentLuminance, 1e-5f);
+    return _mm_mul_ps(color, _mm_setr_ps(luminanceScale, luminanceScale, luminanceScale, 1.0f));
+}
+
+static inline float Frac(float value) { return value - std::floor(value); }
+
+static void PrepareDest(CpuImage& image, uint32_t width, uint32_t height)
+{
+    if (image.width != width || image.height != height)
+        image = CpuImage(width, height);
+}
+
+static float BicubicWeight(float x)
+{
+    const float a = -0.75f;
+    float absX = std::abs(x);
+
+    if (absX <= 1.0f)
+        return (a + 2.0f) * absX * absX * absX - (a + 3.0f) * absX * absX + 1.0f;
+    else if (absX < 2.0f)
+        return a * absX * absX * absX - 5.0f * a * absX * absX + 8.0f * a * absX - 4.0f * a;
+
+    return 0.0f;
+}
+
+static float LanczosKernel(float x, float radius)
+{
+    const float pi = 3.14159265359f;
+
+    if (x == 0.0f)
+        return 1.0f;
+
+    if (x > radius)
+        return 0.0f;
+
+    x *= pi;
+    return (std::sin(x) / x) * (std::sin(x / radius) / (x / radius));
+}
+
+static float CatmullRomKernel(float x)
+{
+    x = std::abs(x);
+
+    if (x < 1.0f)
+        return (1.5f * x - 2.5f) * x * x + 1.0f;
+    else if (x < 2.0f)
+        return ((-0.5f * x + 2.5f) * x - 4.0f) * x + 2.0f;
+
+    return 0.0f;
+}
+
+static float MagcKernel(float x)
+{
+    x = std::abs(x);
+
+    if (x <= 1.0f)
+        return 1.0f - 2.0f * x * x + x * x * x;
+    else if (x <= 2.0f)
+        return 4.0f - 8.0f * x + 5.0f * x * x - x * x * x;
+
+    return 0.0f;
+}
+
+static float W1(float x, float A) { return x * x * ((A + 2) * x - (A + 3)) + 1.0f; }
+
+static float W2(float x, float A) { return A * (x * (x * (x - 5) + 8) - 4); }
+
+static void ComputeWeights(float d1, float A, float weights[4])
+{
+    weights[0] = W2(1.0f + d1, A);
+    weights[1] = W1(d1, A);
+    weights[2] = W1(1.0f - d1, A);
+    weights[3] = W2(2.0f - d1, A);
+}
+
+static float RcasSharpness(const CpuImage* motion, const CpuRcasConstants& constants, int x, int y)
+{
+    float setSharpness = constants.sharpness;
+
+    if (!constants.dynamicSharpenEnabled)
+        return setSharpness;
+
+    __m128 mv = _mm_setzero_ps();
+
+    if (motion != nullptr)
+    {
+        if (constants.displaySizeMV)
+            mv = LoadPixel(*motion, x, y);
+        else
+            mv = LoadPixel(*motion, (int) (x * constants.motionTextureScale), (int) (y * constants.motionTextureScale));
+    }
+
+    float motionLength =
+        std::max(std::abs(Lane(mv, 0) * constants.mvScaleX), std::abs(Lane(mv, 1) * constants.mvScaleY));
+    float add = 0.0f;
+
+    if (motionLength > constants.threshold)
+        add = (motionLength / (constants.scaleLimit - constants.threshold)) * constants.motionSharpness;
+
+    if ((add > constants.motionSharpness && constants.motionSharpness > 0.0f) ||
+        (add < constants.motionSharpness && constants.motionSharpness < 0.0f))
+    {
+        add = constants.motionSharpness;
+    }
+
+    setSharpness += add;
+
+    if (setSharpness > 1.3f)
+        setSharpness = 1.3f;
+    else if (setSharpness < 0.0f)
+        setSharpness = 0.0f;
+
+    return setSharpness;
+}
+
+static __m128 RcasPixel(const CpuImage& source, const CpuImage* motion, const CpuRcasConstants& constants, int x,
+                        int y)
+{
+    float setSharpness = RcasSharpness(motion, constants, x, y);
+
+    __m128 e = LoadPixel(source, x, y);
+
+    // skip sharpening if set value == 0
+    if (setSharpness == 0.0f)
+    {
+        if (constants.debug && constants.dynamicSharpenEnabled && constants.sharpness > 0.0f)
+            e = _mm_mul_ps(e, _mm_setr_ps(1.0f, 1.0f + (12.0f * constants.sharpness), 1.0f, 1.0f));
+
+        return e;
+    }
+
+    __m128 b = LoadPixel(source, x, y - 1);
+    __m128 d = LoadPixel(source, x - 1, y);
+    __m128 f = LoadPixel(source, x + 1, y);
+    __m128 h = LoadPixel(source, x, y + 1);
+
+    // Min and max of ring
+    __m128 minRGB = _mm_min_ps(_mm_min_ps(b, d), _mm_min_ps(f, h));
+    __m128 maxRGB = _mm_max_ps(_mm_max_ps(b, d), _mm_max_ps(f, h));
+
+    // Standard RCAS limiters, peak range is (1.0, -4.0)
+    const __m128 four = _mm_set1_ps(4.0f);
+    __m128 hitMin = _mm_div_ps(minRGB, _mm_mul_ps(four, maxRGB));
+    __m128 hitMax = _mm_div_ps(_mm_sub_ps(_mm_set1_ps(1.0f), maxRGB), _mm_sub_ps(_mm_mul_ps(four, minRGB), four));
+    __m128 lobeRGB = MaxNum(_mm_sub_ps(_mm_setzero_ps(), hitMin), hitMax);
+    float lobe = std::fmax(-0.1875f, std::fmin(Max3(lobeRGB), 0.0f)) * setSharpness;
+
+    // Contrast adaptation, only green is used as representative
+    if (constants.contrast >= -10.0f)
+    {
+        __m128 amp = _mm_div_ps(MinNum(minRGB, _mm_sub_ps(_mm_set1_ps(2.0f), maxRGB)),
+                                MaxNum(maxRGB, _mm_set1_ps(1e-5f)));
+        float ampG = 1.0f / std::sqrt(Saturate(Lane(amp, 1)));
+
+        float peak = -3.0f * constants.contrast + 8.0f;
+        float contrastFactor = 1.0f / std::fmax(ampG * peak, 1.0f);
+
+        lobe *= 1.0f + (contrastFactor - 1.0f) * constants.contrast;
+    }
+
+    float rcpL = 1.0f / (4.0f * lobe + 1.0f);
+    __m128 ring = _mm_add_ps(_mm_add_ps(b, d), _mm_add_ps(f, h));
+    __m128 output = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ring, _mm_set1_ps(lobe)), e), _mm_set1_ps(rcpL));
+
+    if (constants.debug && constants.dynamicSharpenEnabled)
+    {
+        if (constants.sharpness < setSharpness)
+            output = _mm_mul_ps(output, _mm_setr_ps(1.0f + (12.0f * (setSharpness - constants.sharpness)), 1, 1, 1));
+        else
+            output = _mm_mul_ps(output, _mm_setr_ps(1, 1.0f + (12.0f * (constants.sharpness - setSharpness)), 1, 1));
+    }
+
+    return WithAlpha(output, e);
+}
+
+void CR_Cpu::Bias(const CpuImage& InSource, float InBias, CpuImage& OutDest)
+{
+    PrepareDest(OutDest, InSource.width, InSource.height);
+
+    const __m128 bias = _mm_setr_ps(InBias, 1.0f, 1.0f, 1.0f);
+    const size_t count = (size_t) InSource.width * InSource.height * 4;
+
+    for (size_t i = 0; i < count; i += 4)
+        _mm_storeu_ps(&OutDest.pixels[i], _mm_mul_ps(_mm_loadu_ps(&InSource.pixels[i]), bias));
+}
+
+void CR_Cpu::DepthScale(const CpuImage& InSource, float InDepthScale, CpuImage& OutDest)
+{
+    PrepareDest(OutDest, InSource.width, InSource.height);
+
+    const __m128 depthScale = _mm_set1_ps(InDepthScale);
+    const size_t count = (size_t) InSource.width * InSource.height;
+    size_t i = 0;
+
+    // Depth is single channel, process 4 pixels at once
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* src = &InSource.pixels[i * 4];
+        __m128 depth = Saturate(_mm_div_ps(_mm_setr_ps(src[0], src[4], src[8], src[12]), depthScale));
+
+        alignas(16) float result[4];
+        _mm_store_ps(result, depth);
+
+        for (size_t j = 0; j < 4; j++)
+            _mm_storeu_ps(&OutDest.pixels[(i + j) * 4], _mm_setr_ps(result[j], 0.0f, 0.0f, 0.0f));
+    }
+
+    for (; i < count; i++)
+        OutDest.pixels[i * 4] = Saturate(InSource.pixels[i * 4] / InDepthScale);
+}
+
+bool CR_Cpu::FormatTransfer(const CpuImage& InSource, CpuPackedFormat InFormat, std::vector<uint32_t>& OutDest)
+{
+    __m128 scale;
+
+    switch (InFormat)
+    {
+    case CpuPackedFormat::R10G10B10A2:
+        scale = _mm_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f);
+        break;
+
+    case CpuPackedFormat::R8G8B8A8:
+    case CpuPackedFormat::B8G8R8A8:
+        scale = _mm_set1_ps(255.0f);
+        break;
+
+    default:
+        return false;
+    }
+
+    const size_t count = (size_t) InSource.width * InSource.height;
+    OutDest.resize(count);
+
+    alignas(16) int32_t c[4];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        __m128i packed = _mm_cvttps_epi32(_mm_mul_ps(Saturate(_mm_loadu_ps(&InSource.pixels[i * 4])), scale));
+        _mm_store_si128((__m128i*) c, packed);
+
+        // B8G8R8A8 packing is same with the shader
+        if (InFormat == CpuPackedFormat::R10G10B10A2)
+            OutDest[i] = c[0] | c[1] << 10 | c[2] << 20 | (uint32_t) c[3] << 30;
+        else if (InFormat == CpuPackedFormat::B8G8R8A8)
+            OutDest[i] = c[2] | c[0] << 8 | c[1] << 16 | (uint32_t) c[3] << 24;
+        else
+            OutDest[i] = c[0] | c[1] << 8 | c[2] << 16 | (uint32_t) c[3] << 24;
+    }
+
+    return true;
+}
+
+void CR_Cpu::ResourceFlip(const CpuImage& InSource, uint32_t InWidth, uint32_t InHeight, uint32_t InOffset,
+                          bool InVelocity, CpuImage& OutDest)
+{
+    if (OutDest.width == 0 || OutDest.height == 0)
+        OutDest = CpuImage(InSource.width, InSource.height);
+
+    // RF_Dx12 writes height - 1 to constants
+    const int64_t height = (int64_t) InHeight - 1;
+    const uint32_t width = std::min({ InSource.width, OutDest.width, InWidth });
+    const __m128 velocitySign = _mm_setr_ps(1.0f, -1.0f, 0.0f, 0.0f);
+
+    for (uint32_t y = 0; y < InSource.height; y++)
+    {
+        if (y < InOffset || y > height + InOffset)
+            continue;
+
+        // Shader uses uint math, negative rows wrap and UAV write is dropped
+        int64_t destY = height - y - InOffset;
+
+        if (destY < 0 || destY >= OutDest.height)
+            continue;
+
+        for (uint32_t x = 0; x < width; x++)
+        {
+            __m128 color = _mm_loadu_ps(InSource.At(x, y));
+
+            if (InVelocity)
+                color = _mm_mul_ps(color, velocitySign);
+
+            StorePixel(OutDest, x, (uint32_t) destY, color);
+        }
+    }
+}
+
+// Output row of a source row like FI_Dx12 Target(), width is checked by the caller
+static bool FITargetRow(uint32_t y, uint32_t height, uint32_t offset, bool flip, int64_t& targetY)
+{
+    // Shader gets height - 1
+    const int64_t last = (int64_t) height - 1;
+    targetY = y;
+
+    if (!flip)
+        return y <= last;
+
+    if (y < offset || y > last + offset)
+        return false;
+
+    // Negative rows wrap in the shader and UAV write is dropped
+    targetY = last - y - offset;
+    return targetY >= 0;
+}
+
+void CR_Cpu::PrepareFGInputs(const CpuImage& InVelocity, const CpuImage& InDepth, const CpuFIConstants& InConstants,
+                             CpuImage& OutVelocity, CpuImage& OutDepth)
+{
+    if (OutVelocity.width == 0 || OutVelocity.height == 0)
+        OutVelocity = CpuImage(InVelocity.width, InVelocity.height);
+
+    if (OutDepth.width == 0 || OutDepth.height == 0)
+        OutDepth = CpuImage(InDepth.width, InDepth.height);
+
+    // Output is float2, velocity.y is negated when flipping
+    const __m128 velocityMask = _mm_setr_ps(1.0f, InConstants.flipVelocity ? -1.0f : 1.0f, 0.0f, 0.0f);
+    const uint32_t velocityRows = InConstants.velocityHeight + InConstants.velocityOffset;
+    const uint32_t velocityWidth = std::min(InConstants.velocityWidth, OutVelocity.width);
+    int64_t targetY = 0;
+
+    for (uint32_t y = 0; y < velocityRows; y++)
+    {
+        if (!FITargetRow(y, InConstants.velocityHeight, InConstants.velocityOffset, InConstants.flipVelocity,
+                         targetY) ||
+            targetY >= OutVelocity.height)
+        {
+            continue;
+        }
+
+        for (uint32_t x = 0; x < velocityWidth; x++)
+        {
+            __m128 velocity = _mm_mul_ps(LoadPixel(InVelocity, x, y), velocityMask);
+            StorePixel(OutVelocity, x, (uint32_t) targetY, velocity);
+        }
+    }
+
+    const uint32_t depthRows = InConstants.depthHeight + InConstants.depthOffset;
+    const uint32_t depthWidth = std::min(InConstants.depthWidth, OutDepth.width);
+
+    for (uint32_t y = 0; y < depthRows; y++)
+    {
+        if (!FITargetRow(y, InConstants.depthHeight, InConstants.depthOffset, InConstants.flipDepth, targetY) ||
+            targetY >= OutDepth.height)
+        {
+            continue;
+        }
+
+        for (uint32_t x = 0; x < depthWidth; x++)
+        {
+            float depth = Lane(LoadPixel(InDepth, x, y), 0);
+
+            if (InConstants.scaleDepth)
+                depth = Saturate(depth / InConstants.depthScale);
+
+            StorePixel(OutDepth, x, (uint32_t) targetY, _mm_setr_ps(depth, 0.0f, 0.0f, 0.0f));
+        }
+    }
+}
+
+void CR_Cpu::HudlessCompare(const CpuImage& InReference, const CpuImage& InBackCopy, float InDiffThreshold,
+                            float InPinkAmount, CpuImage& OutDest)
+{
+    PrepareDest(OutDest, InBackCopy.width, InBackCopy.height);
+
+    if (InReference.width == 0 || InReference.height == 0)
+        return;
+
+    const __m128 pink = _mm_setr_ps(1.0f, 0.4f, 0.6f, 0.0f);
+
+    for (uint32_t y = 0; y < InBackCopy.height; y++)
+    {
+        // Point clamp sampling with same uv
+        uint32_t refY = std::min((uint32_t) ((y + 0.5f) * InReference.height / InBackCopy.height),
+                                 InReference.height - 1);
+
+        for (uint32_t x = 0; x < InBackCopy.width; x++)
+        {
+            uint32_t refX = std::min((uint32_t) ((x + 0.5f) * InReference.width / InBackCopy.width),
+                                     InReference.width - 1);
+
+            __m128 refC = _mm_loadu_ps(InReference.At(refX, refY));
+            __m128 backC = _mm_loadu_ps(InBackCopy.At(x, y));
+
+            float d = Max3(Abs(_mm_sub_ps(refC, backC)));
+
+            // soft threshold
+            float t = Saturate((d - InDiffThreshold) / (InDiffThreshold * 2.0f - InDiffThreshold));
+            float m = t * t * (3.0f - 2.0f * t);
+
+            __m128 amount = _mm_set1_ps(m * InPinkAmount);
+            __m128 outRgb = _mm_add_ps(backC, _mm_mul_ps(_mm_sub_ps(pink, backC), amount));
+
+            StorePixel(OutDest, x, y, WithAlpha(outRgb, backC));
+        }
+    }
+}
+
+bool CR_Cpu::HudlessHistogram(const CpuImage& InHudless, const CpuImage& InBackBuffer, uint32_t* OutHistogram)
+{
+    if (InHudless.width == 0 || InHudless.height == 0 || InHudless.width != InBackBuffer.width ||
+        InHudless.height != InBackBuffer.height)
+    {
+        return false;
+    }
+
+    constexpr uint32_t cellSize = Hudfix_Common::ValidationCellSize;
+
+    std::fill(OutHistogram, OutHistogram + Hudfix_Common::ValidationBinCount, 0u);
+
+    const uint32_t sampleWidth = (InHudless.width + cellSize - 1) / cellSize;
+    const uint32_t sampleHeight = (InHudless.height + cellSize - 1) / cellSize;
+
+    for (uint32_t sy = 0; sy < sampleHeight; sy++)
+    {
+        // Center of the cell, last cells are clamped to the edge
+        uint32_t y = std::min(sy * cellSize + cellSize / 2, InHudless.height - 1);
+
+        for (uint32_t sx = 0; sx < sampleWidth; sx++)
+        {
+            uint32_t x = std::min(sx * cellSize + cellSize / 2, InHudless.width - 1);
+
+            float d = Max3(Abs(_mm_sub_ps(LoadPixel(InHudless, x, y), LoadPixel(InBackBuffer, x, y))));
+
+            OutHistogram[Hudfix_Common::ValidationBin(d)]++;
+        }
+    }
+
+    return true;
+}
+
+void CR_Cpu::Rcas(const CpuImage& InSource, const CpuImage* InMotion, const CpuRcasConstants& InConstants,
+                  CpuImage& OutDest)
+{
+    PrepareDest(OutDest, InSource.width, InSource.height);
+
+    for (uint32_t y = 0; y < InSource.height; y++)
+    {
+        for (uint32_t x = 0; x < InSource.width; x++)
+            StorePixel(OutDest, x, y, RcasPixel(InSource, InMotion, InConstants, x, y));
+    }
+}
+
+bool CR_Cpu::OutputScaling(const CpuImage& InSource, uint32_t InDownscaler, bool InUpsample, CpuImage& OutDest)
+{
+    if (InSource.width == 0 || InSource.height == 0 || OutDest.width == 0 || OutDest.height == 0)
+        return false;
+
+    const float scaleX = (float) InSource.width / (float) OutDest.width;
+    const float scaleY = (float) InSource.height / (float) OutDest.height;
+
+    for (uint32_t y = 0; y < OutDest.height; y++)
+    {
+        for (uint32_t x = 0; x < OutDest.width; x++)
+        {
+            __m128 result = _mm_setzero_ps();
+
+            // BCUS, bicubic upsample with 16 precomputed phases
+            if (InUpsample)
+            {
+                float topLeftX = (x + 0.5f) * scaleX - 1.5f;
+                float topLeftY = (y + 0.5f) * scaleY - 1.5f;
+                int baseX = (int) std::floor(topLeftX);
+                int baseY = (int) std::floor(topLeftY);
+
+                float xWeights[4];
+                float yWeights[4];
+                ComputeWeights(((uint32_t) (Frac(topLeftX) * 16.0f) + 0.5f) / 16.0f, -0.5f, xWeights);
+                ComputeWeights(((uint32_t) (Frac(topLeftY) * 16.0f) + 0.5f) / 16.0f, -0.5f, yWeights);
+
+                for (int j = 0; j < 4; j++)
+                {
+                    __m128 row = _mm_setzero_ps();
+
+                    for (int i = 0; i < 4; i++)
+                    {
+                        __m128 color = LoadPixel(InSource, baseX + i, baseY + j);
+                        row = _mm_add_ps(row, _mm_mul_ps(color, _mm_set1_ps(xWeights[i])));
+                    }
+
+                    result = _mm_add_ps(result, _mm_mul_ps(row, _mm_set1_ps(yWeights[j])));
+                }
+
+                StorePixel(OutDest, x, y, result);
+                continue;
+            }
+
+            // Bicubic
+            if (InDownscaler == 0 || InDownscaler > 3)
+            {
+                float pixelX = (x / (OutDest.width - 1.0f)) * InSource.width;
+                float pixelY = (y / (OutDest.height - 1.0f)) * InSource.height;
+                int texelX = (int) std::floor(pixelX);
+                int texelY = (int) std::floor(pixelY);
+                float tx = pixelX - texelX;
+                float ty = pixelY - texelY;
+                tx = tx * tx * (3.0f - 2.0f * tx);
+                ty = ty * ty * (3.0f - 2.0f * ty);
+
+                float avgLuminance = 0.0f;
+
+                for (int j = -1; j <= 2; j++)
+                {
+                    for (int i = -1; i <= 2; i++)
+                        avgLuminance += Luminance(LoadPixel(InSource, texelX + i, texelY + j));
+                }
+
+                avgLuminance /= 16.0f;
+
+                for (int j = -1; j <= 2; j++)
+                {
+                    for (int i = -1; i <= 2; i++)
+                    {
+                        __m128 color = CorrectLuminance(LoadPixel(InSource, texelX + i, texelY + j), avgLuminance);
+                        float weight = BicubicWeight(i - tx) * BicubicWeight(j - ty);
+                        result = _mm_add_ps(result, _mm_mul_ps(color, _mm_set1_ps(weight)));
+                    }
+                }
+
+                StorePixel(OutDest, x, y, result);
+                continue;
+            }
+
+            float sourceX = x * scaleX;
+            float sourceY = y * scaleY;
+            int baseX = (int) sourceX;
+            int baseY = (int) sourceY;
+
+            float avgLuminance = 0.0f;
+
+            for (int j = -1; j <= 2; j++)
+            {
+                for (int i = -1; i <= 2; i++)
+                    avgLuminance += Luminance(LoadPixelClamped(InSource, baseX + i, baseY + j));
+            }
+
+            avgLuminance /= 16.0f;
+
+            float totalWeight = 0.0f;
+
+            // Lanczos, shader multiplies the same weight twice so it's kept
+            if (InDownscaler == 1)
+            {
+                const float radius = 3.0f;
+
+                for (int j = -3; j <= 3; j++)
+                {
+                    for (int i = -3; i <= 3; i++)
+                    {
+                        float sampleX = std::clamp(sourceX + i, 0.0f, InSource.width - 1.0f);
+                        float sampleY = std::clamp(sourceY + j, 0.0f, InSource.height - 1.0f);
+
+                        __m128 color = CorrectLuminance(LoadPixel(InSource, (int) sampleX, (int) sampleY),
+                                                        avgLuminance);
+
+                        float weight = LanczosKernel(std::abs(sampleX - sourceX), radius) *
+                                       LanczosKernel(std::abs(sampleY - sourceY), radius);
+                        weight *= weight;
+
+                        result = _mm_add_ps(result, _mm_mul_ps(color, _mm_set1_ps(weight)));
+                        totalWeight += weight;
+                    }
+                }
+            }
+            // Catmull-Rom & MAGC
+            else
+            {
+                auto kernel = InDownscaler == 2 ? CatmullRomKernel : MagcKernel;
+                float fracX = Frac(sourceX);
+                float fracY = Frac(sourceY);
+
+                for (int j = -1; j <= 2; j++)
+                {
+                    for (int i = -1; i <= 2; i++)
+                    {
+                        __m128 color = CorrectLuminance(LoadPixelClamped(InSource, baseX + i, baseY + j),
+                                                        avgLuminance);
+
+                        float weight = kernel(i - fracX) * kernel(j - fracY);
+
+                        result = _mm_add_ps(result, _mm_mul_ps(color, _mm_set1_ps(weight)));
+                        totalWeight += weight;
+                    }
+                }
+            }
+
+            StorePixel(OutDest, x, y, _mm_div_ps(result, _mm_set1_ps(totalWeight)));
+        }
+    }
+
+    return true;
+}
+
+bool CR_Cpu::RcasOutputScaling(const CpuImage& InSource, const CpuImage* InMotion,
+                               const CpuRcasConstants& InConstants, bool InUpsample, CpuImage& OutDest)
+{
+    if (InSource.width == 0 || InSource.height == 0 || OutDest.width == 0 || OutDest.height == 0)
+        return false;
+
+    // Bicubic footprint reaches 2 texels outside of the source on edges, they stay 0 like RCAS_OS_Dx12
+    const int border = 2;
+    CpuImage sharpened(InSource.width + border * 2, InSource.height + border * 2);
+
+    for (uint32_t y = 0; y < InSource.height; y++)
+    {
+        for (uint32_t x = 0; x < InSource.width; x++)
+            StorePixel(sharpened, x + border, y + border, RcasPixel(InSource, InMotion, InConstants, x, y));
+    }
+
+    const float scaleX = (float) InSource.width / (float) OutDest.width;
+    const float scaleY = (float) InSource.height / (float) OutDest.height;
+    const float a = InUpsample ? -0.5f : -0.75f;
+
+    __m128 samples[16];
+
+    for (uint32_t y = 0; y < OutDest.height; y++)
+    {
+        for (uint32_t x = 0; x < OutDest.width; x++)
+        {
+            float topLeftX = (x + 0.5f) * scaleX - 1.5f;
+            float topLeftY = (y + 0.5f) * scaleY - 1.5f;
+            int baseX = (int) std::floor(topLeftX) + border;
+            int baseY = (int) std::floor(topLeftY) + border;
+
+            float xWeights[4];
+            float yWeights[4];
+            ComputeWeights(Frac(topLeftX), a, xWeights);
+            ComputeWeights(Frac(topLeftY), a, yWeights);
+
+            float avgLuminance = 0.0f;
+
+            for (int j = 0; j < 4; j++)
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    samples[j * 4 + i] = LoadPixel(sharpened, baseX + i, baseY + j);
+
+                    if (!InUpsample)
+                        avgLuminance += Luminance(samples[j * 4 + i]);
+                }
+            }
+
+            avgLuminance /= 16.0f;
+
+            __m128 result = _mm_setzero_ps();
+
+            for (int j = 0; j < 4; j++)
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    __m128 color = samples[j * 4 + i];
+
+                    if (!InUpsample)
+                        color = CorrectLuminance(color, avgLuminance);
+
+                    result = _mm_add_ps(result, _mm_mul_ps(color, _mm_set1_ps(xWeights[i] * yWeights[j])));
+                }
+            }
+
+            StorePixel(OutDest, x, y, result);
+        }
+    }
+
+    return true;
+}
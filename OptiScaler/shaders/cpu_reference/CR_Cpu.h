@@ -0,0 +1,108 @@
+#pragma once
+
+#include <hudfix/Hudfix_Common.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// RGBA32F image, CPU side stand-in for the textures shader passes read and write
+typedef struct CpuImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> pixels;
+
+    CpuImage() = default;
+    CpuImage(uint32_t InWidth, uint32_t InHeight)
+        : width(InWidth), height(InHeight), pixels((size_t) InWidth * InHeight * 4, 0.0f)
+    {
+    }
+
+    float* At(uint32_t x, uint32_t y) { return &pixels[((size_t) y * width + x) * 4]; }
+    const float* At(uint32_t x, uint32_t y) const { return &pixels[((size_t) y * width + x) * 4]; }
+} cpu_image;
+
+// Output formats of FT_Dx12, sRGB and typeless variants are packed the same way
+enum class CpuPackedFormat : uint32_t
+{
+    R10G10B10A2,
+    R8G8B8A8,
+    B8G8R8A8,
+};
+
+// Same values RCAS_Dx12 writes to its constant buffer
+typedef struct CpuRcasConstants
+{
+    float sharpness = 0.0f;
+    float contrast = -100.0f; // Contrast adaptation is skipped below -10
+
+    bool dynamicSharpenEnabled = false;
+    bool displaySizeMV = false;
+    bool debug = false;
+
+    float motionSharpness = 0.4f;
+    float motionTextureScale = 1.0f;
+    float mvScaleX = 1.0f;
+    float mvScaleY = 1.0f;
+    float threshold = 0.0f;
+    float scaleLimit = 10.0f;
+} cpu_rcas_constants;
+
+// Same values FI_Dx12 gets with FIParams and FIFlags
+typedef struct CpuFIConstants
+{
+    bool flipVelocity = false;
+    bool flipDepth = false;
+    bool scaleDepth = false;
+
+    uint32_t velocityWidth = 0;
+    uint32_t velocityHeight = 0;
+    uint32_t velocityOffset = 0; // FGResourceFlipOffset result
+    uint32_t depthWidth = 0;
+    uint32_t depthHeight = 0;
+    uint32_t depthOffset = 0;
+    float depthScale = 1.0f;
+} cpu_fi_constants;
+
+// CPU reference implementations of the compute passes in shaders folder
+// Results follow the HLSL versions (out of bounds loads return 0, same kernels and quirks)
+// so GPU output can be compared against them, SSE is used for per pixel math
+// Not part of the DLL, it's built by the tests project with golden tests and a throughput benchmark
+class CR_Cpu
+{
+  public:
+    static void Bias(const CpuImage& InSource, float InBias, CpuImage& OutDest);
+    static void DepthScale(const CpuImage& InSource, float InDepthScale, CpuImage& OutDest);
+
+    // Packs to R10G10B10A2_UNORM, R8G8B8A8_UNORM or B8G8R8A8_UNORM like FT_Dx12
+    static bool FormatTransfer(const CpuImage& InSource, CpuPackedFormat InFormat, std::vector<uint32_t>& OutDest);
+
+    // Parameters are same with RF_Dx12::Dispatch, InOffset is FGResourceFlipOffset result
+    static void ResourceFlip(const CpuImage& InSource, uint32_t InWidth, uint32_t InHeight, uint32_t InOffset,
+                             bool InVelocity, CpuImage& OutDest);
+
+    // Fused velocity flip, depth flip and depth scale of FI_Dx12
+    // Outputs should be created with source sizes, results match ResourceFlip + DepthScale inside them
+    static void PrepareFGInputs(const CpuImage& InVelocity, const CpuImage& InDepth, const CpuFIConstants& InConstants,
+                                CpuImage& OutVelocity, CpuImage& OutDepth);
+
+    static void HudlessCompare(const CpuImage& InReference, const CpuImage& InBackCopy, float InDiffThreshold,
+                               float InPinkAmount, CpuImage& OutDest);
+
+    // Hudless validation of HV_Dx12, images should have same size
+    // OutHistogram has Hudfix_Common::ValidationBinCount entries
+    static bool HudlessHistogram(const CpuImage& InHudless, const CpuImage& InBackBuffer, uint32_t* OutHistogram);
+
+    // InMotion can be nullptr when dynamic sharpening is disabled
+    static void Rcas(const CpuImage& InSource, const CpuImage* InMotion, const CpuRcasConstants& InConstants,
+                     CpuImage& OutDest);
+
+    // OutDest should be created with display size, InDownscaler is OutputScalingDownscaler value
+    // and upsample uses BCUS like OS_Dx12, FSR1 EASU path has no CPU version
+    static bool OutputScaling(const CpuImage& InSource, uint32_t InDownscaler, bool InUpsample, CpuImage& OutDest);
+
+    // Fused RCAS + bicubic scaling of RCAS_OS_Dx12
+    static bool RcasOutputScaling(const CpuImage& InSource, const CpuImage* InMotion,
+                                  const CpuRcasConstants& InConstants, bool InUpsample, CpuImage& OutDest);
+};
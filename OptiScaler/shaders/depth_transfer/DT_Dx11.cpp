@@ -4,6 +4,7 @@
 #include "precompile/dt_Shader_Dx11.h"
 
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 bool DepthTransfer_Dx11::CreateBufferResource(ID3D11Device* InDevice, ID3D11Resource* InResource)
 {
@@ -29,6 +30,8 @@ bool DepthTransfer_Dx11::CreateBufferResource(ID3D11Device* InDevice, ID3D11Reso
         return false;
     }
 
+    VramTracker::Track(_buffer, VramOwner::Shaders);
+
     return true;
 }
 
@@ -0,0 +1,127 @@
+#pragma once
+#include <pch.h>
+#include <d3dcompiler.h>
+
+// Transforms of FG inputs, each combination is a separate shader permutation
+enum FIFlags : uint32_t
+{
+    FI_None = 0,
+    FI_FlipVelocity = 1 << 0, // Same with RF_Dx12 velocity flip
+    FI_FlipDepth = 1 << 1,    // Same with RF_Dx12 depth flip
+    FI_ScaleDepth = 1 << 2,   // Same with DS_Dx12
+    FI_Count = 1 << 3
+};
+
+struct alignas(256) FIConstants
+{
+    UINT VelocityWidth;  // width - 1 like RF_Dx12
+    UINT VelocityHeight; // height - 1 like RF_Dx12
+    UINT VelocityOffset;
+    UINT DepthWidth;
+    UINT DepthHeight;
+    UINT DepthOffset;
+    float DepthScale;
+};
+
+// Velocity and depth are prepared for FG in a single dispatch
+// Permutation defines are used instead of branching on constants, unused transforms are compiled out
+// Same source with precompiled/FI.hlsl, which is used when UsePrecompiledShaders is set and headers exist
+static std::string fiCode = R"(
+cbuffer Params : register(b0)
+{
+    uint VelocityWidth;
+    uint VelocityHeight;
+    uint VelocityOffset;
+    uint DepthWidth;
+    uint DepthHeight;
+    uint DepthOffset;
+    float DepthScale;
+};
+
+Texture2D<float2> Velocity : register(t0);
+Texture2D<float> Depth : register(t1);
+
+RWTexture2D<float2> VelocityOut : register(u0);
+RWTexture2D<float> DepthOut : register(u1);
+
+// Output position of a source pixel, flip follows RF_Dx12 (uint math, wrapped rows are dropped)
+bool Target(uint2 pos, uint width, uint height, uint offset, bool flip, out uint2 target)
+{
+    target = pos;
+
+    if (pos.x > width)
+        return false;
+
+    if (!flip)
+        return pos.y <= height;
+
+    if (pos.y < offset || pos.y > (height + offset))
+        return false;
+
+    target.y = height - pos.y - offset;
+    return true;
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 target;
+
+    if (Target(dispatchThreadID.xy, VelocityWidth, VelocityHeight, VelocityOffset, FLIP_VELOCITY, target))
+    {
+        float2 velocity = Velocity.Load(int3(dispatchThreadID.xy, 0));
+
+#if FLIP_VELOCITY
+        velocity.y = -velocity.y;
+#endif
+
+        VelocityOut[target] = velocity;
+    }
+
+    if (Target(dispatchThreadID.xy, DepthWidth, DepthHeight, DepthOffset, FLIP_DEPTH, target))
+    {
+        float depth = Depth.Load(int3(dispatchThreadID.xy, 0));
+
+#if SCALE_DEPTH
+        depth = saturate(depth / DepthScale);
+#endif
+
+        DepthOut[target] = depth;
+    }
+}
+)";
+
+static ID3DBlob* FI_CompileShader(const char* shaderCode, const char* entryPoint, const char* target, uint32_t flags)
+{
+    ID3DBlob* shaderBlob = nullptr;
+    ID3DBlob* errorBlob = nullptr;
+
+    const D3D_SHADER_MACRO defines[] = { { "FLIP_VELOCITY", (flags & FI_FlipVelocity) ? "1" : "0" },
+                                         { "FLIP_DEPTH", (flags & FI_FlipDepth) ? "1" : "0" },
+                                         { "SCALE_DEPTH", (flags & FI_ScaleDepth) ? "1" : "0" },
+                                         { nullptr, nullptr } };
+
+    HRESULT hr = D3DCompile(shaderCode, strlen(shaderCode), nullptr, defines, nullptr, entryPoint, target,
+                            D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shaderBlob, &errorBlob);
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("error while compiling shader");
+
+        if (errorBlob)
+        {
+            LOG_ERROR("error while compiling shader : {0}", (char*) errorBlob->GetBufferPointer());
+            errorBlob->Release();
+        }
+
+        if (shaderBlob)
+            shaderBlob->Release();
+
+        return nullptr;
+    }
+
+    if (errorBlob)
+        errorBlob->Release();
+
+    return shaderBlob;
+}
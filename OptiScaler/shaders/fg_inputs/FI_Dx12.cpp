@@ -0,0 +1,347 @@
+#include "FI_Dx12.h"
+
+#include <Config.h>
+#include <State.h>
+#include <shaders/DescriptorHeap_Dx12.h>
+
+// Headers are created with precompiled/build_FI_permutations.bat, runtime compile is used until they exist
+#if __has_include("precompiled/FI_7_Shader.h")
+#include "precompiled/FI_0_Shader.h"
+#include "precompiled/FI_1_Shader.h"
+#include "precompiled/FI_2_Shader.h"
+#include "precompiled/FI_3_Shader.h"
+#include "precompiled/FI_4_Shader.h"
+#include "precompiled/FI_5_Shader.h"
+#include "precompiled/FI_6_Shader.h"
+#include "precompiled/FI_7_Shader.h"
+
+#define FI_PRECOMPILED
+
+static const D3D12_SHADER_BYTECODE FI_cso[FI_Count] = {
+    { FI_0_cso, sizeof(FI_0_cso) }, { FI_1_cso, sizeof(FI_1_cso) }, { FI_2_cso, sizeof(FI_2_cso) },
+    { FI_3_cso, sizeof(FI_3_cso) }, { FI_4_cso, sizeof(FI_4_cso) }, { FI_5_cso, sizeof(FI_5_cso) },
+    { FI_6_cso, sizeof(FI_6_cso) }, { FI_7_cso, sizeof(FI_7_cso) }
+};
+#endif
+
+inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32A32_FLOAT;
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32_FLOAT;
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+        return DXGI_FORMAT_R16G16B16A16_FLOAT;
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+        return DXGI_FORMAT_R10G10B10A2_UINT;
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+        return DXGI_FORMAT_B8G8R8A8_UNORM;
+    case DXGI_FORMAT_R16G16_TYPELESS:
+        return DXGI_FORMAT_R16G16_FLOAT;
+    case DXGI_FORMAT_R32G32_TYPELESS:
+        return DXGI_FORMAT_R32G32_FLOAT;
+    case DXGI_FORMAT_R24G8_TYPELESS:
+        return DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+    case DXGI_FORMAT_R32G8X24_TYPELESS:
+        return DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS;
+    case DXGI_FORMAT_R32_TYPELESS:
+        return DXGI_FORMAT_R32_FLOAT;
+    case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+        return DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS;
+    case DXGI_FORMAT_D32_FLOAT:
+        return DXGI_FORMAT_R32_FLOAT;
+    case DXGI_FORMAT_D24_UNORM_S8_UINT:
+        return DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+    default:
+        return format;
+    }
+}
+
+bool FI_Dx12::CreatePipelineState(uint32_t InFlags)
+{
+    D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {};
+    computePsoDesc.pRootSignature = _rootSignature;
+    computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+    ID3DBlob* shaderBlob = nullptr;
+
+#ifdef FI_PRECOMPILED
+    if (Config::Instance()->UsePrecompiledShaders.value_or_default())
+        computePsoDesc.CS = FI_cso[InFlags];
+#endif
+
+    if (computePsoDesc.CS.pShaderBytecode == nullptr)
+    {
+        shaderBlob = FI_CompileShader(fiCode.c_str(), "CSMain", "cs_5_0", InFlags);
+
+        if (shaderBlob == nullptr)
+        {
+            LOG_ERROR("[{0}] FI_CompileShader error, flags: {1}", _name, InFlags);
+            return false;
+        }
+
+        computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+    }
+
+    auto hr = _device->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
+                                                  (void**) &_pipelineStates[InFlags]);
+
+    if (shaderBlob != nullptr)
+        shaderBlob->Release();
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateComputePipelineState error: {1:X}", _name, (unsigned int) hr);
+        _pipelineStates[InFlags] = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool FI_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, const FIParams& InParams)
+{
+    if (!_init || InDevice == nullptr || InCmdList == nullptr || InParams.velocity == nullptr ||
+        InParams.velocityOut == nullptr || InParams.depth == nullptr || InParams.depthOut == nullptr ||
+        InParams.velocityWidth == 0 || InParams.velocityHeight == 0 || InParams.depthWidth == 0 ||
+        InParams.depthHeight == 0)
+    {
+        return false;
+    }
+
+    if (!IsSupported(InParams.flags))
+        return false;
+
+    auto pipelineState = _pipelineStates[InParams.flags];
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    DescriptorRange descriptors {};
+
+    if (!DescriptorHeap_Dx12::Allocate(InDevice, 5, &descriptors))
+        return false;
+
+    auto velocityDesc = InParams.velocity->GetDesc();
+    auto depthDesc = InParams.depth->GetDesc();
+
+    // Create SRVs for Velocity & Depth
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Format = TranslateTypelessFormats(velocityDesc.Format);
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+    InDevice->CreateShaderResourceView(InParams.velocity, &srvDesc, descriptors.Cpu(0));
+
+    srvDesc.Format = TranslateTypelessFormats(depthDesc.Format);
+    InDevice->CreateShaderResourceView(InParams.depth, &srvDesc, descriptors.Cpu(1));
+
+    // Create UAVs for outputs
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = TranslateTypelessFormats(InParams.velocityOut->GetDesc().Format);
+    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+    uavDesc.Texture2D.MipSlice = 0;
+    InDevice->CreateUnorderedAccessView(InParams.velocityOut, nullptr, &uavDesc, descriptors.Cpu(2));
+
+    uavDesc.Format = TranslateTypelessFormats(InParams.depthOut->GetDesc().Format);
+    InDevice->CreateUnorderedAccessView(InParams.depthOut, nullptr, &uavDesc, descriptors.Cpu(3));
+
+    auto flipOffset = Config::Instance()->FGResourceFlipOffset.value_or_default();
+
+    FIConstants constants {};
+    constants.VelocityWidth = InParams.velocityWidth - 1;
+    constants.VelocityHeight = InParams.velocityHeight - 1;
+    constants.VelocityOffset = flipOffset ? velocityDesc.Height - InParams.velocityHeight : 0;
+    constants.DepthWidth = InParams.depthWidth - 1;
+    constants.DepthHeight = InParams.depthHeight - 1;
+    constants.DepthOffset = flipOffset ? depthDesc.Height - InParams.depthHeight : 0;
+    constants.DepthScale = Config::Instance()->FGDepthScaleMax.value_or_default();
+
+    // Copy the updated constant buffer data to the constant buffer resource
+    BYTE* pCBDataBegin;
+    CD3DX12_RANGE readRange(0, 0); // We do not intend to read from this resource on the CPU
+    auto result = _constantBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pCBDataBegin));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] _constantBuffer->Map error {1:x}", _name, (UINT) result);
+        return false;
+    }
+
+    if (pCBDataBegin == nullptr)
+    {
+        _constantBuffer->Unmap(0, nullptr);
+        LOG_ERROR("[{0}] pCBDataBegin is null!", _name);
+        return false;
+    }
+
+    memcpy(pCBDataBegin, &constants, sizeof(constants));
+    _constantBuffer->Unmap(0, nullptr);
+
+    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+    cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
+    cbvDesc.SizeInBytes = sizeof(constants);
+    InDevice->CreateConstantBufferView(&cbvDesc, descriptors.Cpu(4));
+
+    DescriptorHeap_Dx12::Bind(InCmdList, descriptors);
+
+    InCmdList->SetComputeRootSignature(_rootSignature);
+    InCmdList->SetPipelineState(pipelineState);
+
+    // All descriptors are in a single table
+    InCmdList->SetComputeRootDescriptorTable(0, descriptors.Gpu(0));
+
+    auto width = (std::max)(InParams.velocityWidth, InParams.depthWidth);
+    auto height = (std::max)(InParams.velocityHeight + constants.VelocityOffset,
+                             InParams.depthHeight + constants.DepthOffset);
+
+    InCmdList->Dispatch((width + InNumThreadsX - 1) / InNumThreadsX, (height + InNumThreadsY - 1) / InNumThreadsY, 1);
+    DescriptorHeap_Dx12::Restore(InCmdList);
+
+    return true;
+}
+
+FI_Dx12::FI_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _device(InDevice)
+{
+    if (InDevice == nullptr)
+    {
+        LOG_ERROR("InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    // Describe and create the root signature
+    // ---------------------------------------------------
+    D3D12_DESCRIPTOR_RANGE descriptorRange[3];
+
+    // SRV Range (Velocity & Depth)
+    descriptorRange[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    descriptorRange[0].NumDescriptors = 2;
+    descriptorRange[0].BaseShaderRegister = 0; // t0 - t1
+    descriptorRange[0].RegisterSpace = 0;
+    descriptorRange[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // UAV Range (Velocity & Depth outputs)
+    descriptorRange[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+    descriptorRange[1].NumDescriptors = 2;
+    descriptorRange[1].BaseShaderRegister = 0; // u0 - u1
+    descriptorRange[1].RegisterSpace = 0;
+    descriptorRange[1].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // CBV Range (Params)
+    descriptorRange[2].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
+    descriptorRange[2].NumDescriptors = 1;
+    descriptorRange[2].BaseShaderRegister = 0; // b0
+    descriptorRange[2].RegisterSpace = 0;
+    descriptorRange[2].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // Single descriptor table, one root parameter change per dispatch
+    // ---------------------------------------------------
+    D3D12_ROOT_PARAMETER rootParameters[1];
+    rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    rootParameters[0].DescriptorTable.NumDescriptorRanges = 3;
+    rootParameters[0].DescriptorTable.pDescriptorRanges = descriptorRange;
+    rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+    // A root signature is an array of root parameters
+    // ---------------------------------------------------
+    D3D12_ROOT_SIGNATURE_DESC rootSigDesc;
+    rootSigDesc.NumParameters = 1;
+    rootSigDesc.pParameters = rootParameters;
+    rootSigDesc.NumStaticSamplers = 0;
+    rootSigDesc.pStaticSamplers = nullptr;
+    rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    ID3DBlob* errorBlob = nullptr;
+    ID3DBlob* signatureBlob = nullptr;
+
+    do
+    {
+        auto hr = D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] D3D12SerializeRootSignature error {1:x}", _name, (unsigned int) hr);
+            break;
+        }
+
+        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
+                                           IID_PPV_ARGS(&_rootSignature));
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] CreateRootSignature error {1:x}", _name, (unsigned int) hr);
+            break;
+        }
+
+    } while (false);
+
+    if (errorBlob != nullptr)
+    {
+        errorBlob->Release();
+        errorBlob = nullptr;
+    }
+
+    if (signatureBlob != nullptr)
+    {
+        signatureBlob->Release();
+        signatureBlob = nullptr;
+    }
+
+    if (_rootSignature == nullptr)
+    {
+        LOG_ERROR("[{0}] _rootSignature is null!", _name);
+        return;
+    }
+
+    D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(FIConstants));
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+
+    auto hr = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
+                                                D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                                IID_PPV_ARGS(&_constantBuffer));
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, (unsigned int) hr);
+        return;
+    }
+
+    // All permutations are created here so flag changes never compile during a frame
+    // Failed ones stay nullptr and FG uses RF & DS passes for them
+    for (uint32_t flags = 0; flags < FI_Count; flags++)
+        CreatePipelineState(flags);
+
+    _init = true;
+}
+
+FI_Dx12::~FI_Dx12()
+{
+    if (!_init || State::Instance().isShuttingDown)
+        return;
+
+    for (auto& pipelineState : _pipelineStates)
+    {
+        if (pipelineState != nullptr)
+        {
+            pipelineState->Release();
+            pipelineState = nullptr;
+        }
+    }
+
+    if (_rootSignature != nullptr)
+    {
+        _rootSignature->Release();
+        _rootSignature = nullptr;
+    }
+
+    if (_constantBuffer != nullptr)
+    {
+        _constantBuffer->Release();
+        _constantBuffer = nullptr;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <pch.h>
+
+#include "FI_Common.h"
+
+#include <d3d12.h>
+#include <d3dx/d3dx12.h>
+
+// Resources and sizes of a single FG input preparation dispatch
+typedef struct FIParams
+{
+    ID3D12Resource* velocity = nullptr;
+    ID3D12Resource* velocityOut = nullptr;
+    UINT velocityWidth = 0;
+    UINT velocityHeight = 0;
+
+    ID3D12Resource* depth = nullptr;
+    ID3D12Resource* depthOut = nullptr;
+    UINT depthWidth = 0;
+    UINT depthHeight = 0;
+
+    uint32_t flags = FI_None;
+} fi_params;
+
+// Velocity flip, depth flip and depth scale of FG inputs in one dispatch, replaces RF_Dx12 & DS_Dx12 passes
+class FI_Dx12
+{
+  private:
+    std::string _name = "";
+    bool _init = false;
+    ID3D12RootSignature* _rootSignature = nullptr;
+
+    // Every permutation is created in constructor, nullptr when it failed
+    ID3D12PipelineState* _pipelineStates[FI_Count] = {};
+
+    uint32_t InNumThreadsX = 16;
+    uint32_t InNumThreadsY = 16;
+
+    ID3D12Device* _device = nullptr;
+    ID3D12Resource* _constantBuffer = nullptr;
+
+    bool CreatePipelineState(uint32_t InFlags);
+
+  public:
+    // False when the permutation can't be used
+    bool IsSupported(uint32_t InFlags) const
+    {
+        return _init && InFlags < FI_Count && _pipelineStates[InFlags] != nullptr;
+    }
+
+    // Returns false when permutation can't be created, caller should use the separate passes
+    bool Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, const FIParams& InParams);
+
+    bool IsInit() const { return _init; }
+
+    FI_Dx12(std::string InName, ID3D12Device* InDevice);
+
+    ~FI_Dx12();
+};
@@ -0,0 +1,75 @@
+// Permutation is selected with -D, see build_FI_permutations.bat, missing defines are disabled transforms
+#ifndef FLIP_VELOCITY
+#define FLIP_VELOCITY 0
+#endif
+
+#ifndef FLIP_DEPTH
+#define FLIP_DEPTH 0
+#endif
+
+#ifndef SCALE_DEPTH
+#define SCALE_DEPTH 0
+#endif
+
+cbuffer Params : register(b0)
+{
+    uint VelocityWidth;
+    uint VelocityHeight;
+    uint VelocityOffset;
+    uint DepthWidth;
+    uint DepthHeight;
+    uint DepthOffset;
+    float DepthScale;
+};
+
+Texture2D<float2> Velocity : register(t0);
+Texture2D<float> Depth : register(t1);
+
+RWTexture2D<float2> VelocityOut : register(u0);
+RWTexture2D<float> DepthOut : register(u1);
+
+// Output position of a source pixel, flip follows RF_Dx12 (uint math, wrapped rows are dropped)
+bool Target(uint2 pos, uint width, uint height, uint offset, bool flip, out uint2 target)
+{
+    target = pos;
+
+    if (pos.x > width)
+        return false;
+
+    if (!flip)
+        return pos.y <= height;
+
+    if (pos.y < offset || pos.y > (height + offset))
+        return false;
+
+    target.y = height - pos.y - offset;
+    return true;
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint2 target;
+
+    if (Target(dispatchThreadID.xy, VelocityWidth, VelocityHeight, VelocityOffset, FLIP_VELOCITY, target))
+    {
+        float2 velocity = Velocity.Load(int3(dispatchThreadID.xy, 0));
+
+#if FLIP_VELOCITY
+        velocity.y = -velocity.y;
+#endif
+
+        VelocityOut[target] = velocity;
+    }
+
+    if (Target(dispatchThreadID.xy, DepthWidth, DepthHeight, DepthOffset, FLIP_DEPTH, target))
+    {
+        float depth = Depth.Load(int3(dispatchThreadID.xy, 0));
+
+#if SCALE_DEPTH
+        depth = saturate(depth / DepthScale);
+#endif
+
+        DepthOut[target] = depth;
+    }
+}
@@ -0,0 +1,21 @@
+@echo off
+
+rem Creates FI_<flags>_Shader.h for every FIFlags combination, index bits follow FI_Common.h
+rem Only enabled transforms are defined (as 1), FI.hlsl defaults the rest to 0
+cd /d "%~dp0"
+
+for /L %%i in (0,1,7) do call :build %%i
+exit /b 0
+
+:build
+set Defines=
+set /a FlipVelocity="%1 & 1"
+set /a FlipDepth="(%1 >> 1) & 1"
+set /a ScaleDepth="(%1 >> 2) & 1"
+
+if %FlipVelocity%==1 set Defines=%Defines% -D FLIP_VELOCITY
+if %FlipDepth%==1 set Defines=%Defines% -D FLIP_DEPTH
+if %ScaleDepth%==1 set Defines=%Defines% -D SCALE_DEPTH
+
+call "%~dp0..\..\shader_tools\build_precompiled_permutation.bat" FI %1 %Defines%
+exit /b 0
@@ -1,6 +1,7 @@
 #include "HC_Dx12.h"
 
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 DXGI_FORMAT HC_Dx12::ToSRGB(DXGI_FORMAT f)
 {
@@ -93,6 +94,7 @@ bool HC_Dx12::CreateBufferResource(UINT index, ID3D12Device* InDevice, ID3D12Res
     }
 
     _buffer[index]->SetName(L"HC_Buffer");
+    VramTracker::Track(_buffer[index], VramOwner::Shaders);
     _bufferState[index] = InState;
 
     return true;
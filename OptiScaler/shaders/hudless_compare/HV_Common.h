@@ -0,0 +1,68 @@
+#pragma once
+
+#include "pch.h"
+
+#include "HC_Common.h"
+
+// Root constants of validation pass
+struct HVConstants
+{
+    UINT Width;
+    UINT Height;
+    UINT SampleWidth;
+    UINT SampleHeight;
+};
+
+// Compares one pixel per 8x8 cell of hudless candidate and back buffer, difference is binned into a histogram
+// Bins are reduced in group shared memory first so each group does at most 16 global atomics
+// Keep bin edges and sampled pixel same with Hudfix_Common::ValidationBin and CR_Cpu::HudlessHistogram
+// Same source with precompile/HV.hlsl, which is used when UsePrecompiledShaders is set and header exists
+static std::string hvCode = R"(
+#define BIN_COUNT 16
+#define CELL_SIZE 8
+
+cbuffer Params : register(b0)
+{
+    uint Width;
+    uint Height;
+    uint SampleWidth;
+    uint SampleHeight;
+};
+
+Texture2D<float4> Hudless : register(t0);
+Texture2D<float4> BackBuffer : register(t1);
+
+RWByteAddressBuffer Histogram : register(u0);
+
+groupshared uint gsBins[BIN_COUNT];
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex < BIN_COUNT)
+        gsBins[groupIndex] = 0;
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (dispatchThreadID.x < SampleWidth && dispatchThreadID.y < SampleHeight)
+    {
+        uint2 pos = min(dispatchThreadID.xy * CELL_SIZE + CELL_SIZE / 2, uint2(Width - 1, Height - 1));
+
+        float3 diff = abs(Hudless.Load(int3(pos, 0)).rgb - BackBuffer.Load(int3(pos, 0)).rgb);
+        float d = max(max(diff.r, diff.g), diff.b);
+
+        uint bin = 0;
+
+        [unroll]
+        for (uint i = 1; i < BIN_COUNT; i++)
+            bin += d >= (float) (i * i) / (float) (BIN_COUNT * BIN_COUNT) ? 1 : 0;
+
+        InterlockedAdd(gsBins[bin], 1);
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex < BIN_COUNT && gsBins[groupIndex] > 0)
+        Histogram.InterlockedAdd(groupIndex * 4, gsBins[groupIndex]);
+}
+)";
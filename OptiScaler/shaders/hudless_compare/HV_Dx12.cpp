@@ -0,0 +1,460 @@
+#include "HV_Dx12.h"
+
+#include <Config.h>
+#include <State.h>
+#include <misc/VramTracker.h>
+#include <shaders/DescriptorHeap_Dx12.h>
+
+// Header is created with "build_precompiled_shader.bat HV" in precompile folder
+#if __has_include("precompile/HV_Shader.h")
+#include "precompile/HV_Shader.h"
+#define HV_PRECOMPILED
+#endif
+
+inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32A32_FLOAT;
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32_FLOAT;
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+        return DXGI_FORMAT_R16G16B16A16_FLOAT;
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+        return DXGI_FORMAT_R10G10B10A2_UNORM;
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+        return DXGI_FORMAT_B8G8R8A8_UNORM;
+    default:
+        return format;
+    }
+}
+
+void HV_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
+                              D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState)
+{
+    if (InBeforeState == InAfterState)
+        return;
+
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = InResource;
+    barrier.Transition.StateBefore = InBeforeState;
+    barrier.Transition.StateAfter = InAfterState;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    InCommandList->ResourceBarrier(1, &barrier);
+}
+
+bool HV_Dx12::Dispatch(ID3D12CommandQueue* InQueue, ID3D12Resource* InHudless, D3D12_RESOURCE_STATES InState,
+                       ID3D12Resource* InBackBuffer, void* InCandidate)
+{
+    if (!_init || InQueue == nullptr || InHudless == nullptr || InBackBuffer == nullptr)
+        return false;
+
+    auto slot = &_slots[_next];
+
+    // GPU is too far behind or results are not collected yet, skip this frame instead of waiting
+    if (slot->pending)
+    {
+        LOG_DEBUG("[{0}] All readback slots are in flight, skipping", _name);
+        return false;
+    }
+
+    auto hudlessDesc = InHudless->GetDesc();
+    auto backBufferDesc = InBackBuffer->GetDesc();
+
+    if (hudlessDesc.Width != backBufferDesc.Width || hudlessDesc.Height != backBufferDesc.Height)
+    {
+        LOG_DEBUG("[{0}] Size mismatch, hudless: {1}x{2}, back buffer: {3}x{4}", _name, hudlessDesc.Width,
+                  hudlessDesc.Height, backBufferDesc.Width, backBufferDesc.Height);
+        return false;
+    }
+
+    DescriptorRange descriptors {};
+
+    if (!DescriptorHeap_Dx12::Allocate(_device, 3, &descriptors))
+        return false;
+
+    auto result = slot->allocator->Reset();
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] allocator->Reset() error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    auto cmdList = slot->commandList;
+    result = cmdList->Reset(slot->allocator, nullptr);
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] commandList->Reset error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    // Create views
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+    srvDesc.Format = TranslateTypelessFormats(hudlessDesc.Format);
+    _device->CreateShaderResourceView(InHudless, &srvDesc, descriptors.Cpu(0));
+
+    srvDesc.Format = TranslateTypelessFormats(backBufferDesc.Format);
+    _device->CreateShaderResourceView(InBackBuffer, &srvDesc, descriptors.Cpu(1));
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = Hudfix_Common::ValidationBinCount;
+    uavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+    _device->CreateUnorderedAccessView(_histogram, nullptr, &uavDesc, descriptors.Cpu(2));
+
+    // Clear histogram
+    cmdList->CopyBufferRegion(_histogram, 0, _zeroBuffer, 0, HistogramSize);
+
+    D3D12_RESOURCE_BARRIER barriers[3] = {};
+    barriers[0] = CD3DX12_RESOURCE_BARRIER::Transition(_histogram, D3D12_RESOURCE_STATE_COPY_DEST,
+                                                       D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    barriers[1] = CD3DX12_RESOURCE_BARRIER::Transition(InBackBuffer, D3D12_RESOURCE_STATE_PRESENT,
+                                                       D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    UINT barrierCount = 2;
+
+    if (InState != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+    {
+        barriers[2] = CD3DX12_RESOURCE_BARRIER::Transition(InHudless, InState,
+                                                           D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+        barrierCount++;
+    }
+
+    cmdList->ResourceBarrier(barrierCount, barriers);
+
+    HVConstants constants {};
+    constants.Width = (UINT) backBufferDesc.Width;
+    constants.Height = backBufferDesc.Height;
+    constants.SampleWidth = (constants.Width + Hudfix_Common::ValidationCellSize - 1) /
+                            Hudfix_Common::ValidationCellSize;
+    constants.SampleHeight = (constants.Height + Hudfix_Common::ValidationCellSize - 1) /
+                             Hudfix_Common::ValidationCellSize;
+
+    ID3D12DescriptorHeap* heaps[] = { descriptors.heap };
+    cmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+
+    cmdList->SetComputeRootSignature(_rootSignature);
+    cmdList->SetPipelineState(_pipelineState);
+    cmdList->SetComputeRootDescriptorTable(0, descriptors.Gpu(0));
+    cmdList->SetComputeRoot32BitConstants(1, sizeof(constants) / sizeof(UINT), &constants, 0);
+
+    cmdList->Dispatch((constants.SampleWidth + 7) / 8, (constants.SampleHeight + 7) / 8, 1);
+
+    // Restore states & copy histogram to readback slot
+    for (UINT i = 0; i < barrierCount; i++)
+        std::swap(barriers[i].Transition.StateBefore, barriers[i].Transition.StateAfter);
+
+    barriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+    cmdList->ResourceBarrier(barrierCount, barriers);
+
+    cmdList->CopyBufferRegion(slot->buffer, 0, _histogram, 0, HistogramSize);
+
+    ResourceBarrier(cmdList, _histogram, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    result = cmdList->Close();
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] commandList->Close error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    ID3D12CommandList* cmdLists[] = { cmdList };
+    InQueue->ExecuteCommandLists(1, cmdLists);
+
+    _fenceValue++;
+    result = InQueue->Signal(_fence, _fenceValue);
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] Signal error: {1:X}", _name, (UINT) result);
+        return false;
+    }
+
+    slot->fenceValue = _fenceValue;
+    slot->candidate = InCandidate;
+    slot->pending = true;
+
+    _next = (_next + 1) % RingSize;
+
+    return true;
+}
+
+void HV_Dx12::Collect(std::vector<HVResult>& OutResults)
+{
+    if (!_init)
+        return;
+
+    auto completed = _fence->GetCompletedValue();
+
+    // Oldest slot first, so results are in dispatch order
+    for (UINT i = 0; i < RingSize; i++)
+    {
+        auto slot = &_slots[(_next + i) % RingSize];
+
+        if (!slot->pending || completed < slot->fenceValue)
+            continue;
+
+        slot->pending = false;
+
+        uint32_t* data = nullptr;
+        D3D12_RANGE readRange { 0, HistogramSize };
+        auto result = slot->buffer->Map(0, &readRange, reinterpret_cast<void**>(&data));
+
+        if (result != S_OK || data == nullptr)
+        {
+            LOG_ERROR("[{0}] readback Map error: {1:X}", _name, (UINT) result);
+            continue;
+        }
+
+        HVResult hvResult {};
+        hvResult.candidate = slot->candidate;
+        memcpy(hvResult.histogram, data, HistogramSize);
+
+        D3D12_RANGE writeRange { 0, 0 };
+        slot->buffer->Unmap(0, &writeRange);
+
+        OutResults.push_back(hvResult);
+    }
+}
+
+HV_Dx12::HV_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _device(InDevice)
+{
+    if (InDevice == nullptr)
+    {
+        LOG_ERROR("InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    // Root signature, textures & histogram in a table and sizes as root constants
+    // Constants are part of the command list so in flight validations don't share a constant buffer
+    CD3DX12_DESCRIPTOR_RANGE1 ranges[2] {};
+    ranges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 2, 0); // t0 - t1
+    ranges[1].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0); // u0
+
+    CD3DX12_ROOT_PARAMETER1 rootParameters[2] {};
+    rootParameters[0].InitAsDescriptorTable(_countof(ranges), ranges);
+    rootParameters[1].InitAsConstants(sizeof(HVConstants) / sizeof(UINT), 0); // b0
+
+    CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSigDesc;
+    rootSigDesc.Init_1_1(_countof(rootParameters), rootParameters, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+    ID3DBlob* errorBlob = nullptr;
+    ID3DBlob* signatureBlob = nullptr;
+
+    auto hr = D3D12SerializeVersionedRootSignature(&rootSigDesc, &signatureBlob, &errorBlob);
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] D3D12SerializeVersionedRootSignature error {1:x}", _name, (unsigned int) hr);
+
+        if (errorBlob != nullptr)
+            errorBlob->Release();
+
+        return;
+    }
+
+    hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
+                                       IID_PPV_ARGS(&_rootSignature));
+
+    signatureBlob->Release();
+
+    if (errorBlob != nullptr)
+        errorBlob->Release();
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateRootSignature error {1:x}", _name, (unsigned int) hr);
+        return;
+    }
+
+    // Validation is disabled when shader can't be created
+    D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {};
+    computePsoDesc.pRootSignature = _rootSignature;
+
+    ID3DBlob* shaderBlob = nullptr;
+
+#ifdef HV_PRECOMPILED
+    if (Config::Instance()->UsePrecompiledShaders.value_or_default())
+        computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(HV_cso), sizeof(HV_cso));
+#endif
+
+    if (computePsoDesc.CS.pShaderBytecode == nullptr)
+    {
+        shaderBlob = HC_CompileShader(hvCode.c_str(), "CSMain", "cs_5_0");
+
+        if (shaderBlob == nullptr)
+        {
+            LOG_ERROR("[{0}] HC_CompileShader error", _name);
+            return;
+        }
+
+        computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+    }
+
+    hr = InDevice->CreateComputePipelineState(&computePsoDesc, IID_PPV_ARGS(&_pipelineState));
+
+    if (shaderBlob != nullptr)
+        shaderBlob->Release();
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateComputePipelineState error: {1:X}", _name, (unsigned int) hr);
+        return;
+    }
+
+    // Buffers
+    auto defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    auto uavDesc = CD3DX12_RESOURCE_DESC::Buffer(HistogramSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+    hr = InDevice->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &uavDesc,
+                                           D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&_histogram));
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource(histogram) error {1:x}", _name, (unsigned int) hr);
+        return;
+    }
+
+    _histogram->SetName(L"HV_Histogram");
+    VramTracker::Track(_histogram, VramOwner::Shaders);
+
+    auto uploadHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(HistogramSize);
+
+    hr = InDevice->CreateCommittedResource(&uploadHeap, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                           D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&_zeroBuffer));
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource(zero) error {1:x}", _name, (unsigned int) hr);
+        return;
+    }
+
+    void* zeroData = nullptr;
+    CD3DX12_RANGE readRange(0, 0);
+
+    if (_zeroBuffer->Map(0, &readRange, &zeroData) != S_OK || zeroData == nullptr)
+    {
+        LOG_ERROR("[{0}] _zeroBuffer->Map error", _name);
+        return;
+    }
+
+    memset(zeroData, 0, HistogramSize);
+    _zeroBuffer->Unmap(0, nullptr);
+
+    auto readbackHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+
+    for (size_t i = 0; i < RingSize; i++)
+    {
+        hr = InDevice->CreateCommittedResource(&readbackHeap, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                               D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                               IID_PPV_ARGS(&_slots[i].buffer));
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] CreateCommittedResource(readback) error {1:x}", _name, (unsigned int) hr);
+            return;
+        }
+
+        hr = InDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_slots[i].allocator));
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] CreateCommandAllocator error: {1:X}", _name, (unsigned long) hr);
+            return;
+        }
+
+        hr = InDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _slots[i].allocator, NULL,
+                                         IID_PPV_ARGS(&_slots[i].commandList));
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] CreateCommandList error: {1:X}", _name, (unsigned long) hr);
+            return;
+        }
+
+        _slots[i].commandList->SetName(L"HV_CommandList");
+        _slots[i].commandList->Close();
+    }
+
+    hr = InDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateFence error: {1:X}", _name, (unsigned long) hr);
+        return;
+    }
+
+    _init = true;
+}
+
+HV_Dx12::~HV_Dx12()
+{
+    if (State::Instance().isShuttingDown)
+        return;
+
+    // Command lists might still be in flight
+    if (_fence != nullptr && _fence->GetCompletedValue() < _fenceValue)
+    {
+        auto event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+        if (event != nullptr)
+        {
+            _fence->SetEventOnCompletion(_fenceValue, event);
+            WaitForSingleObject(event, 500);
+            CloseHandle(event);
+        }
+    }
+
+    for (auto& slot : _slots)
+    {
+        if (slot.commandList != nullptr)
+            slot.commandList->Release();
+
+        if (slot.allocator != nullptr)
+            slot.allocator->Release();
+
+        if (slot.buffer != nullptr)
+            slot.buffer->Release();
+
+        slot = {};
+    }
+
+    if (_fence != nullptr)
+    {
+        _fence->Release();
+        _fence = nullptr;
+    }
+
+    if (_pipelineState != nullptr)
+    {
+        _pipelineState->Release();
+        _pipelineState = nullptr;
+    }
+
+    if (_rootSignature != nullptr)
+    {
+        _rootSignature->Release();
+        _rootSignature = nullptr;
+    }
+
+    if (_histogram != nullptr)
+    {
+        _histogram->Release();
+        _histogram = nullptr;
+    }
+
+    if (_zeroBuffer != nullptr)
+    {
+        _zeroBuffer->Release();
+        _zeroBuffer = nullptr;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <pch.h>
+
+#include "HV_Common.h"
+
+#include <hudfix/Hudfix_Common.h>
+
+#include <d3d12.h>
+#include <d3dx/d3dx12.h>
+
+// Histogram of a completed validation, candidate is the resource Hudfix captured hudless from
+typedef struct HVResult
+{
+    void* candidate = nullptr;
+    uint32_t histogram[Hudfix_Common::ValidationBinCount] {};
+} hv_result;
+
+// Compares hudless with the final back buffer at low resolution to rate the captured resource
+// Histograms are copied to a ring of readback buffers and collected frames later when their fence is completed,
+// CPU never waits for the GPU
+class HV_Dx12
+{
+  private:
+    static constexpr UINT RingSize = 4;
+    static constexpr UINT HistogramSize = Hudfix_Common::ValidationBinCount * sizeof(uint32_t);
+
+    typedef struct ReadbackSlot
+    {
+        ID3D12Resource* buffer = nullptr;
+        ID3D12CommandAllocator* allocator = nullptr;
+        ID3D12GraphicsCommandList* commandList = nullptr;
+        UINT64 fenceValue = 0;
+        void* candidate = nullptr;
+        bool pending = false;
+    } readback_slot;
+
+    std::string _name = "";
+    bool _init = false;
+
+    ID3D12Device* _device = nullptr;
+    ID3D12RootSignature* _rootSignature = nullptr;
+    ID3D12PipelineState* _pipelineState = nullptr;
+
+    // Histogram is cleared with a copy from zero buffer before every dispatch
+    ID3D12Resource* _histogram = nullptr;
+    ID3D12Resource* _zeroBuffer = nullptr;
+
+    ReadbackSlot _slots[RingSize] {};
+    UINT _next = 0;
+
+    ID3D12Fence* _fence = nullptr;
+    UINT64 _fenceValue = 0;
+
+    static void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
+                                D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
+
+  public:
+    // Records validation to its own command list and executes it on InQueue
+    // Back buffer should be in present state, skipped when all readback slots are still in flight
+    bool Dispatch(ID3D12CommandQueue* InQueue, ID3D12Resource* InHudless, D3D12_RESOURCE_STATES InState,
+                  ID3D12Resource* InBackBuffer, void* InCandidate);
+
+    // Appends results of validations completed by the GPU
+    void Collect(std::vector<HVResult>& OutResults);
+
+    bool IsInit() const { return _init; }
+
+    HV_Dx12(std::string InName, ID3D12Device* InDevice);
+
+    ~HV_Dx12();
+};
@@ -14,6 +14,7 @@
 #include <shaders/fsr1/FSR_EASU_Shader_Dx11.h>
 
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -83,6 +84,8 @@ bool OS_Dx11::CreateBufferResource(ID3D11Device* InDevice, ID3D11Resource* InRes
         return false;
     }
 
+    VramTracker::Track(_buffer, VramOwner::Shaders);
+
     return true;
 }
 
@@ -14,15 +14,8 @@ class OS_Dx12
     bool _init = false;
     ID3D12RootSignature* _rootSignature = nullptr;
     ID3D12PipelineState* _pipelineState = nullptr;
-    ID3D12DescriptorHeap* _srvHeap[3] = { nullptr, nullptr, nullptr };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuCbvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuCbvHandle[2] { { NULL }, { NULL } };
-    int _counter = 0;
     bool _upsample = false;
+    uint32_t _downscaler = 0;
 
     uint32_t InNumThreadsX = 16;
     uint32_t InNumThreadsY = 16;
@@ -42,6 +35,8 @@ class OS_Dx12
 
     ID3D12Resource* Buffer() { return _buffer; }
     bool IsUpsampling() { return _upsample; }
+    uint32_t Downscaler() const { return _downscaler; }
+    ID3D12Device* Device() const { return _device; }
     bool IsInit() const { return _init; }
     bool CanRender() const { return _init && _buffer != nullptr; }
 
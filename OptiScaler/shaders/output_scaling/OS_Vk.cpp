@@ -0,0 +1,63 @@
+#include "OS_Vk.h"
+
+#include "precompile/bcus_Shader_Vk.h"
+#include "precompile/bcds_bicubic_Shader_Vk.h"
+
+#include <Config.h>
+
+bool OS_Vk::CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource, uint32_t InWidth,
+                                 uint32_t InHeight)
+{
+    if (!_init || InCmdBuffer == VK_NULL_HANDLE || InSource == nullptr)
+        return false;
+
+    return CreateBuffer(InCmdBuffer, InSource->Resource.ImageViewInfo.Format, InWidth, InHeight);
+}
+
+bool OS_Vk::Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource,
+                     NVSDK_NGX_Resource_VK* OutResource)
+{
+    if (!_init || InResource == nullptr || OutResource == nullptr)
+        return false;
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    auto& inInfo = InResource->Resource.ImageViewInfo;
+    auto& outInfo = OutResource->Resource.ImageViewInfo;
+
+    InternalConstants constants {};
+    constants.SrcWidth = inInfo.Width;
+    constants.SrcHeight = inInfo.Height;
+    constants.DstWidth = outInfo.Width;
+    constants.DstHeight = outInfo.Height;
+
+    const NVSDK_NGX_Resource_VK* inputs[] = { InResource };
+
+    return Shader_Vk::Dispatch(InCmdBuffer, inputs, OutResource, &constants, outInfo.Width, outInfo.Height);
+}
+
+OS_Vk::OS_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice, bool InUpsample)
+    : Shader_Vk(InName, InPD, InDevice), _upsample(InUpsample)
+{
+    if (InPD == VK_NULL_HANDLE || InDevice == VK_NULL_HANDLE)
+    {
+        LOG_ERROR("InPD or InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    if (Config::Instance()->OutputScalingUseFsr.value_or_default())
+        LOG_WARN("[{0}] FSR1 is not available on Vulkan, using bicubic", _name);
+
+    if (_upsample)
+    {
+        _init = CreatePipeline(bcus_spv, sizeof(bcus_spv), 1, sizeof(InternalConstants));
+        return;
+    }
+
+    if (Config::Instance()->OutputScalingDownscaler.value_or_default() != 0)
+        LOG_WARN("[{0}] Only bicubic downscaler is available on Vulkan", _name);
+
+    _init = CreatePipeline(bcds_bicubic_spv, sizeof(bcds_bicubic_spv), 1, sizeof(InternalConstants));
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <pch.h>
+
+#include <shaders/Shader_Vk.h>
+
+// Vulkan has BCUS for upsampling and bicubic for downsampling, FSR1 and other downscalers are Dx only
+class OS_Vk : public Shader_Vk
+{
+  private:
+    // Push constant layout of bcus/bcds_bicubic .spvasm and _Vk.hlsl sources
+    struct InternalConstants
+    {
+        int SrcWidth;
+        int SrcHeight;
+        int DstWidth;
+        int DstHeight;
+    };
+
+    bool _upsample = false;
+
+  public:
+    bool CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource, uint32_t InWidth,
+                              uint32_t InHeight);
+    bool Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource, NVSDK_NGX_Resource_VK* OutResource);
+
+    bool IsUpsampling() { return _upsample; }
+
+    OS_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice, bool InUpsample);
+};
@@ -0,0 +1,86 @@
+// Vulkan version of bcds_bicubic.hlsl
+// Compile with build_precompiled_shader_vk.bat bcds_bicubic
+//
+// Out of bounds texels are 0 like Texture2D.Load, image fetch doesn't do it on Vulkan
+
+struct Params
+{
+    int SrcWidth;
+    int SrcHeight;
+    int DstWidth;
+    int DstHeight;
+};
+
+[[vk::push_constant]] Params params;
+
+[[vk::binding(0, 0)]] Texture2D<float4> Source;
+[[vk::binding(1, 0)]] [[vk::image_format("unknown")]] RWTexture2D<float4> Dest;
+
+float4 LoadSource(int2 pos)
+{
+    int2 size = int2(params.SrcWidth, params.SrcHeight);
+    float4 texel = Source.Load(int3(clamp(pos, 0, size - 1), 0));
+    return all(pos >= 0 && pos < size) ? texel : 0.0;
+}
+
+float Luminance(float3 color)
+{
+    return dot(color, float3(0.2126, 0.7152, 0.0722));
+}
+
+float BicubicWeight(float x)
+{
+    float a = -0.75f;
+    float absX = abs(x);
+
+    if (absX <= 1.0f)
+        return (a + 2.0f) * absX * absX * absX - (a + 3.0f) * absX * absX + 1.0f;
+    else if (absX < 2.0f)
+        return a * absX * absX * absX - 5.0f * a * absX * absX + 8.0f * a * absX - 4.0f * a;
+    else
+        return 0.0f;
+}
+
+// 256 invocations, Shader_Vk checks maxComputeWorkGroupInvocations before creating the pipeline
+[numthreads(16, 16, 1)]
+void CSMain(uint3 DTid : SV_DispatchThreadID)
+{
+    if ((int) DTid.x >= params.DstWidth || (int) DTid.y >= params.DstHeight)
+        return;
+
+    float2 uv = float2(DTid.x / (params.DstWidth - 1.0f), DTid.y / (params.DstHeight - 1.0f));
+    float2 pixel = uv * float2(params.SrcWidth, params.SrcHeight);
+    float2 texel = floor(pixel);
+    int2 base = int2(texel);
+    float2 t = pixel - texel;
+    t = t * t * (3.0f - 2.0f * t);
+
+    float avgLuminance = 0.0;
+
+    for (int y = -1; y <= 2; y++)
+    {
+        for (int x = -1; x <= 2; x++)
+            avgLuminance += Luminance(LoadSource(base + int2(x, y)).rgb);
+    }
+
+    avgLuminance /= 16.0;
+
+    float4 result = 0.0;
+
+    for (int y = -1; y <= 2; y++)
+    {
+        for (int x = -1; x <= 2; x++)
+        {
+            float4 color = LoadSource(base + int2(x, y));
+            float currentLuminance = Luminance(color.rgb);
+
+            // Scale the color to match the average luminance if it deviates too much
+            if (abs(currentLuminance - avgLuminance) > 0.5)
+                color.rgb *= avgLuminance / max(currentLuminance, 1e-5);
+
+            result += color * BicubicWeight(x - t.x) * BicubicWeight(y - t.y);
+        }
+    }
+
+    Dest[DTid.xy] = result;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+inline static const uint32_t bcus_spv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x000000bd, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+    0x00000038, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e,
+    0x00000000, 0x00000001, 0x0006000f, 0x00000005, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003,
+    0x00060010, 0x00000002, 0x00000011, 0x00000010, 0x00000010, 0x00000001, 0x00040047, 0x00000003,
+    0x0000000b, 0x0000001c, 0x00030047, 0x00000004, 0x00000002, 0x00050048, 0x00000004, 0x00000000,
+    0x00000023, 0x00000000, 0x00050048, 0x00000004, 0x00000001, 0x00000023, 0x00000004, 0x00050048,
+    0x00000004, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000004, 0x00000003, 0x00000023,
+    0x0000000c, 0x00040047, 0x00000005, 0x00000022, 0x00000000, 0x00040047, 0x00000005, 0x00000021,
+    0x00000000, 0x00040047, 0x00000006, 0x00000022, 0x00000000, 0x00040047, 0x00000006, 0x00000021,
+    0x00000001, 0x00030047, 0x00000006, 0x00000019, 0x00020013, 0x00000007, 0x00030021, 0x00000008,
+    0x00000007, 0x00020014, 0x00000009, 0x00040015, 0x0000000a, 0x00000020, 0x00000000, 0x00040015,
+    0x0000000b, 0x00000020, 0x00000001, 0x00030016, 0x0000000c, 0x00000020, 0x00040017, 0x0000000d,
+    0x00000009, 0x00000002, 0x00040017, 0x0000000e, 0x00000009, 0x00000004, 0x00040017, 0x0000000f,
+    0x0000000b, 0x00000002, 0x00040017, 0x00000010, 0x0000000a, 0x00000002, 0x00040017, 0x00000011,
+    0x0000000a, 0x00000003, 0x00040017, 0x00000012, 0x0000000c, 0x00000004, 0x00040021, 0x00000013,
+    0x00000012, 0x0000000f, 0x00040021, 0x00000014, 0x0000000c, 0x0000000c, 0x00040021, 0x00000015,
+    0x00000012, 0x0000000c, 0x00060021, 0x00000016, 0x00000012, 0x0000000b, 0x0000000b, 0x00000012,
+    0x00090019, 0x00000017, 0x0000000c, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001,
+    0x00000000, 0x00090019, 0x00000018, 0x0000000c, 0x00000001, 0x00000000, 0x00000000, 0x00000000,
+    0x00000002, 0x00000000, 0x00040020, 0x00000019, 0x00000000, 0x00000017, 0x00040020, 0x0000001a,
+    0x00000000, 0x00000018, 0x0006001e, 0x00000004, 0x0000000b, 0x0000000b, 0x0000000b, 0x0000000b,
+    0x00040020, 0x0000001b, 0x00000009, 0x00000004, 0x00040020, 0x0000001c, 0x00000009, 0x0000000b,
+    0x00040020, 0x0000001d, 0x00000001, 0x00000011, 0x0004002b, 0x0000000b, 0x0000001e, 0x00000000,
+    0x0004002b, 0x0000000b, 0x0000001f, 0x00000001, 0x0004002b, 0x0000000b, 0x00000020, 0x00000002,
+    0x0004002b, 0x0000000b, 0x00000021, 0x00000003, 0x0004002b, 0x0000000c, 0x00000022, 0x00000000,
+    0x0004002b, 0x0000000c, 0x00000023, 0x3f000000, 0x0004002b, 0x0000000c, 0x00000024, 0x3f800000,
+    0x0004002b, 0x0000000c, 0x00000025, 0x3fc00000, 0x0004002b, 0x0000000c, 0x00000026, 0x40000000,
+    0x0004002b, 0x0000000c, 0x00000027, 0x40200000, 0x0004002b, 0x0000000c, 0x00000028, 0x40800000,
+    0x0004002b, 0x0000000c, 0x00000029, 0x40a00000, 0x0004002b, 0x0000000c, 0x0000002a, 0x41000000,
+    0x0004002b, 0x0000000c, 0x0000002b, 0x41800000, 0x0004002b, 0x0000000c, 0x0000002c, 0xbf000000,
+    0x0005002c, 0x0000000f, 0x0000002d, 0x0000001e, 0x0000001e, 0x0005002c, 0x0000000f, 0x0000002e,
+    0x0000001f, 0x0000001f, 0x0007002c, 0x00000012, 0x0000002f, 0x00000022, 0x00000022, 0x00000022,
+    0x00000022, 0x0004003b, 0x0000001b, 0x00000030, 0x00000009, 0x0004003b, 0x00000019, 0x00000005,
+    0x00000000, 0x0004003b, 0x0000001a, 0x00000006, 0x00000000, 0x0004003b, 0x0000001d, 0x00000003,
+    0x00000001, 0x00050036, 0x00000012, 0x00000031, 0x00000000, 0x00000013, 0x00030037, 0x0000000f,
+    0x00000032, 0x000200f8, 0x00000033, 0x00050041, 0x0000001c, 0x00000034, 0x00000030, 0x0000001e,
+    0x0004003d, 0x0000000b, 0x00000035, 0x00000034, 0x00050041, 0x0000001c, 0x00000036, 0x00000030,
+    0x0000001f, 0x0004003d, 0x0000000b, 0x00000037, 0x00000036, 0x00050050, 0x0000000f, 0x00000038,
+    0x00000035, 0x00000037, 0x000500af, 0x0000000d, 0x00000039, 0x00000032, 0x0000002d, 0x000500b1,
+    0x0000000d, 0x0000003a, 0x00000032, 0x00000038, 0x000500a7, 0x0000000d, 0x0000003b, 0x00000039,
+    0x0000003a, 0x0004009b, 0x00000009, 0x0000003c, 0x0000003b, 0x00050082, 0x0000000f, 0x0000003d,
+    0x00000038, 0x0000002e, 0x0008000c, 0x0000000f, 0x0000003e, 0x00000001, 0x0000002d, 0x00000032,
+    0x0000002d, 0x0000003d, 0x0004003d, 0x00000017, 0x0000003f, 0x00000005, 0x0007005f, 0x00000012,
+    0x00000040, 0x0000003f, 0x0000003e, 0x00000002, 0x0000001e, 0x00070050, 0x0000000e, 0x00000041,
+    0x0000003c, 0x0000003c, 0x0000003c, 0x0000003c, 0x000600a9, 0x00000012, 0x00000042, 0x00000041,
+    0x00000040, 0x0000002f, 0x000200fe, 0x00000042, 0x00010038, 0x00050036, 0x0000000c, 0x00000043,
+    0x00000000, 0x00000014, 0x00030037, 0x0000000c, 0x00000044, 0x000200f8, 0x00000045, 0x00050085,
+    0x0000000c, 0x00000046, 0x00000044, 0x00000044, 0x00050085, 0x0000000c, 0x00000047, 0x00000025,
+    0x00000044, 0x00050083, 0x0000000c, 0x00000048, 0x00000047, 0x00000027, 0x00050085, 0x0000000c,
+    0x00000049, 0x00000046, 0x00000048, 0x00050081, 0x0000000c, 0x0000004a, 0x00000049, 0x00000024,
+    0x000200fe, 0x0000004a, 0x00010038, 0x00050036, 0x0000000c, 0x0000004b, 0x00000000, 0x00000014,
+    0x00030037, 0x0000000c, 0x0000004c, 0x000200f8, 0x0000004d, 0x00050083, 0x0000000c, 0x0000004e,
+    0x0000004c, 0x00000029, 0x00050085, 0x0000000c, 0x0000004f, 0x0000004c, 0x0000004e, 0x00050081,
+    0x0000000c, 0x00000050, 0x0000004f, 0x0000002a, 0x00050085, 0x0000000c, 0x00000051, 0x0000004c,
+    0x00000050, 0x00050083, 0x0000000c, 0x00000052, 0x00000051, 0x00000028, 0x00050085, 0x0000000c,
+    0x00000053, 0x0000002c, 0x00000052, 0x000200fe, 0x00000053, 0x00010038, 0x00050036, 0x00000012,
+    0x00000054, 0x00000000, 0x00000015, 0x00030037, 0x0000000c, 0x00000055, 0x000200f8, 0x00000056,
+    0x00050085, 0x0000000c, 0x00000057, 0x00000055, 0x0000002b, 0x0004006d, 0x0000000a, 0x00000058,
+    0x00000057, 0x00040070, 0x0000000c, 0x00000059, 0x00000058, 0x00050081, 0x0000000c, 0x0000005a,
+    0x00000059, 0x00000023, 0x00050088, 0x0000000c, 0x0000005b, 0x0000005a, 0x0000002b, 0x00050081,
+    0x0000000c, 0x0000005c, 0x00000024, 0x0000005b, 0x00050083, 0x0000000c, 0x0000005d, 0x00000024,
+    0x0000005b, 0x00050083, 0x0000000c, 0x0000005e, 0x00000026, 0x0000005b, 0x00050039, 0x0000000c,
+    0x0000005f, 0x0000004b, 0x0000005c, 0x00050039, 0x0000000c, 0x00000060, 0x00000043, 0x0000005b,
+    0x00050039, 0x0000000c, 0x00000061, 0x00000043, 0x0000005d, 0x00050039, 0x0000000c, 0x00000062,
+    0x0000004b, 0x0000005e, 0x00070050, 0x00000012, 0x00000063, 0x0000005f, 0x00000060, 0x00000061,
+    0x00000062, 0x000200fe, 0x00000063, 0x00010038, 0x00050036, 0x00000012, 0x00000064, 0x00000000,
+    0x00000016, 0x00030037, 0x0000000b, 0x00000065, 0x00030037, 0x0000000b, 0x00000066, 0x00030037,
+    0x00000012, 0x00000067, 0x000200f8, 0x00000068, 0x00050080, 0x0000000b, 0x00000069, 0x00000065,
+    0x0000001f, 0x00050080, 0x0000000b, 0x0000006a, 0x00000065, 0x00000020, 0x00050080, 0x0000000b,
+    0x0000006b, 0x00000065, 0x00000021, 0x00050050, 0x0000000f, 0x0000006c, 0x00000065, 0x00000066,
+    0x00050050, 0x0000000f, 0x0000006d, 0x00000069, 0x00000066, 0x00050050, 0x0000000f, 0x0000006e,
+    0x0000006a, 0x00000066, 0x00050050, 0x0000000f, 0x0000006f, 0x0000006b, 0x00000066, 0x00050039,
+    0x00000012, 0x00000070, 0x00000031, 0x0000006c, 0x00050039, 0x00000012, 0x00000071, 0x00000031,
+    0x0000006d, 0x00050039, 0x00000012, 0x00000072, 0x00000031, 0x0000006e, 0x00050039, 0x00000012,
+    0x00000073, 0x00000031, 0x0000006f, 0x00050051, 0x0000000c, 0x00000074, 0x00000067, 0x00000000,
+    0x00050051, 0x0000000c, 0x00000075, 0x00000067, 0x00000001, 0x00050051, 0x0000000c, 0x00000076,
+    0x00000067, 0x00000002, 0x00050051, 0x0000000c, 0x00000077, 0x00000067, 0x00000003, 0x0005008e,
+    0x00000012, 0x00000078, 0x00000070, 0x00000074, 0x0005008e, 0x00000012, 0x00000079, 0x00000071,
+    0x00000075, 0x0005008e, 0x00000012, 0x0000007a, 0x00000072, 0x00000076, 0x0005008e, 0x00000012,
+    0x0000007b, 0x00000073, 0x00000077, 0x00050081, 0x00000012, 0x0000007c, 0x00000078, 0x00000079,
+    0x00050081, 0x00000012, 0x0000007d, 0x0000007c, 0x0000007a, 0x00050081, 0x00000012, 0x0000007e,
+    0x0000007d, 0x0000007b, 0x000200fe, 0x0000007e, 0x00010038, 0x00050036, 0x00000007, 0x00000002,
+    0x00000000, 0x00000008, 0x000200f8, 0x0000007f, 0x0004003d, 0x00000011, 0x00000080, 0x00000003,
+    0x0007004f, 0x00000010, 0x00000081, 0x00000080, 0x00000080, 0x00000000, 0x00000001, 0x0004007c,
+    0x0000000f, 0x00000082, 0x00000081, 0x00050051, 0x0000000b, 0x00000083, 0x00000082, 0x00000000,
+    0x00050051, 0x0000000b, 0x00000084, 0x00000082, 0x00000001, 0x00050041, 0x0000001c, 0x00000085,
+    0x00000030, 0x0000001e, 0x0004003d, 0x0000000b, 0x00000086, 0x00000085, 0x00050041, 0x0000001c,
+    0x00000087, 0x00000030, 0x0000001f, 0x0004003d, 0x0000000b, 0x00000088, 0x00000087, 0x00050041,
+    0x0000001c, 0x00000089, 0x00000030, 0x00000020, 0x0004003d, 0x0000000b, 0x0000008a, 0x00000089,
+    0x00050041, 0x0000001c, 0x0000008b, 0x00000030, 0x00000021, 0x0004003d, 0x0000000b, 0x0000008c,
+    0x0000008b, 0x000500af, 0x00000009, 0x0000008d, 0x00000083, 0x0000008a, 0x000500af, 0x00000009,
+    0x0000008e, 0x00000084, 0x0000008c, 0x000500a6, 0x00000009, 0x0000008f, 0x0000008d, 0x0000008e,
+    0x000300f7, 0x00000090, 0x00000000, 0x000400fa, 0x0000008f, 0x00000090, 0x00000091, 0x000200f8,
+    0x00000091, 0x0004006f, 0x0000000c, 0x00000092, 0x00000086, 0x0004006f, 0x0000000c, 0x00000093,
+    0x00000088, 0x0004006f, 0x0000000c, 0x00000094, 0x0000008a, 0x0004006f, 0x0000000c, 0x00000095,
+    0x0000008c, 0x00050088, 0x0000000c, 0x00000096, 0x00000092, 0x00000094, 0x00050088, 0x0000000c,
+    0x00000097, 0x00000093, 0x00000095, 0x00050051, 0x0000000a, 0x00000098, 0x00000081, 0x00000000,
+    0x00050051, 0x0000000a, 0x00000099, 0x00000081, 0x00000001, 0x00040070, 0x0000000c, 0x0000009a,
+    0x00000098, 0x00040070, 0x0000000c, 0x0000009b, 0x00000099, 0x00050081, 0x0000000c, 0x0000009c,
+    0x0000009a, 0x00000023, 0x00050081, 0x0000000c, 0x0000009d, 0x0000009b, 0x00000023, 0x00050085,
+    0x0000000c, 0x0000009e, 0x0000009c, 0x00000096, 0x00050085, 0x0000000c, 0x0000009f, 0x0000009d,
+    0x00000097, 0x00050083, 0x0000000c, 0x000000a0, 0x0000009e, 0x00000025, 0x00050083, 0x0000000c,
+    0x000000a1, 0x0000009f, 0x00000025, 0x0006000c, 0x0000000c, 0x000000a2, 0x00000001, 0x00000008,
+    0x000000a0, 0x0006000c, 0x0000000c, 0x000000a3, 0x00000001, 0x00000008, 0x000000a1, 0x0004006e,
+    0x0000000b, 0x000000a4, 0x000000a2, 0x0004006e, 0x0000000b, 0x000000a5, 0x000000a3, 0x00050083,
+    0x0000000c, 0x000000a6, 0x000000a0, 0x000000a2, 0x00050083, 0x0000000c, 0x000000a7, 0x000000a1,
+    0x000000a3, 0x00050039, 0x00000012, 0x000000a8, 0x00000054, 0x000000a6, 0x00050039, 0x00000012,
+    0x000000a9, 0x00000054, 0x000000a7, 0x00050080, 0x0000000b, 0x000000aa, 0x000000a5, 0x0000001f,
+    0x00050080, 0x0000000b, 0x000000ab, 0x000000a5, 0x00000020, 0x00050080, 0x0000000b, 0x000000ac,
+    0x000000a5, 0x00000021, 0x00070039, 0x00000012, 0x000000ad, 0x00000064, 0x000000a4, 0x000000a5,
+    0x000000a8, 0x00070039, 0x00000012, 0x000000ae, 0x00000064, 0x000000a4, 0x000000aa, 0x000000a8,
+    0x00070039, 0x00000012, 0x000000af, 0x00000064, 0x000000a4, 0x000000ab, 0x000000a8, 0x00070039,
+    0x00000012, 0x000000b0, 0x00000064, 0x000000a4, 0x000000ac, 0x000000a8, 0x00050051, 0x0000000c,
+    0x000000b1, 0x000000a9, 0x00000000, 0x00050051, 0x0000000c, 0x000000b2, 0x000000a9, 0x00000001,
+    0x00050051, 0x0000000c, 0x000000b3, 0x000000a9, 0x00000002, 0x00050051, 0x0000000c, 0x000000b4,
+    0x000000a9, 0x00000003, 0x0005008e, 0x00000012, 0x000000b5, 0x000000ad, 0x000000b1, 0x0005008e,
+    0x00000012, 0x000000b6, 0x000000ae, 0x000000b2, 0x0005008e, 0x00000012, 0x000000b7, 0x000000af,
+    0x000000b3, 0x0005008e, 0x00000012, 0x000000b8, 0x000000b0, 0x000000b4, 0x00050081, 0x00000012,
+    0x000000b9, 0x000000b5, 0x000000b6, 0x00050081, 0x00000012, 0x000000ba, 0x000000b9, 0x000000b7,
+    0x00050081, 0x00000012, 0x000000bb, 0x000000ba, 0x000000b8, 0x0004003d, 0x00000018, 0x000000bc,
+    0x00000006, 0x00040063, 0x000000bc, 0x00000082, 0x000000bb, 0x000200f9, 0x00000090, 0x000200f8,
+    0x00000090, 0x000100fd, 0x00010038
+};
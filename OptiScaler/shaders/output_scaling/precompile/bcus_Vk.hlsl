@@ -0,0 +1,75 @@
+// Vulkan version of bcus.hlsl
+// Compile with build_precompiled_shader_vk.bat bcus
+//
+// Each invocation reads its 4x4 neighbourhood directly instead of the LDS tile of HLSL version,
+// weights use the same 16 discrete phases. Out of bounds texels are 0 like Texture2D.Load.
+
+struct Params
+{
+    int SrcWidth;
+    int SrcHeight;
+    int DstWidth;
+    int DstHeight;
+};
+
+[[vk::push_constant]] Params params;
+
+[[vk::binding(0, 0)]] Texture2D<float4> Source;
+[[vk::binding(1, 0)]] [[vk::image_format("unknown")]] RWTexture2D<float4> Dest;
+
+float4 LoadSource(int2 pos)
+{
+    int2 size = int2(params.SrcWidth, params.SrcHeight);
+    float4 texel = Source.Load(int3(clamp(pos, 0, size - 1), 0));
+    return all(pos >= 0 && pos < size) ? texel : 0.0;
+}
+
+float W1(float x, float A)
+{
+    return x * x * ((A + 2) * x - (A + 3)) + 1.0;
+}
+
+float W2(float x, float A)
+{
+    return A * (x * (x * (x - 5) + 8) - 4);
+}
+
+// Phase is snapped to one of 16 discrete offsets like GetBicubicFilterWeights
+float4 ComputeWeights(float phase)
+{
+    float d1 = ((uint) (phase * 16.0) + 0.5) / 16.0;
+    return float4(W2(1.0 + d1, -0.5), W1(d1, -0.5), W1(1.0 - d1, -0.5), W2(2.0 - d1, -0.5));
+}
+
+// Horizontal pass over 4 texels starting from pos
+float4 ConvolveRow(int2 pos, float4 weights)
+{
+    return LoadSource(pos) * weights.x + LoadSource(pos + int2(1, 0)) * weights.y +
+           LoadSource(pos + int2(2, 0)) * weights.z + LoadSource(pos + int2(3, 0)) * weights.w;
+}
+
+// 256 invocations, Shader_Vk checks maxComputeWorkGroupInvocations before creating the pipeline
+[numthreads(16, 16, 1)]
+void CSMain(uint3 DTid : SV_DispatchThreadID)
+{
+    if ((int) DTid.x >= params.DstWidth || (int) DTid.y >= params.DstHeight)
+        return;
+
+    float2 scale = float2(params.SrcWidth, params.SrcHeight) / float2(params.DstWidth, params.DstHeight);
+
+    // Top-left sample of the 4x4 kernel in source texture space
+    float2 topLeftSample = (DTid.xy + 0.5) * scale - 1.5;
+    float2 topLeft = floor(topLeftSample);
+    int2 base = int2(topLeft);
+    float2 phase = topLeftSample - topLeft;
+
+    float4 xWeights = ComputeWeights(phase.x);
+    float4 yWeights = ComputeWeights(phase.y);
+
+    // Horizontal pass per row, then vertical
+    float4 result = ConvolveRow(base, xWeights) * yWeights.x + ConvolveRow(base + int2(0, 1), xWeights) * yWeights.y +
+                    ConvolveRow(base + int2(0, 2), xWeights) * yWeights.z +
+                    ConvolveRow(base + int2(0, 3), xWeights) * yWeights.w;
+
+    Dest[DTid.xy] = result;
+}
@@ -1,5 +1,6 @@
 #include "PAG_Dx12.h"
 #include "../Config.h"
+#include <misc/VramTracker.h>
 
 inline static DXGI_FORMAT GetDepthFormat(DXGI_FORMAT InFormat)
 {
@@ -131,6 +132,7 @@ inline static bool CreateReferencedResource(ID3D12Device* InDevice, ID3D12Resour
     }
 
     (*OutResource)->SetName(InName);
+    VramTracker::Track(*OutResource, VramOwner::Shaders);
 
     return true;
 }
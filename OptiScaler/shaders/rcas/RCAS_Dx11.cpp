@@ -3,6 +3,7 @@
 #include "precompile/RCAS_Shader_Dx11.h"
 
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -68,6 +69,8 @@ bool RCAS_Dx11::CreateBufferResource(ID3D11Device* InDevice, ID3D11Resource* InR
         return false;
     }
 
+    VramTracker::Track(_buffer, VramOwner::Shaders);
+
     return true;
 }
 
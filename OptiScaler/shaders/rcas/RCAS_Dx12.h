@@ -32,19 +32,9 @@ class RCAS_Dx12
 
     std::string _name = "";
     bool _init = false;
-    int _counter = 0;
 
     ID3D12RootSignature* _rootSignature = nullptr;
     ID3D12PipelineState* _pipelineState = nullptr;
-    ID3D12DescriptorHeap* _srvHeap[4] = { nullptr, nullptr, nullptr, nullptr };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle2[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuCbvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle2[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuCbvHandle[2] { { NULL }, { NULL } };
 
     inline static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootSignature,
                                            ID3D12PipelineState** pipelineState, ID3DBlob* shaderBlob);
@@ -65,6 +55,7 @@ class RCAS_Dx12
 
     ID3D12Resource* Buffer() { return _buffer; }
     bool IsInit() const { return _init; }
+    ID3D12Device* Device() const { return _device; }
     bool CanRender() const { return _init && _buffer != nullptr; }
 
     RCAS_Dx12(std::string InName, ID3D12Device* InDevice);
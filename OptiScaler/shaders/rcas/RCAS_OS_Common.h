@@ -0,0 +1,277 @@
+#pragma once
+
+#include "RCAS_Common.h"
+
+// RCAS and bicubic output scaling in a single pass
+// Source tile is loaded once to LDS, sharpened in LDS and then resampled to the destination
+// so upscaler output doesn't need to go through the RCAS buffer first
+// Same source with precompile/RCAS_OS.hlsl, which is used when UsePrecompiledShaders is set and header exists
+static std::string rcasOsCode = R"(
+cbuffer Params : register(b0)
+{
+    float Sharpness;
+    float Contrast;
+
+    // Motion Vector Stuff
+    int DynamicSharpenEnabled;
+    int DisplaySizeMV;
+    int Debug;
+
+    float MotionSharpness;
+    float MotionTextureScale;
+    float MvScaleX;
+    float MvScaleY;
+    float Threshold;
+    float ScaleLimit;
+
+    // Output Scaling
+    int Upsample;
+    int SrcWidth;
+    int SrcHeight;
+    int DstWidth;
+    int DstHeight;
+};
+
+Texture2D<float3> Source : register(t0);
+Texture2D<float2> Motion : register(t1);
+RWTexture2D<float3> Dest : register(u0);
+
+#define TILE_DIM 8
+#define GROUP_COUNT (TILE_DIM * TILE_DIM)
+
+// Output scaling ratio is limited to 0.5 - 3.0, a 8x8 destination tile
+// reads at most (TILE_DIM - 1) * 3 + 5 source texels for 4x4 bicubic kernel
+#define SHARP_DIM 28
+#define SOURCE_DIM (SHARP_DIM + 2)
+
+// De-interleaved to avoid LDS bank conflicts
+groupshared float g_R[SOURCE_DIM * SOURCE_DIM];
+groupshared float g_G[SOURCE_DIM * SOURCE_DIM];
+groupshared float g_B[SOURCE_DIM * SOURCE_DIM];
+
+groupshared float g_SharpR[SHARP_DIM * SHARP_DIM];
+groupshared float g_SharpG[SHARP_DIM * SHARP_DIM];
+groupshared float g_SharpB[SHARP_DIM * SHARP_DIM];
+
+float3 LoadSource(uint x, uint y)
+{
+    uint idx = x + y * SOURCE_DIM;
+    return float3(g_R[idx], g_G[idx], g_B[idx]);
+}
+
+float3 LoadSharp(uint x, uint y)
+{
+    uint idx = x + y * SHARP_DIM;
+    return float3(g_SharpR[idx], g_SharpG[idx], g_SharpB[idx]);
+}
+
+bool InSource(int2 pos, int2 maxPos)
+{
+    return all(pos >= 0) && all(pos <= maxPos);
+}
+
+float Luminance(float3 color)
+{
+    return dot(color, float3(0.2126, 0.7152, 0.0722));
+}
+
+float W1(float x, float A)
+{
+    return x * x * ((A + 2) * x - (A + 3)) + 1.0;
+}
+
+float W2(float x, float A)
+{
+    return A * (x * (x * (x - 5) + 8) - 4);
+}
+
+float4 ComputeWeights(float d1, float A)
+{
+    return float4(W2(1.0 + d1, A), W1(d1, A), W1(1.0 - d1, A), W2(2.0 - d1, A));
+}
+
+float GetSharpness(int2 pos)
+{
+    float setSharpness = Sharpness;
+
+    if (DynamicSharpenEnabled > 0)
+    {
+        float2 mv;
+        float motion;
+        float add = 0.0f;
+
+        if (DisplaySizeMV > 0)
+            mv = Motion.Load(int3(pos, 0)).rg;
+        else
+            mv = Motion.Load(int3(pos.x * MotionTextureScale, pos.y * MotionTextureScale, 0)).rg;
+
+        motion = max(abs(mv.r * MvScaleX), abs(mv.g * MvScaleY));
+
+        if (motion > Threshold)
+            add = (motion / (ScaleLimit - Threshold)) * MotionSharpness;
+
+        if ((add > MotionSharpness && MotionSharpness > 0.0f) || (add < MotionSharpness && MotionSharpness < 0.0f))
+            add = MotionSharpness;
+
+        setSharpness = clamp(setSharpness + add, 0.0f, 1.3f);
+    }
+
+    return setSharpness;
+}
+
+float3 Rcas(uint2 idx, int2 pos)
+{
+    float setSharpness = GetSharpness(pos);
+    float3 e = LoadSource(idx.x, idx.y);
+
+    // skip sharpening if set value == 0
+    if (setSharpness == 0.0f)
+    {
+        if (Debug > 0 && DynamicSharpenEnabled > 0 && Sharpness > 0)
+            e.g *= 1 + (12.0f * Sharpness);
+
+        return e;
+    }
+
+    float3 b = LoadSource(idx.x, idx.y - 1);
+    float3 d = LoadSource(idx.x - 1, idx.y);
+    float3 f = LoadSource(idx.x + 1, idx.y);
+    float3 h = LoadSource(idx.x, idx.y + 1);
+
+    // Min and max of ring.
+    float3 minRGB = min(min(b, d), min(f, h));
+    float3 maxRGB = max(max(b, d), max(f, h));
+
+    // Immediate constants for peak range.
+    float2 peakC = float2(1.0, -4.0);
+
+    // Standard RCAS limiters
+    float3 hitMin = minRGB * rcp(4.0 * maxRGB);
+    float3 hitMax = (peakC.xxx - maxRGB) * rcp(4.0 * minRGB + peakC.yyy);
+    float3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-0.1875, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0)) * setSharpness;
+
+    // Apply contrast adaptation only if Contrast > 0
+    if (Contrast >= -10.0)
+    {
+        float3 amp = saturate(min(minRGB, 2.0 - maxRGB) / max(maxRGB, 1e-5));
+        amp = rsqrt(amp);
+
+        float peak = -3.0 * Contrast + 8.0;
+        float contrastFactor = 1.0 / max(amp.g * peak, 1.0);
+
+        lobe *= lerp(1.0, contrastFactor, Contrast);
+    }
+
+    // Resolve with medium precision rcp
+    float rcpL = rcp(4.0 * lobe + 1.0);
+    float3 output = ((b + d + f + h) * lobe + e) * rcpL;
+
+    if (Debug > 0 && DynamicSharpenEnabled > 0)
+    {
+        if (Sharpness < setSharpness)
+            output.r *= 1 + (12.0f * (setSharpness - Sharpness));
+        else
+            output.g *= 1 + (12.0f * (Sharpness - setSharpness));
+    }
+
+    return output;
+}
+
+[numthreads(TILE_DIM, TILE_DIM, 1)]
+void CSMain(uint3 DTid : SV_DispatchThreadID, uint3 Gid : SV_GroupID, uint GI : SV_GroupIndex)
+{
+    const float2 scale = float2(SrcWidth, SrcHeight) / float2(DstWidth, DstHeight);
+    const int2 maxPos = int2(SrcWidth - 1, SrcHeight - 1);
+
+    // Top-left texel of the sharpened area this tile needs
+    const int2 upperLeft = floor((Gid.xy * TILE_DIM + 0.5) * scale - 1.5);
+    const int2 lowerRight = floor((Gid.xy * TILE_DIM + TILE_DIM - 0.5) * scale - 1.5) + 3;
+    const uint2 sharpSpace = min(uint2(lowerRight - upperLeft + 1), SHARP_DIM);
+    const uint2 sourceSpace = sharpSpace + 2;
+
+    // Load source tile with 1 texel border for RCAS
+    // Texels outside of source are 0 like the out of bounds loads of separate RCAS & OS passes
+    for (uint i = GI; i < sourceSpace.x * sourceSpace.y; i += GROUP_COUNT)
+    {
+        uint2 st = uint2(i % sourceSpace.x, i / sourceSpace.x);
+        int2 pos = upperLeft - 1 + int2(st);
+        float3 color = InSource(pos, maxPos) ? Source.Load(int3(pos, 0)) : 0.0;
+
+        uint idx = st.x + st.y * SOURCE_DIM;
+        g_R[idx] = color.r;
+        g_G[idx] = color.g;
+        g_B[idx] = color.b;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    // Sharpen the inner area
+    for (uint j = GI; j < sharpSpace.x * sharpSpace.y; j += GROUP_COUNT)
+    {
+        uint2 st = uint2(j % sharpSpace.x, j / sharpSpace.x);
+        int2 pos = upperLeft + int2(st);
+
+        // OS pass reads outside of RCAS output as 0 too
+        float3 color = InSource(pos, maxPos) ? Rcas(st + 1, pos) : 0.0;
+
+        uint idx = st.x + st.y * SHARP_DIM;
+        g_SharpR[idx] = color.r;
+        g_SharpG[idx] = color.g;
+        g_SharpB[idx] = color.b;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (DTid.x >= DstWidth || DTid.y >= DstHeight)
+        return;
+
+    // The coordinate of the top-left sample from the 4x4 kernel in source texture space
+    float2 topLeftSample = (DTid.xy + 0.5) * scale - 1.5;
+    float2 phase = frac(topLeftSample);
+    uint2 tileST = min(uint2(int2(floor(topLeftSample)) - upperLeft), SHARP_DIM - 4);
+
+    float4 xWeights = ComputeWeights(phase.x, Upsample > 0 ? -0.5 : -0.75);
+    float4 yWeights = ComputeWeights(phase.y, Upsample > 0 ? -0.5 : -0.75);
+
+    // Same luminance correction with bicubic downscaler
+    float avgLuminance = 0.0;
+
+    if (Upsample == 0)
+    {
+        [unroll]
+        for (int y = 0; y < 4; y++)
+        {
+            [unroll]
+            for (int x = 0; x < 4; x++)
+                avgLuminance += Luminance(LoadSharp(tileST.x + x, tileST.y + y));
+        }
+
+        avgLuminance /= 16.0;
+    }
+
+    float3 result = 0.0;
+
+    [unroll]
+    for (int y = 0; y < 4; y++)
+    {
+        [unroll]
+        for (int x = 0; x < 4; x++)
+        {
+            float3 color = LoadSharp(tileST.x + x, tileST.y + y);
+
+            if (Upsample == 0)
+            {
+                float currentLuminance = Luminance(color);
+
+                if (abs(currentLuminance - avgLuminance) > 0.5)
+                    color *= avgLuminance / max(currentLuminance, 1e-5);
+            }
+
+            result += color * xWeights[x] * yWeights[y];
+        }
+    }
+
+    Dest[DTid.xy] = result;
+}
+)";
@@ -0,0 +1,353 @@
+#include "RCAS_OS_Dx12.h"
+
+#include <Config.h>
+#include <shaders/DescriptorHeap_Dx12.h>
+
+// Header is created with "build_precompiled_shader.bat RCAS_OS" in precompile folder
+#if __has_include("precompile/RCAS_OS_Shader.h")
+#include "precompile/RCAS_OS_Shader.h"
+#define RCAS_OS_PRECOMPILED
+#endif
+
+inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32A32_FLOAT;
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32_FLOAT;
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+        return DXGI_FORMAT_R16G16B16A16_FLOAT;
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+        return DXGI_FORMAT_R10G10B10A2_UINT;
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+        return DXGI_FORMAT_B8G8R8A8_UNORM;
+    case DXGI_FORMAT_R16G16_TYPELESS:
+        return DXGI_FORMAT_R16G16_FLOAT;
+    case DXGI_FORMAT_R32G32_TYPELESS:
+        return DXGI_FORMAT_R32G32_FLOAT;
+    default:
+        return format;
+    }
+}
+
+bool RCAS_OS_Dx12::IsSupported(bool InUpsample)
+{
+    if (!Config::Instance()->OutputScalingFuseRcas.value_or_default() ||
+        Config::Instance()->OutputScalingUseFsr.value_or_default())
+    {
+        return false;
+    }
+
+    return InUpsample || Config::Instance()->OutputScalingDownscaler.value_or_default() == 0;
+}
+
+bool RCAS_OS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList,
+                            ID3D12Resource* InResource, ID3D12Resource* InMotionVectors, RcasConstants InConstants,
+                            ID3D12Resource* OutResource)
+{
+    if (!_init || InDevice == nullptr || InCmdList == nullptr || InResource == nullptr || OutResource == nullptr ||
+        InMotionVectors == nullptr || State::Instance().currentFeature == nullptr)
+        return false;
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    DescriptorRange descriptors {};
+
+    if (!DescriptorHeap_Dx12::Allocate(InDevice, 4, &descriptors))
+        return false;
+
+    auto inDesc = InResource->GetDesc();
+    auto mvDesc = InMotionVectors->GetDesc();
+    auto outDesc = OutResource->GetDesc();
+
+    // Create SRV for Input Texture
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Format = TranslateTypelessFormats(inDesc.Format);
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, descriptors.Cpu(0));
+
+    // Create SRV for Motion Texture
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc2 = {};
+    srvDesc2.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc2.Format = TranslateTypelessFormats(mvDesc.Format);
+    srvDesc2.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc2.Texture2D.MipLevels = 1;
+
+    InDevice->CreateShaderResourceView(InMotionVectors, &srvDesc2, descriptors.Cpu(1));
+
+    // Create UAV for Output Texture
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = TranslateTypelessFormats(outDesc.Format);
+    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+    uavDesc.Texture2D.MipSlice = 0;
+
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, descriptors.Cpu(2));
+
+    InternalConstants constants {};
+
+    if (Config::Instance()->ContrastEnabled.value_or_default())
+        constants.Contrast = Config::Instance()->Contrast.value_or_default() * -1.0f;
+    else
+        constants.Contrast = -100.0f;
+
+    constants.DynamicSharpenEnabled = Config::Instance()->MotionSharpnessEnabled.value_or_default() ? 1 : 0;
+    constants.MotionSharpness = Config::Instance()->MotionSharpness.value_or_default();
+    constants.MvScaleX = InConstants.MvScaleX;
+    constants.MvScaleY = InConstants.MvScaleY;
+    constants.Sharpness = InConstants.Sharpness;
+    constants.Debug = Config::Instance()->MotionSharpnessDebug.value_or_default() ? 1 : 0;
+    constants.Threshold = Config::Instance()->MotionThreshold.value_or_default();
+    constants.ScaleLimit = Config::Instance()->MotionScaleLimit.value_or_default();
+    constants.DisplaySizeMV = InConstants.DisplaySizeMV ? 1 : 0;
+
+    if (InConstants.RenderWidth == 0 || InConstants.DisplayWidth == 0)
+        constants.MotionTextureScale = 1.0f;
+    else
+        constants.MotionTextureScale = (float) InConstants.RenderWidth / (float) InConstants.DisplayWidth;
+
+    constants.Upsample = _upsample ? 1 : 0;
+    constants.SrcWidth = State::Instance().currentFeature->TargetWidth();
+    constants.SrcHeight = State::Instance().currentFeature->TargetHeight();
+    constants.DstWidth = State::Instance().currentFeature->DisplayWidth();
+    constants.DstHeight = State::Instance().currentFeature->DisplayHeight();
+
+    // Copy the updated constant buffer data to the constant buffer resource
+    BYTE* pCBDataBegin;
+    CD3DX12_RANGE readRange(0, 0); // We do not intend to read from this resource on the CPU
+    auto result = _constantBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pCBDataBegin));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] _constantBuffer->Map error {1:x}", _name, (unsigned int) result);
+        return false;
+    }
+
+    if (pCBDataBegin == nullptr)
+    {
+        _constantBuffer->Unmap(0, nullptr);
+        LOG_ERROR("[{0}] pCBDataBegin is null!", _name);
+        return false;
+    }
+
+    memcpy(pCBDataBegin, &constants, sizeof(constants));
+    _constantBuffer->Unmap(0, nullptr);
+
+    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+    cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
+    cbvDesc.SizeInBytes = sizeof(constants);
+    InDevice->CreateConstantBufferView(&cbvDesc, descriptors.Cpu(3));
+
+    DescriptorHeap_Dx12::Bind(InCmdList, descriptors);
+
+    InCmdList->SetComputeRootSignature(_rootSignature);
+    InCmdList->SetPipelineState(_pipelineState);
+
+    InCmdList->SetComputeRootDescriptorTable(0, descriptors.Gpu(0));
+    InCmdList->SetComputeRootDescriptorTable(1, descriptors.Gpu(1));
+    InCmdList->SetComputeRootDescriptorTable(2, descriptors.Gpu(2));
+    InCmdList->SetComputeRootDescriptorTable(3, descriptors.Gpu(3));
+
+    UINT dispatchWidth = (constants.DstWidth + InNumThreadsX - 1) / InNumThreadsX;
+    UINT dispatchHeight = (constants.DstHeight + InNumThreadsY - 1) / InNumThreadsY;
+
+    InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+    DescriptorHeap_Dx12::Restore(InCmdList);
+
+    return true;
+}
+
+RCAS_OS_Dx12::RCAS_OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample)
+    : _name(InName), _device(InDevice), _upsample(InUpsample)
+{
+    if (InDevice == nullptr)
+    {
+        LOG_ERROR("InDevice is nullptr!");
+        return;
+    }
+
+    // No need to compile the shader when it won't be used
+    if (!IsSupported(InUpsample))
+    {
+        LOG_DEBUG("[{0}] Not supported with current output scaling settings", _name);
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    // Describe and create the root signature
+    // ---------------------------------------------------
+    D3D12_DESCRIPTOR_RANGE descriptorRange[4];
+
+    // SRV Range (Input Texture)
+    descriptorRange[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    descriptorRange[0].NumDescriptors = 1;
+    descriptorRange[0].BaseShaderRegister = 0; // Assuming t0 register in HLSL for SRV
+    descriptorRange[0].RegisterSpace = 0;
+    descriptorRange[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // SRV Range (Motion Texture)
+    descriptorRange[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    descriptorRange[1].NumDescriptors = 1;
+    descriptorRange[1].BaseShaderRegister = 1; // Assuming t1 register in HLSL for SRV
+    descriptorRange[1].RegisterSpace = 0;
+    descriptorRange[1].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // UAV Range (Output Texture)
+    descriptorRange[2].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+    descriptorRange[2].NumDescriptors = 1;
+    descriptorRange[2].BaseShaderRegister = 0; // Assuming u0 register in HLSL for UAV
+    descriptorRange[2].RegisterSpace = 0;
+    descriptorRange[2].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // CBV Range (Params)
+    descriptorRange[3].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
+    descriptorRange[3].NumDescriptors = 1;
+    descriptorRange[3].BaseShaderRegister = 0; // Assuming b0 register in HLSL for CBV
+    descriptorRange[3].RegisterSpace = 0;
+    descriptorRange[3].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // Define the root parameter (descriptor table)
+    // ---------------------------------------------------
+    D3D12_ROOT_PARAMETER rootParameters[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        rootParameters[i].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        rootParameters[i].DescriptorTable.NumDescriptorRanges = 1;
+        rootParameters[i].DescriptorTable.pDescriptorRanges = &descriptorRange[i];
+        rootParameters[i].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+    }
+
+    // A root signature is an array of root parameters
+    // ---------------------------------------------------
+    D3D12_ROOT_SIGNATURE_DESC rootSigDesc;
+    rootSigDesc.NumParameters = 4;
+    rootSigDesc.pParameters = rootParameters;
+    rootSigDesc.NumStaticSamplers = 0;
+    rootSigDesc.pStaticSamplers = nullptr;
+    rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    ID3DBlob* errorBlob = nullptr;
+    ID3DBlob* signatureBlob = nullptr;
+
+    do
+    {
+        auto hr = D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] D3D12SerializeRootSignature error {1:x}", _name, (unsigned int) hr);
+            break;
+        }
+
+        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
+                                           IID_PPV_ARGS(&_rootSignature));
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] CreateRootSignature error {1:x}", _name, (unsigned int) hr);
+            break;
+        }
+
+    } while (false);
+
+    if (errorBlob != nullptr)
+    {
+        errorBlob->Release();
+        errorBlob = nullptr;
+    }
+
+    if (signatureBlob != nullptr)
+    {
+        signatureBlob->Release();
+        signatureBlob = nullptr;
+    }
+
+    if (_rootSignature == nullptr)
+    {
+        LOG_ERROR("[{0}] _rootSignature is null!", _name);
+        return;
+    }
+
+    // If shader can't be created features use RCAS + OS passes
+    D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {};
+    computePsoDesc.pRootSignature = _rootSignature;
+    computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+    ID3DBlob* shaderBlob = nullptr;
+
+#ifdef RCAS_OS_PRECOMPILED
+    if (Config::Instance()->UsePrecompiledShaders.value_or_default())
+        computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(RCAS_OS_cso), sizeof(RCAS_OS_cso));
+#endif
+
+    if (computePsoDesc.CS.pShaderBytecode == nullptr)
+    {
+        shaderBlob = RCAS_CompileShader(rcasOsCode.c_str(), "CSMain", "cs_5_0");
+
+        if (shaderBlob == nullptr)
+        {
+            LOG_ERROR("[{0}] RCAS_CompileShader error!", _name);
+            return;
+        }
+
+        computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+    }
+
+    auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
+                                                   (void**) &_pipelineState);
+
+    if (shaderBlob != nullptr)
+        shaderBlob->Release();
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateComputePipelineState error: {1:X}", _name, hr);
+        return;
+    }
+
+    D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(InternalConstants));
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+
+    hr = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ,
+                                           nullptr, IID_PPV_ARGS(&_constantBuffer));
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, (unsigned int) hr);
+        return;
+    }
+
+    _init = true;
+}
+
+RCAS_OS_Dx12::~RCAS_OS_Dx12()
+{
+    if (!_init || State::Instance().isShuttingDown)
+        return;
+
+    if (_rootSignature != nullptr)
+    {
+        _rootSignature->Release();
+        _rootSignature = nullptr;
+    }
+
+    if (_pipelineState != nullptr)
+    {
+        _pipelineState->Release();
+        _pipelineState = nullptr;
+    }
+
+    if (_constantBuffer != nullptr)
+    {
+        _constantBuffer->Release();
+        _constantBuffer = nullptr;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <pch.h>
+
+#include "RCAS_OS_Common.h"
+
+#include <d3d12.h>
+#include <d3dx/d3dx12.h>
+
+class RCAS_OS_Dx12
+{
+  private:
+    struct alignas(256) InternalConstants
+    {
+        float Sharpness;
+        float Contrast;
+
+        // Motion Vector Stuff
+        int DynamicSharpenEnabled;
+        int DisplaySizeMV;
+        int Debug;
+
+        float MotionSharpness;
+        float MotionTextureScale;
+        float MvScaleX;
+        float MvScaleY;
+        float Threshold;
+        float ScaleLimit;
+
+        // Output Scaling
+        int Upsample;
+        int SrcWidth;
+        int SrcHeight;
+        int DstWidth;
+        int DstHeight;
+    };
+
+    std::string _name = "";
+    bool _init = false;
+    bool _upsample = false;
+
+    ID3D12RootSignature* _rootSignature = nullptr;
+    ID3D12PipelineState* _pipelineState = nullptr;
+
+    ID3D12Device* _device = nullptr;
+    ID3D12Resource* _constantBuffer = nullptr;
+
+    UINT InNumThreadsX = 8;
+    UINT InNumThreadsY = 8;
+
+  public:
+    // Only bicubic scaling is fused, FSR1 and other downscalers still use RCAS + OS passes
+    static bool IsSupported(bool InUpsample);
+
+    bool Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource,
+                  ID3D12Resource* InMotionVectors, RcasConstants InConstants, ID3D12Resource* OutResource);
+
+    bool IsInit() const { return _init; }
+    bool IsUpsampling() const { return _upsample; }
+    ID3D12Device* Device() const { return _device; }
+
+    RCAS_OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample);
+
+    ~RCAS_OS_Dx12();
+};
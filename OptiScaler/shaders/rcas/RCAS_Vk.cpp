@@ -0,0 +1,67 @@
+#include "RCAS_Vk.h"
+
+#include "precompile/rcas_Shader_Vk.h"
+
+#include <Config.h>
+
+bool RCAS_Vk::CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource)
+{
+    if (!_init || InCmdBuffer == VK_NULL_HANDLE || InSource == nullptr)
+        return false;
+
+    auto& info = InSource->Resource.ImageViewInfo;
+    return CreateBuffer(InCmdBuffer, info.Format, info.Width, info.Height);
+}
+
+bool RCAS_Vk::Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource,
+                       NVSDK_NGX_Resource_VK* InMotionVectors, RcasConstants InConstants,
+                       NVSDK_NGX_Resource_VK* OutResource)
+{
+    if (!_init || InResource == nullptr || InMotionVectors == nullptr || OutResource == nullptr)
+        return false;
+
+    InternalConstants constants {};
+
+    if (Config::Instance()->ContrastEnabled.value_or_default())
+        constants.Contrast = Config::Instance()->Contrast.value_or_default() * -1.0f;
+    else
+        constants.Contrast = -100.0f;
+
+    constants.DisplayHeight = InConstants.DisplayHeight;
+    constants.DisplayWidth = InConstants.DisplayWidth;
+    constants.DynamicSharpenEnabled = Config::Instance()->MotionSharpnessEnabled.value_or_default() ? 1 : 0;
+    constants.MotionSharpness = Config::Instance()->MotionSharpness.value_or_default();
+    constants.MvScaleX = InConstants.MvScaleX;
+    constants.MvScaleY = InConstants.MvScaleY;
+    constants.Sharpness = InConstants.Sharpness;
+    constants.Debug = Config::Instance()->MotionSharpnessDebug.value_or_default() ? 1 : 0;
+    constants.Threshold = Config::Instance()->MotionThreshold.value_or_default();
+    constants.ScaleLimit = Config::Instance()->MotionScaleLimit.value_or_default();
+    constants.DisplaySizeMV = InConstants.DisplaySizeMV ? 1 : 0;
+    constants.MotionWidth = InMotionVectors->Resource.ImageViewInfo.Width;
+    constants.MotionHeight = InMotionVectors->Resource.ImageViewInfo.Height;
+
+    if (InConstants.RenderWidth == 0 || InConstants.DisplayWidth == 0)
+        constants.MotionTextureScale = 1.0f;
+    else
+        constants.MotionTextureScale = (float) InConstants.RenderWidth / (float) InConstants.DisplayWidth;
+
+    const NVSDK_NGX_Resource_VK* inputs[] = { InResource, InMotionVectors };
+
+    return Shader_Vk::Dispatch(InCmdBuffer, inputs, OutResource, &constants, InConstants.DisplayWidth,
+                               InConstants.DisplayHeight);
+}
+
+RCAS_Vk::RCAS_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice)
+    : Shader_Vk(InName, InPD, InDevice)
+{
+    if (InPD == VK_NULL_HANDLE || InDevice == VK_NULL_HANDLE)
+    {
+        LOG_ERROR("InPD or InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    _init = CreatePipeline(rcas_spv, sizeof(rcas_spv), 2, sizeof(InternalConstants));
+}
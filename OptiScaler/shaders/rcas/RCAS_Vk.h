@@ -0,0 +1,42 @@
+#pragma once
+
+#include <pch.h>
+
+#include "RCAS_Common.h"
+
+#include <shaders/Shader_Vk.h>
+
+class RCAS_Vk : public Shader_Vk
+{
+  private:
+    // Push constant layout of rcas.spvasm and rcas_Vk.hlsl
+    struct InternalConstants
+    {
+        float Sharpness;
+        float Contrast;
+
+        // Motion Vector Stuff
+        int DynamicSharpenEnabled;
+        int DisplaySizeMV;
+        int Debug;
+
+        float MotionSharpness;
+        float MotionTextureScale;
+        float MvScaleX;
+        float MvScaleY;
+        float Threshold;
+        float ScaleLimit;
+        int DisplayWidth;
+        int DisplayHeight;
+        int MotionWidth;
+        int MotionHeight;
+    };
+
+  public:
+    bool CreateBufferResource(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InSource);
+    bool Dispatch(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* InResource,
+                  NVSDK_NGX_Resource_VK* InMotionVectors, RcasConstants InConstants,
+                  NVSDK_NGX_Resource_VK* OutResource);
+
+    RCAS_Vk(std::string InName, VkPhysicalDevice InPD, VkDevice InDevice);
+};
@@ -0,0 +1,157 @@
+// Vulkan version of rcas.hlsl
+// Compile with build_precompiled_shader_vk.bat rcas
+//
+// Out of bounds loads of Texture2D.Load return 0, image fetch doesn't do it on Vulkan so
+// LoadSource and LoadMotion clamp the coordinate and select 0 for texels outside of the image.
+// NMin/NMax keep min/max behaviour of HLSL (NaN operand is ignored) for 0/0 of black pixels,
+// GLSL FMin/FMax result is undefined for NaN.
+
+struct Params
+{
+    float Sharpness;
+    float Contrast;
+
+    // Motion Vector Stuff
+    int DynamicSharpenEnabled;
+    int DisplaySizeMV;
+    int Debug;
+
+    float MotionSharpness;
+    float MotionTextureScale;
+    float MvScaleX;
+    float MvScaleY;
+    float Threshold;
+    float ScaleLimit;
+    int DisplayWidth;
+    int DisplayHeight;
+    int MotionWidth;
+    int MotionHeight;
+};
+
+[[vk::push_constant]] Params params;
+
+[[vk::binding(0, 0)]] Texture2D<float4> Source;
+[[vk::binding(1, 0)]] [[vk::image_format("unknown")]] RWTexture2D<float4> Dest;
+[[vk::binding(2, 0)]] Texture2D<float4> Motion;
+
+float4 LoadSource(int2 pos)
+{
+    int2 size = int2(params.DisplayWidth, params.DisplayHeight);
+    float4 texel = Source.Load(int3(clamp(pos, 0, size - 1), 0));
+    return all(pos >= 0 && pos < size) ? texel : 0.0;
+}
+
+float4 LoadMotion(int2 pos)
+{
+    int2 size = int2(params.MotionWidth, params.MotionHeight);
+    float4 texel = Motion.Load(int3(clamp(pos, 0, size - 1), 0));
+    return all(pos >= 0 && pos < size) ? texel : 0.0;
+}
+
+float NMin(float a, float b)
+{
+    return isnan(a) ? b : (isnan(b) ? a : min(a, b));
+}
+
+float NMax(float a, float b)
+{
+    return isnan(a) ? b : (isnan(b) ? a : max(a, b));
+}
+
+float3 NMin(float3 a, float3 b)
+{
+    return float3(NMin(a.x, b.x), NMin(a.y, b.y), NMin(a.z, b.z));
+}
+
+float3 NMax(float3 a, float3 b)
+{
+    return float3(NMax(a.x, b.x), NMax(a.y, b.y), NMax(a.z, b.z));
+}
+
+// 256 invocations instead of 1024 of rcas.hlsl, Shader_Vk checks maxComputeWorkGroupInvocations
+// before creating the pipeline
+[numthreads(16, 16, 1)]
+void CSMain(uint3 DTid : SV_DispatchThreadID)
+{
+    int2 pos = int2(DTid.xy);
+
+    if (pos.x >= params.DisplayWidth || pos.y >= params.DisplayHeight)
+        return;
+
+    bool debugDynamic = params.Debug > 0 && params.DynamicSharpenEnabled > 0;
+    float setSharpness = params.Sharpness;
+
+    // Dynamic sharpness from motion vectors
+    if (params.DynamicSharpenEnabled > 0)
+    {
+        int2 mvPos = params.DisplaySizeMV > 0 ? pos : int2(DTid.xy * params.MotionTextureScale);
+        float2 mv = LoadMotion(mvPos).rg;
+        float motion = max(abs(mv.r * params.MvScaleX), abs(mv.g * params.MvScaleY));
+        float add = 0.0f;
+
+        if (motion > params.Threshold)
+            add = (motion / (params.ScaleLimit - params.Threshold)) * params.MotionSharpness;
+
+        if ((add > params.MotionSharpness && params.MotionSharpness > 0.0f) ||
+            (add < params.MotionSharpness && params.MotionSharpness < 0.0f))
+        {
+            add = params.MotionSharpness;
+        }
+
+        setSharpness = clamp(setSharpness + add, 0.0f, 1.3f);
+    }
+
+    float4 e = LoadSource(pos);
+
+    // Sharpening is skipped, only debug tint is applied
+    if (setSharpness == 0.0f)
+    {
+        if (debugDynamic && params.Sharpness > 0)
+            e.g *= 1 + (12.0f * params.Sharpness);
+
+        Dest[pos] = e;
+        return;
+    }
+
+    float3 b = LoadSource(pos + int2(0, -1)).rgb;
+    float3 d = LoadSource(pos + int2(-1, 0)).rgb;
+    float3 f = LoadSource(pos + int2(1, 0)).rgb;
+    float3 h = LoadSource(pos + int2(0, 1)).rgb;
+
+    // Min and max of ring
+    float3 minRGB = min(min(b, d), min(f, h));
+    float3 maxRGB = max(max(b, d), max(f, h));
+
+    // Standard RCAS limiters, peak range is (1.0, -4.0)
+    float3 hitMin = minRGB / (4.0 * maxRGB);
+    float3 hitMax = (1.0 - maxRGB) / (4.0 * minRGB - 4.0);
+    float3 lobeRGB = NMax(-hitMin, hitMax);
+    float lobe = NMax(-0.1875, NMin(NMax(lobeRGB.r, NMax(lobeRGB.g, lobeRGB.b)), 0.0)) * setSharpness;
+
+    // Contrast adaptation, only green is used as representative
+    if (params.Contrast >= -10.0)
+    {
+        float3 amp = NMin(minRGB, 2.0 - maxRGB) / NMax(maxRGB, 1e-5);
+        float ampG = rsqrt(NMin(NMax(amp.g, 0.0), 1.0));
+
+        float peak = -3.0 * params.Contrast + 8.0;
+        float contrastFactor = 1.0 / NMax(ampG * peak, 1.0);
+
+        lobe *= 1.0 + (contrastFactor - 1.0) * params.Contrast;
+    }
+
+    // Resolve
+    float rcpL = 1.0 / (4.0 * lobe + 1.0);
+    float3 output = ((b + d + f + h) * lobe + e.rgb) * rcpL;
+
+    // Debug tint, red when motion increased sharpness, green otherwise
+    if (debugDynamic)
+    {
+        if (params.Sharpness < setSharpness)
+            output.r *= 1 + (12.0f * (setSharpness - params.Sharpness));
+        else
+            output.g *= 1 + (12.0f * (params.Sharpness - setSharpness));
+    }
+
+    Dest[pos] = float4(output, e.a);
+}
@@ -0,0 +1,23 @@
+@echo off
+
+if "%~2"=="" (
+    echo Usage: %~nx0 ShaderName PermutationIndex [dxc arguments]
+    exit /b 1
+)
+
+set ShaderName=%1
+set Index=%2
+set Defines=
+
+:collect
+if "%~3"=="" goto build
+set Defines=%Defines% %3
+shift /3
+goto collect
+
+:build
+echo Creating Dx12 CSO for %ShaderName% permutation %Index%
+"%~dp0dxc.exe" -T cs_6_0 -E CSMain -Cc -Vi %Defines% "%ShaderName%.hlsl" -Fo "%ShaderName%_%Index%_Shader.cso"
+
+echo Creating Dx12 Header
+python "%~dp0create_header.py" "%ShaderName%_%Index%_Shader.cso" "%ShaderName%_%Index%_Shader.h" %ShaderName%_%Index%_cso
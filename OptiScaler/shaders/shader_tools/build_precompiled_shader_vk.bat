@@ -0,0 +1,21 @@
+@echo off
+
+if "%~1"=="" (
+    echo Usage: %~nx0 ShaderName
+    exit /b 1
+)
+
+set ShaderName=%1
+
+rem Shipped headers are still assembled from .spvasm, HLSL sources replace them once built with dxc
+if not exist "%~dp0dxc.exe" (
+    echo dxc.exe not found, assembling %ShaderName%.spvasm
+    python "%~dp0spirv_as.py" "%ShaderName%.spvasm" "%ShaderName%_Shader_Vk.h" %ShaderName%_spv
+    exit /b %errorlevel%
+)
+
+echo Creating Vulkan SPIR-V
+"%~dp0dxc.exe" -spirv -fspv-target-env=vulkan1.1 -fspv-entrypoint-name=main -T cs_6_0 -E CSMain -Vi "%ShaderName%_Vk.hlsl" -Fo "%ShaderName%_Shader_Vk.spv"
+
+echo Creating Vulkan Header
+python "%~dp0create_header_vk.py" "%ShaderName%_Shader_Vk.spv" "%ShaderName%_Shader_Vk.h" %ShaderName%_spv
@@ -0,0 +1,47 @@
+import sys
+import os
+
+def convert_spirv_to_header(input_file_path, output_file_path, array_name):
+    # Read the SPIR-V binary, it is a stream of 32 bit little endian words
+    try:
+        with open(input_file_path, 'rb') as input_file:
+            byte_array = input_file.read()
+    except IOError as e:
+        print(f"Failed to open the input file: {input_file_path}")
+        print(e)
+        return
+
+    if len(byte_array) % 4 != 0:
+        print(f"Input file is not SPIR-V: {input_file_path}")
+        return
+
+    words = [int.from_bytes(byte_array[i:i + 4], "little") for i in range(0, len(byte_array), 4)]
+
+    # Open the output file
+    try:
+        with open(output_file_path, 'w') as output_file:
+            output_file.write("#pragma once\n\n")
+            output_file.write(f"inline static const uint32_t {array_name}[] = {{\n    ")
+
+            for i, word in enumerate(words):
+                output_file.write(f"0x{word:08x}")
+                if i < len(words) - 1:
+                    output_file.write(",\n    " if (i + 1) % 8 == 0 else ", ")
+
+            output_file.write("\n};\n")
+
+        print(f"Shader converted to header file successfully: {output_file_path}")
+    except IOError as e:
+        print(f"Failed to open the output file: {output_file_path}")
+        print(e)
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4:
+        print(f"Usage: {os.path.basename(__file__)} <input_spirv_file> <output_header_file> <array_name>")
+        sys.exit(1)
+
+    input_spirv_file = sys.argv[1]
+    output_header_file = sys.argv[2]
+    array_name = sys.argv[3]
+
+    convert_spirv_to_header(input_spirv_file, output_header_file, array_name)
@@ -0,0 +1,230 @@
+import sys
+import os
+import re
+import struct
+
+# Minimal SPIR-V assembler for the Vulkan compute shaders in shaders folder
+# Accepts the spirv-as text format for the subset of instructions these shaders use,
+# so files can also be assembled with spirv-as from Vulkan SDK when it's available.
+
+SPIRV_MAGIC = 0x07230203
+SPIRV_VERSION = 0x00010000  # 1.0, shaders are loaded on Vulkan 1.0 devices too
+
+OPCODES = {
+    "OpExtInstImport": 11, "OpExtInst": 12, "OpMemoryModel": 14, "OpEntryPoint": 15, "OpExecutionMode": 16,
+    "OpCapability": 17, "OpTypeVoid": 19, "OpTypeBool": 20, "OpTypeInt": 21, "OpTypeFloat": 22,
+    "OpTypeVector": 23, "OpTypeImage": 25, "OpTypeArray": 28, "OpTypeStruct": 30, "OpTypePointer": 32,
+    "OpTypeFunction": 33, "OpConstantTrue": 41, "OpConstantFalse": 42, "OpConstant": 43,
+    "OpConstantComposite": 44, "OpFunction": 54, "OpFunctionParameter": 55, "OpFunctionEnd": 56,
+    "OpFunctionCall": 57, "OpVariable": 59, "OpLoad": 61, "OpStore": 62, "OpAccessChain": 65,
+    "OpDecorate": 71, "OpMemberDecorate": 72, "OpVectorShuffle": 79, "OpCompositeConstruct": 80,
+    "OpCompositeExtract": 81, "OpCompositeInsert": 82, "OpImageFetch": 95, "OpImageWrite": 99,
+    "OpConvertFToU": 109, "OpConvertFToS": 110, "OpConvertSToF": 111, "OpConvertUToF": 112, "OpBitcast": 124,
+    "OpFNegate": 127, "OpIAdd": 128, "OpFAdd": 129, "OpISub": 130, "OpFSub": 131, "OpIMul": 132, "OpFMul": 133,
+    "OpUDiv": 134, "OpSDiv": 135, "OpFDiv": 136, "OpUMod": 137, "OpVectorTimesScalar": 142, "OpDot": 148,
+    "OpAny": 154, "OpAll": 155, "OpLogicalOr": 166, "OpLogicalAnd": 167, "OpLogicalNot": 168, "OpSelect": 169,
+    "OpIEqual": 170, "OpINotEqual": 171, "OpUGreaterThan": 172, "OpSGreaterThan": 173,
+    "OpUGreaterThanEqual": 174, "OpSGreaterThanEqual": 175, "OpULessThan": 176, "OpSLessThan": 177,
+    "OpULessThanEqual": 178, "OpSLessThanEqual": 179, "OpFOrdEqual": 180, "OpFOrdNotEqual": 182,
+    "OpFOrdLessThan": 184, "OpFOrdGreaterThan": 186, "OpFOrdLessThanEqual": 188, "OpFOrdGreaterThanEqual": 190,
+    "OpPhi": 245, "OpLoopMerge": 246, "OpSelectionMerge": 247, "OpLabel": 248, "OpBranch": 249,
+    "OpBranchConditional": 250, "OpReturn": 253, "OpReturnValue": 254,
+}
+
+# Enumerant names of all operand kinds used, values don't collide for same names
+ENUMERANTS = {
+    # Capability
+    "Shader": 1, "ImageQuery": 50, "StorageImageReadWithoutFormat": 55, "StorageImageWriteWithoutFormat": 56,
+    # AddressingModel / MemoryModel / ExecutionModel / ExecutionMode
+    "Logical": 0, "GLSL450": 1, "GLCompute": 5, "LocalSize": 17,
+    # StorageClass
+    "UniformConstant": 0, "Input": 1, "Uniform": 2, "Output": 3, "Workgroup": 4, "Private": 6, "Function": 7,
+    "PushConstant": 9,
+    # Decoration / BuiltIn
+    "Block": 2, "BuiltIn": 11, "NonWritable": 24, "NonReadable": 25, "Binding": 33, "DescriptorSet": 34,
+    "Offset": 35, "WorkgroupId": 26, "LocalInvocationId": 27, "GlobalInvocationId": 28,
+    "LocalInvocationIndex": 29,
+    # Dim / ImageFormat
+    "2D": 1, "Unknown": 0, "Rgba16f": 2, "R32f": 3,
+    # ImageOperands
+    "Lod": 2,
+    # FunctionControl / SelectionControl / LoopControl
+    "None": 0, "Inline": 1, "DontInline": 2, "Flatten": 1, "DontFlatten": 2, "Unroll": 1, "DontUnroll": 2,
+}
+
+# GLSL.std.450 extended instructions
+GLSL_STD_450 = {
+    "Round": 1, "Trunc": 3, "FAbs": 4, "SAbs": 5, "FSign": 6, "Floor": 8, "Ceil": 9, "Fract": 10, "Sqrt": 31,
+    "InverseSqrt": 32, "FMin": 37, "UMin": 38, "SMin": 39, "FMax": 40, "UMax": 41, "SMax": 42, "FClamp": 43,
+    "UClamp": 44, "SClamp": 45, "FMix": 46, "Fma": 50, "NMin": 79, "NMax": 80, "NClamp": 81,
+}
+
+TOKEN = re.compile(r'"(?:[^"\\]|\\.)*"|[^\s]+')
+
+
+class AssemblerError(Exception):
+    pass
+
+
+class Assembler:
+    def __init__(self):
+        self.ids = {}
+        self.float_types = set()
+        self.int_types = {}
+        self.ext_sets = {}
+        self.words = []
+
+    def id_of(self, name):
+        if name not in self.ids:
+            self.ids[name] = len(self.ids) + 1
+
+        return self.ids[name]
+
+    def literal_string(self, token):
+        data = token[1:-1].encode("utf-8").decode("unicode_escape").encode("utf-8") + b"\0"
+        data += b"\0" * (-len(data) % 4)
+        return list(struct.unpack(f"<{len(data) // 4}I", data))
+
+    def literal_number(self, token, result_type=None):
+        if result_type in self.float_types:
+            return [struct.unpack("<I", struct.pack("<f", float(token)))[0]]
+
+        value = int(token, 0)
+
+        if result_type in self.int_types and self.int_types[result_type] and value < 0:
+            value &= 0xFFFFFFFF
+
+        if value < 0 or value > 0xFFFFFFFF:
+            raise AssemblerError(f"literal {token} is out of range")
+
+        return [value]
+
+    def operand(self, token, result_type=None, ext_set=None):
+        if token.startswith("%"):
+            return [self.id_of(token)]
+
+        if token.startswith('"'):
+            return self.literal_string(token)
+
+        if re.fullmatch(r"[-+]?(\d+\.\d*(e[-+]?\d+)?|\d+e[-+]?\d+|0x[0-9a-fA-F]+|\d+)", token):
+            return self.literal_number(token, result_type)
+
+        if ext_set is not None and token in GLSL_STD_450:
+            return [GLSL_STD_450[token]]
+
+        if token in ENUMERANTS:
+            return [ENUMERANTS[token]]
+
+        raise AssemblerError(f"unknown operand {token}")
+
+    def line(self, text):
+        tokens = TOKEN.findall(self.strip_comment(text))
+
+        if not tokens:
+            return
+
+        result = None
+
+        if len(tokens) > 2 and tokens[1] == "=":
+            result = tokens[0]
+            tokens = tokens[2:]
+
+        opname = tokens[0]
+
+        if opname not in OPCODES:
+            raise AssemblerError(f"unsupported instruction {opname}")
+
+        args = tokens[1:]
+        words = []
+
+        # Result type comes before result id in the binary
+        has_type = result is not None and not opname.startswith("OpType") and opname not in (
+            "OpExtInstImport", "OpLabel", "OpString")
+
+        result_type = None
+
+        if has_type:
+            result_type = self.id_of(args[0])
+            words.append(result_type)
+            args = args[1:]
+
+        if result is not None:
+            words.append(self.id_of(result))
+
+        if opname == "OpTypeFloat":
+            self.float_types.add(self.id_of(result))
+        elif opname == "OpTypeInt":
+            self.int_types[self.id_of(result)] = args[1] == "1"
+        elif opname == "OpExtInstImport":
+            self.ext_sets[self.id_of(result)] = args[0]
+
+        ext_set = None
+
+        for index, arg in enumerate(args):
+            if opname == "OpExtInst" and index == 1:
+                ext_set = self.id_of(args[0])
+
+                if arg not in GLSL_STD_450:
+                    raise AssemblerError(f"unknown extended instruction {arg}")
+
+                words.append(GLSL_STD_450[arg])
+                continue
+
+            words.extend(self.operand(arg, result_type if opname == "OpConstant" else None, ext_set))
+
+        self.words.append(((len(words) + 1) << 16) | OPCODES[opname])
+        self.words.extend(words)
+
+    @staticmethod
+    def strip_comment(text):
+        in_string = False
+
+        for index, char in enumerate(text):
+            if char == '"':
+                in_string = not in_string
+            elif char == ";" and not in_string:
+                return text[:index]
+
+        return text
+
+    def assemble(self, source):
+        for number, text in enumerate(source.splitlines(), 1):
+            try:
+                self.line(text)
+            except (AssemblerError, ValueError, IndexError) as e:
+                raise AssemblerError(f"line {number}: {e}") from None
+
+        return [SPIRV_MAGIC, SPIRV_VERSION, 0, len(self.ids) + 1, 0] + self.words
+
+
+def assemble_file(input_file_path):
+    with open(input_file_path, "r") as input_file:
+        return Assembler().assemble(input_file.read())
+
+
+def write_header(words, output_file_path, array_name):
+    with open(output_file_path, "w") as output_file:
+        output_file.write("#pragma once\n\n")
+        output_file.write(f"inline static const uint32_t {array_name}[] = {{\n    ")
+
+        for i, word in enumerate(words):
+            output_file.write(f"0x{word:08x}")
+            if i < len(words) - 1:
+                output_file.write(",\n    " if (i + 1) % 8 == 0 else ", ")
+
+        output_file.write("\n};\n")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4:
+        print(f"Usage: {os.path.basename(__file__)} <input_spvasm_file> <output_header_file> <array_name>")
+        sys.exit(1)
+
+    try:
+        spirv = assemble_file(sys.argv[1])
+    except (AssemblerError, IOError) as e:
+        print(f"Failed to assemble {sys.argv[1]}: {e}")
+        sys.exit(1)
+
+    write_header(spirv, sys.argv[2], sys.argv[3])
+    print(f"Shader assembled to header file successfully: {sys.argv[2]}")
@@ -1,6 +1,7 @@
 #include "IFeature_Dx11wDx12.h"
 
 #include <Config.h>
+#include <misc/VramTracker.h>
 
 #define ASSIGN_DESC(dest, src)                                                                                         \
     dest.Width = src.Width;                                                                                            \
@@ -78,6 +79,8 @@ bool IFeature_Dx11wDx12::CopyTextureFrom11To12(ID3D11Resource* InResource, D3D11
                 return false;
             }
 
+            VramTracker::Track(OutResource->SharedTexture, VramOwner::Dx11wDx12);
+
             IDXGIResource1* resource;
 
             result = OutResource->SharedTexture->QueryInterface(IID_PPV_ARGS(&resource));
@@ -169,6 +172,7 @@ bool IFeature_Dx11wDx12::CopyTextureFrom11To12(ID3D11Resource* InResource, D3D11
                 desc.Usage = D3D11_USAGE_DEFAULT;
 
                 result = Dx11Device->CreateTexture2D(&desc, nullptr, &OutResource->SharedTexture);
+                VramTracker::Track(OutResource->SharedTexture, VramOwner::Dx11wDx12);
 
                 IDXGIResource1* resource;
                 result = OutResource->SharedTexture->QueryInterface(IID_PPV_ARGS(&resource));
@@ -525,6 +529,22 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
     Dx12CommandAllocator[frame]->Reset();
     Dx12CommandList[frame]->Reset(Dx12CommandAllocator[frame], nullptr);
 
+    if (Config::Instance()->AsyncPostPasses.value_or_default() && AsyncPost == nullptr)
+    {
+        AsyncPost = std::make_unique<AsyncCompute_Dx12>("AsyncPost", State::Instance().currentD3D12Device,
+                                                        Dx12CommandQueue);
+
+        if (!AsyncPost->IsInit())
+        {
+            LOG_WARN("Can't create async compute queue, post passes will run on direct queue");
+            Config::Instance()->AsyncPostPasses.set_volatile_value(false);
+            AsyncPost.reset();
+        }
+    }
+
+    if (AsyncPost != nullptr)
+        AsyncPost->BeginFrame(Dx12CommandList[frame]);
+
     HRESULT result;
 
     auto dontUseNTS = Config::Instance()->DontUseNTShared.value_or_default();
@@ -834,6 +854,34 @@ bool IFeature_Dx11wDx12::CopyBackOutput()
     return true;
 }
 
+ID3D12GraphicsCommandList* IFeature_Dx11wDx12::BeginPostPasses(ID3D12GraphicsCommandList* InCmdList, bool InRcas,
+                                                               bool InOutputScaling)
+{
+    if (AsyncPost == nullptr)
+        return InCmdList;
+
+    // Bias stays on direct list, upscaler reads its output right after
+    auto eligible = (InRcas || InOutputScaling) &&
+                    (!InRcas || Config::Instance()->AsyncPostRcas.value_or_default()) &&
+                    (!InOutputScaling || Config::Instance()->AsyncPostOutputScaling.value_or_default());
+
+    return AsyncPost->BeginPost(InCmdList, eligible);
+}
+
+void IFeature_Dx11wDx12::SubmitCommandLists(ID3D12GraphicsCommandList* InCmdList)
+{
+    if (AsyncPost != nullptr)
+    {
+        AsyncPost->Execute(InCmdList, dx12FenceTextureCopy, _fenceValue);
+        return;
+    }
+
+    InCmdList->Close();
+    ID3D12CommandList* ppCommandLists[] = { InCmdList };
+    Dx12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
+    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
+}
+
 bool IFeature_Dx11wDx12::BaseInit(ID3D11Device* InDevice, ID3D11DeviceContext* InContext,
                                   NVSDK_NGX_Parameter* InParameters)
 {
@@ -891,6 +939,9 @@ IFeature_Dx11wDx12::~IFeature_Dx11wDx12()
     if (State::Instance().isShuttingDown)
         return;
 
+    // Waits for post passes on compute queue
+    AsyncPost.reset();
+
     ReleaseSharedResources();
 
     if (Imgui != nullptr && Imgui.get() != nullptr)
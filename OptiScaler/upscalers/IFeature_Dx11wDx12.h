@@ -7,6 +7,7 @@
 #include <shaders/bias/Bias_Dx12.h>
 #include <shaders/output_scaling/OS_Dx12.h>
 #include <shaders/depth_transfer/DT_Dx11.h>
+#include <shaders/AsyncCompute_Dx12.h>
 
 #include <d3d12.h>
 #include <d3d11_4.h>
@@ -65,6 +66,7 @@ class IFeature_Dx11wDx12 : public virtual IFeature_Dx11
     std::unique_ptr<RCAS_Dx12> RCAS = nullptr;
     std::unique_ptr<Bias_Dx12> Bias = nullptr;
     std::unique_ptr<DepthTransfer_Dx11> DT = nullptr;
+    std::unique_ptr<AsyncCompute_Dx12> AsyncPost = nullptr;
 
     HRESULT CreateDx12Device(D3D_FEATURE_LEVEL InFeatureLevel);
     void GetHardwareAdapter(IDXGIFactory1* InFactory, IDXGIAdapter** InAdapter, D3D_FEATURE_LEVEL InFeatureLevel,
@@ -75,6 +77,13 @@ class IFeature_Dx11wDx12 : public virtual IFeature_Dx11
     bool ProcessDx11Textures(const NVSDK_NGX_Parameter* InParameters);
     bool CopyBackOutput();
 
+    // List for RCAS & output scaling, async compute list when it's enabled for all active passes
+    ID3D12GraphicsCommandList* BeginPostPasses(ID3D12GraphicsCommandList* InCmdList, bool InRcas,
+                                               bool InOutputScaling);
+
+    // Submits command lists of the frame, dx12FenceTextureCopy is signaled when output is ready
+    void SubmitCommandLists(ID3D12GraphicsCommandList* InCmdList);
+
     void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
                          D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
 
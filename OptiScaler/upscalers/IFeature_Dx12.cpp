@@ -27,12 +27,9 @@ IFeature_Dx12::~IFeature_Dx12()
     if (Imgui != nullptr && Imgui.get() != nullptr)
         Imgui.reset();
 
-    if (OutputScaler != nullptr && OutputScaler.get() != nullptr)
-        OutputScaler.reset();
-
-    if (RCAS != nullptr && RCAS.get() != nullptr)
-        RCAS.reset();
-
-    if (Bias != nullptr && Bias.get() != nullptr)
-        Bias.reset();
+    // Shader passes go back to the pool so the next feature doesn't need to compile them again
+    ShaderPool_Dx12::Release(OutputScaler);
+    ShaderPool_Dx12::Release(RCAS);
+    ShaderPool_Dx12::Release(RcasScaler);
+    ShaderPool_Dx12::Release(Bias);
 }
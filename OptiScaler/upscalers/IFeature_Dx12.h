@@ -7,7 +7,9 @@
 #include <menu/menu_dx12.h>
 #include <shaders/output_scaling/OS_Dx12.h>
 #include <shaders/rcas/RCAS_Dx12.h>
+#include <shaders/rcas/RCAS_OS_Dx12.h>
 #include <shaders/bias/Bias_Dx12.h>
+#include <shaders/ShaderPool_Dx12.h>
 
 class IFeature_Dx12 : public virtual IFeature
 {
@@ -16,6 +18,7 @@ class IFeature_Dx12 : public virtual IFeature
     static inline std::unique_ptr<Menu_Dx12> Imgui = nullptr;
     std::unique_ptr<OS_Dx12> OutputScaler = nullptr;
     std::unique_ptr<RCAS_Dx12> RCAS = nullptr;
+    std::unique_ptr<RCAS_OS_Dx12> RcasScaler = nullptr;
     std::unique_ptr<Bias_Dx12> Bias = nullptr;
 
     void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
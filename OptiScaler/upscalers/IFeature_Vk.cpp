@@ -0,0 +1,72 @@
+#include "IFeature_Vk.h"
+#include <pch.h>
+
+#include <Config.h>
+#include <State.h>
+
+void IFeature_Vk::CreatePostPasses(VkPhysicalDevice InPD, VkDevice InDevice)
+{
+    OutputScaler = std::make_unique<OS_Vk>("Output Scaling", InPD, InDevice, (TargetWidth() < DisplayWidth()));
+    RCAS = std::make_unique<RCAS_Vk>("RCAS", InPD, InDevice);
+    Bias = std::make_unique<Bias_Vk>("Bias", InPD, InDevice);
+}
+
+NVSDK_NGX_Resource_VK* IFeature_Vk::PostPassesOutput(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* OutResource,
+                                                     bool InUseSS, bool InRcasEnabled)
+{
+    auto output = OutResource;
+
+    if (InUseSS && OutputScaler->CreateBufferResource(InCmdBuffer, OutResource, TargetWidth(), TargetHeight()))
+        output = OutputScaler->Buffer();
+
+    if (InRcasEnabled &&
+        (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
+                               Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
+        RCAS != nullptr && RCAS.get() != nullptr && RCAS->IsInit() && RCAS->CreateBufferResource(InCmdBuffer, output))
+    {
+        output = RCAS->Buffer();
+    }
+
+    return output;
+}
+
+bool IFeature_Vk::RunPostPasses(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* InParameters,
+                                NVSDK_NGX_Resource_VK* InUpscaled, NVSDK_NGX_Resource_VK* InMotionVectors,
+                                NVSDK_NGX_Resource_VK* OutResource, bool InUseSS)
+{
+    RcasConstants rcasConstants {};
+
+    rcasConstants.Sharpness = _sharpness;
+    rcasConstants.DisplayWidth = TargetWidth();
+    rcasConstants.DisplayHeight = TargetHeight();
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+    rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+    rcasConstants.RenderHeight = RenderHeight();
+    rcasConstants.RenderWidth = RenderWidth();
+
+    // apply rcas, upscaler only wrote to its buffer when it could be created
+    if (RCAS != nullptr && RCAS.get() != nullptr && RCAS->CanRender() && InUpscaled == RCAS->Buffer())
+    {
+        if (!RCAS->Dispatch(InCmdBuffer, InUpscaled, InMotionVectors, rcasConstants,
+                            InUseSS ? OutputScaler->Buffer() : OutResource))
+        {
+            Config::Instance()->RcasEnabled.set_volatile_value(false);
+            return false;
+        }
+    }
+
+    if (InUseSS)
+    {
+        LOG_DEBUG("scaling output...");
+
+        if (!OutputScaler->Dispatch(InCmdBuffer, OutputScaler->Buffer(), OutResource))
+        {
+            Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+            State::Instance().changeBackend[Handle()->Id] = true;
+            return false;
+        }
+    }
+
+    return true;
+}
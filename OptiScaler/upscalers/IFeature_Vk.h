@@ -2,6 +2,11 @@
 #include <vulkan/vulkan.hpp>
 #include "IFeature.h"
 
+#include <nvsdk_ngx_vk.h>
+#include <shaders/output_scaling/OS_Vk.h>
+#include <shaders/rcas/RCAS_Vk.h>
+#include <shaders/bias/Bias_Vk.h>
+
 class IFeature_Vk : public virtual IFeature
 {
   private:
@@ -11,6 +16,20 @@ class IFeature_Vk : public virtual IFeature
     VkDevice Device = nullptr;
     PFN_vkGetInstanceProcAddr GIPA = nullptr;
     PFN_vkGetDeviceProcAddr GDPA = nullptr;
+    std::unique_ptr<OS_Vk> OutputScaler = nullptr;
+    std::unique_ptr<RCAS_Vk> RCAS = nullptr;
+    std::unique_ptr<Bias_Vk> Bias = nullptr;
+
+    void CreatePostPasses(VkPhysicalDevice InPD, VkDevice InDevice);
+
+    // Upscaler output when RCAS or output scaling is active, otherwise OutResource
+    NVSDK_NGX_Resource_VK* PostPassesOutput(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Resource_VK* OutResource,
+                                            bool InUseSS, bool InRcasEnabled);
+
+    // Runs RCAS and output scaling after upscaler, false when a pass failed and was disabled
+    bool RunPostPasses(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* InParameters,
+                       NVSDK_NGX_Resource_VK* InUpscaled, NVSDK_NGX_Resource_VK* InMotionVectors,
+                       NVSDK_NGX_Resource_VK* OutResource, bool InUseSS);
 
   public:
     virtual bool Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice InDevice, VkCommandBuffer InCmdList,
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "pch.h"
+
+// Upscaler backends, ini and menu still use codes like "fsr21" which are only converted at the boundary
+enum class Upscaler : uint32_t
+{
+    None,
+    XeSS,
+    XeSS_Dx12,
+    FSR21,
+    FSR21_Dx12,
+    FSR22,
+    FSR22_Dx12,
+    FSR31,
+    FSR31_Dx12,
+    DLSS,
+    DLSSD,
+};
+
+inline Upscaler UpscalerFromCode(const std::string& code)
+{
+    if (code == "xess")
+        return Upscaler::XeSS;
+
+    if (code == "xess_12")
+        return Upscaler::XeSS_Dx12;
+
+    if (code == "fsr21")
+        return Upscaler::FSR21;
+
+    if (code == "fsr21_12")
+        return Upscaler::FSR21_Dx12;
+
+    if (code == "fsr22")
+        return Upscaler::FSR22;
+
+    if (code == "fsr22_12")
+        return Upscaler::FSR22_Dx12;
+
+    if (code == "fsr31")
+        return Upscaler::FSR31;
+
+    if (code == "fsr31_12")
+        return Upscaler::FSR31_Dx12;
+
+    if (code == "dlss")
+        return Upscaler::DLSS;
+
+    if (code == "dlssd")
+        return Upscaler::DLSSD;
+
+    return Upscaler::None;
+}
+
+inline const char* UpscalerCode(Upscaler upscaler)
+{
+    switch (upscaler)
+    {
+    case Upscaler::XeSS:
+        return "xess";
+    case Upscaler::XeSS_Dx12:
+        return "xess_12";
+    case Upscaler::FSR21:
+        return "fsr21";
+    case Upscaler::FSR21_Dx12:
+        return "fsr21_12";
+    case Upscaler::FSR22:
+        return "fsr22";
+    case Upscaler::FSR22_Dx12:
+        return "fsr22_12";
+    case Upscaler::FSR31:
+        return "fsr31";
+    case Upscaler::FSR31_Dx12:
+        return "fsr31_12";
+    case Upscaler::DLSS:
+        return "dlss";
+    case Upscaler::DLSSD:
+        return "dlssd";
+    default:
+        return "";
+    }
+}
+
+inline bool IsFSRUpscaler(Upscaler upscaler)
+{
+    return upscaler >= Upscaler::FSR21 && upscaler <= Upscaler::FSR31_Dx12;
+}
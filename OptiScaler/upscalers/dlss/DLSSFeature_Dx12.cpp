@@ -72,12 +72,15 @@ bool DLSSFeatureDx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* In
 
     if (initResult)
     {
-        RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
+        RCAS = ShaderPool_Dx12::AcquireRcas("RCAS", InDevice);
 
         if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
             Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
-        OutputScaler = std::make_unique<OS_Dx12>("OutputScaling", InDevice, (TargetWidth() < DisplayWidth()));
+        OutputScaler =
+            ShaderPool_Dx12::AcquireOutputScaler("OutputScaling", InDevice, (TargetWidth() < DisplayWidth()));
+        RcasScaler =
+            ShaderPool_Dx12::AcquireRcasScaler("RCAS + OutputScaling", InDevice, (TargetWidth() < DisplayWidth()));
     }
 
     SetInit(initResult);
@@ -152,7 +155,18 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         // RCAS sharpness & preperation
         _sharpness = GetSharpness(InParameters);
 
-        if (Config::Instance()->RcasEnabled.value_or(rcasEnabled) &&
+        // RCAS is applied while scaling the output, skips RCAS buffer and its pass
+        bool fuseRcas = useSS && setBuffer == OutputScaler->Buffer() && RcasScaler->IsInit() &&
+                        Config::Instance()->RcasEnabled.value_or(rcasEnabled) &&
+                        (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
+                                               Config::Instance()->MotionSharpness.value_or_default() > 0.0f));
+
+        if (fuseRcas)
+        {
+            // Disable DLSS sharpness
+            InParameters->Set(NVSDK_NGX_Parameter_Sharpness, 0.0f);
+        }
+        else if (Config::Instance()->RcasEnabled.value_or(rcasEnabled) &&
             (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
                                    Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
             RCAS->IsInit() && RCAS->CreateBufferResource(Device, setBuffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS))
@@ -174,8 +188,19 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
             return false;
         }
 
+        RcasConstants rcasConstants {};
+
+        rcasConstants.Sharpness = _sharpness;
+        rcasConstants.DisplayWidth = TargetWidth();
+        rcasConstants.DisplayHeight = TargetHeight();
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+        rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+        rcasConstants.RenderHeight = RenderHeight();
+        rcasConstants.RenderWidth = RenderWidth();
+
         // Apply CAS
-        if (Config::Instance()->RcasEnabled.value_or(rcasEnabled) &&
+        if (!fuseRcas && Config::Instance()->RcasEnabled.value_or(rcasEnabled) &&
             (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
                                    Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
             RCAS->CanRender())
@@ -186,17 +211,6 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
             RCAS->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-            RcasConstants rcasConstants {};
-
-            rcasConstants.Sharpness = _sharpness;
-            rcasConstants.DisplayWidth = TargetWidth();
-            rcasConstants.DisplayHeight = TargetHeight();
-            InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
-            InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
-            rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
-            rcasConstants.RenderHeight = RenderHeight();
-            rcasConstants.RenderWidth = RenderWidth();
-
             if (useSS)
             {
                 if (!RCAS->Dispatch(Device, InCommandList, setBuffer, paramMotion, rcasConstants,
@@ -222,7 +236,17 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
             LOG_DEBUG("downscaling output...");
             OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-            if (!OutputScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramOutput))
+            if (fuseRcas)
+            {
+                if (!RcasScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramMotion, rcasConstants,
+                                          paramOutput))
+                {
+                    Config::Instance()->OutputScalingFuseRcas.set_volatile_value(false);
+                    State::Instance().changeBackend[Handle()->Id] = true;
+                    return true;
+                }
+            }
+            else if (!OutputScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramOutput))
             {
                 Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
                 State::Instance().changeBackend[Handle()->Id] = true;
@@ -72,6 +72,9 @@ bool DLSSFeatureVk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
 
     } while (false);
 
+    if (initResult)
+        CreatePostPasses(InPD, InDevice);
+
     SetInit(initResult);
 
     return initResult;
@@ -85,19 +88,64 @@ bool DLSSFeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
         return false;
     }
 
+    bool rcasEnabled = Version() >= feature_version { 2, 5, 1 };
+
+    if (Config::Instance()->RcasEnabled.value_or(rcasEnabled) &&
+        (RCAS == nullptr || RCAS.get() == nullptr || !RCAS->IsInit()))
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
+    if (OutputScaler == nullptr || OutputScaler.get() == nullptr || !OutputScaler->IsInit())
+        Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+
     NVSDK_NGX_Result nvResult;
 
     if (NVNGXProxy::VULKAN_EvaluateFeature() != nullptr)
     {
         ProcessEvaluateParams(InParameters);
 
+        NVSDK_NGX_Resource_VK* paramOutput = nullptr;
+        NVSDK_NGX_Resource_VK* paramMotion = nullptr;
+
+        bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+
+        InParameters->Get(NVSDK_NGX_Parameter_Output, (void**) &paramOutput);
+        InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, (void**) &paramMotion);
+
+        // RCAS sharpness & preperation
+        _sharpness = GetSharpness(InParameters);
+
+        auto setBuffer = paramOutput;
+
+        if (paramOutput != nullptr)
+        {
+            setBuffer = PostPassesOutput(InCmdBuffer, paramOutput, useSS,
+                                         Config::Instance()->RcasEnabled.value_or(rcasEnabled));
+
+            // Disable DLSS sharpness
+            if (setBuffer == RCAS->Buffer())
+                InParameters->Set(NVSDK_NGX_Parameter_Sharpness, 0.0f);
+
+            InParameters->Set(NVSDK_NGX_Parameter_Output, (void*) setBuffer);
+        }
+
         nvResult = NVNGXProxy::VULKAN_EvaluateFeature()(InCmdBuffer, _p_dlssHandle, InParameters, NULL);
 
         if (nvResult != NVSDK_NGX_Result_Success)
         {
             LOG_ERROR("_EvaluateFeature result: {0:X}", (unsigned int) nvResult);
+            InParameters->Set(NVSDK_NGX_Parameter_Output, (void*) paramOutput);
             return false;
         }
+
+        if (paramOutput != nullptr)
+        {
+            // set original output texture back
+            InParameters->Set(NVSDK_NGX_Parameter_Output, (void*) paramOutput);
+
+            if (paramMotion != nullptr &&
+                !RunPostPasses(InCmdBuffer, InParameters, setBuffer, paramMotion, paramOutput, useSS))
+                return true;
+        }
     }
     else
     {
@@ -12,7 +12,8 @@ void DLSSDFeature::ProcessEvaluateParams(NVSDK_NGX_Parameter* InParameters)
 
     // override sharpness
     if (Config::Instance()->OverrideSharpness.value_or_default() &&
-        !(State::Instance().api == DX12 && Config::Instance()->RcasEnabled.value_or_default()))
+        !((State::Instance().api == DX12 || State::Instance().api == Vulkan) &&
+          Config::Instance()->RcasEnabled.value_or_default()))
     {
         auto sharpness = Config::Instance()->Sharpness.value_or_default();
 
@@ -61,7 +62,7 @@ void DLSSDFeature::ProcessInitParams(NVSDK_NGX_Parameter* InParameters)
     InParameters->Set(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, featureFlags);
 
     // Resolution -----------------------------
-    if (State::Instance().api != Vulkan && Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
+    if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
     {
         float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or_default();
 
@@ -1,6 +1,7 @@
 #include <pch.h>
 #include <Config.h>
 #include <Util.h>
+#include <misc/VramTracker.h>
 
 #include "FSR2Feature_Dx11.h"
 
@@ -91,6 +92,8 @@ bool FSR2FeatureDx11::CopyTexture(ID3D11Resource* InResource, D3D11_TEXTURE2D_RE
             LOG_ERROR("CreateTexture2D error: {0:x}", result);
             return false;
         }
+
+        VramTracker::Track(OutTextureRes->Texture, VramOwner::Inputs);
     }
 
     if (InCopy)
@@ -308,18 +308,23 @@ bool FSR2FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
             break;
         }
 
+        auto useRcas = Config::Instance()->RcasEnabled.value_or_default() &&
+                       (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
+                                              Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
+                       RCAS->CanRender();
+
+        // RCAS & output scaling might run on async compute queue
+        auto postList = BeginPostPasses(cmdList, useRcas, useSS);
+
         // apply rcas
-        if (Config::Instance()->RcasEnabled.value_or_default() &&
-            (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
-                                   Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
-            RCAS->CanRender())
+        if (useRcas)
         {
             LOG_DEBUG("Apply CAS");
             if (params.output.resource != RCAS->Buffer())
-                ResourceBarrier(cmdList, (ID3D12Resource*) params.output.resource,
+                ResourceBarrier(postList, (ID3D12Resource*) params.output.resource,
                                 D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-            RCAS->SetBufferState(cmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            RCAS->SetBufferState(postList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
             RcasConstants rcasConstants {};
 
@@ -335,7 +340,7 @@ bool FSR2FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
             if (useSS)
             {
                 if (!RCAS->Dispatch(
-                        State::Instance().currentD3D12Device, cmdList, (ID3D12Resource*) params.output.resource,
+                        State::Instance().currentD3D12Device, postList, (ID3D12Resource*) params.output.resource,
                         (ID3D12Resource*) params.motionVectors.resource, rcasConstants, OutputScaler->Buffer()))
                 {
                     Config::Instance()->RcasEnabled.set_volatile_value(false);
@@ -345,7 +350,7 @@ bool FSR2FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
             else
             {
                 if (!RCAS->Dispatch(
-                        State::Instance().currentD3D12Device, cmdList, (ID3D12Resource*) params.output.resource,
+                        State::Instance().currentD3D12Device, postList, (ID3D12Resource*) params.output.resource,
                         (ID3D12Resource*) params.motionVectors.resource, rcasConstants, dx11Out.Dx12Resource))
                 {
                     Config::Instance()->RcasEnabled.set_volatile_value(false);
@@ -357,9 +362,9 @@ bool FSR2FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
         if (useSS)
         {
             LOG_DEBUG("scaling output...");
-            OutputScaler->SetBufferState(cmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            OutputScaler->SetBufferState(postList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-            if (!OutputScaler->Dispatch(State::Instance().currentD3D12Device, cmdList, OutputScaler->Buffer(),
+            if (!OutputScaler->Dispatch(State::Instance().currentD3D12Device, postList, OutputScaler->Buffer(),
                                         dx11Out.Dx12Resource))
             {
                 Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
@@ -371,10 +376,7 @@ bool FSR2FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
     } while (false);
 
     // Execute dx12 commands to process fsr
-    cmdList->Close();
-    ID3D12CommandList* ppCommandLists[] = { cmdList };
-    Dx12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
-    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
+    SubmitCommandLists(cmdList);
 
     auto evalResult = false;
 
@@ -18,9 +18,12 @@ bool FSR2FeatureDx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* In
         if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
             Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
-        OutputScaler = std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
-        RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
-        Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+        OutputScaler =
+            ShaderPool_Dx12::AcquireOutputScaler("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+        RcasScaler =
+            ShaderPool_Dx12::AcquireRcasScaler("RCAS + Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+        RCAS = ShaderPool_Dx12::AcquireRcas("RCAS", InDevice);
+        Bias = ShaderPool_Dx12::AcquireBias("Bias", InDevice);
 
         return true;
     }
@@ -74,6 +77,11 @@ bool FSR2FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
     bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
 
+    // RCAS is applied while scaling the output, skips RCAS buffer and its pass
+    bool fuseRcas = useSS && RcasScaler->IsInit() && Config::Instance()->RcasEnabled.value_or_default() &&
+                    (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
+                                           Config::Instance()->MotionSharpness.value_or_default() > 0.0f));
+
     params.commandList = ffxGetCommandListDX12(InCommandList);
 
     ID3D12Resource* paramColor;
@@ -168,7 +176,7 @@ bool FSR2FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
             params.output = ffxGetResourceDX12(&_context, paramOutput, (wchar_t*) L"FSR2_Output",
                                                FFX_RESOURCE_STATE_UNORDERED_ACCESS);
 
-        if (Config::Instance()->RcasEnabled.value_or_default() &&
+        if (!fuseRcas && Config::Instance()->RcasEnabled.value_or_default() &&
             (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
                                    Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
             RCAS != nullptr && RCAS.get() != nullptr && RCAS->IsInit() &&
@@ -382,8 +390,19 @@ bool FSR2FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         return false;
     }
 
+    RcasConstants rcasConstants {};
+
+    rcasConstants.Sharpness = _sharpness;
+    rcasConstants.DisplayWidth = TargetWidth();
+    rcasConstants.DisplayHeight = TargetHeight();
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+    rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+    rcasConstants.RenderHeight = RenderHeight();
+    rcasConstants.RenderWidth = RenderWidth();
+
     // apply rcas
-    if (Config::Instance()->RcasEnabled.value_or_default() &&
+    if (!fuseRcas && Config::Instance()->RcasEnabled.value_or_default() &&
         (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or_default() &&
                                Config::Instance()->MotionSharpness.value_or_default() > 0.0f)) &&
         RCAS != nullptr && RCAS.get() != nullptr && RCAS->CanRender())
@@ -394,17 +413,6 @@ bool FSR2FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
         RCAS->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-        RcasConstants rcasConstants {};
-
-        rcasConstants.Sharpness = _sharpness;
-        rcasConstants.DisplayWidth = TargetWidth();
-        rcasConstants.DisplayHeight = TargetHeight();
-        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
-        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
-        rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
-        rcasConstants.RenderHeight = RenderHeight();
-        rcasConstants.RenderWidth = RenderWidth();
-
         if (useSS)
         {
             if (!RCAS->Dispatch(Device, InCommandList, (ID3D12Resource*) params.output.resource,
@@ -430,7 +438,17 @@ bool FSR2FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         LOG_DEBUG("scaling output...");
         OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-        if (!OutputScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramOutput))
+        if (fuseRcas)
+        {
+            if (!RcasScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(),
+                                      (ID3D12Resource*) params.motionVectors.resource, rcasConstants, paramOutput))
+            {
+                Config::Instance()->OutputScalingFuseRcas.set_volatile_value(false);
+                State::Instance().changeBackend[Handle()->Id] = true;
+                return true;
+            }
+        }
+        else if (!OutputScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramOutput))
         {
             Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
             State::Instance().changeBackend[Handle()->Id] = true;
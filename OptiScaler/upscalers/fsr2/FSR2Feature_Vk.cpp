@@ -35,19 +35,6 @@ bool FSR2FeatureVk::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
 
     _contextDesc.device = ffxGetDeviceVK(Device);
 
-    if (Config::Instance()->ExtendedLimits.value_or_default())
-    {
-        _contextDesc.maxRenderSize.width = RenderWidth() < DisplayWidth() ? DisplayWidth() : RenderWidth();
-        _contextDesc.maxRenderSize.height = RenderHeight() < DisplayHeight() ? DisplayHeight() : RenderHeight();
-    }
-    else
-    {
-        _contextDesc.maxRenderSize.width = DisplayWidth();
-        _contextDesc.maxRenderSize.height = DisplayHeight();
-    }
-
-    _contextDesc.displaySize.width = DisplayWidth();
-    _contextDesc.displaySize.height = DisplayHeight();
     _contextDesc.flags = 0;
 
     if (DepthInverted())
@@ -65,6 +52,62 @@ bool FSR2FeatureVk::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
     if (!LowResMV())
         _contextDesc.flags |= FFX_FSR2_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS;
 
+    if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
+    {
+        float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or_default();
+
+        if (ssMulti < 0.5f)
+        {
+            ssMulti = 0.5f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+        else if (ssMulti > 3.0f)
+        {
+            ssMulti = 3.0f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+
+        _targetWidth = DisplayWidth() * ssMulti;
+        _targetHeight = DisplayHeight() * ssMulti;
+    }
+    else
+    {
+        _targetWidth = DisplayWidth();
+        _targetHeight = DisplayHeight();
+    }
+
+    // extended limits changes how resolution
+    if (Config::Instance()->ExtendedLimits.value_or_default() && RenderWidth() > DisplayWidth())
+    {
+        _contextDesc.maxRenderSize.width = RenderWidth();
+        _contextDesc.maxRenderSize.height = RenderHeight();
+
+        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+
+        // if output scaling active let it to handle downsampling
+        if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
+        {
+            _contextDesc.displaySize.width = _contextDesc.maxRenderSize.width;
+            _contextDesc.displaySize.height = _contextDesc.maxRenderSize.height;
+
+            // update target res
+            _targetWidth = _contextDesc.maxRenderSize.width;
+            _targetHeight = _contextDesc.maxRenderSize.height;
+        }
+        else
+        {
+            _contextDesc.displaySize.width = DisplayWidth();
+            _contextDesc.displaySize.height = DisplayHeight();
+        }
+    }
+    else
+    {
+        _contextDesc.maxRenderSize.width = TargetWidth() > DisplayWidth() ? TargetWidth() : DisplayWidth();
+        _contextDesc.maxRenderSize.height = TargetHeight() > DisplayHeight() ? TargetHeight() : DisplayHeight();
+        _contextDesc.displaySize.width = TargetWidth();
+        _contextDesc.displaySize.height = TargetHeight();
+    }
+
 #if _DEBUG
     _contextDesc.flags |= FFX_FSR2_ENABLE_DEBUG_CHECKING;
     _contextDesc.fpMessage = FfxLogCallback;
@@ -102,7 +145,12 @@ bool FSR2FeatureVk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
     GIPA = InGIPA;
     GDPA = InGDPA;
 
-    return InitFSR2(InParameters);
+    if (!InitFSR2(InParameters))
+        return false;
+
+    CreatePostPasses(InPD, InDevice);
+
+    return true;
 }
 
 bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* InParameters)
@@ -112,11 +160,36 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
     if (!IsInited())
         return false;
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
+    if (!OutputScaler->IsInit())
+        Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+
     FfxFsr2DispatchDescription params {};
 
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &params.jitterOffset.x);
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &params.jitterOffset.y);
 
+    if (Config::Instance()->OverrideSharpness.value_or_default())
+        _sharpness = Config::Instance()->Sharpness.value_or_default();
+    else
+        _sharpness = GetSharpness(InParameters);
+
+    if (Config::Instance()->RcasEnabled.value_or_default())
+    {
+        params.enableSharpening = false;
+        params.sharpness = 0.0f;
+    }
+    else
+    {
+        if (_sharpness > 1.0f)
+            _sharpness = 1.0f;
+
+        params.enableSharpening = _sharpness > 0.0f;
+        params.sharpness = _sharpness;
+    }
+
     unsigned int reset;
     InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
     params.reset = (reset == 1);
@@ -125,6 +198,8 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
+    bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+
     params.commandList = ffxGetCommandListVK(InCmdBuffer);
 
     void* paramColor;
@@ -172,17 +247,19 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
     void* paramOutput;
     InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
 
+    NVSDK_NGX_Resource_VK* fsrOutput = nullptr;
+
     if (paramOutput)
     {
         LOG_DEBUG("Output exist..");
 
-        params.output =
-            ffxGetTextureResourceVK(&_context, ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Image,
-                                    ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.ImageView,
-                                    ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Width,
-                                    ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Height,
-                                    ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Format,
-                                    (wchar_t*) L"FSR2_Output", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+        fsrOutput = PostPassesOutput(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramOutput, useSS,
+                                     Config::Instance()->RcasEnabled.value_or_default());
+
+        params.output = ffxGetTextureResourceVK(
+            &_context, fsrOutput->Resource.ImageViewInfo.Image, fsrOutput->Resource.ImageViewInfo.ImageView,
+            fsrOutput->Resource.ImageViewInfo.Width, fsrOutput->Resource.ImageViewInfo.Height,
+            fsrOutput->Resource.ImageViewInfo.Format, (wchar_t*) L"FSR2_Output", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
     }
     else
     {
@@ -292,15 +369,27 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
                         (wchar_t*) L"FSR2_Transparency", FFX_RESOURCE_STATE_COMPUTE_READ);
                 }
 
-                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f)
+                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f && Bias->IsInit() &&
+                    Bias->CreateBufferResource(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramReactiveMask2) &&
+                    Bias->CanRender())
                 {
-                    params.reactive = ffxGetTextureResourceVK(
-                        &_context, ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Image,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.ImageView,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Width,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Height,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Format,
-                        (wchar_t*) L"FSR2_Reactive", FFX_RESOURCE_STATE_COMPUTE_READ);
+                    if (Bias->Dispatch(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramReactiveMask2,
+                                       Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->Buffer()))
+                    {
+                        // Bias buffer stays in general layout
+                        auto biasBuffer = Bias->Buffer();
+                        params.reactive = ffxGetTextureResourceVK(
+                            &_context, biasBuffer->Resource.ImageViewInfo.Image,
+                            biasBuffer->Resource.ImageViewInfo.ImageView, biasBuffer->Resource.ImageViewInfo.Width,
+                            biasBuffer->Resource.ImageViewInfo.Height, biasBuffer->Resource.ImageViewInfo.Format,
+                            (wchar_t*) L"FSR2_Reactive", FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+                    }
+                }
+                else
+                {
+                    LOG_DEBUG("Skipping reactive mask, Bias: {0}, Bias Init: {1}, Bias CanRender: {2}",
+                              Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->IsInit(),
+                              Bias->CanRender());
                 }
             }
             else
@@ -337,30 +426,6 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
         params.motionVectorScale.y = MVScaleY;
     }
 
-    if (Config::Instance()->OverrideSharpness.value_or_default())
-    {
-        params.enableSharpening = Config::Instance()->Sharpness.value_or_default() > 0.0f;
-        params.sharpness = Config::Instance()->Sharpness.value_or_default();
-    }
-    else
-    {
-        float shapness = 0.0f;
-        if (InParameters->Get(NVSDK_NGX_Parameter_Sharpness, &shapness) == NVSDK_NGX_Result_Success)
-        {
-            _sharpness = shapness;
-
-            params.enableSharpening = shapness > 0.0f;
-
-            if (params.enableSharpening)
-            {
-                if (shapness > 1.0f)
-                    params.sharpness = 1.0f;
-                else
-                    params.sharpness = shapness;
-            }
-        }
-    }
-
     if (DepthInverted())
     {
         params.cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
@@ -377,7 +442,7 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
     else if (Config::Instance()->FsrHorizontalFov.value_or_default() > 0.0f)
         params.cameraFovAngleVertical =
             2.0f * atan((tan(Config::Instance()->FsrHorizontalFov.value() * 0.0174532925199433f) * 0.5f) /
-                        (float) DisplayHeight() * (float) DisplayWidth());
+                        (float) TargetHeight() * (float) TargetWidth());
     else
         params.cameraFovAngleVertical = 1.0471975511966f;
 
@@ -398,6 +463,10 @@ bool FSR2FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* I
         return false;
     }
 
+    if (!RunPostPasses(InCmdBuffer, InParameters, fsrOutput, (NVSDK_NGX_Resource_VK*) paramVelocity,
+                       (NVSDK_NGX_Resource_VK*) paramOutput, useSS))
+        return true;
+
     _frameCount++;
 
     return true;
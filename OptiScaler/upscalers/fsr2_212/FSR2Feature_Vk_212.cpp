@@ -35,19 +35,61 @@ bool FSR2FeatureVk212::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
 
     _contextDesc.device = Fsr212::ffxGetDeviceVK212(Device);
 
-    if (Config::Instance()->ExtendedLimits.value_or_default())
+    if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
     {
-        _contextDesc.maxRenderSize.width = RenderWidth() < DisplayWidth() ? DisplayWidth() : RenderWidth();
-        _contextDesc.maxRenderSize.height = RenderHeight() < DisplayHeight() ? DisplayHeight() : RenderHeight();
+        float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or_default();
+
+        if (ssMulti < 0.5f)
+        {
+            ssMulti = 0.5f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+        else if (ssMulti > 3.0f)
+        {
+            ssMulti = 3.0f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+
+        _targetWidth = DisplayWidth() * ssMulti;
+        _targetHeight = DisplayHeight() * ssMulti;
     }
     else
     {
-        _contextDesc.maxRenderSize.width = DisplayWidth();
-        _contextDesc.maxRenderSize.height = DisplayHeight();
+        _targetWidth = DisplayWidth();
+        _targetHeight = DisplayHeight();
     }
 
-    _contextDesc.displaySize.width = DisplayWidth();
-    _contextDesc.displaySize.height = DisplayHeight();
+    // extended limits changes how resolution
+    if (Config::Instance()->ExtendedLimits.value_or_default() && RenderWidth() > DisplayWidth())
+    {
+        _contextDesc.maxRenderSize.width = RenderWidth();
+        _contextDesc.maxRenderSize.height = RenderHeight();
+
+        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+
+        // if output scaling active let it to handle downsampling
+        if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
+        {
+            _contextDesc.displaySize.width = _contextDesc.maxRenderSize.width;
+            _contextDesc.displaySize.height = _contextDesc.maxRenderSize.height;
+
+            // update target res
+            _targetWidth = _contextDesc.maxRenderSize.width;
+            _targetHeight = _contextDesc.maxRenderSize.height;
+        }
+        else
+        {
+            _contextDesc.displaySize.width = DisplayWidth();
+            _contextDesc.displaySize.height = DisplayHeight();
+        }
+    }
+    else
+    {
+        _contextDesc.maxRenderSize.width = TargetWidth() > DisplayWidth() ? TargetWidth() : DisplayWidth();
+        _contextDesc.maxRenderSize.height = TargetHeight() > DisplayHeight() ? TargetHeight() : DisplayHeight();
+        _contextDesc.displaySize.width = TargetWidth();
+        _contextDesc.displaySize.height = TargetHeight();
+    }
 
     _contextDesc.flags = 0;
 
@@ -98,7 +140,12 @@ bool FSR2FeatureVk212::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevi
     GIPA = InGIPA;
     GDPA = InGDPA;
 
-    return InitFSR2(InParameters);
+    if (!InitFSR2(InParameters))
+        return false;
+
+    CreatePostPasses(InPD, InDevice);
+
+    return true;
 }
 
 void transitionImageToShaderReadOnly(VkCommandBuffer commandBuffer, VkImage image, VkFormat format,
@@ -137,11 +184,36 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
     if (!IsInited())
         return false;
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
+    if (!OutputScaler->IsInit())
+        Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+
     Fsr212::FfxFsr2DispatchDescription params {};
 
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &params.jitterOffset.x);
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &params.jitterOffset.y);
 
+    if (Config::Instance()->OverrideSharpness.value_or_default())
+        _sharpness = Config::Instance()->Sharpness.value_or_default();
+    else
+        _sharpness = GetSharpness(InParameters);
+
+    if (Config::Instance()->RcasEnabled.value_or_default())
+    {
+        params.enableSharpening = false;
+        params.sharpness = 0.0f;
+    }
+    else
+    {
+        if (_sharpness > 1.0f)
+            _sharpness = 1.0f;
+
+        params.enableSharpening = _sharpness > 0.0f;
+        params.sharpness = _sharpness;
+    }
+
     unsigned int reset;
     InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
     params.reset = (reset == 1);
@@ -150,6 +222,8 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
+    bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+
     params.commandList = Fsr212::ffxGetCommandListVK212(InCmdBuffer);
 
     void* paramColor;
@@ -205,6 +279,8 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
     void* paramOutput;
     InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
 
+    NVSDK_NGX_Resource_VK* fsrOutput = nullptr;
+
     if (paramOutput)
     {
         LOG_DEBUG("Output exist..");
@@ -214,12 +290,13 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
         //                                 ((NVSDK_NGX_Resource_VK*)paramOutput)->Resource.ImageViewInfo.Format,
         //                                 VK_ACCESS_SHADER_WRITE_BIT);
 
+        fsrOutput = PostPassesOutput(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramOutput, useSS,
+                                     Config::Instance()->RcasEnabled.value_or_default());
+
         params.output = Fsr212::ffxGetTextureResourceVK212(
-            &_context, ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Image,
-            ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.ImageView,
-            ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Width,
-            ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Height,
-            ((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Format, (wchar_t*) L"FSR2_Output",
+            &_context, fsrOutput->Resource.ImageViewInfo.Image, fsrOutput->Resource.ImageViewInfo.ImageView,
+            fsrOutput->Resource.ImageViewInfo.Width, fsrOutput->Resource.ImageViewInfo.Height,
+            fsrOutput->Resource.ImageViewInfo.Format, (wchar_t*) L"FSR2_Output",
             Fsr212::FFX_RESOURCE_STATE_UNORDERED_ACCESS);
     }
     else
@@ -334,15 +411,27 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
                         (wchar_t*) L"FSR2_Transparency", Fsr212::FFX_RESOURCE_STATE_COMPUTE_READ);
                 }
 
-                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f)
+                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f && Bias->IsInit() &&
+                    Bias->CreateBufferResource(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramReactiveMask2) &&
+                    Bias->CanRender())
                 {
-                    params.reactive = Fsr212::ffxGetTextureResourceVK212(
-                        &_context, ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Image,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.ImageView,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Width,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Height,
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Format,
-                        (wchar_t*) L"FSR2_Reactive", Fsr212::FFX_RESOURCE_STATE_COMPUTE_READ);
+                    if (Bias->Dispatch(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramReactiveMask2,
+                                       Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->Buffer()))
+                    {
+                        // Bias buffer stays in general layout
+                        auto biasBuffer = Bias->Buffer();
+                        params.reactive = Fsr212::ffxGetTextureResourceVK212(
+                            &_context, biasBuffer->Resource.ImageViewInfo.Image,
+                            biasBuffer->Resource.ImageViewInfo.ImageView, biasBuffer->Resource.ImageViewInfo.Width,
+                            biasBuffer->Resource.ImageViewInfo.Height, biasBuffer->Resource.ImageViewInfo.Format,
+                            (wchar_t*) L"FSR2_Reactive", Fsr212::FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+                    }
+                }
+                else
+                {
+                    LOG_DEBUG("Skipping reactive mask, Bias: {0}, Bias Init: {1}, Bias CanRender: {2}",
+                              Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->IsInit(),
+                              Bias->CanRender());
                 }
             }
             else
@@ -379,30 +468,6 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
         params.motionVectorScale.y = MVScaleY;
     }
 
-    if (Config::Instance()->OverrideSharpness.value_or_default())
-    {
-        params.enableSharpening = Config::Instance()->Sharpness.value_or_default() > 0.0f;
-        params.sharpness = Config::Instance()->Sharpness.value_or_default();
-    }
-    else
-    {
-        float shapness = 0.0f;
-        if (InParameters->Get(NVSDK_NGX_Parameter_Sharpness, &shapness) == NVSDK_NGX_Result_Success)
-        {
-            _sharpness = shapness;
-
-            params.enableSharpening = shapness > 0.0f;
-
-            if (params.enableSharpening)
-            {
-                if (shapness > 1.0f)
-                    params.sharpness = 1.0f;
-                else
-                    params.sharpness = shapness;
-            }
-        }
-    }
-
     if (DepthInverted())
     {
         params.cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
@@ -419,7 +484,7 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
     else if (Config::Instance()->FsrHorizontalFov.value_or_default() > 0.0f)
         params.cameraFovAngleVertical =
             2.0f * atan((tan(Config::Instance()->FsrHorizontalFov.value() * 0.0174532925199433f) * 0.5f) /
-                        (float) DisplayHeight() * (float) DisplayWidth());
+                        (float) TargetHeight() * (float) TargetWidth());
     else
         params.cameraFovAngleVertical = 1.0471975511966f;
 
@@ -440,6 +505,10 @@ bool FSR2FeatureVk212::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter
         return false;
     }
 
+    if (!RunPostPasses(InCmdBuffer, InParameters, fsrOutput, (NVSDK_NGX_Resource_VK*) paramVelocity,
+                       (NVSDK_NGX_Resource_VK*) paramOutput, useSS))
+        return true;
+
     _frameCount++;
 
     return true;
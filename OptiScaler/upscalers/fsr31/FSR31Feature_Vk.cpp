@@ -192,19 +192,61 @@ bool FSR31FeatureVk::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
         LOG_INFO("contextDesc.initFlags (NonLinearColorSpace) {0:b}", _contextDesc.flags);
     }
 
-    if (Config::Instance()->ExtendedLimits.value_or_default())
+    if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
     {
-        _contextDesc.maxRenderSize.width = RenderWidth() < DisplayWidth() ? DisplayWidth() : RenderWidth();
-        _contextDesc.maxRenderSize.height = RenderHeight() < DisplayHeight() ? DisplayHeight() : RenderHeight();
+        float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or_default();
+
+        if (ssMulti < 0.5f)
+        {
+            ssMulti = 0.5f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+        else if (ssMulti > 3.0f)
+        {
+            ssMulti = 3.0f;
+            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+        }
+
+        _targetWidth = DisplayWidth() * ssMulti;
+        _targetHeight = DisplayHeight() * ssMulti;
     }
     else
     {
-        _contextDesc.maxRenderSize.width = DisplayWidth();
-        _contextDesc.maxRenderSize.height = DisplayHeight();
+        _targetWidth = DisplayWidth();
+        _targetHeight = DisplayHeight();
     }
 
-    _contextDesc.maxUpscaleSize.width = DisplayWidth();
-    _contextDesc.maxUpscaleSize.height = DisplayHeight();
+    // extended limits changes how resolution
+    if (Config::Instance()->ExtendedLimits.value_or_default() && RenderWidth() > DisplayWidth())
+    {
+        _contextDesc.maxRenderSize.width = RenderWidth();
+        _contextDesc.maxRenderSize.height = RenderHeight();
+
+        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+
+        // if output scaling active let it to handle downsampling
+        if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
+        {
+            _contextDesc.maxUpscaleSize.width = _contextDesc.maxRenderSize.width;
+            _contextDesc.maxUpscaleSize.height = _contextDesc.maxRenderSize.height;
+
+            // update target res
+            _targetWidth = _contextDesc.maxRenderSize.width;
+            _targetHeight = _contextDesc.maxRenderSize.height;
+        }
+        else
+        {
+            _contextDesc.maxUpscaleSize.width = DisplayWidth();
+            _contextDesc.maxUpscaleSize.height = DisplayHeight();
+        }
+    }
+    else
+    {
+        _contextDesc.maxRenderSize.width = TargetWidth() > DisplayWidth() ? TargetWidth() : DisplayWidth();
+        _contextDesc.maxRenderSize.height = TargetHeight() > DisplayHeight() ? TargetHeight() : DisplayHeight();
+        _contextDesc.maxUpscaleSize.width = TargetWidth();
+        _contextDesc.maxUpscaleSize.height = TargetHeight();
+    }
 
     ffxCreateBackendVKDesc backendDesc = { 0 };
     backendDesc.header.type = FFX_API_CREATE_CONTEXT_DESC_TYPE_BACKEND_VK;
@@ -262,7 +304,12 @@ bool FSR31FeatureVk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
     GIPA = InGIPA;
     GDPA = InGDPA;
 
-    return InitFSR3(InParameters);
+    if (!InitFSR3(InParameters))
+        return false;
+
+    CreatePostPasses(InPD, InDevice);
+
+    return true;
 }
 
 bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* InParameters)
@@ -272,6 +319,12 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     if (!IsInited())
         return false;
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled.set_volatile_value(false);
+
+    if (!OutputScaler->IsInit())
+        Config::Instance()->OutputScalingEnabled.set_volatile_value(false);
+
     struct ffxDispatchDescUpscale params = { 0 };
     params.header.type = FFX_API_DISPATCH_DESC_TYPE_UPSCALE;
 
@@ -286,6 +339,25 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &params.jitterOffset.x);
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &params.jitterOffset.y);
 
+    if (Config::Instance()->OverrideSharpness.value_or_default())
+        _sharpness = Config::Instance()->Sharpness.value_or_default();
+    else
+        _sharpness = GetSharpness(InParameters);
+
+    if (Config::Instance()->RcasEnabled.value_or_default())
+    {
+        params.enableSharpening = false;
+        params.sharpness = 0.0f;
+    }
+    else
+    {
+        if (_sharpness > 1.0f)
+            _sharpness = 1.0f;
+
+        params.enableSharpening = _sharpness > 0.0f;
+        params.sharpness = _sharpness;
+    }
+
     unsigned int reset;
     InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
     params.reset = (reset == 1);
@@ -294,6 +366,8 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
+    bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+
     params.commandList = InCmdBuffer;
 
     void* paramColor;
@@ -335,14 +409,18 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     void* paramOutput;
     InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
 
+    NVSDK_NGX_Resource_VK* fsrOutput = nullptr;
+
     if (paramOutput)
     {
         LOG_DEBUG("Output exist..");
 
-        params.output =
-            ffxApiGetResourceVK(((NVSDK_NGX_Resource_VK*) paramOutput)->Resource.ImageViewInfo.Image,
-                                ffxApiGetImageResourceDescriptionVKLocal((NVSDK_NGX_Resource_VK*) paramOutput),
-                                FFX_API_RESOURCE_STATE_UNORDERED_ACCESS);
+        fsrOutput = PostPassesOutput(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramOutput, useSS,
+                                     Config::Instance()->RcasEnabled.value_or_default());
+
+        params.output = ffxApiGetResourceVK(fsrOutput->Resource.ImageViewInfo.Image,
+                                            ffxApiGetImageResourceDescriptionVKLocal(fsrOutput),
+                                            FFX_API_RESOURCE_STATE_UNORDERED_ACCESS);
     }
     else
     {
@@ -440,12 +518,24 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
 
                 LOG_DEBUG("Bias mask exist..");
 
-                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f)
+                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f && Bias->IsInit() &&
+                    Bias->CreateBufferResource(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramReactiveMask2) &&
+                    Bias->CanRender())
                 {
-                    params.reactive = ffxApiGetResourceVK(
-                        ((NVSDK_NGX_Resource_VK*) paramReactiveMask2)->Resource.ImageViewInfo.Image,
-                        ffxApiGetImageResourceDescriptionVKLocal((NVSDK_NGX_Resource_VK*) paramReactiveMask2),
-                        FFX_API_RESOURCE_STATE_COMPUTE_READ);
+                    if (Bias->Dispatch(InCmdBuffer, (NVSDK_NGX_Resource_VK*) paramReactiveMask2,
+                                       Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->Buffer()))
+                    {
+                        // Bias buffer stays in general layout
+                        params.reactive = ffxApiGetResourceVK(Bias->Buffer()->Resource.ImageViewInfo.Image,
+                                                              ffxApiGetImageResourceDescriptionVKLocal(Bias->Buffer()),
+                                                              FFX_API_RESOURCE_STATE_UNORDERED_ACCESS);
+                    }
+                }
+                else
+                {
+                    LOG_DEBUG("Skipping reactive mask, Bias: {0}, Bias Init: {1}, Bias CanRender: {2}",
+                              Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->IsInit(),
+                              Bias->CanRender());
                 }
             }
             else
@@ -482,30 +572,6 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         params.motionVectorScale.y = MVScaleY;
     }
 
-    if (Config::Instance()->OverrideSharpness.value_or_default())
-    {
-        params.enableSharpening = Config::Instance()->Sharpness.value_or_default() > 0.0f;
-        params.sharpness = Config::Instance()->Sharpness.value_or_default();
-    }
-    else
-    {
-        float shapness = 0.0f;
-        if (InParameters->Get(NVSDK_NGX_Parameter_Sharpness, &shapness) == NVSDK_NGX_Result_Success)
-        {
-            _sharpness = shapness;
-
-            params.enableSharpening = shapness > 0.0f;
-
-            if (params.enableSharpening)
-            {
-                if (shapness > 1.0f)
-                    params.sharpness = 1.0f;
-                else
-                    params.sharpness = shapness;
-            }
-        }
-    }
-
     if (DepthInverted())
     {
         params.cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
@@ -522,7 +588,7 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     else if (Config::Instance()->FsrHorizontalFov.value_or_default() > 0.0f)
         params.cameraFovAngleVertical =
             2.0f * atan((tan(Config::Instance()->FsrHorizontalFov.value() * 0.0174532925199433f) * 0.5f) /
-                        (float) DisplayHeight() * (float) DisplayWidth());
+                        (float) TargetHeight() * (float) TargetWidth());
     else
         params.cameraFovAngleVertical = 1.0471975511966f;
 
@@ -602,6 +668,9 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         }
     }
 
+    params.upscaleSize.width = TargetWidth();
+    params.upscaleSize.height = TargetHeight();
+
     if (InParameters->Get("FSR.upscaleSize.width", &params.upscaleSize.width) == NVSDK_NGX_Result_Success &&
         Config::Instance()->OutputScalingEnabled.value_or_default())
         params.upscaleSize.width *= Config::Instance()->OutputScalingMultiplier.value_or_default();
@@ -619,6 +688,10 @@ bool FSR31FeatureVk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         return false;
     }
 
+    if (!RunPostPasses(InCmdBuffer, InParameters, fsrOutput, (NVSDK_NGX_Resource_VK*) paramVelocity,
+                       (NVSDK_NGX_Resource_VK*) paramOutput, useSS))
+        return true;
+
     _frameCount++;
 
     return true;
@@ -318,19 +318,24 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
             break;
         }
 
+        auto useRcas = Config::Instance()->RcasEnabled.value_or(true) &&
+                       (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) &&
+                                              Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f)) &&
+                       RCAS->CanRender();
+
+        // RCAS & output scaling might run on async compute queue
+        auto postList = BeginPostPasses(cmdList, useRcas, useSS);
+
         // apply rcas
-        if (Config::Instance()->RcasEnabled.value_or(true) &&
-            (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) &&
-                                   Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f)) &&
-            RCAS->CanRender())
+        if (useRcas)
         {
             LOG_DEBUG("Apply RCAS");
 
             if (params.pOutputTexture != RCAS->Buffer())
-                ResourceBarrier(cmdList, params.pOutputTexture, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                ResourceBarrier(postList, params.pOutputTexture, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
                                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-            RCAS->SetBufferState(cmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            RCAS->SetBufferState(postList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
             RcasConstants rcasConstants {};
             rcasConstants.Sharpness = _sharpness;
@@ -344,7 +349,7 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
 
             if (useSS)
             {
-                if (!RCAS->Dispatch(State::Instance().currentD3D12Device, cmdList, params.pOutputTexture,
+                if (!RCAS->Dispatch(State::Instance().currentD3D12Device, postList, params.pOutputTexture,
                                     params.pVelocityTexture, rcasConstants, OutputScaler->Buffer()))
                 {
                     Config::Instance()->RcasEnabled = false;
@@ -353,7 +358,7 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
             }
             else
             {
-                if (!RCAS->Dispatch(State::Instance().currentD3D12Device, cmdList, params.pOutputTexture,
+                if (!RCAS->Dispatch(State::Instance().currentD3D12Device, postList, params.pOutputTexture,
                                     params.pVelocityTexture, rcasConstants, dx11Out.Dx12Resource))
                 {
                     Config::Instance()->RcasEnabled = false;
@@ -365,9 +370,9 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
         if (useSS)
         {
             LOG_DEBUG("scaling output...");
-            OutputScaler->SetBufferState(cmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            OutputScaler->SetBufferState(postList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-            if (!OutputScaler->Dispatch(State::Instance().currentD3D12Device, cmdList, OutputScaler->Buffer(),
+            if (!OutputScaler->Dispatch(State::Instance().currentD3D12Device, postList, OutputScaler->Buffer(),
                                         dx11Out.Dx12Resource))
             {
                 Config::Instance()->OutputScalingEnabled = false;
@@ -379,10 +384,7 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
 
     } while (false);
 
-    cmdList->Close();
-    ID3D12CommandList* ppCommandLists[] = { cmdList };
-    Dx12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
-    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
+    SubmitCommandLists(cmdList);
 
     auto evalResult = false;
 
@@ -19,9 +19,12 @@ bool XeSSFeatureDx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* In
         if (!Config::Instance()->OverlayMenu.value_or(true) && (Imgui == nullptr || Imgui.get() == nullptr))
             Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
-        OutputScaler = std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
-        RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
-        Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+        OutputScaler =
+            ShaderPool_Dx12::AcquireOutputScaler("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+        RcasScaler =
+            ShaderPool_Dx12::AcquireRcasScaler("RCAS + Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+        RCAS = ShaderPool_Dx12::AcquireRcas("RCAS", InDevice);
+        Bias = ShaderPool_Dx12::AcquireBias("Bias", InDevice);
 
         return true;
     }
@@ -85,6 +88,11 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
     bool useSS = Config::Instance()->OutputScalingEnabled.value_or(false) && LowResMV();
 
+    // RCAS is applied while scaling the output, skips RCAS buffer and its pass
+    bool fuseRcas = useSS && RcasScaler->IsInit() && Config::Instance()->RcasEnabled.value_or(true) &&
+                    (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) &&
+                                           Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f));
+
     LOG_DEBUG("Input Resolution: {0}x{1}", params.inputWidth, params.inputHeight);
 
     ID3D12Resource* paramColor;
@@ -177,7 +185,7 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         else
             params.pOutputTexture = paramOutput;
 
-        if (Config::Instance()->RcasEnabled.value_or(true) &&
+        if (!fuseRcas && Config::Instance()->RcasEnabled.value_or(true) &&
             (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) &&
                                    Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f)) &&
             RCAS->IsInit() &&
@@ -354,8 +362,19 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         return false;
     }
 
+    RcasConstants rcasConstants {};
+
+    rcasConstants.Sharpness = _sharpness;
+    rcasConstants.DisplayWidth = TargetWidth();
+    rcasConstants.DisplayHeight = TargetHeight();
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+    InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+    rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+    rcasConstants.RenderHeight = RenderHeight();
+    rcasConstants.RenderWidth = RenderWidth();
+
     // Apply RCAS
-    if (Config::Instance()->RcasEnabled.value_or(true) &&
+    if (!fuseRcas && Config::Instance()->RcasEnabled.value_or(true) &&
         (_sharpness > 0.0f || (Config::Instance()->MotionSharpnessEnabled.value_or(false) &&
                                Config::Instance()->MotionSharpness.value_or(0.4) > 0.0f)) &&
         RCAS->CanRender())
@@ -366,17 +385,6 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
         RCAS->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-        RcasConstants rcasConstants {};
-
-        rcasConstants.Sharpness = _sharpness;
-        rcasConstants.DisplayWidth = TargetWidth();
-        rcasConstants.DisplayHeight = TargetHeight();
-        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
-        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
-        rcasConstants.DisplaySizeMV = !(GetFeatureFlags() & NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
-        rcasConstants.RenderHeight = RenderHeight();
-        rcasConstants.RenderWidth = RenderWidth();
-
         if (useSS)
         {
             if (!RCAS->Dispatch(Device, InCommandList, params.pOutputTexture, params.pVelocityTexture, rcasConstants,
@@ -402,7 +410,17 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         LOG_DEBUG("scaling output...");
         OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
-        if (!OutputScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramOutput))
+        if (fuseRcas)
+        {
+            if (!RcasScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), params.pVelocityTexture,
+                                      rcasConstants, paramOutput))
+            {
+                Config::Instance()->OutputScalingFuseRcas.set_volatile_value(false);
+                State::Instance().changeBackend[_handle->Id] = true;
+                return true;
+            }
+        }
+        else if (!OutputScaler->Dispatch(Device, InCommandList, OutputScaler->Buffer(), paramOutput))
         {
             Config::Instance()->OutputScalingEnabled = false;
             State::Instance().changeBackend[_handle->Id] = true;
@@ -382,6 +382,8 @@ bool XeSSFeature_Vk::Init(VkInstance InInstance, VkPhysicalDevice InPD, VkDevice
         return false;
     }
 
+    CreatePostPasses(InPD, InDevice);
+
     SetInit(true);
 
     return true;
@@ -397,6 +399,12 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         return false;
     }
 
+    if (!RCAS->IsInit())
+        Config::Instance()->RcasEnabled = false;
+
+    if (!OutputScaler->IsInit())
+        Config::Instance()->OutputScalingEnabled = false;
+
     if (State::Instance().xessDebug)
     {
         LOG_ERROR("xessDebug");
@@ -464,11 +472,14 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
     }
 
     NVSDK_NGX_Resource_VK* paramOutput = nullptr;
+    NVSDK_NGX_Resource_VK* xessOutput = nullptr;
     if (InParameters->Get(NVSDK_NGX_Parameter_Output, (void**) &paramOutput) == NVSDK_NGX_Result_Success &&
         paramOutput != nullptr)
     {
         LOG_DEBUG("Output exist..");
-        params.outputTexture = NV_to_XeSS(paramOutput);
+        xessOutput = PostPassesOutput(InCmdBuffer, paramOutput, useSS,
+                                      Config::Instance()->RcasEnabled.value_or_default());
+        params.outputTexture = NV_to_XeSS(xessOutput);
     }
     else
     {
@@ -549,6 +560,16 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
                 }
 
                 params.responsivePixelMaskTexture = NV_to_XeSS(paramReactiveMask);
+
+                if (Config::Instance()->DlssReactiveMaskBias.value_or_default() > 0.0f && Bias->IsInit() &&
+                    Bias->CreateBufferResource(InCmdBuffer, paramReactiveMask) && Bias->CanRender())
+                {
+                    if (Bias->Dispatch(InCmdBuffer, paramReactiveMask,
+                                       Config::Instance()->DlssReactiveMaskBias.value_or_default(), Bias->Buffer()))
+                    {
+                        params.responsivePixelMaskTexture = NV_to_XeSS(Bias->Buffer());
+                    }
+                }
             }
         }
         else if ((_xessInitFlags & XESS_INIT_FLAG_RESPONSIVE_PIXEL_MASK) > 0)
@@ -606,6 +627,9 @@ bool XeSSFeature_Vk::Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter*
         return false;
     }
 
+    if (!RunPostPasses(InCmdBuffer, InParameters, xessOutput, paramVelocity, paramOutput, useSS))
+        return true;
+
     _frameCount++;
 
     return true;
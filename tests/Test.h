@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Minimal test harness, every test executable links TestMain.cpp
+namespace Test
+{
+struct Case
+{
+    const char* name;
+    void (*func)();
+};
+
+inline std::vector<Case>& Cases()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+
+inline int& Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline void Fail(const char* file, int line, const char* expr)
+{
+    std::printf("%s:%d: check failed: %s\n", file, line, expr);
+    Failures()++;
+}
+
+struct Register
+{
+    Register(const char* name, void (*func)()) { Cases().push_back({ name, func }); }
+};
+} // namespace Test
+
+#define TEST_CASE(name)                                                                                                \
+    static void name();                                                                                                \
+    static Test::Register name##_register(#name, name);                                                                \
+    static void name()
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+            Test::Fail(__FILE__, __LINE__, #expr);                                                                     \
+    } while (0)
+
+#define CHECK_NEAR(a, b, eps) CHECK(std::fabs((double) (a) - (double) (b)) <= (double) (eps))
@@ -0,0 +1,13 @@
+#include "Test.h"
+
+int main()
+{
+    for (auto& testCase : Test::Cases())
+    {
+        auto before = Test::Failures();
+        testCase.func();
+        std::printf("%s %s\n", Test::Failures() == before ? "PASS" : "FAIL", testCase.name);
+    }
+
+    return Test::Failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include <Test.h>
+
+#include <framegen/FGFrameSlots.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST_CASE(TransitionNeedsRequiredAndNoExcluded)
+{
+    FGFrameSlots slots;
+    slots.Begin(1);
+
+    CHECK(!slots.Transition(1, FGSlot_Prepared, 0, FGSlot_Executed));
+    CHECK(slots.Set(1, FGSlot_Prepared));
+    CHECK(slots.Transition(1, FGSlot_Prepared, FGSlot_Executed, FGSlot_Executed));
+    CHECK(!slots.Transition(1, FGSlot_Prepared, FGSlot_Executed, FGSlot_Executed));
+    CHECK(slots.Has(1, FGSlot_Prepared | FGSlot_Executed));
+
+    CHECK(slots.Clear(1, FGSlot_Executed));
+    CHECK(!slots.Has(1, FGSlot_Executed));
+    CHECK(slots.Has(1, FGSlot_Prepared));
+}
+
+TEST_CASE(OldFrameCantTouchReusedSlot)
+{
+    FGFrameSlots slots;
+    slots.Begin(2);
+    slots.Begin(2 + FGFrameSlots::SlotCount);
+
+    CHECK(!slots.Set(2, FGSlot_InputsReady));
+    CHECK(!slots.Has(2, FGSlot_None));
+    CHECK(!slots.Has(2 + FGFrameSlots::SlotCount, FGSlot_InputsReady));
+    CHECK(slots.Has(2 + FGFrameSlots::SlotCount, FGSlot_None));
+}
+
+TEST_CASE(ResetDropsAllFrames)
+{
+    FGFrameSlots slots;
+
+    for (uint64_t i = 1; i <= FGFrameSlots::SlotCount; i++)
+    {
+        slots.Begin(i);
+        slots.Set(i, FGSlot_InputsReady);
+    }
+
+    slots.Reset();
+
+    for (uint64_t i = 1; i <= FGFrameSlots::SlotCount; i++)
+        CHECK(!slots.Has(i, FGSlot_None));
+}
+
+// Upscale thread publishes frames with a payload, present threads race to execute them and a
+// stale thread keeps updating old frames. Threads sleep randomly to shuffle the interleavings.
+TEST_CASE(StressRandomTiming)
+{
+    constexpr uint64_t Frames = 20000;
+    constexpr int Consumers = 3;
+
+    FGFrameSlots slots;
+    std::atomic<uint64_t> payload[FGFrameSlots::SlotCount] = {};
+    std::atomic<uint64_t> currentFrame = 0;
+    std::atomic<bool> done = false;
+
+    std::vector<std::atomic<int>> executed(Frames + 1);
+    std::atomic<int> badPayload = 0;
+    std::atomic<int> staleHudless = 0;
+
+    auto randomPause = [](std::mt19937& rng)
+    {
+        auto r = rng() % 64;
+
+        if (r == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(rng() % 50));
+        else if (r < 16)
+            std::this_thread::yield();
+    };
+
+    std::thread producer(
+        [&]
+        {
+            std::mt19937 rng(1);
+
+            for (uint64_t frame = 1; frame <= Frames; frame++)
+            {
+                slots.Begin(frame);
+                currentFrame.store(frame, std::memory_order_release);
+                randomPause(rng);
+
+                payload[frame % FGFrameSlots::SlotCount].store(frame, std::memory_order_release);
+
+                // Only even frames have hudless
+                if (frame % 2 == 0)
+                    slots.Set(frame, FGSlot_HudlessReady);
+
+                slots.Set(frame, FGSlot_InputsReady);
+                randomPause(rng);
+            }
+
+            done = true;
+        });
+
+    std::vector<std::thread> consumers;
+
+    for (int c = 0; c < Consumers; c++)
+    {
+        consumers.emplace_back(
+            [&, c]
+            {
+                std::mt19937 rng(100 + c);
+
+                while (!done)
+                {
+                    auto frame = currentFrame.load(std::memory_order_acquire);
+                    randomPause(rng);
+
+                    if (!slots.Has(frame, FGSlot_InputsReady))
+                        continue;
+
+                    // Payload written before the flag must be visible, unless the slot moved on
+                    auto value = payload[frame % FGFrameSlots::SlotCount].load(std::memory_order_acquire);
+
+                    if (value != frame && slots.Has(frame, FGSlot_None))
+                        badPayload++;
+
+                    if (frame % 2 != 0 && slots.Has(frame, FGSlot_HudlessReady))
+                        staleHudless++;
+
+                    if (slots.Transition(frame, FGSlot_InputsReady, FGSlot_Executed, FGSlot_Executed))
+                        executed[frame]++;
+                }
+            });
+    }
+
+    std::thread stale(
+        [&]
+        {
+            std::mt19937 rng(7);
+
+            while (!done)
+            {
+                auto frame = currentFrame.load(std::memory_order_acquire);
+
+                if (frame > FGFrameSlots::SlotCount)
+                    slots.Set(frame - FGFrameSlots::SlotCount, FGSlot_HudlessReady | FGSlot_InputsReady);
+
+                randomPause(rng);
+            }
+        });
+
+    producer.join();
+    stale.join();
+
+    for (auto& consumer : consumers)
+        consumer.join();
+
+    int executedFrames = 0;
+    bool executedTwice = false;
+
+    for (auto& count : executed)
+    {
+        executedTwice |= count > 1;
+        executedFrames += count;
+    }
+
+    CHECK(!executedTwice);
+    CHECK(executedFrames > 0);
+    CHECK(badPayload == 0);
+    CHECK(staleHudless == 0);
+}
@@ -0,0 +1,185 @@
+#include <Test.h>
+
+#include <framegen/FGFrameState.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Drives the state machine the way FG backends do, without any graphics API
+class MockBackend : public FGFrameState
+{
+  public:
+    std::atomic<int> dispatches = 0;
+    std::atomic<int> executions = 0;
+
+    // Upscaler hook, dispatches when inputs are ready
+    bool Dispatch()
+    {
+        auto frame = FrameCount();
+
+        if (IsPaused() || !UpscalerInputsReady() || !ClaimDispatch(frame))
+            return false;
+
+        dispatches++;
+        _slots.Set(frame, FGSlot_Prepared);
+        return true;
+    }
+
+    // Present hook, executes prepared command list
+    bool Present()
+    {
+        if (!WaitingExecution() || !ClaimExecution(FrameCount()))
+            return false;
+
+        executions++;
+        return true;
+    }
+
+    // Update arriving from a thread still working on an older frame
+    void LateInputs(uint64_t frame) { _slots.Set(frame, FGSlot_InputsReady); }
+};
+
+TEST_CASE(IndexWrapsSlotCount)
+{
+    MockBackend fg;
+
+    for (uint64_t i = 1; i <= FGFrameSlots::SlotCount * 3; i++)
+    {
+        CHECK(fg.StartNewFrame() == i);
+        CHECK(fg.GetIndex() == (int) (i % FGFrameSlots::SlotCount));
+    }
+}
+
+TEST_CASE(ReadinessBelongsToFrame)
+{
+    MockBackend fg;
+    fg.StartNewFrame();
+
+    CHECK(!fg.UpscalerInputsReady());
+    CHECK(!fg.HudlessReady());
+
+    fg.SetUpscaleInputsReady();
+    fg.SetHudlessReady();
+    CHECK(fg.UpscalerInputsReady());
+    CHECK(fg.HudlessReady());
+    CHECK(!fg.UsingHudless());
+
+    fg.StartNewFrame();
+    CHECK(!fg.UpscalerInputsReady());
+    CHECK(!fg.HudlessReady());
+}
+
+TEST_CASE(LateUpdateDoesNotMarkReusedSlot)
+{
+    MockBackend fg;
+    auto old = fg.StartNewFrame();
+
+    for (uint32_t i = 0; i < FGFrameSlots::SlotCount; i++)
+        fg.StartNewFrame();
+
+    CHECK(fg.GetIndex() == (int) (old % FGFrameSlots::SlotCount));
+
+    fg.LateInputs(old);
+    CHECK(!fg.UpscalerInputsReady());
+}
+
+TEST_CASE(DispatchAndExecuteOnce)
+{
+    MockBackend fg;
+    fg.StartNewFrame();
+
+    CHECK(!fg.Dispatch());
+    CHECK(!fg.Present());
+
+    fg.SetUpscaleInputsReady();
+    CHECK(fg.Dispatch());
+    CHECK(fg.IsDispatched());
+    CHECK(fg.LastDispatchedFrame() == 1);
+    CHECK(!fg.Dispatch());
+
+    CHECK(fg.WaitingExecution());
+    CHECK(fg.Present());
+    CHECK(!fg.WaitingExecution());
+    CHECK(!fg.Present());
+
+    CHECK(fg.dispatches == 1);
+    CHECK(fg.executions == 1);
+}
+
+TEST_CASE(RacingThreadsClaimOnce)
+{
+    constexpr int Frames = 2000;
+    constexpr int Threads = 4;
+
+    MockBackend fg;
+
+    for (int i = 0; i < Frames; i++)
+    {
+        fg.StartNewFrame();
+        fg.SetUpscaleInputsReady();
+
+        std::atomic<bool> go = false;
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < Threads; t++)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    while (!go)
+                        std::this_thread::yield();
+
+                    fg.Dispatch();
+                    fg.Present();
+                });
+        }
+
+        go = true;
+
+        for (auto& thread : threads)
+            thread.join();
+
+        // Dispatch might finish after all threads tried to present
+        fg.Present();
+    }
+
+    CHECK(fg.dispatches == Frames);
+    CHECK(fg.executions == Frames);
+}
+
+TEST_CASE(PausedUntilTarget)
+{
+    MockBackend fg;
+    fg.ResetCounters();
+    fg.UpdateTarget();
+
+    CHECK(fg.TargetFrame() == FGFrameState::PauseFrames);
+
+    for (uint64_t i = 1; i <= FGFrameState::PauseFrames; i++)
+    {
+        fg.StartNewFrame();
+        fg.SetUpscaleInputsReady();
+        CHECK(fg.IsPaused());
+        CHECK(!fg.Dispatch());
+    }
+
+    fg.StartNewFrame();
+    fg.SetUpscaleInputsReady();
+    CHECK(!fg.IsPaused());
+    CHECK(fg.Dispatch());
+}
+
+TEST_CASE(ResetClearsSlots)
+{
+    MockBackend fg;
+    fg.StartNewFrame();
+    fg.SetUpscaleInputsReady();
+    fg.Dispatch();
+
+    fg.ResetCounters();
+    CHECK(fg.FrameCount() == 0);
+    CHECK(fg.TargetFrame() == 0);
+    CHECK(!fg.IsDispatched());
+    CHECK(!fg.UpscalerInputsReady());
+}
@@ -0,0 +1,200 @@
+#include <Test.h>
+
+#include <framegen/FGPacing_Common.h>
+
+#include <cmath>
+#include <random>
+
+// Presents of one window, real frame takes frameMs and generated frame is shown bias ms late
+static void AddTrace(PacingAnalyzer& analyzer, double& time, uint32_t presents, double frameMs, double bias,
+                     std::mt19937* rng = nullptr, double noiseMs = 0.0)
+{
+    std::uniform_real_distribution<double> noise(-noiseMs, noiseMs);
+
+    for (uint32_t i = 0; i < presents; i++)
+    {
+        auto generated = (i % 2) == 0;
+        auto interval = frameMs * 0.5 + (generated ? bias : -bias);
+
+        if (rng != nullptr)
+            interval += noise(*rng);
+
+        time += interval;
+        analyzer.AddPresent(time, generated);
+    }
+}
+
+TEST_CASE(EvenPacing)
+{
+    PacingAnalyzer analyzer(100);
+    PacingStats stats {};
+    double time = 1000.0;
+
+    AddTrace(analyzer, time, 101, 20.0, 0.0);
+
+    CHECK(analyzer.Analyze(&stats));
+    CHECK(stats.presents == 100);
+    CHECK_NEAR(stats.interval, 10.0, 1e-6);
+    CHECK_NEAR(stats.jitter, 0.0, 1e-4);
+    CHECK_NEAR(stats.error, 0.0, 1e-6);
+    CHECK_NEAR(stats.imbalance, 0.0, 1e-6);
+    CHECK(stats.displayInterval == 0.0);
+}
+
+TEST_CASE(WindowStartsOverAfterAnalyze)
+{
+    PacingAnalyzer analyzer(100);
+    PacingStats stats {};
+    double time = 1000.0;
+
+    CHECK(!analyzer.Analyze(nullptr));
+
+    AddTrace(analyzer, time, 50, 20.0, 0.0);
+    CHECK(!analyzer.Analyze(&stats));
+
+    AddTrace(analyzer, time, 51, 20.0, 0.0);
+    CHECK(analyzer.Analyze(&stats));
+    CHECK(!analyzer.Analyze(&stats));
+}
+
+TEST_CASE(UnevenHalvesAreImbalance)
+{
+    PacingAnalyzer analyzer(100);
+    PacingStats stats {};
+    double time = 1000.0;
+
+    // 12 ms to generated, 8 ms to real
+    AddTrace(analyzer, time, 101, 20.0, 2.0);
+
+    CHECK(analyzer.Analyze(&stats));
+    CHECK_NEAR(stats.interval, 10.0, 1e-6);
+    CHECK_NEAR(stats.jitter, 2.0, 1e-4);
+    CHECK_NEAR(stats.error, 0.2, 1e-6);
+    CHECK_NEAR(stats.imbalance, 0.4, 1e-6);
+}
+
+TEST_CASE(HitchesAreDropped)
+{
+    PacingAnalyzer analyzer(100);
+    PacingStats stats {};
+    double time = 1000.0;
+
+    AddTrace(analyzer, time, 60, 20.0, 0.0);
+    time += 500.0; // loading screen
+    AddTrace(analyzer, time, 60, 20.0, 0.0);
+
+    CHECK(analyzer.Analyze(&stats));
+    CHECK(stats.presents == 118);
+    CHECK_NEAR(stats.interval, 10.0, 1e-6);
+    CHECK_NEAR(stats.error, 0.0, 1e-6);
+}
+
+TEST_CASE(DisplayIntervalsFromSyncSamples)
+{
+    PacingAnalyzer analyzer(10);
+    PacingStats stats {};
+    double time = 1000.0;
+
+    analyzer.AddSyncSample(100, 1000.0);
+    analyzer.AddSyncSample(100, 1000.0); // not updated yet
+    analyzer.AddSyncSample(102, 1020.0);
+    analyzer.AddSyncSample(103, 1030.0);
+    analyzer.AddSyncSample(105, 1050.0);
+
+    AddTrace(analyzer, time, 11, 20.0, 0.0);
+
+    CHECK(analyzer.Analyze(&stats));
+    CHECK_NEAR(stats.displayInterval, 10.0, 1e-6);
+    CHECK_NEAR(stats.displayJitter, 0.0, 1e-4);
+
+    // Disjoint statistics don't make one long interval
+    analyzer.AddSyncSample(110, 2000.0);
+    analyzer.ResetSync();
+    analyzer.AddSyncSample(200, 3000.0);
+    analyzer.AddSyncSample(201, 3010.0);
+    analyzer.AddSyncSample(202, 3020.0);
+
+    AddTrace(analyzer, time, 10, 20.0, 0.0);
+
+    CHECK(analyzer.Analyze(&stats));
+    CHECK_NEAR(stats.displayInterval, 10.0, 1e-6);
+}
+
+TEST_CASE(TunerIgnoresEmptyStats)
+{
+    PacingTuner tuner(0.1f, 0.1f);
+    PacingStats stats {};
+
+    CHECK(!tuner.Step(stats));
+    CHECK(tuner.SafetyMargin() == 0.1f);
+    CHECK(tuner.VarianceFactor() == 0.1f);
+}
+
+TEST_CASE(TunerClampsStartValues)
+{
+    PacingTuner tuner(5.0f, -1.0f);
+
+    CHECK(tuner.SafetyMargin() == 2.0f);
+    CHECK(tuner.VarianceFactor() == 0.0f);
+}
+
+// Imbalance of generated frames grows with distance of parameters from values which fit this "game"
+static double ModelBias(const PacingTuner& tuner)
+{
+    return 2.0 * std::abs(tuner.SafetyMargin() - 0.6) + 1.0 * std::abs(tuner.VarianceFactor() - 0.5);
+}
+
+static int RunTuner(PacingTuner& tuner, PacingAnalyzer& analyzer, std::mt19937& rng, double& time, int windows)
+{
+    PacingStats stats {};
+
+    for (int w = 0; w < windows; w++)
+    {
+        AddTrace(analyzer, time, 241, 20.0, ModelBias(tuner), &rng, 0.05);
+
+        if (analyzer.Analyze(&stats))
+            tuner.Step(stats);
+
+        if (tuner.Converged())
+            return w;
+    }
+
+    return windows;
+}
+
+TEST_CASE(TunerFindsBestParameters)
+{
+    PacingAnalyzer analyzer(240);
+    PacingTuner tuner(0.01f, 0.3f);
+    std::mt19937 rng(42);
+    double time = 1000.0;
+
+    auto startBias = ModelBias(tuner);
+    auto windows = RunTuner(tuner, analyzer, rng, time, 1000);
+
+    CHECK(tuner.Converged());
+    CHECK(windows < 1000);
+    CHECK(ModelBias(tuner) < startBias * 0.25);
+    CHECK_NEAR(tuner.SafetyMargin(), 0.6, 0.15);
+    CHECK_NEAR(tuner.VarianceFactor(), 0.5, 0.25);
+    CHECK(tuner.SafetyMargin() >= 0.0f && tuner.SafetyMargin() <= 2.0f);
+    CHECK(tuner.VarianceFactor() >= 0.0f && tuner.VarianceFactor() <= 1.0f);
+}
+
+TEST_CASE(TunerSearchesAgainOnDrift)
+{
+    PacingAnalyzer analyzer(240);
+    PacingTuner tuner(0.01f, 0.3f);
+    std::mt19937 rng(7);
+    double time = 1000.0;
+
+    RunTuner(tuner, analyzer, rng, time, 1000);
+    CHECK(tuner.Converged());
+
+    // Scene gets much worse with same parameters
+    PacingStats stats {};
+    AddTrace(analyzer, time, 241, 20.0, ModelBias(tuner) + 3.0, &rng, 0.05);
+    CHECK(analyzer.Analyze(&stats));
+    CHECK(tuner.Step(stats));
+    CHECK(!tuner.Converged());
+}
@@ -0,0 +1,308 @@
+#include <Test.h>
+
+#include <hooks/HookRegistry.h>
+
+#include <map>
+#include <set>
+
+// Behaves like Detours: changes are applied on commit, a failed attach or detach fails the whole transaction
+class StubBackend : public IHookBackend
+{
+  private:
+    bool _open = false;
+    bool _error = false;
+    std::vector<std::pair<void**, void*>> _attaches;
+    std::vector<void**> _detaches;
+    std::map<void**, void*> _targets; // original values of attached hooks
+
+  public:
+    std::set<void*> refused; // detours which can't be attached or detached
+    bool failBegin = false;
+    bool failCommit = false;
+
+    int begins = 0;
+    int commits = 0;
+    int aborts = 0;
+
+    bool Begin() override
+    {
+        begins++;
+
+        if (failBegin || _open)
+            return false;
+
+        _open = true;
+        _error = false;
+        return true;
+    }
+
+    bool Attach(void** original, void* detour) override
+    {
+        if (refused.contains(detour))
+        {
+            _error = true;
+            return false;
+        }
+
+        _attaches.push_back({ original, detour });
+        return true;
+    }
+
+    bool Detach(void** original, void* detour) override
+    {
+        if (refused.contains(detour))
+        {
+            _error = true;
+            return false;
+        }
+
+        _detaches.push_back(original);
+        return true;
+    }
+
+    bool Commit() override
+    {
+        if (!_open || _error || failCommit)
+            return false;
+
+        for (auto& [original, detour] : _attaches)
+        {
+            _targets[original] = *original;
+            *original = detour; // stands for the trampoline
+        }
+
+        for (auto original : _detaches)
+        {
+            *original = _targets[original];
+            _targets.erase(original);
+        }
+
+        Clear();
+        commits++;
+        return true;
+    }
+
+    void Abort() override
+    {
+        aborts++;
+        Clear();
+    }
+
+    void Clear()
+    {
+        _open = false;
+        _attaches.clear();
+        _detaches.clear();
+    }
+
+    bool IsHooked(void** original) const { return _targets.contains(original); }
+    bool IsOpen() const { return _open; }
+};
+
+// Distinct addresses for functions and detours
+static char Functions[16];
+static char Detours[16];
+
+static void* Function(int i) { return &Functions[i]; }
+static void* Detour(int i) { return &Detours[i]; }
+
+TEST_CASE(CommitAttachesQueuedHooks)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* a = Function(0);
+    void* b = Function(1);
+
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, Detour(0));
+    HookRegistry::Queue(HookGroup::Dx12Device, &b, Detour(1));
+
+    // Same pointer again is not a second hook
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, Detour(0));
+
+    CHECK(HookRegistry::Commit());
+    CHECK(backend.begins == 1 && backend.commits == 1);
+    CHECK(a == Detour(0) && b == Detour(1));
+
+    // Nothing pending, no transaction
+    CHECK(HookRegistry::Commit());
+    CHECK(backend.begins == 1);
+
+    HookRegistry::Remove(&a);
+    HookRegistry::Remove(&b);
+    CHECK(a == nullptr && b == nullptr);
+    CHECK(!backend.IsHooked(&a) && !backend.IsHooked(&b));
+
+    HookRegistry::SetBackend(nullptr);
+}
+
+TEST_CASE(QueueIgnoresInvalidHooks)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* empty = nullptr;
+    void* a = Function(0);
+
+    HookRegistry::Queue(HookGroup::Dx12Device, nullptr, Detour(0));
+    HookRegistry::Queue(HookGroup::Dx12Device, &empty, Detour(0));
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, nullptr);
+
+    CHECK(HookRegistry::Commit());
+    CHECK(backend.begins == 0);
+
+    HookRegistry::SetBackend(nullptr);
+}
+
+TEST_CASE(BatchCommitsOnce)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* hooks[4] = { Function(0), Function(1), Function(2), Function(3) };
+
+    {
+        HookBatch outer;
+
+        HookRegistry::Queue(HookGroup::Streamline, &hooks[0], Detour(0));
+        HookRegistry::Commit();
+
+        {
+            HookBatch inner;
+            HookRegistry::Queue(HookGroup::Streamline, &hooks[1], Detour(1));
+            HookRegistry::Queue(HookGroup::Streamline, &hooks[2], Detour(2));
+        }
+
+        HookRegistry::Queue(HookGroup::Streamline, &hooks[3], Detour(3));
+        CHECK(backend.begins == 0);
+    }
+
+    CHECK(backend.begins == 1 && backend.commits == 1);
+
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(hooks[i] == Detour(i));
+        HookRegistry::Remove(&hooks[i]);
+    }
+
+    HookRegistry::SetBackend(nullptr);
+}
+
+TEST_CASE(FailedAttachDoesntPoisonLaterCommits)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* a = Function(0);
+    void* bad = Function(1);
+    void* c = Function(2);
+
+    backend.refused.insert(Detour(1));
+
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, Detour(0));
+    HookRegistry::Queue(HookGroup::Dx12Device, &bad, Detour(1));
+    HookRegistry::Queue(HookGroup::Dx12Device, &c, Detour(2));
+
+    // Rest of the batch is committed without the failing hook
+    CHECK(!HookRegistry::Commit());
+    CHECK(backend.aborts == 1);
+    CHECK(backend.commits == 1);
+    CHECK(!backend.IsOpen());
+    CHECK(a == Detour(0) && c == Detour(2));
+    CHECK(bad == Function(1));
+
+    // Later commits (other subsystems) don't retry it
+    void* d = Function(3);
+    HookRegistry::Queue(HookGroup::RootSignature, &d, Detour(3));
+    auto begins = backend.begins;
+
+    CHECK(HookRegistry::Commit());
+    CHECK(backend.begins == begins + 1);
+    CHECK(d == Detour(3));
+
+    CHECK(HookRegistry::Commit());
+    CHECK(backend.begins == begins + 1);
+
+    // Explicitly queued again it's tried once more
+    backend.refused.clear();
+    HookRegistry::Queue(HookGroup::Dx12Device, &bad, Detour(1));
+    CHECK(HookRegistry::Commit());
+    CHECK(bad == Detour(1));
+
+    for (auto hook : { &a, &bad, &c, &d })
+        HookRegistry::Remove(hook);
+
+    HookRegistry::SetBackend(nullptr);
+}
+
+TEST_CASE(FailedDetachKeepsHook)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* a = Function(0);
+    void* b = Function(1);
+
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, Detour(0));
+    HookRegistry::Queue(HookGroup::Dx12Device, &b, Detour(1));
+    CHECK(HookRegistry::Commit());
+
+    backend.refused.insert(Detour(0));
+    HookRegistry::Remove(&a);
+    CHECK(a == Detour(0));
+    CHECK(backend.IsHooked(&a));
+
+    auto begins = backend.begins;
+    HookRegistry::Remove(&b);
+    CHECK(b == nullptr);
+    CHECK(backend.begins == begins + 1);
+
+    backend.refused.clear();
+    HookRegistry::Remove(&a);
+    CHECK(a == nullptr);
+
+    HookRegistry::SetBackend(nullptr);
+}
+
+TEST_CASE(BeginOrCommitFailureKeepsPending)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* a = Function(0);
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, Detour(0));
+
+    backend.failBegin = true;
+    CHECK(!HookRegistry::Commit());
+    CHECK(a == Function(0));
+
+    backend.failBegin = false;
+    backend.failCommit = true;
+    CHECK(!HookRegistry::Commit());
+    CHECK(a == Function(0));
+    CHECK(!backend.IsOpen());
+
+    backend.failCommit = false;
+    CHECK(HookRegistry::Commit());
+    CHECK(a == Detour(0));
+
+    HookRegistry::Remove(&a);
+    HookRegistry::SetBackend(nullptr);
+}
+
+TEST_CASE(RemoveBeforeCommitNeedsNoTransaction)
+{
+    StubBackend backend;
+    HookRegistry::SetBackend(&backend);
+
+    void* a = Function(0);
+    HookRegistry::Queue(HookGroup::Dx12Device, &a, Detour(0));
+    HookRegistry::Remove(&a);
+
+    CHECK(backend.begins == 0);
+    CHECK(a == Function(0));
+    CHECK(HookRegistry::Commit());
+    CHECK(backend.begins == 0);
+
+    HookRegistry::SetBackend(nullptr);
+}
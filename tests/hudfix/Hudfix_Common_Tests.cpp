@@ -0,0 +1,71 @@
+#include <Test.h>
+
+#include <hudfix/Hudfix_Common.h>
+
+TEST_CASE(CheckSizeExactMatch)
+{
+    bool extended = false;
+
+    CHECK(Hudfix_Common::CheckSize(1920, 1080, 1920, 1080, false, &extended));
+    CHECK(!extended);
+    CHECK(!Hudfix_Common::CheckSize(1920, 1088, 1920, 1080, false, &extended));
+    CHECK(!extended);
+}
+
+TEST_CASE(CheckSizeRelaxed)
+{
+    bool extended = false;
+
+    CHECK(Hudfix_Common::CheckSize(1920, 1088, 1920, 1080, true, &extended));
+    CHECK(extended);
+
+    extended = false;
+    CHECK(Hudfix_Common::CheckSize(1888, 1112, 1920, 1080, true, &extended));
+    CHECK(extended);
+
+    extended = false;
+    CHECK(!Hudfix_Common::CheckSize(1952 + 1, 1080, 1920, 1080, true, &extended));
+    CHECK(!Hudfix_Common::CheckSize(1920, 1080 - 33, 1920, 1080, true, &extended));
+    CHECK(!extended);
+
+    CHECK(Hudfix_Common::CheckSize(1920, 1090, 1920, 1080, true, nullptr));
+}
+
+TEST_CASE(ValidationBinEdges)
+{
+    constexpr auto bins = Hudfix_Common::ValidationBinCount;
+
+    CHECK(Hudfix_Common::ValidationBin(0.0f) == 0);
+    CHECK(Hudfix_Common::ValidationBin(1.0f) == bins - 1);
+    CHECK(Hudfix_Common::ValidationBin(2.0f) == bins - 1);
+
+    for (uint32_t i = 1; i < bins; i++)
+    {
+        auto edge = (float) (i * i) / (float) (bins * bins);
+
+        CHECK(Hudfix_Common::ValidationBin(edge) == i);
+        CHECK(Hudfix_Common::ValidationBin(edge * 0.999f) == i - 1);
+    }
+
+    // Up to ~4 steps of 8 bit is a match
+    CHECK(Hudfix_Common::ValidationBin(3.0f / 255.0f) < Hudfix_Common::ValidationMatchBins);
+    CHECK(Hudfix_Common::ValidationBin(8.0f / 255.0f) >= Hudfix_Common::ValidationMatchBins);
+}
+
+TEST_CASE(ValidationScoreFraction)
+{
+    uint32_t histogram[Hudfix_Common::ValidationBinCount] = {};
+
+    CHECK(Hudfix_Common::ValidationScore(histogram) == -1.0f);
+
+    histogram[0] = 60;
+    histogram[Hudfix_Common::ValidationMatchBins - 1] = 20;
+    histogram[Hudfix_Common::ValidationMatchBins] = 15;
+    histogram[Hudfix_Common::ValidationBinCount - 1] = 5;
+
+    CHECK_NEAR(Hudfix_Common::ValidationScore(histogram), 0.8, 1e-6);
+
+    histogram[0] = 0;
+    histogram[Hudfix_Common::ValidationMatchBins - 1] = 0;
+    CHECK(Hudfix_Common::ValidationScore(histogram) == 0.0f);
+}
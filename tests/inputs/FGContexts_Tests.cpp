@@ -0,0 +1,292 @@
+#include <Test.h>
+
+#include <framegen/FGFrameState.h>
+#include <inputs/FGContextSelector.h>
+#include <shaders/ShaderPool_Common.h>
+
+#include <atomic>
+#include <barrier>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Stands for RCAS, Output Scaling or Bias pass, only what the pool looks at
+struct MockPass
+{
+    int device = 0;
+    bool init = true;
+    int id = 0;
+
+    bool IsInit() { return init; }
+    int Device() { return device; }
+};
+
+static std::unique_ptr<MockPass> MakePass(int device, int id, bool init = true)
+{
+    auto pass = std::make_unique<MockPass>();
+    pass->device = device;
+    pass->id = id;
+    pass->init = init;
+    return pass;
+}
+
+TEST_CASE(PoolReusesReleasedPass)
+{
+    ShaderPoolList<MockPass> pool;
+    auto pass = MakePass(1, 7);
+
+    pool.Return(pass);
+    CHECK(pass == nullptr);
+    CHECK(pool.Size() == 1);
+
+    CHECK(pool.Take([](MockPass* p) { return p->Device() == 2; }) == nullptr);
+
+    auto reused = pool.Take([](MockPass* p) { return p->Device() == 1; });
+    CHECK(reused != nullptr && reused->id == 7);
+    CHECK(pool.Size() == 0);
+}
+
+TEST_CASE(PoolDropsFailedPass)
+{
+    ShaderPoolList<MockPass> pool;
+    auto pass = MakePass(1, 1, false);
+
+    pool.Return(pass);
+    CHECK(pass == nullptr);
+    CHECK(pool.Size() == 0);
+
+    std::unique_ptr<MockPass> empty;
+    pool.Return(empty);
+    CHECK(pool.Size() == 0);
+}
+
+TEST_CASE(PoolKeepsNewestUpToLimit)
+{
+    ShaderPoolList<MockPass> pool(4);
+
+    for (int i = 0; i < 6; i++)
+    {
+        auto pass = MakePass(1, i);
+        pool.Return(pass);
+    }
+
+    CHECK(pool.Size() == 4);
+
+    auto any = [](MockPass*) { return true; };
+
+    // Newest first, two oldest are gone
+    for (int i = 5; i >= 2; i--)
+    {
+        auto pass = pool.Take(any);
+        CHECK(pass != nullptr && pass->id == i);
+    }
+
+    CHECK(pool.Take(any) == nullptr);
+    CHECK(pool.Clear() == 0);
+}
+
+TEST_CASE(SelectorPicksLargestThenLowestHandle)
+{
+    FGContextSelector empty;
+    CHECK(empty.IsSelected(3));
+
+    FGContextSelector selector;
+    selector.Add(5, 1920, 1080);
+    selector.Add(2, 1280, 720);
+    selector.Add(9, 1920, 1080);
+    CHECK(selector.IsSelected(5));
+    CHECK(!selector.IsSelected(2));
+    CHECK(!selector.IsSelected(9));
+
+    // Same contexts in other order
+    FGContextSelector reversed;
+    reversed.Add(9, 1920, 1080);
+    reversed.Add(2, 1280, 720);
+    reversed.Add(5, 1920, 1080);
+    CHECK(reversed.IsSelected(5));
+
+    // Area is 64 bit
+    FGContextSelector large;
+    large.Add(1, 65536, 65536);
+    large.Add(2, 65535, 65537);
+    CHECK(large.IsSelected(1));
+}
+
+// Several contexts run on their own threads and come and go over time like split screen or scope views.
+// Every frame they take passes from the shared pool and evaluate selection on the same context list,
+// only the selected one starts the FG frame.
+TEST_CASE(ConcurrentContexts)
+{
+    struct Context
+    {
+        unsigned int handle;
+        uint32_t width;
+        uint32_t height;
+        int createFrame;
+        int destroyFrame;
+    };
+
+    const std::vector<Context> contexts = {
+        { 10, 1920, 1080, 0, 400 },  { 11, 640, 360, 0, 1000 },   { 12, 1920, 1080, 50, 1000 },
+        { 13, 2560, 1440, 300, 600 }, { 14, 2560, 1440, 300, 700 }, { 15, 320, 240, 800, 1000 },
+    };
+
+    constexpr int Frames = 1000;
+    constexpr int Device = 1;
+
+    ShaderPoolList<MockPass> pool;
+    FGFrameState fg;
+
+    std::mutex registryMutex;
+    std::map<unsigned int, const Context*> registry;
+
+    std::mutex heldMutex;
+    std::set<MockPass*> held;
+    std::atomic<int> nextId = 0;
+    std::atomic<int> created = 0;
+    std::atomic<int> sharedPasses = 0;
+    std::atomic<int> wrongDrivers = 0;
+
+    std::vector<std::atomic<int>> drivers(Frames);
+    std::vector<unsigned int> expected(Frames, 0);
+
+    // Registry changes only between frames, same as features being created before evaluate
+    auto updateRegistry = [&](int frame)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        for (auto& context : contexts)
+        {
+            if (context.createFrame == frame)
+                registry[context.handle] = &context;
+            else if (context.destroyFrame == frame)
+                registry.erase(context.handle);
+        }
+
+        FGContextSelector selector;
+
+        for (auto const& [handle, context] : registry)
+            selector.Add(handle, context->width, context->height);
+
+        for (auto const& [handle, context] : registry)
+        {
+            if (selector.IsSelected(handle))
+                expected[frame] = handle;
+        }
+    };
+
+    int frame = 0;
+    updateRegistry(0);
+
+    std::barrier sync((std::ptrdiff_t) contexts.size(),
+                      [&]() noexcept
+                      {
+                          frame++;
+
+                          if (frame < Frames)
+                              updateRegistry(frame);
+                      });
+
+    std::vector<std::thread> threads;
+
+    for (auto& context : contexts)
+    {
+        threads.emplace_back(
+            [&, context]()
+            {
+                std::unique_ptr<MockPass> pass;
+
+                for (int f = 0; f < Frames; f++)
+                {
+                    bool alive = f >= context.createFrame && f < context.destroyFrame;
+
+                    if (alive && pass == nullptr)
+                    {
+                        pass = pool.Take([](MockPass* p) { return p->Device() == Device; });
+
+                        if (pass == nullptr)
+                        {
+                            pass = MakePass(Device, nextId++);
+                            created++;
+                        }
+
+                        std::lock_guard<std::mutex> lock(heldMutex);
+
+                        if (!held.insert(pass.get()).second)
+                            sharedPasses++;
+                    }
+                    else if (!alive && pass != nullptr)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(heldMutex);
+                            held.erase(pass.get());
+                        }
+
+                        pool.Return(pass);
+                    }
+
+                    if (alive)
+                    {
+                        bool selected = false;
+
+                        {
+                            std::lock_guard<std::mutex> lock(registryMutex);
+
+                            FGContextSelector selector;
+
+                            for (auto const& [handle, registered] : registry)
+                                selector.Add(handle, registered->width, registered->height);
+
+                            selected = registry.size() < 2 || selector.IsSelected(context.handle);
+                        }
+
+                        if (selected)
+                        {
+                            drivers[f]++;
+
+                            if (expected[f] != context.handle)
+                                wrongDrivers++;
+
+                            fg.StartNewFrame();
+                        }
+                    }
+
+                    sync.arrive_and_wait();
+                }
+
+                if (pass != nullptr)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(heldMutex);
+                        held.erase(pass.get());
+                    }
+
+                    pool.Return(pass);
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int f = 0; f < Frames; f++)
+        CHECK(drivers[f] == 1);
+
+    CHECK(fg.FrameCount() == Frames);
+    CHECK(wrongDrivers == 0);
+    CHECK(sharedPasses == 0);
+
+    // At most 5 contexts are alive at once, passes of destroyed ones are reused by later ones
+    CHECK(created == 5);
+    CHECK(pool.Size() == 4);
+
+    // Spot check the schedule, 10 drives until 13 & 14 appear, 13 wins the tie and 14 takes over when it goes
+    CHECK(expected[0] == 10);
+    CHECK(expected[300] == 13);
+    CHECK(expected[650] == 14);
+    CHECK(expected[750] == 12);
+    CHECK(expected[900] == 12);
+}
@@ -0,0 +1,216 @@
+#include <inputs/UpscaleInputs.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+
+// Per dispatch cost of writing FSR3 upscaler inputs to the NGX parameter block.
+// Old path: every input is written each frame and the parameter map builds a std::string key for every lookup.
+// New path: UpscaleInputs writes only changed values, lookups are transparent.
+// Parameter block is a copy of NVNGX_Parameters, std::unordered_map stands for ankerl::unordered_dense.
+// Usage: UpscaleInputs_Bench [dispatches]
+
+typedef struct Parameter
+{
+    template <typename T> void operator=(T value)
+    {
+        key = typeid(T).hash_code();
+        memcpy(&values, &value, sizeof(T));
+    }
+
+    uint64_t values = 0;
+    size_t key = 0;
+} parameter;
+
+struct KeyHash
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view> {}(key); }
+};
+
+template <bool Transparent> struct BenchParameters : public NVSDK_NGX_Parameter
+{
+    std::unordered_map<std::string, Parameter, KeyHash, std::equal_to<>> m_values;
+    mutable std::mutex m_mutex;
+    uint64_t writes = 0;
+
+    template <typename T> void setT(const char* key, T& value)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        writes++;
+
+        decltype(m_values.begin()) k;
+
+        if constexpr (Transparent)
+            k = m_values.find(std::string_view(key));
+        else
+            k = m_values.find(std::string(key));
+
+        if (k != m_values.end())
+            k->second = value;
+        else
+            m_values[key] = value;
+    }
+
+    void Set(const char* key, unsigned long long value) override { setT(key, value); }
+    void Set(const char* key, float value) override { setT(key, value); }
+    void Set(const char* key, double value) override { setT(key, value); }
+    void Set(const char* key, unsigned int value) override { setT(key, value); }
+    void Set(const char* key, int value) override { setT(key, value); }
+    void Set(const char* key, ID3D11Resource* value) override { setT(key, value); }
+    void Set(const char* key, ID3D12Resource* value) override { setT(key, value); }
+    void Set(const char* key, void* value) override { setT(key, value); }
+
+    NVSDK_NGX_Result Get(const char*, unsigned long long*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, float*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, double*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, unsigned int*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, int*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, ID3D11Resource**) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, ID3D12Resource**) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, void**) const override { return NVSDK_NGX_Result_Fail; }
+    void Reset() override {}
+};
+
+// Members used by GetFfxUpscaleInputs, same names as Fsr3::FfxFsr3UpscalerDispatchDescription
+typedef struct BenchResource
+{
+    void* resource = nullptr;
+} bench_resource;
+
+typedef struct BenchDispatchDescription
+{
+    BenchResource color { (void*) 0x1000 };
+    BenchResource depth { (void*) 0x2000 };
+    BenchResource motionVectors { (void*) 0x3000 };
+    BenchResource exposure {};
+    BenchResource reactive { (void*) 0x4000 };
+    BenchResource transparencyAndComposition {};
+    BenchResource output { (void*) 0x5000 };
+    struct
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    } jitterOffset, motionVectorScale { -1920.0f, -1080.0f };
+    struct
+    {
+        uint32_t width = 1280;
+        uint32_t height = 720;
+    } renderSize;
+    float sharpness = 0.0f;
+    float frameTimeDelta = 6.9f;
+    float preExposure = 1.0f;
+    bool reset = false;
+    float cameraNear = 0.1f;
+    float cameraFar = 10000.0f;
+    float cameraFovAngleVertical = 1.0f;
+    float viewSpaceToMetersFactor = 1.0f;
+} bench_dispatch_description;
+
+// FSR3 dispatch before UpscaleInputs
+static void WriteAll(NVSDK_NGX_Parameter* params, const BenchDispatchDescription* desc)
+{
+    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, desc->jitterOffset.x);
+    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, desc->jitterOffset.y);
+    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, desc->motionVectorScale.x);
+    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, desc->motionVectorScale.y);
+    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
+    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, desc->preExposure);
+    params->Set(NVSDK_NGX_Parameter_Reset, desc->reset ? 1 : 0);
+    params->Set(NVSDK_NGX_Parameter_Width, desc->renderSize.width);
+    params->Set(NVSDK_NGX_Parameter_Height, desc->renderSize.height);
+    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, desc->renderSize.width);
+    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, desc->renderSize.height);
+    params->Set(NVSDK_NGX_Parameter_Depth, desc->depth.resource);
+    params->Set(NVSDK_NGX_Parameter_ExposureTexture, desc->exposure.resource);
+    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, desc->reactive.resource);
+    params->Set(NVSDK_NGX_Parameter_Color, desc->color.resource);
+    params->Set(NVSDK_NGX_Parameter_MotionVectors, desc->motionVectors.resource);
+    params->Set(NVSDK_NGX_Parameter_Output, desc->output.resource);
+    params->Set("FSR.cameraNear", desc->cameraNear);
+    params->Set("FSR.cameraFar", desc->cameraFar);
+    params->Set("FSR.cameraFovAngleVertical", desc->cameraFovAngleVertical);
+    params->Set("FSR.frameTimeDelta", desc->frameTimeDelta);
+    params->Set("FSR.transparencyAndComposition", desc->transparencyAndComposition.resource);
+    params->Set("FSR.reactive", desc->reactive.resource);
+    params->Set("FSR.viewSpaceToMetersFactor", desc->viewSpaceToMetersFactor);
+    params->Set(NVSDK_NGX_Parameter_Sharpness, desc->sharpness);
+}
+
+// FSR3 dispatch with UpscaleInputs
+static void WriteChanged(NVSDK_NGX_Parameter* params, const BenchDispatchDescription* desc, UpscaleInputs& last)
+{
+    UpscaleInputs inputs {};
+    GetFfxUpscaleInputs(desc, inputs);
+    inputs.biasColorMask = desc->reactive.resource;
+    inputs.reactive = desc->reactive.resource;
+    inputs.transparency = desc->transparencyAndComposition.resource;
+    inputs.meterFactor = desc->viewSpaceToMetersFactor;
+    ApplyUpscaleInputs(params, inputs, last);
+}
+
+// Jitter sequence & frame time change every frame, rest is stable like in games
+static void NextFrame(BenchDispatchDescription& desc, uint32_t frame)
+{
+    desc.jitterOffset.x = (float) (frame % 8) * 0.125f - 0.5f;
+    desc.jitterOffset.y = (float) (frame % 3) * 0.33f - 0.5f;
+    desc.frameTimeDelta = 6.9f + (float) (frame % 5) * 0.01f;
+}
+
+template <bool Transparent, bool Changed> static double Run(uint32_t dispatches, uint64_t& writes)
+{
+    BenchParameters<Transparent> params;
+    BenchDispatchDescription desc {};
+    UpscaleInputs last {};
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < dispatches; i++)
+    {
+        NextFrame(desc, i);
+
+        if constexpr (Changed)
+            WriteChanged(&params, &desc, last);
+        else
+            WriteAll(&params, &desc);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    writes = params.writes;
+
+    return std::chrono::duration<double, std::nano>(end - begin).count() / dispatches;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t dispatches = argc > 1 ? (uint32_t) strtoul(argv[1], nullptr, 10) : 1000000;
+    uint64_t writes = 0;
+
+    printf("%u dispatches\n", dispatches);
+
+    auto oldPath = Run<false, false>(dispatches, writes);
+    printf("All inputs, string keys:        %6.0f ns, %.1f writes per dispatch\n", oldPath,
+           (double) writes / dispatches);
+
+    auto transparent = Run<true, false>(dispatches, writes);
+    printf("All inputs, transparent keys:   %6.0f ns, %.1f writes per dispatch\n", transparent,
+           (double) writes / dispatches);
+
+    auto changedOnly = Run<false, true>(dispatches, writes);
+    printf("Changed inputs, string keys:    %6.0f ns, %.1f writes per dispatch\n", changedOnly,
+           (double) writes / dispatches);
+
+    auto newPath = Run<true, true>(dispatches, writes);
+    printf("Changed inputs, transparent:    %6.0f ns, %.1f writes per dispatch\n", newPath,
+           (double) writes / dispatches);
+
+    return 0;
+}
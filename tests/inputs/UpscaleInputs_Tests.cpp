@@ -0,0 +1,142 @@
+#include <Test.h>
+
+#include <inputs/UpscaleInputs.h>
+
+#include <string>
+#include <vector>
+
+// Records written keys, values are not needed
+struct RecordingParameters : public NVSDK_NGX_Parameter
+{
+    std::vector<std::string> keys;
+
+    bool Has(const char* key) const
+    {
+        for (auto& k : keys)
+        {
+            if (k == key)
+                return true;
+        }
+
+        return false;
+    }
+
+    void Set(const char* key, unsigned long long) override { keys.push_back(key); }
+    void Set(const char* key, float) override { keys.push_back(key); }
+    void Set(const char* key, double) override { keys.push_back(key); }
+    void Set(const char* key, unsigned int) override { keys.push_back(key); }
+    void Set(const char* key, int) override { keys.push_back(key); }
+    void Set(const char* key, ID3D11Resource*) override { keys.push_back(key); }
+    void Set(const char* key, ID3D12Resource*) override { keys.push_back(key); }
+    void Set(const char* key, void*) override { keys.push_back(key); }
+
+    NVSDK_NGX_Result Get(const char*, unsigned long long*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, float*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, double*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, unsigned int*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, int*) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, ID3D11Resource**) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, ID3D12Resource**) const override { return NVSDK_NGX_Result_Fail; }
+    NVSDK_NGX_Result Get(const char*, void**) const override { return NVSDK_NGX_Result_Fail; }
+    void Reset() override { keys.clear(); }
+};
+
+static UpscaleInputs Frame()
+{
+    UpscaleInputs inputs {};
+    inputs.renderWidth = 1280;
+    inputs.renderHeight = 720;
+    inputs.color = (void*) 0x1000;
+    inputs.depth = (void*) 0x2000;
+    inputs.motionVectors = (void*) 0x3000;
+    inputs.output = (void*) 0x4000;
+    inputs.mvScaleX = 1.0f;
+    inputs.mvScaleY = 1.0f;
+    inputs.cameraNear = 0.1f;
+    inputs.sharpness = 0.5f;
+    return inputs;
+}
+
+TEST_CASE(FirstFrameWritesEverything)
+{
+    RecordingParameters params;
+    UpscaleInputs last {};
+
+    ApplyUpscaleInputs(&params, Frame(), last);
+
+    CHECK(last.applied);
+    CHECK(params.Has(NVSDK_NGX_Parameter_Jitter_Offset_X));
+    CHECK(params.Has(NVSDK_NGX_Parameter_Color));
+    CHECK(params.Has(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width));
+    CHECK(params.Has("FSR.cameraNear"));
+
+    // Optional inputs without a value are left alone
+    CHECK(!params.Has("FSR.cameraFar"));
+    CHECK(!params.Has(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X));
+}
+
+TEST_CASE(UnchangedFrameWritesOnlyBackendKeys)
+{
+    RecordingParameters params;
+    UpscaleInputs last {};
+
+    ApplyUpscaleInputs(&params, Frame(), last);
+    params.Reset();
+    ApplyUpscaleInputs(&params, Frame(), last);
+
+    // Backends rewrite these during evaluate
+    CHECK(params.keys.size() == 4);
+    CHECK(params.Has(NVSDK_NGX_Parameter_Width));
+    CHECK(params.Has(NVSDK_NGX_Parameter_Height));
+    CHECK(params.Has(NVSDK_NGX_Parameter_Output));
+    CHECK(params.Has(NVSDK_NGX_Parameter_Sharpness));
+}
+
+TEST_CASE(ChangedValuesAreWritten)
+{
+    RecordingParameters params;
+    UpscaleInputs last {};
+
+    ApplyUpscaleInputs(&params, Frame(), last);
+    params.Reset();
+
+    auto inputs = Frame();
+    inputs.jitterX = 0.25f;
+    inputs.color = (void*) 0x1100;
+    inputs.renderWidth = 1024;
+    ApplyUpscaleInputs(&params, inputs, last);
+
+    CHECK(params.Has(NVSDK_NGX_Parameter_Jitter_Offset_X));
+    CHECK(!params.Has(NVSDK_NGX_Parameter_Jitter_Offset_Y));
+    CHECK(params.Has(NVSDK_NGX_Parameter_Color));
+    CHECK(!params.Has(NVSDK_NGX_Parameter_Depth));
+    CHECK(params.Has(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width));
+    CHECK(params.Has(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height));
+    CHECK(last.jitterX == 0.25f);
+
+    // Subrect bases are written together once any of them changes
+    params.Reset();
+    inputs.subrectBases = UpscaleSubrectBases {};
+    ApplyUpscaleInputs(&params, inputs, last);
+    CHECK(params.Has(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X));
+    CHECK(params.Has(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y));
+
+    params.Reset();
+    ApplyUpscaleInputs(&params, inputs, last);
+    CHECK(!params.Has(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X));
+}
+
+TEST_CASE(NewContextWritesEverythingAgain)
+{
+    RecordingParameters params;
+    UpscaleInputs last {};
+
+    ApplyUpscaleInputs(&params, Frame(), last);
+
+    // Context recreation resets the last inputs
+    last = {};
+    params.Reset();
+    ApplyUpscaleInputs(&params, Frame(), last);
+    CHECK(params.Has(NVSDK_NGX_Parameter_Depth));
+    CHECK(params.Has("FSR.cameraNear"));
+}
@@ -0,0 +1,297 @@
+#include <imgui/imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <version>
+
+// Overlay uses std::format, older standard libraries fall back to fmt which std::format is based on
+#ifdef __cpp_lib_format
+#include <format>
+namespace fmtns = std;
+#else
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+namespace fmtns = fmt;
+#endif
+
+// CPU time of the fps overlay per present with headless ImGui, no renderer backend.
+// Same work as MenuCommon::RenderMenu with vertical FpsOverlayType 5 (all lines & both graphs). Old overlay rebuilt
+// texts & averages every frame and drew the graphs with ImGui::PlotLines, one line per sample. Current overlay
+// rebuilds them at FpsOverlayUpdateRate (10 Hz by default) together with normalized graph points, other frames
+// only submit the cached texts and one polyline per graph.
+// Usage: FpsOverlay_Bench [frames] [fps]
+
+static std::deque<double> _frameTimes(300, 6.9);
+static std::deque<double> _upscaleTimes(300, 1.2);
+static std::mutex _frameTimeMutex;
+
+static double _lastUpdate = -1e9;
+static double _frameTime = 0.0;
+static double _frameRate = 0.0;
+static float _averageFrameTime = 0.0f;
+static float _averageUpscalerTime = 0.0f;
+static std::vector<float> _frameTimesCopy;
+static std::vector<float> _upscalerTimesCopy;
+static std::string _firstLine;
+static std::string _secondLine;
+static std::string _thirdLine;
+static ImVec2 _plotSize = {};
+
+static void Rebuild()
+{
+    float frameCnt = 0;
+    _frameTime = 0;
+    for (size_t i = 299; i > 199; i--)
+    {
+        if (_frameTimes[i] > 0.0)
+        {
+            _frameTime += _frameTimes[i];
+            frameCnt++;
+        }
+    }
+
+    _frameTime /= frameCnt;
+    _frameRate = 1000.0 / _frameTime;
+
+    _frameTimeMutex.lock();
+    _frameTimesCopy.assign(_frameTimes.begin(), _frameTimes.end());
+    _upscalerTimesCopy.assign(_upscaleTimes.begin(), _upscaleTimes.end());
+    _frameTimeMutex.unlock();
+
+    _averageFrameTime = 0.0f;
+    _averageUpscalerTime = 0.0f;
+
+    for (size_t i = 0; i < _frameTimesCopy.size(); i++)
+    {
+        _averageFrameTime += _frameTimesCopy[i];
+        _averageUpscalerTime += _upscalerTimesCopy[i];
+    }
+
+    _averageFrameTime /= _frameTimesCopy.size();
+    _averageUpscalerTime /= _frameTimesCopy.size();
+}
+
+static void UpdateTexts()
+{
+    _firstLine = fmtns::format("{} | FPS: {:5.1f}, Avg: {:5.1f} | {} -> {} {}.{}.{}", "D3D12", _frameRate,
+                             1000.0f / _averageFrameTime, "DLSS", "FSR", 3, 1, 4);
+    _secondLine =
+        fmtns::format("Frame Time: {:6.2f} ms, Avg: {:6.2f} ms", _frameTimesCopy.back(), _averageFrameTime);
+    _thirdLine = fmtns::format("Upscaler Time: {:6.2f} ms, Avg: {:6.2f} ms", _upscalerTimesCopy.back(),
+                             _averageUpscalerTime);
+
+    auto firstSize = ImGui::CalcTextSize(_firstLine.c_str());
+    auto secondSize = ImGui::CalcTextSize(_secondLine.c_str());
+    auto thirdSize = ImGui::CalcTextSize(_thirdLine.c_str());
+    auto textWidth = std::max(firstSize.x, std::max(secondSize.x, thirdSize.x));
+
+    _plotSize = { std::max(textWidth, 300.0f), 30.0f };
+}
+
+static std::vector<ImVec2> _framePlot;
+static std::vector<ImVec2> _upscalerPlot;
+static std::vector<ImVec2> _plotPoints;
+
+// Same as MenuCommon::BuildFpsPlot & DrawFpsPlot
+static void BuildPlot(const std::vector<float>& values, float scaleMax, std::vector<ImVec2>& plot)
+{
+    auto count = std::min((size_t) _plotSize.x, values.size());
+    plot.resize(count);
+
+    if (count < 2)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto value = values[i * values.size() / count];
+        plot[i] = { (float) i / (count - 1), 1.0f - std::clamp(value / scaleMax, 0.0f, 1.0f) };
+    }
+}
+
+static void DrawPlot(const std::vector<ImVec2>& plot)
+{
+    auto& style = ImGui::GetStyle();
+    auto drawList = ImGui::GetWindowDrawList();
+
+    auto frameMin = ImGui::GetCursorScreenPos();
+    ImVec2 frameMax { frameMin.x + _plotSize.x, frameMin.y + _plotSize.y };
+    ImGui::Dummy(_plotSize);
+
+    drawList->AddRectFilled(frameMin, frameMax, ImGui::GetColorU32(ImGuiCol_FrameBg), style.FrameRounding);
+
+    if (plot.size() < 2)
+        return;
+
+    ImVec2 innerMin { frameMin.x + style.FramePadding.x, frameMin.y + style.FramePadding.y };
+    ImVec2 innerSize { _plotSize.x - style.FramePadding.x * 2.0f, _plotSize.y - style.FramePadding.y * 2.0f };
+
+    _plotPoints.resize(plot.size());
+
+    for (size_t i = 0; i < plot.size(); i++)
+        _plotPoints[i] = { innerMin.x + plot[i].x * innerSize.x, innerMin.y + plot[i].y * innerSize.y };
+
+    drawList->AddPolyline(_plotPoints.data(), (int) _plotPoints.size(), ImGui::GetColorU32(ImGuiCol_PlotLines),
+                          ImDrawFlags_None, 1.0f);
+}
+
+static void OverlayCachedPlot(double now, float updateRate)
+{
+    bool refresh = updateRate <= 0.0f || (now - _lastUpdate) >= (1000.0 / updateRate);
+
+    if (refresh)
+    {
+        Rebuild();
+        _lastUpdate = now;
+    }
+
+    ImGui::SetNextWindowPos({ 0.0f, 0.0f }, ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.4f);
+
+    if (ImGui::Begin("Performance Overlay", nullptr,
+                     ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDecoration |
+                         ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing |
+                         ImGuiWindowFlags_NoNav))
+    {
+        if (refresh)
+        {
+            UpdateTexts();
+            BuildPlot(_frameTimesCopy, 66.6f, _framePlot);
+            BuildPlot(_upscalerTimesCopy, 20.0f, _upscalerPlot);
+        }
+
+        ImGui::TextUnformatted(_firstLine.c_str());
+        ImGui::Spacing();
+        ImGui::TextUnformatted(_secondLine.c_str());
+        DrawPlot(_framePlot);
+        ImGui::Spacing();
+        ImGui::TextUnformatted(_thirdLine.c_str());
+        DrawPlot(_upscalerPlot);
+    }
+
+    ImGui::End();
+}
+
+static void Overlay(double now, float updateRate)
+{
+    bool refresh = updateRate <= 0.0f || (now - _lastUpdate) >= (1000.0 / updateRate);
+
+    if (refresh)
+    {
+        Rebuild();
+        _lastUpdate = now;
+    }
+
+    ImGui::SetNextWindowPos({ 0.0f, 0.0f }, ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.4f);
+
+    if (ImGui::Begin("Performance Overlay", nullptr,
+                     ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDecoration |
+                         ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing |
+                         ImGuiWindowFlags_NoNav))
+    {
+        if (refresh)
+            UpdateTexts();
+
+        ImGui::TextUnformatted(_firstLine.c_str());
+        ImGui::Spacing();
+        ImGui::TextUnformatted(_secondLine.c_str());
+        ImGui::PlotLines("##FrameTimeGraph", _frameTimesCopy.data(), (int) _frameTimesCopy.size(), 0, nullptr, 0.0f,
+                         66.6f, _plotSize);
+        ImGui::Spacing();
+        ImGui::TextUnformatted(_thirdLine.c_str());
+        ImGui::PlotLines("##UpscalerFrameTimeGraph", _upscalerTimesCopy.data(), (int) _upscalerTimesCopy.size(), 0,
+                         nullptr, 0.0f, 20.0f, _plotSize);
+    }
+
+    ImGui::End();
+}
+
+static void AcceptTextures()
+{
+    for (auto texture : ImGui::GetPlatformIO().Textures)
+    {
+        if (texture->Status == ImTextureStatus_WantCreate)
+            texture->SetTexID((ImTextureID) 1);
+
+        if (texture->Status == ImTextureStatus_WantDestroy)
+            texture->SetStatus(ImTextureStatus_Destroyed);
+        else if (texture->Status != ImTextureStatus_OK)
+            texture->SetStatus(ImTextureStatus_OK);
+    }
+}
+
+// Returns ns per frame, without overlay only the empty ImGui frame is measured
+static double Run(uint32_t frames, double fps, float updateRate, bool overlay, bool cachedPlot = false)
+{
+    auto& io = ImGui::GetIO();
+    double now = 0.0;
+    _lastUpdate = -1e9;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        now += 1000.0 / fps;
+        io.DeltaTime = (float) (1.0 / fps);
+
+        // Game's frame time history moves every frame
+        _frameTimeMutex.lock();
+        _frameTimes.pop_front();
+        _frameTimes.push_back(1000.0 / fps + (i % 7) * 0.1);
+        _upscaleTimes.pop_front();
+        _upscaleTimes.push_back(1.0 + (i % 5) * 0.05);
+        _frameTimeMutex.unlock();
+
+        ImGui::NewFrame();
+
+        if (overlay && cachedPlot)
+            OverlayCachedPlot(now, updateRate);
+        else if (overlay)
+            Overlay(now, updateRate);
+
+        ImGui::Render();
+        AcceptTextures();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / frames;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frames = argc > 1 ? (uint32_t) strtoul(argv[1], nullptr, 10) : 200000;
+    double fps = argc > 2 ? strtod(argv[2], nullptr) : 144.0;
+
+    ImGui::CreateContext();
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = { 1920.0f, 1080.0f };
+    io.IniFilename = nullptr;
+    io.Fonts->AddFontDefault();
+
+    // Null renderer, texture requests are accepted without uploading
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+    // Warm up, font glyphs & window are created on first frames
+    Run(1000, fps, 0.0f, true);
+
+    auto empty = Run(frames, fps, 0.0f, false);
+    auto everyFrame = Run(frames, fps, 0.0f, true);
+    auto limited = Run(frames, fps, 10.0f, true);
+    auto cached = Run(frames, fps, 10.0f, true, true);
+
+    printf("%u frames at %.0f fps\n", frames, fps);
+    printf("ImGui frame without overlay:  %8.0f ns\n", empty);
+    printf("Every frame, PlotLines:       %8.0f ns (+%.0f ns)\n", everyFrame, everyFrame - empty);
+    printf("10 Hz, PlotLines:             %8.0f ns (+%.0f ns)\n", limited, limited - empty);
+    printf("10 Hz, cached polylines:      %8.0f ns (+%.0f ns)\n", cached, cached - empty);
+
+    ImGui::DestroyContext();
+    return 0;
+}
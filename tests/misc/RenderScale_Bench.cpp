@@ -0,0 +1,112 @@
+#include "RenderScale_Sim.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Runs the render scale controller against frame time traces and prints how close it keeps the target
+// Usage: RenderScale_Bench [trace file] [target ms] [query interval] [fixed ms]
+// Trace file has a frame time in milliseconds at full render scale per line, first column of csv files is used
+// and lines which don't start with a number are skipped. Without a file synthetic traces are used.
+using namespace RenderScaleSim;
+
+static bool LoadTrace(const char* path, std::vector<double>& trace)
+{
+    std::ifstream file(path);
+
+    if (!file)
+        return false;
+
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        char* end = nullptr;
+        auto value = std::strtod(line.c_str(), &end);
+
+        if (end != line.c_str() && value > 0.0)
+            trace.push_back(value);
+    }
+
+    return !trace.empty();
+}
+
+static void Report(const char* name, const std::vector<double>& trace, double targetMs, const Game& game)
+{
+    RenderScaleController controller;
+    controller.Reset(1.0f, 0.5f, 1.0f);
+
+    auto result = Run(controller, trace, targetMs, game);
+
+    // Skip first second of convergence
+    size_t from = std::min<size_t>(60, trace.size());
+    std::vector<double> measured(result.frameTimes.begin() + from, result.frameTimes.end());
+
+    uint32_t overTarget = 0;
+
+    for (auto frameTime : measured)
+        overTarget += frameTime > targetMs * 1.05;
+
+    float minScale = 1.0f;
+
+    for (auto scale : result.renderScales)
+        minScale = std::min(minScale, scale);
+
+    std::printf("%-14s frames: %6zu mean: %7.3f ms p95: %7.3f ms over target: %5.1f%% min scale: %.3f "
+                "final scale: %.3f changes: %u queries: %u\n",
+                name, trace.size(), Mean(result.frameTimes, from, result.frameTimes.size()),
+                Percentile(measured, 95.0), measured.empty() ? 0.0 : 100.0 * overTarget / measured.size(), minScale,
+                result.renderScales.back(), result.changes, result.queries);
+}
+
+int main(int argc, char** argv)
+{
+    double targetMs = argc > 2 ? std::atof(argv[2]) : 16.667;
+
+    Game game;
+
+    if (argc > 3)
+        game.queryInterval = (uint32_t) std::atoi(argv[3]);
+
+    if (argc > 4)
+        game.fixedMs = std::atof(argv[4]);
+
+    if (argc > 1)
+    {
+        std::vector<double> trace;
+
+        if (!LoadTrace(argv[1], trace))
+        {
+            std::printf("Can't read trace: %s\n", argv[1]);
+            return 1;
+        }
+
+        Report(argv[1], trace, targetMs, game);
+        return 0;
+    }
+
+    std::vector<double> stepUp(3000, 14.0);
+    std::fill(stepUp.begin() + 1000, stepUp.end(), 28.0);
+
+    std::vector<double> spikes = Noisy(3000, 20.0, 0.1, 4);
+
+    for (size_t i = 500; i < spikes.size(); i += 400)
+    {
+        for (size_t j = i; j < std::min(i + 20, spikes.size()); j++)
+            spikes[j] *= 2.0;
+    }
+
+    std::vector<double> ramp(3000);
+
+    for (size_t i = 0; i < ramp.size(); i++)
+        ramp[i] = 12.0 + 24.0 * (double) i / (double) ramp.size();
+
+    Report("steady", std::vector<double>(3000, 25.0), targetMs, game);
+    Report("noisy", Noisy(3000, 25.0, 0.2, 1), targetMs, game);
+    Report("step", stepUp, targetMs, game);
+    Report("spikes", spikes, targetMs, game);
+    Report("ramp", ramp, targetMs, game);
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <misc/RenderScale_Common.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Simulated game for RenderScaleController, trace has frame times at full render scale
+namespace RenderScaleSim
+{
+struct Game
+{
+    double fixedMs = 3.0;        // Part of the frame which doesn't scale with resolution
+    uint32_t queryInterval = 1;  // Optimal settings are queried every N frames, 0 never
+    uint32_t applyDelay = 1;     // Frames until the queried size is rendered
+    uint32_t firstQueryFrame = 0;
+    uint32_t lastQueryFrame = UINT32_MAX;
+};
+
+struct Result
+{
+    std::vector<double> frameTimes;
+    std::vector<float> renderScales;     // Scale each frame was rendered with
+    std::vector<float> controllerScales; // Controller's scale after each frame
+    uint32_t changes = 0;            // Controller scale changes
+    uint32_t queries = 0;
+};
+
+inline Result Run(RenderScaleController& controller, const std::vector<double>& trace, double targetMs,
+                  const Game& game)
+{
+    Result result;
+    float renderScale = 1.0f;
+    float queuedScale = renderScale;
+    int64_t applyFrame = -1;
+
+    for (uint32_t frame = 0; frame < trace.size(); frame++)
+    {
+        if (applyFrame == frame)
+            renderScale = queuedScale;
+
+        bool query = game.queryInterval > 0 && frame >= game.firstQueryFrame && frame <= game.lastQueryFrame &&
+                     (frame - game.firstQueryFrame) % game.queryInterval == 0;
+
+        // Like RenderScale::QueryRatio, game gets current scale and controller is told it's applied
+        if (query)
+        {
+            queuedScale = controller.Scale();
+            applyFrame = frame + game.applyDelay;
+            controller.Applied();
+            result.queries++;
+        }
+
+        auto scaled = std::max(trace[frame] - game.fixedMs, 0.0);
+        auto frameTime = std::min(trace[frame], game.fixedMs) + scaled * renderScale * renderScale;
+
+        auto oldScale = controller.Scale();
+
+        if (controller.Update(frameTime, targetMs) != oldScale)
+            result.changes++;
+
+        result.frameTimes.push_back(frameTime);
+        result.renderScales.push_back(renderScale);
+        result.controllerScales.push_back(controller.Scale());
+    }
+
+    return result;
+}
+
+// Deterministic +-amount noise around a base frame time
+inline std::vector<double> Noisy(size_t frames, double baseMs, double amount, uint32_t seed)
+{
+    std::vector<double> trace(frames);
+    uint32_t state = seed * 747796405u + 2891336453u;
+
+    for (auto& frameTime : trace)
+    {
+        state = state * 1664525u + 1013904223u;
+        frameTime = baseMs * (1.0 + amount * ((double) (state >> 8) / 8388608.0 - 1.0));
+    }
+
+    return trace;
+}
+
+inline double Mean(const std::vector<double>& values, size_t from, size_t to)
+{
+    double sum = 0.0;
+
+    for (size_t i = from; i < to; i++)
+        sum += values[i];
+
+    return to > from ? sum / (double) (to - from) : 0.0;
+}
+
+inline double Percentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    auto index = (size_t) ((percentile / 100.0) * (double) (values.size() - 1));
+    return values[index];
+}
+} // namespace RenderScaleSim
@@ -0,0 +1,145 @@
+#include <Test.h>
+
+#include "RenderScale_Sim.h"
+
+#include <cmath>
+
+using namespace RenderScaleSim;
+
+static constexpr double Target = 16.667;
+
+static RenderScaleController Controller(float minScale = 0.5f)
+{
+    RenderScaleController controller;
+    controller.Reset(1.0f, minScale, 1.0f);
+    return controller;
+}
+
+static uint32_t Reversals(const std::vector<float>& scales, size_t from)
+{
+    uint32_t reversals = 0;
+    int lastDirection = 0;
+
+    for (size_t i = from + 1; i < scales.size(); i++)
+    {
+        int direction = scales[i] > scales[i - 1] ? 1 : (scales[i] < scales[i - 1] ? -1 : 0);
+
+        if (direction != 0)
+        {
+            reversals += lastDirection != 0 && direction != lastDirection;
+            lastDirection = direction;
+        }
+    }
+
+    return reversals;
+}
+
+TEST_CASE(ConvergesToTarget)
+{
+    auto controller = Controller();
+    auto result = Run(controller, std::vector<double>(1500, 25.0), Target, Game {});
+
+    auto mean = Mean(result.frameTimes, 1200, 1500);
+    CHECK(std::abs(mean - Target) / Target < controller.DeadBand * 1.5);
+    CHECK(result.renderScales.back() < 1.0f);
+    CHECK(Reversals(result.renderScales, 1200) == 0);
+}
+
+TEST_CASE(StaysAtFullScaleUnderBudget)
+{
+    auto controller = Controller();
+    auto result = Run(controller, Noisy(1000, 10.0, 0.2, 1), Target, Game {});
+
+    CHECK(result.changes == 0);
+    CHECK(controller.Scale() == 1.0f);
+}
+
+TEST_CASE(ClampsAtMinimumAndRecovers)
+{
+    auto controller = Controller(0.5f);
+    std::vector<double> trace(3000, 100.0);
+    std::fill(trace.begin() + 1500, trace.end(), 10.0);
+
+    auto result = Run(controller, trace, Target, Game {});
+
+    CHECK(result.renderScales[1499] == 0.5f);
+
+    // No integral windup while clamped, full scale is reached again
+    CHECK(result.renderScales.back() == 1.0f);
+}
+
+TEST_CASE(NoQueryNoChange)
+{
+    // Without queries game never renders with a new scale, controller must not drift
+    auto controller = Controller();
+    Game game;
+    game.queryInterval = 0;
+
+    auto result = Run(controller, std::vector<double>(2000, 40.0), Target, game);
+
+    CHECK(result.changes == 0);
+    CHECK(controller.Pending());
+    CHECK(controller.Scale() == 1.0f);
+}
+
+TEST_CASE(WaitsForEachQuery)
+{
+    // Game stops querying after a while, only one change after the last query is allowed
+    auto controller = Controller();
+    Game game;
+    game.queryInterval = 30;
+    game.lastQueryFrame = 300;
+
+    auto result = Run(controller, std::vector<double>(2000, 40.0), Target, game);
+
+    CHECK(result.changes <= result.queries);
+    CHECK(controller.Pending());
+
+    uint32_t changesAfterLastQuery = 0;
+
+    for (size_t i = 301; i < result.controllerScales.size(); i++)
+        changesAfterLastQuery += result.controllerScales[i] != result.controllerScales[i - 1];
+
+    CHECK(changesAfterLastQuery <= 1);
+    CHECK(std::abs(controller.Scale() - result.renderScales.back()) <= controller.MaxStepDown + 1e-6f);
+}
+
+TEST_CASE(SlowQueriesConverge)
+{
+    auto controller = Controller();
+    Game game;
+    game.queryInterval = 20;
+    game.applyDelay = 3;
+
+    auto result = Run(controller, Noisy(8000, 25.0, 0.1, 2), Target, game);
+
+    auto mean = Mean(result.frameTimes, 7000, 8000);
+    CHECK(std::abs(mean - Target) / Target < controller.DeadBand * 1.5);
+}
+
+TEST_CASE(RecoversFromLoadIncrease)
+{
+    auto controller = Controller();
+    std::vector<double> trace(2000, 18.0);
+    std::fill(trace.begin() + 1000, trace.end(), 30.0);
+
+    auto result = Run(controller, trace, Target, Game {});
+
+    // Scale is lowered quickly after the step
+    uint32_t slowFrames = 0;
+
+    for (size_t i = 1300; i < 2000; i++)
+        slowFrames += result.frameTimes[i] > Target * 1.1;
+
+    CHECK(slowFrames == 0);
+    CHECK(std::abs(Mean(result.frameTimes, 1500, 2000) - Target) / Target < controller.DeadBand * 1.5);
+}
+
+TEST_CASE(NoisyTraceDoesNotOscillate)
+{
+    auto controller = Controller();
+    auto result = Run(controller, Noisy(3000, 24.0, 0.15, 3), Target, Game {});
+
+    // Dead band and smoothing keep the scale mostly still after converging
+    CHECK(Reversals(result.renderScales, 1500) <= 10);
+}
@@ -0,0 +1,234 @@
+#include <Test.h>
+
+#include <misc/TelemetryLayout.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Shared file mapping like the one readers open, it's removed when closed
+class SharedFile
+{
+  private:
+    std::vector<char> _path;
+    int _fd = -1;
+
+  public:
+    bool Create()
+    {
+        const char pattern[] = "/tmp/optiscaler_telemetry_XXXXXX";
+        _path.assign(pattern, pattern + sizeof(pattern));
+        _fd = mkstemp(_path.data());
+
+        return _fd >= 0 && ftruncate(_fd, TelemetryMappingSize) == 0;
+    }
+
+    // Separate view of the same file, forked reader maps its own
+    TelemetryHeader* Map()
+    {
+        int fd = open(_path.data(), O_RDWR);
+
+        if (fd < 0)
+            return nullptr;
+
+        auto view = mmap(nullptr, TelemetryMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        return view == MAP_FAILED ? nullptr : (TelemetryHeader*) view;
+    }
+
+    static void Unmap(TelemetryHeader* header) { munmap(header, TelemetryMappingSize); }
+
+    ~SharedFile()
+    {
+        if (_fd >= 0)
+        {
+            close(_fd);
+            unlink(_path.data());
+        }
+    }
+};
+
+// Every field is derived from the frame so a record mixing two writes is detected
+static TelemetryRecord MakeRecord(uint64_t frame)
+{
+    TelemetryRecord record {};
+    record.timeMs = frame * 1.5;
+    record.frameTimeMs = (double) (frame % 97);
+    record.upscaleTimeMs = frame * 0.25;
+    record.renderWidth = (uint32_t) frame;
+    record.renderHeight = (uint32_t) (frame >> 1);
+    record.outputWidth = (uint32_t) (frame * 3);
+    record.outputHeight = (uint32_t) (frame ^ 0x5555);
+    record.flags = (uint32_t) (frame & 0xF);
+    std::snprintf(record.backend, sizeof(record.backend), "f%llu", (unsigned long long) frame);
+    return record;
+}
+
+static bool Matches(const TelemetryRecord& record, uint64_t frame)
+{
+    auto expected = MakeRecord(frame);
+    expected.sequence = frame * 2 + 2;
+    expected.frame = frame;
+    return memcmp(&record, &expected, sizeof(TelemetryRecord)) == 0;
+}
+
+TEST_CASE(HeaderIsPublishedWithMagic)
+{
+    SharedFile file;
+    CHECK(file.Create());
+
+    auto header = file.Map();
+    CHECK(header != nullptr);
+
+    if (header == nullptr)
+        return;
+
+    CHECK(TelemetryWriteIndex(header) == 0);
+
+    TelemetryInitHeader(header, 1234);
+
+    // Read back through another view of the file
+    auto view = file.Map();
+    CHECK(view != nullptr && view != header);
+    CHECK(view->magic == TelemetryMagic);
+    CHECK(view->version == TelemetryVersion);
+    CHECK(view->headerSize == sizeof(TelemetryHeader));
+    CHECK(view->recordSize == sizeof(TelemetryRecord));
+    CHECK(view->recordCount == TelemetryRecordCount);
+    CHECK(view->processId == 1234);
+
+    SharedFile::Unmap(view);
+    SharedFile::Unmap(header);
+}
+
+TEST_CASE(WriteAndRead)
+{
+    SharedFile file;
+    CHECK(file.Create());
+
+    auto header = file.Map();
+
+    if (header == nullptr)
+        return;
+
+    TelemetryInitHeader(header, 1);
+
+    for (uint64_t frame = 0; frame < 3; frame++)
+        TelemetryWriteRecord(header, MakeRecord(frame));
+
+    CHECK(TelemetryWriteIndex(header) == 3);
+
+    TelemetryRecord record {};
+
+    for (uint64_t frame = 0; frame < 3; frame++)
+    {
+        CHECK(TelemetryReadRecord(header, frame, &record));
+        CHECK(Matches(record, frame));
+    }
+
+    // Not written yet
+    CHECK(!TelemetryReadRecord(header, 3, &record));
+
+    SharedFile::Unmap(header);
+}
+
+TEST_CASE(OverwrittenAndInProgressAreRejected)
+{
+    SharedFile file;
+    CHECK(file.Create());
+
+    auto header = file.Map();
+
+    if (header == nullptr)
+        return;
+
+    TelemetryInitHeader(header, 1);
+
+    for (uint64_t frame = 0; frame <= TelemetryRecordCount; frame++)
+        TelemetryWriteRecord(header, MakeRecord(frame));
+
+    TelemetryRecord record {};
+
+    // Slot 0 holds frame recordCount now
+    CHECK(!TelemetryReadRecord(header, 0, &record));
+    CHECK(TelemetryReadRecord(header, TelemetryRecordCount, &record));
+    CHECK(Matches(record, TelemetryRecordCount));
+    CHECK(TelemetryReadRecord(header, 1, &record));
+
+    // Writer stopped in the middle of frame recordCount + 1
+    auto slot = &TelemetryRecords(header)[1];
+    slot->sequence = (TelemetryRecordCount + 1) * 2 + 1;
+    CHECK(!TelemetryReadRecord(header, 1, &record));
+    CHECK(!TelemetryReadRecord(header, TelemetryRecordCount + 1, &record));
+
+    SharedFile::Unmap(header);
+}
+
+// Reader process reads the oldest records of the ring through its own mapping of the file, those are the
+// ones writer rewrites next. Every accepted record must be complete, rejected ones are expected.
+TEST_CASE(ConcurrentReaderProcess)
+{
+    constexpr uint64_t Frames = 2000000;
+
+    SharedFile file;
+    CHECK(file.Create());
+
+    auto header = file.Map();
+
+    if (header == nullptr)
+        return;
+
+    auto reader = fork();
+    CHECK(reader >= 0);
+
+    if (reader == 0)
+    {
+        auto view = file.Map();
+
+        if (view == nullptr)
+            _exit(2);
+
+        uint64_t accepted = 0;
+        uint64_t torn = 0;
+        TelemetryRecord record {};
+
+        for (uint64_t written = 0; written < Frames; written = TelemetryWriteIndex(view))
+        {
+            if (written < TelemetryRecordCount)
+                continue;
+
+            for (uint64_t frame = written - TelemetryRecordCount; frame < written - TelemetryRecordCount + 4; frame++)
+            {
+                if (!TelemetryReadRecord(view, frame, &record))
+                    continue;
+
+                accepted++;
+
+                if (!Matches(record, frame))
+                    torn++;
+            }
+        }
+
+        std::printf("Reader accepted %llu records, %llu torn\n", (unsigned long long) accepted,
+                    (unsigned long long) torn);
+        std::fflush(stdout);
+        _exit(torn == 0 && accepted > 0 ? 0 : 1);
+    }
+
+    TelemetryInitHeader(header, (uint32_t) getpid());
+
+    for (uint64_t frame = 0; frame < Frames; frame++)
+        TelemetryWriteRecord(header, MakeRecord(frame));
+
+    int status = 0;
+    CHECK(waitpid(reader, &status, 0) == reader);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    SharedFile::Unmap(header);
+}
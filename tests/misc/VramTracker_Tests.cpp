@@ -0,0 +1,106 @@
+#include <Test.h>
+
+#include <misc/VramTracker_Common.h>
+
+#include <cstring>
+
+TEST_CASE(AccountingTotalsPerOwner)
+{
+    VramAccounting accounting;
+
+    accounting.Add(0x1000, VramOwner::FrameGen, 100);
+    accounting.Add(0x2000, VramOwner::FrameGen, 50);
+    accounting.Add(0x3000, VramOwner::Hudfix, 30);
+
+    CHECK(accounting.Count() == 3);
+    CHECK(accounting.Total() == 180);
+    CHECK(accounting.Total(VramOwner::FrameGen) == 150);
+    CHECK(accounting.Total(VramOwner::Hudfix) == 30);
+    CHECK(accounting.Total(VramOwner::Overlay) == 0);
+}
+
+TEST_CASE(AccountingReplacesSameKey)
+{
+    VramAccounting accounting;
+
+    // Address reused by a new resource of another owner
+    accounting.Add(0x1000, VramOwner::FrameGen, 100);
+    accounting.Add(0x1000, VramOwner::Shaders, 40);
+
+    CHECK(accounting.Count() == 1);
+    CHECK(accounting.Total() == 40);
+    CHECK(accounting.Total(VramOwner::FrameGen) == 0);
+    CHECK(accounting.Total(VramOwner::Shaders) == 40);
+}
+
+TEST_CASE(AccountingRemoveAndClear)
+{
+    VramAccounting accounting;
+
+    accounting.Add(0x1000, VramOwner::Inputs, 64);
+    accounting.Add(0x2000, VramOwner::Overlay, 32);
+
+    CHECK(accounting.Remove(0x1000));
+    CHECK(!accounting.Remove(0x1000));
+    CHECK(!accounting.Remove(0x9000));
+    CHECK(accounting.Total() == 32);
+    CHECK(accounting.Total(VramOwner::Inputs) == 0);
+
+    accounting.Clear();
+    CHECK(accounting.Count() == 0);
+    CHECK(accounting.Total() == 0);
+    CHECK(accounting.Total(VramOwner::Overlay) == 0);
+}
+
+TEST_CASE(PressureWithoutBudget)
+{
+    CHECK(VramAccounting::Evaluate(100, 0, 0.9f, VramPressure::High) == VramPressure::None);
+}
+
+TEST_CASE(PressureLevels)
+{
+    CHECK(VramAccounting::Evaluate(50, 100, 0.9f, VramPressure::None) == VramPressure::None);
+    CHECK(VramAccounting::Evaluate(91, 100, 0.9f, VramPressure::None) == VramPressure::High);
+    CHECK(VramAccounting::Evaluate(101, 100, 0.9f, VramPressure::None) == VramPressure::Critical);
+}
+
+TEST_CASE(PressureHysteresis)
+{
+    // Lowered only after usage drops 5% of budget below the limit
+    CHECK(VramAccounting::Evaluate(88, 100, 0.9f, VramPressure::High) == VramPressure::High);
+    CHECK(VramAccounting::Evaluate(84, 100, 0.9f, VramPressure::High) == VramPressure::None);
+    CHECK(VramAccounting::Evaluate(88, 100, 0.9f, VramPressure::None) == VramPressure::None);
+
+    CHECK(VramAccounting::Evaluate(98, 100, 0.9f, VramPressure::Critical) == VramPressure::Critical);
+    CHECK(VramAccounting::Evaluate(94, 100, 0.9f, VramPressure::Critical) == VramPressure::High);
+    CHECK(VramAccounting::Evaluate(98, 100, 0.9f, VramPressure::None) == VramPressure::High);
+}
+
+TEST_CASE(PressureDoesNotFlipAroundThreshold)
+{
+    auto pressure = VramPressure::None;
+    int changes = 0;
+
+    // Usage oscillates 2% around the threshold
+    for (int i = 0; i < 100; i++)
+    {
+        uint64_t usage = (i % 2 == 0) ? 920 : 880;
+        auto next = VramAccounting::Evaluate(usage, 1000, 0.9f, pressure);
+
+        if (next != pressure)
+            changes++;
+
+        pressure = next;
+    }
+
+    CHECK(changes == 1);
+    CHECK(pressure == VramPressure::High);
+}
+
+TEST_CASE(OwnerNames)
+{
+    for (uint32_t i = 0; i < (uint32_t) VramOwner::Count; i++)
+        CHECK(std::strcmp(VramOwnerName((VramOwner) i), "Unknown") != 0);
+
+    CHECK(std::strcmp(VramOwnerName(VramOwner::Count), "Unknown") == 0);
+}
@@ -0,0 +1,118 @@
+#include <Test.h>
+
+#include <resource_tracking/FGHazard_Common.h>
+
+TEST_CASE(StartsLearningAndCopies)
+{
+    HazardLearner learner(3);
+
+    CHECK(learner.State() == HazardState::Learning);
+    CHECK(learner.NeedsCopy());
+    CHECK(learner.RequiredFrames() == 3);
+}
+
+TEST_CASE(CleanWindowsMakeItSafe)
+{
+    HazardLearner learner(3);
+
+    CHECK(!learner.Observe(false));
+    CHECK(!learner.Observe(false));
+    CHECK(learner.CleanFrames() == 2);
+    CHECK(learner.NeedsCopy());
+
+    CHECK(learner.Observe(false));
+    CHECK(learner.State() == HazardState::Safe);
+    CHECK(!learner.NeedsCopy());
+
+    // Still watched but nothing changes while clean
+    CHECK(!learner.Observe(false));
+    CHECK(learner.State() == HazardState::Safe);
+}
+
+TEST_CASE(WriteWhileLearningIsHazard)
+{
+    HazardLearner learner(3);
+
+    learner.Observe(false);
+    learner.Observe(false);
+    CHECK(learner.Observe(true));
+    CHECK(learner.State() == HazardState::Hazard);
+    CHECK(learner.CleanFrames() == 0);
+
+    // Hazard is final, clean windows don't bring it back
+    for (int i = 0; i < 10; i++)
+        CHECK(!learner.Observe(false));
+
+    CHECK(!learner.Observe(true));
+    CHECK(learner.NeedsCopy());
+}
+
+TEST_CASE(WriteAfterSafeIsHazard)
+{
+    HazardLearner learner(2);
+
+    learner.Observe(false);
+    learner.Observe(false);
+    CHECK(learner.State() == HazardState::Safe);
+
+    CHECK(learner.Observe(true));
+    CHECK(learner.State() == HazardState::Hazard);
+    CHECK(learner.NeedsCopy());
+}
+
+TEST_CASE(RestoreFromConfig)
+{
+    HazardLearner learner(3);
+
+    // Safe is learned again, game might write the input after an update
+    learner.Restore(false);
+    CHECK(learner.State() == HazardState::Learning);
+    CHECK(learner.NeedsCopy());
+
+    learner.Restore(true);
+    CHECK(learner.State() == HazardState::Hazard);
+
+    learner.Observe(false);
+    learner.Restore(std::nullopt);
+    CHECK(learner.State() == HazardState::Learning);
+    CHECK(learner.CleanFrames() == 0);
+}
+
+TEST_CASE(ResetStartsOver)
+{
+    HazardLearner learner(2);
+
+    learner.Observe(true);
+    learner.Reset();
+    CHECK(learner.State() == HazardState::Learning);
+
+    learner.Observe(false);
+    learner.Observe(false);
+    CHECK(learner.State() == HazardState::Safe);
+}
+
+TEST_CASE(ForcedHazardIsNeverSafe)
+{
+    HazardLearner learner(2);
+
+    learner.Observe(false);
+    learner.Observe(false);
+    CHECK(learner.State() == HazardState::Safe);
+
+    CHECK(learner.ForceHazard());
+    CHECK(learner.State() == HazardState::Hazard);
+    CHECK(learner.Forced());
+    CHECK(!learner.ForceHazard());
+
+    // Relearning and config values don't bring it back
+    learner.Reset();
+    CHECK(learner.State() == HazardState::Hazard);
+
+    learner.Restore(std::nullopt);
+    CHECK(learner.State() == HazardState::Hazard);
+
+    for (int i = 0; i < 10; i++)
+        learner.Observe(false);
+
+    CHECK(learner.NeedsCopy());
+}
@@ -0,0 +1,105 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Cost of a tracking hook which stays attached and returns right away when its tracking mode is off.
+// Same shape as hkCopyDescriptorsSimple: game calls through the vtable, hook checks the atomic mode and
+// calls the original through the saved pointer. Detours' own jump to the hook is not included.
+// Usage: HookGate_Bench [calls per thread] [threads]
+
+enum class Mode : uint32_t
+{
+    Off,
+    Descriptors,
+    Full
+};
+
+typedef void (*PFN_Copy)(uint8_t* dest, const uint8_t* src);
+
+static std::atomic<Mode> _mode { Mode::Off };
+static PFN_Copy o_Copy = nullptr;
+
+// Stands for the driver's descriptor copy
+__attribute__((noinline)) static void Copy(uint8_t* dest, const uint8_t* src) { memcpy(dest, src, 32); }
+
+__attribute__((noinline)) static void hkCopy(uint8_t* dest, const uint8_t* src)
+{
+    if (_mode.load(std::memory_order_relaxed) < Mode::Descriptors)
+    {
+        o_Copy(dest, src);
+        return;
+    }
+
+    o_Copy(dest, src);
+    dest[0] ^= 1; // tracking work would be here
+}
+
+// Returns ns per call, vtable entry is volatile so the call stays indirect
+static double Run(PFN_Copy entry, uint64_t calls, uint32_t threads)
+{
+    std::atomic<bool> start = false;
+    std::vector<std::thread> workers;
+    std::vector<double> results(threads);
+
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back(
+            [&, t]()
+            {
+                uint8_t heap[64 * 32] = {};
+                uint8_t source[32] = { 1 };
+                volatile PFN_Copy vtable = entry;
+
+                while (!start.load())
+                    std::this_thread::yield();
+
+                auto begin = std::chrono::steady_clock::now();
+
+                for (uint64_t i = 0; i < calls; i++)
+                    vtable(&heap[(i & 63) * 32], source);
+
+                auto end = std::chrono::steady_clock::now();
+                results[t] = std::chrono::duration<double, std::nano>(end - begin).count() / calls;
+            });
+    }
+
+    start = true;
+
+    for (auto& worker : workers)
+        worker.join();
+
+    double sum = 0.0;
+
+    for (auto result : results)
+        sum += result;
+
+    return sum / threads;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+    uint32_t threads = argc > 2 ? (uint32_t) std::strtoul(argv[2], nullptr, 10) : 1;
+
+    if (calls == 0 || threads == 0)
+        return 1;
+
+    o_Copy = Copy;
+
+    // Warm up
+    Run(Copy, calls / 10, threads);
+    Run(hkCopy, calls / 10, threads);
+
+    auto direct = Run(Copy, calls, threads);
+    auto gated = Run(hkCopy, calls, threads);
+
+    std::printf("%llu calls on %u threads\n", (unsigned long long) calls, threads);
+    std::printf("Not hooked:           %.2f ns/call\n", direct);
+    std::printf("Hooked, mode is off:  %.2f ns/call (+%.2f)\n", gated, gated - direct);
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+#include <Test.h>
+
+#include <resource_tracking/ResTrack_Vk_Common.h>
+
+static constexpr VkHandleValue Pool = 0x100;
+static constexpr VkHandleValue OtherPool = 0x200;
+static constexpr VkHandleValue Layout = 0x300;
+static constexpr VkHandleValue SparseLayout = 0x400;
+static constexpr VkHandleValue SetA = 0x1000;
+static constexpr VkHandleValue SetB = 0x2000;
+
+static DescriptorWrite Tracked(VkHandleValue view) { return { view, 5, true }; }
+
+static std::vector<DescriptorImageInfo> Images(const DescriptorSetTracker& tracker, VkHandleValue set)
+{
+    std::vector<DescriptorImageInfo> images;
+    tracker.GetImages(set, images);
+    return images;
+}
+
+static bool HasImage(const DescriptorSetTracker& tracker, VkHandleValue set, uint32_t binding, uint32_t arrayElement,
+                     VkHandleValue view)
+{
+    for (auto& image : Images(tracker, set))
+    {
+        if (image.binding == binding && image.arrayElement == arrayElement)
+            return image.view == view;
+    }
+
+    return false;
+}
+
+// Binding 0: 2 descriptors, binding 1: empty, binding 2: 3 descriptors
+static void AddLayouts(DescriptorSetTracker& tracker)
+{
+    tracker.AddLayout(Layout, { { 0, 2 }, { 1, 0 }, { 2, 3 } });
+
+    // Binding numbers don't need to be continuous or ordered
+    tracker.AddLayout(SparseLayout, { { 4, 1 }, { 1, 2 } });
+}
+
+TEST_CASE(NextDescriptorRollsOver)
+{
+    std::vector<uint32_t> counts { 2, 0, 3 };
+
+    uint32_t binding = 0;
+    uint32_t element = 1;
+
+    DescriptorSetTracker::NextDescriptor(&counts, binding, element, true);
+    CHECK(binding == 2 && element == 0);
+
+    // Start position past the end of the array also rolls over
+    binding = 0;
+    element = 4;
+    DescriptorSetTracker::NextDescriptor(&counts, binding, element, false);
+    CHECK(binding == 2 && element == 2);
+
+    // Unknown layout keeps counting in the same binding
+    binding = 0;
+    element = 1;
+    DescriptorSetTracker::NextDescriptor(nullptr, binding, element, true);
+    CHECK(binding == 0 && element == 2);
+}
+
+TEST_CASE(WriteRollsOverIntoNextBinding)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+
+    DescriptorWrite writes[] = { Tracked(0xA1), Tracked(0xA2), Tracked(0xA3) };
+    tracker.Write(SetA, 0, 1, writes, 3);
+
+    CHECK(Images(tracker, SetA).size() == 3);
+    CHECK(HasImage(tracker, SetA, 0, 1, 0xA1));
+    CHECK(HasImage(tracker, SetA, 2, 0, 0xA2));
+    CHECK(HasImage(tracker, SetA, 2, 1, 0xA3));
+}
+
+TEST_CASE(SparseLayoutBindings)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, SparseLayout, SetA);
+
+    // Bindings 0, 2 & 3 are missing, binding 1 has 2 descriptors
+    DescriptorWrite writes[] = { Tracked(0xB1), Tracked(0xB2), Tracked(0xB3) };
+    tracker.Write(SetA, 1, 0, writes, 3);
+
+    CHECK(HasImage(tracker, SetA, 1, 0, 0xB1));
+    CHECK(HasImage(tracker, SetA, 1, 1, 0xB2));
+    CHECK(HasImage(tracker, SetA, 4, 0, 0xB3));
+}
+
+TEST_CASE(UntrackedWriteClearsEntry)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+
+    DescriptorWrite first[] = { Tracked(0xA1), Tracked(0xA2) };
+    tracker.Write(SetA, 0, 0, first, 2);
+
+    // Replaced by a buffer view or an image which is not a candidate
+    DescriptorWrite second[] = { Tracked(0xC1), { 0xC2, 0, false } };
+    tracker.Write(SetA, 0, 0, second, 2);
+
+    CHECK(Images(tracker, SetA).size() == 1);
+    CHECK(HasImage(tracker, SetA, 0, 0, 0xC1));
+}
+
+TEST_CASE(SetWithoutLayoutIsTracked)
+{
+    DescriptorSetTracker tracker;
+
+    // Allocated before hooking, first tracked write creates the entry
+    DescriptorWrite untracked[] = { { 0xA1, 0, false } };
+    tracker.Write(SetA, 0, 0, untracked, 1);
+    CHECK(tracker.SetCount() == 0);
+
+    DescriptorWrite writes[] = { Tracked(0xA1), Tracked(0xA2), Tracked(0xA3) };
+    tracker.Write(SetA, 0, 0, writes, 3);
+
+    CHECK(tracker.SetCount() == 1);
+    CHECK(HasImage(tracker, SetA, 0, 2, 0xA3));
+}
+
+TEST_CASE(CopyRollsOverIndependently)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+    tracker.Allocate(Pool, SparseLayout, SetB);
+
+    DescriptorWrite writes[] = { Tracked(0xA1), Tracked(0xA2), Tracked(0xA3) };
+    tracker.Write(SetA, 0, 1, writes, 3);
+
+    // Source: (0,1) (2,0) (2,1), destination: (1,1) (4,0)
+    tracker.Copy(SetA, 0, 1, SetB, 1, 1, 2);
+
+    CHECK(Images(tracker, SetB).size() == 2);
+    CHECK(HasImage(tracker, SetB, 1, 1, 0xA1));
+    CHECK(HasImage(tracker, SetB, 4, 0, 0xA2));
+
+    // Copying empty descriptors clears the destination
+    tracker.Copy(SetA, 0, 0, SetB, 1, 1, 1);
+    CHECK(Images(tracker, SetB).size() == 1);
+    CHECK(!HasImage(tracker, SetB, 1, 1, 0xA1));
+}
+
+TEST_CASE(CopyInsideSameSet)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+
+    DescriptorWrite writes[] = { Tracked(0xA1), Tracked(0xA2) };
+    tracker.Write(SetA, 0, 0, writes, 2);
+
+    // Ranges of the same set must not overlap
+    tracker.Copy(SetA, 0, 0, SetA, 2, 1, 2);
+
+    CHECK(Images(tracker, SetA).size() == 4);
+    CHECK(HasImage(tracker, SetA, 2, 1, 0xA1));
+    CHECK(HasImage(tracker, SetA, 2, 2, 0xA2));
+}
+
+TEST_CASE(FreeAndRecycledHandle)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+
+    DescriptorWrite writes[] = { Tracked(0xA1) };
+    tracker.Write(SetA, 2, 0, writes, 1);
+
+    // Driver returns the same handle from another pool, old bindings must not be reported
+    tracker.Allocate(OtherPool, SparseLayout, SetA);
+
+    CHECK(Images(tracker, SetA).size() == 0);
+    CHECK(tracker.PoolSetCount(Pool) == 0);
+    CHECK(tracker.PoolSetCount(OtherPool) == 1);
+
+    tracker.Free(SetA);
+    CHECK(tracker.SetCount() == 0);
+    CHECK(tracker.PoolSetCount(OtherPool) == 0);
+
+    // Freeing twice or unknown sets is harmless
+    tracker.Free(SetA);
+    tracker.Free(SetB);
+    CHECK(tracker.SetCount() == 0);
+}
+
+TEST_CASE(ResetAndDestroyPool)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+    tracker.Allocate(OtherPool, Layout, SetB);
+
+    DescriptorWrite writes[] = { Tracked(0xA1) };
+    tracker.Write(SetA, 0, 0, writes, 1);
+    tracker.Write(SetB, 0, 0, writes, 1);
+
+    tracker.ResetPool(Pool);
+    CHECK(Images(tracker, SetA).size() == 0);
+    CHECK(Images(tracker, SetB).size() == 1);
+    CHECK(tracker.SetCount() == 1);
+
+    // Pool stays usable after reset
+    tracker.Allocate(Pool, Layout, SetA);
+    CHECK(tracker.PoolSetCount(Pool) == 1);
+
+    tracker.DestroyPool(Pool);
+    tracker.DestroyPool(OtherPool);
+    CHECK(tracker.SetCount() == 0);
+    CHECK(tracker.PoolSetCount(Pool) == 0);
+}
+
+TEST_CASE(DestroyedLayoutKeepsAllocatedSets)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+    tracker.Allocate(Pool, Layout, SetA);
+
+    tracker.RemoveLayout(Layout);
+
+    // Allocated set still rolls over with its own binding counts
+    DescriptorWrite writes[] = { Tracked(0xA1), Tracked(0xA2) };
+    tracker.Write(SetA, 0, 1, writes, 2);
+    CHECK(HasImage(tracker, SetA, 2, 0, 0xA2));
+
+    // New allocations with the destroyed layout don't roll over
+    tracker.Allocate(Pool, Layout, SetB);
+    tracker.Write(SetB, 0, 1, writes, 2);
+    CHECK(HasImage(tracker, SetB, 0, 2, 0xA2));
+}
+
+TEST_CASE(ReplayBindsOnlyLiveSets)
+{
+    DescriptorSetTracker tracker;
+    AddLayouts(tracker);
+
+    // Per frame pool pattern: allocate, update, bind, reset
+    for (uint32_t frame = 0; frame < 64; frame++)
+    {
+        VkHandleValue pool = (frame % 2) == 0 ? Pool : OtherPool;
+        tracker.ResetPool(pool);
+
+        for (VkHandleValue i = 0; i < 8; i++)
+        {
+            // Handles are recycled between pools like drivers do
+            VkHandleValue set = SetA + ((frame + i) % 12);
+            tracker.Allocate(pool, Layout, set);
+
+            DescriptorWrite writes[] = { Tracked(0x10000 + frame * 16 + i) };
+            tracker.Write(set, 2, 2, writes, 1);
+
+            auto images = Images(tracker, set);
+            CHECK(images.size() == 1);
+            CHECK(images[0].view == 0x10000 + frame * 16 + i);
+        }
+
+        CHECK(tracker.SetCount() <= 12);
+        CHECK(tracker.PoolSetCount(Pool) + tracker.PoolSetCount(OtherPool) == tracker.SetCount());
+    }
+}
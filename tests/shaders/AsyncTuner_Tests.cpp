@@ -0,0 +1,102 @@
+#include <Test.h>
+
+#include <shaders/AsyncCompute_Common.h>
+
+// Runs frames until the current probe is finished, latency of each mode is given
+static void RunProbe(AsyncTuner& tuner, double inlineMs, double asyncMs)
+{
+    for (int i = 0; i < 1000 && tuner.Probing(); i++)
+    {
+        auto async = tuner.NextAsync();
+        tuner.AddSample(async, async ? asyncMs : inlineMs);
+    }
+}
+
+TEST_CASE(ProbeAlternatesModes)
+{
+    AsyncTuner tuner(4, 10, 0.05);
+
+    CHECK(tuner.Probing());
+    CHECK(!tuner.NextAsync());
+    CHECK(tuner.NextAsync());
+    CHECK(!tuner.NextAsync());
+    CHECK(tuner.NextAsync());
+}
+
+TEST_CASE(SwitchesToFasterMode)
+{
+    AsyncTuner tuner(4, 10, 0.05);
+
+    RunProbe(tuner, 2.0, 1.5);
+
+    CHECK(!tuner.Probing());
+    CHECK(tuner.Async());
+    CHECK_NEAR(tuner.Average(false), 2.0, 1e-9);
+    CHECK_NEAR(tuner.Average(true), 1.5, 1e-9);
+
+    // Kept between probes
+    for (int i = 0; i < 5; i++)
+        CHECK(tuner.NextAsync());
+}
+
+TEST_CASE(MarginKeepsCurrentMode)
+{
+    AsyncTuner tuner(4, 10, 0.05);
+
+    // Async is 2% faster, not enough to switch
+    RunProbe(tuner, 2.0, 1.96);
+    CHECK(!tuner.Async());
+
+    AsyncTuner slower(4, 10, 0.05);
+    RunProbe(slower, 1.0, 3.0);
+    CHECK(!slower.Async());
+}
+
+TEST_CASE(ProbesAgainAfterSettle)
+{
+    AsyncTuner tuner(4, 10, 0.05);
+
+    RunProbe(tuner, 2.0, 1.0);
+    CHECK(tuner.Async());
+
+    for (int i = 0; i < 10; i++)
+        tuner.NextAsync();
+
+    CHECK(tuner.Probing());
+
+    // Async got slower meanwhile
+    RunProbe(tuner, 1.0, 2.0);
+    CHECK(!tuner.Async());
+}
+
+TEST_CASE(IgnoresInvalidSamples)
+{
+    AsyncTuner tuner(2, 10, 0.05);
+
+    CHECK(!tuner.AddSample(false, 0.0));
+    CHECK(!tuner.AddSample(true, -1.0));
+    CHECK(!tuner.AddSample(false, 1.0));
+    CHECK(!tuner.AddSample(false, 1.0));
+    CHECK(!tuner.AddSample(true, 0.5));
+
+    // Probe needs samples of both modes
+    CHECK(tuner.AddSample(true, 0.5));
+    CHECK(tuner.Async());
+
+    // Not probing, samples are dropped
+    CHECK(!tuner.AddSample(false, 0.1));
+}
+
+TEST_CASE(ResetStartsNewProbe)
+{
+    AsyncTuner tuner(4, 10, 0.05);
+
+    RunProbe(tuner, 2.0, 1.0);
+    tuner.Reset();
+
+    CHECK(tuner.Probing());
+    CHECK(!tuner.Async());
+    CHECK(tuner.Average(false) == 0.0);
+    CHECK(tuner.Average(true) == 0.0);
+    CHECK(!tuner.NextAsync());
+}
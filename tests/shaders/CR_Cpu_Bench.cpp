@@ -0,0 +1,77 @@
+#include "CR_Cpu_Images.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+// Throughput of CPU reference passes at 1080p, optional argument is the iteration count
+// Results are megapixels of output per second on a single thread
+static void Measure(const char* name, uint32_t width, uint32_t height, int iterations, const std::function<void()>& run)
+{
+    // Warm up caches and allocations
+    run();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+        run();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    double perRun = elapsed.count() / iterations;
+    double mpixels = (double) width * height / 1000000.0;
+
+    std::printf("%-28s %9.3f ms %9.1f MPix/s\n", name, perRun, mpixels / (perRun / 1000.0));
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+    constexpr uint32_t width = 1920;
+    constexpr uint32_t height = 1080;
+
+    auto source = CrImages::Noise(width, height, 1);
+    auto other = CrImages::Noise(width, height, 2);
+    CpuImage dest(width, height);
+    CpuImage display(2560, 1440);
+    CpuImage half(width / 2, height / 2);
+    std::vector<uint32_t> packed;
+    uint32_t histogram[Hudfix_Common::ValidationBinCount];
+
+    CpuRcasConstants rcas;
+    rcas.sharpness = 0.6f;
+
+    CpuFIConstants fi { true, true, true, width, height, 0, width, height, 0, 0.5f };
+    CpuImage depthOut(width, height);
+
+    Measure("Bias", width, height, iterations, [&] { CR_Cpu::Bias(source, 0.5f, dest); });
+    Measure("DepthScale", width, height, iterations, [&] { CR_Cpu::DepthScale(source, 0.5f, dest); });
+    Measure("FormatTransfer", width, height, iterations,
+            [&] { CR_Cpu::FormatTransfer(source, CpuPackedFormat::R10G10B10A2, packed); });
+    Measure("ResourceFlip", width, height, iterations,
+            [&] { CR_Cpu::ResourceFlip(source, width, height, 0, true, dest); });
+    Measure("PrepareFGInputs", width, height, iterations,
+            [&] { CR_Cpu::PrepareFGInputs(source, other, fi, dest, depthOut); });
+    Measure("HudlessCompare", width, height, iterations,
+            [&] { CR_Cpu::HudlessCompare(source, other, 0.1f, 1.0f, dest); });
+    Measure("HudlessHistogram", width, height, iterations,
+            [&] { CR_Cpu::HudlessHistogram(source, other, histogram); });
+    Measure("Rcas", width, height, iterations, [&] { CR_Cpu::Rcas(source, nullptr, rcas, dest); });
+    Measure("OutputScaling_BCUS", display.width, display.height, iterations,
+            [&] { CR_Cpu::OutputScaling(source, 0, true, display); });
+
+    const char* downscalers[] = { "OutputScaling_Bicubic", "OutputScaling_Lanczos", "OutputScaling_CatmullRom",
+                                  "OutputScaling_MAGC" };
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Measure(downscalers[i], half.width, half.height, iterations,
+                [&] { CR_Cpu::OutputScaling(source, i, false, half); });
+    }
+
+    Measure("RcasOutputScaling", display.width, display.height, iterations,
+            [&] { CR_Cpu::RcasOutputScaling(source, nullptr, rcas, true, display); });
+
+    return 0;
+}
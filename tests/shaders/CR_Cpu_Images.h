@@ -0,0 +1,78 @@
+#pragma once
+
+#include <shaders/cpu_reference/CR_Cpu.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Deterministic inputs of CR_Cpu tests & benchmark, same on every platform
+namespace CrImages
+{
+inline CpuImage Noise(uint32_t width, uint32_t height, uint32_t seed, float minValue = 0.0f, float maxValue = 1.0f)
+{
+    CpuImage image(width, height);
+    uint32_t state = seed * 747796405u + 2891336453u;
+
+    for (auto& value : image.pixels)
+    {
+        // LCG, top 24 bits are exact in float
+        state = state * 1664525u + 1013904223u;
+        value = minValue + (maxValue - minValue) * (float) (state >> 8) / 16777216.0f;
+    }
+
+    return image;
+}
+
+inline CpuImage Constant(uint32_t width, uint32_t height, float r, float g, float b, float a)
+{
+    CpuImage image(width, height);
+
+    for (size_t i = 0; i < image.pixels.size(); i += 4)
+    {
+        image.pixels[i] = r;
+        image.pixels[i + 1] = g;
+        image.pixels[i + 2] = b;
+        image.pixels[i + 3] = a;
+    }
+
+    return image;
+}
+
+// FNV-1a of values rounded to 1/4096, tolerates last bit differences of the math library
+inline uint64_t Checksum(const float* values, size_t count)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto quantized = (int64_t) std::llround((double) values[i] * 4096.0);
+
+        for (int b = 0; b < 8; b++)
+        {
+            hash ^= (uint8_t) (quantized >> (b * 8));
+            hash *= 1099511628211ull;
+        }
+    }
+
+    return hash;
+}
+
+inline uint64_t Checksum(const std::vector<uint32_t>& values)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (auto value : values)
+    {
+        for (int b = 0; b < 4; b++)
+        {
+            hash ^= (uint8_t) (value >> (b * 8));
+            hash *= 1099511628211ull;
+        }
+    }
+
+    return hash;
+}
+
+inline uint64_t Checksum(const CpuImage& image) { return Checksum(image.pixels.data(), image.pixels.size()); }
+} // namespace CrImages
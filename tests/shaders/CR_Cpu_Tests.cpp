@@ -0,0 +1,386 @@
+#include <Test.h>
+
+#include "CR_Cpu_Images.h"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <functional>
+
+TEST_CASE(BiasScalesRed)
+{
+    auto source = CrImages::Noise(5, 3, 1);
+    CpuImage dest;
+
+    CR_Cpu::Bias(source, 0.25f, dest);
+
+    for (size_t i = 0; i < source.pixels.size(); i++)
+        CHECK(dest.pixels[i] == (i % 4 == 0 ? source.pixels[i] * 0.25f : source.pixels[i]));
+}
+
+TEST_CASE(DepthScaleSaturates)
+{
+    // 7 pixels, last 3 go through the scalar tail
+    auto source = CrImages::Noise(7, 1, 2, -0.5f, 1.5f);
+    CpuImage dest;
+
+    CR_Cpu::DepthScale(source, 0.5f, dest);
+
+    for (uint32_t x = 0; x < source.width; x++)
+    {
+        auto expected = std::fmin(std::fmax(source.At(x, 0)[0] / 0.5f, 0.0f), 1.0f);
+        CHECK(dest.At(x, 0)[0] == expected);
+        CHECK(dest.At(x, 0)[1] == 0.0f);
+    }
+}
+
+TEST_CASE(FormatTransferPacking)
+{
+    auto source = CrImages::Constant(2, 1, 1.0f, 0.5f, 0.0f, 1.0f);
+    source.At(1, 0)[0] = 2.0f;  // Saturated
+    source.At(1, 0)[2] = -1.0f; // Saturated
+
+    std::vector<uint32_t> packed;
+
+    CHECK(CR_Cpu::FormatTransfer(source, CpuPackedFormat::R8G8B8A8, packed));
+    CHECK(packed.size() == 2);
+    CHECK(packed[0] == 0xFF007FFF);
+    CHECK(packed[1] == packed[0]);
+
+    CHECK(CR_Cpu::FormatTransfer(source, CpuPackedFormat::B8G8R8A8, packed));
+    CHECK(packed[0] == 0xFF7FFF00);
+
+    CHECK(CR_Cpu::FormatTransfer(source, CpuPackedFormat::R10G10B10A2, packed));
+    CHECK(packed[0] == (1023u | 511u << 10 | 3u << 30));
+
+    CHECK(!CR_Cpu::FormatTransfer(source, (CpuPackedFormat) 99, packed));
+}
+
+TEST_CASE(ResourceFlipRowsAndVelocity)
+{
+    auto source = CrImages::Noise(4, 6, 3);
+    CpuImage dest(4, 6);
+
+    CR_Cpu::ResourceFlip(source, 4, 5, 0, true, dest);
+
+    for (uint32_t y = 0; y < 5; y++)
+    {
+        for (uint32_t x = 0; x < 4; x++)
+        {
+            auto src = source.At(x, y);
+            auto dst = dest.At(x, 4 - y);
+
+            CHECK(dst[0] == src[0]);
+            CHECK(dst[1] == -src[1]);
+            CHECK(dst[2] == 0.0f);
+        }
+    }
+
+    // Nothing is written below the flipped area
+    CHECK(dest.At(0, 5)[0] == 0.0f);
+
+    // Like RF shader, offset is skipped in source and subtracted from target row, rows above 0 are dropped
+    CpuImage offsetDest(4, 6);
+    CR_Cpu::ResourceFlip(source, 4, 5, 1, false, offsetDest);
+
+    for (uint32_t y = 1; y < 4; y++)
+        CHECK(offsetDest.At(2, 3 - y)[1] == source.At(2, y)[1]);
+
+    CHECK(offsetDest.At(2, 3)[1] == 0.0f);
+}
+
+// FI_Dx12 replaces RF_Dx12 for velocity & depth and DS_Dx12 for depth, results should stay the same
+TEST_CASE(PrepareFGInputsMatchesSeparatePasses)
+{
+    auto velocity = CrImages::Noise(37, 23, 7, -4.0f, 4.0f);
+    auto depth = CrImages::Noise(30, 21, 8, 0.0f, 1.2f);
+
+    for (uint32_t flags = 0; flags < 8; flags++)
+    {
+        CpuFIConstants constants;
+        constants.flipVelocity = (flags & 1) != 0;
+        constants.flipDepth = (flags & 2) != 0;
+        constants.scaleDepth = (flags & 4) != 0;
+        constants.velocityWidth = 37;
+        constants.velocityHeight = 20;
+        constants.velocityOffset = 2;
+        constants.depthWidth = 30;
+        constants.depthHeight = 20;
+        constants.depthOffset = 1;
+        constants.depthScale = 0.8f;
+
+        CpuImage fusedVelocity;
+        CpuImage fusedDepth;
+        CR_Cpu::PrepareFGInputs(velocity, depth, constants, fusedVelocity, fusedDepth);
+
+        auto expectedVelocity = velocity;
+
+        if (constants.flipVelocity)
+        {
+            expectedVelocity = CpuImage(velocity.width, velocity.height);
+            CR_Cpu::ResourceFlip(velocity, 37, 20, 2, true, expectedVelocity);
+        }
+        else
+        {
+            // Not flipped rows are copied up to velocityHeight
+            for (uint32_t y = 20; y < velocity.height; y++)
+            {
+                for (uint32_t x = 0; x < velocity.width; x++)
+                    expectedVelocity.At(x, y)[0] = expectedVelocity.At(x, y)[1] = 0.0f;
+            }
+        }
+
+        auto expectedDepth = depth;
+
+        if (constants.flipDepth)
+        {
+            expectedDepth = CpuImage(depth.width, depth.height);
+            CR_Cpu::ResourceFlip(depth, 30, 20, 1, false, expectedDepth);
+        }
+        else
+        {
+            for (uint32_t x = 0; x < depth.width; x++)
+                expectedDepth.At(x, 20)[0] = 0.0f;
+        }
+
+        if (constants.scaleDepth)
+            CR_Cpu::DepthScale(CpuImage(expectedDepth), 0.8f, expectedDepth);
+
+        // Outputs are R16G16 velocity and R32 depth
+        bool velocityMatches = true;
+        bool depthMatches = true;
+
+        for (uint32_t y = 0; y < velocity.height; y++)
+        {
+            for (uint32_t x = 0; x < velocity.width; x++)
+            {
+                velocityMatches &= fusedVelocity.At(x, y)[0] == expectedVelocity.At(x, y)[0];
+                velocityMatches &= fusedVelocity.At(x, y)[1] == expectedVelocity.At(x, y)[1];
+            }
+        }
+
+        for (uint32_t y = 0; y < depth.height; y++)
+        {
+            for (uint32_t x = 0; x < depth.width; x++)
+                depthMatches &= fusedDepth.At(x, y)[0] == expectedDepth.At(x, y)[0];
+        }
+
+        CHECK(velocityMatches);
+        CHECK(depthMatches);
+    }
+}
+
+TEST_CASE(HistogramCountsCells)
+{
+    auto hudless = CrImages::Noise(20, 12, 4);
+    auto backBuffer = hudless;
+    uint32_t histogram[Hudfix_Common::ValidationBinCount];
+
+    // 3x2 cells, last ones are clamped to the edge
+    CHECK(CR_Cpu::HudlessHistogram(hudless, backBuffer, histogram));
+    CHECK(histogram[0] == 6);
+
+    // Center of the first cell
+    backBuffer.At(4, 4)[1] += 0.5f;
+    CHECK(CR_Cpu::HudlessHistogram(hudless, backBuffer, histogram));
+    CHECK(histogram[0] == 5);
+    CHECK(histogram[Hudfix_Common::ValidationBin(0.5f)] == 1);
+
+    CpuImage other(19, 12);
+    CHECK(!CR_Cpu::HudlessHistogram(hudless, other, histogram));
+}
+
+TEST_CASE(RcasKeepsFlatImage)
+{
+    auto source = CrImages::Constant(6, 6, 0.25f, 0.5f, 0.75f, 1.0f);
+    CpuImage dest;
+    CpuRcasConstants constants;
+    constants.sharpness = 1.0f;
+
+    CR_Cpu::Rcas(source, nullptr, constants, dest);
+
+    // Edges see 0 outside, inner pixels have a flat ring
+    for (uint32_t y = 1; y < 5; y++)
+    {
+        for (uint32_t x = 1; x < 5; x++)
+        {
+            for (int c = 0; c < 4; c++)
+                CHECK_NEAR(dest.At(x, y)[c], source.At(x, y)[c], 1e-6);
+        }
+    }
+
+    constants.sharpness = 0.0f;
+    CR_Cpu::Rcas(source, nullptr, constants, dest);
+    CHECK(dest.pixels == source.pixels);
+}
+
+TEST_CASE(OutputScalingKeepsConstant)
+{
+    auto source = CrImages::Constant(16, 12, 0.2f, 0.4f, 0.6f, 1.0f);
+
+    // Normalized downscalers, Lanczos, Catmull-Rom & MAGC
+    for (uint32_t downscaler = 1; downscaler <= 3; downscaler++)
+    {
+        CpuImage dest(10, 7);
+        CHECK(CR_Cpu::OutputScaling(source, downscaler, false, dest));
+
+        for (size_t i = 0; i < dest.pixels.size(); i++)
+            CHECK_NEAR(dest.pixels[i], source.pixels[i % 4], 1e-5);
+    }
+
+    // BCUS weights sum to 1 away from the edges
+    CpuImage dest(24, 18);
+    CHECK(CR_Cpu::OutputScaling(source, 0, true, dest));
+
+    for (uint32_t y = 4; y < 14; y++)
+    {
+        for (uint32_t x = 4; x < 20; x++)
+            CHECK_NEAR(dest.At(x, y)[1], 0.4f, 1e-5);
+    }
+
+    CpuImage empty;
+    CHECK(!CR_Cpu::OutputScaling(source, 0, true, empty));
+}
+
+TEST_CASE(RcasOutputScalingZeroFillsEdges)
+{
+    auto source = CrImages::Constant(16, 12, 0.5f, 0.5f, 0.5f, 1.0f);
+    CpuRcasConstants constants;
+    constants.sharpness = 0.0f;
+
+    CpuImage dest(24, 18);
+    CHECK(CR_Cpu::RcasOutputScaling(source, nullptr, constants, true, dest));
+
+    // Same with the unfused passes, bicubic footprint reads 0 outside of the source
+    CHECK(dest.At(0, 0)[0] < 0.5f);
+    CHECK_NEAR(dest.At(12, 9)[0], 0.5f, 1e-5);
+}
+
+// Checksums of pass outputs on noise images, run with OPTISCALER_PRINT_GOLDEN=1 to print new values
+// after an intended change of a pass and update the table
+struct GoldenPass
+{
+    const char* name;
+    uint64_t checksum;
+    std::function<uint64_t()> run;
+};
+
+static uint64_t Downscale(uint32_t downscaler)
+{
+    CpuImage dest(24, 15);
+    CR_Cpu::OutputScaling(CrImages::Noise(37, 23, 1), downscaler, false, dest);
+    return CrImages::Checksum(dest);
+}
+
+static uint64_t RcasWith(float sharpness, float contrast, bool dynamic)
+{
+    auto source = CrImages::Noise(37, 23, 1);
+    auto motion = CrImages::Noise(37, 23, 5, -8.0f, 8.0f);
+
+    CpuRcasConstants constants;
+    constants.sharpness = sharpness;
+    constants.contrast = contrast;
+    constants.dynamicSharpenEnabled = dynamic;
+    constants.displaySizeMV = true;
+
+    CpuImage dest;
+    CR_Cpu::Rcas(source, dynamic ? &motion : nullptr, constants, dest);
+    return CrImages::Checksum(dest);
+}
+
+static uint64_t RcasOs(bool upsample)
+{
+    CpuRcasConstants constants;
+    constants.sharpness = 0.6f;
+
+    CpuImage dest(upsample ? 61 : 24, upsample ? 40 : 15);
+    CR_Cpu::RcasOutputScaling(CrImages::Noise(37, 23, 1), nullptr, constants, upsample, dest);
+    return CrImages::Checksum(dest);
+}
+
+static uint64_t Pack(CpuPackedFormat format)
+{
+    std::vector<uint32_t> packed;
+    CR_Cpu::FormatTransfer(CrImages::Noise(37, 23, 1, -0.1f, 1.1f), format, packed);
+    return CrImages::Checksum(packed);
+}
+
+static const GoldenPass GoldenPasses[] = {
+    { "Bias", 0xC69784B1683039E2,
+      []
+      {
+          CpuImage dest;
+          CR_Cpu::Bias(CrImages::Noise(37, 23, 1), 0.5f, dest);
+          return CrImages::Checksum(dest);
+      } },
+    { "DepthScale", 0xF16CAC3A41C8FB05,
+      []
+      {
+          CpuImage dest;
+          CR_Cpu::DepthScale(CrImages::Noise(37, 23, 1), 0.8f, dest);
+          return CrImages::Checksum(dest);
+      } },
+    { "FormatTransfer_R10G10B10A2", 0xAB000223CAAD90F8, [] { return Pack(CpuPackedFormat::R10G10B10A2); } },
+    { "FormatTransfer_R8G8B8A8", 0x51A657BF94B48C8B, [] { return Pack(CpuPackedFormat::R8G8B8A8); } },
+    { "FormatTransfer_B8G8R8A8", 0x204AF8604B022A6D, [] { return Pack(CpuPackedFormat::B8G8R8A8); } },
+    { "ResourceFlip", 0xF5455E9DC18DFA04,
+      []
+      {
+          CpuImage dest(37, 23);
+          CR_Cpu::ResourceFlip(CrImages::Noise(37, 23, 1), 37, 20, 2, true, dest);
+          return CrImages::Checksum(dest);
+      } },
+    { "PrepareFGInputs", 0xDA6564AE6484F3E1,
+      []
+      {
+          CpuFIConstants constants { true, true, true, 37, 20, 2, 37, 21, 1, 0.7f };
+          CpuImage velocity;
+          CpuImage depth;
+          CR_Cpu::PrepareFGInputs(CrImages::Noise(37, 23, 1), CrImages::Noise(37, 23, 2), constants, velocity, depth);
+          return CrImages::Checksum(velocity) ^ (CrImages::Checksum(depth) * 31);
+      } },
+    { "HudlessCompare", 0x9C25E6F6E79FEAB5,
+      []
+      {
+          CpuImage dest;
+          CR_Cpu::HudlessCompare(CrImages::Noise(19, 12, 1), CrImages::Noise(37, 23, 2), 0.1f, 1.0f, dest);
+          return CrImages::Checksum(dest);
+      } },
+    { "HudlessHistogram", 0x604F4B06935A6BC0,
+      []
+      {
+          uint32_t histogram[Hudfix_Common::ValidationBinCount];
+          CR_Cpu::HudlessHistogram(CrImages::Noise(150, 70, 1), CrImages::Noise(150, 70, 2), histogram);
+          return CrImages::Checksum(std::vector<uint32_t>(histogram, histogram + Hudfix_Common::ValidationBinCount));
+      } },
+    { "Rcas", 0x983C3B5A375E368E, [] { return RcasWith(0.6f, -100.0f, false); } },
+    { "Rcas_Contrast", 0xE7FEE959BB41845C, [] { return RcasWith(0.6f, 0.3f, false); } },
+    { "Rcas_Dynamic", 0xF78B6C867C790BE2, [] { return RcasWith(0.3f, -100.0f, true); } },
+    { "OutputScaling_BCUS", 0x474990FF8F1DF284,
+      []
+      {
+          CpuImage dest(61, 40);
+          CR_Cpu::OutputScaling(CrImages::Noise(37, 23, 1), 0, true, dest);
+          return CrImages::Checksum(dest);
+      } },
+    { "OutputScaling_Bicubic", 0x3C05C3AAE6671E1B, [] { return Downscale(0); } },
+    { "OutputScaling_Lanczos", 0xDDE4D6D6F6F381E8, [] { return Downscale(1); } },
+    { "OutputScaling_CatmullRom", 0x13EF83C5FD74D450, [] { return Downscale(2); } },
+    { "OutputScaling_MAGC", 0x6B653F012BD9FB4F, [] { return Downscale(3); } },
+    { "RcasOutputScaling_Upsample", 0xC0453521EDD60341, [] { return RcasOs(true); } },
+    { "RcasOutputScaling_Downsample", 0xC1D11A5BF6F6559B, [] { return RcasOs(false); } },
+};
+
+TEST_CASE(GoldenImages)
+{
+    bool print = std::getenv("OPTISCALER_PRINT_GOLDEN") != nullptr;
+
+    for (auto& pass : GoldenPasses)
+    {
+        auto checksum = pass.run();
+
+        if (print || checksum != pass.checksum)
+            std::printf("%s: 0x%016" PRIX64 " expected: 0x%016" PRIX64 "\n", pass.name, checksum, pass.checksum);
+
+        CHECK(checksum == pass.checksum);
+    }
+}
@@ -0,0 +1,196 @@
+#include <Test.h>
+
+#include <shaders/DescriptorHeap_Common.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+TEST_CASE(RejectsEmptyAndOversized)
+{
+    DescriptorRing ring(16);
+
+    CHECK(!ring.Allocate(0).has_value());
+    CHECK(!ring.Allocate(17).has_value());
+    CHECK(ring.Used() == 0);
+}
+
+TEST_CASE(AllocatesLinearly)
+{
+    DescriptorRing ring(16);
+
+    CHECK(ring.Allocate(4) == 0u);
+    CHECK(ring.Allocate(5) == 4u);
+    CHECK(ring.Allocate(7) == 9u);
+    CHECK(ring.Used() == 16);
+
+    // Full until the frame is retired
+    CHECK(!ring.Allocate(1).has_value());
+}
+
+TEST_CASE(RetiresByFence)
+{
+    DescriptorRing ring(16);
+
+    ring.Allocate(6);
+    ring.EndFrame(1);
+    ring.Allocate(6);
+    ring.EndFrame(2);
+
+    // Frame without allocations is not recorded
+    ring.EndFrame(3);
+    CHECK(ring.PendingFrames() == 2);
+
+    ring.Retire(0);
+    CHECK(ring.Used() == 12);
+
+    ring.Retire(1);
+    CHECK(ring.Used() == 6);
+    CHECK(ring.PendingFrames() == 1);
+
+    ring.Retire(5);
+    CHECK(ring.Used() == 0);
+    CHECK(ring.PendingFrames() == 0);
+}
+
+TEST_CASE(SkipsEndOfRingWhenRangeDoesntFit)
+{
+    DescriptorRing ring(16);
+
+    ring.Allocate(6);
+    ring.EndFrame(1);
+    ring.Allocate(6);
+    ring.EndFrame(2);
+    ring.Retire(1);
+
+    // 4 slots left at the end, range starts from 0 and the end is counted as used
+    CHECK(ring.Allocate(5) == 0u);
+    CHECK(ring.Used() == 6 + 4 + 5);
+
+    // Only [5, 6) is free now
+    CHECK(!ring.Allocate(2).has_value());
+    CHECK(ring.Allocate(1) == 5u);
+    ring.EndFrame(3);
+
+    ring.Retire(3);
+    CHECK(ring.Used() == 0);
+}
+
+TEST_CASE(StartsFromZeroWhenIdle)
+{
+    DescriptorRing ring(16);
+
+    ring.Allocate(10);
+    ring.EndFrame(1);
+    ring.Retire(1);
+
+    CHECK(ring.Allocate(12) == 0u);
+}
+
+TEST_CASE(ResetDropsPendingFrames)
+{
+    DescriptorRing ring(16);
+
+    ring.Allocate(8);
+    ring.EndFrame(1);
+    ring.Allocate(3);
+    ring.Reset();
+
+    CHECK(ring.Used() == 0);
+    CHECK(ring.PendingFrames() == 0);
+    CHECK(ring.Allocate(16) == 0u);
+}
+
+// Random allocations with a few frames in flight, live ranges must never overlap
+// and allocation may only fail when the ring is really out of contiguous space
+TEST_CASE(RandomFramesNeverOverlap)
+{
+    constexpr uint32_t Capacity = 64;
+    constexpr int FramesInFlight = 3;
+
+    DescriptorRing ring(Capacity);
+    std::mt19937 rng(1234);
+
+    struct Range
+    {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct Frame
+    {
+        uint64_t fence;
+        std::vector<Range> ranges;
+    };
+
+    std::deque<Frame> frames;
+    std::vector<Range> current;
+    int overlaps = 0;
+    int failures = 0;
+    uint64_t fence = 0;
+
+    auto owner = [&](std::vector<int>& slots, const std::vector<Range>& ranges)
+    {
+        for (auto& range : ranges)
+        {
+            for (uint32_t i = 0; i < range.count; i++)
+            {
+                if (slots[range.offset + i]++ > 0)
+                    overlaps++;
+            }
+        }
+    };
+
+    for (int frame = 0; frame < 5000; frame++)
+    {
+        int dispatches = rng() % 6;
+
+        for (int d = 0; d < dispatches; d++)
+        {
+            uint32_t count = 1 + rng() % 5;
+            auto offset = ring.Allocate(count);
+
+            if (!offset.has_value())
+            {
+                failures++;
+                continue;
+            }
+
+            CHECK(offset.value() + count <= Capacity);
+            current.push_back({ offset.value(), count });
+        }
+
+        std::vector<int> slots(Capacity, 0);
+
+        for (auto& pending : frames)
+            owner(slots, pending.ranges);
+
+        owner(slots, current);
+
+        fence++;
+        ring.EndFrame(fence);
+
+        if (!current.empty())
+            frames.push_back({ fence, current });
+
+        current.clear();
+
+        // GPU completes frames with some latency
+        if (fence > FramesInFlight)
+        {
+            auto completed = fence - FramesInFlight;
+
+            while (!frames.empty() && frames.front().fence <= completed)
+                frames.pop_front();
+
+            ring.Retire(completed);
+        }
+
+        CHECK(ring.Used() <= Capacity);
+    }
+
+    CHECK(overlaps == 0);
+
+    // 3 frames of at most 25 slots each fit, allocations should rarely fail
+    CHECK(failures < 5000 / 10);
+}
@@ -0,0 +1,237 @@
+#include <Test.h>
+
+#include <shaders/PipelineCacheFile.h>
+
+#include <cstring>
+#include <fstream>
+
+static PipelineCacheKey MakeKey(uint32_t vendorId = 0x10DE, uint32_t deviceId = 0x2684, uint8_t uuidSeed = 1)
+{
+    PipelineCacheKey key {};
+    key.vendorId = vendorId;
+    key.deviceId = deviceId;
+
+    for (uint8_t i = 0; i < sizeof(key.cacheUUID); i++)
+        key.cacheUUID[i] = (uint8_t) (uuidSeed + i);
+
+    return key;
+}
+
+static void Put(std::vector<uint8_t>& data, size_t offset, uint32_t value)
+{
+    memcpy(&data[offset], &value, sizeof(value));
+}
+
+// VkPipelineCacheHeaderVersionOne followed by driver data
+static std::vector<uint8_t> MakeCache(const PipelineCacheKey& key, size_t payload = 1000)
+{
+    std::vector<uint8_t> data(32 + payload);
+    Put(data, 0, 32);
+    Put(data, 4, 1);
+    Put(data, 8, key.vendorId);
+    Put(data, 12, key.deviceId);
+    memcpy(&data[16], key.cacheUUID, sizeof(key.cacheUUID));
+
+    for (size_t i = 32; i < data.size(); i++)
+        data[i] = (uint8_t) (i * 7);
+
+    return data;
+}
+
+// Cache file in a fresh directory, removed with the directory
+class TempCache
+{
+  private:
+    std::filesystem::path _dir;
+
+  public:
+    std::filesystem::path path;
+
+    explicit TempCache(const char* name)
+    {
+        _dir = std::filesystem::temp_directory_path() / "optiscaler_pipeline_cache_tests" / name;
+        std::filesystem::remove_all(_dir);
+        std::filesystem::create_directories(_dir);
+        path = _dir / "OptiScaler.vkcache";
+    }
+
+    std::vector<uint8_t> Read() const
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void Write(const std::vector<uint8_t>& bytes) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write((const char*) bytes.data(), bytes.size());
+    }
+
+    ~TempCache()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(_dir, ec);
+    }
+};
+
+TEST_CASE(RoundTrip)
+{
+    TempCache cache("RoundTrip");
+    auto key = MakeKey();
+    auto data = MakeCache(key);
+    std::vector<uint8_t> loaded;
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, data) == PipelineCacheResult::Ok);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::Ok);
+    CHECK(loaded == data);
+
+    // No temporary file is left behind
+    auto temp = cache.path;
+    temp += ".tmp";
+    CHECK(!std::filesystem::exists(temp));
+
+    // Saving again replaces the file
+    auto bigger = MakeCache(key, 5000);
+    CHECK(PipelineCacheFile::Save(cache.path, key, bigger) == PipelineCacheResult::Ok);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::Ok);
+    CHECK(loaded == bigger);
+}
+
+TEST_CASE(MissingFile)
+{
+    TempCache cache("MissingFile");
+    std::vector<uint8_t> loaded(3, 1);
+
+    CHECK(PipelineCacheFile::Load(cache.path, MakeKey(), loaded) == PipelineCacheResult::NotFound);
+    CHECK(loaded.empty());
+}
+
+TEST_CASE(TruncatedFile)
+{
+    TempCache cache("TruncatedFile");
+    auto key = MakeKey();
+    std::vector<uint8_t> loaded;
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, MakeCache(key)) == PipelineCacheResult::Ok);
+    auto bytes = cache.Read();
+
+    // Cut in the data
+    cache.Write(std::vector<uint8_t>(bytes.begin(), bytes.end() - 10));
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::SizeMismatch);
+    CHECK(loaded.empty());
+
+    // Cut in the file header
+    cache.Write(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 10));
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::TooSmall);
+
+    // Extra bytes at the end
+    bytes.push_back(0);
+    cache.Write(bytes);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::SizeMismatch);
+}
+
+TEST_CASE(BadChecksum)
+{
+    TempCache cache("BadChecksum");
+    auto key = MakeKey();
+    std::vector<uint8_t> loaded;
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, MakeCache(key)) == PipelineCacheResult::Ok);
+    auto bytes = cache.Read();
+
+    bytes[bytes.size() - 100] ^= 0x40;
+    cache.Write(bytes);
+
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::BadChecksum);
+    CHECK(loaded.empty());
+}
+
+TEST_CASE(UnknownFormat)
+{
+    TempCache cache("UnknownFormat");
+    auto key = MakeKey();
+    std::vector<uint8_t> loaded;
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, MakeCache(key)) == PipelineCacheResult::Ok);
+    auto bytes = cache.Read();
+
+    // Magic
+    auto damaged = bytes;
+    damaged[0] ^= 0xFF;
+    cache.Write(damaged);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::UnknownFormat);
+
+    // Version
+    damaged = bytes;
+    damaged[4]++;
+    cache.Write(damaged);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::UnknownFormat);
+
+    // Data size above the limit is not allocated
+    damaged = bytes;
+    uint64_t size = PipelineCacheFile::MaxDataSize + 1;
+    memcpy(&damaged[8], &size, sizeof(size));
+    cache.Write(damaged);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::UnknownFormat);
+}
+
+TEST_CASE(IncompatibleKey)
+{
+    TempCache cache("IncompatibleKey");
+    auto key = MakeKey();
+    std::vector<uint8_t> loaded;
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, MakeCache(key)) == PipelineCacheResult::Ok);
+
+    CHECK(PipelineCacheFile::Load(cache.path, MakeKey(0x1002), loaded) == PipelineCacheResult::Incompatible);
+    CHECK(PipelineCacheFile::Load(cache.path, MakeKey(0x10DE, 0x2685), loaded) == PipelineCacheResult::Incompatible);
+    CHECK(PipelineCacheFile::Load(cache.path, MakeKey(0x10DE, 0x2684, 2), loaded) ==
+          PipelineCacheResult::Incompatible);
+    CHECK(loaded.empty());
+
+    // Same device still loads it
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::Ok);
+}
+
+TEST_CASE(SaveRejectsInvalidData)
+{
+    TempCache cache("SaveRejectsInvalidData");
+    auto key = MakeKey();
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, {}) == PipelineCacheResult::Incompatible);
+    CHECK(PipelineCacheFile::Save(cache.path, key, std::vector<uint8_t>(16, 0)) ==
+          PipelineCacheResult::Incompatible);
+    CHECK(PipelineCacheFile::Save(cache.path, MakeKey(0x8086), MakeCache(key)) == PipelineCacheResult::Incompatible);
+
+    // Header size pointing past the data
+    auto data = MakeCache(key, 0);
+    Put(data, 0, 64);
+    CHECK(PipelineCacheFile::Save(cache.path, key, data) == PipelineCacheResult::Incompatible);
+
+    CHECK(!std::filesystem::exists(cache.path));
+}
+
+TEST_CASE(FailedSaveKeepsOldFile)
+{
+    TempCache cache("FailedSaveKeepsOldFile");
+    auto key = MakeKey();
+    auto data = MakeCache(key);
+    std::vector<uint8_t> loaded;
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, data) == PipelineCacheResult::Ok);
+
+    // Temporary file can't be created when a directory has its name
+    auto temp = cache.path;
+    temp += ".tmp";
+    std::filesystem::create_directory(temp);
+
+    CHECK(PipelineCacheFile::Save(cache.path, key, MakeCache(key, 10)) == PipelineCacheResult::WriteFailed);
+    CHECK(PipelineCacheFile::Load(cache.path, key, loaded) == PipelineCacheResult::Ok);
+    CHECK(loaded == data);
+}
+
+TEST_CASE(ResultNames)
+{
+    for (uint32_t i = 0; i <= (uint32_t) PipelineCacheResult::ReplaceFailed; i++)
+        CHECK(strcmp(PipelineCacheFile::ResultName((PipelineCacheResult) i), "Unknown") != 0);
+}
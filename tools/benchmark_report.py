@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""Compares OptiScaler benchmark captures and joins image metrics with the timing report.
+
+Usage: benchmark_report.py <Benchmark/<date> folder> [--reference <run name>]
+
+Reads report.json and the DDS captures written by the in-game benchmark, computes
+PSNR and SSIM (and FLIP when flip_evaluator is installed) of every run against the
+reference run and writes metrics.csv next to the report. Requires numpy.
+"""
+
+import argparse
+import csv
+import json
+import struct
+import sys
+from pathlib import Path
+
+import numpy as np
+
+# DXGI formats written by the benchmark capture
+DXGI_FORMATS = {
+    2: ("rgba32f", 16),    # R32G32B32A32_FLOAT
+    10: ("rgba16f", 8),    # R16G16B16A16_FLOAT
+    11: ("rgba16un", 8),   # R16G16B16A16_UNORM
+    24: ("rgb10a2", 4),    # R10G10B10A2_UNORM
+    26: ("r11g11b10f", 4), # R11G11B10_FLOAT
+    27: ("rgba8", 4),      # R8G8B8A8_TYPELESS
+    28: ("rgba8", 4),      # R8G8B8A8_UNORM
+    29: ("rgba8", 4),      # R8G8B8A8_UNORM_SRGB
+    87: ("bgra8", 4),      # B8G8R8A8_UNORM
+    90: ("bgra8", 4),      # B8G8R8A8_TYPELESS
+    91: ("bgra8", 4),      # B8G8R8A8_UNORM_SRGB
+}
+
+
+def small_float(bits, mantissa_bits):
+    exponent = (bits >> mantissa_bits) & 0x1F
+    mantissa = (bits & ((1 << mantissa_bits) - 1)).astype(np.float32)
+    scale = float(1 << mantissa_bits)
+    normal = (1.0 + mantissa / scale) * np.exp2(exponent.astype(np.float32) - 15.0)
+    denormal = (mantissa / scale) * np.float32(2.0 ** -14)
+    return np.where(exponent == 0, denormal, normal).astype(np.float32)
+
+
+def load_dds(path):
+    """Returns HxWx3 float32 image in 0..1 range, HDR formats are tonemapped."""
+    data = path.read_bytes()
+
+    if data[:4] != b"DDS " or data[84:88] != b"DX10":
+        raise ValueError(f"{path.name}: only DX10 DDS files are supported")
+
+    height, width = struct.unpack_from("<II", data, 12)
+    dxgi_format = struct.unpack_from("<I", data, 128)[0]
+
+    if dxgi_format not in DXGI_FORMATS:
+        raise ValueError(f"{path.name}: unsupported DXGI format {dxgi_format}")
+
+    kind, pixel_size = DXGI_FORMATS[dxgi_format]
+    pixels = data[148:148 + width * height * pixel_size]
+    hdr = False
+
+    if kind in ("rgba8", "bgra8"):
+        image = np.frombuffer(pixels, np.uint8).reshape(height, width, 4)[..., :3].astype(np.float32) / 255.0
+        if kind == "bgra8":
+            image = image[..., ::-1]
+    elif kind == "rgb10a2":
+        raw = np.frombuffer(pixels, np.uint32).reshape(height, width)
+        image = np.stack([(raw >> shift) & 0x3FF for shift in (0, 10, 20)], axis=-1).astype(np.float32) / 1023.0
+    elif kind == "r11g11b10f":
+        raw = np.frombuffer(pixels, np.uint32).reshape(height, width)
+        r = small_float(raw & 0x7FF, 6)
+        g = small_float((raw >> 11) & 0x7FF, 6)
+        b = small_float((raw >> 22) & 0x3FF, 5)
+        image = np.stack([r, g, b], axis=-1)
+        hdr = True
+    elif kind == "rgba16f":
+        image = np.frombuffer(pixels, np.float16).reshape(height, width, 4)[..., :3].astype(np.float32)
+        hdr = True
+    elif kind == "rgba16un":
+        image = np.frombuffer(pixels, np.uint16).reshape(height, width, 4)[..., :3].astype(np.float32) / 65535.0
+    else:
+        image = np.frombuffer(pixels, np.float32).reshape(height, width, 4)[..., :3].copy()
+        hdr = True
+
+    image = np.nan_to_num(image, nan=0.0, posinf=0.0, neginf=0.0)
+
+    if hdr:
+        # Reinhard, metrics are only meaningful relative to each other
+        image = np.maximum(image, 0.0)
+        image = image / (1.0 + image)
+
+    return np.clip(image, 0.0, 1.0)
+
+
+def psnr(a, b):
+    mse = float(np.mean((a - b) ** 2))
+    return float("inf") if mse == 0.0 else 10.0 * np.log10(1.0 / mse)
+
+
+def gaussian_blur(image, size=11, sigma=1.5):
+    x = np.arange(size, dtype=np.float32) - size // 2
+    kernel = np.exp(-(x ** 2) / (2.0 * sigma ** 2))
+    kernel /= kernel.sum()
+
+    blurred = np.apply_along_axis(lambda row: np.convolve(row, kernel, mode="valid"), 1, image)
+    return np.apply_along_axis(lambda col: np.convolve(col, kernel, mode="valid"), 0, blurred)
+
+
+def ssim(a, b):
+    luma = np.array([0.2126, 0.7152, 0.0722], np.float32)
+    x = a @ luma
+    y = b @ luma
+
+    c1 = 0.01 ** 2
+    c2 = 0.03 ** 2
+
+    mu_x = gaussian_blur(x)
+    mu_y = gaussian_blur(y)
+    sigma_x = gaussian_blur(x * x) - mu_x ** 2
+    sigma_y = gaussian_blur(y * y) - mu_y ** 2
+    sigma_xy = gaussian_blur(x * y) - mu_x * mu_y
+
+    numerator = (2 * mu_x * mu_y + c1) * (2 * sigma_xy + c2)
+    denominator = (mu_x ** 2 + mu_y ** 2 + c1) * (sigma_x + sigma_y + c2)
+    ssim_map = numerator / denominator
+    return float(ssim_map.mean())
+
+
+def flip(a, b):
+    try:
+        import flip_evaluator
+    except ImportError:
+        return None
+
+    _, mean_flip, _ = flip_evaluator.evaluate(a, b, "LDR")
+    return float(mean_flip)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("folder", type=Path, help="benchmark output folder containing report.json")
+    parser.add_argument("--reference", help="run name used as reference, default is the last captured run")
+    args = parser.parse_args()
+
+    report = json.loads((args.folder / "report.json").read_text())
+    runs = [run for run in report["runs"] if run.get("capture")]
+
+    if not runs:
+        print("No captures in report", file=sys.stderr)
+        return 1
+
+    reference = runs[-1]
+
+    if args.reference:
+        matches = [run for run in runs if run["name"] == args.reference]
+        if not matches:
+            print(f"Reference run {args.reference} has no capture", file=sys.stderr)
+            return 1
+        reference = matches[0]
+
+    reference_image = load_dds(args.folder / reference["capture"])
+    rows = []
+
+    for run in report["runs"]:
+        row = {
+            "name": run["name"],
+            "status": run["status"],
+            "render": f'{run["renderWidth"]}x{run["renderHeight"]}',
+            "frame_avg_ms": run["frameTime"]["avg"],
+            "frame_p99_ms": run["frameTime"]["p99"],
+            "upscale_avg_ms": run["upscaleTime"]["avg"],
+            "vram_delta_mb": run["vramDeltaMB"],
+            "psnr": None,
+            "ssim": None,
+            "flip": None,
+        }
+
+        if run.get("capture"):
+            image = load_dds(args.folder / run["capture"])
+
+            if image.shape != reference_image.shape:
+                print(f"{run['name']}: capture size differs from reference, skipped", file=sys.stderr)
+            else:
+                row["psnr"] = psnr(image, reference_image)
+                row["ssim"] = ssim(image, reference_image)
+                row["flip"] = flip(reference_image, image)
+
+        rows.append(row)
+
+    with open(args.folder / "metrics.csv", "w", newline="") as file:
+        writer = csv.DictWriter(file, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        writer.writerows(rows)
+
+    def fmt(value, spec):
+        return "-" if value is None else format(value, spec)
+
+    print(f"Reference: {reference['name']}")
+    print(f"{'name':<16}{'render':>12}{'frame ms':>10}{'p99 ms':>10}{'upscale ms':>12}{'vram MB':>10}"
+          f"{'psnr':>9}{'ssim':>8}{'flip':>8}")
+
+    for row in rows:
+        print(f"{row['name']:<16}{row['render']:>12}{fmt(row['frame_avg_ms'], '.3f'):>10}"
+              f"{fmt(row['frame_p99_ms'], '.3f'):>10}{fmt(row['upscale_avg_ms'], '.3f'):>12}"
+              f"{fmt(row['vram_delta_mb'], '.1f'):>10}{fmt(row['psnr'], '.2f'):>9}{fmt(row['ssim'], '.4f'):>8}"
+              f"{fmt(row['flip'], '.4f'):>8}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
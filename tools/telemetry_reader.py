@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""Reads OptiScaler's shared memory telemetry ring.
+
+Usage: telemetry_reader.py (--pid <process id> | --file <path>) [--follow] [--csv <path>]
+
+OptiScaler writes a record of runtime metrics for every presented frame to the named
+mapping Local\\OptiScaler_Telemetry_<pid> when [Telemetry] Enabled=true. Layout is
+defined in OptiScaler/misc/TelemetryLayout.h, this module mirrors it. --file reads a
+file with the same layout (mapping dump or a test file) on any platform.
+
+Can be imported: TelemetryReader(...).read_new() returns records written since last call.
+"""
+
+import argparse
+import csv
+import mmap
+import struct
+import sys
+import time
+from pathlib import Path
+
+MAGIC = 0x54504F54
+VERSION = 1
+
+HEADER = struct.Struct("<6IQ32x")
+RECORD = struct.Struct("<QQddd7I4x16s40x")
+
+HEADER_SIZE = HEADER.size
+RECORD_SIZE = RECORD.size
+
+FLAGS = {1: "upscaling", 2: "fg", 4: "hudless", 8: "hudfix"}
+APIS = {0: "none", 1: "dx11", 2: "dx12", 3: "vulkan"}
+FG_TYPES = {0: "none", 1: "optifg", 2: "nukems"}
+
+FIELDS = [
+    "frame", "time_ms", "frame_time_ms", "upscale_time_ms", "render_width", "render_height",
+    "output_width", "output_height", "api", "fg_type", "flags", "backend",
+]
+
+
+class TelemetryError(Exception):
+    pass
+
+
+def mapping_name(pid):
+    return f"Local\\OptiScaler_Telemetry_{pid}"
+
+
+class TelemetryReader:
+    def __init__(self, pid=None, path=None):
+        if path is not None:
+            self._file = open(path, "rb")
+            self._view = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        elif pid is not None:
+            if sys.platform != "win32":
+                raise TelemetryError("named mappings are only available on Windows, use --file")
+
+            self._file = None
+            # Opens existing mapping, a missing one is created empty and fails the magic check
+            self._view = mmap.mmap(-1, HEADER_SIZE, tagname=mapping_name(pid), access=mmap.ACCESS_READ)
+            header = self._read_header()
+            self._view.close()
+            size = header["header_size"] + header["record_size"] * header["record_count"]
+            self._view = mmap.mmap(-1, size, tagname=mapping_name(pid), access=mmap.ACCESS_READ)
+        else:
+            raise TelemetryError("pid or path is needed")
+
+        self.header = self._read_header()
+        self._next = max(0, self.header["write_index"] - self.header["record_count"])
+
+    def _read_header(self):
+        values = HEADER.unpack_from(self._view, 0)
+        header = dict(zip(["magic", "version", "header_size", "record_size", "record_count", "process_id",
+                           "write_index"], values))
+
+        if header["magic"] != MAGIC:
+            raise TelemetryError("telemetry is not enabled in this process")
+
+        if header["version"] != VERSION:
+            raise TelemetryError(f"unsupported telemetry version {header['version']}")
+
+        if header["record_size"] < RECORD_SIZE or header["record_count"] == 0:
+            raise TelemetryError("unexpected record layout")
+
+        return header
+
+    def write_index(self):
+        return struct.unpack_from("<Q", self._view, 24)[0]
+
+    def read(self, index):
+        """Record of frame index, None when it's being written or already overwritten."""
+        offset = self.header["header_size"] + (index % self.header["record_count"]) * self.header["record_size"]
+        expected = index * 2 + 2
+
+        if struct.unpack_from("<Q", self._view, offset)[0] != expected:
+            return None
+
+        data = self._view[offset:offset + RECORD_SIZE]
+
+        # Seqlock: writer changed the record while it was copied
+        if struct.unpack_from("<Q", self._view, offset)[0] != expected:
+            return None
+
+        values = RECORD.unpack(data)
+        record = dict(zip(FIELDS, values[1:]))
+        record["backend"] = record["backend"].split(b"\0", 1)[0].decode("ascii", "replace")
+        return record
+
+    def read_new(self):
+        """Records written since last call, skipped ones are counted in self.dropped."""
+        records = []
+        self.dropped = 0
+        end = self.write_index()
+
+        # Reader fell behind more than the ring, oldest ones are gone
+        if end - self._next > self.header["record_count"]:
+            self.dropped += end - self._next - self.header["record_count"]
+            self._next = end - self.header["record_count"]
+
+        while self._next < end:
+            record = self.read(self._next)
+
+            if record is None:
+                self.dropped += 1
+            else:
+                records.append(record)
+
+            self._next += 1
+
+        return records
+
+    def close(self):
+        self._view.close()
+
+        if self._file is not None:
+            self._file.close()
+
+
+def describe_flags(flags):
+    names = [name for bit, name in FLAGS.items() if flags & bit]
+    return ",".join(names) if names else "-"
+
+
+def format_record(record):
+    return (f"{record['frame']:>8} {record['frame_time_ms']:8.3f} ms  upscale {record['upscale_time_ms']:6.3f} ms  "
+            f"{record['backend'] or '-':>9}  {record['render_width']}x{record['render_height']} -> "
+            f"{record['output_width']}x{record['output_height']}  {APIS.get(record['api'], '?')}  "
+            f"fg {FG_TYPES.get(record['fg_type'], '?')}  {describe_flags(record['flags'])}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--pid", type=int, help="process id of the game")
+    source.add_argument("--file", type=Path, help="file with telemetry layout")
+    parser.add_argument("--follow", action="store_true", help="keep reading new records until Ctrl+C")
+    parser.add_argument("--csv", type=Path, help="write records to a csv file instead of printing")
+    args = parser.parse_args()
+
+    try:
+        reader = TelemetryReader(pid=args.pid, path=args.file)
+    except (TelemetryError, OSError) as e:
+        print(f"Can't open telemetry: {e}", file=sys.stderr)
+        return 1
+
+    output = open(args.csv, "w", newline="") if args.csv else None
+    writer = csv.DictWriter(output, fieldnames=FIELDS) if output else None
+
+    if writer:
+        writer.writeheader()
+
+    dropped = 0
+
+    try:
+        while True:
+            for record in reader.read_new():
+                if writer:
+                    writer.writerow(record)
+                else:
+                    print(format_record(record))
+
+            dropped += reader.dropped
+
+            if not args.follow:
+                break
+
+            time.sleep(0.1)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        reader.close()
+
+        if output:
+            output.close()
+
+    if dropped:
+        print(f"{dropped} records were skipped, they were overwritten or being written", file=sys.stderr)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())